@@ -112,8 +112,41 @@ void BM_validate(benchmark::State& state) {
     state.SetBytesProcessed(totalSize);
 }
 
+void BM_getFieldWide(benchmark::State& state) {
+    BSONObjBuilder builder;
+    auto len = state.range(0);
+    for (auto j = 0; j < len; j++)
+        builder.append(fmt::format("field_with_a_longer_name_{}", j), j);
+    BSONObj obj = builder.obj();
+    const auto lastField = fmt::format("field_with_a_longer_name_{}", len - 1);
+
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        benchmark::DoNotOptimize(obj.getField(lastField));
+    }
+    state.SetItemsProcessed(state.iterations() * len);
+}
+
+void BM_validateWide(benchmark::State& state) {
+    BSONObjBuilder builder;
+    auto len = state.range(0);
+    for (auto j = 0; j < len; j++)
+        builder.append(fmt::format("field_with_a_longer_name_{}", j), j);
+    BSONObj obj = builder.obj();
+    size_t totalSize = 0;
+
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        benchmark::DoNotOptimize(validateBSON(obj.objdata(), obj.objsize()));
+        totalSize += obj.objsize();
+    }
+    state.SetBytesProcessed(totalSize);
+}
+
 BENCHMARK(BM_arrayBuilder)->Ranges({{{1}, {100'000}}});
 BENCHMARK(BM_arrayLookup)->Ranges({{{1}, {100'000}}});
 BENCHMARK(BM_validate)->Ranges({{{1}, {1'000}}});
+BENCHMARK(BM_getFieldWide)->Ranges({{{8}, {1'024}}});
+BENCHMARK(BM_validateWide)->Ranges({{{8}, {1'024}}});
 
 }  // namespace mongo
@@ -199,12 +199,13 @@ private:
         }
 
         size_t strlen() const {
-            // This is actually by far the hottest code in all of BSON validation.
+            // This is actually by far the hottest code in all of BSON validation. Use memchr,
+            // which the C library implements with vector instructions, rather than a byte loop
+            // the compiler cannot vectorize. If no terminator is found before 'end', returning
+            // the remaining length makes the caller's subsequent skip() fail the bounds check.
             dassert(ptr < end);
-            size_t len = 0;
-            while (ptr[len])
-                ++len;
-            return len;
+            auto nul = static_cast<const char*>(std::memchr(ptr, 0, end - ptr));
+            return nul ? nul - ptr : end - ptr;
         }
 
         const char* ptr;
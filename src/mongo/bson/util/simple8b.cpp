@@ -917,6 +917,56 @@ typename Simple8b<T>::Iterator Simple8b<T>::end() const {
     return {_buffer + _size, _buffer + _size, boost::none};
 }
 
+template <typename T>
+void Simple8b<T>::decodeAll(std::vector<boost::optional<T>>* out) const {
+    boost::optional<T> last = _previous;
+    for (const char* pos = _buffer; pos != _buffer + _size; pos += sizeof(uint64_t)) {
+        uint64_t block = ConstDataView(pos).read<LittleEndian<uint64_t>>();
+        uint8_t selector = block & kBaseSelectorMask;
+        uint8_t selectorExtension = (block >> kSelectorBits) & kBaseSelectorMask;
+
+        // RLE blocks repeat the last value of the previous block.
+        if (selector == kRleSelector) {
+            out->insert(out->end(), (selectorExtension + 1) * kRleMultiplier, last);
+            continue;
+        }
+
+        uint8_t extensionType = kBaseSelector;
+        uint8_t extensionBits = 0;
+        if (selector == 7 || selector == 8) {
+            extensionType = kSelectorToExtension[selector - 7][selectorExtension];
+            if (extensionType != kBaseSelector) {
+                selector = selectorExtension;
+            }
+            extensionBits = 4;
+        }
+
+        const uint64_t mask = kDecodeMask[extensionType][selector];
+        const uint8_t countMask = kTrailingZerosMask[extensionType];
+        const uint8_t countBits = kTrailingZeroBitSize[extensionType];
+        const uint8_t countMultiplier = kTrailingZerosMultiplier[extensionType];
+        const uint8_t bitsPerValue = kBitsPerIntForSelector[extensionType][selector] + countBits;
+        const uint8_t numValues = kIntsStoreForSelector[extensionType][selector];
+        if (numValues == 0) {
+            continue;
+        }
+
+        uint64_t slots = block >> (kSelectorBits + extensionBits);
+        for (uint8_t i = 0; i < numValues; ++i) {
+            uint64_t value = slots & mask;
+            if (value == mask) {
+                out->push_back(boost::none);
+            } else {
+                auto trailingZeros = value & countMask;
+                out->push_back(static_cast<T>(value >> countBits)
+                               << (trailingZeros * countMultiplier));
+            }
+            slots >>= bitsPerValue;
+        }
+        last = out->back();
+    }
+}
+
 template class Simple8b<uint64_t>;
 template class Simple8b<uint128_t>;
 template class Simple8bBuilder<uint64_t>;
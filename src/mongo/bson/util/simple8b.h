@@ -403,6 +403,13 @@ public:
     Iterator begin() const;
     Iterator end() const;
 
+    /**
+     * Appends all values in the buffer to 'out', in the order the iterators would produce them.
+     * Decoding a whole block at a time resolves the selector once per block rather than once per
+     * value, which makes this considerably faster than iterating when every value is needed.
+     */
+    void decodeAll(std::vector<boost::optional<T>>* out) const;
+
 private:
     const char* _buffer;
     int _size;
@@ -146,11 +146,49 @@ void BM_decode(benchmark::State& state) {
     state.SetBytesProcessed(totalBytes);
 }
 
+void BM_decodeAll(benchmark::State& state) {
+    size_t totalBytes = 0;
+
+    BufBuilder _buffer;
+    Simple8bBuilder<uint64_t> s8bBuilder(
+        [&_buffer](uint64_t simple8bBlock) { _buffer.appendNum(simple8bBlock); });
+
+    // Same values as BM_decode.
+    for (auto j = 0; j < 100; j++)
+        s8bBuilder.append(j % 2);
+
+    for (auto j = 0; j < 200; j++)
+        s8bBuilder.append(0);
+
+    for (auto j = 0; j < 100; j++) {
+        uint64_t value = j % 2 ? 0xE0 : 0xFF;
+        s8bBuilder.append(value);
+    }
+
+    s8bBuilder.flush();
+
+    auto size = _buffer.len();
+    auto buf = _buffer.release();
+    Simple8b<uint64_t> s8b(buf.get(), size);
+
+    std::vector<boost::optional<uint64_t>> values;
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        values.clear();
+        s8b.decodeAll(&values);
+        benchmark::DoNotOptimize(values.data());
+        totalBytes += size;
+    }
+
+    state.SetBytesProcessed(totalBytes);
+}
+
 BENCHMARK(BM_increasingValues)->Arg(100);
 BENCHMARK(BM_rle)->Arg(100);
 BENCHMARK(BM_changingSmallValues)->Arg(100);
 BENCHMARK(BM_changingLargeValues)->Arg(100);
 BENCHMARK(BM_selectorSeven)->Arg(100);
 BENCHMARK(BM_decode);
+BENCHMARK(BM_decodeAll);
 
 }  // namespace mongo
@@ -48,6 +48,14 @@ void assertValuesEqual(const Simple8b<T>& actual, const std::vector<boost::optio
 
     ASSERT(it == end);
     ASSERT_EQ(i, expected.size());
+
+    // Bulk decoding must produce the same values as iterating.
+    std::vector<boost::optional<T>> decoded;
+    actual.decodeAll(&decoded);
+    ASSERT_EQ(decoded.size(), expected.size());
+    for (i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ(decoded[i], expected[i]);
+    }
 }
 
 template <typename T>
@@ -205,6 +205,13 @@ public:
      */
     virtual OID getCacheGeneration() = 0;
 
+    /**
+     * Returns a counter which is incremented whenever getCacheGeneration() changes. Unlike the
+     * generation itself it can be read without taking a lock, so it is suitable for checks made on
+     * every request, such as AuthorizationSession deciding whether its derived state is current.
+     */
+    virtual uint64_t getCacheEpoch() const = 0;
+
     /**
      * Returns true if there exists at least one privilege document in the system.
      * Used by the AuthorizationSession to determine whether localhost connections should be
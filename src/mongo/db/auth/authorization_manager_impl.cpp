@@ -415,6 +415,10 @@ OID AuthorizationManagerImpl::getCacheGeneration() {
     return _cacheGeneration;
 }
 
+uint64_t AuthorizationManagerImpl::getCacheEpoch() const {
+    return _cacheEpoch.load();
+}
+
 void AuthorizationManagerImpl::setAuthEnabled(bool enabled) {
     _authEnabled = enabled;
 }
@@ -588,6 +592,7 @@ void AuthorizationManagerImpl::updatePinnedUsersList(std::vector<UserName> names
 void AuthorizationManagerImpl::_updateCacheGeneration() {
     stdx::lock_guard lg(_cacheGenerationMutex);
     _cacheGeneration = OID::gen();
+    _cacheEpoch.fetchAndAdd(1);
 }
 
 void AuthorizationManagerImpl::_pinnedUsersThreadRoutine() noexcept try {
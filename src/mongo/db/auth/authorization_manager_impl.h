@@ -67,6 +67,8 @@ public:
 
     OID getCacheGeneration() override;
 
+    uint64_t getCacheEpoch() const override;
+
     bool hasAnyPrivilegeDocuments(OperationContext* opCtx) override;
 
     Status getUserDescription(OperationContext* opCtx,
@@ -156,6 +158,9 @@ private:
         MONGO_MAKE_LATCH("AuthorizationManagerImpl::_cacheGenerationMutex");
     OID _cacheGeneration{OID::gen()};
 
+    // Incremented every time _cacheGeneration is regenerated. Refer to getCacheEpoch().
+    AtomicWord<uint64_t> _cacheEpoch{1};
+
     /**
      * Cache which contains at most a single entry (which has key 0), whose value is the version of
      * the auth schema.
@@ -392,5 +392,18 @@ TEST_F(AuthorizationManagerTest, testRefreshExternalV2User) {
     }
 }
 
+TEST_F(AuthorizationManagerTest, CacheEpochAdvancesWithCacheGeneration) {
+    const auto initialGeneration = authzManager->getCacheGeneration();
+    const auto initialEpoch = authzManager->getCacheEpoch();
+
+    authzManager->invalidateUsersFromDB(opCtx.get(), "test");
+    ASSERT_NE(initialGeneration, authzManager->getCacheGeneration());
+    ASSERT_GT(authzManager->getCacheEpoch(), initialEpoch);
+
+    const auto epoch = authzManager->getCacheEpoch();
+    authzManager->invalidateUserCache(opCtx.get());
+    ASSERT_GT(authzManager->getCacheEpoch(), epoch);
+}
+
 }  // namespace
 }  // namespace mongo
@@ -691,11 +691,14 @@ bool AuthorizationSessionImpl::isAuthenticated() {
 
 void AuthorizationSessionImpl::_refreshUserInfoAsNeeded(OperationContext* opCtx) {
     AuthorizationManager& authMan = getAuthorizationManager();
+    const auto cacheEpoch = authMan.getCacheEpoch();
+    bool usersChanged = false;
     UserSet::iterator it = _authenticatedUsers.begin();
     auto removeUser = [&](const auto& it) {
         // Take out a lock on the client here to ensure that no one reads while
         // _authenticatedUsers is being modified.
         stdx::lock_guard<Client> lk(*opCtx->getClient());
+        usersChanged = true;
 
         // The user is invalid, so make sure that we erase it from _authenticateUsers.
         _authenticatedUsers.removeAt(it);
@@ -705,6 +708,7 @@ void AuthorizationSessionImpl::_refreshUserInfoAsNeeded(OperationContext* opCtx)
         // Take out a lock on the client here to ensure that no one reads while
         // _authenticatedUsers is being modified.
         stdx::lock_guard<Client> lk(*opCtx->getClient());
+        usersChanged = true;
         _authenticatedUsers.replaceAt(it, std::move(updatedUser));
     };
 
@@ -778,7 +782,14 @@ void AuthorizationSessionImpl::_refreshUserInfoAsNeeded(OperationContext* opCtx)
 
         ++it;
     }
-    _updateInternalAuthorizationState();
+
+    // The derived state only depends on the authenticated users and on persisted authorization
+    // data, so it can be reused across requests until one of them changes. This keeps the common
+    // case, where every user handle is still valid, free of any further work.
+    if (usersChanged || cacheEpoch != _internalAuthorizationStateEpoch) {
+        _updateInternalAuthorizationState();
+        _internalAuthorizationStateEpoch = cacheEpoch;
+    }
 }
 
 bool AuthorizationSessionImpl::isAuthorizedForAnyActionOnAnyResourceInDB(StringData db) {
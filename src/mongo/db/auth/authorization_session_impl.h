@@ -222,5 +222,9 @@ private:
     AuthorizationContract _contract;
 
     bool _mayBypassWriteBlockingMode;
+
+    // The AuthorizationManager cache epoch at which the state maintained by
+    // _updateInternalAuthorizationState() was last refreshed by _refreshUserInfoAsNeeded().
+    uint64_t _internalAuthorizationStateEpoch = 0;
 };
 }  // namespace mongo
@@ -156,6 +156,7 @@ MONGO_INITIALIZER(AuthorizationBuiltinRoles)(InitializerContext* context) {
 
     // DB admin role
     dbAdminRoleActions
+        << ActionType::analyze
         << ActionType::bypassDocumentValidation
         << ActionType::collMod
         << ActionType::collStats  // clusterMonitor gets this also
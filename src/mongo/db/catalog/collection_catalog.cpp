@@ -285,6 +285,11 @@ bool CollectionCatalog::Range::empty() const {
 }
 
 std::shared_ptr<const CollectionCatalog> CollectionCatalog::get(ServiceContext* svcCtx) {
+    // Every call touches the reference count shared by all readers of this instance. Readers that
+    // need the catalog repeatedly should stash it on their operation (see stash() and
+    // CollectionCatalogStasher) rather than calling this again. Caching references per thread
+    // instead would keep superseded catalogs, and the Collections and idents they reference,
+    // alive on idle threads and hold up the drop-pending ident reaper.
     return atomic_load(&getCatalog(svcCtx).catalog);
 }
 
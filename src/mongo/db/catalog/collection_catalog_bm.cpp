@@ -228,6 +228,19 @@ void BM_CollectionCatalogIterateCollections(benchmark::State& state) {
     }
 }
 
+void BM_CollectionCatalogGetConcurrent(benchmark::State& state) {
+    // Readers on every thread load the same published instance, so this measures the cost of the
+    // atomic_load and the shared reference count under contention.
+    static ServiceContext* serviceContext = nullptr;
+    if (state.thread_index == 0) {
+        serviceContext = setupServiceContext();
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(CollectionCatalog::get(serviceContext));
+    }
+}
+
 BENCHMARK(BM_CollectionCatalogWrite)->Ranges({{{1}, {100'000}}});
 BENCHMARK(BM_CollectionCatalogWriteBatchedWithGlobalExclusiveLock)->Ranges({{{1}, {100'000}}});
 BENCHMARK(BM_CollectionCatalogCreateDropCollection)->Ranges({{{1}, {100'000}}});
@@ -236,5 +249,6 @@ BENCHMARK(BM_CollectionCatalogCreateNCollections)->Ranges({{{1}, {32'768}}});
 BENCHMARK(BM_CollectionCatalogLookupCollectionByNamespace)->Ranges({{{1}, {100'000}}});
 BENCHMARK(BM_CollectionCatalogLookupCollectionByUUID)->Ranges({{{1}, {100'000}}});
 BENCHMARK(BM_CollectionCatalogIterateCollections)->Ranges({{{1}, {100'000}}});
+BENCHMARK(BM_CollectionCatalogGetConcurrent)->ThreadRange(1, 64);
 
 }  // namespace mongo
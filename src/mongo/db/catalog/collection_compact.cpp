@@ -51,7 +51,7 @@ namespace {
 
 CollectionPtr getCollectionForCompact(OperationContext* opCtx,
                                       const NamespaceString& collectionNss) {
-    invariant(opCtx->lockState()->isCollectionLockedForMode(collectionNss, MODE_IX));
+    invariant(opCtx->lockState()->isCollectionLockedForMode(collectionNss, MODE_IS));
 
     auto collectionCatalog = CollectionCatalog::get(opCtx);
     CollectionPtr collection = collectionCatalog->lookupCollectionByNamespace(opCtx, collectionNss);
@@ -68,6 +68,24 @@ CollectionPtr getCollectionForCompact(OperationContext* opCtx,
 
 }  // namespace
 
+StatusWith<int64_t> estimateCompactBytesFreed(OperationContext* opCtx,
+                                              const NamespaceString& collectionNss) {
+    AutoGetDb autoDb(opCtx, collectionNss.db(), MODE_IS);
+    uassert(ErrorCodes::NamespaceNotFound, "database does not exist", autoDb.getDb());
+
+    Lock::CollectionLock collLk(opCtx, collectionNss, MODE_IS);
+    CollectionPtr collection = getCollectionForCompact(opCtx, collectionNss);
+
+    auto recordStore = collection->getRecordStore();
+    if (!recordStore->compactSupported())
+        return Status(ErrorCodes::CommandNotSupported,
+                      str::stream() << "cannot compact collection with record store: "
+                                    << recordStore->name());
+
+    return recordStore->freeStorageSize(opCtx) +
+        static_cast<int64_t>(collection->getIndexFreeStorageBytes(opCtx));
+}
+
 StatusWith<int64_t> compactCollection(OperationContext* opCtx,
                                       const NamespaceString& collectionNss) {
     AutoGetDb autoDb(opCtx, collectionNss.db(), MODE_IX);
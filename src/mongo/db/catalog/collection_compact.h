@@ -43,4 +43,12 @@ namespace mongo {
 StatusWith<int64_t> compactCollection(OperationContext* opCtx,
                                       const NamespaceString& collectionNss);
 
+/**
+ * Estimates the number of bytes compacting the collection could free, without compacting it. The
+ * estimate is the space the storage engine reports as available for reuse in the collection and
+ * its ready indexes, which compaction may or may not be able to return to the file system.
+ */
+StatusWith<int64_t> estimateCompactBytesFreed(OperationContext* opCtx,
+                                              const NamespaceString& collectionNss);
+
 }  // namespace mongo
@@ -37,8 +37,11 @@
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/collection_mock.h"
 #include "mongo/db/catalog/collection_validation.h"
+#include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
+#include "mongo/db/curop.h"
 #include "mongo/db/db_raii.h"
+#include "mongo/db/index/index_access_method.h"
 #include "mongo/db/repl/storage_interface_impl.h"
 #include "mongo/stdx/thread.h"
 #include "mongo/unittest/unittest.h"
@@ -344,6 +347,122 @@ TEST_F(CollectionTest, ForceSetIndexIsMultikeyRemovesUncommittedChangesOnRollbac
     }
 }
 
+/**
+ * Replaces the collection's only document with 'newDoc' and returns the number of index keys the
+ * update inserted and deleted.
+ */
+std::pair<long long, long long> updateOnlyDocument(OperationContext* opCtx,
+                                                   const CollectionPtr& coll,
+                                                   const BSONObj& newDoc) {
+    auto cursor = coll->getCursor(opCtx);
+    auto record = cursor->next();
+    ASSERT(record);
+    Snapshotted<BSONObj> oldDoc(opCtx->recoveryUnit()->getSnapshotId(),
+                                record->data.toBson().getOwned());
+
+    CollectionUpdateArgs args;
+    args.update = newDoc;
+    args.criteria = BSON("_id" << oldDoc.value()["_id"]);
+    args.updatedDoc = newDoc;
+
+    OpDebug opDebug;
+    WriteUnitOfWork wuow(opCtx);
+    coll->updateDocument(
+        opCtx, record->id, oldDoc, newDoc, true /* indexesAffected */, &opDebug, &args);
+    wuow.commit();
+    return {opDebug.additiveMetrics.keysInserted.value_or(0),
+            opDebug.additiveMetrics.keysDeleted.value_or(0)};
+}
+
+int64_t numIndexEntries(OperationContext* opCtx, const CollectionPtr& coll, StringData indexName) {
+    auto indexCatalog = coll->getIndexCatalog();
+    auto desc = indexCatalog->findIndexByName(opCtx, indexName);
+    ASSERT(desc);
+    auto iam = indexCatalog->getEntry(desc)->accessMethod()->asSortedData();
+    return iam->getSortedDataInterface()->numEntries(opCtx);
+}
+
+TEST_F(CollectionTest, UpdateKeepsMultikeyIndexKeysInSync) {
+    NamespaceString nss("test.t");
+    auto indexName = "myindex"_sd;
+    makeCollectionForMultikey(nss, indexName);
+
+    auto opCtx = operationContext();
+    AutoGetCollection autoColl(opCtx, nss, MODE_IX);
+    const auto& coll = autoColl.getCollection();
+    ASSERT(coll);
+    {
+        WriteUnitOfWork wuow(opCtx);
+        ASSERT_OK(coll->insertDocument(
+            opCtx, InsertStatement(BSON("_id" << 0 << "a" << BSON_ARRAY(1 << 2 << 3) << "b" << 1)),
+            nullptr));
+        wuow.commit();
+    }
+    MultikeyPaths paths;
+    ASSERT(coll->isIndexMultikey(opCtx, indexName, &paths));
+    ASSERT_EQ(3, numIndexEntries(opCtx, coll, indexName));
+
+    // Leaving the array alone leaves the keys alone.
+    auto keysChanged = updateOnlyDocument(
+        opCtx, coll, BSON("_id" << 0 << "a" << BSON_ARRAY(1 << 2 << 3) << "b" << 2));
+    ASSERT_EQ(0, keysChanged.first);
+    ASSERT_EQ(0, keysChanged.second);
+    ASSERT_EQ(3, numIndexEntries(opCtx, coll, indexName));
+
+    // Changing one element of the array replaces only the matching key.
+    keysChanged = updateOnlyDocument(
+        opCtx, coll, BSON("_id" << 0 << "a" << BSON_ARRAY(1 << 2 << 4) << "b" << 2));
+    ASSERT_EQ(1, keysChanged.first);
+    ASSERT_EQ(1, keysChanged.second);
+    ASSERT_EQ(3, numIndexEntries(opCtx, coll, indexName));
+
+    keysChanged =
+        updateOnlyDocument(opCtx, coll, BSON("_id" << 0 << "a" << BSON_ARRAY(5) << "b" << 2));
+    ASSERT_EQ(1, keysChanged.first);
+    ASSERT_EQ(3, keysChanged.second);
+    ASSERT_EQ(1, numIndexEntries(opCtx, coll, indexName));
+    ASSERT(coll->isIndexMultikey(opCtx, indexName, &paths));
+}
+
+TEST_F(CollectionTest, UpdateKeepsPartialIndexKeysInSync) {
+    NamespaceString nss("test.t");
+    auto indexName = "partial"_sd;
+    ASSERT_OK(storageInterface()->createCollection(operationContext(), nss, CollectionOptions()));
+
+    auto opCtx = operationContext();
+    AutoGetCollection autoColl(opCtx, nss, MODE_X);
+    {
+        WriteUnitOfWork wuow(opCtx);
+        auto collWriter = autoColl.getWritableCollection(opCtx);
+        ASSERT_OK(collWriter->getIndexCatalog()->createIndexOnEmptyCollection(
+            opCtx,
+            collWriter,
+            BSON("v" << 2 << "name" << indexName << "key" << BSON("a" << 1)
+                     << "partialFilterExpression" << BSON("b" << BSON("$gt" << 0)))));
+        wuow.commit();
+    }
+    const auto& coll = autoColl.getCollection();
+    {
+        WriteUnitOfWork wuow(opCtx);
+        ASSERT_OK(coll->insertDocument(
+            opCtx, InsertStatement(BSON("_id" << 0 << "a" << 1 << "b" << 1)), nullptr));
+        wuow.commit();
+    }
+    ASSERT_EQ(1, numIndexEntries(opCtx, coll, indexName));
+
+    // The indexed field is unchanged, but the document no longer matches the filter.
+    auto keysChanged = updateOnlyDocument(opCtx, coll, BSON("_id" << 0 << "a" << 1 << "b" << -1));
+    ASSERT_EQ(0, keysChanged.first);
+    ASSERT_EQ(1, keysChanged.second);
+    ASSERT_EQ(0, numIndexEntries(opCtx, coll, indexName));
+
+    // And now matches it again.
+    keysChanged = updateOnlyDocument(opCtx, coll, BSON("_id" << 0 << "a" << 1 << "b" << 1));
+    ASSERT_EQ(1, keysChanged.first);
+    ASSERT_EQ(0, keysChanged.second);
+    ASSERT_EQ(1, numIndexEntries(opCtx, coll, indexName));
+}
+
 TEST_F(CollectionTest, CheckTimeseriesBucketDocsForMixedSchemaData) {
     NamespaceString nss("test.system.buckets.ts");
     makeTimeseries(nss);
@@ -346,6 +346,11 @@ void _reportValidationResults(OperationContext* opCtx,
             bob.append("errors", vr.errors);
         }
 
+        if (validateState->isFullValidation()) {
+            bob.appendNumber("keyBytes", static_cast<long long>(vr.keyBytesTraversed));
+            bob.appendNumber("keyBytesSharedWithPreviousKey",
+                             static_cast<long long>(vr.keyBytesSharedWithPreviousKey));
+        }
 
         keysPerIndex.appendNumber(indexName, static_cast<long long>(vr.keysTraversed));
 
@@ -289,7 +289,7 @@ void IndexCatalogEntryImpl::forceSetMultikey(OperationContext* const opCtx,
     coll->forceSetIndexIsMultikey(opCtx, _descriptor.get(), isMultikey, multikeyPaths);
 
     // Since multikey metadata has changed, invalidate the query cache.
-    CollectionQueryInfo::get(coll).clearQueryCacheForSetMultikey(coll);
+    CollectionQueryInfo::get(coll).clearQueryCacheForSetMultikey(coll, _descriptor->indexName());
 }
 
 Status IndexCatalogEntryImpl::_setMultikeyInMultiDocumentTransaction(
@@ -412,7 +412,8 @@ void IndexCatalogEntryImpl::_catalogSetMultikey(OperationContext* opCtx,
                     "Index set to multi key, clearing query plan cache",
                     "namespace"_attr = collection->ns(),
                     "keyPattern"_attr = _descriptor->keyPattern());
-        CollectionQueryInfo::get(collection).clearQueryCacheForSetMultikey(collection);
+        CollectionQueryInfo::get(collection)
+            .clearQueryCacheForSetMultikey(collection, _descriptor->indexName());
     }
 }
 
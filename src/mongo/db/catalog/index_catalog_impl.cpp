@@ -177,6 +177,30 @@ Status isSpecOKClusteredIndexCheck(const BSONObj& indexSpec,
     return Status(ErrorCodes::IndexAlreadyExists,
                   "The index already exists implicitly as the collection's clustered index");
 };
+
+/**
+ * Returns true if 'desc' is certain to generate the same keys for 'oldDoc' and 'newDoc', in which
+ * case an update does not need to regenerate and diff them. This is only decided for btree and
+ * hashed indexes without a partial filter, whose keys depend on nothing but the indexed paths:
+ * if the top-level field each indexed path starts in is byte-for-byte unchanged, so are the keys.
+ */
+bool indexKeysUnchangedByUpdate(const IndexDescriptor* desc,
+                                const BSONObj& oldDoc,
+                                const BSONObj& newDoc) {
+    const auto type = desc->getIndexType();
+    if ((type != INDEX_BTREE && type != INDEX_HASHED) || desc->isPartial()) {
+        return false;
+    }
+
+    for (auto&& keyElem : desc->keyPattern()) {
+        const auto path = keyElem.fieldNameStringData();
+        const auto topLevelField = path.substr(0, path.find('.'));
+        if (!oldDoc[topLevelField].binaryEqual(newDoc[topLevelField])) {
+            return false;
+        }
+    }
+    return true;
+}
 }  // namespace
 
 // -------------
@@ -1561,6 +1585,11 @@ Status IndexCatalogImpl::_updateRecord(OperationContext* const opCtx,
                                        const RecordId& recordId,
                                        int64_t* const keysInsertedOut,
                                        int64_t* const keysDeletedOut) const {
+    // Most updates leave most indexes' fields alone. Skip key generation entirely for those.
+    if (indexKeysUnchangedByUpdate(index->descriptor(), oldDoc, newDoc)) {
+        return Status::OK();
+    }
+
     SharedBufferFragmentBuilder pooledBuilder(KeyString::HeapBuilder::kHeapAllocatorDefaultBytes);
 
     InsertDeleteOptions options;
@@ -56,6 +56,7 @@
 #include "mongo/db/timeseries/timeseries_constants.h"
 #include "mongo/db/timeseries/timeseries_index_schema_conversion_functions.h"
 #include "mongo/logv2/log.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/log_and_backoff.h"
@@ -346,6 +347,13 @@ StatusWith<std::vector<BSONObj>> MultiIndexBlock::init(
                       eachIndexBuildMaxMemoryUsageBytes / 1024 / 1024);
 
             index.filterExpression = indexCatalogEntry->getFilterExpression();
+            for (size_t j = 0; index.filterExpression && j + 1 < _indexes.size(); ++j) {
+                if (_indexes[j].filterExpression &&
+                    _indexes[j].filterExpression->equivalent(index.filterExpression)) {
+                    index.sameFilterAs = j;
+                    break;
+                }
+            }
         }
 
         opCtx->recoveryUnit()->onCommit([ns = collection->ns(), this](auto commitTs) {
@@ -710,8 +718,15 @@ Status MultiIndexBlock::_insert(OperationContext* opCtx,
     }
 
     for (size_t i = 0; i < _indexes.size(); i++) {
-        if (_indexes[i].filterExpression && !_indexes[i].filterExpression->matchesBSON(doc)) {
-            continue;
+        auto& index = _indexes[i];
+        if (index.filterExpression) {
+            // Indexes sharing a partial filter only match the document against it once.
+            index.filterMatches = index.sameFilterAs
+                ? _indexes[*index.sameFilterAs].filterMatches
+                : index.filterExpression->matchesBSON(doc);
+            if (!index.filterMatches) {
+                continue;
+            }
         }
 
         Status idxStatus = Status::OK();
@@ -719,13 +734,13 @@ Status MultiIndexBlock::_insert(OperationContext* opCtx,
         // When calling insert, BulkBuilderImpl's Sorter performs file I/O that may result in an
         // exception.
         try {
-            idxStatus = _indexes[i].bulk->insert(opCtx,
-                                                 collection,
-                                                 doc,
-                                                 loc,
-                                                 _indexes[i].options,
-                                                 saveCursorBeforeWrite,
-                                                 restoreCursorAfterWrite);
+            idxStatus = index.bulk->insert(opCtx,
+                                           collection,
+                                           doc,
+                                           loc,
+                                           index.options,
+                                           saveCursorBeforeWrite,
+                                           restoreCursorAfterWrite);
         } catch (...) {
             return exceptionToStatus();
         }
@@ -764,6 +779,17 @@ Status MultiIndexBlock::dumpInsertsFromBulk(
               IndexBuildPhase_serializer(_phase).toString());
     _phase = IndexBuildPhaseEnum::kBulkLoad;
 
+    // Sorting the keys does not need the OperationContext, so it can be done for several indexes
+    // at once. Inserting the sorted keys into each index below stays on this thread.
+    const auto numSortThreads =
+        std::min(_indexes.size(), static_cast<size_t>(indexBuildSortConcurrency.load()));
+    if (numSortThreads > 1) {
+        Status status = _finishSortingInParallel(numSortThreads);
+        if (!status.isOK()) {
+            return status;
+        }
+    }
+
     // Doesn't allow yielding when in a foreground index build.
     const int32_t kYieldIterations =
         isBackgroundBuilding() ? internalIndexBuildBulkLoadYieldIterations.load() : 0;
@@ -820,6 +846,46 @@ Status MultiIndexBlock::dumpInsertsFromBulk(
     return Status::OK();
 }
 
+Status MultiIndexBlock::_finishSortingInParallel(size_t numThreads) {
+    Timer timer;
+    AtomicWord<size_t> nextIndex{0};
+    std::vector<Status> statuses(_indexes.size(), Status::OK());
+    auto sortIndexes = [&] {
+        for (size_t i = nextIndex.fetchAndAdd(1); i < _indexes.size();
+             i = nextIndex.fetchAndAdd(1)) {
+            // The external sorter may throw on file I/O.
+            try {
+                _indexes[i].bulk->finishSorting();
+            } catch (...) {
+                statuses[i] = exceptionToStatus();
+            }
+        }
+    };
+
+    std::vector<stdx::thread> threads;
+    for (size_t i = 1; i < numThreads; ++i) {
+        threads.emplace_back(sortIndexes);
+    }
+    sortIndexes();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    LOGV2(7027513,
+          "Index build: sorted keys from external sorter",
+          "buildUUID"_attr = _buildUUID,
+          "numIndexes"_attr = _indexes.size(),
+          "numThreads"_attr = numThreads,
+          "duration"_attr = duration_cast<Milliseconds>(timer.elapsed()));
+
+    for (auto&& status : statuses) {
+        if (!status.isOK()) {
+            return status;
+        }
+    }
+    return Status::OK();
+}
+
 Status MultiIndexBlock::drainBackgroundWrites(
     OperationContext* opCtx,
     RecoveryUnit::ReadSource readSource,
@@ -984,7 +1050,8 @@ Status MultiIndexBlock::commit(OperationContext* opCtx,
         }
     }
 
-    CollectionQueryInfo::get(collection).clearQueryCache(opCtx, collection);
+    // The built indexes are now ready: evict the cached plans which could use them.
+    CollectionQueryInfo::get(collection).rebuildIndexData(opCtx, collection);
     opCtx->recoveryUnit()->onCommit(
         [this](boost::optional<Timestamp> commitTime) { _buildIsCleanedUp = true; });
 
@@ -185,6 +185,9 @@ public:
      * If 'onDuplicateRecord' is passed as non-NULL and duplicates are not allowed for the index,
      * violators of uniqueness constraints will be handled by 'onDuplicateRecord'.
      *
+     * When building several indexes, the keys of up to 'indexBuildSortConcurrency' indexes are
+     * sorted at the same time before they are inserted into the indexes one after another.
+     *
      * Should not be called inside of a WriteUnitOfWork.
      */
     Status dumpInsertsFromBulk(OperationContext* opCtx, const CollectionPtr& collection);
@@ -313,6 +316,11 @@ private:
         const MatchExpression* filterExpression;  // might be NULL, owned elsewhere
         std::unique_ptr<IndexAccessMethod::BulkBuilder> bulk;
 
+        // Position of an earlier index in '_indexes' with an equivalent 'filterExpression', whose
+        // result for the current document is reused instead of matching the document again.
+        boost::optional<size_t> sameFilterAs;
+        bool filterMatches = true;
+
         InsertDeleteOptions options;
     };
 
@@ -333,6 +341,12 @@ private:
                    const std::function<void()>& saveCursorBeforeWrite,
                    const std::function<void()>& restoreCursorAfterWrite);
 
+    /**
+     * Sorts the keys of every index being built, using up to 'numThreads' threads including the
+     * calling one. Returns the first error encountered.
+     */
+    Status _finishSortingInParallel(size_t numThreads);
+
     /**
      * Performs a collection scan on the given collection and inserts the relevant index keys into
      * the external sorter.
@@ -35,6 +35,7 @@
 #include "mongo/db/catalog_raii.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/repl/replication_coordinator_mock.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/unittest/unittest.h"
 
 namespace mongo {
@@ -140,6 +141,114 @@ TEST_F(MultiIndexBlockTest, CommitAfterInsertingSingleDocument) {
     indexer->abortIndexBuild(operationContext(), coll, MultiIndexBlock::kNoopOnCleanUpFn);
 }
 
+TEST_F(MultiIndexBlockTest, CommitAfterSortingSeveralIndexesConcurrently) {
+    RAIIServerParameterControllerForTest sortConcurrency("indexBuildSortConcurrency", 2);
+
+    auto indexer = getIndexer();
+
+    AutoGetCollection autoColl(operationContext(), getNSS(), MODE_X);
+    CollectionWriter coll(operationContext(), autoColl);
+
+    std::vector<BSONObj> indexSpecs{BSON("v" << 2 << "name"
+                                             << "a_1"
+                                             << "key" << BSON("a" << 1)),
+                                    BSON("v" << 2 << "name"
+                                             << "b_1"
+                                             << "key" << BSON("b" << 1)),
+                                    BSON("v" << 2 << "name"
+                                             << "c_1"
+                                             << "key" << BSON("c" << 1))};
+    auto specs = unittest::assertGet(
+        indexer->init(operationContext(), coll, indexSpecs, MultiIndexBlock::kNoopOnInitFn));
+    ASSERT_EQUALS(3U, specs.size());
+
+    const int numDocs = 10;
+    for (int i = 0; i < numDocs; ++i) {
+        ASSERT_OK(indexer->insertSingleDocumentForInitialSyncOrRecovery(
+            operationContext(),
+            coll.get(),
+            BSON("a" << i << "b" << numDocs - i << "c" << i % 3),
+            RecordId(i + 1),
+            /*saveCursorBeforeWrite*/ []() {},
+            /*restoreCursorAfterWrite*/ []() {}));
+    }
+    ASSERT_OK(indexer->dumpInsertsFromBulk(operationContext(), coll.get()));
+    ASSERT_OK(indexer->checkConstraints(operationContext(), coll.get()));
+
+    {
+        WriteUnitOfWork wunit(operationContext());
+        ASSERT_OK(indexer->commit(operationContext(),
+                                  coll.getWritableCollection(),
+                                  MultiIndexBlock::kNoopOnCreateEachFn,
+                                  MultiIndexBlock::kNoopOnCommitFn));
+        wunit.commit();
+    }
+
+    for (auto&& spec : indexSpecs) {
+        auto indexCatalog = coll->getIndexCatalog();
+        auto desc = indexCatalog->findIndexByName(operationContext(), spec["name"].String());
+        ASSERT(desc);
+        auto iam = indexCatalog->getEntry(desc)->accessMethod()->asSortedData();
+        ASSERT_EQUALS(numDocs, iam->getSortedDataInterface()->numEntries(operationContext()));
+    }
+}
+
+TEST_F(MultiIndexBlockTest, IndexesWithEquivalentPartialFiltersIndexTheSameDocuments) {
+    auto indexer = getIndexer();
+
+    AutoGetCollection autoColl(operationContext(), getNSS(), MODE_X);
+    CollectionWriter coll(operationContext(), autoColl);
+
+    auto filter = BSON("a" << BSON("$gt" << 4));
+    std::vector<BSONObj> indexSpecs{BSON("v" << 2 << "name"
+                                             << "a_1"
+                                             << "key" << BSON("a" << 1)
+                                             << "partialFilterExpression" << filter),
+                                    BSON("v" << 2 << "name"
+                                             << "b_1"
+                                             << "key" << BSON("b" << 1)),
+                                    BSON("v" << 2 << "name"
+                                             << "a_1_b_1"
+                                             << "key" << BSON("a" << 1 << "b" << 1)
+                                             << "partialFilterExpression" << filter)};
+    auto specs = unittest::assertGet(
+        indexer->init(operationContext(), coll, indexSpecs, MultiIndexBlock::kNoopOnInitFn));
+    ASSERT_EQUALS(3U, specs.size());
+
+    const int numDocs = 10;
+    for (int i = 0; i < numDocs; ++i) {
+        ASSERT_OK(indexer->insertSingleDocumentForInitialSyncOrRecovery(
+            operationContext(),
+            coll.get(),
+            BSON("a" << i << "b" << i),
+            RecordId(i + 1),
+            /*saveCursorBeforeWrite*/ []() {},
+            /*restoreCursorAfterWrite*/ []() {}));
+    }
+    ASSERT_OK(indexer->dumpInsertsFromBulk(operationContext(), coll.get()));
+    ASSERT_OK(indexer->checkConstraints(operationContext(), coll.get()));
+
+    {
+        WriteUnitOfWork wunit(operationContext());
+        ASSERT_OK(indexer->commit(operationContext(),
+                                  coll.getWritableCollection(),
+                                  MultiIndexBlock::kNoopOnCreateEachFn,
+                                  MultiIndexBlock::kNoopOnCommitFn));
+        wunit.commit();
+    }
+
+    auto numEntries = [&](StringData indexName) {
+        auto indexCatalog = coll->getIndexCatalog();
+        auto desc = indexCatalog->findIndexByName(operationContext(), indexName);
+        ASSERT(desc);
+        auto iam = indexCatalog->getEntry(desc)->accessMethod()->asSortedData();
+        return iam->getSortedDataInterface()->numEntries(operationContext());
+    };
+    ASSERT_EQUALS(5, numEntries("a_1"));
+    ASSERT_EQUALS(numDocs, numEntries("b_1"));
+    ASSERT_EQUALS(5, numEntries("a_1_b_1"));
+}
+
 TEST_F(MultiIndexBlockTest, AbortWithoutCleanupAfterInsertingSingleDocument) {
     auto indexer = getIndexer();
 
@@ -33,6 +33,7 @@
 
 #include "mongo/db/catalog/validate_adaptor.h"
 
+#include <algorithm>
 #include <fmt/format.h>
 
 #include "mongo/bson/bsonobj.h"
@@ -325,6 +326,13 @@ Status ValidateAdaptor::validateRecord(OperationContext* opCtx,
 }
 
 namespace {
+// Returns the length of the common prefix of the encoded keys of 'lhs' and 'rhs'.
+size_t _sharedKeyPrefixSize(const KeyString::Value& lhs, const KeyString::Value& rhs) {
+    const auto size = std::min(lhs.getSize(), rhs.getSize());
+    return std::mismatch(lhs.getBuffer(), lhs.getBuffer() + size, rhs.getBuffer()).first -
+        lhs.getBuffer();
+}
+
 // Ensures that index entries are in increasing or decreasing order.
 void _validateKeyOrder(OperationContext* opCtx,
                        const IndexCatalogEntry* index,
@@ -461,6 +469,12 @@ void ValidateAdaptor::traverseIndex(OperationContext* opCtx,
             }
         }
 
+        indexResults.keyBytesTraversed += indexEntry->keyString.getSize();
+        if (!isFirstEntry) {
+            indexResults.keyBytesSharedWithPreviousKey +=
+                _sharedKeyPrefixSize(indexEntry->keyString, prevIndexKeyStringValue);
+        }
+
         _progress->hit();
         numKeys++;
         isFirstEntry = false;
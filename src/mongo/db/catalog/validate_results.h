@@ -46,6 +46,10 @@ struct IndexValidateResults {
     std::vector<std::string> warnings;
     int64_t keysTraversed = 0;
     int64_t keysRemovedFromRecordStore = 0;
+    // The total size of the KeyStrings traversed, and how many of those bytes repeat a prefix of
+    // the preceding key. Their difference is roughly what a prefix-compressed key format stores.
+    int64_t keyBytesTraversed = 0;
+    int64_t keyBytesSharedWithPreviousKey = 0;
 };
 
 using ValidateResultsMap = std::map<std::string, IndexValidateResults>;
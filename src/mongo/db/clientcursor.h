@@ -216,6 +216,21 @@ public:
         _nReturnedSoFar = n;
     }
 
+    /**
+     * Increments the cursor's tracked size in bytes of the query results returned so far by 'n'.
+     */
+    void incNBytesReturnedSoFar(std::uint64_t n) {
+        _nBytesReturnedSoFar += n;
+    }
+
+    /**
+     * Returns the average size in bytes of the results returned by this cursor so far, or 0 if no
+     * results have been returned yet.
+     */
+    std::size_t getAverageResultSize() const {
+        return _nReturnedSoFar ? _nBytesReturnedSoFar / _nReturnedSoFar : 0;
+    }
+
     /**
      * Returns the number of batches returned by this cursor so far.
      */
@@ -393,6 +408,10 @@ private:
     // for display in $currentOp output.
     std::uint64_t _nReturnedSoFar = 0;
 
+    // Tracks the total size of the results returned by this cursor so far. Used to size the reply
+    // buffer of subsequent getMores.
+    std::uint64_t _nBytesReturnedSoFar = 0;
+
     // Tracks the number of batches returned by this cursor so far.
     std::uint64_t _nBatchesReturned = 0;
 
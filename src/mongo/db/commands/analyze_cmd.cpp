@@ -0,0 +1,180 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <vector>
+
+#include "mongo/client/dbclient_cursor.h"
+#include "mongo/db/auth/authorization_session.h"
+#include "mongo/db/commands.h"
+#include "mongo/db/commands/analyze_gen.h"
+#include "mongo/db/db_raii.h"
+#include "mongo/db/dbdirectclient.h"
+#include "mongo/db/pipeline/aggregate_command_gen.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/query/stats/histogram.h"
+#include "mongo/db/query/stats/stats_catalog.h"
+#include "mongo/rpc/get_status_from_command_result.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Returns the value of the field 'path' in 'doc', EOO if the field is missing, or the first array
+ * found along the path, since predicates on the path would match the elements of that array.
+ */
+BSONElement extractValue(const BSONObj& doc, StringData path) {
+    BSONObj current = doc;
+    while (true) {
+        const auto dot = path.find('.');
+        auto elem = current.getField(path.substr(0, dot));
+        if (dot == std::string::npos || elem.type() == BSONType::Array) {
+            return elem;
+        }
+        if (elem.type() != BSONType::Object) {
+            return BSONElement();
+        }
+        current = elem.Obj();
+        path = path.substr(dot + 1);
+    }
+}
+
+/**
+ * Builds the statistics of a field of a collection from a sample of its documents and stores them
+ * in the statistics collection 'db.system.statistics.coll', where the planner picks them up.
+ *
+ * {
+ *     analyze: coll,
+ *     key: "a.b",
+ *     sampleSize: 10000,
+ *     numberBuckets: 100,
+ * }
+ */
+class AnalyzeCommand final : public TypedCommand<AnalyzeCommand> {
+public:
+    using Request = AnalyzeCommandRequest;
+
+    std::string help() const override {
+        return "Builds a histogram of the values of a field of a collection, used by the query "
+               "planner for cardinality estimation.";
+    }
+
+    bool adminOnly() const override {
+        return false;
+    }
+
+    AllowedOnSecondary secondaryAllowed(ServiceContext*) const override {
+        return AllowedOnSecondary::kNever;
+    }
+
+    class Invocation final : public InvocationBase {
+    public:
+        using InvocationBase::InvocationBase;
+
+        void typedRun(OperationContext* opCtx) {
+            const auto& nss = request().getNamespace();
+            const auto& key = request().getKey();
+            uassert(ErrorCodes::BadValue,
+                    "The key to analyze must be a non-empty field path",
+                    !key.empty() && key[0] != '$');
+            uassert(ErrorCodes::IllegalOperation,
+                    "Cannot analyze a statistics collection",
+                    !nss.isSystemStatsCollection());
+
+            long long numRecords = 0;
+            {
+                AutoGetCollectionForRead collection(opCtx, nss);
+                uassert(ErrorCodes::NamespaceNotFound,
+                        str::stream() << "Collection " << nss << " does not exist",
+                        collection.getCollection());
+                numRecords = collection->numRecords(opCtx);
+            }
+
+            const long long sampleSize =
+                request().getSampleSize().value_or(internalQueryStatsAnalyzeSampleSize.load());
+            std::vector<BSONObj> pipeline;
+            if (numRecords > sampleSize) {
+                pipeline.push_back(BSON("$sample" << BSON("size" << sampleSize)));
+            }
+            const bool isIdPath = key == "_id" || key.startsWith("_id.");
+            pipeline.push_back(BSON("$project" << (isIdPath ? BSON(key << 1)
+                                                            : BSON("_id" << 0 << key << 1))));
+
+            DBDirectClient client(opCtx);
+            auto cursor = uassertStatusOK(DBClientCursor::fromAggregationRequest(
+                &client,
+                AggregateCommandRequest(nss, std::move(pipeline)),
+                false /* secondaryOk */,
+                false /* useExhaust */));
+
+            std::vector<BSONObj> docs;
+            std::vector<BSONElement> values;
+            while (cursor->more()) {
+                docs.push_back(cursor->next().getOwned());
+                values.push_back(extractValue(docs.back(), key));
+            }
+
+            const int numberBuckets =
+                request().getNumberBuckets().value_or(internalQueryStatsHistogramMaxBuckets.load());
+            const auto histogram = stats::Histogram::build(std::move(values), numberBuckets);
+
+            auto reply = client.updateAcknowledged(
+                nss.makeStatisticsNamespace().ns(),
+                BSON("_id" << key),
+                BSON("_id" << key << "statistics" << histogram.toBSON()),
+                true /* upsert */);
+            uassertStatusOK(getStatusFromWriteCommandReply(reply));
+
+            stats::StatsCatalog::get(opCtx).invalidate(nss);
+        }
+
+    private:
+        NamespaceString ns() const override {
+            return request().getNamespace();
+        }
+
+        bool supportsWriteConcern() const override {
+            return true;
+        }
+
+        void doCheckAuthorization(OperationContext* opCtx) const override {
+            uassert(ErrorCodes::Unauthorized,
+                    "Unauthorized",
+                    AuthorizationSession::get(opCtx->getClient())
+                        ->isAuthorizedForActionsOnResource(
+                            ResourcePattern::forExactNamespace(request().getNamespace()),
+                            ActionType::analyze));
+        }
+    };
+
+} analyzeCmd;
+
+}  // namespace
+}  // namespace mongo
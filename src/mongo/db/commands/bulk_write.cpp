@@ -0,0 +1,362 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <vector>
+
+#include "mongo/db/auth/authorization_session.h"
+#include "mongo/db/commands.h"
+#include "mongo/db/commands/bulk_write_gen.h"
+#include "mongo/db/not_primary_error_tracker.h"
+#include "mongo/db/ops/write_ops_exec.h"
+#include "mongo/db/server_feature_flags_gen.h"
+#include "mongo/db/server_options.h"
+#include "mongo/stdx/variant.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+namespace {
+
+using BulkWriteOp = stdx::variant<BulkWriteInsertOp, BulkWriteUpdateOp, BulkWriteDeleteOp>;
+
+BulkWriteOp parseOp(const BSONObj& op) {
+    IDLParserErrorContext ctx("bulkWrite.ops");
+    const auto opName = op.firstElementFieldNameStringData();
+    if (opName == BulkWriteInsertOp::kNsInfoIdxFieldName) {
+        return BulkWriteInsertOp::parse(ctx, op);
+    }
+    if (opName == BulkWriteUpdateOp::kNsInfoIdxFieldName) {
+        return BulkWriteUpdateOp::parse(ctx, op);
+    }
+    uassert(7027503,
+            str::stream() << "Unrecognized bulkWrite operation: " << op,
+            opName == BulkWriteDeleteOp::kNsInfoIdxFieldName);
+    return BulkWriteDeleteOp::parse(ctx, op);
+}
+
+int getNsInfoIdx(const BulkWriteOp& op) {
+    return stdx::visit([](const auto& op) { return op.getNsInfoIdx(); }, op);
+}
+
+/**
+ * Accumulates the per-operation results and the totals of a bulkWrite command.
+ */
+class BulkWriteReplyBuilder {
+public:
+    void addError(size_t idx, const Status& status) {
+        BulkWriteReplyItem item(0, idx);
+        item.setCode(static_cast<int>(status.code()));
+        item.setErrmsg(status.reason());
+        _results.push_back(std::move(item));
+        ++_nErrors;
+    }
+
+    void addInsert(size_t idx, const SingleWriteResult& result) {
+        BulkWriteReplyItem item(1, idx);
+        item.setN(result.getN());
+        _results.push_back(std::move(item));
+        _nInserted += result.getN();
+    }
+
+    void addUpdate(size_t idx, const SingleWriteResult& result) {
+        BulkWriteReplyItem item(1, idx);
+        item.setN(result.getN());
+        item.setNModified(result.getNModified());
+        if (auto idElement = result.getUpsertedId().firstElement()) {
+            item.setUpserted(IDLAnyTypeOwned(idElement));
+            ++_nUpserted;
+        } else {
+            _nMatched += result.getN();
+        }
+        _nModified += result.getNModified();
+        _results.push_back(std::move(item));
+    }
+
+    void addDelete(size_t idx, const SingleWriteResult& result) {
+        BulkWriteReplyItem item(1, idx);
+        item.setN(result.getN());
+        _results.push_back(std::move(item));
+        _nDeleted += result.getN();
+    }
+
+    BulkWriteCommandReply done() {
+        return BulkWriteCommandReply(std::move(_results),
+                                     _nErrors,
+                                     _nInserted,
+                                     _nMatched,
+                                     _nModified,
+                                     _nUpserted,
+                                     _nDeleted);
+    }
+
+private:
+    std::vector<BulkWriteReplyItem> _results;
+    int _nErrors = 0;
+    int _nInserted = 0;
+    int _nMatched = 0;
+    int _nModified = 0;
+    int _nUpserted = 0;
+    int _nDeleted = 0;
+};
+
+/**
+ * Runs a mixed list of inserts, updates and deletes against any number of collections in a single
+ * round trip.
+ *
+ * {
+ *     bulkWrite: 1,
+ *     ops: [{insert: 0, document: {...}},
+ *           {update: 1, filter: {...}, updateMods: {...}, multi: <bool>, upsert: <bool>},
+ *           {delete: 0, filter: {...}, multi: <bool>}],
+ *     nsInfo: [{ns: "db.coll1"}, {ns: "db.coll2"}],
+ *     ordered: <bool>,
+ * }
+ *
+ * Consecutive operations of the same kind on the same collection are executed together as a
+ * single insert, update or delete batch, so they share the lock acquisitions and grouped storage
+ * transactions of the regular write commands. Sending the operations for the same collection next
+ * to each other therefore gives the best throughput.
+ */
+class BulkWriteCmd final : public TypedCommand<BulkWriteCmd> {
+public:
+    using Request = BulkWriteCommandRequest;
+    using Reply = BulkWriteCommandReply;
+
+    std::string help() const override {
+        return "Runs inserts, updates and deletes across multiple collections in one command";
+    }
+
+    bool adminOnly() const override {
+        return true;
+    }
+
+    AllowedOnSecondary secondaryAllowed(ServiceContext*) const override {
+        return AllowedOnSecondary::kNever;
+    }
+
+    ReadWriteType getReadWriteType() const override {
+        return ReadWriteType::kWrite;
+    }
+
+    bool collectsResourceConsumptionMetrics() const override {
+        return true;
+    }
+
+    class Invocation final : public InvocationBase {
+    public:
+        Invocation(OperationContext* opCtx,
+                   const Command* command,
+                   const OpMsgRequest& opMsgRequest)
+            : InvocationBase(opCtx, command, opMsgRequest) {
+            uassert(
+                ErrorCodes::IllegalOperation,
+                "featureFlagBulkWriteCommand not enabled",
+                gFeatureFlagBulkWriteCommand.isEnabled(serverGlobalParams.featureCompatibility));
+
+            const auto numNamespaces = request().getNsInfo().size();
+            _ops.reserve(request().getOps().size());
+            for (const auto& op : request().getOps()) {
+                _ops.push_back(parseOp(op));
+                uassert(ErrorCodes::BadValue,
+                        str::stream() << "bulkWrite operation refers to nsInfo index "
+                                      << getNsInfoIdx(_ops.back()) << ", but only "
+                                      << numNamespaces << " namespaces were given",
+                        static_cast<size_t>(getNsInfoIdx(_ops.back())) < numNamespaces);
+            }
+        }
+
+        Reply typedRun(OperationContext* opCtx) try {
+            uassert(ErrorCodes::OperationNotSupportedInTransaction,
+                    "bulkWrite is not supported in multi-document transactions",
+                    !opCtx->inMultiDocumentTransaction());
+
+            BulkWriteReplyBuilder reply;
+            size_t groupStart = 0;
+            while (groupStart < _ops.size()) {
+                // Extend the group over the following operations of the same kind on the same
+                // collection.
+                size_t groupEnd = groupStart + 1;
+                while (groupEnd < _ops.size() &&
+                       _ops[groupEnd].index() == _ops[groupStart].index() &&
+                       getNsInfoIdx(_ops[groupEnd]) == getNsInfoIdx(_ops[groupStart])) {
+                    ++groupEnd;
+                }
+
+                const auto& nss = request().getNsInfo()[getNsInfoIdx(_ops[groupStart])].getNs();
+                write_ops_exec::WriteResult result;
+                if (stdx::holds_alternative<BulkWriteInsertOp>(_ops[groupStart])) {
+                    result = _performInserts(opCtx, nss, groupStart, groupEnd);
+                } else if (stdx::holds_alternative<BulkWriteUpdateOp>(_ops[groupStart])) {
+                    result = _performUpdates(opCtx, nss, groupStart, groupEnd);
+                } else {
+                    result = _performDeletes(opCtx, nss, groupStart, groupEnd);
+                }
+
+                bool failed = false;
+                for (size_t i = 0; i < result.results.size(); ++i) {
+                    const size_t idx = groupStart + i;
+                    const auto& swResult = result.results[i];
+                    if (!swResult.isOK()) {
+                        failed = true;
+                        reply.addError(idx, swResult.getStatus());
+                    } else if (stdx::holds_alternative<BulkWriteInsertOp>(_ops[idx])) {
+                        reply.addInsert(idx, swResult.getValue());
+                    } else if (stdx::holds_alternative<BulkWriteUpdateOp>(_ops[idx])) {
+                        reply.addUpdate(idx, swResult.getValue());
+                    } else {
+                        reply.addDelete(idx, swResult.getValue());
+                    }
+                }
+
+                // The batch stops short of the group when an ordered write fails or when a batch
+                // level error (e.g. a stale shard version) makes it unsafe to continue.
+                if ((failed && request().getOrdered()) || !result.canContinue ||
+                    result.results.size() < groupEnd - groupStart) {
+                    break;
+                }
+                groupStart = groupEnd;
+            }
+
+            return reply.done();
+        } catch (const DBException& ex) {
+            NotPrimaryErrorTracker::get(opCtx->getClient()).recordError(ex.code());
+            throw;
+        }
+
+    private:
+        NamespaceString ns() const override {
+            return NamespaceString(request().getDbName(), "");
+        }
+
+        bool supportsWriteConcern() const override {
+            return true;
+        }
+
+        void doCheckAuthorization(OperationContext* opCtx) const override {
+            // Gather the actions each collection needs from the operations that target it.
+            std::vector<ActionSet> actions(request().getNsInfo().size());
+            if (request().getBypassDocumentValidation()) {
+                for (auto& actionSet : actions) {
+                    actionSet.addAction(ActionType::bypassDocumentValidation);
+                }
+            }
+            for (const auto& op : _ops) {
+                auto& actionSet = actions[getNsInfoIdx(op)];
+                if (stdx::holds_alternative<BulkWriteInsertOp>(op)) {
+                    actionSet.addAction(ActionType::insert);
+                } else if (auto update = stdx::get_if<BulkWriteUpdateOp>(&op)) {
+                    actionSet.addAction(ActionType::update);
+                    if (update->getUpsert()) {
+                        actionSet.addAction(ActionType::insert);
+                    }
+                } else {
+                    actionSet.addAction(ActionType::remove);
+                }
+            }
+
+            auto as = AuthorizationSession::get(opCtx->getClient());
+            for (size_t i = 0; i < actions.size(); ++i) {
+                const auto& nss = request().getNsInfo()[i].getNs();
+                uassert(ErrorCodes::Unauthorized,
+                        str::stream() << "Not authorized to run bulkWrite on " << nss.ns(),
+                        as->isAuthorizedForActionsOnResource(
+                            ResourcePattern::forExactNamespace(nss), actions[i]));
+            }
+        }
+
+        write_ops::WriteCommandRequestBase _makeWriteCommandBase() const {
+            write_ops::WriteCommandRequestBase base;
+            base.setOrdered(request().getOrdered());
+            base.setBypassDocumentValidation(request().getBypassDocumentValidation());
+            return base;
+        }
+
+        write_ops_exec::WriteResult _performInserts(OperationContext* opCtx,
+                                                    const NamespaceString& nss,
+                                                    size_t begin,
+                                                    size_t end) const {
+            std::vector<BSONObj> documents;
+            documents.reserve(end - begin);
+            for (size_t i = begin; i < end; ++i) {
+                documents.push_back(stdx::get<BulkWriteInsertOp>(_ops[i]).getDocument());
+            }
+
+            write_ops::InsertCommandRequest insertOp(nss, std::move(documents));
+            insertOp.setWriteCommandRequestBase(_makeWriteCommandBase());
+            return write_ops_exec::performInserts(opCtx, insertOp);
+        }
+
+        write_ops_exec::WriteResult _performUpdates(OperationContext* opCtx,
+                                                    const NamespaceString& nss,
+                                                    size_t begin,
+                                                    size_t end) const {
+            std::vector<write_ops::UpdateOpEntry> updates;
+            updates.reserve(end - begin);
+            for (size_t i = begin; i < end; ++i) {
+                const auto& op = stdx::get<BulkWriteUpdateOp>(_ops[i]);
+                write_ops::UpdateOpEntry entry(op.getFilter(), op.getUpdateMods());
+                entry.setArrayFilters(op.getArrayFilters());
+                entry.setMulti(op.getMulti());
+                entry.setUpsert(op.getUpsert());
+                entry.setHint(op.getHint());
+                entry.setCollation(op.getCollation());
+                updates.push_back(std::move(entry));
+            }
+
+            write_ops::UpdateCommandRequest updateOp(nss, std::move(updates));
+            updateOp.setWriteCommandRequestBase(_makeWriteCommandBase());
+            return write_ops_exec::performUpdates(opCtx, updateOp);
+        }
+
+        write_ops_exec::WriteResult _performDeletes(OperationContext* opCtx,
+                                                    const NamespaceString& nss,
+                                                    size_t begin,
+                                                    size_t end) const {
+            std::vector<write_ops::DeleteOpEntry> deletes;
+            deletes.reserve(end - begin);
+            for (size_t i = begin; i < end; ++i) {
+                const auto& op = stdx::get<BulkWriteDeleteOp>(_ops[i]);
+                write_ops::DeleteOpEntry entry(op.getFilter(), op.getMulti());
+                entry.setHint(op.getHint());
+                entry.setCollation(op.getCollation());
+                deletes.push_back(std::move(entry));
+            }
+
+            write_ops::DeleteCommandRequest deleteOp(nss, std::move(deletes));
+            deleteOp.setWriteCommandRequestBase(_makeWriteCommandBase());
+            return write_ops_exec::performDeletes(opCtx, deleteOp);
+        }
+
+        std::vector<BulkWriteOp> _ops;
+    };
+} bulkWriteCmd;
+
+}  // namespace
+}  // namespace mongo
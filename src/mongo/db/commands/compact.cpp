@@ -69,8 +69,9 @@ public:
         return "compact collection\n"
                "warning: this operation locks the database and is slow. you can cancel with "
                "killOp()\n"
-               "{ compact : <collection_name>, [force:<bool>] }\n"
-               "  force - allows to run on a replica set primary\n";
+               "{ compact : <collection_name>, [force:<bool>], [dryRun:<bool>] }\n"
+               "  force - allows to run on a replica set primary\n"
+               "  dryRun - only estimate the number of bytes compaction could free\n";
     }
     CompactCmd() : ErrmsgCommandDeprecated("compact") {}
 
@@ -81,6 +82,13 @@ public:
                            BSONObjBuilder& result) {
         NamespaceString nss = CommandHelpers::parseNsCollectionRequired(db, cmdObj);
 
+        if (cmdObj["dryRun"].trueValue()) {
+            // A dry run only reads storage statistics, so it may run anywhere.
+            auto estimate = uassertStatusOK(estimateCompactBytesFreed(opCtx, nss));
+            result.appendNumber("estimatedBytesFreed", static_cast<long long>(estimate));
+            return true;
+        }
+
         repl::ReplicationCoordinator* replCoord = repl::ReplicationCoordinator::get(opCtx);
         if (replCoord->getMemberState().primary() && !cmdObj["force"].trueValue()) {
             errmsg =
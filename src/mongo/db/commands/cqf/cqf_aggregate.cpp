@@ -33,6 +33,7 @@
 #include "mongo/db/exec/sbe/abt/abt_lower.h"
 #include "mongo/db/pipeline/abt/abt_document_source_visitor.h"
 #include "mongo/db/pipeline/abt/match_expression_visitor.h"
+#include "mongo/db/query/ce/ce_histogram.h"
 #include "mongo/db/query/ce/ce_sampling.h"
 #include "mongo/db/query/optimizer/cascades/ce_heuristic.h"
 #include "mongo/db/query/optimizer/cascades/cost_derivation.h"
@@ -393,6 +394,21 @@ std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> getSBEExecutorViaCascadesOp
     std::cerr << ExplainGenerator::explainV2(abtTree) << std::endl;
     std::cerr << "******* Translated ABT **********\n";
 
+    if (collectionExists && numRecords > 0 &&
+        internalQueryEnableHistogramCardinalityEstimator.load()) {
+        OptPhaseManager phaseManager{OptPhaseManager::getAllRewritesSet(),
+                                     prefixId,
+                                     false /*requireRID*/,
+                                     std::move(metadata),
+                                     std::make_unique<CEHistogramTransport>(opCtx, nss),
+                                     std::make_unique<DefaultCosting>(),
+                                     DebugInfo::kDefaultForProd};
+        phaseManager.getHints() = queryHints;
+
+        return optimizeAndCreateExecutor(
+            phaseManager, std::move(abtTree), opCtx, expCtx, nss, collection);
+    }
+
     if (collectionExists && numRecords > 0 &&
         internalQueryEnableSamplingCardinalityEstimator.load()) {
         Metadata metadataForSampling = metadata;
@@ -42,6 +42,7 @@
 #include "mongo/db/cursor_manager.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/exec/disk_use_options_gen.h"
+#include "mongo/db/exec/queued_data_stage.h"
 #include "mongo/db/exec/working_set_common.h"
 #include "mongo/db/fle_crud.h"
 #include "mongo/db/matcher/extensions_callback_real.h"
@@ -53,7 +54,10 @@
 #include "mongo/db/query/find.h"
 #include "mongo/db/query/find_common.h"
 #include "mongo/db/query/get_executor.h"
+#include "mongo/db/query/plan_executor_factory.h"
 #include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/query/query_planner_common.h"
+#include "mongo/db/query/query_result_cache.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/stats/counters.h"
@@ -197,6 +201,95 @@ void beginQueryOp(OperationContext* opCtx, const NamespaceString& nss, const BSO
     curOp->setNS_inlock(nss.ns());
 }
 
+/**
+ * Returns true if the results of "cq" may be served from, and stored in, the query result cache.
+ * Only reads of the latest data outside of transactions qualify, and queries whose results may
+ * change without a write to the collection do not.
+ */
+bool canUseQueryResultCache(OperationContext* opCtx,
+                            const CollectionPtr& collection,
+                            const CanonicalQuery& cq) {
+    if (!collection || collection->isCapped() ||
+        !QueryResultCache::isEnabledForNamespace(collection->ns())) {
+        return false;
+    }
+
+    // On shards the results also depend on the routing metadata used for orphan filtering.
+    if (serverGlobalParams.clusterRole == ClusterRole::ShardServer) {
+        return false;
+    }
+
+    if (opCtx->inMultiDocumentTransaction() ||
+        opCtx->recoveryUnit()->getTimestampReadSource() !=
+            RecoveryUnit::ReadSource::kNoTimestamp) {
+        return false;
+    }
+
+    const auto& findCommand = cq.getFindCommandRequest();
+    if (findCommand.getTailable() || findCommand.getRequestResumeToken() ||
+        !findCommand.getResumeAfter().isEmpty()) {
+        return false;
+    }
+
+    // Aggregation expressions and metadata may depend on the time or on randomness.
+    return !QueryPlannerCommon::hasNode(cq.root(), MatchExpression::EXPRESSION) &&
+        !QueryPlannerCommon::hasNode(cq.root(), MatchExpression::WHERE) &&
+        !(cq.getProj() && cq.getProj()->hasExpressions()) && cq.metadataDeps().none();
+}
+
+/**
+ * Returns the query result cache key for "cq", which identifies the query and all of its
+ * parameters.
+ */
+std::string makeQueryResultCacheKey(const CanonicalQuery& cq) {
+    const auto& findCommand = cq.getFindCommandRequest();
+
+    BSONObjBuilder bob;
+    bob.append("filter", cq.root()->serialize());
+    bob.append("projection", findCommand.getProjection());
+    bob.append("sort", findCommand.getSort());
+    bob.append("hint", findCommand.getHint());
+    bob.append("min", findCommand.getMin());
+    bob.append("max", findCommand.getMax());
+    bob.append("collation", findCommand.getCollation());
+    if (auto skip = findCommand.getSkip()) {
+        bob.append("skip", static_cast<long long>(*skip));
+    }
+    if (auto limit = findCommand.getLimit()) {
+        bob.append("limit", static_cast<long long>(*limit));
+    }
+    bob.append("returnKey", findCommand.getReturnKey());
+    bob.append("showRecordId", findCommand.getShowRecordId());
+
+    auto key = bob.done();
+    return std::string(key.objdata(), key.objsize());
+}
+
+/**
+ * Returns an executor which produces "results", the cached results of "cq".
+ */
+std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> makeExecutorForCachedResults(
+    const CollectionPtr* collection,
+    std::unique_ptr<CanonicalQuery> cq,
+    const std::vector<BSONObj>& results) {
+    auto ws = std::make_unique<WorkingSet>();
+    auto root = std::make_unique<QueuedDataStage>(cq->getExpCtxRaw(), ws.get());
+    for (auto&& obj : results) {
+        WorkingSetID id = ws->allocate();
+        WorkingSetMember* member = ws->get(id);
+        member->resetDocument(SnapshotId(), obj);
+        member->transitionToOwnedObj();
+        root->pushBack(id);
+    }
+
+    return uassertStatusOK(plan_executor_factory::make(std::move(cq),
+                                                       std::move(ws),
+                                                       std::move(root),
+                                                       collection,
+                                                       PlanYieldPolicy::YieldPolicy::YIELD_AUTO,
+                                                       QueryPlannerParams::DEFAULT));
+}
+
 /**
  * A command for running .find() queries.
  */
@@ -494,6 +587,10 @@ public:
                 }
             }
 
+            // Results can only be added to the query result cache if no write to the collection
+            // has committed since this epoch, so it must be read before the snapshot is opened.
+            const auto resultCacheEpoch = QueryResultCache::get(opCtx).getEpoch();
+
             // Acquire locks. If the query is on a view, we release our locks and convert the query
             // request into an aggregation command.
             boost::optional<AutoGetCollectionForReadCommandMaybeLockFree> ctx;
@@ -593,20 +690,38 @@ public:
             uassertStatusOK(replCoord->checkCanServeReadsFor(
                 opCtx, nss, ReadPreferenceSetting::get(opCtx).canRunOnSecondary()));
 
-            if (cq->getFindCommandRequest().getReadOnce()) {
+            if (FindCommon::shouldReadOnce(opCtx,
+                                           nss,
+                                           cq->getFindCommandRequest().getReadOnce(),
+                                           cq->getFindCommandRequest().getTailable())) {
                 // The readOnce option causes any storage-layer cursors created during plan
                 // execution to assume read data will not be needed again and need not be cached.
                 opCtx->recoveryUnit()->setReadOnce(true);
             }
 
+            // Serve the query from the result cache if the collection opted in and the cache holds
+            // current results. Otherwise remember the key to cache the results under.
+            boost::optional<std::string> resultCacheKey;
+            boost::optional<std::vector<BSONObj>> cachedResults;
+            if (canUseQueryResultCache(opCtx, collection, *cq)) {
+                resultCacheKey = makeQueryResultCacheKey(*cq);
+                cachedResults =
+                    QueryResultCache::get(opCtx).lookup(collection->uuid(), *resultCacheKey);
+            }
+
             // Get the execution plan for the query.
             bool permitYield = true;
-            auto exec =
-                uassertStatusOK(getExecutorFind(opCtx,
-                                                &collection,
-                                                std::move(cq),
-                                                nullptr /* extractAndAttachPipelineStages */,
-                                                permitYield));
+            std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> exec;
+            if (cachedResults) {
+                exec = makeExecutorForCachedResults(&collection, std::move(cq), *cachedResults);
+                resultCacheKey.reset();
+            } else {
+                exec = uassertStatusOK(getExecutorFind(opCtx,
+                                                       &collection,
+                                                       std::move(cq),
+                                                       nullptr /* extractAndAttachPipelineStages */,
+                                                       permitYield));
+            }
 
             // If the executor supports it, find operations will maintain the storage engine state
             // across commands.
@@ -648,8 +763,10 @@ public:
             BSONObj obj;
             PlanExecutor::ExecState state = PlanExecutor::ADVANCED;
             std::uint64_t numResults = 0;
+            std::uint64_t numBytes = 0;
             bool stashedResult = false;
             ResourceConsumption::DocumentUnitCounter docUnitsReturned;
+            std::vector<BSONObj> resultsToCache;
 
             try {
                 while (!FindCommon::enoughForFirstBatch(originalFC, numResults) &&
@@ -665,10 +782,26 @@ public:
                     // If this executor produces a postBatchResumeToken, add it to the response.
                     firstBatch.setPostBatchResumeToken(exec->getPostBatchResumeToken());
 
+                    // At this point, we know that there will be at least one document in this
+                    // batch. Reserve an initial estimated number of bytes for the response, as
+                    // getMore does, so that a large batch is not copied every time the reply
+                    // buffer outgrows its capacity.
+                    if (numResults == 0) {
+                        if (auto bytesToReserve = FindCommon::getBytesToReserveForFirstBatch(
+                                originalFC, obj.objsize())) {
+                            firstBatch.reserveReplyBuffer(bytesToReserve);
+                        }
+                    }
+
                     // Add result to output buffer.
                     firstBatch.append(obj);
                     numResults++;
+                    numBytes += obj.objsize();
                     docUnitsReturned.observeOne(obj.objsize());
+
+                    if (resultCacheKey) {
+                        resultsToCache.push_back(obj.getOwned());
+                    }
                 }
             } catch (DBException& exception) {
                 firstBatch.abandon();
@@ -693,6 +826,14 @@ public:
                 firstBatch.setPostBatchResumeToken(exec->getPostBatchResumeToken());
             }
 
+            // Cache the results if the query ran to completion within the first batch.
+            if (resultCacheKey && state == PlanExecutor::IS_EOF && !stashedResult) {
+                QueryResultCache::get(opCtx).add(collection->uuid(),
+                                                 *resultCacheKey,
+                                                 resultCacheEpoch,
+                                                 std::move(resultsToCache));
+            }
+
             // Set up the cursor for getMore.
             CursorId cursorId = 0;
             if (shouldSaveCursor(opCtx, collection, state, exec.get())) {
@@ -726,6 +867,7 @@ public:
                         opCtx->getRemainingMaxTimeMicros());
                 }
                 pinnedCursor.getCursor()->setNReturnedSoFar(numResults);
+                pinnedCursor.getCursor()->incNBytesReturnedSoFar(numBytes);
                 pinnedCursor.getCursor()->incNBatches();
 
                 // Fill out curop based on the results.
@@ -382,6 +382,7 @@ public:
             BSONObj obj;
             PlanExecutor::ExecState state;
             size_t batchSize = cmd.getBatchSize().value_or(0);
+            std::uint64_t numBytes = 0;
             try {
                 while (!FindCommon::enoughForGetMore(batchSize, *numResults) &&
                        PlanExecutor::ADVANCED == (state = exec->getNext(&obj, nullptr))) {
@@ -399,15 +400,19 @@ public:
                     nextBatch->setPostBatchResumeToken(exec->getPostBatchResumeToken());
 
                     // At this point, we know that there will be at least one document in this
-                    // batch. Reserve an initial estimated number of bytes for the response.
+                    // batch. Reserve an initial estimated number of bytes for the response, sized
+                    // by the average result returned by earlier batches of this cursor.
                     if (*numResults == 0) {
                         auto bytesToReserve = FindCommon::getBytesToReserveForGetMoreReply(
-                            isTailable, obj.objsize(), batchSize);
+                            isTailable,
+                            std::max<size_t>(obj.objsize(), cursor->getAverageResultSize()),
+                            batchSize);
                         nextBatch->reserveReplyBuffer(bytesToReserve);
                     }
 
                     nextBatch->append(obj);
                     (*numResults)++;
+                    numBytes += obj.objsize();
                     docUnitsReturned->observeOne(obj.objsize());
                 }
             } catch (const ExceptionFor<ErrorCodes::CloseChangeStream>&) {
@@ -440,6 +445,8 @@ public:
                 throw;
             }
 
+            cursor->incNBytesReturnedSoFar(numBytes);
+
             if (state == PlanExecutor::IS_EOF) {
                 // The latest oplog timestamp may advance even when there are no results. Ensure
                 // that we have the latest postBatchResumeToken produced by the plan executor.
@@ -569,7 +576,10 @@ public:
 
             PlanExecutor* exec = cursorPin->getExecutor();
             const auto* cq = exec->getCanonicalQuery();
-            if (cq && cq->getFindCommandRequest().getReadOnce()) {
+            if (FindCommon::shouldReadOnce(opCtx,
+                                           nss,
+                                           cq && cq->getFindCommandRequest().getReadOnce(),
+                                           cursorPin->isTailable())) {
                 // The readOnce option causes any storage-layer cursors created during plan
                 // execution to assume read data will not be needed again and need not be cached.
                 opCtx->recoveryUnit()->setReadOnce(true);
@@ -0,0 +1,196 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <string>
+#include <vector>
+
+#include "mongo/db/auth/authorization_session.h"
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/commands.h"
+#include "mongo/db/db_raii.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/pipeline/materialized_group_catalog.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+namespace {
+
+constexpr auto kCreateField = "create"_sd;
+constexpr auto kDropField = "drop"_sd;
+constexpr auto kLookupField = "lookup"_sd;
+
+std::vector<BSONObj> parsePipeline(const BSONObj& cmdObj) {
+    auto pipelineElem = cmdObj["pipeline"];
+    uassert(ErrorCodes::TypeMismatch,
+            "'pipeline' must be an array of stage specifications",
+            pipelineElem.type() == BSONType::Array);
+
+    std::vector<BSONObj> pipeline;
+    for (auto&& stageElem : pipelineElem.Obj()) {
+        uassert(ErrorCodes::TypeMismatch,
+                "Each element of 'pipeline' must be an object",
+                stageElem.type() == BSONType::Object);
+        pipeline.push_back(stageElem.Obj().getOwned());
+    }
+    return pipeline;
+}
+
+/**
+ * The 'materializedGroup' command manages the materialized $group pipelines of a collection and
+ * reads from them. A materialized group is maintained incrementally as the collection is written
+ * to, so that reading the result of its pipeline for one group key is a point lookup:
+ *
+ *    {materializedGroup: <collection>, create: <name>, pipeline: [{$match: ...}, {$group: ...}]}
+ *    {materializedGroup: <collection>, drop: <name>}
+ *    {materializedGroup: <collection>, lookup: <name>, key: <group _id>}
+ *
+ * The state and maintenance cost of the materialized groups are reported by collStats.
+ */
+class MaterializedGroupCommand final : public BasicCommand {
+public:
+    MaterializedGroupCommand() : BasicCommand("materializedGroup") {}
+
+    bool run(OperationContext* opCtx,
+             const std::string& dbname,
+             const BSONObj& cmdObj,
+             BSONObjBuilder& result) override;
+
+    bool supportsWriteConcern(const BSONObj& cmd) const override {
+        return false;
+    }
+
+    AllowedOnSecondary secondaryAllowed(ServiceContext*) const override {
+        return AllowedOnSecondary::kOptIn;
+    }
+
+    Status checkAuthForCommand(Client* client,
+                               const std::string& dbname,
+                               const BSONObj& cmdObj) const override;
+
+    std::string help() const override {
+        return "Creates, drops or reads from a materialized $group pipeline of a collection.";
+    }
+
+private:
+    void _create(OperationContext* opCtx, const NamespaceString& nss, const BSONObj& cmdObj);
+    void _drop(OperationContext* opCtx, const NamespaceString& nss, const BSONObj& cmdObj);
+    void _lookup(OperationContext* opCtx,
+                 const NamespaceString& nss,
+                 const BSONObj& cmdObj,
+                 BSONObjBuilder* result);
+} materializedGroupCommand;
+
+Status MaterializedGroupCommand::checkAuthForCommand(Client* client,
+                                                     const std::string& dbname,
+                                                     const BSONObj& cmdObj) const {
+    AuthorizationSession* authzSession = AuthorizationSession::get(client);
+    ResourcePattern pattern = parseResourcePattern(dbname, cmdObj);
+
+    const auto action = cmdObj.hasField(kLookupField) ? ActionType::find : ActionType::collMod;
+    if (authzSession->isAuthorizedForActionsOnResource(pattern, action)) {
+        return Status::OK();
+    }
+
+    return Status(ErrorCodes::Unauthorized, "unauthorized");
+}
+
+bool MaterializedGroupCommand::run(OperationContext* opCtx,
+                                   const std::string& dbname,
+                                   const BSONObj& cmdObj,
+                                   BSONObjBuilder& result) {
+    const NamespaceString nss(CommandHelpers::parseNsCollectionRequired(dbname, cmdObj));
+
+    const int numModes = cmdObj.hasField(kCreateField) + cmdObj.hasField(kDropField) +
+        cmdObj.hasField(kLookupField);
+    uassert(ErrorCodes::BadValue,
+            "Exactly one of 'create', 'drop' and 'lookup' must be specified",
+            numModes == 1);
+
+    if (cmdObj.hasField(kCreateField)) {
+        _create(opCtx, nss, cmdObj);
+    } else if (cmdObj.hasField(kDropField)) {
+        _drop(opCtx, nss, cmdObj);
+    } else {
+        _lookup(opCtx, nss, cmdObj, &result);
+    }
+    return true;
+}
+
+void MaterializedGroupCommand::_create(OperationContext* opCtx,
+                                       const NamespaceString& nss,
+                                       const BSONObj& cmdObj) {
+    const auto name = cmdObj[kCreateField].String();
+    auto pipeline = parsePipeline(cmdObj);
+
+    // Block writes to the collection while it is scanned and the materialized group registered.
+    AutoGetCollection collection(opCtx, nss, MODE_S);
+    uassert(ErrorCodes::NamespaceNotFound,
+            str::stream() << "Collection " << nss << " does not exist",
+            collection);
+
+    MaterializedGroupCatalog::get(opCtx).create(
+        opCtx, collection.getCollection(), name, std::move(pipeline));
+}
+
+void MaterializedGroupCommand::_drop(OperationContext* opCtx,
+                                     const NamespaceString& nss,
+                                     const BSONObj& cmdObj) {
+    const auto name = cmdObj[kDropField].String();
+
+    AutoGetCollectionForReadCommand collection(opCtx, nss);
+    uassert(ErrorCodes::NamespaceNotFound,
+            str::stream() << "Collection " << nss << " does not exist",
+            collection.getCollection());
+    uassert(ErrorCodes::NamespaceNotFound,
+            str::stream() << "No materialized group named '" << name << "' on " << nss,
+            MaterializedGroupCatalog::get(opCtx).drop(collection->uuid(), name));
+}
+
+void MaterializedGroupCommand::_lookup(OperationContext* opCtx,
+                                       const NamespaceString& nss,
+                                       const BSONObj& cmdObj,
+                                       BSONObjBuilder* result) {
+    const auto name = cmdObj[kLookupField].String();
+    auto keyElem = cmdObj["key"];
+    const Value key = keyElem.eoo() ? Value(BSONNULL) : Value(keyElem);
+
+    AutoGetCollectionForReadCommand collection(opCtx, nss);
+    uassert(ErrorCodes::NamespaceNotFound,
+            str::stream() << "Collection " << nss << " does not exist",
+            collection.getCollection());
+
+    if (auto group = MaterializedGroupCatalog::get(opCtx).lookup(collection->uuid(), name, key)) {
+        result->append("group", group->toBson());
+    }
+}
+
+}  // namespace
+}  // namespace mongo
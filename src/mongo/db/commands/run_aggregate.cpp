@@ -445,6 +445,11 @@ boost::intrusive_ptr<ExpressionContext> makeExpressionContext(
     expCtx->tempDir = storageGlobalParams.dbpath + "/_tmp";
     expCtx->collationMatchesDefault = collationMatchesDefault;
     expCtx->forPerShardCursor = request.getPassthroughToShard().has_value();
+    uassert(ErrorCodes::QueryFeatureNotAllowed,
+            "the 'maxDegreeOfParallelism' option is not enabled on this server",
+            !request.getMaxDegreeOfParallelism() ||
+                internalQuerySlotBasedExecutionAllowMaxDegreeOfParallelismOption.load());
+    expCtx->maxDegreeOfParallelism = request.getMaxDegreeOfParallelism();
     expCtx->allowDiskUse = request.getAllowDiskUse().value_or(allowDiskUseByDefault.load());
     if (storageGlobalParams.readOnly) {
         // Disallow disk use if in read-only mode.
@@ -936,6 +941,14 @@ Status runAggregate(OperationContext* opCtx,
                                     request.getCollectionUUID(),
                                     false /* checkFeatureFlag */);
 
+        // On a node which cannot accept writes for this namespace, storage cursors may be asked to
+        // avoid populating the storage engine cache. Change streams, the only tailable
+        // aggregations, are excluded.
+        if (ctx && !hasChangeStream &&
+            FindCommon::shouldReadOnce(opCtx, nss, false /* requested */, false /* isTailable */)) {
+            opCtx->recoveryUnit()->setReadOnce(true);
+        }
+
         invariant(collatorToUse);
         expCtx = makeExpressionContext(
             opCtx, request, std::move(*collatorToUse), uuid, collatorToUseMatchesDefault);
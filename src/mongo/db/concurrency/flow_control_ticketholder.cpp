@@ -35,6 +35,7 @@
 
 #include "mongo/db/operation_context.h"
 #include "mongo/logv2/log.h"
+#include "mongo/rpc/metadata/client_metadata.h"
 #include "mongo/util/time_support.h"
 
 namespace mongo {
@@ -90,16 +91,49 @@ void FlowControlTicketholder::refreshTo(int numTickets) {
     _cv.notify_all();
 }
 
+FlowControlTicketholder::SourceStats& FlowControlTicketholder::_getSourceStats(
+    WithLock, std::string appName) {
+    auto it = _sourceStats.find(appName);
+    if (it != _sourceStats.end()) {
+        return it->second;
+    }
+    if (_sourceStats.size() >= kMaxTrackedSources) {
+        appName = kOtherSourcesName.toString();
+    }
+    return _sourceStats.try_emplace(std::move(appName)).first->second;
+}
+
+void FlowControlTicketholder::appendSourceStats(BSONObjBuilder* builder) const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    for (const auto& [appName, sourceStats] : _sourceStats) {
+        BSONObjBuilder source(builder->subobjStart(appName));
+        source.append("acquireCount", sourceStats.acquireCount);
+        source.append("acquireWaitCount", sourceStats.acquireWaitCount);
+        source.append("timeAcquiringMicros", sourceStats.timeAcquiringMicros);
+    }
+}
+
 void FlowControlTicketholder::getTicket(OperationContext* opCtx,
                                         FlowControlTicketholder::CurOp* stats) {
+    // Build the stats key before taking '_mutex' so the allocation is not made under the lock.
+    std::string appName = kUnnamedSourceName.toString();
+    if (auto clientMetadata = ClientMetadata::get(opCtx->getClient())) {
+        if (!clientMetadata->getApplicationName().empty()) {
+            appName = clientMetadata->getApplicationName().toString();
+        }
+    }
+
     stdx::unique_lock<Latch> lk(_mutex);
     if (_inShutdown) {
         return;
     }
 
+    auto& sourceStats = _getSourceStats(lk, std::move(appName));
+
     LOGV2_DEBUG(20519, 4, "Taking ticket.", "Available"_attr = _tickets);
     if (_tickets == 0) {
         ++stats->acquireWaitCount;
+        ++sourceStats.acquireWaitCount;
     }
 
     auto currentWaitTime = curTimeMicros64();
@@ -108,6 +142,7 @@ void FlowControlTicketholder::getTicket(OperationContext* opCtx,
         auto waitTimeDelta = currentWaitTime - oldWaitTime;
         _totalTimeAcquiringMicros.fetchAndAddRelaxed(waitTimeDelta);
         stats->timeAcquiringMicros += waitTimeDelta;
+        sourceStats.timeAcquiringMicros += waitTimeDelta;
     };
 
     stats->waiting = true;
@@ -129,6 +164,7 @@ void FlowControlTicketholder::getTicket(OperationContext* opCtx,
     }
 
     ++stats->ticketsAcquired;
+    ++sourceStats.acquireCount;
     --_tickets;
 }
 
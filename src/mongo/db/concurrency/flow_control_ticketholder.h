@@ -29,10 +29,15 @@
 
 #pragma once
 
+#include <string>
+
+#include "mongo/base/string_data.h"
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/concurrency/with_lock.h"
 
 namespace mongo {
 
@@ -89,14 +94,42 @@ public:
 
     void setInShutdown();
 
+    /**
+     * Appends, for each client application name, how many tickets it acquired and how long it
+     * spent waiting for them. This shows which workloads flow control is throttling. At most
+     * 'kMaxTrackedSources' names are tracked; the remainder are accumulated under
+     * 'kOtherSourcesName'. Clients without an application name are reported under
+     * 'kUnnamedSourceName'.
+     */
+    void appendSourceStats(BSONObjBuilder* builder) const;
+
+    static constexpr std::size_t kMaxTrackedSources = 100;
+    static constexpr StringData kOtherSourcesName = "__other"_sd;
+    static constexpr StringData kUnnamedSourceName = "__unnamed"_sd;
+
 private:
+    struct SourceStats {
+        long long acquireCount = 0;
+        long long acquireWaitCount = 0;
+        long long timeAcquiringMicros = 0;
+    };
+
+    /**
+     * Returns the stats entry for 'appName', creating it if needed. Takes 'appName' by value so
+     * the caller can build the key outside '_mutex'.
+     */
+    SourceStats& _getSourceStats(WithLock, std::string appName);
+
     // Use an int64_t as this is serialized to bson which does not support unsigned 64-bit numbers.
     AtomicWord<std::int64_t> _totalTimeAcquiringMicros;
 
-    Mutex _mutex = MONGO_MAKE_LATCH("FlowControlTicketHolder::_mutex");
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("FlowControlTicketHolder::_mutex");
     stdx::condition_variable _cv;
     int _tickets;
 
+    // Keyed by client application name. Guarded by _mutex.
+    stdx::unordered_map<std::string, SourceStats> _sourceStats;
+
     bool _inShutdown;  // used to synchronize shutdown of the ticket refresher job
 };
 
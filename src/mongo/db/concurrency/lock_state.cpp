@@ -51,6 +51,7 @@
 #include "mongo/util/fail_point.h"
 #include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -377,6 +378,10 @@ bool LockerImpl::_acquireTicket(OperationContext* opCtx, LockMode mode, Date_t d
 
         auto waitMode = _uninterruptibleLocksRequested ? TicketHolder::WaitMode::kUninterruptible
                                                        : TicketHolder::WaitMode::kInterruptible;
+
+        // Account for the time spent queued whether or not a ticket is eventually obtained.
+        Timer queueTimer;
+        ON_BLOCK_EXIT([&] { _timeQueuedForTicketMicros.fetchAndAdd(queueTimer.micros()); });
         if (deadline == Date_t::max()) {
             _ticket = holder->waitForTicket(opCtx, &_admCtx, waitMode);
         } else if (auto ticket = holder->waitForTicketUntil(opCtx, &_admCtx, deadline, waitMode)) {
@@ -1044,6 +1049,13 @@ void LockerImpl::getFlowControlTicket(OperationContext* opCtx, LockMode lockMode
         invariant(!opCtx->recoveryUnit()->isTimestamped());
         ticketholder->getTicket(opCtx, &_flowControlStats);
     }
+
+    if (lockMode == LockMode::MODE_IX && _clientState.load() == kInactive &&
+        opCtx->shouldParticipateInFlowControl() && !_uninterruptibleLocksRequested) {
+        // Like flow control, the storage engine may delay writers under pressure. This happens
+        // before any lock is taken, so a delayed writer holds nothing that others wait on.
+        TicketHolders::get(opCtx->getServiceContext()).throttleWrite(opCtx);
+    }
 }
 
 LockResult LockerImpl::lockRSTLBegin(OperationContext* opCtx, LockMode mode) {
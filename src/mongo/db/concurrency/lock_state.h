@@ -224,6 +224,10 @@ public:
 
     FlowControlTicketholder::CurOp getFlowControlStats() const override;
 
+    Microseconds getTimeQueuedForTicket() const override {
+        return Microseconds{_timeQueuedForTicketMicros.load()};
+    }
+
     //
     // Below functions are for testing only.
     //
@@ -382,6 +386,10 @@ private:
     // A structure for accumulating time spent getting flow control tickets.
     FlowControlTicketholder::CurOp _flowControlStats;
 
+    // Cumulative time spent queued in '_acquireTicket' waiting for a read or write ticket. Atomic
+    // because $currentOp reads it from another client's thread.
+    AtomicWord<long long> _timeQueuedForTicketMicros{0};
+
     // Keeps state and statistics related to admission control.
     AdmissionContext _admCtx;
 
@@ -551,6 +551,14 @@ public:
         return FlowControlTicketholder::CurOp();
     }
 
+    /**
+     * If tracked by an implementation, returns the cumulative time this Locker has spent queued
+     * for a storage engine admission ticket. Safe to call from a thread other than the owner.
+     */
+    virtual Microseconds getTimeQueuedForTicket() const {
+        return Microseconds{0};
+    }
+
     /**
      * This function is for unit testing only.
      */
@@ -0,0 +1,215 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <map>
+
+#include "mongo/db/client.h"
+#include "mongo/db/dbdirectclient.h"
+#include "mongo/db/ops/write_ops.h"
+#include "mongo/db/service_context_d_bm_fixture.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/platform/random.h"
+
+namespace mongo {
+namespace {
+
+const NamespaceString kNss("crud_concurrency_bm.coll");
+const int kMaxThreads = 128;
+const int kNumDocuments = 10000;
+const int kNumReportedLatches = 5;
+
+enum class KeyDistribution : int64_t { kUniform, kHotDocument };
+
+/**
+ * The environment shared by every benchmark and every benchmark thread in this binary, preloaded
+ * with kNumDocuments documents.
+ */
+class CrudBenchmarkEnvironment : public ServiceContextMongoDBenchmarkFixture {
+public:
+    static CrudBenchmarkEnvironment& get() {
+        return getShared<CrudBenchmarkEnvironment>();
+    }
+
+    CrudBenchmarkEnvironment() {
+        auto opCtx = makeOperationContext();
+        DBDirectClient client(opCtx.get());
+        std::vector<BSONObj> docs;
+        for (int i = 0; i < kNumDocuments; ++i) {
+            docs.push_back(BSON("_id" << i << "n" << 0));
+        }
+        write_ops::InsertCommandRequest insertOp(kNss);
+        insertOp.setDocuments(std::move(docs));
+        invariant(!client.insert(insertOp).getWriteErrors());
+    }
+};
+
+/**
+ * Per-thread state: a Client (the main thread reuses the environment's), an OperationContext and a
+ * DBDirectClient, so that every operation goes through ServiceEntryPointMongod.
+ */
+class CrudBenchmarkThread {
+public:
+    explicit CrudBenchmarkThread(const benchmark::State& state)
+        : _random(state.thread_index),
+          _distribution(static_cast<KeyDistribution>(state.range(0))) {
+        auto service = CrudBenchmarkEnvironment::get().getServiceContext();
+        if (!haveClient()) {
+            _threadClient.emplace(service);
+        }
+        _opCtx = cc().makeOperationContext();
+        _client.emplace(_opCtx.get());
+    }
+
+    int nextKey() {
+        return _distribution == KeyDistribution::kHotDocument ? 0
+                                                              : _random.nextInt32(kNumDocuments);
+    }
+
+    DBDirectClient& client() {
+        return *_client;
+    }
+
+private:
+    PseudoRandom _random;
+    KeyDistribution _distribution;
+    boost::optional<ThreadClient> _threadClient;
+    ServiceContext::UniqueOperationContext _opCtx;
+    boost::optional<DBDirectClient> _client;
+};
+
+/**
+ * Snapshots the contention counters of every latch so that the latches which were contended the
+ * most while the benchmark ran can be reported as counters.
+ */
+class LatchContentionReport {
+public:
+    LatchContentionReport() {
+        _forEachLatch([&](StringData name, long long waitMicros) {
+            _waitMicrosBefore[name.toString()] = waitMicros;
+        });
+    }
+
+    void report(benchmark::State& state) const {
+        std::vector<std::pair<long long, std::string>> deltas;
+        _forEachLatch([&](StringData name, long long waitMicros) {
+            auto it = _waitMicrosBefore.find(name.toString());
+            auto delta = waitMicros - (it == _waitMicrosBefore.end() ? 0 : it->second);
+            if (delta > 0) {
+                deltas.emplace_back(delta, name.toString());
+            }
+        });
+        std::sort(deltas.rbegin(), deltas.rend());
+        for (size_t i = 0; i < deltas.size() && i < kNumReportedLatches; ++i) {
+            state.counters["latchWaitMicros:" + deltas[i].second] = deltas[i].first;
+        }
+    }
+
+private:
+    template <typename Callback>
+    static void _forEachLatch(Callback callback) {
+        for (auto iter = latch_detail::Catalog::get().iter(); iter.more();) {
+            auto data = iter.next();
+            if (data) {
+                callback(data->identity().name(), data->counts().contendedWaitMicros.loadRelaxed());
+            }
+        }
+    }
+
+    std::map<std::string, long long> _waitMicrosBefore;
+};
+
+/**
+ * Runs 'runOp' in a loop on every benchmark thread. Thread 0 additionally reports the latches with
+ * the most contended wait time accumulated during the run.
+ */
+template <typename RunOp>
+void benchmarkCrud(benchmark::State& state, RunOp runOp) {
+    CrudBenchmarkThread thread(state);
+    boost::optional<LatchContentionReport> latchReport;
+    if (state.thread_index == 0) {
+        latchReport.emplace();
+    }
+
+    for (auto keepRunning : state) {
+        runOp(thread);
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    if (latchReport) {
+        latchReport->report(state);
+    }
+}
+
+void BM_Insert(benchmark::State& state) {
+    // The collection is shared by every run of every benchmark, so the _ids must be unique across
+    // all of them, past the preloaded documents.
+    static AtomicWord<long long> nextId{kNumDocuments};
+    benchmarkCrud(state, [&](CrudBenchmarkThread& thread) {
+        write_ops::InsertCommandRequest insertOp(kNss);
+        insertOp.setDocuments({BSON("_id" << nextId.fetchAndAdd(1) << "n" << 0)});
+        auto reply = thread.client().insert(insertOp);
+        invariant(!reply.getWriteErrors());
+    });
+}
+
+void BM_PointFind(benchmark::State& state) {
+    benchmarkCrud(state, [](CrudBenchmarkThread& thread) {
+        benchmark::DoNotOptimize(thread.client().findOne(kNss, BSON("_id" << thread.nextKey())));
+    });
+}
+
+void BM_PointUpdate(benchmark::State& state) {
+    benchmarkCrud(state, [](CrudBenchmarkThread& thread) {
+        benchmark::DoNotOptimize(thread.client().updateAcknowledged(
+            kNss.ns(), BSON("_id" << thread.nextKey()), BSON("$inc" << BSON("n" << 1))));
+    });
+}
+
+BENCHMARK(BM_Insert)
+    ->Arg(static_cast<int64_t>(KeyDistribution::kUniform))
+    ->ThreadRange(1, kMaxThreads)
+    ->UseRealTime();
+BENCHMARK(BM_PointFind)
+    ->Arg(static_cast<int64_t>(KeyDistribution::kUniform))
+    ->Arg(static_cast<int64_t>(KeyDistribution::kHotDocument))
+    ->ThreadRange(1, kMaxThreads)
+    ->UseRealTime();
+BENCHMARK(BM_PointUpdate)
+    ->Arg(static_cast<int64_t>(KeyDistribution::kUniform))
+    ->Arg(static_cast<int64_t>(KeyDistribution::kHotDocument))
+    ->ThreadRange(1, kMaxThreads)
+    ->UseRealTime();
+
+}  // namespace
+}  // namespace mongo
@@ -51,6 +51,7 @@
 #include "mongo/db/profile_filter.h"
 #include "mongo/db/query/getmore_command_gen.h"
 #include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/query/query_shape_stats.h"
 #include "mongo/logv2/log.h"
 #include "mongo/rpc/metadata/client_metadata.h"
 #include "mongo/rpc/metadata/impersonated_user_metadata.h"
@@ -426,6 +427,19 @@ bool CurOp::completeAndLogOperation(OperationContext* opCtx,
         oplogGetMoreStats.recordMillis(executionTimeMillis);
     }
 
+    // Gather the time spent blocked on prepare conflicts and queued for tickets here, rather than
+    // only when logging, so that the profiler and the profile filter can see them too.
+    _debug.prepareConflictDurationMillis = duration_cast<Milliseconds>(
+        PrepareConflictTracker::get(opCtx).getPrepareConflictDuration());
+    _debug.timeQueuedForTicketMicros = opCtx->lockState()->getTimeQueuedForTicket();
+
+    if (_debug.queryHash) {
+        QueryShapeStatsStore::get(opCtx).record(*_debug.queryHash,
+                                                _debug.executionTime,
+                                                _debug.additiveMetrics.keysExamined.value_or(0),
+                                                _debug.additiveMetrics.docsExamined.value_or(0));
+    }
+
     bool shouldLogSlowOp, shouldProfileAtLevel1;
 
     if (auto filter =
@@ -488,12 +502,6 @@ bool CurOp::completeAndLogOperation(OperationContext* opCtx,
             }
         }
 
-        // Gets the time spent blocked on prepare conflicts.
-        auto prepareConflictDurationMicros =
-            PrepareConflictTracker::get(opCtx).getPrepareConflictDuration();
-        _debug.prepareConflictDurationMillis =
-            duration_cast<Milliseconds>(prepareConflictDurationMicros);
-
         auto operationMetricsPtr = [&]() -> ResourceConsumption::OperationMetrics* {
             auto& metricsCollector = ResourceConsumption::MetricsCollector::get(opCtx);
             if (metricsCollector.hasCollectedMetrics()) {
@@ -713,6 +721,10 @@ void CurOp::reportState(OperationContext* opCtx, BSONObjBuilder* builder, bool t
 
     builder->append("numYields", _numYields.load());
 
+    if (auto queued = opCtx->lockState()->getTimeQueuedForTicket(); queued > Microseconds::zero()) {
+        builder->append("timeQueuedForTicketMicros", durationCount<Microseconds>(queued));
+    }
+
     if (_debug.dataThroughputLastSecond) {
         builder->append("dataThroughputLastSecond", *_debug.dataThroughputLastSecond);
     }
@@ -830,6 +842,10 @@ void OpDebug::report(OperationContext* opCtx,
         pAttrs->add("totalOplogSlotDuration", totalOplogSlotDurationMicros);
     }
 
+    if (timeQueuedForTicketMicros > Microseconds::zero()) {
+        pAttrs->add("timeQueuedForTicket", timeQueuedForTicketMicros);
+    }
+
     if (dataThroughputLastSecond) {
         pAttrs->add("dataThroughputLastSecondMBperSec", *dataThroughputLastSecond);
     }
@@ -1128,6 +1144,16 @@ void OpDebug::append(OperationContext* opCtx,
                        durationCount<Microseconds>(totalOplogSlotDurationMicros));
     }
 
+    if (prepareConflictDurationMillis > Milliseconds::zero()) {
+        b.appendNumber("prepareConflictDurationMillis",
+                       durationCount<Milliseconds>(prepareConflictDurationMillis));
+    }
+
+    if (timeQueuedForTicketMicros > Microseconds::zero()) {
+        b.appendNumber("timeQueuedForTicketMicros",
+                       durationCount<Microseconds>(timeQueuedForTicketMicros));
+    }
+
     if (!execStats.isEmpty()) {
         b.append("execStats", std::move(execStats));
     }
@@ -1445,6 +1471,19 @@ std::function<BSONObj(ProfileFilter::Args)> OpDebug::appendStaged(StringSet requ
         }
     });
 
+    addIfNeeded("prepareConflictDurationMillis", [](auto field, auto args, auto& b) {
+        if (args.op.prepareConflictDurationMillis > Milliseconds::zero()) {
+            b.appendNumber(field,
+                           durationCount<Milliseconds>(args.op.prepareConflictDurationMillis));
+        }
+    });
+
+    addIfNeeded("timeQueuedForTicketMicros", [](auto field, auto args, auto& b) {
+        if (args.op.timeQueuedForTicketMicros > Microseconds::zero()) {
+            b.appendNumber(field, durationCount<Microseconds>(args.op.timeQueuedForTicketMicros));
+        }
+    });
+
     addIfNeeded("execStats", [](auto field, auto args, auto& b) {
         if (!args.op.execStats.isEmpty()) {
             b.append(field, args.op.execStats);
@@ -289,6 +289,9 @@ public:
     // Stores the duration of time spent blocked on prepare conflicts.
     Milliseconds prepareConflictDurationMillis{0};
 
+    // Stores the cumulative time spent queued for a storage engine read or write ticket.
+    Microseconds timeQueuedForTicketMicros{0};
+
     // Stores the total time an operation spends with an uncommitted oplog slot held open. Indicator
     // that an operation is holding back replication by causing oplog holes to remain open for
     // unusual amounts of time.
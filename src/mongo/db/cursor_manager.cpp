@@ -53,6 +53,8 @@
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/query/plan_executor.h"
+#include "mongo/db/query/plan_explainer.h"
+#include "mongo/db/query/plan_summary_stats.h"
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/service_context.h"
 #include "mongo/logv2/log.h"
@@ -84,6 +86,11 @@ static ServerStatusMetricField<Counter64> dCursorStatsLifespanLessThan10Minutes(
 static ServerStatusMetricField<Counter64> dCursorStatsLifespanGreaterThanOrEqual10Minutes(
     "cursor.lifespan.greaterThanOrEqual10Minutes", &cursorStatsLifespanGreaterThanOrEqual10Minutes);
 
+static Counter64 cursorStatsTimedOutWithInMemorySort;
+
+static ServerStatusMetricField<Counter64> dCursorStatsTimedOutWithInMemorySort(
+    "cursor.timedOutWithInMemorySort", &cursorStatsTimedOutWithInMemorySort);
+
 constexpr int CursorManager::kNumPartitions;
 
 namespace {
@@ -151,7 +158,7 @@ std::pair<Status, int> CursorManager::killCursorsWithMatchingSessions(
 
 CursorManager::CursorManager(ClockSource* preciseClockSource)
     : _random(std::make_unique<PseudoRandom>(SecureRandom().nextInt64())),
-      _cursorMap(std::make_unique<Partitioned<stdx::unordered_map<CursorId, ClientCursor*>>>(
+      _cursorMap(std::make_unique<Partitioned<absl::flat_hash_map<CursorId, ClientCursor*>>>(
           kNumPartitions)),
       _preciseClockSource(preciseClockSource) {}
 
@@ -172,7 +179,26 @@ bool CursorManager::cursorShouldTimeout_inlock(const ClientCursor* cursor, Date_
         (cursor->getSessionId() && !enableTimeoutOfInactiveSessionCursors.load())) {
         return false;
     }
-    return (now - cursor->_lastUseDate) >= Milliseconds(getCursorTimeoutMillis());
+
+    auto idleFor = now - cursor->_lastUseDate;
+    if (idleFor >= Milliseconds(getCursorTimeoutMillis())) {
+        return true;
+    }
+
+    // An idle cursor whose plan sorted in memory keeps the sorted results alive until it is
+    // exhausted, so it can be reaped sooner than other cursors.
+    auto inMemorySortTimeout = getCursorTimeoutMillisForInMemorySort();
+    if (inMemorySortTimeout < 0 || idleFor < Milliseconds(inMemorySortTimeout)) {
+        return false;
+    }
+
+    PlanSummaryStats stats;
+    cursor->getExecutor()->getPlanExplainer().getSummaryStats(&stats);
+    if (!stats.hasSortStage || stats.usedDisk) {
+        return false;
+    }
+    cursorStatsTimedOutWithInMemorySort.increment();
+    return true;
 }
 
 std::size_t CursorManager::timeoutCursors(OperationContext* opCtx, Date_t now) {
@@ -441,7 +467,7 @@ void CursorManager::deregisterCursor(ClientCursor* cursor) {
 }
 
 void CursorManager::deregisterAndDestroyCursor(
-    Partitioned<stdx::unordered_map<CursorId, ClientCursor*>>::OnePartition&& lk,
+    Partitioned<absl::flat_hash_map<CursorId, ClientCursor*>>::OnePartition&& lk,
     OperationContext* opCtx,
     std::unique_ptr<ClientCursor, ClientCursor::Deleter> cursor) {
     {
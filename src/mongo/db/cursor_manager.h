@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <absl/container/flat_hash_map.h>
 #include <utility>
 
 #include "mongo/db/catalog/util/partitioned.h"
@@ -65,6 +66,13 @@ class PlanExecutor;
  * accessing the CursorManager (i.e. a workload which runs many concurrent queries), the cursor
  * manager's underlying data structure is partitioned. Each partition is protected by its own latch.
  *
+ * An idle cursor keeps its whole PlanExecutor alive between getMores, including any in-memory
+ * sort or group state, until it is exhausted, killed, or reaped after 'cursorTimeoutMillis'. That
+ * state is not spilled, since plan stages have no serialized form to restore from, so the memory
+ * held by slow consumers is bounded only by the timeout and by the per-stage memory limits.
+ * Cursors whose plan sorted in memory can be reaped sooner with
+ * 'cursorTimeoutMillisForInMemorySort'.
+ *
  * See clientcursor.h for more information.
  */
 class CursorManager {
@@ -220,7 +228,7 @@ private:
 
     void deregisterCursor(ClientCursor* cursor);
     void deregisterAndDestroyCursor(
-        Partitioned<stdx::unordered_map<CursorId, ClientCursor*>>::OnePartition&&,
+        Partitioned<absl::flat_hash_map<CursorId, ClientCursor*>>::OnePartition&&,
         OperationContext* opCtx,
         std::unique_ptr<ClientCursor, ClientCursor::Deleter> cursor);
 
@@ -257,7 +265,7 @@ private:
     // mutexes for all partitions.
     mutable SimpleMutex _registrationLock;
     std::unique_ptr<PseudoRandom> _random;
-    std::unique_ptr<Partitioned<stdx::unordered_map<CursorId, ClientCursor*>>> _cursorMap;
+    std::unique_ptr<Partitioned<absl::flat_hash_map<CursorId, ClientCursor*>>> _cursorMap;
 
     // A mapping from client OperationKey to corresponding CursorID. Note that it's possible that
     // cursors in the map above are not present in this map, since OperationKey is not required when
@@ -43,6 +43,10 @@ long long getCursorTimeoutMillis() {
     return gCursorTimeoutMillis.load();
 }
 
+long long getCursorTimeoutMillisForInMemorySort() {
+    return gCursorTimeoutMillisForInMemorySort.load();
+}
+
 Milliseconds getDefaultCursorTimeoutMillis() {
     return Milliseconds(kCursorTimeoutMillisDefault);
 }
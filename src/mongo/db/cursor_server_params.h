@@ -39,6 +39,11 @@ int getClientCursorMonitorFrequencySecs();
 // parameter "cursorTimeoutMillis".
 long long getCursorTimeoutMillis();
 
+// Period of time after which mortal cursors holding the results of an in-memory sort are killed
+// for inactivity, or a negative value if they share the timeout of other cursors. Configurable
+// with server parameter "cursorTimeoutMillisForInMemorySort".
+long long getCursorTimeoutMillisForInMemorySort();
+
 Milliseconds getDefaultCursorTimeoutMillis();
 
 }  // namespace mongo
@@ -35,6 +35,7 @@
 
 #include "mongo/db/catalog/collection_catalog.h"
 #include "mongo/db/catalog/database_holder.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/concurrency/locker.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/repl/replication_coordinator.h"
@@ -52,6 +53,17 @@ namespace {
 
 const boost::optional<int> kDoNotChangeProfilingLevel = boost::none;
 
+/**
+ * Number of read acquisitions through the MaybeLockFree helpers that took the lock-free path, and
+ * number that fell back to taking database and collection intent locks.
+ */
+Counter64 lockFreeReadAcquisitions;
+Counter64 lockedReadAcquisitions;
+ServerStatusMetricField<Counter64> displayLockFreeReadAcquisitions(
+    "query.readAcquisitions.lockFree", &lockFreeReadAcquisitions);
+ServerStatusMetricField<Counter64> displayLockedReadAcquisitions("query.readAcquisitions.locked",
+                                                                 &lockedReadAcquisitions);
+
 // TODO: SERVER-44105 remove
 // If set to false, secondary reads should wait behind the PBW lock.
 const auto allowSecondaryReadsDuringBatchApplication_DONT_USE =
@@ -766,8 +778,10 @@ AutoGetCollectionForReadMaybeLockFree::AutoGetCollectionForReadMaybeLockFree(
     const std::vector<NamespaceStringOrUUID>& secondaryNssOrUUIDs) {
     if (supportsLockFreeRead(opCtx)) {
         _autoGetLockFree.emplace(opCtx, nsOrUUID, viewMode, deadline, secondaryNssOrUUIDs);
+        lockFreeReadAcquisitions.increment();
     } else {
         _autoGet.emplace(opCtx, nsOrUUID, viewMode, deadline, secondaryNssOrUUIDs);
+        lockedReadAcquisitions.increment();
     }
 }
 
@@ -907,8 +921,10 @@ AutoGetCollectionForReadCommandMaybeLockFree::AutoGetCollectionForReadCommandMay
     const std::vector<NamespaceStringOrUUID>& secondaryNssOrUUIDs) {
     if (supportsLockFreeRead(opCtx)) {
         _autoGetLockFree.emplace(opCtx, nsOrUUID, viewMode, deadline, logMode, secondaryNssOrUUIDs);
+        lockFreeReadAcquisitions.increment();
     } else {
         _autoGet.emplace(opCtx, nsOrUUID, viewMode, deadline, logMode, secondaryNssOrUUIDs);
+        lockedReadAcquisitions.increment();
     }
 }
 
@@ -1001,8 +1017,10 @@ AutoGetDbForReadMaybeLockFree::AutoGetDbForReadMaybeLockFree(OperationContext* o
                                                              Date_t deadline) {
     if (supportsLockFreeRead(opCtx)) {
         _autoGetLockFree.emplace(opCtx, dbName, deadline);
+        lockFreeReadAcquisitions.increment();
     } else {
         _autoGet.emplace(opCtx, dbName, MODE_IS, deadline);
+        lockedReadAcquisitions.increment();
     }
 }
 
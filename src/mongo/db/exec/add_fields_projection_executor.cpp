@@ -224,12 +224,13 @@ void AddFieldsProjectionExecutor::parse(const BSONObj& spec) {
 }
 
 Document AddFieldsProjectionExecutor::applyProjection(const Document& inputDoc) const {
-    // The output doc is the same as the input doc, with the added fields.
+    // The output doc is the same as the input doc, with the added fields. 'output' starts out
+    // sharing the input's storage, and the first write clones it, metadata included, so the
+    // metadata does not need to be copied again. The clone cannot be skipped even when the caller
+    // holds the only other reference, since the expressions read from 'inputDoc' while 'output'
+    // is being written and must see the original field values.
     MutableDocument output(inputDoc);
     _root->applyExpressions(inputDoc, &output);
-
-    // Pass through the metadata.
-    output.copyMetaDataFrom(inputDoc);
     return output.freeze();
 }
 
@@ -296,7 +296,7 @@ PlanStage::StageState AndHashStage::hashOtherChildren(WorkingSetID* out) {
             // Ignore.  It's not in any previous child.
         } else {
             // We have a hit.  Copy data into the WSM we already have.
-            _seenMap.insert(member->recordId);
+            markSeen(member->recordId);
             WorkingSetID olderMemberID = _dataMap[member->recordId];
             WorkingSetMember* olderMember = _ws->get(olderMemberID);
             size_t memUsageBefore = olderMember->getMemUsage();
@@ -315,7 +315,7 @@ PlanStage::StageState AndHashStage::hashOtherChildren(WorkingSetID* out) {
         // Keep elements of _dataMap that are in _seenMap.
         DataMap::iterator it = _dataMap.begin();
         while (it != _dataMap.end()) {
-            if (_seenMap.end() == _seenMap.find(it->first)) {
+            if (!wasSeen(it->first)) {
                 DataMap::iterator toErase = it;
                 ++it;
 
@@ -333,6 +333,7 @@ PlanStage::StageState AndHashStage::hashOtherChildren(WorkingSetID* out) {
         _specificStats.mapAfterChild.push_back(_dataMap.size());
 
         _seenMap.clear();
+        _seenBitmap.clear();
 
         // _dataMap is now the intersection of the first _currentChild nodes.
 
@@ -357,6 +358,21 @@ PlanStage::StageState AndHashStage::hashOtherChildren(WorkingSetID* out) {
     }
 }
 
+void AndHashStage::markSeen(const RecordId& recordId) {
+    if (recordId.isLong()) {
+        _seenBitmap.add(recordId.getLong());
+    } else {
+        _seenMap.insert(recordId);
+    }
+}
+
+bool AndHashStage::wasSeen(const RecordId& recordId) const {
+    if (recordId.isLong()) {
+        return _seenBitmap.contains(recordId.getLong());
+    }
+    return _seenMap.end() != _seenMap.find(recordId);
+}
+
 unique_ptr<PlanStageStats> AndHashStage::getStats() {
     _commonStats.isEOF = isEOF();
 
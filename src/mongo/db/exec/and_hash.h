@@ -32,6 +32,7 @@
 #include <vector>
 
 #include "mongo/db/exec/plan_stage.h"
+#include "mongo/db/exec/record_id_bitmap.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/record_id.h"
@@ -83,6 +84,9 @@ private:
     StageState hashOtherChildren(WorkingSetID* out);
     StageState workChild(size_t childNo, WorkingSetID* out);
 
+    void markSeen(const RecordId& recordId);
+    bool wasSeen(const RecordId& recordId) const;
+
     // Not owned by us.
     WorkingSet* _ws;
 
@@ -97,9 +101,11 @@ private:
     DataMap _dataMap;
 
     // Keeps track of what elements from _dataMap subsequent children have seen.
-    // Only used while _hashingChildren.
+    // Only used while _hashingChildren. Integer record ids are kept in the compressed
+    // _seenBitmap, other record ids (e.g. of clustered collections) in _seenMap.
     typedef stdx::unordered_set<RecordId, RecordId::Hasher> SeenMap;
     SeenMap _seenMap;
+    RecordIdBitmap _seenBitmap;
 
     // True if we're still intersecting _children[0..._children.size()-1].
     bool _hashingChildren;
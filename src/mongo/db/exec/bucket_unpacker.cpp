@@ -1017,6 +1017,13 @@ public:
                                           const Value& metaValue,
                                           bool includeTimeField,
                                           bool includeMetaField) = 0;
+    virtual void peekNext(BSONObjBuilder& builder,
+                          const BucketSpec& spec,
+                          const BSONElement& metaValue,
+                          bool includeTimeField,
+                          bool includeMetaField,
+                          const StringSet& fieldNames) = 0;
+    virtual bool skipNext() = 0;
 
     // Provides an upper bound on the number of fields in each measurement.
     virtual std::size_t numberOfFields() = 0;
@@ -1073,6 +1080,13 @@ public:
                                   const Value& metaValue,
                                   bool includeTimeField,
                                   bool includeMetaField) override;
+    void peekNext(BSONObjBuilder& builder,
+                  const BucketSpec& spec,
+                  const BSONElement& metaValue,
+                  bool includeTimeField,
+                  bool includeMetaField,
+                  const StringSet& fieldNames) override;
+    bool skipNext() override;
     std::size_t numberOfFields() override;
 
 private:
@@ -1205,6 +1219,47 @@ void BucketUnpackerV1::extractSingleMeasurement(
     }
 }
 
+void BucketUnpackerV1::peekNext(BSONObjBuilder& builder,
+                                const BucketSpec& spec,
+                                const BSONElement& metaValue,
+                                bool includeTimeField,
+                                bool includeMetaField,
+                                const StringSet& fieldNames) {
+    auto&& timeElem = *_timeFieldIter;
+    if (includeTimeField) {
+        builder.appendAs(timeElem, spec.timeField());
+    }
+
+    if (includeMetaField && !metaValue.eoo()) {
+        builder.appendAs(metaValue, *spec.metaField());
+    }
+
+    const auto& currentIdx = timeElem.fieldNameStringData();
+    for (auto&& [colName, colIter] : _fieldIters) {
+        // A data field with the same name as the time or meta field is shadowed by it, as it is in
+        // the fully unpacked measurement where the first occurrence of a field name wins.
+        if (!fieldNames.contains(colName) || builder.hasField(colName)) {
+            continue;
+        }
+        if (auto&& elem = *colIter; colIter.more() && elem.fieldNameStringData() == currentIdx) {
+            builder.appendAs(elem, colName);
+        }
+    }
+}
+
+bool BucketUnpackerV1::skipNext() {
+    auto&& timeElem = _timeFieldIter.next();
+
+    const auto& currentIdx = timeElem.fieldNameStringData();
+    for (auto&& [colName, colIter] : _fieldIters) {
+        if (auto&& elem = *colIter; colIter.more() && elem.fieldNameStringData() == currentIdx) {
+            colIter.advance(elem);
+        }
+    }
+
+    return _timeFieldIter.more();
+}
+
 std::size_t BucketUnpackerV1::numberOfFields() {
     // The data fields are tracked by _fieldIters, but we need to account also for the time field
     // and possibly the meta field.
@@ -1236,6 +1291,13 @@ public:
                                   const Value& metaValue,
                                   bool includeTimeField,
                                   bool includeMetaField) override;
+    void peekNext(BSONObjBuilder& builder,
+                  const BucketSpec& spec,
+                  const BSONElement& metaValue,
+                  bool includeTimeField,
+                  bool includeMetaField,
+                  const StringSet& fieldNames) override;
+    bool skipNext() override;
     std::size_t numberOfFields() override;
 
 private:
@@ -1378,6 +1440,50 @@ void BucketUnpackerV2::extractSingleMeasurement(
     }
 }
 
+void BucketUnpackerV2::peekNext(BSONObjBuilder& builder,
+                                const BucketSpec& spec,
+                                const BSONElement& metaValue,
+                                bool includeTimeField,
+                                bool includeMetaField,
+                                const StringSet& fieldNames) {
+    if (includeTimeField) {
+        builder.appendAs(*_timeColumn.it, spec.timeField());
+    }
+
+    if (includeMetaField && !metaValue.eoo()) {
+        builder.appendAs(metaValue, *spec.metaField());
+    }
+
+    for (auto& fieldColumn : _fieldColumns) {
+        // See BucketUnpackerV1::peekNext() for why fields already in 'builder' are skipped.
+        if (!fieldNames.contains(fieldColumn.column.name()) ||
+            builder.hasField(fieldColumn.column.name())) {
+            continue;
+        }
+        uassert(7027300,
+                "Bucket unexpectedly contained fewer values than count",
+                fieldColumn.it != fieldColumn.end);
+        const BSONElement& elem = *fieldColumn.it;
+        // EOO represents missing field
+        if (!elem.eoo()) {
+            builder.appendAs(elem, fieldColumn.column.name());
+        }
+    }
+}
+
+bool BucketUnpackerV2::skipNext() {
+    ++_timeColumn.it;
+
+    for (auto& fieldColumn : _fieldColumns) {
+        uassert(7027301,
+                "Bucket unexpectedly contained fewer values than count",
+                fieldColumn.it != fieldColumn.end);
+        ++fieldColumn.it;
+    }
+
+    return _timeColumn.it != _timeColumn.end;
+}
+
 std::size_t BucketUnpackerV2::numberOfFields() {
     // The data fields are tracked by _fieldColumns, but we need to account also for the time field
     // and possibly the meta field.
@@ -1552,6 +1658,25 @@ BSONObj BucketUnpacker::getNextBson() {
     return builder.obj();
 }
 
+void BucketUnpacker::peekNextBson(BSONObjBuilder& builder, const StringSet& fieldNames) {
+    tassert(7027302, "'peekNextBson()' requires the bucket to be owned", _bucket.isOwned());
+    tassert(7027303, "'peekNextBson()' was called after the bucket has been exhausted", hasNext());
+
+    _unpackingImpl->peekNext(
+        builder, _spec, _metaBSONElem, _includeTimeField, _includeMetaField, fieldNames);
+
+    for (auto&& name : _spec.computedMetaProjFields()) {
+        if (fieldNames.contains(name) && !builder.hasField(name)) {
+            builder.appendAs(_computedMetaProjections[name], name);
+        }
+    }
+}
+
+void BucketUnpacker::skipNext() {
+    tassert(7027304, "'skipNext()' was called after the bucket has been exhausted", hasNext());
+    _hasNext = _unpackingImpl->skipNext();
+}
+
 Document BucketUnpacker::extractSingleMeasurement(int j) {
     tassert(5422101,
             "'extractSingleMeasurment' expects j to be greater than or equal to zero and less than "
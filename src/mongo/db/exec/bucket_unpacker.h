@@ -38,6 +38,7 @@
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/timeseries/timeseries_constants.h"
+#include "mongo/util/string_map.h"
 
 namespace mongo {
 /**
@@ -271,6 +272,21 @@ public:
      */
     BSONObj getNextBson();
 
+    /**
+     * Appends the time and meta fields, and those of the next measurement's data fields and
+     * computed meta projections named in 'fieldNames', to 'builder' without advancing. Each field
+     * name is appended at most once, keeping its first occurrence as a lookup on the measurement
+     * returned by 'getNext()' does when a data field shares its name with the meta field. Together
+     * with 'skipNext()' this allows a caller to evaluate a filter on the fields it depends on and
+     * only materialize the measurements which match. 'hasNext()' must be true.
+     */
+    void peekNextBson(BSONObjBuilder& builder, const StringSet& fieldNames);
+
+    /**
+     * Advances past the next measurement without materializing it. 'hasNext()' must be true.
+     */
+    void skipNext();
+
     /**
      * This method will extract the j-th measurement from the bucket. A precondition of this method
      * is that j >= 0 && j <= the number of measurements within the underlying bucket.
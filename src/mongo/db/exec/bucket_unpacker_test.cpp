@@ -224,6 +224,78 @@ TEST_F(BucketUnpackerTest, ExcludeASingleField) {
     test(*timeseries::compressBucket(bucket, "time"_sd, {}, false).compressedBucket);
 }
 
+TEST_F(BucketUnpackerTest, PeekAndSkipMeasurements) {
+    std::set<std::string> fields{"b"};
+
+    auto bucket = fromjson(
+        "{control: {'version': 1}, meta: {'m1': 999, 'm2': 9999}, data: {_id: {'0':1, '1':2, "
+        "'2':3}, time: {'0':1, '1':2, '2':3}, a:{'0':1, '1':2, '2':3}, b:{'1':1}}}");
+
+    auto test = [&](BSONObj bucket) {
+        auto unpacker = makeBucketUnpacker(fields,
+                                           BucketSpec::Behavior::kExclude,
+                                           std::move(bucket),
+                                           kUserDefinedMetaName.toString());
+        const StringSet peekFields{"a"};
+
+        // Peeking does not advance, and only includes the requested data fields.
+        for (int i = 0; i < 2; ++i) {
+            BSONObjBuilder builder;
+            unpacker.peekNextBson(builder, peekFields);
+            ASSERT_BSONOBJ_EQ(builder.obj(),
+                              fromjson("{time: 1, myMeta: {m1: 999, m2: 9999}, a: 1}"));
+        }
+
+        unpacker.skipNext();
+        ASSERT_TRUE(unpacker.hasNext());
+        {
+            BSONObjBuilder builder;
+            unpacker.peekNextBson(builder, peekFields);
+            ASSERT_BSONOBJ_EQ(builder.obj(),
+                              fromjson("{time: 2, myMeta: {m1: 999, m2: 9999}, a: 2}"));
+        }
+
+        unpacker.skipNext();
+        ASSERT_TRUE(unpacker.hasNext());
+        assertGetNext(unpacker,
+                      Document{fromjson("{time: 3, myMeta: {m1: 999, m2: 9999}, _id: 3, a: 3}")});
+        ASSERT_FALSE(unpacker.hasNext());
+    };
+
+    test(bucket);
+    test(*timeseries::compressBucket(bucket, "time"_sd, {}, false).compressedBucket);
+}
+
+TEST_F(BucketUnpackerTest, PeekAppendsOverlappingFieldsOnce) {
+    std::set<std::string> fields{};
+
+    // The data region has a field with the same name as the meta field.
+    auto bucket = fromjson(
+        "{control: {'version': 1}, meta: {'m1': 999}, data: {_id: {'0':1, '1':2}, time: {'0':1, "
+        "'1':2}, myMeta: {'0':5, '1':6}, a:{'0':1, '1':2}}}");
+
+    auto test = [&](BSONObj bucket) {
+        auto unpacker = makeBucketUnpacker(fields,
+                                           BucketSpec::Behavior::kExclude,
+                                           std::move(bucket),
+                                           kUserDefinedMetaName.toString());
+        const StringSet peekFields{"time", "myMeta", "a"};
+
+        // Like a lookup on the full measurement, the peeked fields keep the first occurrence of
+        // each name, which is the meta field.
+        BSONObjBuilder builder;
+        unpacker.peekNextBson(builder, peekFields);
+        ASSERT_BSONOBJ_EQ(builder.obj(), fromjson("{time: 1, myMeta: {m1: 999}, a: 1}"));
+
+        auto measurement = unpacker.getNext();
+        ASSERT_VALUE_EQ(measurement["myMeta"], Value(fromjson("{m1: 999}")));
+        ASSERT_VALUE_EQ(measurement["a"], Value(1));
+    };
+
+    test(bucket);
+    test(*timeseries::compressBucket(bucket, "time"_sd, {}, false).compressedBucket);
+}
+
 TEST_F(BucketUnpackerTest, EmptyIncludeGetsEmptyMeasurements) {
     std::set<std::string> fields{};
 
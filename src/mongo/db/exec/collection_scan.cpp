@@ -42,6 +42,7 @@
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/record_id_helpers.h"
 #include "mongo/db/repl/optime.h"
 #include "mongo/logv2/log.h"
@@ -119,6 +120,20 @@ CollectionScan::CollectionScan(ExpressionContext* expCtx,
         // only support in the forward direction.
         invariant(params.direction == CollectionScanParams::FORWARD);
     }
+
+    if (params.shareScanPosition) {
+        invariant(params.direction == CollectionScanParams::FORWARD);
+        invariant(!params.tailable && !params.minRecord && !params.maxRecord &&
+                  !params.resumeAfterRecordId && !params.requestResumeToken);
+    }
+
+    // Reading ahead of the records handed out is only safe when the position of the cursor does
+    // not matter once it has been restored, which rules out tailable and capped scans. Shared
+    // scans report the position of each record as it is returned, so they read one at a time too.
+    if (!params.tailable && !params.shareScanPosition && !collection->isCapped() &&
+        !collection->ns().isOplog()) {
+        _batchSize = internalQueryCollectionScanBatchSize.load();
+    }
 }
 
 PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
@@ -151,6 +166,11 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
 
             _cursor = collection()->getCursor(opCtx(), forward);
 
+            if (_params.shareScanPosition && !_sharedScan) {
+                _sharedScan = SharedScanRegistry::get(opCtx()->getServiceContext())
+                                  .joinScan(collection()->uuid());
+            }
+
             if (!_lastSeenId.isNull()) {
                 invariant(_params.tailable);
                 // Seek to where we were last time. If it no longer exists, mark us as dead since we
@@ -219,7 +239,20 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
             record = _cursor->seekNear(_params.maxRecord->recordId());
         }
 
+        if (_lastSeenId.isNull() && _sharedScan && _sharedScan->startPosition()) {
+            // Seek to the position of the other scans of the collection.
+            record = _cursor->seekNear(*_sharedScan->startPosition());
+        }
+
         if (!record) {
+            record = nextRecord();
+        }
+
+        if (!record && _sharedScan && _sharedScan->startPosition() && !_sharedScanWrapped) {
+            // Go back to the beginning of the collection to read the records before the position
+            // this scan started at.
+            _cursor = collection()->getCursor(opCtx());
+            _sharedScanWrapped = true;
             record = _cursor->next();
         }
     } catch (const WriteConflictException&) {
@@ -237,11 +270,17 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
             _cursor.reset();
         } else {
             _commonStats.isEOF = true;
+            _sharedScan.reset();
         }
         return PlanStage::IS_EOF;
     }
 
     _lastSeenId = record->id;
+    if (_sharedScan) {
+        if (auto state = checkSharedScanBounds(record->id)) {
+            return *state;
+        }
+    }
     if (_params.assertTsHasNotFallenOffOplog) {
         assertTsHasNotFallenOffOplog(*record);
     }
@@ -249,15 +288,62 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
         setLatestOplogEntryTimestamp(*record);
     }
 
+    // A record handed out of a batch may have been read before the last yield.
+    const auto snapshotId =
+        _batchPos > 0 ? _batchSnapshotId : opCtx()->recoveryUnit()->getSnapshotId();
+
     WorkingSetID id = _workingSet->allocate();
     WorkingSetMember* member = _workingSet->get(id);
     member->recordId = std::move(record->id);
-    member->resetDocument(opCtx()->recoveryUnit()->getSnapshotId(), record->data.releaseToBson());
+    member->resetDocument(snapshotId, record->data.releaseToBson());
     _workingSet->transitionToRecordIdAndObj(id);
 
     return returnIfMatches(member, id, out);
 }
 
+boost::optional<Record> CollectionScan::nextRecord() {
+    if (_batchSize <= 1) {
+        return _cursor->next();
+    }
+
+    if (_batchPos == _batch.size()) {
+        // If reading the batch throws, the records read so far stay in '_batch' and are handed out
+        // after the retry.
+        _batchPos = 0;
+        _batchSnapshotId = opCtx()->recoveryUnit()->getSnapshotId();
+        _cursor->nextBatch(_batchSize, &_batch);
+        if (_batch.empty()) {
+            return boost::none;
+        }
+    }
+    return std::move(_batch[_batchPos++]);
+}
+
+boost::optional<PlanStage::StageState> CollectionScan::checkSharedScanBounds(
+    const RecordId& recordId) {
+    const auto& startPosition = _sharedScan->startPosition();
+    if (!startPosition) {
+        _sharedScan->onRecord(recordId);
+        return boost::none;
+    }
+
+    if (_sharedScanWrapped && recordId >= *startPosition) {
+        // The records from here on were returned before wrapping around.
+        _commonStats.isEOF = true;
+        _sharedScan.reset();
+        return PlanStage::IS_EOF;
+    }
+
+    if (!_sharedScanWrapped && recordId < *startPosition) {
+        // seekNear() may position the cursor before the start position. Such records are returned
+        // after wrapping around.
+        return PlanStage::NEED_TIME;
+    }
+
+    _sharedScan->onRecord(recordId);
+    return boost::none;
+}
+
 void CollectionScan::setLatestOplogEntryTimestamp(const Record& record) {
     auto tsElem = record.data.toBson()[repl::OpTime::kTimestampFieldName];
     uassert(ErrorCodes::Error(4382100),
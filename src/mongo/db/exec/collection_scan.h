@@ -30,11 +30,14 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "mongo/db/exec/collection_scan_common.h"
 #include "mongo/db/exec/requires_collection_stage.h"
+#include "mongo/db/exec/shared_scan_registry.h"
 #include "mongo/db/matcher/expression_leaf.h"
 #include "mongo/db/record_id.h"
+#include "mongo/db/storage/snapshot.h"
 #include "mongo/s/resharding/resume_token_gen.h"
 
 namespace mongo {
@@ -119,6 +122,19 @@ private:
      */
     void assertTsHasNotFallenOffOplog(const Record& record);
 
+    /**
+     * For a scan sharing its position, skips the records of the first pass which precede the
+     * start position, and ends the scan when the pass after wrapping around reaches it. Returns
+     * boost::none if 'recordId' should be processed as usual.
+     */
+    boost::optional<StageState> checkSharedScanBounds(const RecordId& recordId);
+
+    /**
+     * Returns the next record of '_cursor', reading a batch of '_batchSize' records from the
+     * storage engine whenever the previous batch has been handed out.
+     */
+    boost::optional<Record> nextRecord();
+
     // WorkingSet is not owned by us.
     WorkingSet* _workingSet;
 
@@ -135,6 +151,22 @@ private:
     // timestamp seen in the collection.  Otherwise, this is a null timestamp.
     Timestamp _latestOplogEntryTimestamp;
 
+    // If _params.shareScanPosition is set, the membership of this scan in the scans of the
+    // collection from the first call to doWork() until EOF.
+    std::unique_ptr<SharedScanRegistry::Scan> _sharedScan;
+
+    // True once a shared scan which did not start at the beginning of the collection reached its
+    // end and went back to the beginning.
+    bool _sharedScanWrapped = false;
+
+    // When greater than 1, the number of records read from '_cursor' at once. The records of the
+    // current batch are handed out of '_batch' starting at '_batchPos', and carry the id of the
+    // snapshot the batch was read in.
+    size_t _batchSize = 0;
+    std::vector<Record> _batch;
+    size_t _batchPos = 0;
+    SnapshotId _batchSnapshotId;
+
     // Stats
     CollectionScanStats _specificStats;
 };
@@ -115,6 +115,11 @@ struct CollectionScanParams {
     // Whether or not to return EOF and stop further scanning once MatchExpression evaluates to
     // false. Can only be set to true if the MatchExpression is present.
     bool shouldReturnEofOnFilterMismatch = false;
+
+    // Whether this scan may start at the position of the concurrent scans of the same collection
+    // and wrap around to the beginning of the collection, see SharedScanRegistry. Only valid for
+    // forward, unbounded, non-tailable scans which need not return records in RecordId order.
+    bool shareScanPosition = false;
 };
 
 }  // namespace mongo
@@ -203,9 +203,18 @@ Position DocumentStorage::findField(T field, LookupPolicy policy) const {
         return pos;
     }
 
+    // A document that already has a hashed field cache is being looked at field by field, and on
+    // wide documents every miss would rescan the backing BSON from the start. Bring the fields this
+    // scan walks past into the cache as well so that later lookups of them hit the hash table.
+    const bool cacheScannedFields = _numFields >= HASH_TAB_MIN && !_bsonHasMetadata;
+    auto self = const_cast<DocumentStorage*>(this);
     for (auto&& bsonElement : _bson) {
-        if (field == bsonElement.fieldNameStringData()) {
-            return const_cast<DocumentStorage*>(this)->constructInCache(bsonElement);
+        const auto fieldName = bsonElement.fieldNameStringData();
+        if (field == fieldName) {
+            return self->constructInCache(bsonElement);
+        }
+        if (cacheScannedFields && !findFieldInCache(fieldName).found()) {
+            self->constructInCache(bsonElement);
         }
     }
 
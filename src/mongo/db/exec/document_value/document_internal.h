@@ -589,6 +589,11 @@ public:
         return _firstElement ? _firstElement->plusBytes(_usedBytes) : nullptr;
     }
 
+    /// Returns true once enough fields are cached for lookups to go through the hash table.
+    bool hasHashTable() const {
+        return _numFields >= HASH_TAB_MIN;
+    }
+
     auto bsonHasMetadata() const {
         return _bsonHasMetadata;
     }
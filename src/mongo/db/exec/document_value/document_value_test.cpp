@@ -365,6 +365,41 @@ TEST(DocumentGetFieldNonCaching, TraverseArray) {
     checkArrayTagIsReturned();
 }
 
+TEST(DocumentGetField, WideDocumentCachesScannedFieldsOnceHashed) {
+    BSONObjBuilder builder;
+    for (int i = 0; i < 32; ++i) {
+        builder.append("f" + std::to_string(i), i);
+    }
+    BSONObj bson = builder.obj();
+    auto storagePtr = make_intrusive<DocumentStorage>(bson, false, false, 0);
+    const DocumentStorage& storage = *storagePtr;
+    auto cachedPosition = [&](int i) {
+        return storage.findField(StringData("f" + std::to_string(i)),
+                                 DocumentStorage::LookupPolicy::kCacheOnly);
+    };
+
+    // Fault in enough fields from the front of the document to build the hashed field cache. Until
+    // then a miss only caches the field that was asked for.
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_FALSE(storage.hasHashTable());
+        ASSERT_VALUE_EQ(storage.getField(StringData("f" + std::to_string(i))), Value(i));
+        ASSERT_FALSE(cachedPosition(i + 1).found());
+    }
+    ASSERT_TRUE(storage.hasHashTable());
+    for (int i = 4; i < 32; ++i) {
+        ASSERT_FALSE(cachedPosition(i).found()) << i;
+    }
+
+    // Looking up the last field walks past every other field, which are then cached as well.
+    ASSERT_VALUE_EQ(storage.getField("f31"_sd), Value(31));
+    for (int i = 0; i < 32; ++i) {
+        const auto pos = cachedPosition(i);
+        ASSERT_TRUE(pos.found()) << i;
+        ASSERT_VALUE_EQ(storage.getField(pos).val, Value(i));
+    }
+    ASSERT_EQ(storage.computeSize(), 32U);
+}
+
 TEST(DocumentSize, ApproximateSizeIsSnapshotted) {
     const auto rawBson = BSON("field"
                               << "value");
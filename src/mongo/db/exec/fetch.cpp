@@ -31,6 +31,7 @@
 
 #include "mongo/db/exec/fetch.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "mongo/db/catalog/collection.h"
@@ -38,6 +39,7 @@
 #include "mongo/db/exec/filter.h"
 #include "mongo/db/exec/scoped_timer.h"
 #include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/str.h"
 
@@ -57,7 +59,8 @@ FetchStage::FetchStage(ExpressionContext* expCtx,
     : RequiresCollectionStage(kStageType, expCtx, collection),
       _ws(ws),
       _filter((filter && !filter->isTriviallyTrue()) ? filter : nullptr),
-      _idRetrying(WorkingSet::INVALID_ID) {
+      _idRetrying(WorkingSet::INVALID_ID),
+      _lookaheadWindowSize(internalQueryFetchLookaheadWindowSize.load()) {
     _children.emplace_back(std::move(child));
 }
 
@@ -69,7 +72,7 @@ bool FetchStage::isEOF() {
         return false;
     }
 
-    return child()->isEOF();
+    return _window.empty() && child()->isEOF();
 }
 
 PlanStage::StageState FetchStage::doWork(WorkingSetID* out) {
@@ -77,6 +80,10 @@ PlanStage::StageState FetchStage::doWork(WorkingSetID* out) {
         return PlanStage::IS_EOF;
     }
 
+    if (_lookaheadWindowSize > 0) {
+        return doWorkWithLookahead(out);
+    }
+
     // Either retry the last WSM we worked on or get a new one from our child.
     WorkingSetID id;
     StageState status;
@@ -100,12 +107,7 @@ PlanStage::StageState FetchStage::doWork(WorkingSetID* out) {
             verify(member->hasRecordId());
 
             try {
-                const auto& coll = collection();
-                if (!_cursor)
-                    _cursor = coll->getCursor(opCtx());
-
-                if (!WorkingSetCommon::fetch(opCtx(), _ws, id, _cursor.get(), coll, coll->ns())) {
-                    _ws->free(id);
+                if (!fetch(id)) {
                     return NEED_TIME;
                 }
             } catch (const WriteConflictException&) {
@@ -126,6 +128,92 @@ PlanStage::StageState FetchStage::doWork(WorkingSetID* out) {
     return status;
 }
 
+PlanStage::StageState FetchStage::doWorkWithLookahead(WorkingSetID* out) {
+    if (_fillingWindow) {
+        if (_window.size() < _lookaheadWindowSize && !child()->isEOF()) {
+            WorkingSetID id;
+            StageState status = child()->work(&id);
+            if (PlanStage::ADVANCED == status) {
+                _window.push_back(id);
+                return NEED_TIME;
+            } else if (PlanStage::NEED_YIELD == status) {
+                *out = id;
+            }
+            if (PlanStage::IS_EOF != status) {
+                return status;
+            }
+        }
+
+        // The window is full, or the child has nothing more to give. Fetch the records in
+        // ascending RecordId order.
+        _fillingWindow = false;
+        for (size_t i = 0; i < _window.size(); ++i) {
+            WorkingSetMember* member = _ws->get(_window[i]);
+            if (member->hasObj()) {
+                ++_specificStats.alreadyHasObj;
+                continue;
+            }
+            verify(WorkingSetMember::RID_AND_IDX == member->getState());
+            verify(member->hasRecordId());
+            _toFetch.push_back(i);
+        }
+        std::sort(_toFetch.begin(), _toFetch.end(), [&](size_t lhs, size_t rhs) {
+            return _ws->get(_window[lhs])->recordId > _ws->get(_window[rhs])->recordId;
+        });
+    }
+
+    if (!_toFetch.empty()) {
+        WorkingSetID& id = _window[_toFetch.back()];
+        try {
+            if (fetch(id)) {
+                // The record is returned after more records have been read with '_cursor', so the
+                // member cannot keep pointing into the cursor's buffer.
+                _ws->get(id)->makeObjOwnedIfNeeded();
+            } else {
+                id = WorkingSet::INVALID_ID;
+            }
+        } catch (const WriteConflictException&) {
+            // The record is fetched again once we have yielded.
+            *out = WorkingSet::INVALID_ID;
+            return NEED_YIELD;
+        }
+        _toFetch.pop_back();
+        return NEED_TIME;
+    }
+
+    if (_nextToReturn == _window.size()) {
+        // The child reached EOF without producing anything more.
+        _window.clear();
+        _nextToReturn = 0;
+        _fillingWindow = true;
+        return IS_EOF;
+    }
+
+    WorkingSetID id = _window[_nextToReturn++];
+    if (_nextToReturn == _window.size()) {
+        _window.clear();
+        _nextToReturn = 0;
+        _fillingWindow = true;
+    }
+
+    if (WorkingSet::INVALID_ID == id) {
+        return NEED_TIME;
+    }
+    return returnIfMatches(_ws->get(id), id, out);
+}
+
+bool FetchStage::fetch(WorkingSetID id) {
+    const auto& coll = collection();
+    if (!_cursor)
+        _cursor = coll->getCursor(opCtx());
+
+    if (!WorkingSetCommon::fetch(opCtx(), _ws, id, _cursor.get(), coll, coll->ns())) {
+        _ws->free(id);
+        return false;
+    }
+    return true;
+}
+
 void FetchStage::doSaveStateRequiresCollection() {
     if (_cursor) {
         _cursor->saveUnpositioned();
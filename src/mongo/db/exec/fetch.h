@@ -30,6 +30,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "mongo/db/exec/requires_collection_stage.h"
 #include "mongo/db/jsobj.h"
@@ -47,6 +48,10 @@ class SeekableRecordCursor;
  * the record at the provided RecordId.  Returns verbatim any data that already has an object.
  *
  * Preconditions: Valid RecordId.
+ *
+ * When 'internalQueryFetchLookaheadWindowSize' is non-zero, the stage reads up to that many members
+ * ahead from its child and fetches their records in RecordId order, so that records close together
+ * on disk are read together. The members are still returned in the order the child produced them.
  */
 class FetchStage : public RequiresCollectionStage {
 public:
@@ -86,6 +91,18 @@ private:
      */
     StageState returnIfMatches(WorkingSetMember* member, WorkingSetID memberID, WorkingSetID* out);
 
+    /**
+     * doWork() when reading ahead: fills '_window' from the child, fetches the records of the
+     * window in RecordId order, then returns the window's members in child order.
+     */
+    StageState doWorkWithLookahead(WorkingSetID* out);
+
+    /**
+     * Fetches the record for 'id' with '_cursor'. Returns false, after freeing 'id', if the record
+     * no longer exists.
+     */
+    bool fetch(WorkingSetID id);
+
     // Used to fetch Records from _collection.
     std::unique_ptr<SeekableRecordCursor> _cursor;
 
@@ -98,6 +115,21 @@ private:
     // If not Null, we use this rather than asking our child what to do next.
     WorkingSetID _idRetrying;
 
+    // The maximum number of members read ahead from the child, or 0 to fetch one at a time.
+    const size_t _lookaheadWindowSize;
+
+    // Members read ahead from the child, in child order. An entry is INVALID_ID once its record
+    // was found to have been deleted.
+    std::vector<WorkingSetID> _window;
+
+    // Positions in '_window' whose records remain to be fetched, by decreasing RecordId.
+    std::vector<size_t> _toFetch;
+
+    // Position in '_window' of the next member to return, once all of its records are fetched.
+    size_t _nextToReturn = 0;
+
+    bool _fillingWindow = true;
+
     // Stats
     FetchStats _specificStats;
 };
@@ -31,6 +31,7 @@
 
 #include "mongo/db/exec/idhack.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "mongo/db/catalog/index_catalog.h"
@@ -72,6 +73,18 @@ IDHackStage::IDHackStage(ExpressionContext* expCtx,
     _specificStats.indexName = descriptor->indexName();
 }
 
+IDHackStage::IDHackStage(ExpressionContext* expCtx,
+                         std::vector<BSONObj> keys,
+                         WorkingSet* ws,
+                         const CollectionPtr& collection,
+                         const IndexDescriptor* descriptor)
+    : RequiresIndexStage(kStageType, expCtx, collection, descriptor, ws),
+      _workingSet(ws),
+      _keys(std::move(keys)) {
+    invariant(!_keys.empty());
+    _specificStats.indexName = descriptor->indexName();
+}
+
 IDHackStage::~IDHackStage() {}
 
 bool IDHackStage::isEOF() {
@@ -83,6 +96,10 @@ PlanStage::StageState IDHackStage::doWork(WorkingSetID* out) {
         return PlanStage::IS_EOF;
     }
 
+    if (!_keys.empty()) {
+        return doWorkBatch(out);
+    }
+
     WorkingSetID id = WorkingSet::INVALID_ID;
     try {
         // Look up the key by going directly to the index.
@@ -130,6 +147,57 @@ PlanStage::StageState IDHackStage::doWork(WorkingSetID* out) {
     }
 }
 
+PlanStage::StageState IDHackStage::doWorkBatch(WorkingSetID* out) {
+    WorkingSetID id = WorkingSet::INVALID_ID;
+    try {
+        if (!_recordIds) {
+            // Look all the keys up in the index at once, then fetch the documents in storage order.
+            auto recordIds =
+                indexAccessMethod()->asSortedData()->findMany(opCtx(), collection(), _keys);
+            std::sort(recordIds.begin(), recordIds.end());
+            _specificStats.keysExamined += recordIds.size();
+            _recordIds = std::move(recordIds);
+        }
+
+        if (_nextRecordId == _recordIds->size()) {
+            _done = true;
+            return PlanStage::IS_EOF;
+        }
+
+        // Create a new WSM for the next result document.
+        id = _workingSet->allocate();
+        WorkingSetMember* member = _workingSet->get(id);
+        member->recordId = (*_recordIds)[_nextRecordId];
+        _workingSet->transitionToRecordIdAndIdx(id);
+
+        const auto& coll = collection();
+        if (!_recordCursor)
+            _recordCursor = coll->getCursor(opCtx());
+
+        ++_specificStats.docsExamined;
+        const bool found = WorkingSetCommon::fetch(
+            opCtx(), _workingSet, id, _recordCursor.get(), coll, coll->ns());
+        ++_nextRecordId;
+        if (!found) {
+            // The document was deleted since we looked its key up.
+            _workingSet->free(id);
+            return PlanStage::NEED_TIME;
+        }
+
+        invariant(member->hasObj());
+        *out = id;
+        return PlanStage::ADVANCED;
+    } catch (const WriteConflictException&) {
+        // Retry the current document.
+        _recordCursor.reset();
+        if (id != WorkingSet::INVALID_ID)
+            _workingSet->free(id);
+
+        *out = WorkingSet::INVALID_ID;
+        return NEED_YIELD;
+    }
+}
+
 PlanStage::StageState IDHackStage::advance(WorkingSetID id,
                                            WorkingSetMember* member,
                                            WorkingSetID* out) {
@@ -30,6 +30,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "mongo/db/exec/requires_index_stage.h"
 #include "mongo/db/query/canonical_query.h"
@@ -44,6 +45,10 @@ class RecordCursor;
  * A standalone stage implementing the fast path for key-value retrievals via the _id index. Since
  * the _id index always has the collection default collation, the IDHackStage can only be used when
  * the query's collation is equal to the collection default.
+ *
+ * The stage can also look up a batch of _id values, e.g. for {_id: {$in: [...]}}. It then resolves
+ * all of them through the _id index in index order first, and fetches the documents found in
+ * RecordId order. The documents are therefore returned in storage order.
  */
 class IDHackStage final : public RequiresIndexStage {
 public:
@@ -60,6 +65,15 @@ public:
                 const CollectionPtr& collection,
                 const IndexDescriptor* descriptor);
 
+    /**
+     * Looks up every one of 'keys', which are of the form {_id: <value>}.
+     */
+    IDHackStage(ExpressionContext* expCtx,
+                std::vector<BSONObj> keys,
+                WorkingSet* ws,
+                const CollectionPtr& collection,
+                const IndexDescriptor* descriptor);
+
     ~IDHackStage();
 
     bool isEOF() final;
@@ -91,6 +105,11 @@ private:
      */
     StageState advance(WorkingSetID id, WorkingSetMember* member, WorkingSetID* out);
 
+    /**
+     * Implements doWork() for a batch of keys, returning the next document found.
+     */
+    StageState doWorkBatch(WorkingSetID* out);
+
     std::unique_ptr<SeekableRecordCursor> _recordCursor;
 
     // The WorkingSet we annotate with results.  Not owned by us.
@@ -99,6 +118,12 @@ private:
     // The value to match against the _id field.
     BSONObj _key;
 
+    // For a batched lookup, the values to match against the _id field, and once looked up, the
+    // sorted RecordIds of the documents still to be returned.
+    std::vector<BSONObj> _keys;
+    boost::optional<std::vector<RecordId>> _recordIds;
+    size_t _nextRecordId = 0;
+
     // Have we returned our one document?
     bool _done = false;
 
@@ -56,7 +56,9 @@ MergeSortStage::MergeSortStage(ExpressionContext* expCtx,
       _pattern(params.pattern),
       _collator(params.collator),
       _dedup(params.dedup),
-      _merging(StageWithValueComparison(ws, params.pattern, params.collator)) {}
+      _mergeByRecordId(params.mergeByRecordId),
+      _merging(StageWithValueComparison(
+          ws, params.pattern, params.mergeByRecordId, params.collator)) {}
 
 void MergeSortStage::addChild(std::unique_ptr<PlanStage> child) {
     _children.emplace_back(std::move(child));
@@ -86,8 +88,8 @@ PlanStage::StageState MergeSortStage::doWork(WorkingSetID* out) {
         if (PlanStage::ADVANCED == code) {
             WorkingSetMember* member = _ws->get(id);
 
-            // If we're deduping...
-            if (_dedup) {
+            // If we're deduping, and can't rely on duplicates coming out next to each other...
+            if (_dedup && !_mergeByRecordId) {
                 if (!member->hasRecordId()) {
                     // Can't dedup data unless there's a RecordId.  We go ahead and use its
                     // result.
@@ -154,6 +156,20 @@ PlanStage::StageState MergeSortStage::doWork(WorkingSetID* out) {
     WorkingSetID idToTest = top->id;
     _mergingData.erase(top);
 
+    if (_dedup && _mergeByRecordId) {
+        WorkingSetMember* member = _ws->get(idToTest);
+        tassert(7000118,
+                "Merging on RecordId requires results with a RecordId",
+                member->hasRecordId());
+        ++_specificStats.dupsTested;
+        if (_lastRecordId && *_lastRecordId == member->recordId) {
+            _ws->free(idToTest);
+            ++_specificStats.dupsDropped;
+            return PlanStage::NEED_TIME;
+        }
+        _lastRecordId = member->recordId;
+    }
+
     // Return the min.
     *out = idToTest;
 
@@ -167,6 +183,10 @@ bool MergeSortStage::StageWithValueComparison::operator()(const MergingRef& lhs,
     WorkingSetMember* lhsMember = _ws->get(lhs->id);
     WorkingSetMember* rhsMember = _ws->get(rhs->id);
 
+    if (_mergeByRecordId) {
+        return lhsMember->recordId > rhsMember->recordId;
+    }
+
     BSONObjIterator it(_pattern);
     while (it.more()) {
         BSONElement patternElt = it.next();
@@ -242,6 +262,7 @@ unique_ptr<PlanStageStats> MergeSortStage::getStats() {
     _commonStats.isEOF = isEOF();
 
     _specificStats.sortPattern = _pattern;
+    _specificStats.mergeByRecordId = _mergeByRecordId;
 
     unique_ptr<PlanStageStats> ret =
         std::make_unique<PlanStageStats>(_commonStats, STAGE_SORT_MERGE);
@@ -54,6 +54,11 @@ class MergeSortStageParams;
  *
  * Preconditions: For each field in 'pattern' all inputs in the child must handle a
  * getFieldDotted for that field.
+ *
+ * If 'mergeByRecordId' is set, the children are instead sorted by RecordId, which is how index
+ * scans over a single key return their results. The output is then sorted by RecordId as well and
+ * duplicates come out next to each other, so they are dropped without remembering every RecordId
+ * seen so far.
  */
 class MergeSortStage final : public PlanStage {
 public:
@@ -89,8 +94,11 @@ private:
     // The comparison function used in our priority queue.
     class StageWithValueComparison {
     public:
-        StageWithValueComparison(WorkingSet* ws, BSONObj pattern, const CollatorInterface* collator)
-            : _ws(ws), _pattern(pattern), _collator(collator) {}
+        StageWithValueComparison(WorkingSet* ws,
+                                 BSONObj pattern,
+                                 bool mergeByRecordId,
+                                 const CollatorInterface* collator)
+            : _ws(ws), _pattern(pattern), _mergeByRecordId(mergeByRecordId), _collator(collator) {}
 
         // Is lhs less than rhs?  Note that priority_queue is a max heap by default so we invert
         // the return from the expected value.
@@ -102,6 +110,7 @@ private:
 
         WorkingSet* _ws;
         BSONObj _pattern;
+        bool _mergeByRecordId;
         const CollatorInterface* _collator;
     };
 
@@ -118,9 +127,16 @@ private:
     // Are we deduplicating on RecordId?
     const bool _dedup;
 
-    // Which RecordIds have we seen?
+    // Are the children merged on RecordId rather than according to '_pattern'?
+    const bool _mergeByRecordId;
+
+    // Which RecordIds have we seen? Unused when merging on RecordId.
     stdx::unordered_set<RecordId, RecordId::Hasher> _seen;
 
+    // The RecordId of the last result returned when merging on RecordId. Any duplicate of it is
+    // returned by one of the next calls to work(...).
+    boost::optional<RecordId> _lastRecordId;
+
     // In order to pick the next smallest value, we need each child work(...) until it produces
     // a result.  This is the queue of children that haven't given us a result yet.
     std::queue<PlanStage*> _noResultToMerge;
@@ -138,7 +154,7 @@ private:
 // Parameters that must be provided to a MergeSortStage
 class MergeSortStageParams {
 public:
-    MergeSortStageParams() : collator(nullptr), dedup(true) {}
+    MergeSortStageParams() : collator(nullptr), dedup(true), mergeByRecordId(false) {}
 
     // How we're sorting.
     BSONObj pattern;
@@ -149,6 +165,9 @@ public:
 
     // Do we deduplicate on RecordId?
     bool dedup;
+
+    // Are the children sorted by RecordId rather than by 'pattern'?
+    bool mergeByRecordId;
 };
 
 }  // namespace mongo
@@ -214,13 +214,28 @@ void updatePlanCache(
                                            sbe::CachedSbePlan,
                                            plan_cache_debug_info::DebugInfoSBE>
                         callbacks{query, buildDebugInfoFn};
+                    auto sbeKey =
+                        plan_cache_key_factory::make<sbe::PlanCacheKey>(query, collection);
                     uassertStatusOK(sbe::getPlanCache(opCtx).set(
-                        plan_cache_key_factory::make<sbe::PlanCacheKey>(query, collection),
+                        sbeKey,
                         std::move(cachedPlan),
                         *rankingDecision,
                         opCtx->getServiceContext()->getPreciseClockSource()->now(),
                         &callbacks,
                         boost::none /* worksGrowthCoefficient */));
+
+                    // Index filters are per collection, so a solution shaped by one must not be
+                    // shared with other collections.
+                    auto& sharedCache =
+                        sbe::SharedShapePlanCache::get(opCtx->getServiceContext());
+                    if (sharedCache.isEnabled() && !winningPlan.solution->indexFilterApplied) {
+                        auto&& sbeStats =
+                            stdx::get<plan_ranker::SBEStatsDetails>(rankingDecision->stats);
+                        sharedCache.set(
+                            plan_cache_key_factory::makeSharedShapeKey(opCtx, sbeKey, collection),
+                            {winningPlan.solution->cacheData->toBSON(),
+                             sbe::calculateNumberOfReads(sbeStats.candidatePlanStats[0].get())});
+                    }
                 } else {
                     // TODO(SERVER-61507, SERVER-64882): Fall back to use the classic plan cache.
                     // Remove this branch after "gFeatureFlagSbePlanCache" is removed and lowering
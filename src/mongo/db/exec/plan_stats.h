@@ -784,6 +784,11 @@ struct SortStats : public SpecificStats {
 
     // The number of times that we spilled data to disk during the execution of this query.
     uint64_t spills = 0u;
+
+    // The number of bytes written to disk when spilling, and the size of that data before it was
+    // compressed.
+    uint64_t spilledDataStorageSize = 0u;
+    uint64_t spilledUncompressedDataSize = 0u;
 };
 
 struct MergeSortStats : public SpecificStats {
@@ -810,6 +815,9 @@ struct MergeSortStats : public SpecificStats {
 
     // The pattern according to which we are sorting.
     BSONObj sortPattern;
+
+    // True if the children are merged on RecordId rather than according to 'sortPattern'.
+    bool mergeByRecordId = false;
 };
 
 struct ShardingFilterStats : public SpecificStats {
@@ -0,0 +1,115 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/record_id_bitmap.h"
+
+#include <algorithm>
+
+namespace mongo {
+namespace {
+
+int64_t highBits(int64_t id) {
+    return id >> 16;
+}
+
+uint16_t lowBits(int64_t id) {
+    return static_cast<uint16_t>(id & 0xFFFF);
+}
+
+}  // namespace
+
+bool RecordIdBitmap::Container::contains(uint16_t low) const {
+    if (isBitmap()) {
+        return bits[low / 64] & (uint64_t{1} << (low % 64));
+    }
+    return std::binary_search(array.begin(), array.end(), low);
+}
+
+bool RecordIdBitmap::Container::add(uint16_t low) {
+    if (isBitmap()) {
+        uint64_t& word = bits[low / 64];
+        const uint64_t mask = uint64_t{1} << (low % 64);
+        if (word & mask) {
+            return false;
+        }
+        word |= mask;
+        ++cardinality;
+        return true;
+    }
+
+    // Record ids are usually added in increasing order, so check the end of the array first.
+    auto it = array.empty() || array.back() < low
+        ? array.end()
+        : std::lower_bound(array.begin(), array.end(), low);
+    if (it != array.end() && *it == low) {
+        return false;
+    }
+    array.insert(it, low);
+    ++cardinality;
+
+    if (array.size() > kMaxArraySize) {
+        convertToBitmap();
+    }
+    return true;
+}
+
+void RecordIdBitmap::Container::convertToBitmap() {
+    bits.assign(kBitmapWords, 0);
+    for (auto low : array) {
+        bits[low / 64] |= uint64_t{1} << (low % 64);
+    }
+    array = std::vector<uint16_t>();
+}
+
+bool RecordIdBitmap::add(int64_t id) {
+    if (!_containers[highBits(id)].add(lowBits(id))) {
+        return false;
+    }
+    ++_size;
+    return true;
+}
+
+bool RecordIdBitmap::contains(int64_t id) const {
+    auto it = _containers.find(highBits(id));
+    return it != _containers.end() && it->second.contains(lowBits(id));
+}
+
+size_t RecordIdBitmap::getMemUsage() const {
+    size_t memUsage = sizeof(*this);
+    for (auto&& [high, container] : _containers) {
+        memUsage += sizeof(high) + sizeof(container) +
+            container.array.capacity() * sizeof(uint16_t) +
+            container.bits.capacity() * sizeof(uint64_t);
+    }
+    return memUsage;
+}
+
+}  // namespace mongo
@@ -0,0 +1,103 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "mongo/stdx/unordered_map.h"
+
+namespace mongo {
+
+/**
+ * A compressed set of 64-bit integer record ids, organized like a roaring bitmap: the ids are
+ * partitioned by their high 48 bits, and the low 16 bits of the ids within each partition are
+ * stored in a sorted array while the partition is sparse, or in a 65536-bit bitmap once it is
+ * dense. Record ids of a collection are mostly allocated sequentially, so a set of them costs a
+ * few bits per member instead of a hash table node.
+ */
+class RecordIdBitmap {
+public:
+    /**
+     * Adds 'id' to the set. Returns false if it was already a member.
+     */
+    bool add(int64_t id);
+
+    bool contains(int64_t id) const;
+
+    void clear() {
+        _containers.clear();
+        _size = 0;
+    }
+
+    size_t size() const {
+        return _size;
+    }
+
+    bool empty() const {
+        return _size == 0;
+    }
+
+    /**
+     * Returns the approximate number of bytes used by the set.
+     */
+    size_t getMemUsage() const;
+
+private:
+    // A partition switches from a sorted array to a bitmap once the array would be larger than the
+    // bitmap.
+    static constexpr size_t kMaxArraySize = 4096;
+    static constexpr size_t kBitmapWords = (1 << 16) / 64;
+
+    struct Container {
+        bool contains(uint16_t low) const;
+        bool add(uint16_t low);
+        void convertToBitmap();
+
+        bool isBitmap() const {
+            return !bits.empty();
+        }
+
+        // The sorted low bits of the members, used while the partition has at most
+        // 'kMaxArraySize' members.
+        std::vector<uint16_t> array;
+
+        // One bit per possible member, used once the partition has more than 'kMaxArraySize'
+        // members.
+        std::vector<uint64_t> bits;
+
+        size_t cardinality = 0;
+    };
+
+    stdx::unordered_map<int64_t, Container> _containers;
+    size_t _size = 0;
+};
+
+}  // namespace mongo
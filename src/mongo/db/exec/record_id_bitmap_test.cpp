@@ -0,0 +1,76 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/record_id_bitmap.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+TEST(RecordIdBitmapTest, AddAndContains) {
+    RecordIdBitmap bitmap;
+    ASSERT_TRUE(bitmap.empty());
+
+    ASSERT_TRUE(bitmap.add(5));
+    ASSERT_TRUE(bitmap.add(1));
+    ASSERT_TRUE(bitmap.add(int64_t{1} << 40));
+    ASSERT_FALSE(bitmap.add(5));
+
+    ASSERT_EQ(bitmap.size(), 3U);
+    ASSERT_TRUE(bitmap.contains(1));
+    ASSERT_TRUE(bitmap.contains(5));
+    ASSERT_TRUE(bitmap.contains(int64_t{1} << 40));
+    ASSERT_FALSE(bitmap.contains(2));
+    ASSERT_FALSE(bitmap.contains((int64_t{1} << 40) + 5));
+
+    bitmap.clear();
+    ASSERT_TRUE(bitmap.empty());
+    ASSERT_FALSE(bitmap.contains(5));
+}
+
+TEST(RecordIdBitmapTest, DensePartitionsConvertToBitmaps) {
+    RecordIdBitmap bitmap;
+    for (int64_t id = 0; id < 20000; id += 2) {
+        ASSERT_TRUE(bitmap.add(id));
+    }
+    ASSERT_EQ(bitmap.size(), 10000U);
+
+    for (int64_t id = 0; id < 20000; ++id) {
+        ASSERT_EQ(bitmap.contains(id), id % 2 == 0);
+    }
+    ASSERT_FALSE(bitmap.add(19998));
+
+    // A dense partition costs one bit per possible member rather than two bytes per member.
+    ASSERT_LT(bitmap.getMemUsage(), 10000U * sizeof(uint16_t));
+}
+
+}  // namespace
+}  // namespace mongo
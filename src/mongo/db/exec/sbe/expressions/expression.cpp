@@ -431,6 +431,10 @@ static stdx::unordered_map<std::string, BuiltinFn> kBuiltinFunctions = {
      BuiltinFn{[](size_t n) { return n == 1; }, vm::Builtin::aggDoubleDoubleSum, true}},
     {"aggMergeDoubleDoubleSums",
      BuiltinFn{[](size_t n) { return n == 1; }, vm::Builtin::aggMergeDoubleDoubleSums, true}},
+    {"aggDoubleDoubleSumOfArray",
+     BuiltinFn{[](size_t n) { return n == 1; }, vm::Builtin::aggDoubleDoubleSumOfArray, true}},
+    {"aggMinOfArray", BuiltinFn{[](size_t n) { return n == 1; }, vm::Builtin::aggMinOfArray, true}},
+    {"aggMaxOfArray", BuiltinFn{[](size_t n) { return n == 1; }, vm::Builtin::aggMaxOfArray, true}},
     {"doubleDoubleSumFinalize",
      BuiltinFn{[](size_t n) { return n > 0; }, vm::Builtin::doubleDoubleSumFinalize, false}},
     {"doubleDoubleMergeSumFinalize",
@@ -524,6 +528,26 @@ static stdx::unordered_map<std::string, BuiltinFn> kBuiltinFunctions = {
     {"tsSecond", BuiltinFn{[](size_t n) { return n == 1; }, vm::Builtin::tsSecond, false}},
     {"tsIncrement", BuiltinFn{[](size_t n) { return n == 1; }, vm::Builtin::tsIncrement, false}},
     {"typeMatch", BuiltinFn{[](size_t n) { return n == 2; }, vm::Builtin::typeMatch, false}},
+    {"valueBlockFillEmpty",
+     BuiltinFn{[](size_t n) { return n == 2; }, vm::Builtin::valueBlockFillEmpty, false}},
+    {"valueBlockGtScalar",
+     BuiltinFn{[](size_t n) { return n == 2; }, vm::Builtin::valueBlockGtScalar, false}},
+    {"valueBlockGteScalar",
+     BuiltinFn{[](size_t n) { return n == 2; }, vm::Builtin::valueBlockGteScalar, false}},
+    {"valueBlockEqScalar",
+     BuiltinFn{[](size_t n) { return n == 2; }, vm::Builtin::valueBlockEqScalar, false}},
+    {"valueBlockNeqScalar",
+     BuiltinFn{[](size_t n) { return n == 2; }, vm::Builtin::valueBlockNeqScalar, false}},
+    {"valueBlockLtScalar",
+     BuiltinFn{[](size_t n) { return n == 2; }, vm::Builtin::valueBlockLtScalar, false}},
+    {"valueBlockLteScalar",
+     BuiltinFn{[](size_t n) { return n == 2; }, vm::Builtin::valueBlockLteScalar, false}},
+    {"valueBlockLogicalAnd",
+     BuiltinFn{[](size_t n) { return n == 2; }, vm::Builtin::valueBlockLogicalAnd, false}},
+    {"valueBlockLogicalOr",
+     BuiltinFn{[](size_t n) { return n == 2; }, vm::Builtin::valueBlockLogicalOr, false}},
+    {"valueBlockCount",
+     BuiltinFn{[](size_t n) { return n == 1; }, vm::Builtin::valueBlockCount, false}},
 };
 
 /**
@@ -660,6 +684,36 @@ vm::CodeFragment EFunction::compileDirect(CompileCtx& ctx) const {
             return code;
         }
 
+        // Use the superinstruction form of 'getField' when the field name is a constant, so that
+        // the name is encoded in the bytecode instead of being pushed onto the stack.
+        if (_name == "getField" && _nodes[1]->as<EConstant>()) {
+            auto [fieldTag, fieldVal] = _nodes[1]->as<EConstant>()->getConstant();
+            if (value::isString(fieldTag)) {
+                auto fieldName = value::getStringView(fieldTag, fieldVal);
+                if (fieldName.size() <= vm::CodeFragment::kMaxImmFieldNameSize) {
+                    code.append(_nodes[0]->compileDirect(ctx));
+                    code.appendGetField(fieldName);
+                    return code;
+                }
+            }
+        }
+
+        // Similarly, 'fillEmpty' with a constant null or boolean default value does not need to
+        // push the default onto the stack.
+        if (_name == "fillEmpty" && _nodes[1]->as<EConstant>()) {
+            auto [defaultTag, defaultVal] = _nodes[1]->as<EConstant>()->getConstant();
+            if (defaultTag == value::TypeTags::Null) {
+                code.append(_nodes[0]->compileDirect(ctx));
+                code.appendFillEmpty(vm::Instruction::Null);
+                return code;
+            } else if (defaultTag == value::TypeTags::Boolean) {
+                code.append(_nodes[0]->compileDirect(ctx));
+                code.appendFillEmpty(value::bitcastTo<bool>(defaultVal) ? vm::Instruction::True
+                                                                        : vm::Instruction::False);
+                return code;
+            }
+        }
+
         // The order of evaluation is flipped for instruction functions. We may want to change the
         // evaluation code for those functions so we have the same behavior for all functions.
         for (size_t idx = 0; idx < _nodes.size(); ++idx) {
@@ -0,0 +1,247 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include <numeric>
+
+#include "mongo/db/exec/sbe/expression_test_base.h"
+#include "mongo/db/exec/sbe/vm/array_kernels.h"
+#include "mongo/db/query/sbe_stage_builder_helpers.h"
+
+namespace mongo::sbe {
+
+class SBEAggOfArrayBuiltinsTest : public EExpressionTestFixture {
+protected:
+    static bool valueEquals(value::TypeTags lhsTag,
+                            value::Value lhsVal,
+                            value::TypeTags rhsTag,
+                            value::Value rhsVal) {
+        auto [cmpTag, cmpVal] = value::compareValue(lhsTag, lhsVal, rhsTag, rhsVal);
+        return cmpTag == value::TypeTags::NumberInt32 && value::bitcastTo<int32_t>(cmpVal) == 0;
+    }
+
+    /**
+     * Runs the aggregate builtin 'name' over each of 'inputs' in turn, starting from an empty
+     * accumulator, and returns the final accumulator value.
+     */
+    std::pair<value::TypeTags, value::Value> runAgg(StringData name,
+                                                    const std::vector<BSONArray>& inputs,
+                                                    bool unwindInputs) {
+        value::OwnedValueAccessor aggAccessor, inputAccessor;
+        auto inputSlot = bindAccessor(&inputAccessor);
+        auto expr = stage_builder::makeFunction(name, stage_builder::makeVariable(inputSlot));
+        auto compiledExpr = compileAggExpression(*expr, &aggAccessor);
+
+        auto step = [&](value::TypeTags tag, value::Value val) {
+            inputAccessor.reset(tag, val);
+            auto [resTag, resVal] = runCompiledExpression(compiledExpr.get());
+            aggAccessor.reset(resTag, resVal);
+        };
+
+        for (auto&& input : inputs) {
+            auto [arrTag, arrVal] = makeArray(input);
+            if (!unwindInputs) {
+                step(arrTag, arrVal);
+                continue;
+            }
+
+            // Feed the elements of the array one at a time, as the per-element builtins see them.
+            value::ValueGuard arrGuard{arrTag, arrVal};
+            auto arr = value::getArrayView(arrVal);
+            for (size_t idx = 0; idx < arr->size(); ++idx) {
+                auto [elemTag, elemVal] = arr->getAt(idx);
+                auto [copyTag, copyVal] = value::copyValue(elemTag, elemVal);
+                step(copyTag, copyVal);
+            }
+        }
+
+        return aggAccessor.copyOrMoveValue();
+    }
+
+    /**
+     * Asserts that summing whole arrays with 'aggDoubleDoubleSumOfArray' produces the same state
+     * as folding their elements one by one with 'aggDoubleDoubleSum'.
+     */
+    void assertSumMatchesElementWise(const std::vector<BSONArray>& inputs) {
+        auto [expectedTag, expectedVal] = runAgg("aggDoubleDoubleSum", inputs, true);
+        value::ValueGuard expectedGuard{expectedTag, expectedVal};
+        auto [actualTag, actualVal] = runAgg("aggDoubleDoubleSumOfArray", inputs, false);
+        value::ValueGuard actualGuard{actualTag, actualVal};
+
+        ASSERT_TRUE(valueEquals(actualTag, actualVal, expectedTag, expectedVal))
+            << "expected: " << std::make_pair(expectedTag, expectedVal)
+            << " actual: " << std::make_pair(actualTag, actualVal);
+    }
+
+    void assertMinMax(const std::vector<BSONArray>& inputs, BSONArray expected) {
+        auto [expectedTag, expectedVal] = makeArray(expected);
+        value::ValueGuard expectedGuard{expectedTag, expectedVal};
+        auto expectedArr = value::getArrayView(expectedVal);
+
+        StringData names[] = {"aggMinOfArray"_sd, "aggMaxOfArray"_sd};
+        for (size_t idx = 0; idx < 2; ++idx) {
+            auto [actualTag, actualVal] = runAgg(names[idx], inputs, false);
+            value::ValueGuard actualGuard{actualTag, actualVal};
+            auto [tag, val] = expectedArr->getAt(idx);
+
+            ASSERT_EQ(actualTag, tag) << names[idx];
+            ASSERT_TRUE(valueEquals(actualTag, actualVal, tag, val))
+                << names[idx] << " expected: " << std::make_pair(tag, val)
+                << " actual: " << std::make_pair(actualTag, actualVal);
+        }
+    }
+};
+
+TEST_F(SBEAggOfArrayBuiltinsTest, SumOfInt64Arrays) {
+    assertSumMatchesElementWise({BSON_ARRAY(1LL << 2LL << 3LL << 4LL << 5LL << 6LL << 7LL),
+                                 BSON_ARRAY(-100LL << 50LL),
+                                 BSONArray{}});
+}
+
+TEST_F(SBEAggOfArrayBuiltinsTest, SumOfInt64ArrayWhichOverflows) {
+    const long long big = std::numeric_limits<long long>::max() - 1;
+    assertSumMatchesElementWise({BSON_ARRAY(big << big << 1LL << big << -big << 5LL)});
+}
+
+TEST_F(SBEAggOfArrayBuiltinsTest, SumOfDoubleArrays) {
+    assertSumMatchesElementWise(
+        {BSON_ARRAY(0.5 << 1.25 << -3.75 << 8.0 << 2.5 << 0.25), BSON_ARRAY(1.5 << 2.5)});
+}
+
+TEST_F(SBEAggOfArrayBuiltinsTest, SumOfDoubleArrayWithSpecialValues) {
+    const double inf = std::numeric_limits<double>::infinity();
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    assertSumMatchesElementWise({BSON_ARRAY(1.0 << inf << 2.0 << 3.0 << 4.0)});
+    assertSumMatchesElementWise({BSON_ARRAY(1.0 << inf << -inf << 3.0 << 4.0)});
+    assertSumMatchesElementWise({BSON_ARRAY(1.0 << nan << 2.0 << 3.0 << 4.0)});
+}
+
+TEST_F(SBEAggOfArrayBuiltinsTest, SumOfMixedArrays) {
+    assertSumMatchesElementWise({BSON_ARRAY(1 << 2LL << 3.5 << "str" << BSONNULL),
+                                 BSON_ARRAY(Decimal128("1.1") << 4LL << 5LL << 6LL << 7LL),
+                                 BSON_ARRAY(1LL << 2LL << 3LL << 4LL << 5LL)});
+}
+
+TEST_F(SBEAggOfArrayBuiltinsTest, SumOfScalar) {
+    value::OwnedValueAccessor aggAccessor, inputAccessor;
+    auto inputSlot = bindAccessor(&inputAccessor);
+    auto expr = stage_builder::makeFunction("aggDoubleDoubleSumOfArray",
+                                            stage_builder::makeVariable(inputSlot));
+    auto compiledExpr = compileAggExpression(*expr, &aggAccessor);
+
+    inputAccessor.reset(value::TypeTags::NumberInt32, value::bitcastFrom<int32_t>(5));
+    auto [resTag, resVal] = runCompiledExpression(compiledExpr.get());
+    value::ValueGuard resGuard{resTag, resVal};
+
+    ASSERT_EQ(resTag, value::TypeTags::Array);
+    auto [sumTag, sumVal] = value::getArrayView(resVal)->getAt(1);
+    ASSERT_EQ(sumTag, value::TypeTags::NumberDouble);
+    ASSERT_EQ(value::bitcastTo<double>(sumVal), 5.0);
+}
+
+TEST_F(SBEAggOfArrayBuiltinsTest, MinMaxOfInt64Arrays) {
+    assertMinMax({BSON_ARRAY(5LL << -3LL << 7LL << 12LL << 0LL << -9LL << 4LL << 8LL << 1LL),
+                  BSON_ARRAY(2LL << 100LL)},
+                 BSON_ARRAY(-9LL << 100LL));
+}
+
+TEST_F(SBEAggOfArrayBuiltinsTest, MinMaxOfDoubleArrays) {
+    assertMinMax({BSON_ARRAY(5.5 << -3.25 << 7.0 << 12.5 << 1.0 << -9.75 << 4.0 << 8.0)},
+                 BSON_ARRAY(-9.75 << 12.5));
+}
+
+TEST_F(SBEAggOfArrayBuiltinsTest, MinMaxOfDoubleArrayWithNaNAndZeros) {
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    assertMinMax({BSON_ARRAY(5.5 << nan << 7.0 << 1.0 << 2.0)}, BSON_ARRAY(nan << 7.0));
+    assertMinMax({BSON_ARRAY(0.0 << 1.0 << -0.0 << 2.0 << 3.0)}, BSON_ARRAY(-0.0 << 3.0));
+}
+
+TEST_F(SBEAggOfArrayBuiltinsTest, MinMaxOfMixedArrays) {
+    assertMinMax({BSON_ARRAY(5 << "str" << 7.5 << BSONNULL), BSON_ARRAY(2LL << 1)},
+                 BSON_ARRAY(BSONNULL << "str"));
+}
+
+TEST_F(SBEAggOfArrayBuiltinsTest, MinMaxOfEmptyArrayAndScalar) {
+    for (auto name : {"aggMinOfArray"_sd, "aggMaxOfArray"_sd}) {
+        auto [emptyTag, emptyVal] = runAgg(name, {BSONArray{}}, false);
+        value::ValueGuard emptyGuard{emptyTag, emptyVal};
+        ASSERT_EQ(emptyTag, value::TypeTags::Nothing) << name;
+    }
+
+    // A scalar input is aggregated as a single value.
+    value::OwnedValueAccessor aggAccessor, inputAccessor;
+    auto inputSlot = bindAccessor(&inputAccessor);
+    auto expr =
+        stage_builder::makeFunction("aggMinOfArray", stage_builder::makeVariable(inputSlot));
+    auto compiledExpr = compileAggExpression(*expr, &aggAccessor);
+
+    aggAccessor.reset(value::TypeTags::NumberInt32, value::bitcastFrom<int32_t>(3));
+    inputAccessor.reset(value::TypeTags::NumberInt32, value::bitcastFrom<int32_t>(2));
+    auto [resTag, resVal] = runCompiledExpression(compiledExpr.get());
+    value::ValueGuard resGuard{resTag, resVal};
+    ASSERT_EQ(resTag, value::TypeTags::NumberInt32);
+    ASSERT_EQ(value::bitcastTo<int32_t>(resVal), 2);
+}
+
+TEST(SBEArrayKernelsTest, IntegerKernels) {
+    std::vector<int64_t> vals;
+    int64_t expectedSum = 0;
+    for (int64_t i = 0; i < 1003; ++i) {
+        vals.push_back(i % 2 ? i : -3 * i);
+        expectedSum += vals.back();
+    }
+
+    // Cover every possible length of the unvectorized tail.
+    for (size_t count : {size_t{1}, size_t{3}, size_t{4}, size_t{5}, vals.size()}) {
+        int64_t sum = std::accumulate(vals.begin(), vals.begin() + count, int64_t{0});
+        ASSERT_EQ(*vm::array_kernels::sumInt64(vals.data(), count), sum);
+        ASSERT_EQ(vm::array_kernels::minInt64(vals.data(), count),
+                  *std::min_element(vals.begin(), vals.begin() + count));
+        ASSERT_EQ(vm::array_kernels::maxInt64(vals.data(), count),
+                  *std::max_element(vals.begin(), vals.begin() + count));
+    }
+    ASSERT_EQ(*vm::array_kernels::sumInt64(vals.data(), vals.size()), expectedSum);
+
+    std::vector<int64_t> big(9, std::numeric_limits<int64_t>::max() / 4);
+    ASSERT_FALSE(vm::array_kernels::sumInt64(big.data(), big.size()));
+}
+
+TEST(SBEArrayKernelsTest, AllOfType) {
+    std::vector<value::TypeTags> tags(100, value::TypeTags::NumberInt64);
+    ASSERT_TRUE(
+        vm::array_kernels::allOfType(tags.data(), tags.size(), value::TypeTags::NumberInt64));
+    for (size_t idx : {0, 31, 32, 77, 99}) {
+        tags[idx] = value::TypeTags::NumberDouble;
+        ASSERT_FALSE(
+            vm::array_kernels::allOfType(tags.data(), tags.size(), value::TypeTags::NumberInt64))
+            << vm::array_kernels::implementationName() << " " << idx;
+        tags[idx] = value::TypeTags::NumberInt64;
+    }
+}
+
+}  // namespace mongo::sbe
@@ -0,0 +1,106 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/db/exec/sbe/expression_test_base.h"
+
+namespace mongo::sbe {
+using SBEImmediateInstructionsTest = EExpressionTestFixture;
+
+TEST_F(SBEImmediateInstructionsTest, GetFieldWithConstantName) {
+    value::ViewOfValueAccessor slotAccessor;
+    auto objSlot = bindAccessor(&slotAccessor);
+    auto expr = makeE<EFunction>(
+        "getField", makeEs(makeE<EVariable>(objSlot), makeE<EConstant>("b"_sd)));
+    auto compiledExpr = compileExpression(*expr);
+
+    auto bsonObj = BSON("a" << 1 << "b" << 2);
+    slotAccessor.reset(value::TypeTags::bsonObject,
+                       value::bitcastFrom<const char*>(bsonObj.objdata()));
+    auto [tag, val] = runCompiledExpression(compiledExpr.get());
+    value::ValueGuard guard(tag, val);
+    ASSERT_EQ(value::TypeTags::NumberInt32, tag);
+    ASSERT_EQ(2, value::bitcastTo<int32_t>(val));
+
+    auto missing = BSON("a" << 1);
+    slotAccessor.reset(value::TypeTags::bsonObject,
+                       value::bitcastFrom<const char*>(missing.objdata()));
+    runAndAssertNothing(compiledExpr.get());
+}
+
+TEST_F(SBEImmediateInstructionsTest, GetFieldWithLongConstantName) {
+    value::ViewOfValueAccessor slotAccessor;
+    auto objSlot = bindAccessor(&slotAccessor);
+    std::string fieldName(vm::CodeFragment::kMaxImmFieldNameSize + 1, 'x');
+    auto expr = makeE<EFunction>(
+        "getField", makeEs(makeE<EVariable>(objSlot), makeE<EConstant>(StringData{fieldName})));
+    auto compiledExpr = compileExpression(*expr);
+
+    auto bsonObj = BSON(fieldName << "value");
+    slotAccessor.reset(value::TypeTags::bsonObject,
+                       value::bitcastFrom<const char*>(bsonObj.objdata()));
+    auto [tag, val] = runCompiledExpression(compiledExpr.get());
+    value::ValueGuard guard(tag, val);
+    ASSERT_TRUE(value::isString(tag));
+    ASSERT_EQ("value"_sd, value::getStringView(tag, val));
+}
+
+TEST_F(SBEImmediateInstructionsTest, FillEmptyWithConstantDefault) {
+    value::OwnedValueAccessor slotAccessor;
+    auto argSlot = bindAccessor(&slotAccessor);
+
+    for (auto [defaultTag, defaultVal] : {std::make_pair(value::TypeTags::Null, value::Value{0}),
+                                          makeBool(true),
+                                          makeBool(false)}) {
+        auto expr = makeE<EFunction>(
+            "fillEmpty",
+            makeEs(makeE<EVariable>(argSlot), makeE<EConstant>(defaultTag, defaultVal)));
+        auto compiledExpr = compileExpression(*expr);
+
+        // Nothing is replaced by the default value.
+        slotAccessor.reset(value::TypeTags::Nothing, 0);
+        {
+            auto [tag, val] = runCompiledExpression(compiledExpr.get());
+            value::ValueGuard guard(tag, val);
+            ASSERT_EQ(defaultTag, tag);
+            ASSERT_EQ(defaultVal, val);
+        }
+
+        // Any other value is passed through untouched.
+        auto [strTag, strVal] = value::makeNewString("not so small string"_sd);
+        slotAccessor.reset(true, strTag, strVal);
+        {
+            auto [tag, val] = runCompiledExpression(compiledExpr.get());
+            value::ValueGuard guard(tag, val);
+            ASSERT_EQ(value::TypeTags::StringBig, tag);
+            ASSERT_EQ("not so small string"_sd, value::getStringView(tag, val));
+        }
+    }
+}
+
+}  // namespace mongo::sbe
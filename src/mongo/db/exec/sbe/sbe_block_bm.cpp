@@ -0,0 +1,236 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/bson/util/bsoncolumnbuilder.h"
+#include "mongo/db/exec/sbe/expressions/expression.h"
+#include "mongo/db/exec/sbe/stages/block_to_row.h"
+#include "mongo/db/exec/sbe/stages/co_scan.h"
+#include "mongo/db/exec/sbe/stages/filter.h"
+#include "mongo/db/exec/sbe/stages/limit_skip.h"
+#include "mongo/db/exec/sbe/stages/project.h"
+#include "mongo/db/exec/sbe/stages/row_to_block.h"
+#include "mongo/db/exec/sbe/stages/ts_bucket_to_block.h"
+#include "mongo/db/exec/sbe/stages/unwind.h"
+#include "mongo/db/exec/sbe/values/block_interface.h"
+
+namespace mongo::sbe {
+namespace {
+constexpr size_t kNumRows = 100 * 1000;
+constexpr int64_t kThreshold = kNumRows / 2;
+
+/**
+ * Builds a limit/coscan -> project -> unwind subtree which streams out the elements of the
+ * array 'arrTag/arrVal' through 'outSlot', one per call to getNext(), mimicking a collection scan.
+ * Takes ownership of the array.
+ */
+std::unique_ptr<PlanStage> makeVirtualScan(value::TypeTags arrTag,
+                                           value::Value arrVal,
+                                           value::SlotId arraySlot,
+                                           value::SlotId outSlot,
+                                           value::SlotId indexSlot) {
+    auto limit = makeS<LimitSkipStage>(
+        makeS<CoScanStage>(kEmptyPlanNodeId), 1, boost::none, kEmptyPlanNodeId);
+    auto project = makeProjectStage(
+        std::move(limit), kEmptyPlanNodeId, arraySlot, makeE<EConstant>(arrTag, arrVal));
+    return makeS<UnwindStage>(std::move(project),
+                              arraySlot,
+                              outSlot,
+                              indexSlot,
+                              false /* preserveNullAndEmptyArrays */,
+                              kEmptyPlanNodeId);
+}
+
+std::pair<value::TypeTags, value::Value> makeRows() {
+    auto [arrTag, arrVal] = value::makeNewArray();
+    auto arr = value::getArrayView(arrVal);
+    arr->reserve(kNumRows);
+    for (size_t i = 0; i < kNumRows; ++i) {
+        arr->push_back(value::TypeTags::NumberInt64, value::bitcastFrom<int64_t>(i));
+    }
+    return {arrTag, arrVal};
+}
+
+/**
+ * Returns an array of blocks holding the same values as 'makeRows()', as a columnar source would
+ * produce them.
+ */
+std::pair<value::TypeTags, value::Value> makeBlocks(size_t blockSize) {
+    auto [arrTag, arrVal] = value::makeNewArray();
+    auto arr = value::getArrayView(arrVal);
+    for (size_t i = 0; i < kNumRows; i += blockSize) {
+        auto block = std::make_unique<value::HeterogeneousBlock>();
+        block->reserve(blockSize);
+        for (size_t j = i; j < std::min(i + blockSize, kNumRows); ++j) {
+            block->push_back(value::TypeTags::NumberInt64, value::bitcastFrom<int64_t>(j));
+        }
+        auto [blockTag, blockVal] = value::makeValueBlock(std::move(block));
+        arr->push_back(blockTag, blockVal);
+    }
+    return {arrTag, arrVal};
+}
+
+/**
+ * Returns an array of compressed time-series buckets of 'bucketSize' measurements each, whose 'v'
+ * columns hold the same values as 'makeRows()'.
+ */
+std::pair<value::TypeTags, value::Value> makeBuckets(size_t bucketSize) {
+    auto [arrTag, arrVal] = value::makeNewArray();
+    auto arr = value::getArrayView(arrVal);
+    for (size_t i = 0; i < kNumRows; i += bucketSize) {
+        BSONColumnBuilder timeColumn("t");
+        BSONColumnBuilder valueColumn("v");
+        for (size_t j = i; j < std::min(i + bucketSize, kNumRows); ++j) {
+            auto measurement = BSON("t" << Date_t::fromMillisSinceEpoch(j) << "v"
+                                        << static_cast<long long>(j));
+            timeColumn.append(measurement["t"]);
+            valueColumn.append(measurement["v"]);
+        }
+
+        BSONObjBuilder data;
+        data.append("t", timeColumn.finalize());
+        data.append("v", valueColumn.finalize());
+        auto bucket = BSON("control" << BSON("version" << 2) << "data" << data.obj());
+        auto [bucketTag, bucketVal] = value::copyValue(
+            value::TypeTags::bsonObject, value::bitcastFrom<const char*>(bucket.objdata()));
+        arr->push_back(bucketTag, bucketVal);
+    }
+    return {arrTag, arrVal};
+}
+
+std::unique_ptr<EExpression> makeThreshold() {
+    return makeE<EConstant>(value::TypeTags::NumberInt64, value::bitcastFrom<int64_t>(kThreshold));
+}
+
+/**
+ * Builds a block predicate 'valueBlockGtScalar(blockSlot, kThreshold)' into 'bitmapSlot' on top of
+ * 'input', and turns the qualifying positions back into rows through 'outSlot'.
+ */
+std::unique_ptr<PlanStage> makeBlockFilter(std::unique_ptr<PlanStage> input,
+                                           value::SlotId blockSlot,
+                                           value::SlotId bitmapSlot,
+                                           value::SlotId outSlot) {
+    auto project = makeProjectStage(
+        std::move(input),
+        kEmptyPlanNodeId,
+        bitmapSlot,
+        makeE<EFunction>("valueBlockGtScalar",
+                         makeEs(makeE<EVariable>(blockSlot), makeThreshold())));
+    return makeS<BlockToRowStage>(
+        std::move(project), makeSV(blockSlot), makeSV(outSlot), bitmapSlot, kEmptyPlanNodeId);
+}
+
+void runPlan(benchmark::State& state, PlanStage* root, value::SlotId outSlot) {
+    CompileCtx ctx{std::make_unique<RuntimeEnvironment>()};
+    root->prepare(ctx);
+    auto accessor = root->getAccessor(ctx, outSlot);
+
+    for (auto keepRunning : state) {
+        root->open(false);
+        size_t numResults = 0;
+        while (root->getNext() == PlanState::ADVANCED) {
+            benchmark::DoNotOptimize(accessor->getViewOfValue());
+            ++numResults;
+        }
+        root->close();
+        invariant(numResults == kNumRows - kThreshold - 1);
+    }
+    state.SetItemsProcessed(state.iterations() * kNumRows);
+}
+
+/**
+ * Row mode: scan -> filter 'fillEmpty(s > kThreshold, false)'.
+ */
+void BM_RowScanFilter(benchmark::State& state) {
+    auto [arrTag, arrVal] = makeRows();
+    auto scan = makeVirtualScan(arrTag, arrVal, 1, 2, 3);
+    auto filter = makeS<FilterStage<false>>(
+        std::move(scan),
+        makeE<EFunction>(
+            "fillEmpty",
+            makeEs(makeE<EPrimBinary>(EPrimBinary::greater, makeE<EVariable>(2), makeThreshold()),
+                   makeE<EConstant>(value::TypeTags::Boolean, value::bitcastFrom<bool>(false)))),
+        kEmptyPlanNodeId);
+
+    runPlan(state, filter.get(), 2);
+}
+
+/**
+ * Block mode on top of a row source: scan -> rowtoblock -> block predicate -> blocktorow. This
+ * measures the cost of batching rows which were not produced in blocks.
+ */
+void BM_RowToBlockScanFilter(benchmark::State& state) {
+    auto [arrTag, arrVal] = makeRows();
+    auto scan = makeVirtualScan(arrTag, arrVal, 1, 2, 3);
+    auto rowToBlock = makeS<RowToBlockStage>(std::move(scan),
+                                             makeSV(2),
+                                             makeSV(4),
+                                             static_cast<size_t>(state.range(0)),
+                                             kEmptyPlanNodeId);
+    auto root = makeBlockFilter(std::move(rowToBlock), 4, 5, 6);
+
+    runPlan(state, root.get(), 6);
+}
+
+/**
+ * Block mode on top of a source which already produces blocks, such as a column scan: scan of
+ * blocks -> block predicate -> blocktorow.
+ */
+void BM_BlockScanFilter(benchmark::State& state) {
+    auto [arrTag, arrVal] = makeBlocks(static_cast<size_t>(state.range(0)));
+    auto scan = makeVirtualScan(arrTag, arrVal, 1, 4, 3);
+    auto root = makeBlockFilter(std::move(scan), 4, 5, 6);
+
+    runPlan(state, root.get(), 6);
+}
+
+/**
+ * Block mode on top of compressed time-series buckets: scan of buckets -> tsbuckettoblock ->
+ * block predicate -> blocktorow. The measurements are never materialized as documents.
+ */
+void BM_TsBucketScanFilter(benchmark::State& state) {
+    auto [arrTag, arrVal] = makeBuckets(static_cast<size_t>(state.range(0)));
+    auto scan = makeVirtualScan(arrTag, arrVal, 1, 2, 3);
+    auto unpack = makeS<TsBucketToBlockStage>(
+        std::move(scan), 2, "t", std::vector<std::string>{"v"}, makeSV(4), kEmptyPlanNodeId);
+    auto root = makeBlockFilter(std::move(unpack), 4, 5, 6);
+
+    runPlan(state, root.get(), 6);
+}
+
+BENCHMARK(BM_RowScanFilter);
+BENCHMARK(BM_RowToBlockScanFilter)->Arg(64)->Arg(256)->Arg(1024);
+BENCHMARK(BM_BlockScanFilter)->Arg(64)->Arg(256)->Arg(1024);
+BENCHMARK(BM_TsBucketScanFilter)->Arg(100)->Arg(1000);
+
+}  // namespace
+}  // namespace mongo::sbe
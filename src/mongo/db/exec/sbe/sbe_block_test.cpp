@@ -0,0 +1,227 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+/**
+ * This file contains tests for sbe::RowToBlockStage, sbe::BlockToRowStage and
+ * sbe::TsBucketToBlockStage.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/util/bsoncolumnbuilder.h"
+#include "mongo/db/exec/sbe/sbe_plan_stage_test.h"
+#include "mongo/db/exec/sbe/stages/block_to_row.h"
+#include "mongo/db/exec/sbe/stages/project.h"
+#include "mongo/db/exec/sbe/stages/row_to_block.h"
+#include "mongo/db/exec/sbe/stages/ts_bucket_to_block.h"
+
+namespace mongo::sbe {
+
+using BlockStageTest = PlanStageTestFixture;
+
+TEST_F(BlockStageTest, RowToBlockToRowRoundTripTest) {
+    auto [inputTag, inputVal] = stage_builder::makeValue(
+        BSON_ARRAY(1 << "two" << BSON_ARRAY(3) << 4.5 << BSON("five" << 5) << 6LL << 7));
+    value::ValueGuard inputGuard{inputTag, inputVal};
+
+    auto [expectedTag, expectedVal] = value::copyValue(inputTag, inputVal);
+    value::ValueGuard expectedGuard{expectedTag, expectedVal};
+
+    // A block size which does not divide the number of rows, so that the last block is partial.
+    for (size_t blockSize : {1, 3, 7, 100}) {
+        auto makeStageFn = [this, blockSize](value::SlotId scanSlot,
+                                             std::unique_ptr<PlanStage> scanStage) {
+            auto blockSlot = generateSlotId();
+            auto outSlot = generateSlotId();
+            auto rowToBlock = makeS<RowToBlockStage>(std::move(scanStage),
+                                                     makeSV(scanSlot),
+                                                     makeSV(blockSlot),
+                                                     blockSize,
+                                                     kEmptyPlanNodeId);
+            auto blockToRow = makeS<BlockToRowStage>(std::move(rowToBlock),
+                                                     makeSV(blockSlot),
+                                                     makeSV(outSlot),
+                                                     boost::none,
+                                                     kEmptyPlanNodeId);
+            return std::make_pair(outSlot, std::move(blockToRow));
+        };
+
+        auto [inTag, inVal] = value::copyValue(inputTag, inputVal);
+        auto [outTag, outVal] = value::copyValue(expectedTag, expectedVal);
+        runTest(inTag, inVal, outTag, outVal, makeStageFn);
+    }
+}
+
+TEST_F(BlockStageTest, BlockPredicateBitmapTest) {
+    auto [inputTag, inputVal] =
+        stage_builder::makeValue(BSON_ARRAY(8 << 2 << 10 << "str" << 5 << 6 << BSONNULL << 7.5));
+    value::ValueGuard inputGuard{inputTag, inputVal};
+
+    auto [expectedTag, expectedVal] = stage_builder::makeValue(BSON_ARRAY(8 << 10 << 6 << 7.5));
+    value::ValueGuard expectedGuard{expectedTag, expectedVal};
+
+    auto makeStageFn = [this](value::SlotId scanSlot, std::unique_ptr<PlanStage> scanStage) {
+        auto blockSlot = generateSlotId();
+        auto bitmapSlot = generateSlotId();
+        auto outSlot = generateSlotId();
+
+        auto rowToBlock = makeS<RowToBlockStage>(
+            std::move(scanStage), makeSV(scanSlot), makeSV(blockSlot), 3, kEmptyPlanNodeId);
+
+        // Evaluate 'blockSlot > 5' over a whole block at a time. Values of other types compare as
+        // Nothing, which the bitmap treats as false.
+        auto project = makeProjectStage(
+            std::move(rowToBlock),
+            kEmptyPlanNodeId,
+            bitmapSlot,
+            makeE<EFunction>("valueBlockGtScalar",
+                             makeEs(makeE<EVariable>(blockSlot),
+                                    makeE<EConstant>(value::TypeTags::NumberInt32,
+                                                     value::bitcastFrom<int32_t>(5)))));
+
+        auto blockToRow = makeS<BlockToRowStage>(
+            std::move(project), makeSV(blockSlot), makeSV(outSlot), bitmapSlot, kEmptyPlanNodeId);
+        return std::make_pair(outSlot, std::move(blockToRow));
+    };
+
+    inputGuard.reset();
+    expectedGuard.reset();
+    runTest(inputTag, inputVal, expectedTag, expectedVal, makeStageFn);
+}
+
+TEST_F(BlockStageTest, BlockCountTest) {
+    auto ctx = makeCompileCtx();
+
+    auto [inputTag, inputVal] = stage_builder::makeValue(BSON_ARRAY(1 << 2 << 3 << 4 << 5));
+    auto [scanSlot, scanStage] = generateVirtualScan(inputTag, inputVal);
+
+    auto blockSlot = generateSlotId();
+    auto countSlot = generateSlotId();
+    auto rowToBlock = makeS<RowToBlockStage>(
+        std::move(scanStage), makeSV(scanSlot), makeSV(blockSlot), 2, kEmptyPlanNodeId);
+
+    // Count the number of values greater than 2 in each block of two rows.
+    auto project = makeProjectStage(
+        std::move(rowToBlock),
+        kEmptyPlanNodeId,
+        countSlot,
+        makeE<EFunction>(
+            "valueBlockCount",
+            makeEs(makeE<EFunction>("valueBlockGtScalar",
+                                    makeEs(makeE<EVariable>(blockSlot),
+                                           makeE<EConstant>(value::TypeTags::NumberInt32,
+                                                            value::bitcastFrom<int32_t>(2)))))));
+
+    auto resultAccessor = prepareTree(ctx.get(), project.get(), countSlot);
+
+    for (int64_t expectedCount : {0, 2, 1}) {
+        ASSERT_TRUE(project->getNext() == PlanState::ADVANCED);
+        auto [tag, val] = resultAccessor->getViewOfValue();
+        ASSERT_EQ(tag, value::TypeTags::NumberInt64);
+        ASSERT_EQ(value::bitcastTo<int64_t>(val), expectedCount);
+    }
+    ASSERT_TRUE(project->getNext() == PlanState::IS_EOF);
+}
+
+TEST_F(BlockStageTest, TsBucketToBlockFilterAndLateMaterializationTest) {
+    auto t0 = Date_t::fromMillisSinceEpoch(1000);
+
+    // An uncompressed bucket, where 'a' is missing for the third measurement.
+    auto bucketV1 = BSON("control" << BSON("version" << 1) << "data"
+                                   << BSON("t" << BSON("0" << t0 << "1" << t0 << "2" << t0 << "3"
+                                                           << t0)
+                                               << "a" << BSON("0" << 1 << "1" << 5 << "3" << 7)
+                                               << "b"
+                                               << BSON("0"
+                                                       << "w"
+                                                       << "1"
+                                                       << "x"
+                                                       << "2"
+                                                       << "y"
+                                                       << "3"
+                                                       << "z")));
+
+    // A compressed bucket, where 'a' is missing for the second measurement.
+    auto elems = BSON("t" << t0 << "a" << 2 << "a" << 0 << "b"
+                          << "p"
+                          << "b"
+                          << "q"
+                          << "b"
+                          << "r");
+    std::vector<BSONElement> fields;
+    elems.elems(fields);
+    BSONColumnBuilder timeColumn("t");
+    BSONColumnBuilder aColumn("a");
+    BSONColumnBuilder bColumn("b");
+    timeColumn.append(fields[0]).append(fields[0]).append(fields[0]);
+    aColumn.append(fields[1]).skip().append(fields[2]);
+    bColumn.append(fields[3]).append(fields[4]).append(fields[5]);
+    BSONObjBuilder data;
+    data.append("t", timeColumn.finalize());
+    data.append("a", aColumn.finalize());
+    data.append("b", bColumn.finalize());
+    auto bucketV2 = BSON("control" << BSON("version" << 2) << "data" << data.obj());
+
+    auto [inputTag, inputVal] = stage_builder::makeValue(BSON_ARRAY(bucketV1 << bucketV2));
+    auto [expectedTag, expectedVal] = stage_builder::makeValue(BSON_ARRAY("x"
+                                                                          << "z"
+                                                                          << "p"));
+
+    auto makeStageFn = [this](value::SlotId scanSlot, std::unique_ptr<PlanStage> scanStage) {
+        auto aSlot = generateSlotId();
+        auto bSlot = generateSlotId();
+        auto bitmapSlot = generateSlotId();
+        auto outSlot = generateSlotId();
+
+        auto unpack = makeS<TsBucketToBlockStage>(std::move(scanStage),
+                                                  scanSlot,
+                                                  "t",
+                                                  std::vector<std::string>{"a", "b"},
+                                                  makeSV(aSlot, bSlot),
+                                                  kEmptyPlanNodeId);
+
+        // Filter on 'a > 1' column-wise, then only materialize 'b' for the qualifying rows.
+        auto project = makeProjectStage(
+            std::move(unpack),
+            kEmptyPlanNodeId,
+            bitmapSlot,
+            makeE<EFunction>("valueBlockGtScalar",
+                             makeEs(makeE<EVariable>(aSlot),
+                                    makeE<EConstant>(value::TypeTags::NumberInt32,
+                                                     value::bitcastFrom<int32_t>(1)))));
+
+        auto blockToRow = makeS<BlockToRowStage>(
+            std::move(project), makeSV(bSlot), makeSV(outSlot), bitmapSlot, kEmptyPlanNodeId);
+        return std::make_pair(outSlot, std::move(blockToRow));
+    };
+
+    runTest(inputTag, inputVal, expectedTag, expectedVal, makeStageFn);
+}
+
+}  // namespace mongo::sbe
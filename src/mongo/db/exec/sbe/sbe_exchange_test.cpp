@@ -0,0 +1,144 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+/**
+ * This file contains tests for sbe::ExchangeConsumer and sbe::ExchangeProducer.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/sbe/sbe_plan_stage_test.h"
+#include "mongo/db/exec/sbe/stages/exchange.h"
+#include "mongo/idl/server_parameter_test_util.h"
+
+namespace mongo::sbe {
+
+class ExchangeStageTest : public PlanStageTestFixture {
+public:
+    /**
+     * Makes a round robin exchange with 'numOfProducers' producers over a virtual scan of the
+     * numbers 1 to 10. Every producer runs a clone of the virtual scan, hence each of them produces
+     * all ten numbers.
+     */
+    std::pair<value::SlotId, std::unique_ptr<PlanStage>> makeExchange(size_t numOfProducers) {
+        auto [scanSlot, scanStage] =
+            generateVirtualScan(BSON_ARRAY(1 << 2 << 3 << 4 << 5 << 6 << 7 << 8 << 9 << 10));
+
+        return {scanSlot,
+                makeS<ExchangeConsumer>(std::move(scanStage),
+                                        numOfProducers,
+                                        makeSV(scanSlot),
+                                        ExchangePolicy::roundrobin,
+                                        nullptr /* partition */,
+                                        nullptr /* orderLess */,
+                                        kEmptyPlanNodeId)};
+    }
+
+    /**
+     * Runs 'exchange' and returns the number of rows and the sum of the values produced.
+     */
+    std::pair<size_t, int64_t> runExchange(PlanStage* exchange, value::SlotId scanSlot) {
+        auto ctx = makeCompileCtx();
+        auto resultAccessor = prepareTree(ctx.get(), exchange, scanSlot);
+
+        size_t count = 0;
+        int64_t sum = 0;
+        for (auto st = exchange->getNext(); st == PlanState::ADVANCED; st = exchange->getNext()) {
+            auto [tag, val] = resultAccessor->getViewOfValue();
+            ASSERT_EQ(tag, value::TypeTags::NumberInt32);
+            sum += value::bitcastTo<int32_t>(val);
+            ++count;
+        }
+        exchange->close();
+
+        return {count, sum};
+    }
+
+    std::pair<size_t, int64_t> runExchange(size_t numOfProducers) {
+        auto [scanSlot, exchange] = makeExchange(numOfProducers);
+        return runExchange(exchange.get(), scanSlot);
+    }
+};
+
+TEST_F(ExchangeStageTest, EveryProducerRunsAClone) {
+    auto [count, sum] = runExchange(4);
+    ASSERT_EQ(count, 40);
+    ASSERT_EQ(sum, 220);
+}
+
+TEST_F(ExchangeStageTest, ThreadBudgetLimitsProducers) {
+    RAIIServerParameterControllerForTest budget(
+        "internalQuerySlotBasedExecutionParallelThreadBudget", 2);
+
+    auto [count, sum] = runExchange(4);
+    ASSERT_EQ(count, 20);
+    ASSERT_EQ(sum, 110);
+}
+
+TEST_F(ExchangeStageTest, ExhaustedThreadBudgetStillRunsOneProducer) {
+    RAIIServerParameterControllerForTest budget(
+        "internalQuerySlotBasedExecutionParallelThreadBudget", 0);
+
+    auto [count, sum] = runExchange(4);
+    ASSERT_EQ(count, 10);
+    ASSERT_EQ(sum, 55);
+}
+
+TEST_F(ExchangeStageTest, CloneRunsIndependently) {
+    auto [scanSlot, exchange] = makeExchange(2);
+    auto clone = exchange->clone();
+
+    auto [count, sum] = runExchange(exchange.get(), scanSlot);
+    ASSERT_EQ(count, 20);
+    ASSERT_EQ(sum, 110);
+
+    // Running the original has not affected the clone.
+    std::tie(count, sum) = runExchange(clone.get(), scanSlot);
+    ASSERT_EQ(count, 20);
+    ASSERT_EQ(sum, 110);
+}
+
+TEST_F(ExchangeStageTest, KillingTheConsumerStopsTheProducers) {
+    auto [scanSlot, exchange] = makeExchange(4);
+
+    auto ctx = makeCompileCtx();
+    prepareTree(ctx.get(), exchange.get(), scanSlot);
+
+    {
+        stdx::lock_guard<Client> lk(*opCtx()->getClient());
+        opCtx()->getServiceContext()->killOperation(lk, opCtx(), ErrorCodes::Interrupted);
+    }
+
+    // The consumer throws instead of waiting for the producers, and the producers have finished by
+    // the time it does, so destroying the exchange is safe.
+    ASSERT_THROWS_CODE(exchange->getNext(), DBException, ErrorCodes::Interrupted);
+    exchange.reset();
+}
+
+}  // namespace mongo::sbe
@@ -436,6 +436,8 @@ TEST_F(HashAggStageTest, HashAggBasicCountNoSpill) {
     ASSERT_FALSE(stats->usedDisk);
     ASSERT_EQ(0, stats->numSpills);
     ASSERT_EQ(0, stats->spilledRecords);
+    ASSERT_EQ(9, stats->inputRows);
+    ASSERT_EQ("hash", stage->getStats(true /* includeDebugInfo */)->debugInfo["aggStrategy"].str());
 
     stage->close();
 }
@@ -861,6 +863,12 @@ TEST_F(HashAggStageTest, HashAggMultipleAccSpillAllToDisk) {
     ASSERT_EQ(stats->numSpills, 9);
     ASSERT_EQ(stats->spilledRecords, 9);
 
+    // Nothing was pre-aggregated in memory, so the groups were computed by merging the sorted
+    // spill runs.
+    ASSERT_EQ(stats->inputRows, 9);
+    ASSERT_EQ(stage->getStats(true /* includeDebugInfo */)->debugInfo["aggStrategy"].str(),
+              "sort");
+
     stage->close();
 }
 
@@ -926,6 +934,68 @@ TEST_F(HashAggStageTest, HashAggSum10Groups) {
     stage->close();
 }
 
+TEST_F(HashAggStageTest, HashAggSpillsInBatches) {
+    // Spill about 20 rows at a time, in batches of 3 records.
+    auto defaultInternalQuerySBEAggApproxMemoryUseInBytesBeforeSpill =
+        internalQuerySBEAggApproxMemoryUseInBytesBeforeSpill.load();
+    internalQuerySBEAggApproxMemoryUseInBytesBeforeSpill.store(1024);
+    auto defaultSpillBatchSize = internalQuerySlotBasedExecutionHashAggSpillBatchSize.load();
+    internalQuerySlotBasedExecutionHashAggSpillBatchSize.store(3);
+    ON_BLOCK_EXIT([&] {
+        internalQuerySBEAggApproxMemoryUseInBytesBeforeSpill.store(
+            defaultInternalQuerySBEAggApproxMemoryUseInBytesBeforeSpill);
+        internalQuerySlotBasedExecutionHashAggSpillBatchSize.store(defaultSpillBatchSize);
+    });
+
+    auto ctx = makeCompileCtx();
+
+    // Every value in [0, 100) appears twice, far apart, so its partial counts end up in different
+    // spills.
+    BSONArrayBuilder builder;
+    for (int i = 0; i < 200; ++i) {
+        builder.append(i % 100);
+    }
+    auto [inputTag, inputVal] = stage_builder::makeValue(BSONArray(builder.done()));
+    auto [scanSlot, scanStage] = generateVirtualScan(inputTag, inputVal);
+
+    auto countsSlot = generateSlotId();
+    auto spillSlot = generateSlotId();
+    auto stage = makeS<HashAggStage>(
+        std::move(scanStage),
+        makeSV(scanSlot),
+        makeSlotExprPairVec(
+            countsSlot,
+            stage_builder::makeFunction(
+                "sum",
+                makeE<EConstant>(value::TypeTags::NumberInt64, value::bitcastFrom<int64_t>(1)))),
+        makeSV(),  // Seek slot
+        true,
+        boost::none,
+        true /* allowDiskUse */,
+        makeSlotExprPairVec(
+            spillSlot, stage_builder::makeFunction("sum", stage_builder::makeVariable(spillSlot))),
+        kEmptyPlanNodeId);
+
+    auto resultAccessors = prepareTree(ctx.get(), stage.get(), makeSV(scanSlot, countsSlot));
+
+    std::set<int> groups;
+    while (stage->getNext() == PlanState::ADVANCED) {
+        auto [groupTag, groupVal] = resultAccessors[0]->getViewOfValue();
+        ASSERT_TRUE(groups.insert(value::bitcastTo<int>(groupVal)).second);
+        auto [countTag, countVal] = resultAccessors[1]->getViewOfValue();
+        assertValuesEqual(
+            countTag, countVal, value::TypeTags::NumberInt64, value::bitcastFrom<int64_t>(2));
+    }
+    ASSERT_EQ(groups.size(), 100U);
+
+    // Some spills wrote more rows than fit in one batch.
+    auto stats = static_cast<const HashAggStats*>(stage->getSpecificStats());
+    ASSERT_TRUE(stats->usedDisk);
+    ASSERT_GT(stats->spilledRecords, 3 * stats->numSpills);
+
+    stage->close();
+}
+
 TEST_F(HashAggStageTest, HashAggBasicCountWithRecordIds) {
     auto ctx = makeCompileCtx();
 
@@ -406,4 +406,77 @@ TEST_F(HashLookupStageTest, BasicTests) {
                  BSONArray(fromjson(R"""([
          ])""")));
 }
+
+TEST_F(HashLookupStageTest, SpillsOnlyAsManyPartitionsAsNeeded) {
+    // Every inner key matches every outer key with the same value, the outer keys >= 64 have no
+    // match at all. Numeric values have no out-of-line memory, so each hash table entry accounts
+    // for a single index and the buffered rows do not contribute to the memory usage.
+    BSONArrayBuilder outerBab;
+    for (int i = 0; i < 128; ++i) {
+        outerBab.append(BSON_ARRAY(i << i));
+    }
+    BSONArrayBuilder innerBab;
+    for (int i = 0; i < 64; ++i) {
+        innerBab.append(BSON_ARRAY(i << i));
+    }
+    auto outer = outerBab.arr();
+    auto inner = innerBab.arr();
+
+    auto runLookup = [&]() {
+        auto [outerScanSlots, outerScanStage] = generateVirtualScanMulti(2, outer);
+        auto [innerScanSlots, innerScanStage] = generateVirtualScanMulti(2, inner);
+
+        auto lookupAggSlot = generateSlotId();
+        auto aggs =
+            makeEM(lookupAggSlot,
+                   stage_builder::makeFunction("addToArray", makeE<EVariable>(innerScanSlots[0])));
+        auto lookupStage = makeS<HashLookupStage>(std::move(outerScanStage),
+                                                  std::move(innerScanStage),
+                                                  outerScanSlots[1],
+                                                  innerScanSlots[1],
+                                                  makeSV(innerScanSlots[0]),
+                                                  std::move(aggs),
+                                                  boost::none,
+                                                  kEmptyPlanNodeId);
+
+        auto ctx = makeCompileCtx();
+        auto accessors =
+            prepareTree(ctx.get(), lookupStage.get(), makeSV(outerScanSlots[1], lookupAggSlot));
+        auto [resultsTag, resultsVal] = getAllResultsMulti(lookupStage.get(), accessors);
+        auto stats = *static_cast<const HashLookupStats*>(lookupStage->getSpecificStats());
+        lookupStage->close();
+        return std::make_tuple(resultsTag, resultsVal, stats);
+    };
+
+    auto [expectedTag, expectedVal, inMemoryStats] = runLookup();
+    value::ValueGuard expectedGuard{expectedTag, expectedVal};
+    ASSERT_FALSE(inMemoryStats.usedDisk);
+
+    // Only leave room for half of the hash table entries.
+    auto defaultInternalQuerySBELookupApproxMemoryUseInBytesBeforeSpill =
+        internalQuerySBELookupApproxMemoryUseInBytesBeforeSpill.load();
+    internalQuerySBELookupApproxMemoryUseInBytesBeforeSpill.store(32 * sizeof(size_t));
+    ON_BLOCK_EXIT([&] {
+        internalQuerySBELookupApproxMemoryUseInBytesBeforeSpill.store(
+            defaultInternalQuerySBELookupApproxMemoryUseInBytesBeforeSpill);
+    });
+
+    Lock::GlobalLock lk(opCtx(), MODE_IS);
+    auto [resultsTag, resultsVal, spillStats] = runLookup();
+    value::ValueGuard resultsGuard{resultsTag, resultsVal};
+    ASSERT_TRUE(valueEquals(expectedTag, expectedVal, resultsTag, resultsVal));
+
+    // Some of the partitions must have stayed in memory, and none of the buffered rows were
+    // spilled.
+    ASSERT_TRUE(spillStats.usedDisk);
+    ASSERT_GT(spillStats.spilledHtPartitions, 0);
+    ASSERT_LT(spillStats.spilledHtPartitions, 16);
+    ASSERT_LT(spillStats.spilledHtRecords, 64);
+    ASSERT_EQ(spillStats.spilledBuffRecords, 0);
+
+    // The outer keys without a match which fall into a spilled partition are mostly answered by
+    // the Bloom filter of the spilled keys, rather than by reading the record store.
+    ASSERT_GT(spillStats.spilledHtProbesSkipped, 0);
+    ASSERT_EQ(inMemoryStats.spilledHtProbesSkipped, 0);
+}
 }  // namespace mongo::sbe
@@ -68,4 +68,35 @@ TEST_F(SortStageTest, SortNumbersTest) {
     runTestMulti(2, inputTag, inputVal, expectedTag, expectedVal, makeStageFn);
 }
 
+TEST_F(SortStageTest, SortSpillsToDiskAndReportsSpilledBytes) {
+    auto [scanSlot, scanStage] = generateVirtualScan(BSON_ARRAY(5 << 3 << 4 << 1 << 2));
+
+    // A memory limit of a single byte makes the sorter spill every row.
+    auto sortStage =
+        makeS<SortStage>(std::move(scanStage),
+                         makeSV(scanSlot),
+                         std::vector<value::SortDirection>{value::SortDirection::Ascending},
+                         makeSV(),
+                         std::numeric_limits<std::size_t>::max(),
+                         1,
+                         true,
+                         kEmptyPlanNodeId);
+
+    auto ctx = makeCompileCtx();
+    auto resultAccessor = prepareTree(ctx.get(), sortStage.get(), scanSlot);
+
+    auto [resultsTag, resultsVal] = getAllResults(sortStage.get(), resultAccessor);
+    value::ValueGuard resultGuard{resultsTag, resultsVal};
+    auto [expectedTag, expectedVal] = stage_builder::makeValue(BSON_ARRAY(1 << 2 << 3 << 4 << 5));
+    value::ValueGuard expectedGuard{expectedTag, expectedVal};
+    ASSERT_TRUE(valueEquals(resultsTag, resultsVal, expectedTag, expectedVal));
+
+    auto stats = static_cast<const SortStats*>(sortStage->getSpecificStats());
+    ASSERT_GT(stats->spills, 0);
+    ASSERT_GT(stats->spilledDataStorageSize, 0);
+    ASSERT_GT(stats->spilledUncompressedDataSize, 0);
+
+    sortStage->close();
+}
+
 }  // namespace mongo::sbe
@@ -168,6 +168,60 @@ TEST_F(TrialRunTrackerTest, TrialEndsDuringOpenPhaseOfBlockingStage) {
                        ErrorCodes::QueryTrialRunCompleted);
 }
 
+TEST_F(TrialRunTrackerTest, TrialEndsWhenStopIsRequested) {
+    auto makeHashAggStage = [&](value::SlotId& countsSlot) {
+        auto [inputTag, inputVal] =
+            stage_builder::makeValue(BSON_ARRAY(1 << 2 << 3 << 4 << 5 << 6 << 7 << 8 << 9));
+        auto [scanSlot, scanStage] = generateVirtualScan(inputTag, inputVal);
+
+        countsSlot = generateSlotId();
+        return makeS<HashAggStage>(
+            std::move(scanStage),
+            makeSV(scanSlot),
+            makeSlotExprPairVec(countsSlot,
+                                stage_builder::makeFunction(
+                                    "sum",
+                                    makeE<EConstant>(value::TypeTags::NumberInt64,
+                                                     value::bitcastFrom<int64_t>(1)))),
+            makeSV(), /* Seek slot */
+            true,
+            boost::none,
+            false /* allowDiskUse */,
+            makeSlotExprPairVec(), /* mergingExprs */
+            kEmptyPlanNodeId);
+    };
+
+    // The 'numResults' limit is never reached, so the trial only ends if a stop is requested.
+    const size_t numResultsLimit = 100;
+    AtomicWord<bool> stopRequested{false};
+
+    {
+        auto ctx = makeCompileCtx();
+        value::SlotId countsSlot;
+        auto hashAggStage = makeHashAggStage(countsSlot);
+        auto tracker = std::make_unique<TrialRunTracker>(numResultsLimit, size_t{0});
+        tracker->setStopRequestedFlag(&stopRequested);
+        hashAggStage->attachToTrialRunTracker(tracker.get());
+
+        prepareTree(ctx.get(), hashAggStage.get(), countsSlot);
+        hashAggStage->close();
+    }
+
+    stopRequested.store(true);
+    {
+        auto ctx = makeCompileCtx();
+        value::SlotId countsSlot;
+        auto hashAggStage = makeHashAggStage(countsSlot);
+        auto tracker = std::make_unique<TrialRunTracker>(numResultsLimit, size_t{0});
+        tracker->setStopRequestedFlag(&stopRequested);
+        hashAggStage->attachToTrialRunTracker(tracker.get());
+
+        ASSERT_THROWS_CODE(prepareTree(ctx.get(), hashAggStage.get(), countsSlot),
+                           DBException,
+                           ErrorCodes::QueryTrialRunCompleted);
+    }
+}
+
 TEST_F(TrialRunTrackerTest, OnlyDeepestNestedBlockingStageHasTrialRunTracker) {
     auto ctx = makeCompileCtx();
 
@@ -0,0 +1,267 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/sbe/stages/block_to_row.h"
+
+#include "mongo/db/exec/sbe/size_estimator.h"
+#include "mongo/util/str.h"
+
+namespace mongo::sbe {
+BlockToRowStage::BlockToRowStage(std::unique_ptr<PlanStage> input,
+                                 value::SlotVector blockSlots,
+                                 value::SlotVector valsOutSlots,
+                                 boost::optional<value::SlotId> bitmapSlot,
+                                 PlanNodeId planNodeId)
+    : PlanStage("blocktorow"_sd, planNodeId),
+      _blockSlots(std::move(blockSlots)),
+      _valsOutSlots(std::move(valsOutSlots)),
+      _bitmapSlot(bitmapSlot) {
+    _children.emplace_back(std::move(input));
+
+    uassert(7000102,
+            str::stream() << "the number of block and output slots must match: "
+                          << _blockSlots.size() << " != " << _valsOutSlots.size(),
+            _blockSlots.size() == _valsOutSlots.size());
+}
+
+std::unique_ptr<PlanStage> BlockToRowStage::clone() const {
+    return std::make_unique<BlockToRowStage>(
+        _children[0]->clone(), _blockSlots, _valsOutSlots, _bitmapSlot, _commonStats.nodeId);
+}
+
+void BlockToRowStage::prepare(CompileCtx& ctx) {
+    _children[0]->prepare(ctx);
+
+    _blockAccessors.clear();
+    for (auto slot : _blockSlots) {
+        _blockAccessors.push_back(_children[0]->getAccessor(ctx, slot));
+    }
+    if (_bitmapSlot) {
+        _bitmapAccessor = _children[0]->getAccessor(ctx, *_bitmapSlot);
+    }
+    _outAccessors = std::vector<value::OwnedValueAccessor>(_valsOutSlots.size());
+}
+
+value::SlotAccessor* BlockToRowStage::getAccessor(CompileCtx& ctx, value::SlotId slot) {
+    for (size_t idx = 0; idx < _valsOutSlots.size(); ++idx) {
+        if (_valsOutSlots[idx] == slot) {
+            return &_outAccessors[idx];
+        }
+    }
+
+    return _children[0]->getAccessor(ctx, slot);
+}
+
+void BlockToRowStage::open(bool reOpen) {
+    auto optTimer(getOptTimer(_opCtx));
+
+    _commonStats.opens++;
+    _children[0]->open(reOpen);
+
+    _deblocked.clear();
+    _bitmap = boost::none;
+    _curIdx = 0;
+}
+
+void BlockToRowStage::extractBlocks() {
+    auto extractOne = [](value::SlotAccessor* accessor) {
+        auto [tag, val] = accessor->getViewOfValue();
+        tassert(7000103,
+                str::stream() << "blocktorow expects a block value, got: " << tag,
+                tag == value::TypeTags::valueBlock);
+        return value::getValueBlock(val)->extract();
+    };
+
+    _deblocked.clear();
+    for (auto accessor : _blockAccessors) {
+        _deblocked.push_back(extractOne(accessor));
+    }
+    _bitmap = _bitmapAccessor ? boost::make_optional(extractOne(_bitmapAccessor)) : boost::none;
+
+    boost::optional<size_t> count = _bitmap ? boost::make_optional(_bitmap->count) : boost::none;
+    for (auto& deblocked : _deblocked) {
+        if (!count) {
+            count = deblocked.count;
+        }
+        tassert(7000104,
+                str::stream() << "all the blocks read by blocktorow must have the same size: "
+                              << deblocked.count << " != " << *count,
+                deblocked.count == *count);
+    }
+}
+
+bool BlockToRowStage::getNextBlocks() {
+    // The output accessors point into the current blocks, which are about to be replaced.
+    disableSlotAccess();
+    if (_children[0]->getNext() != PlanState::ADVANCED) {
+        _deblocked.clear();
+        _bitmap = boost::none;
+        return false;
+    }
+
+    extractBlocks();
+    _curIdx = 0;
+    return true;
+}
+
+void BlockToRowStage::setOutputsAtCurrentIndex() {
+    for (size_t idx = 0; idx < _outAccessors.size(); ++idx) {
+        auto [tag, val] = _deblocked[idx][_curIdx];
+        _outAccessors[idx].reset(false, tag, val);
+    }
+}
+
+PlanState BlockToRowStage::getNext() {
+    auto optTimer(getOptTimer(_opCtx));
+
+    // The first call to getNext() has no blocks to advance within, so it starts by reading one.
+    bool needBlocks = _deblocked.empty() && !_bitmap;
+    if (!needBlocks) {
+        ++_curIdx;
+    }
+
+    for (;;) {
+        if (needBlocks) {
+            if (!getNextBlocks()) {
+                return trackPlanState(PlanState::IS_EOF);
+            }
+            needBlocks = false;
+        }
+
+        const size_t count = _bitmap ? _bitmap->count
+                                     : (_deblocked.empty() ? 1 : _deblocked.front().count);
+        // Skip the positions for which the bitmap does not hold 'true'.
+        while (_bitmap && _curIdx < count) {
+            auto [tag, val] = (*_bitmap)[_curIdx];
+            if (tag == value::TypeTags::Boolean && value::bitcastTo<bool>(val)) {
+                break;
+            }
+            ++_curIdx;
+        }
+
+        if (_curIdx < count) {
+            break;
+        }
+        needBlocks = true;
+    }
+
+    setOutputsAtCurrentIndex();
+    return trackPlanState(PlanState::ADVANCED);
+}
+
+void BlockToRowStage::close() {
+    auto optTimer(getOptTimer(_opCtx));
+
+    trackClose();
+    _children[0]->close();
+
+    _deblocked.clear();
+    _bitmap = boost::none;
+}
+
+std::unique_ptr<PlanStageStats> BlockToRowStage::getStats(bool includeDebugInfo) const {
+    auto ret = std::make_unique<PlanStageStats>(_commonStats);
+
+    if (includeDebugInfo) {
+        BSONObjBuilder bob;
+        bob.append("blockSlots", _blockSlots.begin(), _blockSlots.end());
+        bob.append("outputSlots", _valsOutSlots.begin(), _valsOutSlots.end());
+        if (_bitmapSlot) {
+            bob.appendNumber("bitmapSlot", static_cast<long long>(*_bitmapSlot));
+        }
+        ret->debugInfo = bob.obj();
+    }
+
+    ret->children.emplace_back(_children[0]->getStats(includeDebugInfo));
+    return ret;
+}
+
+const SpecificStats* BlockToRowStage::getSpecificStats() const {
+    return nullptr;
+}
+
+std::vector<DebugPrinter::Block> BlockToRowStage::debugPrint() const {
+    auto ret = PlanStage::debugPrint();
+
+    ret.emplace_back(DebugPrinter::Block("[`"));
+    for (size_t idx = 0; idx < _valsOutSlots.size(); ++idx) {
+        if (idx) {
+            ret.emplace_back(DebugPrinter::Block("`,"));
+        }
+        DebugPrinter::addIdentifier(ret, _valsOutSlots[idx]);
+    }
+    ret.emplace_back(DebugPrinter::Block("`]"));
+
+    ret.emplace_back(DebugPrinter::Block("[`"));
+    for (size_t idx = 0; idx < _blockSlots.size(); ++idx) {
+        if (idx) {
+            ret.emplace_back(DebugPrinter::Block("`,"));
+        }
+        DebugPrinter::addIdentifier(ret, _blockSlots[idx]);
+    }
+    ret.emplace_back(DebugPrinter::Block("`]"));
+
+    if (_bitmapSlot) {
+        DebugPrinter::addIdentifier(ret, *_bitmapSlot);
+    }
+
+    DebugPrinter::addNewLine(ret);
+    DebugPrinter::addBlocks(ret, _children[0]->debugPrint());
+
+    return ret;
+}
+
+size_t BlockToRowStage::estimateCompileTimeSize() const {
+    size_t size = sizeof(*this);
+    size += size_estimator::estimate(_children);
+    size += size_estimator::estimate(_blockSlots);
+    size += size_estimator::estimate(_valsOutSlots);
+    return size;
+}
+
+void BlockToRowStage::doSaveState(bool fullSave) {
+    if (!slotsAccessible() || !fullSave) {
+        return;
+    }
+
+    for (auto& accessor : _outAccessors) {
+        prepareForYielding(accessor);
+    }
+}
+
+void BlockToRowStage::doRestoreState(bool fullSave) {
+    if (!slotsAccessible() || (_deblocked.empty() && !_bitmap)) {
+        return;
+    }
+
+    extractBlocks();
+}
+}  // namespace mongo::sbe
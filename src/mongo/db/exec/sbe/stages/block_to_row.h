@@ -0,0 +1,107 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include "mongo/db/exec/sbe/stages/stages.h"
+#include "mongo/db/exec/sbe/values/block_interface.h"
+
+namespace mongo::sbe {
+/**
+ * Takes blocks of values from the slots in 'blockSlots' and produces one row for each of their
+ * positions, with the values made available through the corresponding slots in 'valsOutSlots'.
+ * All the blocks read in a single call to the child's getNext() must have the same number of
+ * values.
+ *
+ * If 'bitmapSlot' is provided, it must hold a block of booleans of the same size as the other
+ * blocks, and only the positions for which the bitmap holds 'true' are returned. This is how a
+ * block predicate computed with the 'valueBlock*' builtins is applied.
+ *
+ * This is the inverse of RowToBlockStage, and turns the output of a block-at-a-time part of a plan
+ * back into rows for the rest of the plan.
+ *
+ * Debug string representation:
+ *
+ *   blocktorow [outSlot_1, ..., outSlot_n] [blockSlot_1, ..., blockSlot_n] bitmapSlot? childStage
+ */
+class BlockToRowStage final : public PlanStage {
+public:
+    BlockToRowStage(std::unique_ptr<PlanStage> input,
+                    value::SlotVector blockSlots,
+                    value::SlotVector valsOutSlots,
+                    boost::optional<value::SlotId> bitmapSlot,
+                    PlanNodeId planNodeId);
+
+    std::unique_ptr<PlanStage> clone() const final;
+
+    void prepare(CompileCtx& ctx) final;
+    value::SlotAccessor* getAccessor(CompileCtx& ctx, value::SlotId slot) final;
+    void open(bool reOpen) final;
+    PlanState getNext() final;
+    void close() final;
+
+    std::unique_ptr<PlanStageStats> getStats(bool includeDebugInfo) const final;
+    const SpecificStats* getSpecificStats() const final;
+    std::vector<DebugPrinter::Block> debugPrint() const final;
+    size_t estimateCompileTimeSize() const final;
+
+protected:
+    void doSaveState(bool relinquishCursor) final;
+    void doRestoreState(bool relinquishCursor) final;
+
+private:
+    /**
+     * Pulls the next batch of blocks from the child. Returns false once the child hits EOF.
+     */
+    bool getNextBlocks();
+
+    /**
+     * Refreshes '_deblocked' and '_bitmap' from the values currently held by the child's slots.
+     */
+    void extractBlocks();
+
+    /**
+     * Points the output accessors at the values stored at position '_curIdx' of the current blocks.
+     */
+    void setOutputsAtCurrentIndex();
+
+    const value::SlotVector _blockSlots;
+    const value::SlotVector _valsOutSlots;
+    const boost::optional<value::SlotId> _bitmapSlot;
+
+    std::vector<value::SlotAccessor*> _blockAccessors;
+    value::SlotAccessor* _bitmapAccessor{nullptr};
+    std::vector<value::OwnedValueAccessor> _outAccessors;
+
+    // Views of the blocks read from the child, valid until the next call to the child's getNext().
+    std::vector<value::DeblockedTagVals> _deblocked;
+    boost::optional<value::DeblockedTagVals> _bitmap;
+    size_t _curIdx{0};
+};
+}  // namespace mongo::sbe
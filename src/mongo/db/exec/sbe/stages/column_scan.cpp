@@ -58,6 +58,7 @@ ColumnScanStage::ColumnScanStage(UUID collectionUuid,
       _rowStoreSlot(rowStoreSlot) {
     invariant(_fieldSlots.size() == _paths.size());
     invariant(_fieldSlots.size() == _pathExprs.size());
+    invariant(!_recordExpr || _recordSlot);
 }
 
 std::unique_ptr<PlanStage> ColumnScanStage::clone() const {
@@ -32,12 +32,23 @@
 #include "mongo/db/exec/sbe/stages/exchange.h"
 
 #include "mongo/base/init.h"
+#include "mongo/db/catalog/collection_catalog.h"
 #include "mongo/db/client.h"
-#include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/exec/sbe/size_estimator.h"
+#include "mongo/db/exec/sbe/stages/collection_helpers.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/storage/recovery_unit.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo::sbe {
 std::unique_ptr<ThreadPool> s_globalThreadPool;
+
+namespace {
+// The number of threads currently reserved by all exchanges from the budget given by
+// 'internalQuerySlotBasedExecutionParallelThreadBudget'.
+AtomicWord<long long> s_numOfReservedProducerThreads{0};
+}  // namespace
 MONGO_INITIALIZER(s_globalThreadPool)(InitializerContext* context) {
     ThreadPool::Options options;
     options.poolName = "parallel execution pool";
@@ -70,10 +81,11 @@ void ExchangePipe::close() {
     _cond.notify_all();
 }
 
-std::unique_ptr<ExchangeBuffer> ExchangePipe::getEmptyBuffer() {
+std::unique_ptr<ExchangeBuffer> ExchangePipe::getEmptyBuffer(OperationContext* opCtx) {
     stdx::unique_lock lock(_mutex);
 
-    _cond.wait(lock, [this]() { return _closed || _emptyCount > 0; });
+    opCtx->waitForConditionOrInterrupt(
+        _cond, lock, [this]() { return _closed || _emptyCount > 0; });
 
     if (_closed) {
         return nullptr;
@@ -84,10 +96,11 @@ std::unique_ptr<ExchangeBuffer> ExchangePipe::getEmptyBuffer() {
     return std::move(_emptyBuffers[_emptyCount]);
 }
 
-std::unique_ptr<ExchangeBuffer> ExchangePipe::getFullBuffer() {
+std::unique_ptr<ExchangeBuffer> ExchangePipe::getFullBuffer(OperationContext* opCtx) {
     stdx::unique_lock lock(_mutex);
 
-    _cond.wait(lock, [this]() { return _closed || _fullCount != _fullPosition; });
+    opCtx->waitForConditionOrInterrupt(
+        _cond, lock, [this]() { return _closed || _fullCount != _fullPosition; });
 
     if (_closed) {
         return nullptr;
@@ -123,17 +136,74 @@ ExchangeState::ExchangeState(size_t numOfProducers,
                              value::SlotVector fields,
                              ExchangePolicy policy,
                              std::unique_ptr<EExpression> partition,
-                             std::unique_ptr<EExpression> orderLess)
+                             std::unique_ptr<EExpression> orderLess,
+                             boost::optional<UUID> collectionUuid)
     : _policy(policy),
+      _numOfPlannedProducers(numOfProducers),
       _numOfProducers(numOfProducers),
       _fields(std::move(fields)),
       _partition(std::move(partition)),
-      _orderLess(std::move(orderLess)) {}
+      _orderLess(std::move(orderLess)),
+      _collectionUuid(std::move(collectionUuid)) {}
+
+ExchangeState::~ExchangeState() {
+    releaseProducerThreads();
+}
 
 ExchangePipe* ExchangeState::pipe(size_t consumerTid, size_t producerTid) {
     return _consumers[consumerTid]->pipe(producerTid);
 }
 
+void ExchangeState::reserveProducerThreads() {
+    invariant(_numOfReservedThreads == 0);
+
+    const long long budget = internalQuerySlotBasedExecutionParallelThreadBudget.load();
+    auto reserved = s_numOfReservedProducerThreads.load();
+    long long granted;
+    do {
+        granted = std::max(1LL,
+                           std::min(static_cast<long long>(_numOfProducers), budget - reserved));
+    } while (!s_numOfReservedProducerThreads.compareAndSwap(&reserved, reserved + granted));
+
+    _numOfReservedThreads = granted;
+    _numOfProducers = granted;
+}
+
+void ExchangeState::releaseProducerThreads() {
+    if (_numOfReservedThreads) {
+        s_numOfReservedProducerThreads.subtractAndFetch(_numOfReservedThreads);
+        _numOfReservedThreads = 0;
+    }
+}
+
+void ExchangeState::registerProducerOpCtx(OperationContext* opCtx) {
+    stdx::lock_guard lock(_producerOpCtxMutex);
+    _producerOpCtxs.push_back(opCtx);
+
+    if (_producerKillCode) {
+        stdx::lock_guard<Client> clientLock(*opCtx->getClient());
+        opCtx->getServiceContext()->killOperation(clientLock, opCtx, *_producerKillCode);
+    }
+}
+
+void ExchangeState::unregisterProducerOpCtx(OperationContext* opCtx) {
+    stdx::lock_guard lock(_producerOpCtxMutex);
+    _producerOpCtxs.erase(std::find(_producerOpCtxs.begin(), _producerOpCtxs.end(), opCtx));
+}
+
+void ExchangeState::killProducers(ErrorCodes::Error code) {
+    stdx::lock_guard lock(_producerOpCtxMutex);
+    if (_producerKillCode) {
+        return;
+    }
+    _producerKillCode = code;
+
+    for (auto opCtx : _producerOpCtxs) {
+        stdx::lock_guard<Client> clientLock(*opCtx->getClient());
+        opCtx->getServiceContext()->killOperation(clientLock, opCtx, code);
+    }
+}
+
 size_t ExchangeState::estimateCompileTimeSize() const {
     size_t size = sizeof(*this);
     size += size_estimator::estimate(_fields);
@@ -149,7 +219,7 @@ ExchangeBuffer* ExchangeConsumer::getBuffer(size_t producerId) {
         return _fullBuffers[producerId].get();
     }
 
-    _fullBuffers[producerId] = _pipes[producerId]->getFullBuffer();
+    _fullBuffers[producerId] = _pipes[producerId]->getFullBuffer(_opCtx);
 
     return _fullBuffers[producerId].get();
 }
@@ -171,11 +241,16 @@ ExchangeConsumer::ExchangeConsumer(std::unique_ptr<PlanStage> input,
                                    ExchangePolicy policy,
                                    std::unique_ptr<EExpression> partition,
                                    std::unique_ptr<EExpression> orderLess,
-                                   PlanNodeId planNodeId)
+                                   PlanNodeId planNodeId,
+                                   boost::optional<UUID> collectionUuid)
     : PlanStage("exchange"_sd, planNodeId) {
     _children.emplace_back(std::move(input));
-    _state = std::make_shared<ExchangeState>(
-        numOfProducers, std::move(fields), policy, std::move(partition), std::move(orderLess));
+    _state = std::make_shared<ExchangeState>(numOfProducers,
+                                             std::move(fields),
+                                             policy,
+                                             std::move(partition),
+                                             std::move(orderLess),
+                                             std::move(collectionUuid));
 
     _tid = _state->addConsumer(this);
     _orderPreserving = _state->isOrderPreserving();
@@ -191,8 +266,26 @@ ExchangeConsumer::ExchangeConsumer(std::shared_ptr<ExchangeState> state, PlanNod
     _tid = _state->addConsumer(this);
     _orderPreserving = _state->isOrderPreserving();
 }
+ExchangeConsumer::~ExchangeConsumer() {
+    // The plan may be destroyed without being closed, for example when a stage above this one
+    // throws. The producers must not outlive the pipes they write to.
+    if (_producersRunning) {
+        abortProducers(ErrorCodes::QueryPlanKilled);
+    }
+}
 std::unique_ptr<PlanStage> ExchangeConsumer::clone() const {
-    return std::make_unique<ExchangeConsumer>(_state, _commonStats.nodeId);
+    // The clone gets its own state, so that it can be opened and run independently of this stage,
+    // for example when a plan is cloned from the plan cache.
+    tassert(7027504, "an exchange cannot be cloned after it was opened", !_children.empty());
+    return std::make_unique<ExchangeConsumer>(
+        _children[0]->clone(),
+        _state->numOfPlannedProducers(),
+        _state->fields(),
+        _state->policy(),
+        _state->partitionExpr() ? _state->partitionExpr()->clone() : nullptr,
+        _state->orderLessExpr() ? _state->orderLessExpr()->clone() : nullptr,
+        _commonStats.nodeId,
+        _state->collectionUuid());
 }
 void ExchangeConsumer::prepare(CompileCtx& ctx) {
     for (size_t idx = 0; idx < _state->fields().size(); ++idx) {
@@ -232,6 +325,12 @@ void ExchangeConsumer::open(bool reOpen) {
         stdx::unique_lock lock(_state->consumerOpenMutex());
         bool allConsumers = (++_state->consumerOpen()) == _state->numOfConsumers();
 
+        // The first consumer to show up reserves the producer threads, so that all consumers agree
+        // on the number of producers when creating their pipes.
+        if (_state->consumerOpen() == 1) {
+            _state->reserveProducerThreads();
+        }
+
         // Create all pipes.
         if (_orderPreserving) {
             for (size_t idx = 0; idx < _state->numOfProducers(); ++idx) {
@@ -272,22 +371,69 @@ void ExchangeConsumer::open(bool reOpen) {
                 }
             }
 
+            // Producers read using their own operation contexts. If this consumer reads at a
+            // timestamp, make the producers read at the same one so that they all observe the same
+            // snapshot of the data.
+            boost::optional<Timestamp> readTimestamp;
+            if (_opCtx->recoveryUnit()->getTimestampReadSource() !=
+                RecoveryUnit::ReadSource::kNoTimestamp) {
+                readTimestamp = _opCtx->recoveryUnit()->getPointInTimeReadTimestamp(_opCtx);
+            }
+
+            // When the producers read a collection, this consumer holds the collection, either
+            // locked or through a catalog stashed with its snapshot. Hand the producers what they
+            // need to acquire the same collection at the same snapshot, through the same catalog.
+            const auto catalog = CollectionCatalog::get(_opCtx);
+            boost::optional<ExchangeCollection> collection;
+            if (auto& collUuid = _state->collectionUuid()) {
+                uassert(ErrorCodes::SnapshotUnavailable,
+                        "an exchange over a collection requires a point-in-time read",
+                        readTimestamp);
+                auto [collPtr, nss, catalogEpoch] = acquireCollection(_opCtx, *collUuid);
+                collection = ExchangeCollection{nss, *collUuid, catalogEpoch};
+            }
+
+            // The producers stop at the same deadline as this consumer. If this consumer is killed
+            // while it waits for them, it kills the producers in turn.
+            const auto deadline = _opCtx->getDeadline();
+            const auto timeoutError = _opCtx->getTimeoutError();
+
             // Start n producers.
-            invariant(_state->producerCompileCtxs().size() == _state->numOfProducers());
+            invariant(_state->producerCompileCtxs().size() >= _state->numOfProducers());
+            _producersRunning = true;
             for (size_t idx = 0; idx < _state->numOfProducers(); ++idx) {
                 auto pf = makePromiseFuture<void>();
-                s_globalThreadPool->schedule(
-                    [this, idx, promise = std::move(pf.promise)](auto status) mutable {
-                        invariant(status);
+                s_globalThreadPool->schedule([state = _state,
+                                              idx,
+                                              readTimestamp,
+                                              catalog,
+                                              collection,
+                                              deadline,
+                                              timeoutError,
+                                              promise = std::move(pf.promise)](
+                                                 auto status) mutable {
+                    invariant(status);
+
+                    auto opCtx = cc().makeOperationContext();
+                    if (readTimestamp) {
+                        opCtx->recoveryUnit()->setTimestampReadSource(
+                            RecoveryUnit::ReadSource::kProvided, *readTimestamp);
+                    }
+                    CollectionCatalog::stash(opCtx.get(), catalog);
+                    if (deadline != Date_t::max()) {
+                        opCtx->setDeadlineByDate(deadline, timeoutError);
+                    }
 
-                        auto opCtx = cc().makeOperationContext();
+                    state->registerProducerOpCtx(opCtx.get());
+                    ON_BLOCK_EXIT([&] { state->unregisterProducerOpCtx(opCtx.get()); });
 
-                        promise.setWith([&] {
-                            ExchangeProducer::start(opCtx.get(),
-                                                    _state->producerCompileCtxs()[idx],
-                                                    std::move(_state->producerPlans()[idx]));
-                        });
+                    promise.setWith([&] {
+                        ExchangeProducer::start(opCtx.get(),
+                                                state->producerCompileCtxs()[idx],
+                                                std::move(state->producerPlans()[idx]),
+                                                collection);
                     });
+                });
                 _state->addProducerFuture(std::move(pf.future));
             }
         } else {
@@ -316,6 +462,17 @@ void ExchangeConsumer::open(bool reOpen) {
 PlanState ExchangeConsumer::getNext() {
     auto optTimer(getOptTimer(_opCtx));
 
+    try {
+        return getNextFromPipes();
+    } catch (const ExceptionForCat<ErrorCategory::Interruption>& ex) {
+        // This consumer's operation was killed or has timed out while it was waiting for the
+        // producers. Stop them, as they run on operation contexts of their own.
+        abortProducers(ex.code());
+        throw;
+    }
+}
+
+PlanState ExchangeConsumer::getNextFromPipes() {
     if (_orderPreserving) {
         // Build a heap and return min element.
         uasserted(4822834, "ordere exchange not yet implemented");
@@ -367,6 +524,8 @@ void ExchangeConsumer::close() {
             for (size_t idx = 0; idx < _state->numOfProducers(); ++idx) {
                 _state->producerResults()[idx].wait();
             }
+            _producersRunning = false;
+            _state->releaseProducerThreads();
         }
 
         if (_state->consumerClose() == _state->numOfConsumers()) {
@@ -388,6 +547,21 @@ void ExchangeConsumer::close() {
     }
 }
 
+void ExchangeConsumer::abortProducers(ErrorCodes::Error code) {
+    for (auto& p : _pipes) {
+        p->close();
+    }
+    _state->killProducers(code);
+
+    if (_tid == 0 && _producersRunning) {
+        for (auto& result : _state->producerResults()) {
+            result.wait();
+        }
+        _producersRunning = false;
+        _state->releaseProducerThreads();
+    }
+}
+
 std::unique_ptr<PlanStageStats> ExchangeConsumer::getStats(bool includeDebugInfo) const {
     auto ret = std::make_unique<PlanStageStats>(_commonStats);
     if (!_children.empty()) {
@@ -461,7 +635,7 @@ ExchangeBuffer* ExchangeProducer::getBuffer(size_t consumerId) {
         return _emptyBuffers[consumerId].get();
     }
 
-    _emptyBuffers[consumerId] = _pipes[consumerId]->getEmptyBuffer();
+    _emptyBuffers[consumerId] = _pipes[consumerId]->getEmptyBuffer(_opCtx);
 
     if (!_emptyBuffers[consumerId]) {
         closePipes();
@@ -501,11 +675,18 @@ ExchangeProducer::ExchangeProducer(std::unique_ptr<PlanStage> input,
 
 void ExchangeProducer::start(OperationContext* opCtx,
                              CompileCtx& ctx,
-                             std::unique_ptr<PlanStage> producer) {
+                             std::unique_ptr<PlanStage> producer,
+                             const boost::optional<ExchangeCollection>& collection) {
     ExchangeProducer* p = static_cast<ExchangeProducer*>(producer.get());
 
-    // TODO: SERVER-62925. Rationalize this lock.
-    Lock::GlobalLock lock(opCtx, MODE_IS);
+    // The producer takes no locks of its own: a lock request queued behind a conflicting one
+    // would wait for the consumer, which holds its locks until all the producers are done. The
+    // producer reads lock-free through the consumer's catalog instead, which the consumer's locks
+    // keep valid, and makes sure that the collection is still the one the consumer saw.
+    LockFreeReadsBlock lockFreeReadsBlock(opCtx);
+    if (collection) {
+        restoreCollection(opCtx, collection->nss, collection->uuid, collection->catalogEpoch);
+    }
 
     p->attachToOperationContext(opCtx);
 
@@ -33,10 +33,12 @@
 
 #include "mongo/db/exec/sbe/expressions/expression.h"
 #include "mongo/db/exec/sbe/stages/stages.h"
+#include "mongo/db/namespace_string.h"
 #include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/future.h"
 #include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/future.h"
+#include "mongo/util/uuid.h"
 
 namespace mongo::sbe {
 class ExchangeConsumer;
@@ -44,6 +46,17 @@ class ExchangeProducer;
 
 enum class ExchangePolicy { broadcast, roundrobin, hashpartition, rangepartition };
 
+/**
+ * The collection the producers of an exchange read from, as the consumer sees it when it starts
+ * them. The producers read the collection through the consumer's catalog without locking it, and
+ * check that it is still the same one.
+ */
+struct ExchangeCollection {
+    NamespaceString nss;
+    UUID uuid;
+    uint64_t catalogEpoch;
+};
+
 // A unit of exchange between a consumer and a producer
 class ExchangeBuffer {
 public:
@@ -122,8 +135,13 @@ public:
     ExchangePipe(size_t size);
 
     void close();
-    std::unique_ptr<ExchangeBuffer> getEmptyBuffer();
-    std::unique_ptr<ExchangeBuffer> getFullBuffer();
+
+    /**
+     * Wait until a buffer is available or the pipe is closed. The wait is interrupted when
+     * 'opCtx' is killed or exceeds its deadline.
+     */
+    std::unique_ptr<ExchangeBuffer> getEmptyBuffer(OperationContext* opCtx);
+    std::unique_ptr<ExchangeBuffer> getFullBuffer(OperationContext* opCtx);
     void putEmptyBuffer(std::unique_ptr<ExchangeBuffer>);
     void putFullBuffer(std::unique_ptr<ExchangeBuffer>);
 
@@ -150,7 +168,10 @@ public:
                   value::SlotVector fields,
                   ExchangePolicy policy,
                   std::unique_ptr<EExpression> partition,
-                  std::unique_ptr<EExpression> orderLess);
+                  std::unique_ptr<EExpression> orderLess,
+                  boost::optional<UUID> collectionUuid);
+
+    ~ExchangeState();
 
     bool isOrderPreserving() const {
         return !!_orderLess;
@@ -211,6 +232,9 @@ public:
     auto numOfProducers() const {
         return _numOfProducers;
     }
+    auto numOfPlannedProducers() const {
+        return _numOfPlannedProducers;
+    }
 
     auto& fields() const {
         return _fields;
@@ -220,13 +244,48 @@ public:
         return _partition.get();
     }
 
+    auto orderLessExpr() const {
+        return _orderLess.get();
+    }
+
+    const auto& collectionUuid() const {
+        return _collectionUuid;
+    }
+
     ExchangePipe* pipe(size_t consumerTid, size_t producerTid);
 
+    /**
+     * Reserves threads for the producers from the server-wide parallel execution budget and lowers
+     * the number of producers to the number of threads granted. At least one thread is always
+     * granted so that the exchange can make progress.
+     */
+    void reserveProducerThreads();
+
+    /**
+     * Returns the threads reserved by 'reserveProducerThreads()' to the budget.
+     */
+    void releaseProducerThreads();
+
+    /**
+     * Producers register their operation contexts for the time they run, so that the consumers can
+     * kill them when the consumers' own operation is interrupted.
+     */
+    void registerProducerOpCtx(OperationContext* opCtx);
+    void unregisterProducerOpCtx(OperationContext* opCtx);
+
+    /**
+     * Kills the operation contexts of all running producers with 'code'. Producers which register
+     * after this call are killed right away.
+     */
+    void killProducers(ErrorCodes::Error code);
+
     size_t estimateCompileTimeSize() const;
 
 private:
     const ExchangePolicy _policy;
-    const size_t _numOfProducers;
+    const size_t _numOfPlannedProducers;
+    size_t _numOfProducers;
+    size_t _numOfReservedThreads{0};
     std::vector<ExchangeConsumer*> _consumers;
     std::vector<ExchangeProducer*> _producers;
     std::vector<std::unique_ptr<PlanStage>> _producerPlans;
@@ -242,6 +301,13 @@ private:
     // The '<' function for order preserving exchange.
     const std::unique_ptr<EExpression> _orderLess;
 
+    // The collection the producers read from, if any.
+    const boost::optional<UUID> _collectionUuid;
+
+    mongo::Mutex _producerOpCtxMutex;
+    std::vector<OperationContext*> _producerOpCtxs;
+    boost::optional<ErrorCodes::Error> _producerKillCode;
+
     // This is verbose and heavyweight. Recondsider something lighter
     // at minimum try to share a single mutex (i.e. _stateMutex) if safe
     mongo::Mutex _consumerOpenMutex;
@@ -261,10 +327,13 @@ public:
                      ExchangePolicy policy,
                      std::unique_ptr<EExpression> partition,
                      std::unique_ptr<EExpression> orderLess,
-                     PlanNodeId planNodeId);
+                     PlanNodeId planNodeId,
+                     boost::optional<UUID> collectionUuid = boost::none);
 
     ExchangeConsumer(std::shared_ptr<ExchangeState> state, PlanNodeId planNodeId);
 
+    ~ExchangeConsumer();
+
     std::unique_ptr<PlanStage> clone() const final;
 
     void prepare(CompileCtx& ctx) final;
@@ -284,6 +353,14 @@ private:
     ExchangeBuffer* getBuffer(size_t producerId);
     void putBuffer(size_t producerId);
 
+    PlanState getNextFromPipes();
+
+    /**
+     * Stops the producers early and, for consumer 0, waits for them to finish. The producers refer
+     * to the pipes owned by the consumers, hence they must be gone before the consumers are.
+     */
+    void abortProducers(ErrorCodes::Error code);
+
     std::shared_ptr<ExchangeState> _state;
     size_t _tid{0};
 
@@ -304,6 +381,9 @@ private:
 
     bool _orderPreserving{false};
 
+    // Set once consumer 0 has started the producers and reset once they have all finished.
+    bool _producersRunning{false};
+
     size_t _rowProcessed{0};
 };
 
@@ -315,7 +395,8 @@ public:
 
     static void start(OperationContext* opCtx,
                       CompileCtx& ctx,
-                      std::unique_ptr<PlanStage> producer);
+                      std::unique_ptr<PlanStage> producer,
+                      const boost::optional<ExchangeCollection>& collection);
 
     std::unique_ptr<PlanStage> clone() const final;
 
@@ -268,8 +268,8 @@ void HashAggStage::makeTemporaryRecordStore() {
     _specificStats.usedDisk = true;
 }
 
-void HashAggStage::spillRowToDisk(const value::MaterializedRow& key,
-                                  const value::MaterializedRow& val) {
+std::pair<RecordId, BufBuilder> HashAggStage::serializeSpilledRow(
+    const value::MaterializedRow& key, const value::MaterializedRow& val) {
     CollatorInterface* collator = nullptr;
     if (_collatorAccessor) {
         auto [colTag, colVal] = _collatorAccessor->getViewOfValue();
@@ -288,16 +288,19 @@ void HashAggStage::spillRowToDisk(const value::MaterializedRow& key,
     kb.appendNumberLong(_ridCounter++);
     auto rid = RecordId(kb.getBuffer(), kb.getSize());
 
+    BufBuilder buf;
     if (collator) {
         // The keystring cannot always be deserialized back to the original keys when a collation is
         // in use, so we also store the unmodified key in the data part of the spilled record.
-        upsertToRecordStore(_opCtx, _recordStore->rs(), rid, key, val, false /*update*/);
+        key.serializeForSorter(buf);
+        val.serializeForSorter(buf);
     } else {
+        val.serializeForSorter(buf);
         auto typeBits = kb.getTypeBits();
-        upsertToRecordStore(_opCtx, _recordStore->rs(), rid, val, typeBits, false /*update*/);
+        buf.appendBuf(typeBits.getBuffer(), typeBits.getSize());
     }
 
-    _specificStats.spilledRecords++;
+    return {std::move(rid), std::move(buf)};
 }
 
 void HashAggStage::spill(MemoryCheckData& mcd) {
@@ -314,10 +317,35 @@ void HashAggStage::spill(MemoryCheckData& mcd) {
         makeTemporaryRecordStore();
     }
 
+    // The hash table is written out as a single sorted run. Inserting the records in key order
+    // and in batches is much cheaper than inserting them one at a time in hash order, which would
+    // hit a random position of the spill table for every record. Each batch is its own storage
+    // transaction, so that spilling a large hash table does not build up one huge transaction.
+    std::vector<std::pair<RecordId, BufBuilder>> spilledRows;
+    spilledRows.reserve(_ht->size());
     for (auto&& it : *_ht) {
-        spillRowToDisk(it.first, it.second);
+        spilledRows.emplace_back(serializeSpilledRow(it.first, it.second));
+    }
+    std::sort(spilledRows.begin(), spilledRows.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.first < rhs.first;
+    });
+
+    const size_t batchSize = internalQuerySlotBasedExecutionHashAggSpillBatchSize.load();
+    std::vector<Record> records;
+    records.reserve(std::min(batchSize, spilledRows.size()));
+    for (auto&& [rid, buf] : spilledRows) {
+        records.push_back(Record{rid, RecordData(buf.buf(), buf.len())});
+        if (records.size() == batchSize) {
+            insertRecordsToRecordStore(_opCtx, _recordStore->rs(), &records);
+            records.clear();
+        }
+    }
+    if (!records.empty()) {
+        insertRecordsToRecordStore(_opCtx, _recordStore->rs(), &records);
     }
 
+    _specificStats.spilledRecords += spilledRows.size();
+
     auto& metricsCollector = ResourceConsumption::MetricsCollector::get(_opCtx);
     // We're not actually doing any sorting here or using the 'Sorter' class, but for the purposes
     // of $operationMetrics we incorporate the number of spilled records into the "keysSorted"
@@ -424,6 +452,8 @@ void HashAggStage::open(bool reOpen) {
         MemoryCheckData memoryCheckData;
 
         while (_children[0]->getNext() == PlanState::ADVANCED) {
+            ++_specificStats.inputRows;
+
             value::MaterializedRow key{_inKeyAccessors.size()};
             // Copy keys in order to do the lookup.
             size_t idx = 0;
@@ -631,6 +661,23 @@ PlanState HashAggStage::getNext() {
     }
 }
 
+namespace {
+// If at least this fraction of the input rows ended up as spilled partial aggregates, the hash
+// table did not pre-aggregate anything meaningful and the groups were effectively computed by
+// merging the sorted spill runs.
+constexpr double kSortBasedSpilledRowsRatio = 0.9;
+
+StringData aggStrategyToString(const HashAggStats& stats) {
+    if (!stats.usedDisk) {
+        return "hash"_sd;
+    }
+    if (stats.spilledRecords >= kSortBasedSpilledRowsRatio * stats.inputRows) {
+        return "sort"_sd;
+    }
+    return "hashWithSpill"_sd;
+}
+}  // namespace
+
 std::unique_ptr<PlanStageStats> HashAggStage::getStats(bool includeDebugInfo) const {
     auto ret = std::make_unique<PlanStageStats>(_commonStats);
     ret->specific = std::make_unique<HashAggStats>(_specificStats);
@@ -658,6 +705,7 @@ std::unique_ptr<PlanStageStats> HashAggStage::getStats(bool includeDebugInfo) co
         bob.appendNumber("numSpills", _specificStats.numSpills);
         bob.appendNumber("spilledRecords", _specificStats.spilledRecords);
         bob.appendNumber("spilledDataStorageSize", _specificStats.spilledDataStorageSize);
+        bob.append("aggStrategy", aggStrategyToString(_specificStats));
 
         ret->debugInfo = bob.obj();
     }
@@ -163,17 +163,23 @@ private:
     };
 
     /**
-     * Inserts a key and value pair to the '_recordStore'. They key is serialized to a
-     * 'KeyString::Value' which becomes the 'RecordId'. This makes the keys memcmp-able and ensures
-     * that the record store ends up sorted by the group-by keys.
+     * Serializes a key and value pair into a record for the '_recordStore'. They key is serialized
+     * to a 'KeyString::Value' which becomes the 'RecordId'. This makes the keys memcmp-able and
+     * ensures that the record store ends up sorted by the group-by keys.
      *
      * Note that the 'typeBits' are needed to reconstruct the spilled 'key' to a 'MaterializedRow',
      * but are not necessary for comparison purposes. Therefore, we carry the type bits separately
      * from the record id, instead appending them to the end of the serialized 'val' buffer.
      */
-    void spillRowToDisk(const value::MaterializedRow& key, const value::MaterializedRow& val);
+    std::pair<RecordId, BufBuilder> serializeSpilledRow(const value::MaterializedRow& key,
+                                                        const value::MaterializedRow& val);
 
     void checkMemoryUsageAndSpillIfNecessary(MemoryCheckData& mcd);
+
+    /**
+     * Writes the whole hash table to the '_recordStore' as one run sorted by the record id and
+     * clears it.
+     */
     void spill(MemoryCheckData& mcd);
 
     /**
@@ -205,6 +205,10 @@ void HashLookupStage::reset() {
     _buffer.clear();
     _valueId = 0;
     _bufferIt = 0;
+
+    _htPartitionMemUsage.fill(0);
+    _spilledHtPartitions.reset();
+    _spilledKeysFilter = boost::none;
 }
 
 std::pair<RecordId, KeyString::TypeBits> HashLookupStage::serializeKeyForRecordStore(
@@ -229,62 +233,85 @@ void HashLookupStage::addHashTableEntry(value::SlotAccessor* keyAccessor, size_t
     auto [tagKeyView, valKeyView] = keyAccessor->getViewOfValue();
     _probeKey.reset(0, false, tagKeyView, valKeyView);
 
-    // Check to see if key is already in memory. If not, we will emplace a new key or spill to disk.
+    // Keys of a partition that has been evicted from memory always go to the record store.
+    const auto hash = _ht->hash_function()(_probeKey);
+    const auto partition = hash % kNumHtPartitions;
+    if (_spilledHtPartitions.test(partition)) {
+        spilledKeysFilter().insert(hash);
+        auto val = std::vector<size_t>{valueIndex};
+        spillIndicesToRecordStore(_recordStoreHt->rs(), tagKeyView, valKeyView, val);
+        return;
+    }
+
+    // Check to see if key is already in memory. If not, we will emplace a new key. Any memory
+    // overflow is resolved afterwards by evicting whole partitions.
+    long long memUsage = sizeof(size_t);
     auto htIt = _ht->find(_probeKey);
     if (htIt == _ht->end()) {
-        // If the key and one 'size_t' index fit into the '_ht' without reaching the memory limit
-        // and we haven't spilled yet emplace into '_ht'. Otherwise, we will always spill the key to
-        // the record store. The additional guard !hasSpilledHtToDisk() ensures that a key that is
-        // evicted from '_ht' never ends in '_ht' again.
-        const long long newMemUsage = _computedTotalMemUsage +
-            size_estimator::estimate(tagKeyView, valKeyView) + sizeof(size_t);
+        memUsage += size_estimator::estimate(tagKeyView, valKeyView);
 
+        // We have to insert an owned key, attempt a move, but force copy if necessary.
+        auto [tagKey, valKey] = keyAccessor->copyOrMoveValue();
         value::MaterializedRow key{1};
-        if (!hasSpilledHtToDisk() && newMemUsage <= _memoryUseInBytesBeforeSpill) {
-            // We have to insert an owned key, attempt a move, but force copy if necessary when we
-            // haven't spilled to the '_recordStore' yet.
-            auto [tagKey, valKey] = keyAccessor->copyOrMoveValue();
-            key.reset(0, true, tagKey, valKey);
-
-            auto [it, inserted] = _ht->try_emplace(std::move(key));
-            invariant(inserted);
-            htIt = it;
-            htIt->second.push_back(valueIndex);
-            _computedTotalMemUsage = newMemUsage;
-        } else {
-            // Write record to rs.
-            if (!hasSpilledHtToDisk()) {
-                makeTemporaryRecordStore();
+        key.reset(0, true, tagKey, valKey);
+
+        auto [it, inserted] = _ht->try_emplace(std::move(key));
+        invariant(inserted);
+        htIt = it;
+    }
+    htIt->second.push_back(valueIndex);
+    _htPartitionMemUsage[partition] += memUsage;
+    _computedTotalMemUsage += memUsage;
+
+    spillHtPartitionsIfNeeded();
+}
+
+void HashLookupStage::spillHtPartitionsIfNeeded() {
+    while (_computedTotalMemUsage > _memoryUseInBytesBeforeSpill) {
+        // Evict the largest in-memory partition first since it frees the most memory.
+        boost::optional<size_t> victim;
+        for (size_t partition = 0; partition < kNumHtPartitions; ++partition) {
+            if (!_spilledHtPartitions.test(partition) && _htPartitionMemUsage[partition] > 0 &&
+                (!victim || _htPartitionMemUsage[partition] > _htPartitionMemUsage[*victim])) {
+                victim = partition;
             }
+        }
 
-            auto val = std::vector<size_t>{valueIndex};
-            auto [tagKey, valKey] = keyAccessor->getViewOfValue();
-            spillIndicesToRecordStore(_recordStoreHt->rs(), tagKey, valKey, val);
+        if (!victim) {
+            // The remaining memory is held by the buffered rows, which are spilled separately.
+            return;
         }
-    } else {
-        // The key is already present in '_ht' so the memory will only grow by one size_t. If we
-        // reach the memory limit, the key/value in '_ht' will be evicted from memory and spilled to
-        // '_recordStoreHt' along with the new index.
-        const long long newMemUsage = _computedTotalMemUsage + sizeof(size_t);
-        if (newMemUsage <= _memoryUseInBytesBeforeSpill) {
-            htIt->second.push_back(valueIndex);
-            _computedTotalMemUsage = newMemUsage;
-        } else {
-            if (!hasSpilledHtToDisk()) {
-                makeTemporaryRecordStore();
-            }
+        spillHtPartition(*victim);
+    }
+}
 
-            value::MaterializedRow key{1};
-            key.reset(0, true, tagKeyView, valKeyView);
-            _computedTotalMemUsage -= size_estimator::estimate(tagKeyView, valKeyView);
+void HashLookupStage::spillHtPartition(size_t partition) {
+    if (!hasSpilledHtToDisk()) {
+        makeTemporaryRecordStore();
+    }
 
-            // Evict the hash table value.
-            _computedTotalMemUsage -= htIt->second.size() * sizeof(size_t);
-            htIt->second.push_back(valueIndex);
-            spillIndicesToRecordStore(_recordStoreHt->rs(), tagKeyView, valKeyView, htIt->second);
-            _ht->erase(htIt);
+    for (auto htIt = _ht->begin(); htIt != _ht->end();) {
+        if (getPartition(htIt->first) != partition) {
+            ++htIt;
+            continue;
         }
+
+        // This partition has not been spilled before, so none of its keys can be in the record
+        // store yet and we can insert them without reading the existing records back.
+        spilledKeysFilter().insert(_ht->hash_function()(htIt->first));
+        auto [tagKey, valKey] = htIt->first.getViewOfValue(0);
+        auto [owned, tagKeyColl, valKeyColl] = normalizeStringIfCollator(tagKey, valKey);
+        _probeKey.reset(0, owned, tagKeyColl, valKeyColl);
+        writeIndicesToRecordStore(
+            _recordStoreHt->rs(), tagKeyColl, valKeyColl, htIt->second, false /* update */);
+
+        htIt = _ht->erase(htIt);
     }
+
+    _computedTotalMemUsage -= _htPartitionMemUsage[partition];
+    _htPartitionMemUsage[partition] = 0;
+    _spilledHtPartitions.set(partition);
+    _specificStats.spilledHtPartitions++;
 }
 
 void HashLookupStage::makeTemporaryRecordStore() {
@@ -535,12 +562,16 @@ PlanState HashLookupStage::getNext() {
             while (!enumerator.atEnd()) {
                 auto [tagElemView, valElemView] = enumerator.getViewOfValue();
                 _probeKey.reset(0, false, tagElemView, valElemView);
-                auto htIt = _ht->find(_probeKey);
-                if (htIt != _ht->end()) {
-                    indices.insert(htIt->second.begin(), htIt->second.end());
-                } else if (_recordStoreHt) {
-                    // The key wasn't in memory and we have spilled to a '_recordStoreHt', fetch it
-                    // if it exists.
+                if (!isPartitionSpilled(_probeKey)) {
+                    auto htIt = _ht->find(_probeKey);
+                    if (htIt != _ht->end()) {
+                        indices.insert(htIt->second.begin(), htIt->second.end());
+                    }
+                } else if (!spilledKeyMayExist(_probeKey)) {
+                    _specificStats.spilledHtProbesSkipped++;
+                } else {
+                    // The key belongs to a partition that was spilled to '_recordStoreHt', fetch
+                    // it if it exists.
                     auto [_, tagElemCollView, valElemCollView] =
                         normalizeStringIfCollator(tagElemView, valElemView);
 
@@ -555,14 +586,15 @@ PlanState HashLookupStage::getNext() {
             accumulateFromValueIndices(indices);
         } else {
             _probeKey.reset(0, false, tagKeyView, valKeyView);
-            auto htIt = _ht->find(_probeKey);
-            if (htIt != _ht->end()) {
-                accumulateFromValueIndices(htIt->second);
-            } else if (_recordStoreHt) {
-                // Need to make sure we have spilled by checking if the '_recordStoreHt' is
-                // non-nullptr if we don't find the '_probeKey' in the '_ht'. Otherwise, the empty
-                // foreign side edge case won't fallthrough and we may hit this block and try to
-                // read from a non-existent '_recordStoreHt'.
+            if (!isPartitionSpilled(_probeKey)) {
+                // A miss on an in-memory partition is final, there is no need to go to disk.
+                auto htIt = _ht->find(_probeKey);
+                if (htIt != _ht->end()) {
+                    accumulateFromValueIndices(htIt->second);
+                }
+            } else if (!spilledKeyMayExist(_probeKey)) {
+                _specificStats.spilledHtProbesSkipped++;
+            } else {
                 auto [_, tagKeyCollView, valKeyCollView] =
                     normalizeStringIfCollator(tagKeyView, valKeyView);
 
@@ -599,7 +631,9 @@ std::unique_ptr<PlanStageStats> HashLookupStage::getStats(bool includeDebugInfo)
         // Spilling stats.
         bob.appendBool("usedDisk", _specificStats.usedDisk)
             .appendNumber("spilledRecords", _specificStats.getSpilledRecords())
-            .appendNumber("spilledBytesApprox", _specificStats.getSpilledBytesApprox());
+            .appendNumber("spilledBytesApprox", _specificStats.getSpilledBytesApprox())
+            .appendNumber("spilledHtPartitions", _specificStats.spilledHtPartitions)
+            .appendNumber("spilledHtProbesSkipped", _specificStats.spilledHtProbesSkipped);
         ret->debugInfo = bob.obj();
     }
     return ret;
@@ -29,10 +29,13 @@
 
 #pragma once
 
+#include <array>
+#include <bitset>
 #include <vector>
 
 #include "mongo/db/exec/sbe/expressions/expression.h"
 #include "mongo/db/exec/sbe/stages/stages.h"
+#include "mongo/db/exec/sbe/util/bloom_filter.h"
 #include "mongo/db/exec/sbe/vm/vm.h"
 #include "mongo/db/query/query_knobs_gen.h"
 
@@ -139,6 +142,48 @@ private:
                                    value::TypeTags tagKey,
                                    value::Value valKey,
                                    const std::vector<size_t>& value);
+
+    /**
+     * Returns the spill partition of a key. Keys that compare equal under the collator always map
+     * to the same partition since the partition is derived from the '_ht' hash function.
+     */
+    size_t getPartition(const value::MaterializedRow& key) const {
+        return _ht->hash_function()(key) % kNumHtPartitions;
+    }
+
+    bool isPartitionSpilled(const value::MaterializedRow& key) const {
+        return _spilledHtPartitions.any() && _spilledHtPartitions.test(getPartition(key));
+    }
+
+    /**
+     * Returns false if 'key', which belongs to a spilled partition, is known not to be in
+     * '_recordStoreHt', so that probing for it does not need to read from disk.
+     */
+    bool spilledKeyMayExist(const value::MaterializedRow& key) const {
+        return !_spilledKeysFilter || _spilledKeysFilter->mayContain(_ht->hash_function()(key));
+    }
+
+    BloomFilter& spilledKeysFilter() {
+        if (!_spilledKeysFilter) {
+            _spilledKeysFilter.emplace(std::max(
+                _memoryUseInBytesBeforeSpill / kSpilledKeysFilterMemoryDivisor,
+                kSpilledKeysFilterMinBytes));
+        }
+        return *_spilledKeysFilter;
+    }
+
+    /**
+     * Evicts every '_ht' entry of the given partition to '_recordStoreHt'. Once a partition is
+     * spilled all of its keys, including the ones added later, live in the record store only.
+     */
+    void spillHtPartition(size_t partition);
+
+    /**
+     * Spills the largest in-memory partitions until '_computedTotalMemUsage' is back under the
+     * memory limit or there is nothing left in '_ht' to evict.
+     */
+    void spillHtPartitionsIfNeeded();
+
     /**
      * Constructs a RecordId for a value index. It must be shifted by 1 since a valid RecordId
      * with the value 0 is invalid.
@@ -232,6 +277,20 @@ private:
     std::unique_ptr<TemporaryRecordStore> _recordStoreHt;
     std::unique_ptr<TemporaryRecordStore> _recordStoreBuf;
 
+    // The hash table is split into partitions by the hash of the key. When the memory limit is
+    // reached whole partitions are evicted to '_recordStoreHt', so a probe for a key of an
+    // in-memory partition never has to read from disk, even if the key is not present.
+    static constexpr size_t kNumHtPartitions = 16;
+    std::array<long long, kNumHtPartitions> _htPartitionMemUsage{};
+    std::bitset<kNumHtPartitions> _spilledHtPartitions;
+
+    // Summarizes the keys written to '_recordStoreHt', which lets most probes for keys of a spilled
+    // partition that have no match skip the read from disk. It is created at the first spill with
+    // a fixed size, a fraction of the memory limit, no matter how many keys are spilled.
+    static constexpr long long kSpilledKeysFilterMemoryDivisor = 16;
+    static constexpr long long kSpilledKeysFilterMinBytes = 1024;
+    boost::optional<BloomFilter> _spilledKeysFilter;
+
     HashLookupStats _specificStats;
 };
 }  // namespace mongo::sbe
@@ -60,6 +60,14 @@ struct CommonStats {
     // cache.
     boost::optional<long long> executionTimeMillis;
 
+    // The number of deep values (arrays, objects and big strings) allocated while working inside
+    // this stage, including its children. Only collected along with 'executionTimeMillis'.
+    size_t valueAllocations{0};
+
+    // Thread CPU time, in nanoseconds, spent inside this stage, including its children. Only
+    // collected when running explain with the "executionStats" verbosity or higher.
+    boost::optional<long long> cpuTimeNanos;
+
     size_t advances{0};
     size_t opens{0};
     size_t closes{0};
@@ -285,6 +293,9 @@ struct HashAggStats : public SpecificStats {
     // An estimate, in bytes, of the size of the final spill table after all spill events have taken
     // place.
     long long spilledDataStorageSize{0};
+    // The number of rows consumed from the child. Compared against 'spilledRecords' it tells how
+    // much the hash table reduced the input before spilling.
+    long long inputRows{0};
 };
 
 struct HashLookupStats : public SpecificStats {
@@ -317,6 +328,11 @@ struct HashLookupStats : public SpecificStats {
     long long spilledHtBytesOverAllRecords{0};
     long long spilledBuffRecords{0};
     long long spilledBuffBytesOverAllRecords{0};
+    // Number of hash table partitions that were evicted to the record store.
+    long long spilledHtPartitions{0};
+    // Number of probes for keys of evicted partitions that the Bloom filter of the spilled keys
+    // answered without reading from the record store.
+    long long spilledHtProbesSkipped{0};
 };
 
 /**
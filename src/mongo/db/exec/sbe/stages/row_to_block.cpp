@@ -0,0 +1,195 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/sbe/stages/row_to_block.h"
+
+#include "mongo/db/exec/sbe/size_estimator.h"
+#include "mongo/db/exec/sbe/values/block_interface.h"
+#include "mongo/util/str.h"
+
+namespace mongo::sbe {
+RowToBlockStage::RowToBlockStage(std::unique_ptr<PlanStage> input,
+                                 value::SlotVector inSlots,
+                                 value::SlotVector outSlots,
+                                 size_t blockSize,
+                                 PlanNodeId planNodeId)
+    : PlanStage("rowtoblock"_sd, planNodeId),
+      _inSlots(std::move(inSlots)),
+      _outSlots(std::move(outSlots)),
+      _blockSize(blockSize) {
+    _children.emplace_back(std::move(input));
+
+    uassert(7000100,
+            str::stream() << "the number of input and output slots must match: "
+                          << _inSlots.size() << " != " << _outSlots.size(),
+            _inSlots.size() == _outSlots.size());
+    uassert(7000101, "block size must be positive", _blockSize > 0);
+}
+
+std::unique_ptr<PlanStage> RowToBlockStage::clone() const {
+    return std::make_unique<RowToBlockStage>(
+        _children[0]->clone(), _inSlots, _outSlots, _blockSize, _commonStats.nodeId);
+}
+
+void RowToBlockStage::prepare(CompileCtx& ctx) {
+    _children[0]->prepare(ctx);
+
+    _inAccessors.clear();
+    for (auto slot : _inSlots) {
+        _inAccessors.push_back(_children[0]->getAccessor(ctx, slot));
+    }
+    _outAccessors = std::vector<value::OwnedValueAccessor>(_outSlots.size());
+}
+
+value::SlotAccessor* RowToBlockStage::getAccessor(CompileCtx& ctx, value::SlotId slot) {
+    for (size_t idx = 0; idx < _outSlots.size(); ++idx) {
+        if (_outSlots[idx] == slot) {
+            return &_outAccessors[idx];
+        }
+    }
+
+    return _children[0]->getAccessor(ctx, slot);
+}
+
+void RowToBlockStage::open(bool reOpen) {
+    auto optTimer(getOptTimer(_opCtx));
+
+    _commonStats.opens++;
+    _children[0]->open(reOpen);
+    _childEof = false;
+}
+
+PlanState RowToBlockStage::getNext() {
+    auto optTimer(getOptTimer(_opCtx));
+
+    if (_childEof) {
+        return trackPlanState(PlanState::IS_EOF);
+    }
+
+    std::vector<std::unique_ptr<value::HeterogeneousBlock>> blocks;
+    blocks.reserve(_outSlots.size());
+    for (size_t idx = 0; idx < _outSlots.size(); ++idx) {
+        blocks.push_back(std::make_unique<value::HeterogeneousBlock>());
+        blocks.back()->reserve(_blockSize);
+    }
+
+    size_t numRows = 0;
+    while (numRows < _blockSize) {
+        // The values of the previous row have already been copied into the blocks, so there is no
+        // need for the child to preserve them across a yield.
+        disableSlotAccess();
+        if (_children[0]->getNext() != PlanState::ADVANCED) {
+            _childEof = true;
+            break;
+        }
+
+        for (size_t idx = 0; idx < _inAccessors.size(); ++idx) {
+            auto [tag, val] = _inAccessors[idx]->getViewOfValue();
+            blocks[idx]->push_back(value::copyValue(tag, val));
+        }
+        ++numRows;
+    }
+
+    if (numRows == 0) {
+        return trackPlanState(PlanState::IS_EOF);
+    }
+
+    for (size_t idx = 0; idx < _outAccessors.size(); ++idx) {
+        auto [tag, val] = value::makeValueBlock(std::move(blocks[idx]));
+        _outAccessors[idx].reset(true, tag, val);
+    }
+
+    return trackPlanState(PlanState::ADVANCED);
+}
+
+void RowToBlockStage::close() {
+    auto optTimer(getOptTimer(_opCtx));
+
+    trackClose();
+    _children[0]->close();
+}
+
+std::unique_ptr<PlanStageStats> RowToBlockStage::getStats(bool includeDebugInfo) const {
+    auto ret = std::make_unique<PlanStageStats>(_commonStats);
+
+    if (includeDebugInfo) {
+        BSONObjBuilder bob;
+        bob.appendNumber("blockSize", static_cast<long long>(_blockSize));
+        bob.append("inputSlots", _inSlots.begin(), _inSlots.end());
+        bob.append("outputSlots", _outSlots.begin(), _outSlots.end());
+        ret->debugInfo = bob.obj();
+    }
+
+    ret->children.emplace_back(_children[0]->getStats(includeDebugInfo));
+    return ret;
+}
+
+const SpecificStats* RowToBlockStage::getSpecificStats() const {
+    return nullptr;
+}
+
+std::vector<DebugPrinter::Block> RowToBlockStage::debugPrint() const {
+    auto ret = PlanStage::debugPrint();
+
+    ret.emplace_back(std::to_string(_blockSize));
+
+    ret.emplace_back(DebugPrinter::Block("[`"));
+    for (size_t idx = 0; idx < _outSlots.size(); ++idx) {
+        if (idx) {
+            ret.emplace_back(DebugPrinter::Block("`,"));
+        }
+        DebugPrinter::addIdentifier(ret, _outSlots[idx]);
+    }
+    ret.emplace_back(DebugPrinter::Block("`]"));
+
+    ret.emplace_back(DebugPrinter::Block("[`"));
+    for (size_t idx = 0; idx < _inSlots.size(); ++idx) {
+        if (idx) {
+            ret.emplace_back(DebugPrinter::Block("`,"));
+        }
+        DebugPrinter::addIdentifier(ret, _inSlots[idx]);
+    }
+    ret.emplace_back(DebugPrinter::Block("`]"));
+
+    DebugPrinter::addNewLine(ret);
+    DebugPrinter::addBlocks(ret, _children[0]->debugPrint());
+
+    return ret;
+}
+
+size_t RowToBlockStage::estimateCompileTimeSize() const {
+    size_t size = sizeof(*this);
+    size += size_estimator::estimate(_children);
+    size += size_estimator::estimate(_inSlots);
+    size += size_estimator::estimate(_outSlots);
+    return size;
+}
+}  // namespace mongo::sbe
@@ -0,0 +1,80 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include "mongo/db/exec/sbe/stages/stages.h"
+
+namespace mongo::sbe {
+/**
+ * Gathers up to 'blockSize' rows from its child and hands them to its parent all at once. For each
+ * slot in 'inSlots' the values of the gathered rows are copied into a block which is made
+ * available through the corresponding slot in 'outSlots'. Each call to getNext() produces one
+ * block per output slot; the last block of a stream may contain fewer than 'blockSize' values.
+ *
+ * Together with BlockToRowStage (see block_to_row.h) this allows a part of a plan to run
+ * block-at-a-time: expressions using the 'valueBlock*' builtins can evaluate a predicate or a
+ * projection over every value of a block in a single VM call.
+ *
+ * Debug string representation:
+ *
+ *   rowtoblock blockSize [outSlot_1, ..., outSlot_n] [inSlot_1, ..., inSlot_n] childStage
+ */
+class RowToBlockStage final : public PlanStage {
+public:
+    RowToBlockStage(std::unique_ptr<PlanStage> input,
+                    value::SlotVector inSlots,
+                    value::SlotVector outSlots,
+                    size_t blockSize,
+                    PlanNodeId planNodeId);
+
+    std::unique_ptr<PlanStage> clone() const final;
+
+    void prepare(CompileCtx& ctx) final;
+    value::SlotAccessor* getAccessor(CompileCtx& ctx, value::SlotId slot) final;
+    void open(bool reOpen) final;
+    PlanState getNext() final;
+    void close() final;
+
+    std::unique_ptr<PlanStageStats> getStats(bool includeDebugInfo) const final;
+    const SpecificStats* getSpecificStats() const final;
+    std::vector<DebugPrinter::Block> debugPrint() const final;
+    size_t estimateCompileTimeSize() const final;
+
+private:
+    const value::SlotVector _inSlots;
+    const value::SlotVector _outSlots;
+    const size_t _blockSize;
+
+    std::vector<value::SlotAccessor*> _inAccessors;
+    std::vector<value::OwnedValueAccessor> _outAccessors;
+
+    bool _childEof{false};
+};
+}  // namespace mongo::sbe
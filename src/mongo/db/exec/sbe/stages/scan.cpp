@@ -36,6 +36,7 @@
 #include "mongo/db/exec/sbe/size_estimator.h"
 #include "mongo/db/exec/trial_run_tracker.h"
 #include "mongo/db/index/index_access_method.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/repl/optime.h"
 #include "mongo/util/str.h"
 
@@ -336,6 +337,14 @@ void ScanStage::open(bool reOpen) {
                 _cursor = _coll->getCursor(_opCtx, _forward);
             }
         }
+
+        // Only full scans read ahead of the records they return. Capped collections must be able
+        // to detect that the position of the cursor was lost after a yield.
+        _batch.clear();
+        _batchPos = 0;
+        _batchSize = (_useRandomCursor || _seekKeyAccessor || _oplogTsSlot || _coll->isCapped())
+            ? 0
+            : internalQueryCollectionScanBatchSize.load();
     } else {
         MONGO_UNREACHABLE_TASSERT(5959701);
     }
@@ -369,7 +378,7 @@ PlanState ScanStage::getNext() {
 
     auto res = _firstGetNext && _seekKeyAccessor;
     auto nextRecord = _useRandomCursor ? _randomCursor->next()
-                                       : (res ? _cursor->seekExact(_key) : _cursor->next());
+                                       : (res ? _cursor->seekExact(_key) : nextRecord());
     _firstGetNext = false;
 
     if (!nextRecord) {
@@ -459,11 +468,28 @@ PlanState ScanStage::getNext() {
     return trackPlanState(PlanState::ADVANCED);
 }
 
+boost::optional<Record> ScanStage::nextRecord() {
+    if (_batchSize <= 1) {
+        return _cursor->next();
+    }
+
+    if (_batchPos == _batch.size()) {
+        _batchPos = 0;
+        _cursor->nextBatch(_batchSize, &_batch);
+        if (_batch.empty()) {
+            return boost::none;
+        }
+    }
+    return std::move(_batch[_batchPos++]);
+}
+
 void ScanStage::close() {
     auto optTimer(getOptTimer(_opCtx));
 
     trackClose();
     _indexCatalogEntryMap.clear();
+    _batch.clear();
+    _batchPos = 0;
     _cursor.reset();
     _randomCursor.reset();
     _coll.reset();
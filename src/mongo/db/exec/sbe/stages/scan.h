@@ -136,6 +136,10 @@ private:
     // Returns the primary cursor or the random cursor depending on whether _useRandomCursor is set.
     RecordCursor* getActiveCursor() const;
 
+    // Returns the next record of '_cursor', reading '_batchSize' records at once from the storage
+    // engine when batching is enabled.
+    boost::optional<Record> nextRecord();
+
     const UUID _collUuid;
     const boost::optional<value::SlotId> _recordSlot;
     const boost::optional<value::SlotId> _recordIdSlot;
@@ -191,6 +195,12 @@ private:
     RecordId _key;
     bool _firstGetNext{false};
 
+    // When greater than 1, the number of records read from '_cursor' at once. The records of the
+    // current batch are returned from '_batch' starting at '_batchPos'.
+    size_t _batchSize{0};
+    std::vector<Record> _batch;
+    size_t _batchPos{0};
+
     ScanStats _specificStats;
 
     // Flag set upon restoring the stage that indicates whether the cursor's position in the
@@ -61,6 +61,7 @@ SortStage::SortStage(std::unique_ptr<PlanStage> input,
       _dirs(std::move(dirs)),
       _vals(std::move(vals)),
       _allowDiskUse(allowDiskUse),
+      _sorterFileStats(std::make_unique<SorterFileStats>(nullptr /* sorterTracker */)),
       _mergeData({0, 0}) {
     _children.emplace_back(std::move(input));
 
@@ -127,6 +128,7 @@ void SortStage::makeSorter() {
     opts.limit =
         _specificStats.limit != std::numeric_limits<size_t>::max() ? _specificStats.limit : 0;
     opts.moveSortedDataIntoIterator = true;
+    opts.sorterFileStats = _sorterFileStats.get();
 
     auto comp = [&](const SorterData& lhs, const SorterData& rhs) {
         auto size = lhs.first.size();
@@ -214,6 +216,8 @@ void SortStage::open(bool reOpen) {
     _specificStats.totalDataSizeBytes += _sorter->totalDataSizeSorted();
     _mergeIt.reset(_sorter->done());
     _specificStats.spills += _sorter->stats().spilledRanges();
+    _specificStats.spilledDataStorageSize = _sorterFileStats->bytesSpilled.load();
+    _specificStats.spilledUncompressedDataSize = _sorterFileStats->bytesSpilledUncompressed.load();
     _specificStats.keysSorted += _sorter->numSorted();
     auto& metricsCollector = ResourceConsumption::MetricsCollector::get(_opCtx);
     metricsCollector.incrementKeysSorted(_sorter->numSorted());
@@ -254,6 +258,10 @@ std::unique_ptr<PlanStageStats> SortStage::getStats(bool includeDebugInfo) const
                          static_cast<long long>(_specificStats.totalDataSizeBytes));
         bob.appendBool("usedDisk", _specificStats.spills > 0);
         bob.appendNumber("spills", static_cast<long long>(_specificStats.spills));
+        bob.appendNumber("spilledDataStorageSize",
+                         static_cast<long long>(_specificStats.spilledDataStorageSize));
+        bob.appendNumber("spilledUncompressedDataSize",
+                         static_cast<long long>(_specificStats.spilledUncompressedDataSize));
 
         BSONObjBuilder childrenBob(bob.subobjStart("orderBySlots"));
         for (size_t idx = 0; idx < _obs.size(); ++idx) {
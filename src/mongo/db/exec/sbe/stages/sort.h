@@ -36,6 +36,7 @@ template <typename Key, typename Value>
 class SortIteratorInterface;
 template <typename Key, typename Value>
 class Sorter;
+class SorterFileStats;
 }  // namespace mongo
 
 namespace mongo::sbe {
@@ -109,6 +110,10 @@ private:
 
     value::SlotMap<std::unique_ptr<value::SlotAccessor>> _outAccessors;
 
+    // Tracks the amount of data the sorter writes to disk, across all of the opens of this stage.
+    // Declared ahead of the sorter and its iterator, whose files update it until destroyed.
+    std::unique_ptr<SorterFileStats> _sorterFileStats;
+
     std::unique_ptr<SorterIterator> _mergeIt;
     SorterData _mergeData;
     SorterData* _mergeDataIt{&_mergeData};
@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <time.h>
+
 #include "mongo/config.h"
 #include "mongo/db/exec/sbe/stages/plan_stats.h"
 #include "mongo/db/exec/sbe/util/debug_print.h"
@@ -363,6 +365,20 @@ public:
         }
     }
 
+    /**
+     * Force this stage to also collect the thread CPU time spent in its execution. Reading the
+     * thread CPU clock costs a system call on every call into the stage, so this is reserved for
+     * explain. Must be called along with markShouldCollectTimingInfo(), before execution starts.
+     */
+    void markShouldCollectCpuTime() {
+        _commonStats.cpuTimeNanos.emplace(0);
+
+        auto stage = static_cast<T*>(this);
+        for (auto&& child : stage->_children) {
+            child->markShouldCollectCpuTime();
+        }
+    }
+
     void disableSlotAccess(bool recursive = false) {
         auto stage = static_cast<T*>(this);
         stage->_slotsAccessible = false;
@@ -399,14 +415,63 @@ protected:
         return _slotsAccessible;
     }
 
+    /**
+     * Returns the CPU time consumed so far by the calling thread, or zero on platforms where it
+     * cannot be measured.
+     */
+    static long long threadCpuTimeNanos() {
+#if defined(__linux__)
+        struct timespec t;
+        if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &t) == 0) {
+            return t.tv_sec * 1'000'000'000LL + t.tv_nsec;
+        }
+#endif
+        return 0;
+    }
+
+    /**
+     * Collects the time spent executing the current stage, and the number of SBE values allocated
+     * meanwhile, when it goes out of scope. Also collects the thread CPU time spent, if
+     * 'cpuTimeCounter' is not null.
+     */
+    class ScopedStageTimer {
+    public:
+        ScopedStageTimer(ClockSource* cs,
+                         long long* timeCounter,
+                         size_t* allocationCounter,
+                         long long* cpuTimeCounter)
+            : _timer(cs, timeCounter),
+              _allocationCounter(allocationCounter),
+              _allocationsAtStart(value::threadValueAllocations()),
+              _cpuTimeCounter(cpuTimeCounter),
+              _cpuTimeAtStart(cpuTimeCounter ? threadCpuTimeNanos() : 0) {}
+        ScopedStageTimer(ScopedStageTimer&& other) = default;
+
+        ~ScopedStageTimer() {
+            *_allocationCounter += value::threadValueAllocations() - _allocationsAtStart;
+            if (_cpuTimeCounter) {
+                *_cpuTimeCounter += threadCpuTimeNanos() - _cpuTimeAtStart;
+            }
+        }
+
+    private:
+        ScopedTimer _timer;
+        size_t* _allocationCounter;
+        const uint64_t _allocationsAtStart;
+        long long* _cpuTimeCounter;
+        const long long _cpuTimeAtStart;
+    };
+
     /**
      * Returns an optional timer which is used to collect time spent executing the current stage.
      * May return boost::none if it is not necessary to collect timing info.
      */
-    boost::optional<ScopedTimer> getOptTimer(OperationContext* opCtx) {
+    boost::optional<ScopedStageTimer> getOptTimer(OperationContext* opCtx) {
         if (_commonStats.executionTimeMillis && opCtx) {
             return {{opCtx->getServiceContext()->getFastClockSource(),
-                     _commonStats.executionTimeMillis.get_ptr()}};
+                     _commonStats.executionTimeMillis.get_ptr(),
+                     &_commonStats.valueAllocations,
+                     _commonStats.cpuTimeNanos.get_ptr()}};
         }
 
         return boost::none;
@@ -0,0 +1,253 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/sbe/stages/ts_bucket_to_block.h"
+
+#include "mongo/base/parse_number.h"
+#include "mongo/bson/util/bsoncolumn.h"
+#include "mongo/db/exec/sbe/size_estimator.h"
+#include "mongo/db/exec/sbe/values/block_interface.h"
+#include "mongo/db/exec/sbe/values/bson.h"
+#include "mongo/db/timeseries/timeseries_constants.h"
+#include "mongo/util/str.h"
+
+namespace mongo::sbe {
+namespace {
+/**
+ * Returns the number of measurements in a bucket given its time column.
+ */
+size_t countMeasurements(const BSONElement& timeColumn) {
+    if (timeColumn.type() == BSONType::BinData) {
+        return BSONColumn(timeColumn).size();
+    }
+    uassert(7027401,
+            str::stream() << "time-series bucket is missing its '" << timeColumn.fieldName()
+                          << "' column",
+            timeColumn.type() == BSONType::Object);
+    return timeColumn.Obj().nFields();
+}
+
+/**
+ * Decodes a single 'data.<path>' column of a bucket holding 'count' measurements into a block.
+ */
+std::unique_ptr<value::ValueBlock> makeColumnBlock(const BSONElement& column, size_t count) {
+    auto block = std::make_unique<value::HeterogeneousBlock>();
+    block->reserve(count);
+
+    size_t pos = 0;
+    if (column.type() == BSONType::BinData) {
+        BSONColumn decoded(column);
+        for (auto it = decoded.begin(); it != decoded.end() && pos < count; ++it, ++pos) {
+            // Measurements which do not have the field are encoded as skipped (EOO) elements.
+            if (it->eoo()) {
+                block->push_back(value::TypeTags::Nothing, 0);
+            } else {
+                block->push_back(bson::convertFrom<false>(*it));
+            }
+        }
+    } else if (column.type() == BSONType::Object) {
+        // Uncompressed columns are objects keyed by the measurement's position in the bucket, with
+        // positions omitted for measurements which do not have the field.
+        for (auto&& elem : column.embeddedObject()) {
+            size_t idx = 0;
+            uassert(7027402,
+                    str::stream() << "invalid time-series bucket column key: "
+                                  << elem.fieldNameStringData(),
+                    NumberParser{}(elem.fieldNameStringData(), &idx).isOK() && idx >= pos &&
+                        idx < count);
+            for (; pos < idx; ++pos) {
+                block->push_back(value::TypeTags::Nothing, 0);
+            }
+            block->push_back(bson::convertFrom<false>(elem));
+            ++pos;
+        }
+    } else {
+        uassert(7027403,
+                str::stream() << "unexpected time-series bucket column type: " << column.type(),
+                column.eoo());
+    }
+
+    for (; pos < count; ++pos) {
+        block->push_back(value::TypeTags::Nothing, 0);
+    }
+    return block;
+}
+}  // namespace
+
+TsBucketToBlockStage::TsBucketToBlockStage(std::unique_ptr<PlanStage> input,
+                                           value::SlotId bucketSlot,
+                                           std::string timeField,
+                                           std::vector<std::string> paths,
+                                           value::SlotVector outSlots,
+                                           PlanNodeId planNodeId)
+    : PlanStage("tsbuckettoblock"_sd, planNodeId),
+      _bucketSlot(bucketSlot),
+      _timeField(std::move(timeField)),
+      _paths(std::move(paths)),
+      _outSlots(std::move(outSlots)) {
+    _children.emplace_back(std::move(input));
+
+    uassert(7027400,
+            str::stream() << "the number of paths and output slots must match: " << _paths.size()
+                          << " != " << _outSlots.size(),
+            _paths.size() == _outSlots.size());
+}
+
+std::unique_ptr<PlanStage> TsBucketToBlockStage::clone() const {
+    return std::make_unique<TsBucketToBlockStage>(
+        _children[0]->clone(), _bucketSlot, _timeField, _paths, _outSlots, _commonStats.nodeId);
+}
+
+void TsBucketToBlockStage::prepare(CompileCtx& ctx) {
+    _children[0]->prepare(ctx);
+
+    _bucketAccessor = _children[0]->getAccessor(ctx, _bucketSlot);
+    _outAccessors = std::vector<value::OwnedValueAccessor>(_outSlots.size());
+}
+
+value::SlotAccessor* TsBucketToBlockStage::getAccessor(CompileCtx& ctx, value::SlotId slot) {
+    for (size_t idx = 0; idx < _outSlots.size(); ++idx) {
+        if (_outSlots[idx] == slot) {
+            return &_outAccessors[idx];
+        }
+    }
+
+    return _children[0]->getAccessor(ctx, slot);
+}
+
+void TsBucketToBlockStage::open(bool reOpen) {
+    auto optTimer(getOptTimer(_opCtx));
+
+    _commonStats.opens++;
+    _children[0]->open(reOpen);
+}
+
+PlanState TsBucketToBlockStage::getNext() {
+    auto optTimer(getOptTimer(_opCtx));
+
+    while (true) {
+        // The blocks own copies of the values they were decoded from, so the child does not need to
+        // preserve the bucket across a yield.
+        disableSlotAccess();
+        if (_children[0]->getNext() != PlanState::ADVANCED) {
+            return trackPlanState(PlanState::IS_EOF);
+        }
+
+        auto [bucketTag, bucketVal] = _bucketAccessor->getViewOfValue();
+        uassert(7027404,
+                str::stream() << "expected a time-series bucket document, got: " << bucketTag,
+                bucketTag == value::TypeTags::bsonObject);
+        BSONObj bucket{value::bitcastTo<const char*>(bucketVal)};
+
+        auto dataElem = bucket[timeseries::kBucketDataFieldName];
+        uassert(7027405,
+                "time-series bucket is missing its data field",
+                dataElem.type() == BSONType::Object);
+        auto data = dataElem.embeddedObject();
+
+        auto count = countMeasurements(data[_timeField]);
+        if (count == 0) {
+            continue;
+        }
+
+        for (size_t idx = 0; idx < _paths.size(); ++idx) {
+            auto [tag, val] = value::makeValueBlock(makeColumnBlock(data[_paths[idx]], count));
+            _outAccessors[idx].reset(true, tag, val);
+        }
+        return trackPlanState(PlanState::ADVANCED);
+    }
+}
+
+void TsBucketToBlockStage::close() {
+    auto optTimer(getOptTimer(_opCtx));
+
+    trackClose();
+    _children[0]->close();
+}
+
+std::unique_ptr<PlanStageStats> TsBucketToBlockStage::getStats(bool includeDebugInfo) const {
+    auto ret = std::make_unique<PlanStageStats>(_commonStats);
+
+    if (includeDebugInfo) {
+        BSONObjBuilder bob;
+        bob.appendNumber("bucketSlot", static_cast<long long>(_bucketSlot));
+        bob.append("timeField", _timeField);
+        bob.append("paths", _paths);
+        bob.append("outputSlots", _outSlots.begin(), _outSlots.end());
+        ret->debugInfo = bob.obj();
+    }
+
+    ret->children.emplace_back(_children[0]->getStats(includeDebugInfo));
+    return ret;
+}
+
+const SpecificStats* TsBucketToBlockStage::getSpecificStats() const {
+    return nullptr;
+}
+
+std::vector<DebugPrinter::Block> TsBucketToBlockStage::debugPrint() const {
+    auto ret = PlanStage::debugPrint();
+
+    DebugPrinter::addIdentifier(ret, _bucketSlot);
+    ret.emplace_back(str::stream() << "\"" << _timeField << "\"");
+
+    ret.emplace_back(DebugPrinter::Block("[`"));
+    for (size_t idx = 0; idx < _outSlots.size(); ++idx) {
+        if (idx) {
+            ret.emplace_back(DebugPrinter::Block("`,"));
+        }
+        DebugPrinter::addIdentifier(ret, _outSlots[idx]);
+    }
+    ret.emplace_back(DebugPrinter::Block("`]"));
+
+    ret.emplace_back(DebugPrinter::Block("[`"));
+    for (size_t idx = 0; idx < _paths.size(); ++idx) {
+        if (idx) {
+            ret.emplace_back(DebugPrinter::Block("`,"));
+        }
+        ret.emplace_back(str::stream() << "\"" << _paths[idx] << "\"");
+    }
+    ret.emplace_back(DebugPrinter::Block("`]"));
+
+    DebugPrinter::addNewLine(ret);
+    DebugPrinter::addBlocks(ret, _children[0]->debugPrint());
+
+    return ret;
+}
+
+size_t TsBucketToBlockStage::estimateCompileTimeSize() const {
+    size_t size = sizeof(*this);
+    size += size_estimator::estimate(_children);
+    size += size_estimator::estimate(_paths);
+    size += size_estimator::estimate(_outSlots);
+    return size;
+}
+}  // namespace mongo::sbe
@@ -0,0 +1,82 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include "mongo/db/exec/sbe/stages/stages.h"
+
+namespace mongo::sbe {
+/**
+ * Unpacks time-series bucket documents column by column. For every bucket produced by the child in
+ * 'bucketSlot', this stage reads the 'data.<path>' column of each of 'paths' and makes it available
+ * as a block of values through the corresponding slot in 'outSlots'. Position i of every block
+ * holds the value of the i-th measurement of the bucket, or Nothing if that measurement does not
+ * have the field. The number of measurements is taken from the 'timeField' column.
+ *
+ * Both uncompressed (control.version 1) and compressed (control.version 2) buckets are supported.
+ * Fields which are not listed in 'paths' are never decoded, so combined with the 'valueBlock*'
+ * builtins and BlockToRowStage a plan can filter measurements column-wise and only materialize the
+ * projected fields of the qualifying rows.
+ *
+ * Debug string representation:
+ *
+ *   tsbuckettoblock bucketSlot timeField [outSlot_1, ..., outSlot_n] [path_1, ..., path_n] child
+ */
+class TsBucketToBlockStage final : public PlanStage {
+public:
+    TsBucketToBlockStage(std::unique_ptr<PlanStage> input,
+                         value::SlotId bucketSlot,
+                         std::string timeField,
+                         std::vector<std::string> paths,
+                         value::SlotVector outSlots,
+                         PlanNodeId planNodeId);
+
+    std::unique_ptr<PlanStage> clone() const final;
+
+    void prepare(CompileCtx& ctx) final;
+    value::SlotAccessor* getAccessor(CompileCtx& ctx, value::SlotId slot) final;
+    void open(bool reOpen) final;
+    PlanState getNext() final;
+    void close() final;
+
+    std::unique_ptr<PlanStageStats> getStats(bool includeDebugInfo) const final;
+    const SpecificStats* getSpecificStats() const final;
+    std::vector<DebugPrinter::Block> debugPrint() const final;
+    size_t estimateCompileTimeSize() const final;
+
+private:
+    const value::SlotId _bucketSlot;
+    const std::string _timeField;
+    const std::vector<std::string> _paths;
+    const value::SlotVector _outSlots;
+
+    value::SlotAccessor* _bucketAccessor{nullptr};
+    std::vector<value::OwnedValueAccessor> _outAccessors;
+};
+}  // namespace mongo::sbe
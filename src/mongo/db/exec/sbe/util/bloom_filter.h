@@ -0,0 +1,101 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include "mongo/platform/basic.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace mongo::sbe {
+
+/**
+ * A fixed-size Bloom filter over precomputed hashes of keys. mayContain() returns true for every
+ * hash that was inserted, and for about 1% of the others while the filter holds at most
+ * 'capacity()' keys. Inserting more keys raises the false positive rate but never the memory use.
+ * The bit positions are derived from the single hash by double hashing.
+ */
+class BloomFilter {
+public:
+    explicit BloomFilter(size_t sizeBytes)
+        : _words(std::max(sizeBytes / sizeof(uint64_t), size_t{1})), _numBits(_words.size() * 64) {}
+
+    void insert(size_t hash) {
+        const auto [h1, h2] = splitHash(hash);
+        for (size_t i = 0; i < kNumProbes; ++i) {
+            const auto bit = (h1 + i * h2) % _numBits;
+            _words[bit / 64] |= uint64_t{1} << (bit % 64);
+        }
+    }
+
+    bool mayContain(size_t hash) const {
+        const auto [h1, h2] = splitHash(hash);
+        for (size_t i = 0; i < kNumProbes; ++i) {
+            const auto bit = (h1 + i * h2) % _numBits;
+            if (!(_words[bit / 64] & (uint64_t{1} << (bit % 64)))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    size_t memUsageBytes() const {
+        return _words.size() * sizeof(uint64_t);
+    }
+
+    size_t capacity() const {
+        return _numBits / kBitsPerKey;
+    }
+
+private:
+    // 10 bits per key and 7 probes give a false positive rate of about 1%.
+    static constexpr size_t kBitsPerKey = 10;
+    static constexpr size_t kNumProbes = 7;
+
+    /**
+     * Derives the two hashes of the double hashing scheme from 'hash'. The second one is remixed,
+     * since callers may have used the low bits of 'hash' themselves, and made odd so that it is
+     * never zero.
+     */
+    static std::pair<uint64_t, uint64_t> splitHash(size_t hash) {
+        uint64_t h2 = hash;
+        h2 ^= h2 >> 33;
+        h2 *= 0xff51afd7ed558ccdULL;
+        h2 ^= h2 >> 33;
+        return {hash, h2 | 1};
+    }
+
+    std::vector<uint64_t> _words;
+    const size_t _numBits;
+};
+
+}  // namespace mongo::sbe
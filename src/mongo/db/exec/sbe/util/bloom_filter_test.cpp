@@ -0,0 +1,116 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <absl/hash/hash.h>
+
+#include "mongo/db/exec/sbe/util/bloom_filter.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo::sbe {
+namespace {
+
+size_t hashOf(int key) {
+    return absl::Hash<int>{}(key);
+}
+
+TEST(BloomFilterTest, SizeIsRoundedDownToWholeWords) {
+    BloomFilter filter(100);
+    ASSERT_EQ(filter.memUsageBytes(), 96U);
+    ASSERT_EQ(filter.capacity(), 96U * 8 / 10);
+}
+
+TEST(BloomFilterTest, TooSmallSizeStillAllocatesOneWord) {
+    BloomFilter filter(0);
+    ASSERT_EQ(filter.memUsageBytes(), sizeof(uint64_t));
+    ASSERT_EQ(filter.capacity(), 6U);
+
+    filter.insert(hashOf(1));
+    ASSERT_TRUE(filter.mayContain(hashOf(1)));
+}
+
+TEST(BloomFilterTest, MemoryUseDoesNotGrowWithInserts) {
+    BloomFilter filter(1024);
+    for (int i = 0; i < 100'000; ++i) {
+        filter.insert(hashOf(i));
+    }
+    ASSERT_EQ(filter.memUsageBytes(), 1024U);
+}
+
+TEST(BloomFilterTest, NoFalseNegatives) {
+    BloomFilter filter(16 * 1024);
+    const int numKeys = static_cast<int>(filter.capacity());
+    for (int i = 0; i < numKeys; ++i) {
+        filter.insert(hashOf(i));
+    }
+    for (int i = 0; i < numKeys; ++i) {
+        ASSERT_TRUE(filter.mayContain(hashOf(i))) << i;
+    }
+}
+
+TEST(BloomFilterTest, NoFalseNegativesWhenOverCapacity) {
+    BloomFilter filter(64);
+    const int numKeys = static_cast<int>(filter.capacity()) * 20;
+    for (int i = 0; i < numKeys; ++i) {
+        filter.insert(hashOf(i));
+    }
+    for (int i = 0; i < numKeys; ++i) {
+        ASSERT_TRUE(filter.mayContain(hashOf(i))) << i;
+    }
+}
+
+TEST(BloomFilterTest, FalsePositiveRateAtCapacity) {
+    BloomFilter filter(16 * 1024);
+    const int numKeys = static_cast<int>(filter.capacity());
+    for (int i = 0; i < numKeys; ++i) {
+        filter.insert(hashOf(i));
+    }
+
+    // The filter is sized for a rate of about 1%; allow some slack so the test is not sensitive
+    // to the particular hash function.
+    const int numProbes = 100'000;
+    int falsePositives = 0;
+    for (int i = numKeys; i < numKeys + numProbes; ++i) {
+        if (filter.mayContain(hashOf(i))) {
+            ++falsePositives;
+        }
+    }
+    ASSERT_LT(falsePositives, numProbes * 3 / 100);
+}
+
+TEST(BloomFilterTest, EmptyFilterContainsNothing) {
+    BloomFilter filter(1024);
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_FALSE(filter.mayContain(hashOf(i))) << i;
+    }
+}
+
+}  // namespace
+}  // namespace mongo::sbe
@@ -127,5 +127,18 @@ int upsertToRecordStore(OperationContext* opCtx,
     buf.appendBuf(typeBits.getBuffer(), typeBits.getSize());
     return upsertToRecordStore(opCtx, rs, key, buf, update);
 }
+
+void insertRecordsToRecordStore(OperationContext* opCtx,
+                                RecordStore* rs,
+                                std::vector<Record>* records) {
+    assertIgnorePrepareConflictsBehavior(opCtx);
+
+    WriteUnitOfWork wuow(opCtx);
+    auto status = rs->insertRecords(opCtx, records, std::vector<Timestamp>(records->size()));
+    wuow.commit();
+    tassert(7000106,
+            str::stream() << "Failed to write to disk because " << status.reason(),
+            status.isOK());
+}
 }  // namespace sbe
 }  // namespace mongo
@@ -85,5 +85,15 @@ int upsertToRecordStore(OperationContext* opCtx,
                         BufBuilder& buf,
                         const KeyString::TypeBits& typeBits,  // recover type of value.
                         bool update);
+
+/**
+ * Inserts a batch of new records into 'rs' within a single WriteUnitOfWork. Callers should pass the
+ * records ordered by record id, so that the storage engine fills its pages sequentially instead of
+ * seeking to a random position for every record. This function will tassert if any of the records
+ * already exists.
+ */
+void insertRecordsToRecordStore(OperationContext* opCtx,
+                                RecordStore* rs,
+                                std::vector<Record>* records);
 }  // namespace sbe
 }  // namespace mongo
@@ -0,0 +1,187 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "mongo/db/exec/sbe/values/value.h"
+
+namespace mongo::sbe::value {
+/**
+ * A non-owning view of the values stored in a ValueBlock, in the form of two parallel arrays of
+ * tags and values. The view is valid for as long as the block it was extracted from is alive and
+ * unmodified.
+ */
+struct DeblockedTagVals {
+    DeblockedTagVals(size_t count, const TypeTags* tags, const Value* vals)
+        : count(count), tags(tags), vals(vals) {}
+
+    std::pair<TypeTags, Value> operator[](size_t idx) const {
+        return {tags[idx], vals[idx]};
+    }
+
+    size_t count;
+    const TypeTags* tags;
+    const Value* vals;
+};
+
+/**
+ * Interface for a block of values which can be stored in a single slot, so that plan stages can
+ * hand a whole column of up to N values to their parent at once and the VM can evaluate block
+ * builtins ('valueBlock*') over all of them in a single call.
+ *
+ * A block is owned by whoever holds the 'valueBlock' tagged value pointing to it, like any other
+ * deep SBE value: 'releaseValue()' deletes it and 'copyValue()' clones it.
+ */
+class ValueBlock {
+public:
+    ValueBlock() = default;
+    ValueBlock(const ValueBlock&) = default;
+    ValueBlock& operator=(const ValueBlock&) = delete;
+    virtual ~ValueBlock() = default;
+
+    virtual std::unique_ptr<ValueBlock> clone() const = 0;
+
+    /**
+     * Returns the number of values in the block.
+     */
+    virtual size_t count() = 0;
+
+    /**
+     * Returns a view of the values in the block. The block retains ownership of the values.
+     */
+    virtual DeblockedTagVals extract() = 0;
+};
+
+/**
+ * A block which holds 'count' copies of the same value. This is the natural representation of a
+ * scalar (for example a constant) used as an input to a block operation. The values are only
+ * materialized when 'extract()' is called.
+ */
+class MonoBlock final : public ValueBlock {
+public:
+    /**
+     * Takes ownership of 'val'.
+     */
+    MonoBlock(size_t count, TypeTags tag, Value val) : _count(count), _tag(tag), _val(val) {}
+
+    MonoBlock(const MonoBlock& other) : ValueBlock(other), _count(other._count) {
+        std::tie(_tag, _val) = copyValue(other._tag, other._val);
+    }
+
+    ~MonoBlock() override {
+        releaseValue(_tag, _val);
+    }
+
+    std::unique_ptr<ValueBlock> clone() const override {
+        return std::make_unique<MonoBlock>(*this);
+    }
+
+    size_t count() override {
+        return _count;
+    }
+
+    DeblockedTagVals extract() override;
+
+    std::pair<TypeTags, Value> getValue() const {
+        return {_tag, _val};
+    }
+
+private:
+    size_t _count;
+    TypeTags _tag;
+    Value _val;
+
+    // Lazily materialized views of '_val', populated by 'extract()'.
+    std::vector<TypeTags> _tags;
+    std::vector<Value> _vals;
+};
+
+/**
+ * A block of materialized values, each of which may have a different type. The block owns all
+ * the values it contains.
+ */
+class HeterogeneousBlock final : public ValueBlock {
+public:
+    HeterogeneousBlock() = default;
+
+    /**
+     * Takes ownership of all the values in 'tags'/'vals'.
+     */
+    HeterogeneousBlock(std::vector<TypeTags> tags, std::vector<Value> vals)
+        : _tags(std::move(tags)), _vals(std::move(vals)) {
+        invariant(_tags.size() == _vals.size());
+    }
+
+    HeterogeneousBlock(const HeterogeneousBlock& other);
+
+    ~HeterogeneousBlock() override;
+
+    std::unique_ptr<ValueBlock> clone() const override {
+        return std::make_unique<HeterogeneousBlock>(*this);
+    }
+
+    size_t count() override {
+        return _tags.size();
+    }
+
+    DeblockedTagVals extract() override {
+        return {_tags.size(), _tags.data(), _vals.data()};
+    }
+
+    void reserve(size_t n) {
+        _tags.reserve(n);
+        _vals.reserve(n);
+    }
+
+    /**
+     * Appends a value to the block, taking ownership of it.
+     */
+    void push_back(TypeTags tag, Value val) {
+        ValueGuard guard{tag, val};
+        _tags.push_back(tag);
+        _vals.push_back(val);
+        guard.reset();
+    }
+
+    void push_back(std::pair<TypeTags, Value> tv) {
+        push_back(tv.first, tv.second);
+    }
+
+private:
+    std::vector<TypeTags> _tags;
+    std::vector<Value> _vals;
+};
+
+inline std::pair<TypeTags, Value> makeValueBlock(std::unique_ptr<ValueBlock> block) {
+    return {TypeTags::valueBlock, bitcastFrom<ValueBlock*>(block.release())};
+}
+}  // namespace mongo::sbe::value
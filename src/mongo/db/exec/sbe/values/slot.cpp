@@ -35,6 +35,7 @@
 #include "mongo/bson/util/builder.h"
 #include "mongo/db/exec/js_function.h"
 #include "mongo/db/exec/sbe/size_estimator.h"
+#include "mongo/db/exec/sbe/values/block_interface.h"
 #include "mongo/db/exec/sbe/values/bson.h"
 #include "mongo/db/exec/sbe/values/sort_spec.h"
 #include "mongo/db/exec/sbe/values/value_builder.h"
@@ -758,6 +759,13 @@ int getApproximateSize(TypeTags tag, Value val) {
         case TypeTags::indexBounds:
             result += size_estimator::estimate(*getIndexBoundsView(val));
             break;
+        case TypeTags::valueBlock: {
+            auto block = getValueBlock(val)->extract();
+            for (size_t i = 0; i < block.count; ++i) {
+                result += getApproximateSize(block.tags[i], block.vals[i]);
+            }
+            break;
+        }
         default:
             MONGO_UNREACHABLE;
     }
@@ -33,6 +33,7 @@
 
 #include "mongo/base/compare_numbers.h"
 #include "mongo/db/exec/js_function.h"
+#include "mongo/db/exec/sbe/values/block_interface.h"
 #include "mongo/db/exec/sbe/values/bson.h"
 #include "mongo/db/exec/sbe/values/sort_spec.h"
 #include "mongo/db/exec/sbe/values/value_builder.h"
@@ -331,6 +332,9 @@ void releaseValue(TypeTags tag, Value val) noexcept {
         case TypeTags::classicMatchExpresion:
             delete getClassicMatchExpressionView(val);
             break;
+        case TypeTags::valueBlock:
+            delete getValueBlock(val);
+            break;
         default:
             break;
     }
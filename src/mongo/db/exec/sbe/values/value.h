@@ -76,6 +76,7 @@ using IndexKeysInclusionSet = std::bitset<Ordering::kMaxCompoundIndexKeys>;
 
 namespace value {
 class SortSpec;
+class ValueBlock;
 
 static constexpr size_t kNewUUIDLength = 16;
 
@@ -157,6 +158,9 @@ enum class TypeTags : uint8_t {
 
     // Pointer to a classic engine match expression.
     classicMatchExpresion,
+
+    // Pointer to a ValueBlock, holding a block of values for block-at-a-time processing.
+    valueBlock,
 };
 
 inline constexpr bool isNumber(TypeTags tag) noexcept {
@@ -640,12 +644,94 @@ template <typename T>
 using ValueMapType = DeepEqualityHashMap<std::pair<TypeTags, Value>, T, ValueHash, ValueEq>;
 using ValueSetType = DeepEqualityHashSet<std::pair<TypeTags, Value>, ValueHash, ValueEq>;
 
+/**
+ * Returns the counter of deep values (arrays, objects and big strings) allocated by the current
+ * thread. Plan stages sample it to report how many values were allocated while they executed.
+ */
+inline uint64_t& threadValueAllocations() {
+    static thread_local uint64_t allocations = 0;
+    return allocations;
+}
+
+/**
+ * A per-thread pool of fixed size memory blocks used for the headers of the deep values that are
+ * created and released at a very high rate while a plan executes, i.e. 'Object' and 'Array'.
+ * Recycling the blocks through a thread-local free list avoids a round trip to the global
+ * allocator for every value. The ownership semantics of the values don't change: a value is still
+ * released with 'delete', which returns its block to the free list of the releasing thread.
+ */
+template <typename T>
+class ValueBlockPool {
+public:
+    static void* allocate(size_t size) {
+        dassert(size == sizeof(T));
+        ++threadValueAllocations();
+
+        auto& freeList = getFreeList();
+        if (auto block = freeList.head) {
+            freeList.head = block->next;
+            --freeList.size;
+            return block;
+        }
+        return ::operator new(sizeof(Block));
+    }
+
+    static void deallocate(void* ptr) noexcept {
+        auto& freeList = getFreeList();
+        if (freeList.size < kMaxFreeBlocks) {
+            auto block = static_cast<Block*>(ptr);
+            block->next = freeList.head;
+            freeList.head = block;
+            ++freeList.size;
+        } else {
+            ::operator delete(ptr);
+        }
+    }
+
+private:
+    // Upper bound of the number of idle blocks kept by each thread.
+    static constexpr size_t kMaxFreeBlocks = 1024;
+
+    union Block {
+        Block* next;
+        alignas(T) char storage[sizeof(T)];
+    };
+
+    struct FreeList {
+        ~FreeList() {
+            while (head) {
+                auto next = head->next;
+                ::operator delete(head);
+                head = next;
+            }
+            // Values released by other thread-local destructors after this point go straight back
+            // to the global allocator.
+            size = kMaxFreeBlocks;
+        }
+
+        Block* head{nullptr};
+        size_t size{0};
+    };
+
+    static FreeList& getFreeList() {
+        static thread_local FreeList freeList;
+        return freeList;
+    }
+};
+
 /**
  * This is the SBE representation of objects/documents. It is a relatively simple structure of
  * vectors of field names, type tags, and values.
  */
 class Object {
 public:
+    static void* operator new(size_t size) {
+        return ValueBlockPool<Object>::allocate(size);
+    }
+    static void operator delete(void* ptr) noexcept {
+        ValueBlockPool<Object>::deallocate(ptr);
+    }
+
     Object() = default;
     Object(const Object& other) {
         // Reserve space in all vectors, they are the same size. We arbitrarily picked _typeTags
@@ -741,6 +827,13 @@ private:
  */
 class Array {
 public:
+    static void* operator new(size_t size) {
+        return ValueBlockPool<Array>::allocate(size);
+    }
+    static void operator delete(void* ptr) noexcept {
+        ValueBlockPool<Array>::deallocate(ptr);
+    }
+
     Array() = default;
     Array(const Array& other) {
         // Reserve space in all vectors, they are the same size. We arbitrarily picked _typeTags
@@ -791,6 +884,16 @@ public:
         return {_typeTags[idx], _values[idx]};
     }
 
+    // Direct access to the tags and values, for kernels which process all the elements of an
+    // array at once. The pointers are invalidated by any modification of the array.
+    const TypeTags* tagsData() const noexcept {
+        return _typeTags.data();
+    }
+
+    const Value* valuesData() const noexcept {
+        return _values.data();
+    }
+
     // The in-place update of arrays is allowed only in very limited set of contexts (e.g. when
     // arrays are used in an accumulator slot). The owner of the array must guarantee that no other
     // component can observe the value being updated.
@@ -1132,6 +1235,7 @@ inline std::pair<TypeTags, Value> makeBigString(StringData input) {
 
     auto length = static_cast<uint32_t>(len);
     auto buf = new char[length + 5];
+    ++threadValueAllocations();
     DataView(buf).write<LittleEndian<int32_t>>(length + 1);
     memcpy(buf + 4, ptr, length);
     buf[length + 4] = 0;
@@ -1259,6 +1363,10 @@ inline MatchExpression* getClassicMatchExpressionView(Value val) noexcept {
     return reinterpret_cast<MatchExpression*>(val);
 }
 
+inline ValueBlock* getValueBlock(Value val) noexcept {
+    return reinterpret_cast<ValueBlock*>(val);
+}
+
 /**
  * Pattern and flags of Regex are stored in BSON as two C strings written one after another.
  *
@@ -1381,6 +1489,8 @@ std::pair<TypeTags, Value> makeCopyCollator(const CollatorInterface& collator);
 
 std::pair<TypeTags, Value> makeCopyIndexBounds(const IndexBounds& collator);
 
+std::pair<TypeTags, Value> makeCopyValueBlock(const ValueBlock& block);
+
 /**
  * Releases memory allocated for the value. If the value does not have any memory allocated for it,
  * does nothing.
@@ -1466,6 +1576,8 @@ inline std::pair<TypeTags, Value> copyValue(TypeTags tag, Value val) {
             return {TypeTags::classicMatchExpresion,
                     bitcastFrom<const MatchExpression*>(
                         getClassicMatchExpressionView(val)->shallowClone().release())};
+        case TypeTags::valueBlock:
+            return makeCopyValueBlock(*getValueBlock(val));
         default:
             break;
     }
@@ -27,6 +27,7 @@
  *    it in the license file.
  */
 #include "mongo/db/exec/sbe/values/value_printer.h"
+#include "mongo/db/exec/sbe/values/block_interface.h"
 #include "mongo/db/exec/sbe/values/sort_spec.h"
 #include "mongo/db/exec/sbe/values/value.h"
 #include "mongo/platform/basic.h"
@@ -159,6 +160,9 @@ void ValuePrinter<T>::writeTagToStream(TypeTags tag) {
         case TypeTags::classicMatchExpresion:
             stream << "classicMatchExpression";
             break;
+        case TypeTags::valueBlock:
+            stream << "valueBlock";
+            break;
         default:
             stream << "unknown tag";
             break;
@@ -480,6 +484,18 @@ void ValuePrinter<T>::writeValueToStream(TypeTags tag, Value val, size_t depth)
         case TypeTags::classicMatchExpresion:
             stream << "ClassicMatcher(" << getClassicMatchExpressionView(val)->toString() << ")";
             break;
+        case TypeTags::valueBlock: {
+            auto block = getValueBlock(val)->extract();
+            stream << "ValueBlock([";
+            for (size_t i = 0; i < block.count; ++i) {
+                if (i > 0) {
+                    stream << ", ";
+                }
+                writeValueToStream(block.tags[i], block.vals[i]);
+            }
+            stream << "])";
+            break;
+        }
         default:
             MONGO_UNREACHABLE;
     }
@@ -301,4 +301,27 @@ TEST_F(SbeValueTest, CompareTwoValueMapTypes) {
     valueMapTypeInequalityComparisonTestGenFn(addMultipleDecimalKeyFn, addObjectKeyFn);
 }
 
+TEST_F(SbeValueTest, DeepValueHeadersAreRecycledAndCounted) {
+    auto allocationsBefore = value::threadValueAllocations();
+
+    auto [arrTag, arrVal] = value::makeNewArray();
+    auto arrPtr = value::getArrayView(arrVal);
+    value::releaseValue(arrTag, arrVal);
+
+    // The released block is handed out again to the next array allocated by this thread.
+    auto [arrTag2, arrVal2] = value::makeNewArray();
+    value::ValueGuard arrGuard{arrTag2, arrVal2};
+    ASSERT_EQ(value::getArrayView(arrVal2), arrPtr);
+
+    auto [objTag, objVal] = value::makeNewObject();
+    value::ValueGuard objGuard{objTag, objVal};
+    auto [strTag, strVal] = value::makeNewString("a string too long to be inlined");
+    value::ValueGuard strGuard{strTag, strVal};
+    auto [smallStrTag, smallStrVal] = value::makeNewString("small");
+    value::ValueGuard smallStrGuard{smallStrTag, smallStrVal};
+
+    // Small strings live inside the value itself and are not counted.
+    ASSERT_EQ(value::threadValueAllocations() - allocationsBefore, 4);
+}
+
 }  // namespace mongo::sbe
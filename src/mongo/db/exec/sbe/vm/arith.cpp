@@ -30,6 +30,7 @@
 #include "mongo/db/exec/sbe/vm/vm.h"
 
 #include "mongo/db/exec/sbe/accumulator_sum_value_enum.h"
+#include "mongo/db/exec/sbe/vm/array_kernels.h"
 #include "mongo/db/query/collation/collator_interface.h"
 #include "mongo/platform/overflow_arithmetic.h"
 #include "mongo/util/represent_as.h"
@@ -503,6 +504,51 @@ void ByteCode::aggDoubleDoubleSumImpl(value::Array* arr,
     }
 }
 
+void ByteCode::aggDoubleDoubleSumOfArrayImpl(value::Array* accumulator,
+                                             value::TypeTags rhsTag,
+                                             value::Value rhsValue) {
+    if (rhsTag != TypeTags::Array) {
+        aggDoubleDoubleSumImpl(accumulator, rhsTag, rhsValue);
+        return;
+    }
+
+    auto arr = value::getArrayView(rhsValue);
+    const size_t size = arr->size();
+    if (size == 0) {
+        return;
+    }
+
+    const auto* tags = arr->tagsData();
+    const auto* vals = arr->valuesData();
+    static_assert(sizeof(Value) == sizeof(int64_t) && sizeof(Value) == sizeof(double));
+
+    if (array_kernels::allOfType(tags, size, TypeTags::NumberInt64)) {
+        // The sum of the int64 values is exact unless it overflows, in which case we fall back to
+        // the DoubleDouble summation of every element.
+        if (auto sum = array_kernels::sumInt64(reinterpret_cast<const int64_t*>(vals), size)) {
+            aggDoubleDoubleSumImpl(
+                accumulator, TypeTags::NumberInt64, value::bitcastFrom<int64_t>(*sum));
+            return;
+        }
+    } else if (array_kernels::allOfType(tags, size, TypeTags::NumberDouble)) {
+        DoubleDoubleSummation partial;
+        if (array_kernels::sumDouble(reinterpret_cast<const double*>(vals), size, partial)) {
+            // Fold both halves of the partial DoubleDouble sum into the accumulator, as
+            // 'aggMergeDoubleDoubleSumsImpl()' does.
+            auto [sum, addend] = partial.getDoubleDouble();
+            aggDoubleDoubleSumImpl(
+                accumulator, TypeTags::NumberDouble, value::bitcastFrom<double>(sum));
+            aggDoubleDoubleSumImpl(
+                accumulator, TypeTags::NumberDouble, value::bitcastFrom<double>(addend));
+            return;
+        }
+    }
+
+    for (size_t idx = 0; idx < size; ++idx) {
+        aggDoubleDoubleSumImpl(accumulator, tags[idx], vals[idx]);
+    }
+}
+
 void ByteCode::aggMergeDoubleDoubleSumsImpl(value::Array* accumulator,
                                             value::TypeTags rhsTag,
                                             value::Value rhsValue) {
@@ -0,0 +1,437 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/sbe/vm/array_kernels.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "mongo/platform/overflow_arithmetic.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define MONGO_SBE_ARRAY_KERNELS_HAVE_AVX2
+#endif
+
+namespace mongo::sbe::vm::array_kernels {
+namespace {
+// Number of independent accumulators used by the kernels. Four 64-bit lanes fill an AVX2
+// register, and two NEON or SSE2 registers.
+constexpr size_t kLanes = 4;
+
+/**
+ * Folds the per-lane int64 partial sums into a single sum, checking for overflow.
+ */
+boost::optional<int64_t> combineInt64Lanes(const int64_t* lanes,
+                                           const int64_t* tail,
+                                           size_t tailCount) {
+    int64_t result = 0;
+    for (size_t l = 0; l < kLanes; ++l) {
+        if (overflow::add(result, lanes[l], &result)) {
+            return boost::none;
+        }
+    }
+    for (size_t i = 0; i < tailCount; ++i) {
+        if (overflow::add(result, tail[i], &result)) {
+            return boost::none;
+        }
+    }
+    return result;
+}
+
+/**
+ * Adds 'x' to the compensated sum 's' + 'c' using the 2Sum algorithm, which is exact as long as
+ * no operation overflows.
+ */
+inline void twoSum(double& s, double& c, double x) {
+    double t = s + x;
+    double bp = t - s;
+    c += (s - (t - bp)) + (x - bp);
+    s = t;
+}
+
+/**
+ * Folds the per-lane compensated sums and the values in 'tail' into 'sum'. Returns false if any
+ * of the intermediate results is not finite.
+ */
+bool combineDoubleLanes(double* s,
+                        double* c,
+                        const double* tail,
+                        size_t tailCount,
+                        DoubleDoubleSummation& sum) {
+    for (size_t i = 0; i < tailCount; ++i) {
+        twoSum(s[0], c[0], tail[i]);
+    }
+    for (size_t l = 0; l < kLanes; ++l) {
+        if (!std::isfinite(s[l]) || !std::isfinite(c[l])) {
+            return false;
+        }
+    }
+
+    for (size_t l = 0; l < kLanes; ++l) {
+        sum.addDouble(s[l]);
+        sum.addDouble(c[l]);
+    }
+    return true;
+}
+
+/**
+ * The relative order of equal values in the input determines which of them an aggregate min or
+ * max returns. For doubles the only equal values which can be told apart are the signed zeros, so
+ * the kernels decline to produce a zero result and leave that case to the generic path.
+ */
+boost::optional<double> checkDoubleMinMax(double result, bool sawNaN) {
+    if (sawNaN || result == 0.0) {
+        return boost::none;
+    }
+    return result;
+}
+
+namespace portable {
+bool allOfType(const value::TypeTags* tags, size_t count, value::TypeTags tag) {
+    // Check the tags in fixed size chunks without an early exit, so the inner loop vectorizes.
+    constexpr size_t kChunk = 64;
+    size_t i = 0;
+    for (; i + kChunk <= count; i += kChunk) {
+        uint8_t mismatch = 0;
+        for (size_t j = 0; j < kChunk; ++j) {
+            mismatch |= tags[i + j] != tag;
+        }
+        if (mismatch) {
+            return false;
+        }
+    }
+    for (; i < count; ++i) {
+        if (tags[i] != tag) {
+            return false;
+        }
+    }
+    return true;
+}
+
+boost::optional<int64_t> sumInt64(const int64_t* vals, size_t count) {
+    // Unsigned arithmetic wraps around, and the overflow of a signed add shows up in the sign bit
+    // of '(a ^ r) & (b ^ r)'.
+    uint64_t lanes[kLanes] = {};
+    uint64_t overflowBits = 0;
+    size_t i = 0;
+    for (; i + kLanes <= count; i += kLanes) {
+        for (size_t l = 0; l < kLanes; ++l) {
+            uint64_t x = static_cast<uint64_t>(vals[i + l]);
+            uint64_t r = lanes[l] + x;
+            overflowBits |= (lanes[l] ^ r) & (x ^ r);
+            lanes[l] = r;
+        }
+    }
+    if (overflowBits >> 63) {
+        return boost::none;
+    }
+
+    int64_t signedLanes[kLanes];
+    for (size_t l = 0; l < kLanes; ++l) {
+        signedLanes[l] = static_cast<int64_t>(lanes[l]);
+    }
+    return combineInt64Lanes(signedLanes, vals + i, count - i);
+}
+
+bool sumDouble(const double* vals, size_t count, DoubleDoubleSummation& sum) {
+    double s[kLanes] = {};
+    double c[kLanes] = {};
+    size_t i = 0;
+    for (; i + kLanes <= count; i += kLanes) {
+        for (size_t l = 0; l < kLanes; ++l) {
+            twoSum(s[l], c[l], vals[i + l]);
+        }
+    }
+    return combineDoubleLanes(s, c, vals + i, count - i, sum);
+}
+
+template <typename T, bool IsMin>
+T minMax(const T* vals, size_t count, bool& sawNaN) {
+    T lanes[kLanes];
+    std::fill(lanes, lanes + kLanes, vals[0]);
+    bool nan = false;
+    size_t i = 0;
+    for (; i + kLanes <= count; i += kLanes) {
+        for (size_t l = 0; l < kLanes; ++l) {
+            T x = vals[i + l];
+            if constexpr (std::is_floating_point_v<T>) {
+                nan |= x != x;
+            }
+            lanes[l] = (IsMin ? x < lanes[l] : x > lanes[l]) ? x : lanes[l];
+        }
+    }
+    for (; i < count; ++i) {
+        T x = vals[i];
+        if constexpr (std::is_floating_point_v<T>) {
+            nan |= x != x;
+        }
+        lanes[0] = (IsMin ? x < lanes[0] : x > lanes[0]) ? x : lanes[0];
+    }
+
+    sawNaN = nan;
+    return IsMin ? *std::min_element(lanes, lanes + kLanes)
+                 : *std::max_element(lanes, lanes + kLanes);
+}
+
+int64_t minInt64(const int64_t* vals, size_t count) {
+    bool sawNaN;
+    return minMax<int64_t, true>(vals, count, sawNaN);
+}
+
+int64_t maxInt64(const int64_t* vals, size_t count) {
+    bool sawNaN;
+    return minMax<int64_t, false>(vals, count, sawNaN);
+}
+
+boost::optional<double> minDouble(const double* vals, size_t count) {
+    bool sawNaN;
+    auto result = minMax<double, true>(vals, count, sawNaN);
+    return checkDoubleMinMax(result, sawNaN);
+}
+
+boost::optional<double> maxDouble(const double* vals, size_t count) {
+    bool sawNaN;
+    auto result = minMax<double, false>(vals, count, sawNaN);
+    return checkDoubleMinMax(result, sawNaN);
+}
+}  // namespace portable
+
+#ifdef MONGO_SBE_ARRAY_KERNELS_HAVE_AVX2
+namespace avx2 {
+#define MONGO_SBE_AVX2 __attribute__((target("avx2")))
+
+MONGO_SBE_AVX2 bool allOfType(const value::TypeTags* tags, size_t count, value::TypeTags tag) {
+    static_assert(sizeof(value::TypeTags) == 1);
+    const auto* bytes = reinterpret_cast<const char*>(tags);
+    const __m256i needle = _mm256_set1_epi8(static_cast<char>(tag));
+    size_t i = 0;
+    for (; i + 32 <= count; i += 32) {
+        auto chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes + i));
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, needle)) != -1) {
+            return false;
+        }
+    }
+    return portable::allOfType(tags + i, count - i, tag);
+}
+
+MONGO_SBE_AVX2 boost::optional<int64_t> sumInt64(const int64_t* vals, size_t count) {
+    __m256i acc = _mm256_setzero_si256();
+    __m256i overflowBits = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + kLanes <= count; i += kLanes) {
+        auto x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(vals + i));
+        auto r = _mm256_add_epi64(acc, x);
+        overflowBits = _mm256_or_si256(
+            overflowBits,
+            _mm256_and_si256(_mm256_xor_si256(acc, r), _mm256_xor_si256(x, r)));
+        acc = r;
+    }
+    if (_mm256_movemask_pd(_mm256_castsi256_pd(overflowBits)) != 0) {
+        return boost::none;
+    }
+
+    alignas(32) int64_t lanes[kLanes];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    return combineInt64Lanes(lanes, vals + i, count - i);
+}
+
+MONGO_SBE_AVX2 bool sumDouble(const double* vals, size_t count, DoubleDoubleSummation& sum) {
+    __m256d s = _mm256_setzero_pd();
+    __m256d c = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + kLanes <= count; i += kLanes) {
+        auto x = _mm256_loadu_pd(vals + i);
+        auto t = _mm256_add_pd(s, x);
+        auto bp = _mm256_sub_pd(t, s);
+        auto e = _mm256_add_pd(_mm256_sub_pd(s, _mm256_sub_pd(t, bp)), _mm256_sub_pd(x, bp));
+        c = _mm256_add_pd(c, e);
+        s = t;
+    }
+
+    alignas(32) double sLanes[kLanes];
+    alignas(32) double cLanes[kLanes];
+    _mm256_store_pd(sLanes, s);
+    _mm256_store_pd(cLanes, c);
+    return combineDoubleLanes(sLanes, cLanes, vals + i, count - i, sum);
+}
+
+template <bool IsMin>
+MONGO_SBE_AVX2 int64_t minMaxInt64(const int64_t* vals, size_t count) {
+    if (count < kLanes) {
+        return IsMin ? portable::minInt64(vals, count) : portable::maxInt64(vals, count);
+    }
+
+    __m256i acc = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(vals));
+    size_t i = kLanes;
+    for (; i + kLanes <= count; i += kLanes) {
+        auto x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(vals + i));
+        // Select 'x' in the lanes where it is a better candidate than the accumulator.
+        auto mask = IsMin ? _mm256_cmpgt_epi64(acc, x) : _mm256_cmpgt_epi64(x, acc);
+        acc = _mm256_blendv_epi8(acc, x, mask);
+    }
+
+    alignas(32) int64_t lanes[kLanes];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    int64_t result = IsMin ? *std::min_element(lanes, lanes + kLanes)
+                           : *std::max_element(lanes, lanes + kLanes);
+    for (; i < count; ++i) {
+        result = IsMin ? std::min(result, vals[i]) : std::max(result, vals[i]);
+    }
+    return result;
+}
+
+int64_t minInt64(const int64_t* vals, size_t count) {
+    return minMaxInt64<true>(vals, count);
+}
+
+int64_t maxInt64(const int64_t* vals, size_t count) {
+    return minMaxInt64<false>(vals, count);
+}
+
+template <bool IsMin>
+MONGO_SBE_AVX2 boost::optional<double> minMaxDouble(const double* vals, size_t count) {
+    if (count < kLanes) {
+        return IsMin ? portable::minDouble(vals, count) : portable::maxDouble(vals, count);
+    }
+
+    __m256d acc = _mm256_loadu_pd(vals);
+    __m256d nan = _mm256_cmp_pd(acc, acc, _CMP_UNORD_Q);
+    size_t i = kLanes;
+    for (; i + kLanes <= count; i += kLanes) {
+        auto x = _mm256_loadu_pd(vals + i);
+        nan = _mm256_or_pd(nan, _mm256_cmp_pd(x, x, _CMP_UNORD_Q));
+        acc = IsMin ? _mm256_min_pd(x, acc) : _mm256_max_pd(x, acc);
+    }
+
+    alignas(32) double lanes[kLanes];
+    _mm256_store_pd(lanes, acc);
+    bool sawNaN = _mm256_movemask_pd(nan) != 0;
+    double result = IsMin ? *std::min_element(lanes, lanes + kLanes)
+                          : *std::max_element(lanes, lanes + kLanes);
+    for (; i < count; ++i) {
+        sawNaN |= std::isnan(vals[i]);
+        result = IsMin ? std::min(result, vals[i]) : std::max(result, vals[i]);
+    }
+    return checkDoubleMinMax(result, sawNaN);
+}
+
+boost::optional<double> minDouble(const double* vals, size_t count) {
+    return minMaxDouble<true>(vals, count);
+}
+
+boost::optional<double> maxDouble(const double* vals, size_t count) {
+    return minMaxDouble<false>(vals, count);
+}
+
+#undef MONGO_SBE_AVX2
+}  // namespace avx2
+#endif
+
+/**
+ * The set of kernels selected for the CPU we are running on.
+ */
+struct Implementation {
+    StringData name;
+    bool (*allOfType)(const value::TypeTags*, size_t, value::TypeTags);
+    boost::optional<int64_t> (*sumInt64)(const int64_t*, size_t);
+    bool (*sumDouble)(const double*, size_t, DoubleDoubleSummation&);
+    int64_t (*minInt64)(const int64_t*, size_t);
+    int64_t (*maxInt64)(const int64_t*, size_t);
+    boost::optional<double> (*minDouble)(const double*, size_t);
+    boost::optional<double> (*maxDouble)(const double*, size_t);
+};
+
+Implementation selectImplementation() {
+#ifdef MONGO_SBE_ARRAY_KERNELS_HAVE_AVX2
+    if (__builtin_cpu_supports("avx2")) {
+        return {"avx2"_sd,
+                avx2::allOfType,
+                avx2::sumInt64,
+                avx2::sumDouble,
+                avx2::minInt64,
+                avx2::maxInt64,
+                avx2::minDouble,
+                avx2::maxDouble};
+    }
+#endif
+    return {"portable"_sd,
+            portable::allOfType,
+            portable::sumInt64,
+            portable::sumDouble,
+            portable::minInt64,
+            portable::maxInt64,
+            portable::minDouble,
+            portable::maxDouble};
+}
+
+const Implementation& implementation() {
+    static const Implementation kImplementation = selectImplementation();
+    return kImplementation;
+}
+}  // namespace
+
+bool allOfType(const value::TypeTags* tags, size_t count, value::TypeTags tag) {
+    return implementation().allOfType(tags, count, tag);
+}
+
+boost::optional<int64_t> sumInt64(const int64_t* vals, size_t count) {
+    return implementation().sumInt64(vals, count);
+}
+
+bool sumDouble(const double* vals, size_t count, DoubleDoubleSummation& sum) {
+    return implementation().sumDouble(vals, count, sum);
+}
+
+int64_t minInt64(const int64_t* vals, size_t count) {
+    invariant(count > 0);
+    return implementation().minInt64(vals, count);
+}
+
+int64_t maxInt64(const int64_t* vals, size_t count) {
+    invariant(count > 0);
+    return implementation().maxInt64(vals, count);
+}
+
+boost::optional<double> minDouble(const double* vals, size_t count) {
+    invariant(count > 0);
+    return implementation().minDouble(vals, count);
+}
+
+boost::optional<double> maxDouble(const double* vals, size_t count) {
+    invariant(count > 0);
+    return implementation().maxDouble(vals, count);
+}
+
+StringData implementationName() {
+    return implementation().name;
+}
+}  // namespace mongo::sbe::vm::array_kernels
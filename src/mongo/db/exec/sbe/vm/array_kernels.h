@@ -0,0 +1,86 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <cstddef>
+#include <cstdint>
+
+#include "mongo/db/exec/sbe/values/value.h"
+#include "mongo/util/summation.h"
+
+namespace mongo::sbe::vm::array_kernels {
+/**
+ * Kernels which evaluate an arithmetic or comparison operation over a contiguous run of values of
+ * a single numeric type, as found in an SBE 'Array' holding only NumberInt64 or only NumberDouble
+ * elements (for example a timeseries measurement array). They back the '*OfArray' aggregate
+ * builtins, which fall back to the per-element path when an array is not homogeneous or when a
+ * kernel reports that it can't produce an exact result.
+ *
+ * On x86-64 the AVX2 implementation is selected at startup when the CPU supports it. Otherwise a
+ * portable implementation with independent per-lane accumulators is used, which the compiler is
+ * able to vectorize for the baseline instruction set (SSE2 or NEON).
+ */
+
+/**
+ * Returns true if all of the 'count' tags in 'tags' are equal to 'tag'.
+ */
+bool allOfType(const value::TypeTags* tags, size_t count, value::TypeTags tag);
+
+/**
+ * Returns the sum of 'vals', or boost::none if the sum, or any partial sum, overflows int64.
+ */
+boost::optional<int64_t> sumInt64(const int64_t* vals, size_t count);
+
+/**
+ * Adds all of 'vals' to 'sum'. Returns false, without modifying 'sum', if any input or partial sum
+ * is not finite, in which case the caller must add the values one at a time to get the same
+ * special value semantics as DoubleDoubleSummation.
+ */
+bool sumDouble(const double* vals, size_t count, DoubleDoubleSummation& sum);
+
+/**
+ * Returns the minimum or maximum of 'vals', which must not be empty.
+ */
+int64_t minInt64(const int64_t* vals, size_t count);
+int64_t maxInt64(const int64_t* vals, size_t count);
+
+/**
+ * Returns the minimum or maximum of 'vals', which must not be empty, or boost::none if 'vals'
+ * contains a NaN, since NaN ordering is handled by the generic comparison path.
+ */
+boost::optional<double> minDouble(const double* vals, size_t count);
+boost::optional<double> maxDouble(const double* vals, size_t count);
+
+/**
+ * Returns the name of the implementation selected for this CPU, for logging and testing.
+ */
+StringData implementationName();
+}  // namespace mongo::sbe::vm::array_kernels
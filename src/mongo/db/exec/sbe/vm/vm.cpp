@@ -45,6 +45,7 @@
 #include "mongo/db/exec/sbe/values/sbe_pattern_value_cmp.h"
 #include "mongo/db/exec/sbe/values/sort_spec.h"
 #include "mongo/db/exec/sbe/values/value.h"
+#include "mongo/db/exec/sbe/vm/array_kernels.h"
 #include "mongo/db/exec/sbe/vm/datetime.h"
 #include "mongo/db/hasher.h"
 #include "mongo/db/index/btree_key_generator.h"
@@ -105,7 +106,9 @@ int Instruction::stackOffset[Instruction::Tags::lastInstruction] = {
     -2,  // collCmp3w
 
     -1,  // fillEmpty
+    0,   // fillEmptyImm
     -1,  // getField
+    0,   // getFieldImm
     -1,  // getElement
     -1,  // collComparisonKey
     -1,  // getFieldOrElement
@@ -285,6 +288,20 @@ std::string CodeFragment::toString() const {
                 ss << "tag: " << tag;
                 break;
             }
+            case Instruction::fillEmptyImm: {
+                auto k = readFromMemory<Instruction::Constants>(pcPointer);
+                pcPointer += sizeof(k);
+                ss << "k: " << Instruction::toStringConstants(k);
+                break;
+            }
+            case Instruction::getFieldImm: {
+                auto size = readFromMemory<uint8_t>(pcPointer);
+                pcPointer += sizeof(size);
+                StringData fieldName(reinterpret_cast<const char*>(pcPointer), size);
+                pcPointer += size;
+                ss << "fieldName: " << fieldName;
+                break;
+            }
             case Instruction::function:
             case Instruction::functionSmall: {
                 auto f = readFromMemory<Builtin>(pcPointer);
@@ -497,6 +514,32 @@ void CodeFragment::appendGetField() {
     appendSimpleInstruction(Instruction::getField);
 }
 
+void CodeFragment::appendGetField(StringData fieldName) {
+    invariant(fieldName.size() <= kMaxImmFieldNameSize);
+
+    Instruction i;
+    i.tag = Instruction::getFieldImm;
+    adjustStackSimple(i);
+
+    auto size = static_cast<uint8_t>(fieldName.size());
+    auto offset = allocateSpace(sizeof(Instruction) + sizeof(size) + size);
+
+    offset += writeToMemory(offset, i);
+    offset += writeToMemory(offset, size);
+    memcpy(offset, fieldName.rawData(), size);
+}
+
+void CodeFragment::appendFillEmpty(Instruction::Constants k) {
+    Instruction i;
+    i.tag = Instruction::fillEmptyImm;
+    adjustStackSimple(i);
+
+    auto offset = allocateSpace(sizeof(Instruction) + sizeof(k));
+
+    offset += writeToMemory(offset, i);
+    offset += writeToMemory(offset, k);
+}
+
 void CodeFragment::appendGetElement() {
     appendSimpleInstruction(Instruction::getElement);
 }
@@ -688,7 +731,12 @@ std::tuple<bool, value::TypeTags, value::Value> ByteCode::getField(value::TypeTa
     }
 
     auto fieldStr = value::getStringView(fieldTag, fieldValue);
+    return getField(objTag, objValue, fieldStr);
+}
 
+std::tuple<bool, value::TypeTags, value::Value> ByteCode::getField(value::TypeTags objTag,
+                                                                   value::Value objValue,
+                                                                   StringData fieldStr) {
     if (MONGO_unlikely(failOnPoisonedFieldLookup.shouldFail())) {
         uassert(4623399, "Lookup of $POISON", fieldStr != "POISON");
     }
@@ -1072,6 +1120,27 @@ std::tuple<bool, value::TypeTags, value::Value> ByteCode::aggSum(value::TypeTags
     return genericAdd(accTag, accValue, fieldTag, fieldValue);
 }
 
+namespace {
+/**
+ * Returns the initial accumulator state of the 'aggDoubleDoubleSum' family of builtins.
+ */
+std::pair<value::TypeTags, value::Value> makeDoubleDoubleSumState() {
+    auto [accTag, accValue] = value::makeNewArray();
+    value::ValueGuard newArrGuard{accTag, accValue};
+    auto arr = value::getArrayView(accValue);
+    arr->reserve(AggSumValueElems::kMaxSizeOfArray);
+
+    // The order of the following three elements should match to 'AggSumValueElems'. An absent
+    // 'kDecimalTotal' element means that we've not seen any decimal value. So, we're not adding
+    // 'kDecimalTotal' element yet.
+    arr->push_back(value::TypeTags::NumberInt32, value::bitcastFrom<int32_t>(0));
+    arr->push_back(value::TypeTags::NumberDouble, value::bitcastFrom<double>(0.0));
+    arr->push_back(value::TypeTags::NumberDouble, value::bitcastFrom<double>(0.0));
+    newArrGuard.reset();
+    return {accTag, accValue};
+}
+}  // namespace
+
 template <bool merging>
 std::tuple<bool, value::TypeTags, value::Value> ByteCode::builtinAggDoubleDoubleSum(
     ArityType arity) {
@@ -1082,18 +1151,7 @@ std::tuple<bool, value::TypeTags, value::Value> ByteCode::builtinAggDoubleDouble
 
     // Initialize the accumulator.
     if (accTag == value::TypeTags::Nothing) {
-        std::tie(accTag, accValue) = value::makeNewArray();
-        value::ValueGuard newArrGuard{accTag, accValue};
-        auto arr = value::getArrayView(accValue);
-        arr->reserve(AggSumValueElems::kMaxSizeOfArray);
-
-        // The order of the following three elements should match to 'AggSumValueElems'. An absent
-        // 'kDecimalTotal' element means that we've not seen any decimal value. So, we're not adding
-        // 'kDecimalTotal' element yet.
-        arr->push_back(value::TypeTags::NumberInt32, value::bitcastFrom<int32_t>(0));
-        arr->push_back(value::TypeTags::NumberDouble, value::bitcastFrom<double>(0.0));
-        arr->push_back(value::TypeTags::NumberDouble, value::bitcastFrom<double>(0.0));
-        newArrGuard.reset();
+        std::tie(accTag, accValue) = makeDoubleDoubleSumState();
     }
 
     value::ValueGuard guard{accTag, accValue};
@@ -1110,6 +1168,75 @@ std::tuple<bool, value::TypeTags, value::Value> ByteCode::builtinAggDoubleDouble
     return {true, accTag, accValue};
 }
 
+std::tuple<bool, value::TypeTags, value::Value> ByteCode::builtinAggDoubleDoubleSumOfArray(
+    ArityType arity) {
+    auto [_, fieldTag, fieldValue] = getFromStack(1);
+    auto [accTag, accValue] = moveOwnedFromStack(0);
+
+    if (accTag == value::TypeTags::Nothing) {
+        std::tie(accTag, accValue) = makeDoubleDoubleSumState();
+    }
+
+    value::ValueGuard guard{accTag, accValue};
+    tassert(7000105, "The result slot must be Array-typed", accTag == value::TypeTags::Array);
+    aggDoubleDoubleSumOfArrayImpl(value::getArrayView(accValue), fieldTag, fieldValue);
+
+    guard.reset();
+    return {true, accTag, accValue};
+}
+
+template <bool IsMin>
+std::tuple<bool, value::TypeTags, value::Value> ByteCode::builtinAggMinMaxOfArray(
+    ArityType arity) {
+    auto [accOwned, accTag, accValue] = getFromStack(0);
+    auto [fieldOwned, fieldTag, fieldValue] = getFromStack(1);
+
+    auto aggMinMax = [this, accTag = accTag, accValue = accValue](value::TypeTags tag,
+                                                                  value::Value val) {
+        return IsMin ? aggMin(accTag, accValue, tag, val) : aggMax(accTag, accValue, tag, val);
+    };
+
+    if (fieldTag != value::TypeTags::Array) {
+        return aggMinMax(fieldTag, fieldValue);
+    }
+
+    auto arr = value::getArrayView(fieldValue);
+    const size_t size = arr->size();
+    if (size == 0) {
+        return aggMinMax(value::TypeTags::Nothing, 0);
+    }
+
+    const auto* tags = arr->tagsData();
+    const auto* vals = arr->valuesData();
+    if (array_kernels::allOfType(tags, size, value::TypeTags::NumberInt64)) {
+        auto ints = reinterpret_cast<const int64_t*>(vals);
+        auto result = IsMin ? array_kernels::minInt64(ints, size)
+                            : array_kernels::maxInt64(ints, size);
+        return aggMinMax(value::TypeTags::NumberInt64, value::bitcastFrom<int64_t>(result));
+    }
+    if (array_kernels::allOfType(tags, size, value::TypeTags::NumberDouble)) {
+        auto doubles = reinterpret_cast<const double*>(vals);
+        auto result = IsMin ? array_kernels::minDouble(doubles, size)
+                            : array_kernels::maxDouble(doubles, size);
+        if (result) {
+            return aggMinMax(value::TypeTags::NumberDouble, value::bitcastFrom<double>(*result));
+        }
+    }
+
+    // Find the winning element without copying any of the intermediate results. As in 'aggMin()'
+    // and 'aggMax()', a later element wins over an earlier one which compares equal to it.
+    size_t best = 0;
+    for (size_t idx = 1; idx < size; ++idx) {
+        auto [cmpTag, cmpVal] = compare3way(tags[best], vals[best], tags[idx], vals[idx]);
+        bool keepBest = cmpTag == value::TypeTags::NumberInt32 &&
+            (IsMin ? value::bitcastTo<int>(cmpVal) < 0 : value::bitcastTo<int>(cmpVal) > 0);
+        if (!keepBest) {
+            best = idx;
+        }
+    }
+    return aggMinMax(tags[best], vals[best]);
+}
+
 // This function is necessary because 'aggDoubleDoubleSum()' result is 'Array' type but we need
 // to produce a scalar value out of it.
 //
@@ -4678,6 +4805,12 @@ std::tuple<bool, value::TypeTags, value::Value> ByteCode::dispatchBuiltin(Builti
             return builtinDoubleDoublePartialSumFinalize(arity);
         case Builtin::aggMergeDoubleDoubleSums:
             return builtinAggDoubleDoubleSum<true /*merging*/>(arity);
+        case Builtin::aggDoubleDoubleSumOfArray:
+            return builtinAggDoubleDoubleSumOfArray(arity);
+        case Builtin::aggMinOfArray:
+            return builtinAggMinMaxOfArray<true /*IsMin*/>(arity);
+        case Builtin::aggMaxOfArray:
+            return builtinAggMinMaxOfArray<false /*IsMin*/>(arity);
         case Builtin::aggStdDev:
             return builtinAggStdDev<false /*merging*/>(arity);
         case Builtin::aggMergeStdDevs:
@@ -4810,6 +4943,26 @@ std::tuple<bool, value::TypeTags, value::Value> ByteCode::dispatchBuiltin(Builti
             return builtinTsIncrement(arity);
         case Builtin::typeMatch:
             return builtinTypeMatch(arity);
+        case Builtin::valueBlockFillEmpty:
+            return builtinValueBlockFillEmpty(arity);
+        case Builtin::valueBlockGtScalar:
+            return builtinValueBlockCmpScalar<std::greater<>>(arity);
+        case Builtin::valueBlockGteScalar:
+            return builtinValueBlockCmpScalar<std::greater_equal<>>(arity);
+        case Builtin::valueBlockEqScalar:
+            return builtinValueBlockCmpScalar<std::equal_to<>>(arity);
+        case Builtin::valueBlockNeqScalar:
+            return builtinValueBlockCmpScalar<std::not_equal_to<>>(arity);
+        case Builtin::valueBlockLtScalar:
+            return builtinValueBlockCmpScalar<std::less<>>(arity);
+        case Builtin::valueBlockLteScalar:
+            return builtinValueBlockCmpScalar<std::less_equal<>>(arity);
+        case Builtin::valueBlockLogicalAnd:
+            return builtinValueBlockLogicalOp<true>(arity);
+        case Builtin::valueBlockLogicalOr:
+            return builtinValueBlockLogicalOp<false>(arity);
+        case Builtin::valueBlockCount:
+            return builtinValueBlockCount(arity);
     }
 
     MONGO_UNREACHABLE;
@@ -4850,10 +5003,123 @@ std::tuple<bool, value::TypeTags, value::Value> ByteCode::runLambdaInternal(
     return {retOwn, retTag, retVal};
 }
 
+/*
+ * The interpreter loop below is written in terms of the SBE_VM_CASE() and SBE_VM_NEXT() macros so
+ * that the same instruction bodies can be compiled either as a regular switch statement or, when
+ * the compiler supports the labels-as-values extension, as a direct-threaded interpreter. In the
+ * threaded form every instruction jumps straight to the handler of the next one through
+ * 'kDispatchTable', which gives the branch predictor a separate indirect branch per instruction
+ * instead of a single shared one. Define MONGO_SBE_VM_SWITCH_DISPATCH at build time to force the
+ * portable switch-based loop.
+ */
+#if defined(__GNUC__) && !defined(MONGO_SBE_VM_SWITCH_DISPATCH)
+#define MONGO_SBE_VM_THREADED_DISPATCH 1
+#else
+#define MONGO_SBE_VM_THREADED_DISPATCH 0
+#endif
+
+#if MONGO_SBE_VM_THREADED_DISPATCH
+#define SBE_VM_CASE(name)   \
+    case Instruction::name: \
+        lbl_##name:
+#define SBE_VM_NEXT()                                   \
+    do {                                                \
+        if (pcPointer == pcEnd) {                       \
+            return;                                     \
+        }                                               \
+        i = readFromMemory<Instruction>(pcPointer);     \
+        pcPointer += sizeof(i);                         \
+        dassert(i.tag < Instruction::lastInstruction);  \
+        goto* kDispatchTable[i.tag];                    \
+    } while (false)
+#else
+#define SBE_VM_CASE(name) case Instruction::name:
+#define SBE_VM_NEXT() break
+#endif
+
 void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
     auto pcPointer = code->instrs().data() + position;
     auto pcEnd = pcPointer + code->instrs().size();
 
+#if MONGO_SBE_VM_THREADED_DISPATCH
+    // Label addresses indexed by Instruction::Tags. This table must be kept in sync with the enum.
+    static const void* const kDispatchTable[] = {
+        &&lbl_pushConstVal,
+        &&lbl_pushAccessVal,
+        &&lbl_pushMoveVal,
+        &&lbl_pushLocalVal,
+        &&lbl_pushMoveLocalVal,
+        &&lbl_pushLocalLambda,
+        &&lbl_pop,
+        &&lbl_swap,
+        &&lbl_add,
+        &&lbl_sub,
+        &&lbl_mul,
+        &&lbl_div,
+        &&lbl_idiv,
+        &&lbl_mod,
+        &&lbl_negate,
+        &&lbl_numConvert,
+        &&lbl_logicNot,
+        &&lbl_less,
+        &&lbl_lessEq,
+        &&lbl_greater,
+        &&lbl_greaterEq,
+        &&lbl_eq,
+        &&lbl_neq,
+        &&lbl_cmp3w,
+        &&lbl_collLess,
+        &&lbl_collLessEq,
+        &&lbl_collGreater,
+        &&lbl_collGreaterEq,
+        &&lbl_collEq,
+        &&lbl_collNeq,
+        &&lbl_collCmp3w,
+        &&lbl_fillEmpty,
+        &&lbl_fillEmptyImm,
+        &&lbl_getField,
+        &&lbl_getFieldImm,
+        &&lbl_getElement,
+        &&lbl_collComparisonKey,
+        &&lbl_getFieldOrElement,
+        &&lbl_traverseP,
+        &&lbl_traverseF,
+        &&lbl_setField,
+        &&lbl_getArraySize,
+        &&lbl_aggSum,
+        &&lbl_aggMin,
+        &&lbl_aggMax,
+        &&lbl_aggFirst,
+        &&lbl_aggLast,
+        &&lbl_aggCollMin,
+        &&lbl_aggCollMax,
+        &&lbl_exists,
+        &&lbl_isNull,
+        &&lbl_isObject,
+        &&lbl_isArray,
+        &&lbl_isString,
+        &&lbl_isNumber,
+        &&lbl_isBinData,
+        &&lbl_isDate,
+        &&lbl_isNaN,
+        &&lbl_isInfinity,
+        &&lbl_isRecordId,
+        &&lbl_isMinKey,
+        &&lbl_isMaxKey,
+        &&lbl_isTimestamp,
+        &&lbl_function,
+        &&lbl_functionSmall,
+        &&lbl_jmp,
+        &&lbl_jmpTrue,
+        &&lbl_jmpNothing,
+        &&lbl_ret,
+        &&lbl_fail,
+        &&lbl_applyClassicMatcher,
+    };
+    static_assert(sizeof(kDispatchTable) / sizeof(kDispatchTable[0]) ==
+                  Instruction::Tags::lastInstruction);
+#endif
+
     for (;;) {
         if (pcPointer == pcEnd) {
             break;
@@ -4861,45 +5127,41 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
             Instruction i = readFromMemory<Instruction>(pcPointer);
             pcPointer += sizeof(i);
             switch (i.tag) {
-                case Instruction::pushConstVal: {
+                SBE_VM_CASE(pushConstVal) {
                     auto tag = readFromMemory<value::TypeTags>(pcPointer);
                     pcPointer += sizeof(tag);
                     auto val = readFromMemory<value::Value>(pcPointer);
                     pcPointer += sizeof(val);
 
                     pushStack(false, tag, val);
-
-                    break;
                 }
-                case Instruction::pushAccessVal: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(pushAccessVal) {
                     auto accessor = readFromMemory<value::SlotAccessor*>(pcPointer);
                     pcPointer += sizeof(accessor);
 
                     auto [tag, val] = accessor->getViewOfValue();
                     pushStack(false, tag, val);
-
-                    break;
                 }
-                case Instruction::pushMoveVal: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(pushMoveVal) {
                     auto accessor = readFromMemory<value::SlotAccessor*>(pcPointer);
                     pcPointer += sizeof(accessor);
 
                     auto [tag, val] = accessor->copyOrMoveValue();
                     pushStack(true, tag, val);
-
-                    break;
                 }
-                case Instruction::pushLocalVal: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(pushLocalVal) {
                     auto stackOffset = readFromMemory<int>(pcPointer);
                     pcPointer += sizeof(stackOffset);
 
                     auto [owned, tag, val] = getFromStack(stackOffset);
 
                     pushStack(false, tag, val);
-
-                    break;
                 }
-                case Instruction::pushMoveLocalVal: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(pushMoveLocalVal) {
                     auto stackOffset = readFromMemory<int>(pcPointer);
                     pcPointer += sizeof(stackOffset);
 
@@ -4907,10 +5169,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     setStack(stackOffset, false, value::TypeTags::Nothing, 0);
 
                     pushStack(owned, tag, val);
-
-                    break;
                 }
-                case Instruction::pushLocalLambda: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(pushLocalLambda) {
                     auto offset = readFromMemory<int>(pcPointer);
                     pcPointer += sizeof(offset);
                     auto newPosition = pcPointer - code->instrs().data() + offset;
@@ -4918,23 +5179,22 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     pushStack(false,
                               value::TypeTags::LocalLambda,
                               value::bitcastFrom<int64_t>(newPosition));
-                    break;
                 }
-                case Instruction::pop: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(pop) {
                     auto [owned, tag, val] = getFromStack(0);
                     popStack();
 
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-
-                    break;
                 }
-                case Instruction::swap: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(swap) {
                     swapStack();
-                    break;
                 }
-                case Instruction::add: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(add) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -4949,9 +5209,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
                 }
-                case Instruction::sub: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(sub) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -4966,9 +5226,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
                 }
-                case Instruction::mul: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(mul) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -4983,9 +5243,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
                 }
-                case Instruction::div: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(div) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -5000,9 +5260,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
                 }
-                case Instruction::idiv: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(idiv) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -5017,9 +5277,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
                 }
-                case Instruction::mod: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(mod) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -5034,9 +5294,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
                 }
-                case Instruction::negate: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(negate) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     auto [resultOwned, resultTag, resultVal] = genericSub(
@@ -5047,10 +5307,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (owned) {
                         value::releaseValue(resultTag, resultVal);
                     }
-
-                    break;
                 }
-                case Instruction::numConvert: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(numConvert) {
                     auto tag = readFromMemory<value::TypeTags>(pcPointer);
                     pcPointer += sizeof(tag);
 
@@ -5063,10 +5322,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (owned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-
-                    break;
                 }
-                case Instruction::logicNot: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(logicNot) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     auto [resultTag, resultVal] = genericNot(tag, val);
@@ -5076,9 +5334,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
                 }
-                case Instruction::less: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(less) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -5093,9 +5351,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
                 }
-                case Instruction::collLess: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(collLess) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -5116,9 +5374,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (collOwned) {
                         value::releaseValue(collTag, collVal);
                     }
-                    break;
                 }
-                case Instruction::lessEq: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(lessEq) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -5134,9 +5392,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
                 }
-                case Instruction::collLessEq: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(collLessEq) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -5157,9 +5415,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (collOwned) {
                         value::releaseValue(collTag, collVal);
                     }
-                    break;
                 }
-                case Instruction::greater: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(greater) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -5175,9 +5433,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
                 }
-                case Instruction::collGreater: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(collGreater) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -5198,9 +5456,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (collOwned) {
                         value::releaseValue(collTag, collVal);
                     }
-                    break;
                 }
-                case Instruction::greaterEq: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(greaterEq) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -5216,9 +5474,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
                 }
-                case Instruction::collGreaterEq: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(collGreaterEq) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -5239,9 +5497,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (collOwned) {
                         value::releaseValue(collTag, collVal);
                     }
-                    break;
                 }
-                case Instruction::eq: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(eq) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -5257,9 +5515,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
                 }
-                case Instruction::collEq: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(collEq) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -5280,9 +5538,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (collOwned) {
                         value::releaseValue(collTag, collVal);
                     }
-                    break;
                 }
-                case Instruction::neq: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(neq) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -5299,9 +5557,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
                 }
-                case Instruction::collNeq: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(collNeq) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -5323,9 +5581,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (collOwned) {
                         value::releaseValue(collTag, collVal);
                     }
-                    break;
                 }
-                case Instruction::cmp3w: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(cmp3w) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -5340,9 +5598,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
                 }
-                case Instruction::collCmp3w: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(collCmp3w) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -5362,9 +5620,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (collOwned) {
                         value::releaseValue(collTag, collVal);
                     }
-                    break;
                 }
-                case Instruction::fillEmpty: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(fillEmpty) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -5380,9 +5638,37 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                             value::releaseValue(rhsTag, rhsVal);
                         }
                     }
-                    break;
                 }
-                case Instruction::getField: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(fillEmptyImm) {
+                    auto k = readFromMemory<Instruction::Constants>(pcPointer);
+                    pcPointer += sizeof(k);
+
+                    auto [owned, tag, val] = getFromStack(0);
+                    if (tag == value::TypeTags::Nothing) {
+                        switch (k) {
+                            case Instruction::Nothing:
+                                break;
+                            case Instruction::Null:
+                                topStack(false, value::TypeTags::Null, 0);
+                                break;
+                            case Instruction::True:
+                                topStack(false,
+                                         value::TypeTags::Boolean,
+                                         value::bitcastFrom<bool>(true));
+                                break;
+                            case Instruction::False:
+                                topStack(false,
+                                         value::TypeTags::Boolean,
+                                         value::bitcastFrom<bool>(false));
+                                break;
+                            default:
+                                MONGO_UNREACHABLE;
+                        }
+                    }
+                }
+                SBE_VM_NEXT();
+                SBE_VM_CASE(getField) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -5397,9 +5683,26 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
                 }
-                case Instruction::getElement: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(getFieldImm) {
+                    auto size = readFromMemory<uint8_t>(pcPointer);
+                    pcPointer += sizeof(size);
+                    StringData fieldName(reinterpret_cast<const char*>(pcPointer), size);
+                    pcPointer += size;
+
+                    auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
+
+                    auto [owned, tag, val] = getField(lhsTag, lhsVal, fieldName);
+
+                    topStack(owned, tag, val);
+
+                    if (lhsOwned) {
+                        value::releaseValue(lhsTag, lhsVal);
+                    }
+                }
+                SBE_VM_NEXT();
+                SBE_VM_CASE(getElement) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -5414,9 +5717,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
                 }
-                case Instruction::getArraySize: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(getArraySize) {
                     auto [owned, tag, val] = getFromStack(0);
                     auto [resultOwned, resultTag, resultVal] = getArraySize(tag, val);
                     topStack(resultOwned, resultTag, resultVal);
@@ -5424,9 +5727,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
                 }
-                case Instruction::collComparisonKey: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(collComparisonKey) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -5454,9 +5757,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
                 }
-                case Instruction::getFieldOrElement: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(getFieldOrElement) {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
                     auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
@@ -5471,36 +5774,36 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (lhsOwned) {
                         value::releaseValue(lhsTag, lhsVal);
                     }
-                    break;
                 }
-                case Instruction::traverseP: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(traverseP) {
                     auto [owned, tag, val] = traverseP(code);
                     for (uint8_t cnt = 0; cnt < 2; ++cnt) {
                         popAndReleaseStack();
                     }
 
                     pushStack(owned, tag, val);
-                    break;
                 }
-                case Instruction::traverseF: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(traverseF) {
                     auto [owned, tag, val] = traverseF(code);
                     for (uint8_t cnt = 0; cnt < 3; ++cnt) {
                         popAndReleaseStack();
                     }
 
                     pushStack(owned, tag, val);
-                    break;
                 }
-                case Instruction::setField: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(setField) {
                     auto [owned, tag, val] = setField();
                     popAndReleaseStack();
                     popAndReleaseStack();
                     popAndReleaseStack();
 
                     pushStack(owned, tag, val);
-                    break;
                 }
-                case Instruction::aggSum: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(aggSum) {
                     auto [fieldOwned, fieldTag, fieldVal] = getFromStack(0);
                     popStack();
                     auto [accOwned, accTag, accVal] = getFromStack(0);
@@ -5515,9 +5818,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (accOwned) {
                         value::releaseValue(accTag, accVal);
                     }
-                    break;
                 }
-                case Instruction::aggMin: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(aggMin) {
                     auto [fieldOwned, fieldTag, fieldVal] = getFromStack(0);
                     popStack();
                     auto [accOwned, accTag, accVal] = getFromStack(0);
@@ -5532,9 +5835,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (accOwned) {
                         value::releaseValue(accTag, accVal);
                     }
-                    break;
                 }
-                case Instruction::aggCollMin: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(aggCollMin) {
                     auto [fieldOwned, fieldTag, fieldVal] = getFromStack(0);
                     popStack();
                     auto [collOwned, collTag, collVal] = getFromStack(0);
@@ -5562,9 +5865,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (accOwned) {
                         value::releaseValue(accTag, accVal);
                     }
-                    break;
                 }
-                case Instruction::aggMax: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(aggMax) {
                     auto [fieldOwned, fieldTag, fieldVal] = getFromStack(0);
                     popStack();
                     auto [accOwned, accTag, accVal] = getFromStack(0);
@@ -5579,9 +5882,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (accOwned) {
                         value::releaseValue(accTag, accVal);
                     }
-                    break;
                 }
-                case Instruction::aggCollMax: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(aggCollMax) {
                     auto [fieldOwned, fieldTag, fieldVal] = getFromStack(0);
                     popStack();
                     auto [collOwned, collTag, collVal] = getFromStack(0);
@@ -5609,9 +5912,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (accOwned) {
                         value::releaseValue(accTag, accVal);
                     }
-                    break;
                 }
-                case Instruction::aggFirst: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(aggFirst) {
                     auto [fieldOwned, fieldTag, fieldVal] = getFromStack(0);
                     popStack();
                     auto [accOwned, accTag, accVal] = getFromStack(0);
@@ -5626,9 +5929,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (accOwned) {
                         value::releaseValue(accTag, accVal);
                     }
-                    break;
                 }
-                case Instruction::aggLast: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(aggLast) {
                     auto [fieldOwned, fieldTag, fieldVal] = getFromStack(0);
                     popStack();
                     auto [accOwned, accTag, accVal] = getFromStack(0);
@@ -5643,9 +5946,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (accOwned) {
                         value::releaseValue(accTag, accVal);
                     }
-                    break;
                 }
-                case Instruction::exists: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(exists) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     topStack(false,
@@ -5655,9 +5958,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
                 }
-                case Instruction::isNull: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(isNull) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -5669,9 +5972,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
                 }
-                case Instruction::isObject: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(isObject) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -5683,9 +5986,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
                 }
-                case Instruction::isArray: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(isArray) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -5697,9 +6000,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
                 }
-                case Instruction::isString: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(isString) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -5711,9 +6014,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
                 }
-                case Instruction::isNumber: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(isNumber) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -5725,9 +6028,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
                 }
-                case Instruction::isBinData: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(isBinData) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -5739,9 +6042,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
                 }
-                case Instruction::isDate: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(isDate) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -5753,9 +6056,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
                 }
-                case Instruction::isNaN: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(isNaN) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -5767,9 +6070,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
                 }
-                case Instruction::isInfinity: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(isInfinity) {
                     auto [owned, tag, val] = getFromStack(0);
                     if (tag != value::TypeTags::Nothing) {
                         topStack(false,
@@ -5779,9 +6082,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
                 }
-                case Instruction::isRecordId: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(isRecordId) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -5793,9 +6096,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
                 }
-                case Instruction::isMinKey: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(isMinKey) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -5807,9 +6110,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
                 }
-                case Instruction::isMaxKey: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(isMaxKey) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -5821,9 +6124,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
                 }
-                case Instruction::isTimestamp: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(isTimestamp) {
                     auto [owned, tag, val] = getFromStack(0);
 
                     if (tag != value::TypeTags::Nothing) {
@@ -5835,10 +6138,10 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
                 }
-                case Instruction::function:
-                case Instruction::functionSmall: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(function)
+                SBE_VM_CASE(functionSmall) {
                     auto f = readFromMemory<Builtin>(pcPointer);
                     pcPointer += sizeof(f);
                     ArityType arity{0};
@@ -5857,17 +6160,16 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     }
 
                     pushStack(owned, tag, val);
-
-                    break;
                 }
-                case Instruction::jmp: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(jmp) {
                     auto jumpOffset = readFromMemory<int>(pcPointer);
                     pcPointer += sizeof(jumpOffset);
 
                     pcPointer += jumpOffset;
-                    break;
                 }
-                case Instruction::jmpTrue: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(jmpTrue) {
                     auto jumpOffset = readFromMemory<int>(pcPointer);
                     pcPointer += sizeof(jumpOffset);
 
@@ -5881,9 +6183,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (owned) {
                         value::releaseValue(tag, val);
                     }
-                    break;
                 }
-                case Instruction::jmpNothing: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(jmpNothing) {
                     auto jumpOffset = readFromMemory<int>(pcPointer);
                     pcPointer += sizeof(jumpOffset);
 
@@ -5891,13 +6193,13 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     if (tag == value::TypeTags::Nothing) {
                         pcPointer += jumpOffset;
                     }
-                    break;
                 }
-                case Instruction::ret: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(ret) {
                     pcPointer = pcEnd;
-                    break;
                 }
-                case Instruction::fail: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(fail) {
                     auto [ownedCode, tagCode, valCode] = getFromStack(1);
                     invariant(tagCode == value::TypeTags::NumberInt64);
 
@@ -5909,10 +6211,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                     std::string message{value::getStringView(tagMsg, valMsg)};
 
                     uasserted(code, message);
-
-                    break;
                 }
-                case Instruction::applyClassicMatcher: {
+                SBE_VM_NEXT();
+                SBE_VM_CASE(applyClassicMatcher) {
                     const auto* matcher = readFromMemory<const MatchExpression*>(pcPointer);
                     pcPointer += sizeof(matcher);
 
@@ -5935,8 +6236,8 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
                         value::releaseValue(tagObj, valObj);
                     }
                     topStack(false, value::TypeTags::Boolean, value::bitcastFrom<bool>(res));
-                    break;
                 }
+                SBE_VM_NEXT();
                 default:
                     MONGO_UNREACHABLE;
             }
@@ -5944,6 +6245,9 @@ void ByteCode::runInternal(const CodeFragment* code, int64_t position) {
     }
 }
 
+#undef SBE_VM_NEXT
+#undef SBE_VM_CASE
+
 std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragment* code) {
     uassert(6040900, "The evaluation stack must be empty", _argStack.size() == 0);
 
@@ -274,7 +274,9 @@ struct Instruction {
         collCmp3w,
 
         fillEmpty,
+        fillEmptyImm,  // fillEmpty with a constant encoded in the instruction
         getField,
+        getFieldImm,  // getField with a constant field name encoded in the instruction
         getElement,
         collComparisonKey,
         getFieldOrElement,
@@ -322,6 +324,28 @@ struct Instruction {
         lastInstruction  // this is just a marker used to calculate number of instructions
     };
 
+    enum Constants : uint8_t {
+        Nothing,
+        Null,
+        False,
+        True,
+    };
+
+    static const char* toStringConstants(Constants k) {
+        switch (k) {
+            case Nothing:
+                return "Nothing";
+            case Null:
+                return "Null";
+            case True:
+                return "True";
+            case False:
+                return "False";
+            default:
+                return "unknown";
+        }
+    }
+
     // Make sure that values in this arrays are always in-sync with the enum.
     static int stackOffset[];
 
@@ -393,8 +417,12 @@ struct Instruction {
                 return "collCmp3w";
             case fillEmpty:
                 return "fillEmpty";
+            case fillEmptyImm:
+                return "fillEmptyImm";
             case getField:
                 return "getField";
+            case getFieldImm:
+                return "getFieldImm";
             case getElement:
                 return "getElement";
             case collComparisonKey:
@@ -530,6 +558,13 @@ enum class Builtin : uint8_t {
     // An agg function which can be used to sum a sequence of DoubleDouble inputs, producing the
     // resulting total as a DoubleDouble.
     aggMergeDoubleDoubleSums,
+    // Variants of 'aggDoubleDoubleSum' and of the 'aggMin'/'aggMax' instructions which fold every
+    // element of an array input into the accumulator (a non-array input is folded as a single
+    // value). Arrays holding only NumberInt64 or only NumberDouble values are processed with the
+    // vectorized kernels from 'array_kernels.h'. These don't support collation.
+    aggDoubleDoubleSumOfArray,
+    aggMinOfArray,
+    aggMaxOfArray,
 
     // Implements Welford's online algorithm for computing sample or population standard deviation
     // in a single pass.
@@ -609,6 +644,19 @@ enum class Builtin : uint8_t {
     tsSecond,
     tsIncrement,
     typeMatch,
+
+    // Block-at-a-time builtins. These take 'valueBlock' arguments and evaluate an operation over
+    // every value of the block in a single call, producing a new block of results.
+    valueBlockFillEmpty,
+    valueBlockGtScalar,
+    valueBlockGteScalar,
+    valueBlockEqScalar,
+    valueBlockNeqScalar,
+    valueBlockLtScalar,
+    valueBlockLteScalar,
+    valueBlockLogicalAnd,
+    valueBlockLogicalOr,
+    valueBlockCount,  // number of 'true' values in a block of booleans
 };
 
 /**
@@ -652,6 +700,10 @@ using ArityType = uint32_t;
 
 class CodeFragment {
 public:
+    // The longest field name that can be encoded directly in a 'getFieldImm' instruction. Longer
+    // names fall back to a 'pushConstVal' followed by a regular 'getField'.
+    static constexpr size_t kMaxImmFieldNameSize = std::numeric_limits<uint8_t>::max();
+
     auto& instrs() {
         return _instrs;
     }
@@ -730,7 +782,9 @@ public:
     void appendFillEmpty() {
         appendSimpleInstruction(Instruction::fillEmpty);
     }
+    void appendFillEmpty(Instruction::Constants k);
     void appendGetField();
+    void appendGetField(StringData fieldName);
     void appendGetElement();
     void appendCollComparisonKey();
     void appendGetFieldOrElement();
@@ -987,6 +1041,10 @@ private:
                                                              value::TypeTags fieldTag,
                                                              value::Value fieldValue);
 
+    std::tuple<bool, value::TypeTags, value::Value> getField(value::TypeTags objTag,
+                                                             value::Value objValue,
+                                                             StringData fieldStr);
+
     std::tuple<bool, value::TypeTags, value::Value> getElement(value::TypeTags objTag,
                                                                value::Value objValue,
                                                                value::TypeTags fieldTag,
@@ -1019,6 +1077,9 @@ private:
     void aggMergeDoubleDoubleSumsImpl(value::Array* accumulator,
                                       value::TypeTags rhsTag,
                                       value::Value rhsValue);
+    void aggDoubleDoubleSumOfArrayImpl(value::Array* accumulator,
+                                       value::TypeTags rhsTag,
+                                       value::Value rhsValue);
 
     // This is an implementation of the following algorithm:
     // https://en.wikipedia.org/wiki/Algorithms_for_calculating_variance#Welford's_online_algorithm
@@ -1150,6 +1211,10 @@ private:
     // partially computed DoubleDouble sums.
     template <bool merging>
     std::tuple<bool, value::TypeTags, value::Value> builtinAggDoubleDoubleSum(ArityType arity);
+    std::tuple<bool, value::TypeTags, value::Value> builtinAggDoubleDoubleSumOfArray(
+        ArityType arity);
+    template <bool IsMin>
+    std::tuple<bool, value::TypeTags, value::Value> builtinAggMinMaxOfArray(ArityType arity);
 
     // This is only for compatibility with mongos/sharding and we will revisit this later.
     template <bool keepIntegerPrecision = false>
@@ -1232,6 +1297,13 @@ private:
     std::tuple<bool, value::TypeTags, value::Value> builtinTsIncrement(ArityType arity);
     std::tuple<bool, value::TypeTags, value::Value> builtinTypeMatch(ArityType arity);
 
+    std::tuple<bool, value::TypeTags, value::Value> builtinValueBlockFillEmpty(ArityType arity);
+    template <typename Op>
+    std::tuple<bool, value::TypeTags, value::Value> builtinValueBlockCmpScalar(ArityType arity);
+    template <bool IsAnd>
+    std::tuple<bool, value::TypeTags, value::Value> builtinValueBlockLogicalOp(ArityType arity);
+    std::tuple<bool, value::TypeTags, value::Value> builtinValueBlockCount(ArityType arity);
+
     std::tuple<bool, value::TypeTags, value::Value> dispatchBuiltin(Builtin f, ArityType arity);
 
     std::tuple<bool, value::TypeTags, value::Value> getFromStack(size_t offset) {
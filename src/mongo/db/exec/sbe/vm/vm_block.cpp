@@ -0,0 +1,172 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/sbe/values/block_interface.h"
+#include "mongo/db/exec/sbe/vm/vm.h"
+
+namespace mongo {
+namespace sbe {
+namespace vm {
+/**
+ * Implementations of the 'valueBlock*' builtins. Each of them consumes one or more 'valueBlock'
+ * arguments and produces a new block with one result per input position, so that a whole column
+ * of values is processed in a single VM call instead of once per row.
+ */
+namespace {
+bool isTrue(value::TypeTags tag, value::Value val) {
+    return tag == value::TypeTags::Boolean && value::bitcastTo<bool>(val);
+}
+}  // namespace
+
+std::tuple<bool, value::TypeTags, value::Value> ByteCode::builtinValueBlockFillEmpty(
+    ArityType arity) {
+    invariant(arity == 2);
+
+    auto [blockOwned, blockTag, blockVal] = getFromStack(0);
+    auto [fillOwned, fillTag, fillVal] = getFromStack(1);
+    if (blockTag != value::TypeTags::valueBlock) {
+        return {false, value::TypeTags::Nothing, 0};
+    }
+
+    auto block = value::getValueBlock(blockVal)->extract();
+
+    auto out = std::make_unique<value::HeterogeneousBlock>();
+    out->reserve(block.count);
+    for (size_t i = 0; i < block.count; ++i) {
+        if (block.tags[i] == value::TypeTags::Nothing) {
+            out->push_back(value::copyValue(fillTag, fillVal));
+        } else {
+            out->push_back(value::copyValue(block.tags[i], block.vals[i]));
+        }
+    }
+
+    auto [resTag, resVal] = value::makeValueBlock(std::move(out));
+    return {true, resTag, resVal};
+}
+
+template <typename Op>
+std::tuple<bool, value::TypeTags, value::Value> ByteCode::builtinValueBlockCmpScalar(
+    ArityType arity) {
+    invariant(arity == 2);
+
+    auto [blockOwned, blockTag, blockVal] = getFromStack(0);
+    auto [scalarOwned, scalarTag, scalarVal] = getFromStack(1);
+    if (blockTag != value::TypeTags::valueBlock) {
+        return {false, value::TypeTags::Nothing, 0};
+    }
+
+    auto block = value::getValueBlock(blockVal)->extract();
+
+    // The comparison only ever produces shallow values (booleans or Nothing), so we can build the
+    // output vectors directly.
+    std::vector<value::TypeTags> tags(block.count);
+    std::vector<value::Value> vals(block.count);
+    for (size_t i = 0; i < block.count; ++i) {
+        std::tie(tags[i], vals[i]) =
+            genericCompare<Op>(block.tags[i], block.vals[i], scalarTag, scalarVal);
+    }
+
+    auto [resTag, resVal] = value::makeValueBlock(
+        std::make_unique<value::HeterogeneousBlock>(std::move(tags), std::move(vals)));
+    return {true, resTag, resVal};
+}
+
+template <bool IsAnd>
+std::tuple<bool, value::TypeTags, value::Value> ByteCode::builtinValueBlockLogicalOp(
+    ArityType arity) {
+    invariant(arity == 2);
+
+    auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
+    auto [rhsOwned, rhsTag, rhsVal] = getFromStack(1);
+    if (lhsTag != value::TypeTags::valueBlock || rhsTag != value::TypeTags::valueBlock) {
+        return {false, value::TypeTags::Nothing, 0};
+    }
+
+    auto lhs = value::getValueBlock(lhsVal)->extract();
+    auto rhs = value::getValueBlock(rhsVal)->extract();
+    if (lhs.count != rhs.count) {
+        return {false, value::TypeTags::Nothing, 0};
+    }
+
+    // Anything other than boolean 'true' (including Nothing) is treated as false, matching how
+    // filters treat the result of a predicate.
+    std::vector<value::TypeTags> tags(lhs.count, value::TypeTags::Boolean);
+    std::vector<value::Value> vals(lhs.count);
+    for (size_t i = 0; i < lhs.count; ++i) {
+        bool result = IsAnd
+            ? isTrue(lhs.tags[i], lhs.vals[i]) && isTrue(rhs.tags[i], rhs.vals[i])
+            : isTrue(lhs.tags[i], lhs.vals[i]) || isTrue(rhs.tags[i], rhs.vals[i]);
+        vals[i] = value::bitcastFrom<bool>(result);
+    }
+
+    auto [resTag, resVal] = value::makeValueBlock(
+        std::make_unique<value::HeterogeneousBlock>(std::move(tags), std::move(vals)));
+    return {true, resTag, resVal};
+}
+
+std::tuple<bool, value::TypeTags, value::Value> ByteCode::builtinValueBlockCount(
+    ArityType arity) {
+    invariant(arity == 1);
+
+    auto [blockOwned, blockTag, blockVal] = getFromStack(0);
+    if (blockTag != value::TypeTags::valueBlock) {
+        return {false, value::TypeTags::Nothing, 0};
+    }
+
+    auto block = value::getValueBlock(blockVal)->extract();
+
+    int64_t count = 0;
+    for (size_t i = 0; i < block.count; ++i) {
+        count += isTrue(block.tags[i], block.vals[i]);
+    }
+
+    return {false, value::TypeTags::NumberInt64, value::bitcastFrom<int64_t>(count)};
+}
+
+template std::tuple<bool, value::TypeTags, value::Value>
+ByteCode::builtinValueBlockCmpScalar<std::greater<>>(ArityType arity);
+template std::tuple<bool, value::TypeTags, value::Value>
+ByteCode::builtinValueBlockCmpScalar<std::greater_equal<>>(ArityType arity);
+template std::tuple<bool, value::TypeTags, value::Value>
+ByteCode::builtinValueBlockCmpScalar<std::equal_to<>>(ArityType arity);
+template std::tuple<bool, value::TypeTags, value::Value>
+ByteCode::builtinValueBlockCmpScalar<std::not_equal_to<>>(ArityType arity);
+template std::tuple<bool, value::TypeTags, value::Value>
+ByteCode::builtinValueBlockCmpScalar<std::less<>>(ArityType arity);
+template std::tuple<bool, value::TypeTags, value::Value>
+ByteCode::builtinValueBlockCmpScalar<std::less_equal<>>(ArityType arity);
+template std::tuple<bool, value::TypeTags, value::Value>
+ByteCode::builtinValueBlockLogicalOp<true>(ArityType arity);
+template std::tuple<bool, value::TypeTags, value::Value>
+ByteCode::builtinValueBlockLogicalOp<false>(ArityType arity);
+}  // namespace vm
+}  // namespace sbe
+}  // namespace mongo
@@ -0,0 +1,76 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/shared_scan_registry.h"
+
+#include "mongo/db/service_context.h"
+
+namespace mongo {
+namespace {
+const auto getSharedScanRegistry = ServiceContext::declareDecoration<SharedScanRegistry>();
+}  // namespace
+
+SharedScanRegistry& SharedScanRegistry::get(ServiceContext* serviceContext) {
+    return getSharedScanRegistry(serviceContext);
+}
+
+std::unique_ptr<SharedScanRegistry::Scan> SharedScanRegistry::joinScan(const UUID& uuid) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto& scans = _scans[uuid];
+    ++scans.numScans;
+    return std::make_unique<Scan>(this, uuid, scans.position);
+}
+
+size_t SharedScanRegistry::numScans(const UUID& uuid) const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto it = _scans.find(uuid);
+    return it == _scans.end() ? 0 : it->second.numScans;
+}
+
+void SharedScanRegistry::reportPosition(const UUID& uuid, const RecordId& recordId) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto it = _scans.find(uuid);
+    invariant(it != _scans.end());
+    it->second.position = recordId;
+}
+
+void SharedScanRegistry::leaveScan(const UUID& uuid) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto it = _scans.find(uuid);
+    invariant(it != _scans.end() && it->second.numScans > 0);
+    if (--it->second.numScans == 0) {
+        // The next scan of the collection starts from its beginning.
+        _scans.erase(it);
+    }
+}
+
+}  // namespace mongo
@@ -0,0 +1,131 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <memory>
+
+#include <boost/optional.hpp>
+
+#include "mongo/db/record_id.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/uuid.h"
+
+namespace mongo {
+
+class ServiceContext;
+
+/**
+ * Lets concurrent forward collection scans of the same collection move through it together, so
+ * that each part of the collection is read from disk once for all of them rather than once per
+ * scan. A scan which starts while others are in flight begins at the position they last reported
+ * and wraps around to the start of the collection once it reaches the end, stopping where it
+ * began.
+ *
+ * Only the position is shared: each scan keeps its own cursor and storage snapshot, so the set of
+ * documents it returns is the same as for an ordinary collection scan. Only the order differs.
+ */
+class SharedScanRegistry {
+public:
+    // How many records a scan returns between two reports of its position.
+    static constexpr size_t kPositionReportInterval = 128;
+
+    /**
+     * Membership of one collection scan in the set of scans of its collection. Leaves the set on
+     * destruction.
+     */
+    class Scan {
+    public:
+        Scan(SharedScanRegistry* registry, UUID uuid, boost::optional<RecordId> startPosition)
+            : _registry(registry),
+              _uuid(std::move(uuid)),
+              _startPosition(std::move(startPosition)) {}
+
+        ~Scan() {
+            _registry->leaveScan(_uuid);
+        }
+
+        Scan(const Scan&) = delete;
+        Scan& operator=(const Scan&) = delete;
+
+        /**
+         * The position this scan starts at, or boost::none if it starts at the beginning of the
+         * collection.
+         */
+        const boost::optional<RecordId>& startPosition() const {
+            return _startPosition;
+        }
+
+        /**
+         * Called for each record returned by the scan. Publishes 'recordId' as the position of the
+         * scans of this collection every 'kPositionReportInterval' records.
+         */
+        void onRecord(const RecordId& recordId) {
+            if (++_recordsSinceReport >= kPositionReportInterval) {
+                _registry->reportPosition(_uuid, recordId);
+                _recordsSinceReport = 0;
+            }
+        }
+
+    private:
+        SharedScanRegistry* const _registry;
+        const UUID _uuid;
+        const boost::optional<RecordId> _startPosition;
+        size_t _recordsSinceReport = 0;
+    };
+
+    static SharedScanRegistry& get(ServiceContext* serviceContext);
+
+    /**
+     * Registers a new scan of the collection 'uuid'. The scan starts at the last position reported
+     * by the other scans of the collection, if any.
+     */
+    std::unique_ptr<Scan> joinScan(const UUID& uuid);
+
+    /**
+     * Returns the number of scans of the collection 'uuid' in flight.
+     */
+    size_t numScans(const UUID& uuid) const;
+
+private:
+    struct CollectionScans {
+        size_t numScans = 0;
+        boost::optional<RecordId> position;
+    };
+
+    void reportPosition(const UUID& uuid, const RecordId& recordId);
+    void leaveScan(const UUID& uuid);
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("SharedScanRegistry::_mutex");
+    stdx::unordered_map<UUID, CollectionScans, UUID::Hash> _scans;
+};
+
+}  // namespace mongo
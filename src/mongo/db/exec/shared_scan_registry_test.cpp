@@ -0,0 +1,89 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/shared_scan_registry.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+TEST(SharedScanRegistryTest, FirstScanStartsAtTheBeginning) {
+    SharedScanRegistry registry;
+    const auto uuid = UUID::gen();
+
+    auto scan = registry.joinScan(uuid);
+    ASSERT_FALSE(scan->startPosition());
+    ASSERT_EQ(registry.numScans(uuid), 1U);
+
+    scan.reset();
+    ASSERT_EQ(registry.numScans(uuid), 0U);
+}
+
+TEST(SharedScanRegistryTest, LateScanStartsAtLastReportedPosition) {
+    SharedScanRegistry registry;
+    const auto uuid = UUID::gen();
+
+    auto first = registry.joinScan(uuid);
+    for (int64_t id = 1; id <= int64_t(SharedScanRegistry::kPositionReportInterval) + 10; ++id) {
+        first->onRecord(RecordId(id));
+    }
+
+    auto second = registry.joinScan(uuid);
+    ASSERT(second->startPosition());
+    ASSERT_EQ(*second->startPosition(),
+              RecordId(int64_t(SharedScanRegistry::kPositionReportInterval)));
+    ASSERT_EQ(registry.numScans(uuid), 2U);
+
+    // Scans of other collections are not affected.
+    auto other = registry.joinScan(UUID::gen());
+    ASSERT_FALSE(other->startPosition());
+}
+
+TEST(SharedScanRegistryTest, PositionIsForgottenOnceAllScansEnd) {
+    SharedScanRegistry registry;
+    const auto uuid = UUID::gen();
+
+    auto first = registry.joinScan(uuid);
+    for (int64_t id = 1; id <= int64_t(SharedScanRegistry::kPositionReportInterval); ++id) {
+        first->onRecord(RecordId(id));
+    }
+    auto second = registry.joinScan(uuid);
+    ASSERT(second->startPosition());
+
+    first.reset();
+    second.reset();
+    ASSERT_EQ(registry.numScans(uuid), 0U);
+    ASSERT_FALSE(registry.joinScan(uuid)->startPosition());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -126,12 +126,14 @@ PlanStage::StageState SortStageDefault::unspool(WorkingSetID* out) {
         return PlanStage::IS_EOF;
     }
 
-    auto&& [key, nextWsm] = _sortExecutor.getNext();
-    *out = _ws->emplace(nextWsm.extract());
-
     if (_addSortKeyMetadata) {
+        auto&& [key, nextWsm] = _sortExecutor.getNext();
+        *out = _ws->emplace(nextWsm.extract());
+
         auto member = _ws->get(*out);
         member->metadata().setSortKey(std::move(key), _sortKeyGen.isSingleElementKey());
+    } else {
+        *out = _ws->emplace(_sortExecutor.getNextData().extract());
     }
 
     return PlanStage::ADVANCED;
@@ -168,15 +170,17 @@ PlanStage::StageState SortStageSimple::unspool(WorkingSetID* out) {
         return PlanStage::IS_EOF;
     }
 
-    auto&& [key, nextObj] = _sortExecutor.getNext();
-
     *out = _ws->allocate();
     auto member = _ws->get(*out);
-    member->resetDocument(SnapshotId{}, nextObj.getOwned());
-    member->transitionToOwnedObj();
 
     if (_addSortKeyMetadata) {
+        auto&& [key, nextObj] = _sortExecutor.getNext();
+        member->resetDocument(SnapshotId{}, nextObj.getOwned());
+        member->transitionToOwnedObj();
         member->metadata().setSortKey(std::move(key), _sortKeyGen.isSingleElementKey());
+    } else {
+        member->resetDocument(SnapshotId{}, _sortExecutor.getNextData().getOwned());
+        member->transitionToOwnedObj();
     }
 
     return PlanStage::ADVANCED;
@@ -31,10 +31,61 @@
 
 #include "mongo/db/exec/sort_executor.h"
 
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/exec/document_value/document_metadata_fields.h"
 #include "mongo/db/exec/document_value/value_comparator.h"
 #include "mongo/db/exec/working_set.h"
 
 namespace mongo {
+
+boost::optional<Ordering> EncodedSortKey::makeOrdering(const SortPattern& sortPattern) {
+    if (sortPattern.size() > Ordering::kMaxCompoundIndexKeys) {
+        return boost::none;
+    }
+    BSONObjBuilder orderingBuilder;
+    for (auto&& part : sortPattern) {
+        orderingBuilder.append(""_sd, part.isAscending ? 1 : -1);
+    }
+    return Ordering::make(orderingBuilder.obj());
+}
+
+EncodedSortKey::EncodedSortKey(const Value& sortKey,
+                               bool isSingleElementKey,
+                               const boost::optional<Ordering>& ordering)
+    : EncodedSortKey(ordering ? EncodedSortKey(KeyString::Builder(
+                                                   KeyString::Version::kLatestVersion,
+                                                   DocumentMetadataFields::serializeSortKey(
+                                                       isSingleElementKey, sortKey),
+                                                   *ordering)
+                                                   .getValueCopy())
+                              : EncodedSortKey(sortKey)) {}
+
+EncodedSortKey::EncodedSortKey(KeyString::Value keyString)
+    : _keyString(std::move(keyString)),
+      _memUsage(sizeof(EncodedSortKey) + _keyString->getApproximateSize()) {}
+
+EncodedSortKey::EncodedSortKey(Value value)
+    : _value(std::move(value)),
+      _memUsage(sizeof(EncodedSortKey) + _value.getApproximateSize() - sizeof(Value)) {}
+
+Value EncodedSortKey::decode(bool isSingleElementKey,
+                             const boost::optional<Ordering>& ordering) const {
+    if (!_keyString) {
+        return _value;
+    }
+    return DocumentMetadataFields::deserializeSortKey(isSingleElementKey,
+                                                      KeyString::toBson(*_keyString, *ordering));
+}
+
+EncodedSortKey EncodedSortKey::deserializeForSorter(BufReader& buf,
+                                                    const SorterDeserializeSettings&) {
+    if (!buf.read<char>()) {
+        return EncodedSortKey(Value::deserializeForSorter(buf, Value::SorterDeserializeSettings()));
+    }
+    return EncodedSortKey(
+        KeyString::Value::deserializeForSorter(buf, {KeyString::Version::kLatestVersion}));
+}
+
 namespace {
 /**
  * Generates a new file name on each call using a static, atomic and monotonically increasing
@@ -54,10 +105,12 @@ std::string nextFileName() {
 
 #include "mongo/db/sorter/sorter.cpp"
 
-MONGO_CREATE_SORTER(mongo::Value,
+MONGO_CREATE_SORTER(mongo::EncodedSortKey,
                     mongo::Document,
                     mongo::SortExecutor<mongo::Document>::Comparator);
-MONGO_CREATE_SORTER(mongo::Value,
+MONGO_CREATE_SORTER(mongo::EncodedSortKey,
                     mongo::SortableWorkingSetMember,
                     mongo::SortExecutor<mongo::SortableWorkingSetMember>::Comparator);
-MONGO_CREATE_SORTER(mongo::Value, mongo::BSONObj, mongo::SortExecutor<mongo::BSONObj>::Comparator);
+MONGO_CREATE_SORTER(mongo::EncodedSortKey,
+                    mongo::BSONObj,
+                    mongo::SortExecutor<mongo::BSONObj>::Comparator);
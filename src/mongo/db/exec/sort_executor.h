@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include "mongo/bson/ordering.h"
 #include "mongo/db/exec/document_value/document.h"
 #include "mongo/db/exec/plan_stats.h"
 #include "mongo/db/exec/sort_key_comparator.h"
@@ -36,8 +37,84 @@
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/query/sort_pattern.h"
 #include "mongo/db/sorter/sorter.h"
+#include "mongo/db/storage/key_string.h"
 
 namespace mongo {
+/**
+ * A sort key encoded as a KeyString, which the SortExecutor hands to the Sorter in place of the
+ * Value sort key. The key is encoded once when it is added, after which every comparison made by
+ * the Sorter is a memcmp() rather than a comparison of Values by type. Sort keys already hold the
+ * collation comparison keys in place of strings, so the binary order of the KeyStrings is the same
+ * as the order given by SortKeyComparator. The TypeBits are kept, so that the Value can be decoded
+ * for callers which attach it to the output as metadata.
+ *
+ * An Ordering cannot describe more than 32 components. Sort keys of longer sort patterns are kept
+ * as Values and compared with a SortKeyComparator.
+ */
+class EncodedSortKey {
+public:
+    struct SorterDeserializeSettings {};  // unused
+
+    /**
+     * Returns the Ordering which encodes the directions of 'sortPattern' into a KeyString, or
+     * boost::none if 'sortPattern' has too many components for its keys to be encoded.
+     */
+    static boost::optional<Ordering> makeOrdering(const SortPattern& sortPattern);
+
+    EncodedSortKey() = default;
+
+    EncodedSortKey(const Value& sortKey,
+                   bool isSingleElementKey,
+                   const boost::optional<Ordering>& ordering);
+
+    /**
+     * Returns the sort key this was encoded from.
+     */
+    Value decode(bool isSingleElementKey, const boost::optional<Ordering>& ordering) const;
+
+    /**
+     * Compares the KeyStrings of two encoded keys, or uses 'comparator' for keys kept as Values.
+     */
+    int compare(const EncodedSortKey& other, const SortKeyComparator& comparator) const {
+        if (_keyString && other._keyString) {
+            return _keyString->compare(*other._keyString);
+        }
+        return comparator(_value, other._value);
+    }
+
+    void serializeForSorter(BufBuilder& buf) const {
+        buf.appendChar(_keyString ? 1 : 0);
+        if (_keyString) {
+            _keyString->serializeForSorter(buf);
+        } else {
+            _value.serializeForSorter(buf);
+        }
+    }
+
+    static EncodedSortKey deserializeForSorter(BufReader& buf, const SorterDeserializeSettings&);
+
+    int memUsageForSorter() const {
+        return _memUsage;
+    }
+
+    EncodedSortKey getOwned() const {
+        return *this;
+    }
+
+private:
+    explicit EncodedSortKey(KeyString::Value keyString);
+    explicit EncodedSortKey(Value value);
+
+    boost::optional<KeyString::Value> _keyString;
+
+    // The sort key itself when it is not encoded into '_keyString'.
+    Value _value;
+
+    // Computed up front, since copies of '_keyString' share its buffer and can no longer report
+    // its size.
+    int _memUsage = sizeof(EncodedSortKey);
+};
+
 /**
  * The SortExecutor class is the internal implementation of sorting for query execution. The
  * caller should provide input documents by repeated calls to the add() function, and then
@@ -45,19 +122,19 @@ namespace mongo {
  * called to return the documents one by one in sorted order.
  *
  * The template parameter is the type of data being sorted. In DocumentSource execution, we sort
- * Document objects directly, but in the PlanStage layer we may sort WorkingSetMembers. The type of
- * the sort key, on the other hand, is always Value.
+ * Document objects directly, but in the PlanStage layer we may sort WorkingSetMembers. Callers
+ * provide and receive the sort key as a Value, but it is sorted as an EncodedSortKey.
  */
 template <typename T>
 class SortExecutor {
 public:
-    using DocumentSorter = Sorter<Value, T>;
+    using DocumentSorter = Sorter<EncodedSortKey, T>;
     class Comparator {
     public:
         Comparator(const SortPattern& sortPattern) : _sortKeyComparator(sortPattern) {}
         int operator()(const typename DocumentSorter::Data& lhs,
                        const typename DocumentSorter::Data& rhs) const {
-            return _sortKeyComparator(lhs.first, rhs.first);
+            return lhs.first.compare(rhs.first, _sortKeyComparator);
         }
 
     private:
@@ -74,7 +151,8 @@ public:
                  bool allowDiskUse)
         : _sortPattern(std::move(sortPattern)),
           _tempDir(std::move(tempDir)),
-          _diskUseAllowed(allowDiskUse) {
+          _diskUseAllowed(allowDiskUse),
+          _ordering(EncodedSortKey::makeOrdering(_sortPattern)) {
         _stats.sortPattern =
             _sortPattern.serialize(SortPattern::SortKeySerialization::kForExplain).toBson();
         _stats.limit = limit;
@@ -126,7 +204,7 @@ public:
         if (!_sorter) {
             _sorter.reset(DocumentSorter::make(makeSortOptions(), Comparator(_sortPattern)));
         }
-        _sorter->add(sortKey, data);
+        _sorter->add(EncodedSortKey(sortKey, _sortPattern.isSingleElementKey(), _ordering), data);
     }
 
     /**
@@ -168,7 +246,17 @@ public:
      * end-of-stream must be detected with 'hasNext()'.
      */
     std::pair<Value, T> getNext() {
-        return _output->next();
+        auto next = _output->next();
+        return {next.first.decode(_sortPattern.isSingleElementKey(), _ordering),
+                std::move(next.second)};
+    }
+
+    /**
+     * Like 'getNext()', but returns only the item being sorted, which saves decoding the sort key
+     * for callers that do not need it.
+     */
+    T getNextData() {
+        return _output->next().second;
     }
 
     uint64_t getMaxMemoryBytes() const {
@@ -194,6 +282,7 @@ private:
     const SortPattern _sortPattern;
     const std::string _tempDir;
     const bool _diskUseAllowed;
+    const boost::optional<Ordering> _ordering;
 
     std::unique_ptr<DocumentSorter> _sorter;
     std::unique_ptr<typename DocumentSorter::Iterator> _output;
@@ -303,4 +303,31 @@ TEST_F(SortStageDefaultTest, SortDescendingWithCollation) {
              "{input: [{a: 'ba'}, {a: 'aa'}, {a: 'ab'}]}",
              "{output: [{a: 'ab'}, {a: 'ba'}, {a: 'aa'}]}");
 }
+
+TEST_F(SortStageDefaultTest, SortCompoundWithMixedDirectionsAndTypes) {
+    testWork("{a: 1, b: -1}",
+             nullptr,
+             0,
+             "{input: [{a: 2, b: 1}, {a: NumberLong(1), b: 'x'}, {a: 1.5, b: 3}, {a: 1, b: 2}, "
+             "{a: 2, b: 5}, {a: null, b: 0}]}",
+             "{output: [{a: null, b: 0}, {a: NumberLong(1), b: 'x'}, {a: 1, b: 2}, {a: 1.5, b: 3}, "
+             "{a: 2, b: 5}, {a: 2, b: 1}]}");
+}
+
+TEST_F(SortStageDefaultTest, SortWithMoreComponentsThanAnOrderingCanEncode) {
+    // The keys of this sort pattern are too long to be encoded into KeyStrings, so they are
+    // compared as Values.
+    BSONObjBuilder pattern;
+    for (size_t i = 0; i < Ordering::kMaxCompoundIndexKeys; ++i) {
+        pattern.append("f" + std::to_string(i), 1);
+    }
+    pattern.append("last", -1);
+
+    testWork(pattern.obj().toString().c_str(),
+             nullptr,
+             0,
+             "{input: [{f0: 2, last: 0}, {last: 1}, {last: 3}, {f31: 'x', last: 4}, {last: 2}]}",
+             "{output: [{last: 3}, {last: 2}, {last: 1}, {f31: 'x', last: 4}, "
+             "{f0: 2, last: 0}]}");
+}
 }  // namespace
@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <absl/container/flat_hash_map.h>
 #include <memory>
 
 #include "mongo/db/exec/requires_collection_stage.h"
@@ -138,7 +139,8 @@ private:
     /**
      *  Temporary score data filled out by children.
      *  Maps from RecordID -> (aggregate score for doc, wsid).
-     *  Map each buffered record id to this data.
+     *  Map each buffered record id to this data. An open-addressing map keeps this compact, since
+     *  a query for common terms can buffer an entry for millions of record ids.
      */
     struct TextRecordData {
         TextRecordData() : wsid(WorkingSet::INVALID_ID), score(0.0) {}
@@ -146,7 +148,7 @@ private:
         double score;
     };
 
-    typedef stdx::unordered_map<RecordId, TextRecordData, RecordId::Hasher> ScoreMap;
+    typedef absl::flat_hash_map<RecordId, TextRecordData, RecordId::Hasher> ScoreMap;
     ScoreMap _scores;
     ScoreMap::const_iterator _scoreIterator;
 
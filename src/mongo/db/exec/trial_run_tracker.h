@@ -34,6 +34,8 @@
 #include <functional>
 #include <type_traits>
 
+#include "mongo/platform/atomic_word.h"
+
 namespace mongo {
 /**
  * During the runtime planning phase this tracker is used to track the progress of the work done
@@ -105,6 +107,11 @@ public:
             return true;
         }
 
+        if (_stopRequested && _stopRequested->loadRelaxed()) {
+            _done = true;
+            return true;
+        }
+
         _metrics[metric] += metricIncrement;
         if (_metrics[metric] > _maxMetrics[metric]) {
             if (_onMetricReached) {
@@ -116,6 +123,15 @@ public:
         return _done;
     }
 
+    /**
+     * Makes 'trackProgress()' report the end of the trial period, as if a metric has exceeded its
+     * maximum, as soon as the flag pointed to by 'stopRequested' is set. This allows to stop a
+     * trial run from another thread. The flag must outlive the tracker.
+     */
+    void setStopRequestedFlag(const AtomicWord<bool>* stopRequested) {
+        _stopRequested = stopRequested;
+    }
+
     template <TrialRunMetric metric>
     size_t getMetric() const {
         static_assert(metric >= 0 && metric < sizeof(_metrics) / sizeof(size_t));
@@ -126,6 +142,7 @@ private:
     const size_t _maxMetrics[TrialRunMetric::kLastElem];
     size_t _metrics[TrialRunMetric::kLastElem]{0};
     bool _done{false};
+    const AtomicWord<bool>* _stopRequested{nullptr};
     std::function<bool(TrialRunMetric)> _onMetricReached{};
 };
 }  // namespace mongo
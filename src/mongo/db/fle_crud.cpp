@@ -455,6 +455,11 @@ void processFieldsForInsert(FLEQueryInterface* queryImpl,
                             const EncryptedFieldConfig& efc,
                             int32_t* pStmtId,
                             bool bypassDocumentValidation) {
+    // Nothing to write for documents or updates without encrypted fields. An empty insert command
+    // would be rejected.
+    if (serverPayload.empty()) {
+        return;
+    }
 
     NamespaceString nssEsc(edcNss.db(), efc.getEscCollection().get());
 
@@ -462,6 +467,19 @@ void processFieldsForInsert(FLEQueryInterface* queryImpl,
 
     TxnCollectionReader reader(docCount, queryImpl, nssEsc);
 
+    // Statement ids are assigned as if each field's ESC and ECOC documents were still inserted
+    // one after the other: ESC for the first field, ECOC for the first field, ESC for the second.
+    auto stmtIds = getStmtIdsForInsert(2 * serverPayload.size(), pStmtId);
+
+    std::vector<BSONObj> escDocs;
+    std::vector<BSONObj> ecocDocs;
+    std::vector<StmtId> escStmtIds;
+    std::vector<StmtId> ecocStmtIds;
+    escDocs.reserve(serverPayload.size());
+    ecocDocs.reserve(serverPayload.size());
+    escStmtIds.reserve(serverPayload.size());
+    ecocStmtIds.reserve(serverPayload.size());
+
     for (auto& payload : serverPayload) {
 
         auto escToken = payload.getESCToken();
@@ -471,6 +489,7 @@ void processFieldsForInsert(FLEQueryInterface* queryImpl,
 
         int position = 1;
         int count = 1;
+
         auto alpha = ESCCollection::emuBinary(reader, tagToken, valueToken);
 
         if (alpha.has_value() && alpha.value() == 0) {
@@ -506,26 +525,24 @@ void processFieldsForInsert(FLEQueryInterface* queryImpl,
 
         payload.count = count;
 
-        auto escInsertReply = uassertStatusOK(queryImpl->insertDocument(
-            nssEsc,
-            ESCCollection::generateInsertDocument(tagToken, valueToken, position, count),
-            pStmtId,
-            true));
-        checkWriteErrors(escInsertReply);
-
+        escDocs.push_back(
+            ESCCollection::generateInsertDocument(tagToken, valueToken, position, count));
+        ecocDocs.push_back(ECOCCollection::generateDocument(payload.fieldPathName,
+                                                           payload.payload.getEncryptedTokens()));
+        escStmtIds.push_back(stmtIds[2 * escDocs.size() - 2]);
+        ecocStmtIds.push_back(stmtIds[2 * ecocDocs.size() - 1]);
+    }
 
-        NamespaceString nssEcoc(edcNss.db(), efc.getEcocCollection().get());
+    // Write the state collection entries for all fields with one insert per collection rather
+    // than two inserts per field.
+    auto escInsertReply = uassertStatusOK(
+        queryImpl->insertDocuments(nssEsc, std::move(escDocs), std::move(escStmtIds), true));
+    checkWriteErrors(escInsertReply);
 
-        // TODO - should we make this a batch of ECOC updates?
-        auto ecocInsertReply = uassertStatusOK(queryImpl->insertDocument(
-            nssEcoc,
-            ECOCCollection::generateDocument(payload.fieldPathName,
-                                             payload.payload.getEncryptedTokens()),
-            pStmtId,
-            false,
-            bypassDocumentValidation));
-        checkWriteErrors(ecocInsertReply);
-    }
+    NamespaceString nssEcoc(edcNss.db(), efc.getEcocCollection().get());
+    auto ecocInsertReply = uassertStatusOK(queryImpl->insertDocuments(
+        nssEcoc, std::move(ecocDocs), std::move(ecocStmtIds), false, bypassDocumentValidation));
+    checkWriteErrors(ecocInsertReply);
 }
 
 void processRemovedFields(FLEQueryInterface* queryImpl,
@@ -1299,14 +1316,41 @@ uint64_t FLEQueryInterfaceImpl::countDocuments(const NamespaceString& nss) {
     return static_cast<uint64_t>(signedDocCount);
 }
 
+std::vector<StmtId> getStmtIdsForInsert(size_t numDocs, StmtId* pStmtId) {
+    std::vector<StmtId> stmtIds;
+    stmtIds.reserve(numDocs);
+    for (size_t i = 0; i < numDocs; ++i) {
+        if (*pStmtId != kUninitializedStmtId) {
+            stmtIds.push_back((*pStmtId)++);
+        } else {
+            stmtIds.push_back(kUninitializedStmtId);
+        }
+    }
+    return stmtIds;
+}
+
 StatusWith<write_ops::InsertCommandReply> FLEQueryInterfaceImpl::insertDocument(
     const NamespaceString& nss,
     BSONObj obj,
     StmtId* pStmtId,
     bool translateDuplicateKey,
     bool bypassDocumentValidation) {
+    return insertDocuments(nss,
+                           {std::move(obj)},
+                           getStmtIdsForInsert(1, pStmtId),
+                           translateDuplicateKey,
+                           bypassDocumentValidation);
+}
+
+StatusWith<write_ops::InsertCommandReply> FLEQueryInterfaceImpl::insertDocuments(
+    const NamespaceString& nss,
+    std::vector<BSONObj> objs,
+    std::vector<StmtId> stmtIds,
+    bool translateDuplicateKey,
+    bool bypassDocumentValidation) {
+    invariant(objs.size() == stmtIds.size());
     write_ops::InsertCommandRequest insertRequest(nss);
-    insertRequest.setDocuments({obj});
+    insertRequest.setDocuments(std::move(objs));
 
     EncryptionInformation encryptionInformation;
     encryptionInformation.setCrudProcessed(true);
@@ -1317,12 +1361,8 @@ StatusWith<write_ops::InsertCommandReply> FLEQueryInterfaceImpl::insertDocument(
     insertRequest.getWriteCommandRequestBase().setBypassDocumentValidation(
         bypassDocumentValidation);
 
-    int32_t stmtId = *pStmtId;
-    if (stmtId != kUninitializedStmtId) {
-        (*pStmtId)++;
-    }
-
-    auto response = _txnClient.runCRUDOp(BatchedCommandRequest(insertRequest), {stmtId}).get();
+    auto response =
+        _txnClient.runCRUDOp(BatchedCommandRequest(insertRequest), std::move(stmtIds)).get();
 
     auto status = response.toStatus();
 
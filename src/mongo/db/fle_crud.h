@@ -232,6 +232,13 @@ bool shouldDoFLERewrite(const T& cmd) {
         cmd.getEncryptionInformation();
 }
 
+/**
+ * Returns the statement ids for inserting 'numDocs' documents with a single insert command, one
+ * per document. If '*pStmtId' is initialized, the ids are consecutive from it and '*pStmtId' is
+ * advanced past them.
+ */
+std::vector<StmtId> getStmtIdsForInsert(size_t numDocs, StmtId* pStmtId);
+
 /**
  * Abstraction layer for FLE
  */
@@ -267,6 +274,20 @@ public:
         bool translateDuplicateKey,
         bool bypassDocumentValidation = false) = 0;
 
+    /**
+     * Insert a batch of documents into the given collection with a single write command. 'stmtIds'
+     * holds the statement id of each document in 'objs'; getStmtIdsForInsert() builds them.
+     *
+     * If translateDuplicateKey == true and the insert returns DuplicateKey, returns
+     * FLEStateCollectionContention instead.
+     */
+    virtual StatusWith<write_ops::InsertCommandReply> insertDocuments(
+        const NamespaceString& nss,
+        std::vector<BSONObj> objs,
+        std::vector<StmtId> stmtIds,
+        bool translateDuplicateKey,
+        bool bypassDocumentValidation = false) = 0;
+
     /**
      * Delete a single document with the given query.
      *
@@ -336,6 +357,13 @@ public:
         bool translateDuplicateKey,
         bool bypassDocumentValidation = false) final;
 
+    StatusWith<write_ops::InsertCommandReply> insertDocuments(
+        const NamespaceString& nss,
+        std::vector<BSONObj> objs,
+        std::vector<StmtId> stmtIds,
+        bool translateDuplicateKey,
+        bool bypassDocumentValidation = false) final;
+
     std::pair<write_ops::DeleteCommandReply, BSONObj> deleteWithPreimage(
         const NamespaceString& nss,
         const EncryptionInformation& ei,
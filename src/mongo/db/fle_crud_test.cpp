@@ -958,6 +958,26 @@ TEST_F(FleCrudTest, UpdateOneReplace) {
                                 << "top secret"));
 }
 
+// Update only unencrypted fields of one document
+TEST_F(FleCrudTest, UpdateOnlyPlainText) {
+
+    doSingleInsert(1,
+                   BSON("encrypted"
+                        << "secret"));
+
+    assertDocumentCounts(1, 1, 0, 1);
+
+    doSingleUpdateWithUpdateDoc(1, BSON("$inc" << BSON("counter" << 1)));
+
+    assertDocumentCounts(1, 1, 0, 1);
+
+    validateDocument(1,
+                     BSON("_id" << 1 << "counter" << 2 << "plainText"
+                                << "sample"
+                                << "encrypted"
+                                << "secret"));
+}
+
 // Rename safeContent
 TEST_F(FleCrudTest, RenameSafeContent) {
 
@@ -1037,6 +1057,31 @@ TEST_F(FleCrudTest, FindAndModify_UpdateOne) {
                                 << "top secret"));
 }
 
+// Update only unencrypted fields of one document via findAndModify
+TEST_F(FleCrudTest, FindAndModify_UpdateOnlyPlainText) {
+
+    doSingleInsert(1,
+                   BSON("encrypted"
+                        << "secret"));
+
+    assertDocumentCounts(1, 1, 0, 1);
+
+    write_ops::FindAndModifyCommandRequest req(_edcNs);
+    req.setQuery(BSON("_id" << 1));
+    req.setUpdate(write_ops::UpdateModification(BSON("$inc" << BSON("counter" << 1)),
+                                                write_ops::UpdateModification::ClassicTag{},
+                                                false));
+    doFindAndModify(req);
+
+    assertDocumentCounts(1, 1, 0, 1);
+
+    validateDocument(1,
+                     BSON("_id" << 1 << "counter" << 2 << "plainText"
+                                << "sample"
+                                << "encrypted"
+                                << "secret"));
+}
+
 // Insert and delete one document via findAndModify
 TEST_F(FleCrudTest, FindAndModify_InsertAndDeleteOne) {
     auto doc = BSON("encrypted"
@@ -1080,6 +1125,17 @@ TEST_F(FleCrudTest, FindAndModify_RenameSafeContent) {
     ASSERT_THROWS_CODE(doFindAndModify(req), DBException, 6371506);
 }
 
+TEST(FleCrudStmtIdsTest, OneStmtIdPerInsertedDocument) {
+    StmtId stmtId = 5;
+    ASSERT(getStmtIdsForInsert(3, &stmtId) == std::vector<StmtId>({5, 6, 7}));
+    ASSERT_EQ(stmtId, 8);
+
+    stmtId = kUninitializedStmtId;
+    ASSERT(getStmtIdsForInsert(2, &stmtId) ==
+           std::vector<StmtId>({kUninitializedStmtId, kUninitializedStmtId}));
+    ASSERT_EQ(stmtId, kUninitializedStmtId);
+}
+
 TEST_F(FleCrudTest, validateTagsTest) {
     testValidateTags(BSON(kSafeContent << BSON_ARRAY(123)));
     ASSERT_THROWS_CODE(testValidateTags(BSON(kSafeContent << "foo")), DBException, 6371507);
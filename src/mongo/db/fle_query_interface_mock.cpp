@@ -31,6 +31,9 @@
 
 #include "mongo/db/fle_query_interface_mock.h"
 
+#include "mongo/db/ops/write_ops.h"
+#include "mongo/db/repl/oplog.h"
+
 namespace mongo {
 
 BSONObj FLEQueryInterfaceMock::getById(const NamespaceString& nss, BSONElement element) {
@@ -71,6 +74,36 @@ StatusWith<write_ops::InsertCommandReply> FLEQueryInterfaceMock::insertDocument(
     return write_ops::InsertCommandReply();
 }
 
+StatusWith<write_ops::InsertCommandReply> FLEQueryInterfaceMock::insertDocuments(
+    const NamespaceString& nss,
+    std::vector<BSONObj> objs,
+    std::vector<StmtId> stmtIds,
+    bool translateDuplicateKey,
+    bool bypassDocumentValidation) {
+    // Validate the batch the way the server validates the insert command which
+    // FLEQueryInterfaceImpl sends for it.
+    write_ops::InsertCommandRequest insertRequest(nss);
+    insertRequest.setDocuments(objs);
+    insertRequest.getWriteCommandRequestBase().setStmtIds(std::move(stmtIds));
+    try {
+        write_ops::InsertOp::validate(insertRequest);
+    } catch (const DBException& ex) {
+        return ex.toStatus();
+    }
+
+    std::vector<InsertStatement> inserts;
+    for (auto& obj : objs) {
+        inserts.emplace_back(std::move(obj));
+    }
+
+    auto status = _storage->insertDocuments(_opCtx, nss, inserts);
+    if (!status.isOK()) {
+        return status;
+    }
+
+    return write_ops::InsertCommandReply();
+}
+
 std::pair<write_ops::DeleteCommandReply, BSONObj> FLEQueryInterfaceMock::deleteWithPreimage(
     const NamespaceString& nss,
     const EncryptionInformation& ei,
@@ -54,6 +54,13 @@ public:
         bool translateDuplicateKey,
         bool bypassDocumentValidation = false) final;
 
+    StatusWith<write_ops::InsertCommandReply> insertDocuments(
+        const NamespaceString& nss,
+        std::vector<BSONObj> objs,
+        std::vector<StmtId> stmtIds,
+        bool translateDuplicateKey,
+        bool bypassDocumentValidation = false) final;
+
     std::pair<write_ops::DeleteCommandReply, BSONObj> deleteWithPreimage(
         const NamespaceString& nss,
         const EncryptionInformation& ei,
@@ -27,6 +27,8 @@
  *    it in the license file.
  */
 
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kFTDC
+
 #include "mongo/platform/basic.h"
 
 #include "mongo/db/ftdc/collector.h"
@@ -39,6 +41,8 @@
 #include "mongo/db/ftdc/util.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/logv2/log.h"
+#include "mongo/logv2/log_severity_suppressor.h"
 #include "mongo/util/time_support.h"
 
 namespace mongo {
@@ -48,7 +52,8 @@ void FTDCCollectorCollection::add(std::unique_ptr<FTDCCollectorInterface> collec
     _collectors.emplace_back(std::move(collector));
 }
 
-std::tuple<BSONObj, Date_t> FTDCCollectorCollection::collect(Client* client) {
+std::tuple<BSONObj, Date_t> FTDCCollectorCollection::collect(Client* client,
+                                                             Milliseconds slowCollectorThreshold) {
     // If there are no collectors, just return an empty BSONObj so that that are caller knows we did
     // not collect anything
     if (_collectors.empty()) {
@@ -95,6 +100,20 @@ std::tuple<BSONObj, Date_t> FTDCCollectorCollection::collect(Client* client) {
         end = client->getServiceContext()->getPreciseClockSource()->now();
         subObjBuilder.appendDate(kFTDCCollectEndField, end);
 
+        if (end - now > slowCollectorThreshold) {
+            // A collector that is slow once is usually slow on every pass, so log at Info() at
+            // most once a second and at Debug(2) otherwise.
+            static auto& bumpedSeverity = *new logv2::SeveritySuppressor{
+                Seconds{1}, logv2::LogSeverity::Info(), logv2::LogSeverity::Debug(2)};
+            LOGV2_DEBUG(7027514,
+                        bumpedSeverity().toInt(),
+                        "Slow diagnostic data collector",
+                        "collector"_attr = collector->name(),
+                        "durationMillis"_attr = durationCount<Milliseconds>(end - now),
+                        "thresholdMillis"_attr =
+                            durationCount<Milliseconds>(slowCollectorThreshold));
+        }
+
         // Ensure the collector did not set a read timestamp.
         invariant(opCtx->recoveryUnit()->getTimestampReadSource() ==
                   RecoveryUnit::ReadSource::kNoTimestamp);
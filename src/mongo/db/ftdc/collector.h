@@ -34,6 +34,8 @@
 #include <tuple>
 #include <vector>
 
+#include "mongo/util/duration.h"
+
 
 namespace mongo {
 
@@ -116,8 +118,11 @@ public:
      *    ...
      *    "end" : Date_t,      <- Time at which all collecting ended
      * }
+     *
+     * Logs each collector which takes longer than 'slowCollectorThreshold' to collect.
      */
-    std::tuple<BSONObj, Date_t> collect(Client* client);
+    std::tuple<BSONObj, Date_t> collect(Client* client,
+                                        Milliseconds slowCollectorThreshold = Milliseconds::max());
 
 private:
     // collection of collectors
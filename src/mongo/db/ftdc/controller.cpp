@@ -246,7 +246,8 @@ void FTDCController::doLoop() noexcept {
                 _mgr = uassertStatusOK(std::move(swMgr));
             }
 
-            auto collectSample = _periodicCollectors.collect(client);
+            // A collector that takes longer than a whole period causes samples to be skipped.
+            auto collectSample = _periodicCollectors.collect(client, _config.period);
 
             Status s = _mgr->writeSampleAndRotateIfNeeded(
                 client, std::get<0>(collectSample), std::get<1>(collectSample));
@@ -0,0 +1,304 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kFTDC
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/ftdc/ftdc_cpu_profiler.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <mutex>
+
+#include "mongo/config.h"
+
+// The samples are captured with libunwind, whose unw_backtrace() is async-signal-safe, unlike the
+// backtrace() of glibc.
+#if defined(__linux__) && defined(MONGO_CONFIG_USE_LIBUNWIND)
+#define MONGO_CPU_PROFILER_SUPPORTED
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <signal.h>
+#include <sys/time.h>
+#endif
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/ftdc/ftdc_server.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/logv2/log.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/errno_util.h"
+#include "mongo/util/stacktrace.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+namespace cpu_profiler_detail {
+namespace {
+
+/**
+ * One sample in the ring buffer. The slot for the sample with ticket 't' is 'kNumSampleSlots'-way
+ * shared with the samples of other tickets, so 'sequence' is used as a seqlock: the writer sets it
+ * to 2t+1 while it writes the frames and to 2t+2 once they are complete, and the reader only keeps
+ * the frames if it sees 2t+2 both before and after copying them.
+ */
+struct SampleSlot {
+    AtomicWord<uint64_t> sequence{0};
+    int depth = 0;
+    std::array<void*, kMaxStackDepth> frames;
+};
+
+std::array<SampleSlot, kNumSampleSlots> sampleSlots;
+AtomicWord<uint64_t> nextWriteTicket{0};
+uint64_t nextReadTicket = 0;
+
+AtomicWord<long long> samplesCount{0};
+AtomicWord<long long> droppedSamplesCount{0};
+
+}  // namespace
+
+void recordStack(void* const* frames, size_t depth) {
+    const uint64_t ticket = nextWriteTicket.fetchAndAdd(1);
+    auto& slot = sampleSlots[ticket % kNumSampleSlots];
+    slot.sequence.store(2 * ticket + 1);
+
+    slot.depth = std::min(depth, kMaxStackDepth);
+    std::copy(frames, frames + slot.depth, slot.frames.begin());
+
+    slot.sequence.store(2 * ticket + 2);
+}
+
+void drainSamples(StackCounts* stacks) {
+    const uint64_t end = nextWriteTicket.load();
+    if (end - nextReadTicket > kNumSampleSlots) {
+        // The writers have lapped the reader, so the oldest samples are gone.
+        droppedSamplesCount.fetchAndAdd(end - nextReadTicket - kNumSampleSlots);
+        nextReadTicket = end - kNumSampleSlots;
+    }
+
+    for (; nextReadTicket != end; ++nextReadTicket) {
+        const auto& slot = sampleSlots[nextReadTicket % kNumSampleSlots];
+        const uint64_t complete = 2 * nextReadTicket + 2;
+
+        const uint64_t before = slot.sequence.load();
+        if (before < complete) {
+            // Still being written. Pick it up on the next call.
+            break;
+        }
+        std::vector<void*> frames(slot.frames.begin(), slot.frames.begin() + slot.depth);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (before != complete || slot.sequence.loadRelaxed() != complete) {
+            droppedSamplesCount.fetchAndAdd(1);
+            continue;
+        }
+
+        samplesCount.fetchAndAdd(1);
+        if (!frames.empty()) {
+            ++(*stacks)[std::move(frames)];
+        }
+    }
+}
+
+long long numSamples() {
+    return samplesCount.load();
+}
+
+long long numDroppedSamples() {
+    return droppedSamplesCount.load();
+}
+
+void writeFoldedStacks(const StackCounts& stacks,
+                       const std::function<std::string(void*)>& symbolize,
+                       std::ostream& out) {
+    // Symbolize each distinct address once per file, so that memory does not grow with uptime.
+    std::map<void*, std::string> symbols;
+    for (auto&& [frames, count] : stacks) {
+        // The folded format lists the outermost frame first.
+        for (auto it = frames.rbegin(); it != frames.rend(); ++it) {
+            auto symbol = symbols.find(*it);
+            if (symbol == symbols.end()) {
+                auto name = symbolize(*it);
+                // ';' separates frames and ' ' separates the stack from its count.
+                std::replace(name.begin(), name.end(), ';', ':');
+                std::replace(name.begin(), name.end(), ' ', '_');
+                symbol = symbols.emplace(*it, std::move(name)).first;
+            }
+            if (it != frames.rbegin()) {
+                out << ';';
+            }
+            out << symbol->second;
+        }
+        out << ' ' << count << '\n';
+    }
+}
+
+}  // namespace cpu_profiler_detail
+
+namespace {
+
+constexpr auto kProfileFilePrefix = "cpu-profile."_sd;
+
+AtomicWord<int> cpuProfilerSampleHz{0};
+
+#if defined(MONGO_CPU_PROFILER_SUPPORTED)
+
+// The frames of the signal handler itself and of the signal trampoline.
+constexpr size_t kSkippedFrames = 2;
+
+void recordSample(int, siginfo_t*, void*) {
+    // Only async-signal-safe work is allowed here.
+    const int savedErrno = errno;
+
+    std::array<void*, cpu_profiler_detail::kMaxStackDepth + kSkippedFrames> frames;
+    const size_t depth = rawBacktrace(frames.data(), frames.size());
+    const size_t skipped = std::min(depth, kSkippedFrames);
+    cpu_profiler_detail::recordStack(frames.data() + skipped, depth - skipped);
+
+    errno = savedErrno;
+}
+
+#endif  // defined(MONGO_CPU_PROFILER_SUPPORTED)
+
+std::string symbolize(void* addr) {
+#if defined(MONGO_CPU_PROFILER_SUPPORTED)
+    Dl_info info;
+    if (dladdr(addr, &info) && info.dli_sname) {
+        int status;
+        char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+        std::string name = status == 0 ? demangled : info.dli_sname;
+        std::free(demangled);
+        return name;
+    }
+#endif
+    return str::stream() << addr;
+}
+
+void removeOldProfiles(const boost::filesystem::path& dir) {
+    std::vector<boost::filesystem::path> profiles;
+    for (boost::filesystem::directory_iterator it(dir), end; it != end; ++it) {
+        if (StringData(it->path().filename().string()).startsWith(kProfileFilePrefix)) {
+            profiles.push_back(it->path());
+        }
+    }
+    if (profiles.size() <= FTDCCpuProfileCollector::kMaxProfileFiles) {
+        return;
+    }
+
+    // The file names embed the time at which they were written, so they sort by age.
+    std::sort(profiles.begin(), profiles.end());
+    for (size_t i = 0; i < profiles.size() - FTDCCpuProfileCollector::kMaxProfileFiles; ++i) {
+        boost::system::error_code ec;
+        boost::filesystem::remove(profiles[i], ec);
+    }
+}
+
+}  // namespace
+
+Status setCpuProfilerSampleHz(int hz) {
+#if defined(MONGO_CPU_PROFILER_SUPPORTED)
+    static std::once_flag installHandler;
+    std::call_once(installHandler, [] {
+        struct sigaction sa = {};
+        sa.sa_sigaction = recordSample;
+        sa.sa_flags = SA_SIGINFO | SA_RESTART;
+        sigemptyset(&sa.sa_mask);
+        invariant(sigaction(SIGPROF, &sa, nullptr) == 0);
+    });
+
+    struct itimerval timer = {};
+    if (hz > 0) {
+        timer.it_interval.tv_usec = 1000 * 1000 / hz;
+        timer.it_value = timer.it_interval;
+    }
+    if (setitimer(ITIMER_PROF, &timer, nullptr) != 0) {
+        auto ec = lastSystemError();
+        return Status(ErrorCodes::InternalError,
+                      str::stream() << "Failed to set the CPU profiler timer: "
+                                    << errorMessage(ec));
+    }
+
+    cpuProfilerSampleHz.store(hz);
+    return Status::OK();
+#else
+    if (hz == 0) {
+        return Status::OK();
+    }
+    return Status(ErrorCodes::IllegalOperation,
+                  "The CPU profiler is only supported on Linux builds which use libunwind");
+#endif
+}
+
+bool FTDCCpuProfileCollector::hasData() const {
+    return cpuProfilerSampleHz.load() > 0 || !_stacks.empty();
+}
+
+void FTDCCpuProfileCollector::collect(OperationContext* opCtx, BSONObjBuilder& builder) {
+    cpu_profiler_detail::drainSamples(&_stacks);
+
+    builder.append("samples", cpu_profiler_detail::numSamples());
+    builder.append("droppedSamples", cpu_profiler_detail::numDroppedSamples());
+
+    const auto now = opCtx->getServiceContext()->getFastClockSource()->now();
+    if (_lastFlush == Date_t()) {
+        _lastFlush = now;
+    } else if (now - _lastFlush >= kFlushInterval) {
+        _flush(now);
+    }
+}
+
+void FTDCCpuProfileCollector::_flush(Date_t now) {
+    _lastFlush = now;
+    if (_stacks.empty()) {
+        return;
+    }
+
+    auto dir = getFTDCDirectoryPathParameter();
+    if (dir.empty()) {
+        _stacks.clear();
+        return;
+    }
+
+    auto path = dir / (kProfileFilePrefix + terseCurrentTimeForFilename(true) + ".folded");
+    std::ofstream out(path.string());
+    cpu_profiler_detail::writeFoldedStacks(_stacks, symbolize, out);
+
+    _stacks.clear();
+    if (!out) {
+        LOGV2_WARNING(7027501, "Failed to write CPU profile", "path"_attr = path.string());
+        return;
+    }
+
+    out.close();
+    removeOldProfiles(dir);
+}
+
+}  // namespace mongo
@@ -0,0 +1,119 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <functional>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "mongo/base/status.h"
+#include "mongo/db/ftdc/collector.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+namespace cpu_profiler_detail {
+
+constexpr size_t kMaxStackDepth = 64;
+constexpr size_t kNumSampleSlots = 4096;
+
+// Number of samples per distinct stack, innermost frame first.
+using StackCounts = std::map<std::vector<void*>, long long>;
+
+/**
+ * Records a sample of the 'depth' frames starting at 'frames' in the fixed-size ring buffer,
+ * keeping at most 'kMaxStackDepth' of them. Async-signal-safe, and safe to call from several
+ * threads.
+ */
+void recordStack(void* const* frames, size_t depth);
+
+/**
+ * Adds the samples recorded since the last call to 'stacks'. Samples which were overwritten before
+ * they were read are counted as dropped. Must not be called concurrently with itself.
+ */
+void drainSamples(StackCounts* stacks);
+
+/**
+ * The number of samples drained, and the number of samples dropped, since the process started.
+ */
+long long numSamples();
+long long numDroppedSamples();
+
+/**
+ * Writes 'stacks' to 'out' in the folded stack format read by flame graph tools: one line per
+ * stack, listing the names 'symbolize' gives its frames from the outermost to the innermost,
+ * separated by ';', followed by a space and the number of samples.
+ */
+void writeFoldedStacks(const StackCounts& stacks,
+                       const std::function<std::string(void*)>& symbolize,
+                       std::ostream& out);
+
+}  // namespace cpu_profiler_detail
+
+/**
+ * Starts, reconfigures or, if 'hz' is 0, stops the sampling CPU profiler. While it runs, a
+ * process-wide ITIMER_PROF timer delivers SIGPROF 'hz' times per second of CPU time consumed by the
+ * process, and the signal handler records the interrupted thread's stack in a fixed-size ring
+ * buffer. Only supported on Linux builds which use libunwind.
+ */
+Status setCpuProfilerSampleHz(int hz);
+
+/**
+ * A periodic FTDC collector which drains the samples recorded by the CPU profiler and aggregates
+ * them by stack. Only the sample and drop counters are added to the FTDC document, so that the
+ * metrics schema stays stable. Every 'kFlushInterval', the aggregated stacks are symbolized and
+ * written to the diagnostic data directory as a 'cpu-profile.<date>.folded' file, in the folded
+ * stack format read by flame graph tools, and the oldest of these files are removed so that at
+ * most 'kMaxProfileFiles' remain.
+ */
+class FTDCCpuProfileCollector final : public FTDCCollectorInterface {
+public:
+    static constexpr Seconds kFlushInterval{60};
+    static constexpr size_t kMaxProfileFiles = 10;
+
+    std::string name() const override {
+        return "cpuProfile";
+    }
+
+    bool hasData() const override;
+
+    void collect(OperationContext* opCtx, BSONObjBuilder& builder) override;
+
+private:
+    void _flush(Date_t now);
+
+    // Number of samples per distinct stack since the last flush.
+    cpu_profiler_detail::StackCounts _stacks;
+
+    Date_t _lastFlush;
+};
+
+}  // namespace mongo
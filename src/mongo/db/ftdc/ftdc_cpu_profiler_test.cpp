@@ -0,0 +1,142 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/ftdc/ftdc_cpu_profiler.h"
+
+#include <sstream>
+
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace cpu_profiler_detail {
+namespace {
+
+void* frame(uintptr_t address) {
+    return reinterpret_cast<void*>(address);
+}
+
+class FTDCCpuProfilerTest : public unittest::Test {
+public:
+    void setUp() override {
+        // The ring buffer is process-wide, so catch up with the samples of earlier tests.
+        StackCounts stacks;
+        drainSamples(&stacks);
+    }
+};
+
+TEST_F(FTDCCpuProfilerTest, DrainAggregatesSamplesByStack) {
+    const auto samplesBefore = numSamples();
+    const auto droppedBefore = numDroppedSamples();
+
+    std::vector<void*> first{frame(1), frame(2), frame(3)};
+    std::vector<void*> second{frame(1), frame(4)};
+    recordStack(first.data(), first.size());
+    recordStack(second.data(), second.size());
+    recordStack(first.data(), first.size());
+    recordStack(nullptr, 0);
+
+    StackCounts stacks;
+    drainSamples(&stacks);
+    ASSERT_EQ(stacks.size(), 2U);
+    ASSERT_EQ(stacks[first], 2);
+    ASSERT_EQ(stacks[second], 1);
+
+    // Empty stacks are counted, but not kept.
+    ASSERT_EQ(numSamples() - samplesBefore, 4);
+    ASSERT_EQ(numDroppedSamples() - droppedBefore, 0);
+
+    // Samples are only drained once.
+    stacks.clear();
+    drainSamples(&stacks);
+    ASSERT(stacks.empty());
+}
+
+TEST_F(FTDCCpuProfilerTest, DrainTruncatesDeepStacks) {
+    std::vector<void*> deep;
+    for (size_t i = 0; i < kMaxStackDepth + 10; ++i) {
+        deep.push_back(frame(i + 1));
+    }
+    recordStack(deep.data(), deep.size());
+
+    StackCounts stacks;
+    drainSamples(&stacks);
+    ASSERT_EQ(stacks.size(), 1U);
+    ASSERT_EQ(stacks.begin()->first.size(), kMaxStackDepth);
+    ASSERT(stacks.begin()->first.front() == frame(1));
+}
+
+TEST_F(FTDCCpuProfilerTest, DrainCountsOverwrittenSamplesAsDropped) {
+    const auto samplesBefore = numSamples();
+    const auto droppedBefore = numDroppedSamples();
+
+    std::vector<void*> stack{frame(1)};
+    for (size_t i = 0; i < kNumSampleSlots + 10; ++i) {
+        recordStack(stack.data(), stack.size());
+    }
+
+    StackCounts stacks;
+    drainSamples(&stacks);
+    ASSERT_EQ(stacks[stack], static_cast<long long>(kNumSampleSlots));
+    ASSERT_EQ(numSamples() - samplesBefore, static_cast<long long>(kNumSampleSlots));
+    ASSERT_EQ(numDroppedSamples() - droppedBefore, 10);
+}
+
+TEST(FTDCCpuProfilerFoldedStacksTest, WritesOutermostFrameFirst) {
+    StackCounts stacks;
+    stacks[{frame(3), frame(2), frame(1)}] = 5;
+    stacks[{frame(4), frame(1)}] = 2;
+
+    std::ostringstream out;
+    writeFoldedStacks(
+        stacks,
+        [](void* address) {
+            switch (reinterpret_cast<uintptr_t>(address)) {
+                case 1:
+                    return std::string("main");
+                case 2:
+                    return std::string("mongo::run(int)");
+                case 3:
+                    return std::string("std::map<int;int>::find");
+                default:
+                    return std::string("leaf");
+            }
+        },
+        out);
+
+    // Separators in names are replaced, so that each line still splits into frames and a count.
+    ASSERT_EQ(out.str(),
+              "main;mongo::run(int);std::map<int:int>::find 5\n"
+              "main;leaf 2\n");
+}
+
+}  // namespace
+}  // namespace cpu_profiler_detail
+}  // namespace mongo
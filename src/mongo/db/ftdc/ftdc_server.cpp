@@ -41,6 +41,7 @@
 #include "mongo/db/ftdc/collector.h"
 #include "mongo/db/ftdc/config.h"
 #include "mongo/db/ftdc/controller.h"
+#include "mongo/db/ftdc/ftdc_cpu_profiler.h"
 #include "mongo/db/ftdc/ftdc_server_gen.h"
 #include "mongo/db/ftdc/ftdc_system_stats.h"
 #include "mongo/db/jsobj.h"
@@ -117,6 +118,10 @@ Status onUpdateFTDCPeriod(const std::int32_t potentialNewValue) {
     return Status::OK();
 }
 
+Status onUpdateFTDCCpuProfilerSampleHz(const std::int32_t potentialNewValue) {
+    return setCpuProfilerSampleHz(potentialNewValue);
+}
+
 Status onUpdateFTDCDirectorySize(const std::int32_t potentialNewValue) {
     if (potentialNewValue < ftdcStartupParams.maxFileSizeMB.load()) {
         return Status(
@@ -244,6 +249,7 @@ public:
             BSONObjBuilder subObjBuilder(commandBuilder.subobjStart("opLatencies"));
             subObjBuilder.append("histograms", true);
             subObjBuilder.append("slowBuckets", true);
+            subObjBuilder.append("percentiles", true);
         }
 
         if (gDiagnosticDataCollectionVerboseTCMalloc.load()) {
@@ -307,6 +313,7 @@ void startFTDC(boost::filesystem::path& path,
     // NOTE: For each command here, there must be an equivalent privilege check in
     // GetDiagnosticDataCommand
     controller->addPeriodicCollector(std::make_unique<FTDCServerStatusCommandCollector>());
+    controller->addPeriodicCollector(std::make_unique<FTDCCpuProfileCollector>());
 
     registerCollectors(controller.get());
 
@@ -133,6 +133,7 @@ Status onUpdateFTDCDirectorySize(std::int32_t value);
 Status onUpdateFTDCFileSize(std::int32_t value);
 Status onUpdateFTDCSamplesPerChunk(std::int32_t value);
 Status onUpdateFTDCPerInterimUpdate(std::int32_t value);
+Status onUpdateFTDCCpuProfilerSampleHz(std::int32_t value);
 
 /**
  * Server Parameter accessors
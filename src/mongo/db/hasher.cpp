@@ -33,6 +33,8 @@
 
 #include "mongo/db/hasher.h"
 
+#include <array>
+#include <cstring>
 
 #include "mongo/db/jsobj.h"
 #include "mongo/util/md5.hpp"
@@ -76,8 +78,17 @@ private:
     template <typename T>
     void addIntegerData(T number);
 
+    // Hand any staged bytes to md5_append().
+    void flush();
+
     md5_state_t _md5State;
     HashSeed _seed;
+
+    // Most of the input arrives in pieces of a few bytes (the seed, type tags, numbers and short
+    // values). These are staged here and passed to md5_append() together rather than one call per
+    // piece. The digest is unchanged since MD5 only sees the concatenated input.
+    std::array<md5_byte_t, 64> _staged;
+    size_t _numStaged = 0;
 };
 
 Hasher::Hasher(HashSeed seed) : _seed(seed) {
@@ -86,7 +97,22 @@ Hasher::Hasher(HashSeed seed) : _seed(seed) {
 }
 
 void Hasher::addData(const void* keyData, size_t numBytes) {
-    md5_append(&_md5State, static_cast<const md5_byte_t*>(keyData), numBytes);
+    if (numBytes > _staged.size() - _numStaged) {
+        flush();
+        if (numBytes >= _staged.size()) {
+            md5_append(&_md5State, static_cast<const md5_byte_t*>(keyData), numBytes);
+            return;
+        }
+    }
+    std::memcpy(_staged.data() + _numStaged, keyData, numBytes);
+    _numStaged += numBytes;
+}
+
+void Hasher::flush() {
+    if (_numStaged) {
+        md5_append(&_md5State, _staged.data(), _numStaged);
+        _numStaged = 0;
+    }
 }
 
 template <typename T>
@@ -96,6 +122,7 @@ void Hasher::addIntegerData(T number) {
 }
 
 void Hasher::finish(HashDigest out) {
+    flush();
     md5_finish(&_md5State, out);
 }
 
@@ -33,6 +33,7 @@
 
 #include "mongo/db/index/index_access_method.h"
 
+#include <algorithm>
 #include <utility>
 #include <vector>
 
@@ -382,11 +383,20 @@ Status SortedDataIndexAccessMethod::insertKeys(OperationContext* opCtx,
         dupsAllowed = !unique;
     }
     // Add all new keys into the index. The RecordId for each is already encoded in the KeyString.
-    for (const auto& keyString : keys) {
-        auto status = _newInterface->insert(opCtx, keyString, dupsAllowed);
+    // The keys are sorted, so they are inserted as a batch which is only interrupted by a key that
+    // fails to insert.
+    for (auto it = keys.begin(); it != keys.end(); ++it) {
+        size_t numBatchInserted = 0;
+        auto status =
+            _newInterface->insertBatch(opCtx, it, keys.end(), dupsAllowed, &numBatchInserted);
+        it += numBatchInserted;
+        if (status.isOK()) {
+            break;
+        }
 
         // When duplicates are encountered and allowed, retry with dupsAllowed. Call
         // onDuplicateKey() with the inserted duplicate key.
+        const auto& keyString = *it;
         if (ErrorCodes::DuplicateKey == status.code() && options.dupsAllowed && !prepareUnique) {
             invariant(unique);
 
@@ -447,42 +457,42 @@ Status SortedDataIndexAccessMethod::initializeAsEmpty(OperationContext* opCtx) {
     return _newInterface->initAsEmpty(opCtx);
 }
 
+KeyString::Value SortedDataIndexAccessMethod::_makeLookupKey(OperationContext* opCtx,
+                                                             const CollectionPtr& collection,
+                                                             const BSONObj& requestedKey) const {
+    if (_indexCatalogEntry->getCollator()) {
+        // For performance, call get keys only if there is a non-simple collation.
+        SharedBufferFragmentBuilder pooledBuilder(
+            KeyString::HeapBuilder::kHeapAllocatorDefaultBytes);
+        auto& executionCtx = StorageExecutionContext::get(opCtx);
+        auto keys = executionCtx.keys();
+        KeyStringSet* multikeyMetadataKeys = nullptr;
+        MultikeyPaths* multikeyPaths = nullptr;
+
+        getKeys(opCtx,
+                collection,
+                pooledBuilder,
+                requestedKey,
+                InsertDeleteOptions::ConstraintEnforcementMode::kEnforceConstraints,
+                GetKeysContext::kAddingKeys,
+                keys.get(),
+                multikeyMetadataKeys,
+                multikeyPaths,
+                boost::none /* loc */);
+        invariant(keys->size() == 1);
+        return *keys->begin();
+    }
+
+    KeyString::HeapBuilder requestedKeyString(getSortedDataInterface()->getKeyStringVersion(),
+                                              BSONObj::stripFieldNames(requestedKey),
+                                              getSortedDataInterface()->getOrdering());
+    return requestedKeyString.release();
+}
+
 RecordId SortedDataIndexAccessMethod::findSingle(OperationContext* opCtx,
                                                  const CollectionPtr& collection,
                                                  const BSONObj& requestedKey) const {
-    // Generate the key for this index.
-    KeyString::Value actualKey = [&]() {
-        if (_indexCatalogEntry->getCollator()) {
-            // For performance, call get keys only if there is a non-simple collation.
-            SharedBufferFragmentBuilder pooledBuilder(
-                KeyString::HeapBuilder::kHeapAllocatorDefaultBytes);
-            auto& executionCtx = StorageExecutionContext::get(opCtx);
-            auto keys = executionCtx.keys();
-            KeyStringSet* multikeyMetadataKeys = nullptr;
-            MultikeyPaths* multikeyPaths = nullptr;
-
-            getKeys(opCtx,
-                    collection,
-                    pooledBuilder,
-                    requestedKey,
-                    InsertDeleteOptions::ConstraintEnforcementMode::kEnforceConstraints,
-                    GetKeysContext::kAddingKeys,
-                    keys.get(),
-                    multikeyMetadataKeys,
-                    multikeyPaths,
-                    boost::none /* loc */);
-            invariant(keys->size() == 1);
-            return *keys->begin();
-        } else {
-            KeyString::HeapBuilder requestedKeyString(
-                getSortedDataInterface()->getKeyStringVersion(),
-                BSONObj::stripFieldNames(requestedKey),
-                getSortedDataInterface()->getOrdering());
-            return requestedKeyString.release();
-        }
-    }();
-
-    if (auto loc = _newInterface->findLoc(opCtx, actualKey)) {
+    if (auto loc = _newInterface->findLoc(opCtx, _makeLookupKey(opCtx, collection, requestedKey))) {
         dassert(!loc->isNull());
         return *loc;
     }
@@ -490,6 +500,28 @@ RecordId SortedDataIndexAccessMethod::findSingle(OperationContext* opCtx,
     return RecordId();
 }
 
+std::vector<RecordId> SortedDataIndexAccessMethod::findMany(
+    OperationContext* opCtx,
+    const CollectionPtr& collection,
+    const std::vector<BSONObj>& requestedKeys) const {
+    std::vector<KeyString::Value> keyStrings;
+    keyStrings.reserve(requestedKeys.size());
+    for (auto&& requestedKey : requestedKeys) {
+        keyStrings.push_back(_makeLookupKey(opCtx, collection, requestedKey));
+    }
+    std::sort(keyStrings.begin(), keyStrings.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.compare(rhs) < 0;
+    });
+    keyStrings.erase(std::unique(keyStrings.begin(),
+                                 keyStrings.end(),
+                                 [](const auto& lhs, const auto& rhs) {
+                                     return lhs.compare(rhs) == 0;
+                                 }),
+                     keyStrings.end());
+
+    return _newInterface->findLocs(opCtx, keyStrings);
+}
+
 void SortedDataIndexAccessMethod::validate(OperationContext* opCtx,
                                            int64_t* numKeys,
                                            IndexValidateResults* fullResults) const {
@@ -705,6 +737,8 @@ public:
                   const KeyHandlerFn& onDuplicateKeyInserted,
                   const RecordIdHandlerFn& onDuplicateRecord) final;
 
+    void finishSorting() final;
+
     const MultikeyPaths& getMultikeyPaths() const final;
 
     bool isMultikey() const final;
@@ -729,6 +763,9 @@ private:
     std::unique_ptr<Sorter> _sorter;
     int64_t _keysInserted = 0;
 
+    // The sorted keys, set by finishSorting() and consumed by commit().
+    std::unique_ptr<Sorter::Iterator> _sortedKeys;
+
     // Set to true if any document added to the BulkBuilder causes the index to become multikey.
     bool _isMultiKey = false;
 
@@ -846,6 +883,15 @@ Status SortedDataIndexAccessMethod::BulkBuilderImpl::insert(
     return Status::OK();
 }
 
+void SortedDataIndexAccessMethod::BulkBuilderImpl::finishSorting() {
+    if (_sortedKeys) {
+        return;
+    }
+
+    _insertMultikeyMetadataKeysIntoSorter();
+    _sortedKeys.reset(_sorter->done());
+}
+
 const MultikeyPaths& SortedDataIndexAccessMethod::BulkBuilderImpl::getMultikeyPaths() const {
     return _indexMultikeyPaths;
 }
@@ -942,8 +988,8 @@ Status SortedDataIndexAccessMethod::BulkBuilderImpl::commit(
     const auto descriptor = _iam->_descriptor;
     auto ns = _iam->_indexCatalogEntry->getNSSFromCatalog(opCtx);
 
-    _insertMultikeyMetadataKeysIntoSorter();
-    std::unique_ptr<Sorter::Iterator> it(_sorter->done());
+    finishSorting();
+    std::unique_ptr<Sorter::Iterator> it(std::move(_sortedKeys));
 
     static constexpr char message[] = "Index Build: inserting keys from external sorter into index";
     ProgressMeterHolder pm;
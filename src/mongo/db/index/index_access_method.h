@@ -213,6 +213,14 @@ public:
                               const KeyHandlerFn& onDuplicateKeyInserted,
                               const RecordIdHandlerFn& onDuplicateRecord) = 0;
 
+        /**
+         * Sorts the inserted keys and merges any spilled ranges, leaving only the inserts into the
+         * index to commit(). No keys may be inserted afterwards. This does not use an
+         * OperationContext, so it may run on a thread other than the one building the index.
+         * Calling this before commit() is optional; commit() performs it if it has not been done.
+         */
+        virtual void finishSorting() = 0;
+
         virtual const MultikeyPaths& getMultikeyPaths() const = 0;
 
         virtual bool isMultikey() const = 0;
@@ -443,6 +451,15 @@ public:
                         const CollectionPtr& collection,
                         const BSONObj& key) const;
 
+    /**
+     * Batched version of findSingle(). Returns the RecordIds of the keys found, in index order.
+     * Looking the keys up in index order lets the storage engine seek forward through a single
+     * cursor.
+     */
+    std::vector<RecordId> findMany(OperationContext* opCtx,
+                                   const CollectionPtr& collection,
+                                   const std::vector<BSONObj>& keys) const;
+
     /**
      * Returns an unpositioned cursor over 'this' index.
      */
@@ -566,6 +583,13 @@ protected:
 private:
     class BulkBuilderImpl;
 
+    /**
+     * Returns the KeyString that 'requestedKey' is stored as in this index, for point lookups.
+     */
+    KeyString::Value _makeLookupKey(OperationContext* opCtx,
+                                    const CollectionPtr& collection,
+                                    const BSONObj& requestedKey) const;
+
     /**
      * Removes a single key from the index.
      *
@@ -33,6 +33,8 @@
 
 #include "mongo/db/index/index_build_interceptor.h"
 
+#include <algorithm>
+#include <tuple>
 #include <vector>
 
 #include "mongo/bson/bsonobj.h"
@@ -155,6 +157,16 @@ Status IndexBuildInterceptor::drainWritesIntoIndex(OperationContext* opCtx,
     invariant(kBatchMaxMB <= std::numeric_limits<int32_t>::max() / kMB);
     const int32_t kBatchMaxBytes = kBatchMaxMB * kMB;
 
+    // Applying a batch in key order turns random index writes into a sequential pass over the
+    // index. Only writes to different keys are reordered, which commute with each other.
+    const bool sortBatchesByKey = indexBuildDrainSortBatchesByKey.load();
+    const auto keyFormat = coll->getRecordStore()->keyFormat();
+    const auto compareKeys = [keyFormat](const KeyString::Value& lhs,
+                                         const KeyString::Value& rhs) {
+        return keyFormat == KeyFormat::Long ? lhs.compareWithoutRecordIdLong(rhs)
+                                            : lhs.compareWithoutRecordIdStr(rhs);
+    };
+
     // In a single WriteUnitOfWork, scan the side table up to the batch or memory limit, apply the
     // keys to the index, and delete the side table records.
     // Returns true if the cursor has reached the end of the table, false if there are more records,
@@ -171,6 +183,10 @@ Status IndexBuildInterceptor::drainWritesIntoIndex(OperationContext* opCtx,
         // table matters.
         std::vector<RecordId> recordsAddedToIndex;
 
+        // Side writes held back to be applied in key order once the batch is complete, along with
+        // their position in the side table.
+        std::vector<std::tuple<KeyString::Value, int32_t, BSONObj>> sortedWrites;
+
         auto record = cursor->next();
         while (record) {
             opCtx->checkForInterrupt();
@@ -192,14 +208,17 @@ Status IndexBuildInterceptor::drainWritesIntoIndex(OperationContext* opCtx,
             batchSize += 1;
             batchSizeBytes += objSize;
 
-            if (auto status = _applyWrite(opCtx,
-                                          coll,
-                                          unownedDoc,
-                                          options,
-                                          trackDuplicates,
-                                          &totalInserted,
-                                          &totalDeleted);
-                !status.isOK()) {
+            if (sortBatchesByKey) {
+                sortedWrites.emplace_back(
+                    _decodeKey(unownedDoc), batchSize, unownedDoc.getOwned());
+            } else if (auto status = _applyWrite(opCtx,
+                                                 coll,
+                                                 unownedDoc,
+                                                 options,
+                                                 trackDuplicates,
+                                                 &totalInserted,
+                                                 &totalDeleted);
+                       !status.isOK()) {
                 return status;
             }
 
@@ -215,6 +234,26 @@ Status IndexBuildInterceptor::drainWritesIntoIndex(OperationContext* opCtx,
             record = cursor->next();
         }
 
+        // Sort on the key and then on the position in the side table, so that writes to the same
+        // key, e.g. an insert, a delete and a re-insert, are applied in the order they were
+        // recorded in.
+        std::sort(sortedWrites.begin(), sortedWrites.end(), [&](auto&& lhs, auto&& rhs) {
+            const auto cmp = compareKeys(std::get<0>(lhs), std::get<0>(rhs));
+            return cmp != 0 ? cmp < 0 : std::get<1>(lhs) < std::get<1>(rhs);
+        });
+        for (const auto& write : sortedWrites) {
+            if (auto status = _applyWrite(opCtx,
+                                          coll,
+                                          std::get<2>(write),
+                                          options,
+                                          trackDuplicates,
+                                          &totalInserted,
+                                          &totalDeleted);
+                !status.isOK()) {
+                return status;
+            }
+        }
+
         // Delete documents from the side table as soon as they have been inserted into the index.
         // This ensures that no key is ever inserted twice and no keys are skipped.
         for (const auto& recordId : recordsAddedToIndex) {
@@ -272,6 +311,16 @@ Status IndexBuildInterceptor::drainWritesIntoIndex(OperationContext* opCtx,
     return Status::OK();
 }
 
+KeyString::Value IndexBuildInterceptor::_decodeKey(const BSONObj& operation) const {
+    // Deserialize the encoded KeyString::Value.
+    int keyLen;
+    const char* binKey = operation["key"].binData(keyLen);
+    BufReader reader(binKey, keyLen);
+    auto accessMethod = _indexCatalogEntry->accessMethod()->asSortedData();
+    return KeyString::Value::deserialize(
+        reader, accessMethod->getSortedDataInterface()->getKeyStringVersion());
+}
+
 Status IndexBuildInterceptor::_applyWrite(OperationContext* opCtx,
                                           const CollectionPtr& coll,
                                           const BSONObj& operation,
@@ -279,13 +328,8 @@ Status IndexBuildInterceptor::_applyWrite(OperationContext* opCtx,
                                           TrackDuplicates trackDups,
                                           int64_t* const keysInserted,
                                           int64_t* const keysDeleted) {
-    // Deserialize the encoded KeyString::Value.
-    int keyLen;
-    const char* binKey = operation["key"].binData(keyLen);
-    BufReader reader(binKey, keyLen);
     auto accessMethod = _indexCatalogEntry->accessMethod()->asSortedData();
-    const KeyString::Value keyString = KeyString::Value::deserialize(
-        reader, accessMethod->getSortedDataInterface()->getKeyStringVersion());
+    const KeyString::Value keyString = _decodeKey(operation);
 
     const Op opType = operation.getStringField("op") == "i"_sd ? Op::kInsert : Op::kDelete;
 
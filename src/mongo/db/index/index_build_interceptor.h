@@ -173,6 +173,10 @@ public:
 private:
     using SideWriteRecord = std::pair<RecordId, BSONObj>;
 
+    /**
+     * Returns the index key stored in the side write 'operation'.
+     */
+    KeyString::Value _decodeKey(const BSONObj& operation) const;
 
     Status _applyWrite(OperationContext* opCtx,
                        const CollectionPtr& coll,
@@ -242,15 +242,14 @@ void WildcardKeyGenerator::_addMultiKey(SharedBufferFragmentBuilder& pooledBuffe
     // Multikey paths are denoted by a key of the form { "": 1, "": "path.to.array" }. The argument
     // 'multikeyPaths' may be nullptr if the access method is being used in an operation which does
     // not require multikey path generation.
+    // The KeyString is appended to directly, as in _addKey(), rather than built from an
+    // intermediate BSONObj.
     if (multikeyPaths) {
-        auto key = BSON("" << 1 << "" << fullPath.dottedField());
-        KeyString::PooledBuilder keyString(
-            pooledBufferBuilder,
-            _keyStringVersion,
-            key,
-            _ordering,
-            record_id_helpers::reservedIdFor(
-                record_id_helpers::ReservationId::kWildcardMultikeyMetadataId, _rsKeyFormat));
+        KeyString::PooledBuilder keyString(pooledBufferBuilder, _keyStringVersion, _ordering);
+        keyString.appendNumberInt(1);
+        keyString.appendString(fullPath.dottedField());
+        keyString.appendRecordId(record_id_helpers::reservedIdFor(
+            record_id_helpers::ReservationId::kWildcardMultikeyMetadataId, _rsKeyFormat));
         multikeyPaths->push_back(keyString.release());
     }
 }
@@ -132,7 +132,7 @@ void BSONElementIterator::_setTraversalStart(size_t suffixIndex, BSONElement ele
 }
 
 void BSONElementIterator::ArrayIterationState::reset(const FieldRef& ref, int start) {
-    restOfPath = ref.dottedField(start).toString();
+    restOfPath = ref.dottedField(start);
     hasMore = restOfPath.size() > 0;
     if (hasMore) {
         nextPieceOfPath = ref.getPart(start);
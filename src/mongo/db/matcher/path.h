@@ -256,7 +256,9 @@ private:
             return nextPieceOfPath.size() == restOfPath.size();
         }
 
-        std::string restOfPath;
+        // Points into the FieldRef of the ElementPath being iterated, which outlives this state,
+        // so that entering an array does not copy the remainder of the path.
+        StringData restOfPath;
         bool hasMore;
         StringData nextPieceOfPath;
         bool nextPieceOfPathIsNumber;
@@ -109,8 +109,11 @@
 #include "mongo/db/operation_context.h"
 #include "mongo/db/periodic_runner_job_abort_expired_transactions.h"
 #include "mongo/db/pipeline/change_stream_expired_pre_image_remover.h"
+#include "mongo/db/pipeline/materialized_group_op_observer.h"
 #include "mongo/db/pipeline/process_interface/replica_set_node_process_interface.h"
 #include "mongo/db/query/internal_plans.h"
+#include "mongo/db/query/plan_cache_snapshot.h"
+#include "mongo/db/query/query_result_cache_op_observer.h"
 #include "mongo/db/read_write_concern_defaults_cache_lookup_mongod.h"
 #include "mongo/db/repl/drop_pending_collection_reaper.h"
 #include "mongo/db/repl/initial_syncer_factory.h"
@@ -898,6 +901,10 @@ ExitCode _initAndListen(ServiceContext* serviceContext, int listenPort) {
         startChangeStreamExpiredPreImagesRemover(serviceContext);
     }
 
+    // Start a background task to periodically snapshot the shared-shape plan cache, after loading
+    // the snapshot left by the previous run.
+    plan_cache_snapshot::startPeriodicJob(serviceContext);
+
     // Set up the logical session cache
     LogicalSessionCacheServer kind = LogicalSessionCacheServer::kStandalone;
     if (serverGlobalParams.clusterRole == ClusterRole::ShardServer) {
@@ -1246,6 +1253,8 @@ void setUpObservers(ServiceContext* serviceContext) {
     opObserverRegistry->addObserver(
         std::make_unique<repl::PrimaryOnlyServiceOpObserver>(serviceContext));
     opObserverRegistry->addObserver(std::make_unique<FcvOpObserver>());
+    opObserverRegistry->addObserver(std::make_unique<QueryResultCacheOpObserver>());
+    opObserverRegistry->addObserver(std::make_unique<MaterializedGroupOpObserver>());
 
     if (gFeatureFlagClusterWideConfig.isEnabledAndIgnoreFCV()) {
         opObserverRegistry->addObserver(std::make_unique<ClusterServerParameterOpObserver>());
@@ -1678,6 +1687,14 @@ void shutdownTask(const ShutdownTaskArgs& shutdownArgs) {
         shutdownChangeStreamExpiredPreImagesRemover(serviceContext);
     }
 
+    {
+        TimeElapsedBuilderScopedTimer scopedTimer(serviceContext->getFastClockSource(),
+                                                  "Shut down plan cache snapshots",
+                                                  &shutdownTimeElapsedBuilder);
+        LOGV2(7000112, "Shutting down the plan cache snapshot job");
+        plan_cache_snapshot::shutdownPeriodicJob(serviceContext);
+    }
+
     // We should always be able to acquire the global lock at shutdown.
     // An OperationContext is not necessary to call lockGlobal() during shutdown, as it's only used
     // to check that lockGlobal() is not called after a transaction timestamp has been set.
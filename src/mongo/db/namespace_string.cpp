@@ -176,6 +176,15 @@ const NamespaceString NamespaceString::kConfigsvrCollectionsNamespace(NamespaceS
 const NamespaceString NamespaceString::kLocalHealthLogNamespace(NamespaceString::kLocalDb,
                                                                 "system.healthlog");
 
+const NamespaceString NamespaceString::kLocalPlanCacheSnapshotNamespace(NamespaceString::kLocalDb,
+                                                                        "planCacheSnapshot");
+
+const NamespaceString NamespaceString::kConfigPlanCacheSnapshotNamespace(
+    NamespaceString::kConfigDb, "planCacheSnapshot");
+
+const NamespaceString NamespaceString::kConfigAggregateCheckpointsNamespace(
+    NamespaceString::kConfigDb, "aggregateCheckpoints");
+
 bool NamespaceString::isListCollectionsCursorNS() const {
     return coll() == listCollectionsCursorCol;
 }
@@ -233,6 +242,10 @@ bool NamespaceString::isLegalClientSystemNS(
     if (isChangeStreamPreImagesCollection()) {
         return true;
     }
+    if (isSystemStatsCollection() &&
+        validCollectionName(coll().substr(kStatisticsCollectionPrefix.size()))) {
+        return true;
+    }
 
     return false;
 }
@@ -387,6 +400,10 @@ bool NamespaceString::isTimeseriesBucketsCollection() const {
     return coll().startsWith(kTimeseriesBucketsCollectionPrefix);
 }
 
+bool NamespaceString::isSystemStatsCollection() const {
+    return coll().startsWith(kStatisticsCollectionPrefix);
+}
+
 bool NamespaceString::isChangeStreamPreImagesCollection() const {
     return ns() == kChangeStreamPreImagesNamespace.ns();
 }
@@ -414,6 +431,10 @@ NamespaceString NamespaceString::getTimeseriesViewNamespace() const {
     return {db(), coll().substr(kTimeseriesBucketsCollectionPrefix.size())};
 }
 
+NamespaceString NamespaceString::makeStatisticsNamespace() const {
+    return {db(), kStatisticsCollectionPrefix.toString() + coll()};
+}
+
 bool NamespaceString::isImplicitlyReplicated() const {
     if (isChangeStreamPreImagesCollection() || isConfigImagesCollection() || isChangeCollection()) {
         // Implicitly replicated namespaces are replicated, although they only replicate a subset of
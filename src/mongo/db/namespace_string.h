@@ -95,6 +95,9 @@ public:
     // Prefix for time-series buckets collection.
     static constexpr StringData kTimeseriesBucketsCollectionPrefix = "system.buckets."_sd;
 
+    // Prefix for the collections holding the statistics built by the 'analyze' command.
+    static constexpr StringData kStatisticsCollectionPrefix = "system.statistics."_sd;
+
     // Namespace for storing configuration data, which needs to be replicated if the server is
     // running as a replica set. Documents in this collection should represent some configuration
     // state of the server, which needs to be recovered/consulted at startup. Each document in this
@@ -228,6 +231,14 @@ public:
     // Namespace used for the health log.
     static const NamespaceString kLocalHealthLogNamespace;
 
+    // Namespaces for the snapshots of the shared-shape plan cache, local to each node or
+    // replicated from the primary.
+    static const NamespaceString kLocalPlanCacheSnapshotNamespace;
+    static const NamespaceString kConfigPlanCacheSnapshotNamespace;
+
+    // Namespace for the progress of aggregations whose $merge stage records checkpoints.
+    static const NamespaceString kConfigAggregateCheckpointsNamespace;
+
     /**
      * Constructs an empty NamespaceString.
      */
@@ -411,6 +422,11 @@ public:
      */
     bool isTimeseriesBucketsCollection() const;
 
+    /**
+     * Returns whether the specified namespace is <database>.system.statistics.<>.
+     */
+    bool isSystemStatsCollection() const;
+
     /**
      * Returns whether the specified namespace is config.system.preimages.
      */
@@ -441,6 +457,11 @@ public:
      */
     NamespaceString getTimeseriesViewNamespace() const;
 
+    /**
+     * Returns the namespace of the collection holding the statistics for this collection.
+     */
+    NamespaceString makeStatisticsNamespace() const;
+
     /**
      * Returns whether the namespace is implicitly replicated, based only on its string value.
      *
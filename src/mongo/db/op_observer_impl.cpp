@@ -320,10 +320,41 @@ void writeToImageCollection(OperationContext* opCtx,
     AllowLockAcquisitionOnTimestampedUnitOfWork allowLockAcquisition(opCtx->lockState());
     AutoGetCollection imageCollectionRaii(
         opCtx, NamespaceString::kConfigImagesNamespace, LockMode::MODE_IX);
+    const auto imageDoc = imageEntry.toBSON();
+
+    // There is at most one image per session and it is only ever looked up by _id, so write it
+    // with a point lookup on the _id index and a direct insert or replacement. This avoids
+    // building and planning a full upsert request for every retryable findAndModify. The primary
+    // has the session checked out, so nothing else writes this document concurrently. Secondaries
+    // keep the conditional upsert in repl/oplog.cpp: they must not overwrite a newer image, and
+    // parallel appliers can race to insert the same one.
+    if (const auto& imageCollection = imageCollectionRaii.getCollection()) {
+        const auto idQuery = imageDoc["_id"].wrap();
+        const auto recordId = Helpers::findById(opCtx, imageCollection, idQuery);
+        if (recordId.isNull()) {
+            uassertStatusOK(
+                imageCollection->insertDocument(opCtx, InsertStatement(imageDoc), nullptr));
+            return;
+        }
+
+        CollectionUpdateArgs args;
+        args.criteria = idQuery;
+        args.update = imageDoc;
+        imageCollection->updateDocument(opCtx,
+                                        recordId,
+                                        imageCollection->docFor(opCtx, recordId),
+                                        imageDoc,
+                                        true /* indexesAffected */,
+                                        nullptr /* opDebug */,
+                                        &args);
+        return;
+    }
+
+    // The collection does not exist yet, so let the upsert path create it.
     auto curOp = CurOp::get(opCtx);
     const std::string existingNs = curOp->getNS();
-    UpdateResult res = Helpers::upsert(
-        opCtx, NamespaceString::kConfigImagesNamespace.toString(), imageEntry.toBSON());
+    UpdateResult res =
+        Helpers::upsert(opCtx, NamespaceString::kConfigImagesNamespace.toString(), imageDoc);
     {
         stdx::lock_guard<Client> clientLock(*opCtx->getClient());
         curOp->setNS_inlock(existingNs);
@@ -2257,6 +2257,61 @@ TEST_F(OnUpdateOutputsTest, TestFundamentalTransactionOnUpdateOutputs) {
     }
 }
 
+TEST_F(OnUpdateOutputsTest, RetryableFindAndModifyReplacesExistingImageInSideCollection) {
+    OpObserverRegistry opObserver;
+    opObserver.addObserver(std::make_unique<OpObserverImpl>());
+
+    {
+        auto opCtxRaii = cc().makeOperationContext();
+        resetOplogAndTransactions(opCtxRaii.get());
+    }
+
+    // Two retryable findAndModify commands on one session. The second one asks for the other kind
+    // of image and must replace the session's existing entry in the image collection.
+    const auto lsid = makeLogicalSessionIdForTest();
+    const std::vector<UpdateTestCase> cases = {
+        {kFaMPre, kDoNotRecordPreImages, kChangeStreamImagesDisabled, kRecordInSideCollection, 1},
+        {kFaMPost, kDoNotRecordPreImages, kChangeStreamImagesDisabled, kRecordInSideCollection, 1}};
+    for (std::size_t testIdx = 0; testIdx < cases.size(); ++testIdx) {
+        const auto& testCase = cases[testIdx];
+        logTestCase(testCase);
+
+        auto opCtxRaii = cc().makeOperationContext();
+        OperationContext* opCtx = opCtxRaii.get();
+        opCtx->setLogicalSessionId(lsid);
+        opCtx->setTxnNumber(testIdx);
+        MongoDOperationContextSession contextSession(opCtx);
+        TransactionParticipant::get(opCtx).beginOrContinue(opCtx,
+                                                           {*opCtx->getTxnNumber()},
+                                                           boost::none /* autocommit */,
+                                                           boost::none /* startTransaction */);
+
+        CollectionUpdateArgs updateArgs;
+        OplogUpdateEntryArgs updateEntryArgs(&updateArgs, _nss, _uuid);
+        initializeOplogUpdateEntryArgs(opCtx, testCase, &updateEntryArgs);
+
+        WriteUnitOfWork wuow(opCtx);
+        AutoGetCollection locks(opCtx, _nss, LockMode::MODE_IX);
+        opObserver.onUpdate(opCtx, updateEntryArgs);
+        wuow.commit();
+
+        repl::ImageEntry imageEntry = getImageEntryFromSideCollection(opCtx, lsid);
+        ASSERT_EQ(imageEntry.getTxnNumber(), static_cast<TxnNumber>(testIdx));
+        if (testCase.imageType == StoreDocOption::PreImage) {
+            ASSERT(imageEntry.getImageKind() == repl::RetryImageEnum::kPreImage);
+            ASSERT_BSONOBJ_EQ(*updateArgs.preImageDoc, imageEntry.getImage());
+        } else {
+            ASSERT(imageEntry.getImageKind() == repl::RetryImageEnum::kPostImage);
+            ASSERT_BSONOBJ_EQ(updateArgs.updatedDoc, imageEntry.getImage());
+        }
+    }
+
+    auto opCtxRaii = cc().makeOperationContext();
+    AutoGetCollection sideCollection(
+        opCtxRaii.get(), NamespaceString::kConfigImagesNamespace, LockMode::MODE_IS);
+    ASSERT_EQ(1, sideCollection->numRecords(opCtxRaii.get()));
+}
+
 TEST_F(OnUpdateOutputsTest,
        RetryableInternalTransactionUpdateWithPreImageRecordingEnabledOnShardServerThrows) {
     // Create a registry that only registers the Impl. It can be challenging to call methods on
@@ -33,10 +33,12 @@
 
 #include "change_stream_expired_pre_image_remover.h"
 
+#include "mongo/base/counter.h"
 #include "mongo/db/auth/authorization_session.h"
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/change_stream_options_manager.h"
 #include "mongo/db/client.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/concurrency/exception_util.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/namespace_string.h"
@@ -51,6 +53,7 @@
 #include "mongo/util/background.h"
 #include "mongo/util/concurrency/idle_thread_block.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 // Fail point to set current time for time-based expiration of pre-images.
@@ -90,6 +93,17 @@ boost::optional<Date_t> getPreImageExpirationTime(OperationContext* opCtx, Date_
 
 namespace {
 
+Counter64 purgingJobPasses;
+Counter64 purgingJobDocsDeleted;
+Counter64 purgingJobTimeElapsedMillis;
+
+ServerStatusMetricField<Counter64> purgingJobPassesDisplay(
+    "changeStreamPreImages.purgingJob.totalPass", &purgingJobPasses);
+ServerStatusMetricField<Counter64> purgingJobDocsDeletedDisplay(
+    "changeStreamPreImages.purgingJob.docsDeleted", &purgingJobDocsDeleted);
+ServerStatusMetricField<Counter64> purgingJobTimeElapsedMillisDisplay(
+    "changeStreamPreImages.purgingJob.timeElapsedMillis", &purgingJobTimeElapsedMillis);
+
 RecordId toRecordId(ChangeStreamPreImageId id) {
     return record_id_helpers::keyForElem(
         BSON(ChangeStreamPreImage::kIdFieldName << id.toBSON()).firstElement());
@@ -236,6 +250,9 @@ size_t deleteExpiredChangeStreamPreImages(OperationContext* opCtx,
     }
     return numberOfRemovals;
 }
+}  // namespace
+
+namespace preImageRemoverInternal {
 
 void performExpiredChangeStreamPreImagesRemovalPass(Client* client) {
     ServiceContext::UniqueOperationContext opCtx;
@@ -256,7 +273,12 @@ void performExpiredChangeStreamPreImagesRemovalPass(Client* client) {
                 currentTimeForTimeBasedExpiration = currentTimeElem.Date();
             }
         });
-        deleteExpiredChangeStreamPreImages(opCtx.get(), currentTimeForTimeBasedExpiration);
+        Timer timer;
+        const auto numDeleted =
+            deleteExpiredChangeStreamPreImages(opCtx.get(), currentTimeForTimeBasedExpiration);
+        purgingJobPasses.increment();
+        purgingJobDocsDeleted.increment(numDeleted);
+        purgingJobTimeElapsedMillis.increment(timer.millis());
     } catch (const ExceptionForCat<ErrorCategory::Interruption>&) {
         LOGV2_WARNING(5869105, "Periodic expired pre-images removal job was interrupted");
     } catch (const DBException& exception) {
@@ -265,7 +287,7 @@ void performExpiredChangeStreamPreImagesRemovalPass(Client* client) {
                     "reason"_attr = exception.reason());
     }
 }
-}  // namespace
+}  // namespace preImageRemoverInternal
 
 class ChangeStreamExpiredPreImagesRemover;
 
@@ -324,7 +346,7 @@ public:
         while (true) {
             LOGV2_DEBUG(6278517, 3, "Thread awake");
             auto iterationStartTime = Date_t::now();
-            performExpiredChangeStreamPreImagesRemovalPass(tc.get());
+            preImageRemoverInternal::performExpiredChangeStreamPreImagesRemovalPass(tc.get());
             {
                 // Wait until either gExpiredChangeStreamPreImageRemovalJobSleepSecs passes or a
                 // shutdown is requested.
@@ -37,6 +37,12 @@ namespace preImageRemoverInternal {
 
 boost::optional<Date_t> getPreImageExpirationTime(OperationContext* opCtx, Date_t currentTime);
 
+/**
+ * Runs one pass of the expired pre-image removal job on 'client' and records it in the
+ * 'changeStreamPreImages.purgingJob' serverStatus metrics.
+ */
+void performExpiredChangeStreamPreImagesRemovalPass(Client* client);
+
 }  // namespace preImageRemoverInternal
 
 /**
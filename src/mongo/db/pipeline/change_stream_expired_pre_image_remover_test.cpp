@@ -29,8 +29,13 @@
 
 #include "mongo/platform/basic.h"
 
+#include "mongo/db/catalog/catalog_test_fixture.h"
+#include "mongo/db/catalog/create_collection.h"
 #include "mongo/db/change_stream_options_manager.h"
+#include "mongo/db/commands/server_status_internal.h"
 #include "mongo/db/pipeline/change_stream_expired_pre_image_remover.h"
+#include "mongo/db/pipeline/change_stream_preimage_gen.h"
+#include "mongo/db/repl/storage_interface_impl.h"
 #include "mongo/db/service_context_test_fixture.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/assert_util.h"
@@ -97,5 +102,65 @@ TEST_F(ChangeStreamPreImageExpirationPolicyTest, getPreImageExpirationTimeWithOf
         preImageRemoverInternal::getPreImageExpirationTime(opCtx.get(), currentTime);
     ASSERT_FALSE(receivedExpireAfterSeconds);
 }
+
+class ChangeStreamPreImageRemovalMetricsTest : public CatalogTestFixture {
+public:
+    void setUp() override {
+        CatalogTestFixture::setUp();
+        ChangeStreamOptionsManager::create(getServiceContext());
+        repl::StorageInterface::set(getServiceContext(),
+                                    std::make_unique<repl::StorageInterfaceImpl>());
+    }
+
+    void insertOplogEntry(Timestamp ts) {
+        const auto entry = BSON("ts" << ts << "t" << 1LL << "op"
+                                     << "n"
+                                     << "ns"
+                                     << ""
+                                     << "o" << BSONObj() << "wall" << Date_t::now());
+        ASSERT_OK(storageInterface()->insertDocument(
+            operationContext(), NamespaceString::kRsOplogNamespace, {entry, ts}, 1));
+    }
+
+    void insertPreImage(const UUID& nsUUID, Timestamp ts) {
+        ChangeStreamPreImage preImage{
+            ChangeStreamPreImageId(nsUUID, ts, 0), Date_t::now(), BSON("_id" << 0)};
+        ASSERT_OK(
+            storageInterface()->insertDocument(operationContext(),
+                                               NamespaceString::kChangeStreamPreImagesNamespace,
+                                               {preImage.toBSON(), Timestamp()},
+                                               repl::OpTime::kUninitializedTerm));
+    }
+
+    static BSONObj purgingJobMetrics() {
+        BSONObjBuilder builder;
+        MetricTree::theMetricTree->appendTo(builder);
+        const auto metrics = builder.obj();
+        return metrics["metrics"]["changeStreamPreImages"]["purgingJob"].Obj().getOwned();
+    }
+};
+
+TEST_F(ChangeStreamPreImageRemovalMetricsTest, RemovalPassUpdatesPurgingJobMetrics) {
+    createChangeStreamPreImagesCollection(operationContext());
+    insertOplogEntry(Timestamp(100, 1));
+
+    // Pre-images older than the earliest oplog entry are expired, the newer one is not.
+    const auto nsUUID = UUID::gen();
+    insertPreImage(nsUUID, Timestamp(10, 1));
+    insertPreImage(nsUUID, Timestamp(20, 1));
+    insertPreImage(nsUUID, Timestamp(200, 1));
+
+    const auto before = purgingJobMetrics();
+    {
+        auto client = getServiceContext()->makeClient("preImageRemover");
+        AlternativeClientRegion acr(client);
+        preImageRemoverInternal::performExpiredChangeStreamPreImagesRemovalPass(&cc());
+    }
+    const auto after = purgingJobMetrics();
+
+    ASSERT_EQ(after["totalPass"].numberLong() - before["totalPass"].numberLong(), 1);
+    ASSERT_EQ(after["docsDeleted"].numberLong() - before["docsDeleted"].numberLong(), 2);
+    ASSERT_GTE(after["timeElapsedMillis"].numberLong(), before["timeElapsedMillis"].numberLong());
+}
 }  // namespace
 }  // namespace mongo
@@ -372,6 +372,43 @@ public:
         return next;
     }
 
+    /**
+     * Batched form of getNext(), which amortizes the cost of the call over many results. Appends
+     * results to 'batch' until it holds 'maxBatchSize' documents, and returns the status which
+     * ended the batch. If the status is kAdvanced, at least one document was appended and more may
+     * follow. Otherwise the documents appended, if any, precede the kEOF or kPauseExecution which
+     * getNext() would have returned after them.
+     *
+     * Calls to getNext() and getNextBatch() may be interleaved on the same stage.
+     */
+    GetNextResult::ReturnStatus getNextBatch(std::vector<Document>* batch, size_t maxBatchSize) {
+        tassert(7027100, "Cannot request a batch of no documents", batch->size() < maxBatchSize);
+        pExpCtx->checkForInterrupt();
+
+        if (MONGO_likely(!pExpCtx->shouldCollectDocumentSourceExecStats())) {
+            return doGetNextBatch(batch, maxBatchSize);
+        }
+
+        auto serviceCtx = pExpCtx->opCtx->getServiceContext();
+        invariant(serviceCtx);
+        auto fcs = serviceCtx->getFastClockSource();
+        invariant(fcs);
+
+        invariant(_commonStats.executionTimeMillis);
+        ScopedTimer timer(fcs, _commonStats.executionTimeMillis.get_ptr());
+
+        const auto sizeBefore = batch->size();
+        auto status = doGetNextBatch(batch, maxBatchSize);
+        const auto numAdvanced = batch->size() - sizeBefore;
+        // Count a unit of work for each result, as getNext() would, plus one for the EOF or pause.
+        _commonStats.advanced += numAdvanced;
+        _commonStats.works += numAdvanced;
+        if (status != GetNextResult::ReturnStatus::kAdvanced) {
+            ++_commonStats.works;
+        }
+        return status;
+    }
+
     /**
      * Returns a struct containing information about any special constraints imposed on using this
      * stage. Input parameter Pipeline::SplitState is used by stages whose requirements change
@@ -751,6 +788,23 @@ protected:
      */
     virtual GetNextResult doGetNext() = 0;
 
+    /**
+     * The batched execution API of a DocumentSource. See comment at getNextBatch(). The default
+     * implementation calls doGetNext() once per result; streaming stages should override it to
+     * process the batch of their source in one pass.
+     */
+    virtual GetNextResult::ReturnStatus doGetNextBatch(std::vector<Document>* batch,
+                                                       size_t maxBatchSize) {
+        while (batch->size() < maxBatchSize) {
+            auto next = doGetNext();
+            if (!next.isAdvanced()) {
+                return next.getStatus();
+            }
+            batch->push_back(next.releaseDocument());
+        }
+        return GetNextResult::ReturnStatus::kAdvanced;
+    }
+
     /**
      * Attempt to perform an optimization with the following source in the pipeline. 'container'
      * refers to the entire pipeline, and 'itr' points to this stage within the pipeline.
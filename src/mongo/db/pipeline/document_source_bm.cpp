@@ -0,0 +1,152 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/db/pipeline/document_source.h"
+#include "mongo/db/pipeline/document_source_mock.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/db/query/query_test_service_context.h"
+
+namespace mongo {
+namespace {
+
+const size_t kNumDocuments = 1000;
+
+std::vector<Document> makeDocuments() {
+    std::vector<Document> docs;
+    for (size_t i = 0; i < kNumDocuments; ++i) {
+        docs.push_back(Document{{"_id", static_cast<int>(i)},
+                                {"a", static_cast<int>(i % 10)},
+                                {"b", "payload"_sd},
+                                {"arr", std::vector<Value>{Value(1), Value(2), Value(3)}}});
+    }
+    return docs;
+}
+
+/**
+ * Runs the stages parsed from 'stageSpecs' over 'kNumDocuments' documents, pulling the results
+ * from the last stage one at a time if 'batchSize' is zero, or in batches of 'batchSize'
+ * otherwise.
+ */
+void benchmarkPipeline(const std::vector<BSONObj>& stageSpecs,
+                       size_t batchSize,
+                       benchmark::State& state) {
+    QueryTestServiceContext testServiceContext;
+    auto opContext = testServiceContext.makeOperationContext();
+    NamespaceString nss("test.bm");
+    auto expCtx = make_intrusive<ExpressionContextForTest>(opContext.get(), nss);
+
+    std::vector<boost::intrusive_ptr<DocumentSource>> stages;
+    for (auto&& spec : stageSpecs) {
+        for (auto&& stage : DocumentSource::parse(expCtx, spec)) {
+            if (!stages.empty()) {
+                stage->setSource(stages.back().get());
+            }
+            stages.push_back(stage);
+        }
+    }
+
+    const auto docs = makeDocuments();
+    std::vector<Document> batch;
+    batch.reserve(batchSize);
+    for (auto keepRunning : state) {
+        state.PauseTiming();
+        auto source = DocumentSourceMock::createForTest(docs, expCtx);
+        stages.front()->setSource(source.get());
+        state.ResumeTiming();
+
+        auto& last = stages.back();
+        if (batchSize == 0) {
+            for (auto next = last->getNext(); next.isAdvanced(); next = last->getNext()) {
+                benchmark::DoNotOptimize(next.releaseDocument());
+            }
+        } else {
+            auto status = DocumentSource::GetNextResult::ReturnStatus::kAdvanced;
+            while (status == DocumentSource::GetNextResult::ReturnStatus::kAdvanced) {
+                batch.clear();
+                status = last->getNextBatch(&batch, batchSize);
+                benchmark::DoNotOptimize(batch.data());
+            }
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * kNumDocuments);
+}
+
+const std::vector<BSONObj> kProjectPipeline = {
+    BSON("$project" << BSON("a" << 1 << "b" << 1)),
+};
+
+const std::vector<BSONObj> kMatchAddFieldsPipeline = {
+    BSON("$match" << BSON("a" << BSON("$lt" << 5))),
+    BSON("$addFields" << BSON("c" << BSON("$add" << BSON_ARRAY("$a" << 1)))),
+};
+
+const std::vector<BSONObj> kUnwindProjectPipeline = {
+    BSON("$unwind"
+         << "$arr"),
+    BSON("$project" << BSON("arr" << 1)),
+};
+
+void BM_ProjectGetNext(benchmark::State& state) {
+    benchmarkPipeline(kProjectPipeline, 0, state);
+}
+
+void BM_ProjectGetNextBatch(benchmark::State& state) {
+    benchmarkPipeline(kProjectPipeline, state.range(0), state);
+}
+
+void BM_MatchAddFieldsGetNext(benchmark::State& state) {
+    benchmarkPipeline(kMatchAddFieldsPipeline, 0, state);
+}
+
+void BM_MatchAddFieldsGetNextBatch(benchmark::State& state) {
+    benchmarkPipeline(kMatchAddFieldsPipeline, state.range(0), state);
+}
+
+void BM_UnwindProjectGetNext(benchmark::State& state) {
+    benchmarkPipeline(kUnwindProjectPipeline, 0, state);
+}
+
+void BM_UnwindProjectGetNextBatch(benchmark::State& state) {
+    benchmarkPipeline(kUnwindProjectPipeline, state.range(0), state);
+}
+
+BENCHMARK(BM_ProjectGetNext);
+BENCHMARK(BM_ProjectGetNextBatch)->Arg(16)->Arg(128);
+BENCHMARK(BM_MatchAddFieldsGetNext);
+BENCHMARK(BM_MatchAddFieldsGetNextBatch)->Arg(16)->Arg(128);
+BENCHMARK(BM_UnwindProjectGetNext);
+BENCHMARK(BM_UnwindProjectGetNextBatch)->Arg(16)->Arg(128);
+
+}  // namespace
+}  // namespace mongo
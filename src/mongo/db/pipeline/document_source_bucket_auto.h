@@ -66,6 +66,9 @@ public:
      * The $bucketAuto stage must be run on the merging shard.
      */
     boost::optional<DistributedPlanLogic> distributedPlanLogic() final {
+        // Bucket boundaries depend on the distribution of 'groupBy' across all shards, so there is
+        // no partial result the shards could compute. The merger receives only the fields this
+        // stage depends on.
         // {shardsStage, mergingStage, sortPattern}
         return DistributedPlanLogic{nullptr, this, boost::none};
     }
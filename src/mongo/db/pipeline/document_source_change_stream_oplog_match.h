@@ -35,6 +35,15 @@ namespace mongo {
 /**
  * A custom subclass of DocumentSourceMatch which is used to generate a $match stage to be applied
  * on the oplog. The stage requires itself to be the first stage in the pipeline.
+ *
+ * The filter is absorbed into the oplog collection scan of the cursor that owns the pipeline, so
+ * every open change stream tails the oplog independently and the cost on the node grows linearly
+ * with the number of streams. Sharing one scan between streams would need the scan to outlive any
+ * single cursor and to buffer events per subscriber; neither fits the per-cursor PlanExecutor that
+ * runs this stage today. internalQueryChangeStreamWakeupCoalescingMS bounds the number of scans
+ * per stream by letting each one read the entries of several inserts at once. Deployments with
+ * many narrow streams should also prefer fewer, wider streams and fan the events out in the
+ * application.
  */
 class DocumentSourceChangeStreamOplogMatch final : public DocumentSourceMatch {
 public:
@@ -72,6 +81,11 @@ public:
         MONGO_UNREACHABLE;
     }
 
+    GetNextResult::ReturnStatus doGetNextBatch(std::vector<Document>* batch,
+                                               size_t maxBatchSize) final {
+        MONGO_UNREACHABLE;
+    }
+
     StageConstraints constraints(Pipeline::SplitState pipeState) const final;
 
     Value serialize(boost::optional<ExplainOptions::Verbosity> explain) const final;
@@ -122,6 +122,29 @@ DocumentSource::GetNextResult DocumentSourceCursor::doGetNext() {
     return _currentBatch.dequeue();
 }
 
+DocumentSource::GetNextResult::ReturnStatus DocumentSourceCursor::doGetNextBatch(
+    std::vector<Document>* batch, size_t maxBatchSize) {
+    // The latest oplog timestamp is tracked per result, so hand out one result at a time.
+    if (_trackOplogTS) {
+        return DocumentSource::doGetNextBatch(batch, maxBatchSize);
+    }
+
+    if (_currentBatch.isEmpty()) {
+        loadBatch();
+    }
+
+    if (_currentBatch.isEmpty()) {
+        return GetNextResult::ReturnStatus::kEOF;
+    }
+
+    // Hand out what remains of the loaded batch. The next call loads another one, as getNext()
+    // would.
+    while (!_currentBatch.isEmpty() && batch->size() < maxBatchSize) {
+        batch->push_back(_currentBatch.dequeue());
+    }
+    return GetNextResult::ReturnStatus::kAdvanced;
+}
+
 void DocumentSourceCursor::loadBatch() {
     if (!_exec || _exec->isDisposed()) {
         // No more documents.
@@ -154,7 +177,15 @@ void DocumentSourceCursor::loadBatch() {
     try {
         ON_BLOCK_EXIT([this] { recordPlanSummaryStats(); });
 
-        while ((state = _exec->getNextDocument(&resultObj, nullptr)) == PlanExecutor::ADVANCED) {
+        RecordId recordId;
+        while ((state = _exec->getNextDocument(&resultObj,
+                                               _attachRecordIds ? &recordId : nullptr)) ==
+               PlanExecutor::ADVANCED) {
+            if (_attachRecordIds) {
+                MutableDocument withRecordId(std::move(resultObj));
+                withRecordId.metadata().setRecordId(recordId);
+                resultObj = withRecordId.freeze();
+            }
             _currentBatch.enqueue(transformDoc(std::move(resultObj)));
 
             // As long as we're waiting for inserts, we shouldn't do any batching at this level we
@@ -305,11 +336,13 @@ DocumentSourceCursor::DocumentSourceCursor(
     std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> exec,
     const intrusive_ptr<ExpressionContext>& pCtx,
     CursorType cursorType,
-    bool trackOplogTimestamp)
+    bool trackOplogTimestamp,
+    bool attachRecordIds)
     : DocumentSource(kStageName, pCtx),
       _currentBatch(cursorType),
       _exec(std::move(exec)),
-      _trackOplogTS(trackOplogTimestamp) {
+      _trackOplogTS(trackOplogTimestamp),
+      _attachRecordIds(attachRecordIds) {
     // It is illegal for both 'kEmptyDocuments' and 'trackOplogTimestamp' to be set.
     invariant(!(cursorType == CursorType::kEmptyDocuments && trackOplogTimestamp));
 
@@ -344,9 +377,10 @@ intrusive_ptr<DocumentSourceCursor> DocumentSourceCursor::create(
     std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> exec,
     const intrusive_ptr<ExpressionContext>& pExpCtx,
     CursorType cursorType,
-    bool trackOplogTimestamp) {
+    bool trackOplogTimestamp,
+    bool attachRecordIds) {
     intrusive_ptr<DocumentSourceCursor> source(new DocumentSourceCursor(
-        collections, std::move(exec), pExpCtx, cursorType, trackOplogTimestamp));
+        collections, std::move(exec), pExpCtx, cursorType, trackOplogTimestamp, attachRecordIds));
     return source;
 }
 }  // namespace mongo
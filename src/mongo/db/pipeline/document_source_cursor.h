@@ -62,13 +62,17 @@ public:
      * If 'cursorType' is 'kEmptyDocuments', then we inform the $cursor stage that this is a count
      * scenario -- the dependency set is fully known and is empty. In this case, the newly created
      * $cursor stage can return a sequence of empty documents for the caller to count.
+     *
+     * If 'attachRecordIds' is true, each document returned carries the RecordId it was read from in
+     * its metadata.
      */
     static boost::intrusive_ptr<DocumentSourceCursor> create(
         const MultipleCollectionAccessor& collections,
         std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> exec,
         const boost::intrusive_ptr<ExpressionContext>& pExpCtx,
         CursorType cursorType,
-        bool trackOplogTimestamp = false);
+        bool trackOplogTimestamp = false,
+        bool attachRecordIds = false);
 
     const char* getSourceName() const override;
 
@@ -137,9 +141,12 @@ protected:
                          std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> exec,
                          const boost::intrusive_ptr<ExpressionContext>& pExpCtx,
                          CursorType cursorType,
-                         bool trackOplogTimestamp = false);
+                         bool trackOplogTimestamp = false,
+                         bool attachRecordIds = false);
 
     GetNextResult doGetNext() final;
+    GetNextResult::ReturnStatus doGetNextBatch(std::vector<Document>* batch,
+                                               size_t maxBatchSize) final;
 
     ~DocumentSourceCursor();
 
@@ -259,6 +266,9 @@ private:
     // True if we are tracking the latest observed oplog timestamp, false otherwise.
     bool _trackOplogTS = false;
 
+    // True if the RecordId of each document is added to its metadata.
+    bool _attachRecordIds = false;
+
     // If we are tracking the latest observed oplog time, this is the latest timestamp seen in the
     // oplog. Otherwise, this is a null timestamp.
     Timestamp _latestOplogTimestamp;
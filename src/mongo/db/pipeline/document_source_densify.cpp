@@ -217,8 +217,12 @@ list<intrusive_ptr<DocumentSource>> create(const intrusive_ptr<ExpressionContext
     }
 
     // Constructing resulting stages.
-    results.push_back(
-        make_intrusive<DocumentSourceInternalDensify>(expCtx, field, partitions, rangeStatement));
+    auto densify =
+        make_intrusive<DocumentSourceInternalDensify>(expCtx, field, partitions, rangeStatement);
+    if (!isInternal) {
+        densify->setInputSortedByPartition();
+    }
+    results.push_back(std::move(densify));
 
     return results;
 }
@@ -31,6 +31,7 @@
 
 #include "mongo/db/exec/document_value/value.h"
 #include "mongo/db/exec/document_value/value_comparator.h"
+#include "mongo/db/index/sort_key_generator.h"
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/document_source_densify_gen.h"
 #include "mongo/db/pipeline/expression.h"
@@ -38,6 +39,7 @@
 #include "mongo/db/pipeline/field_path.h"
 #include "mongo/db/pipeline/memory_usage_tracker.h"
 #include "mongo/db/query/datetime/date_time_support.h"
+#include "mongo/db/query/sort_pattern.h"
 #include "mongo/util/time_support.h"
 #include "mongo/util/visit_helper.h"
 
@@ -311,6 +313,26 @@ public:
         _maxDocs = internalQueryMaxAllowedDensifyDocs.load();
     };
 
+    /**
+     * Records that the stage is preceded by the sort $densify desugars into, which orders the
+     * input on the partition fields before the densify field for any bounds other than 'full'.
+     * Completed partitions can then be dropped from the partition table as soon as the next one
+     * starts, rather than being held until EOF.
+     */
+    void setInputSortedByPartition() {
+        _inputSortedByPartition = !_partitions.empty() &&
+            !stdx::holds_alternative<RangeStatement::Full>(_range.getBounds());
+        if (_inputSortedByPartition) {
+            std::vector<SortPattern::SortPatternPart> sortParts;
+            for (const auto& partition : _partitions) {
+                SortPattern::SortPatternPart part;
+                part.fieldPath = partition;
+                sortParts.push_back(std::move(part));
+            }
+            _partitionSortKeyGen.emplace(SortPattern{std::move(sortParts)}, pExpCtx->getCollator());
+        }
+    }
+
     class DocGenerator {
     public:
         DocGenerator(DensifyValue current,
@@ -504,6 +526,9 @@ private:
             auto partitionVal = getDensifyValue(doc);
             auto lastValForPartitionIt = _partitionTable.find(partitionKey);
             if (lastValForPartitionIt == _partitionTable.end()) {
+                if (_inputSortedByPartition) {
+                    startPartitionInSortedInput(doc, partitionKey);
+                }
                 // If this is a new partition, store the size of the key and the value.
                 _memTracker.update(partitionKey.getApproximateSize() +
                                    partitionVal.getApproximateSize());
@@ -521,6 +546,43 @@ private:
         }
     }
 
+    /**
+     * When the input is sorted on the partition fields first, a partition is never seen again once
+     * the sort key of the partition fields moves past it. Partitions with different keys can still
+     * share a sort key and interleave in the input: a missing field sorts like null, and an array
+     * sorts like its smallest element. So a partition is only dropped once the sort key of a new
+     * partition 'partitionKey', starting with 'doc', is strictly greater than its own. Partitions
+     * which still have values to generate after EOF are kept. With 'partition' bounds this keeps
+     * the table at the partitions of a single sort key, no matter how many partitions there are.
+     */
+    void startPartitionInSortedInput(const Document& doc, const Value& partitionKey) {
+        auto sortKey = _partitionSortKeyGen->computeSortKeyFromDocument(doc);
+        // Sort keys already incorporate the collation, so they are compared with the simple one.
+        if (_lastPartitionSortKey &&
+            Value::compare(*_lastPartitionSortKey, sortKey, nullptr) >= 0) {
+            _partitionsWithLastSortKey.push_back(partitionKey);
+            return;
+        }
+
+        auto bounds = _range.getBounds();
+        auto explicitBounds = stdx::get_if<RangeStatement::ExplicitBounds>(&bounds);
+        for (const auto& finishedPartition : _partitionsWithLastSortKey) {
+            auto it = _partitionTable.find(finishedPartition);
+            if (it == _partitionTable.end() ||
+                (explicitBounds && it->second.increment(_range) < explicitBounds->second)) {
+                // The partition must still be densified up to the end of the range.
+                continue;
+            }
+            _memTracker.update(
+                -static_cast<long long>(it->first.getApproximateSize() +
+                                        it->second.getApproximateSize()));
+            _partitionTable.erase(it);
+        }
+
+        _lastPartitionSortKey = std::move(sortKey);
+        _partitionsWithLastSortKey = {partitionKey};
+    }
+
     /**
      * Helpers to create doc generators. Sets _docGenerator to the created generator.
      */
@@ -578,6 +640,14 @@ private:
     RangeStatement _range;
     // Store of the value we've seen for each partition.
     ValueUnorderedMap<DensifyValue> _partitionTable;
+    // True if this stage is known to be fed by the sort on the partition fields and then the
+    // densify field which $densify desugars into. See setInputSortedByPartition().
+    bool _inputSortedByPartition = false;
+    // Generates the sort keys of the partition fields when '_inputSortedByPartition'.
+    boost::optional<SortKeyGenerator> _partitionSortKeyGen;
+    // The greatest sort key of the partition fields seen so far, and the partitions sharing it.
+    boost::optional<Value> _lastPartitionSortKey;
+    std::vector<Value> _partitionsWithLastSortKey;
 
     // Keep track of documents generated, error if it goes above the limit.
     size_t _docsGenerated = 0;
@@ -34,6 +34,7 @@
 #include "mongo/db/pipeline/document_source_densify.h"
 #include "mongo/db/pipeline/document_source_mock.h"
 #include "mongo/db/pipeline/pipeline.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/unittest.h"
 #include <utility>
@@ -1377,6 +1378,74 @@ TEST_F(DensifyPartitionNumericTest, DensifiesOnImmediateEOFExplicitRange) {
     ASSERT_FALSE(next.isAdvanced());
 }
 
+TEST_F(DensifyPartitionNumericTest, SortedInputOnlyKeepsCurrentPartitionInMemory) {
+    // Enough for a single partition table entry, but far less than one per partition.
+    RAIIServerParameterControllerForTest memoryLimit("internalDocumentSourceDensifyMaxMemoryBytes",
+                                                     1024);
+    auto densify = DocumentSourceInternalDensify(
+        getExpCtx(),
+        "b",
+        std::list<FieldPath>({"a"}),
+        RangeStatement(Value(1), RangeStatement::Partition(), boost::none));
+    densify.setInputSortedByPartition();
+
+    std::deque<DocumentSource::GetNextResult> docs;
+    for (int partition = 0; partition < 100; ++partition) {
+        docs.emplace_back(Document{{"a", partition}, {"b", 0}});
+        docs.emplace_back(Document{{"a", partition}, {"b", 2}});
+    }
+    auto source = DocumentSourceMock::createForTest(std::move(docs), getExpCtx());
+    densify.setSource(source.get());
+
+    // Every partition is densified to {b: 0}, {b: 1}, {b: 2}.
+    int numResults = 0;
+    for (auto next = densify.getNext(); next.isAdvanced(); next = densify.getNext()) {
+        ASSERT_EQUALS(numResults / 3, next.getDocument().getField("a").getInt());
+        ASSERT_EQUALS(numResults % 3, next.getDocument().getField("b").getDouble());
+        ++numResults;
+    }
+    ASSERT_EQUALS(300, numResults);
+}
+
+TEST_F(DensifyPartitionNumericTest, SortedInputKeepsPartitionsWithEqualSortKeys) {
+    // A missing partition field sorts like null, and an array like its smallest element, so these
+    // partitions interleave in sorted input even though their keys differ.
+    std::vector<std::pair<Value, Value>> partitionValuePairs = {
+        {Value(BSONNULL), Value()}, {Value(1), Value(BSON_ARRAY(1 << 5))}};
+    for (auto&& [first, second] : partitionValuePairs) {
+        auto densify = DocumentSourceInternalDensify(
+            getExpCtx(),
+            "b",
+            std::list<FieldPath>({"a"}),
+            RangeStatement(Value(1), RangeStatement::Partition(), boost::none));
+        densify.setInputSortedByPartition();
+
+        std::deque<DocumentSource::GetNextResult> docs;
+        for (int b = 0; b < 4; ++b) {
+            MutableDocument doc;
+            if (auto a = b % 2 == 0 ? first : second; !a.missing()) {
+                doc.addField("a", a);
+            }
+            doc.addField("b", Value(b));
+            docs.emplace_back(doc.freeze());
+        }
+        auto source = DocumentSourceMock::createForTest(std::move(docs), getExpCtx());
+        densify.setSource(source.get());
+
+        // Each partition is densified on its own: 0, 1, 2 for the first and 1, 2, 3 for the second.
+        std::vector<int> firstValues;
+        std::vector<int> secondValues;
+        for (auto next = densify.getNext(); next.isAdvanced(); next = densify.getNext()) {
+            auto doc = next.getDocument();
+            auto& values = ValueComparator().evaluate(doc.getField("a") == first) ? firstValues
+                                                                                  : secondValues;
+            values.push_back(doc.getField("b").coerceToInt());
+        }
+        ASSERT(firstValues == std::vector<int>({0, 1, 2}));
+        ASSERT(secondValues == std::vector<int>({1, 2, 3}));
+    }
+}
+
 TEST_F(DensifyCloneTest, InternalDensifyCanBeCloned) {
 
     std::list<boost::intrusive_ptr<DocumentSource>> sources;
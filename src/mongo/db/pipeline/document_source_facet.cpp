@@ -31,21 +31,29 @@
 
 #include "mongo/db/pipeline/document_source_facet.h"
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 
+#include "mongo/base/init.h"
 #include "mongo/base/string_data.h"
 #include "mongo/bson/bsonobj.h"
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/bson/bsontypes.h"
+#include "mongo/db/client.h"
 #include "mongo/db/exec/document_value/document.h"
 #include "mongo/db/exec/document_value/value.h"
+#include "mongo/db/operation_context.h"
 #include "mongo/db/pipeline/document_source_tee_consumer.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/field_path.h"
 #include "mongo/db/pipeline/pipeline.h"
 #include "mongo/db/pipeline/tee_buffer.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/future.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
@@ -62,15 +70,34 @@ DocumentSourceFacet::DocumentSourceFacet(std::vector<FacetPipeline> facetPipelin
     : DocumentSource(kStageName, expCtx),
       _teeBuffer(TeeBuffer::create(facetPipelines.size(), bufferSizeBytes)),
       _facets(std::move(facetPipelines)),
-      _maxOutputDocSizeBytes(maxOutputDocBytes) {
+      _maxOutputDocSizeBytes(maxOutputDocBytes),
+      _memoryTracker(false /* allowDiskUse */, maxOutputDocBytes) {
     for (size_t facetId = 0; facetId < _facets.size(); ++facetId) {
         auto& facet = _facets[facetId];
-        facet.pipeline->addInitialSource(
-            DocumentSourceTeeConsumer::create(pExpCtx, facetId, _teeBuffer, kTeeConsumerStageName));
+        // The consumer shares the ExpressionContext of its facet, since it runs with the facet.
+        facet.pipeline->addInitialSource(DocumentSourceTeeConsumer::create(
+            facet.pipeline->getContext(), facetId, _teeBuffer, kTeeConsumerStageName));
     }
 }
 
 namespace {
+/**
+ * The pool running the facets of $facet stages in parallel, see
+ * 'internalQueryFacetMaxParallelism'.
+ */
+std::unique_ptr<ThreadPool> facetThreadPool;
+
+MONGO_INITIALIZER(facetThreadPool)(InitializerContext* context) {
+    ThreadPool::Options options;
+    options.poolName = "facet pool";
+    options.threadNamePrefix = "Facet";
+    options.minThreads = 0;
+    options.maxThreads = 64;
+    options.onCreateThread = [](const std::string& name) { Client::initThread(name); };
+    facetThreadPool = std::make_unique<ThreadPool>(options);
+    facetThreadPool->startup();
+}
+
 /**
  * Extracts the names of the facets and the vectors of raw BSONObjs representing the stages within
  * that facet's pipeline.
@@ -144,6 +171,7 @@ void DocumentSourceFacet::doDispose() {
         facet.pipeline.get_deleter().dismissDisposal();
         facet.pipeline->dispose(pExpCtx->opCtx);
     }
+    _teeBuffer->disposeSourceIfUnused();
 }
 
 DocumentSource::GetNextResult DocumentSourceFacet::doGetNext() {
@@ -151,6 +179,11 @@ DocumentSource::GetNextResult DocumentSourceFacet::doGetNext() {
         return GetNextResult::makeEOF();
     }
 
+    const auto maxParallelism = static_cast<size_t>(internalQueryFacetMaxParallelism.load());
+    if (maxParallelism > 1 && canRunFacetsInParallel()) {
+        return runFacetsInParallel(maxParallelism);
+    }
+
     const size_t maxBytes = _maxOutputDocSizeBytes;
     auto ensureUnderMemoryLimit = [usedBytes = 0ul, &maxBytes](long long additional) mutable {
         usedBytes += additional;
@@ -185,6 +218,118 @@ DocumentSource::GetNextResult DocumentSourceFacet::doGetNext() {
     return resultDoc.freeze();
 }
 
+bool DocumentSourceFacet::canRunFacetsInParallel() const {
+    if (_facets.size() < 2 || pExpCtx->opCtx->inMultiDocumentTransaction()) {
+        return false;
+    }
+
+    // Stages check for interrupts through their ExpressionContext, and each thread runs with its
+    // own operation context, so facets must not share one.
+    stdx::unordered_set<const ExpressionContext*> contexts{pExpCtx.get()};
+    for (auto&& facet : _facets) {
+        if (!contexts.insert(facet.pipeline->getContext().get()).second) {
+            return false;
+        }
+    }
+
+    // Reading another collection needs the locks and storage snapshot of the operation.
+    stdx::unordered_set<NamespaceString> involvedCollections;
+    addInvolvedCollections(&involvedCollections);
+    return involvedCollections.empty();
+}
+
+DocumentSource::GetNextResult DocumentSourceFacet::runFacetsInParallel(size_t maxParallelism) {
+    _teeBuffer->setLoadedByOwner();
+
+    const long long maxBytes = _maxOutputDocSizeBytes;
+    auto assertUnderMemoryLimit = [maxBytes](long long usedBytes) {
+        uassert(4031700,
+                str::stream() << "document constructed by $facet is " << usedBytes
+                              << " bytes, which exceeds the limit of " << maxBytes << " bytes",
+                usedBytes <= maxBytes);
+    };
+
+    // Each entry is only written by the thread currently running that facet.
+    vector<vector<Value>> results(_facets.size());
+    vector<long long> resultBytes(_facets.size(), 0);
+    vector<char> facetEOF(_facets.size(), false);
+
+    auto runFacet = [&](size_t facetId) {
+        const auto& pipeline = _facets[facetId].pipeline;
+        auto next = pipeline->getSources().back()->getNext();
+        for (; next.isAdvanced(); next = pipeline->getSources().back()->getNext()) {
+            resultBytes[facetId] += next.getDocument().getApproximateSize();
+            assertUnderMemoryLimit(resultBytes[facetId]);
+            results[facetId].emplace_back(next.releaseDocument());
+        }
+        facetEOF[facetId] = next.isEOF();
+    };
+
+    auto opCtx = pExpCtx->opCtx;
+    while (std::count(facetEOF.begin(), facetEOF.end(), false) > 0) {
+        _teeBuffer->loadNextBatchForConsumers();
+
+        vector<size_t> facetsToRun;
+        for (size_t facetId = 0; facetId < _facets.size(); ++facetId) {
+            if (!facetEOF[facetId]) {
+                facetsToRun.push_back(facetId);
+            }
+        }
+
+        // Each thread keeps picking the next facet to run on this batch until there are none left.
+        AtomicWord<size_t> nextFacet{0};
+        const auto numThreads = std::min(maxParallelism, facetsToRun.size());
+        vector<Future<void>> futures;
+        for (size_t i = 0; i < numThreads; ++i) {
+            auto pf = makePromiseFuture<void>();
+            facetThreadPool->schedule([&, promise = std::move(pf.promise)](auto status) mutable {
+                invariant(status);
+
+                auto facetOpCtx = cc().makeOperationContext();
+                promise.setWith([&] {
+                    for (auto ix = nextFacet.fetchAndAdd(1); ix < facetsToRun.size();
+                         ix = nextFacet.fetchAndAdd(1)) {
+                        const auto& pipeline = _facets[facetsToRun[ix]].pipeline;
+                        pipeline->reattachToOperationContext(facetOpCtx.get());
+                        ON_BLOCK_EXIT([&] { pipeline->reattachToOperationContext(opCtx); });
+                        runFacet(facetsToRun[ix]);
+                    }
+                });
+            });
+            futures.push_back(std::move(pf.future));
+        }
+
+        // Wait for all threads before reporting any error, as they reference this stack frame.
+        Status batchStatus = Status::OK();
+        for (auto&& future : futures) {
+            auto status = future.getNoThrow();
+            if (batchStatus.isOK() && !status.isOK()) {
+                batchStatus = status;
+            }
+        }
+        uassertStatusOK(batchStatus);
+
+        for (size_t facetId = 0; facetId < _facets.size(); ++facetId) {
+            _memoryTracker.set(_facets[facetId].name, resultBytes[facetId]);
+            accumulatePipelinePlanSummaryStats(*_facets[facetId].pipeline,
+                                               _stats.planSummaryStats);
+        }
+        assertUnderMemoryLimit(_memoryTracker.currentMemoryBytes());
+
+        // The threads running the facets do not see an interrupt of this operation.
+        opCtx->checkForInterrupt();
+    }
+    _teeBuffer->disposeSourceIfUnused();
+
+    MutableDocument resultDoc;
+    for (size_t facetId = 0; facetId < _facets.size(); ++facetId) {
+        resultDoc[_facets[facetId].name] = Value(std::move(results[facetId]));
+    }
+
+    _done = true;  // We will only ever produce one result.
+    return resultDoc.freeze();
+}
+
 Value DocumentSourceFacet::serialize(boost::optional<ExplainOptions::Verbosity> explain) const {
     MutableDocument serialized;
     for (auto&& facet : _facets) {
@@ -317,11 +462,18 @@ intrusive_ptr<DocumentSource> DocumentSourceFacet::createFromBson(
     boost::optional<std::string> needsMongoS;
     boost::optional<std::string> needsShard;
 
+    // Facets which may run in parallel each get their own copy of the ExpressionContext. Facets of
+    // a nested pipeline keep sharing the parent's, since its variables can change between
+    // executions.
+    const bool mayRunInParallel = internalQueryFacetMaxParallelism.load() > 1 &&
+        !expCtx->inLookup && expCtx->subPipelineDepth == 0;
+
     std::vector<FacetPipeline> facetPipelines;
     for (auto&& rawFacet : extractRawPipelines(elem)) {
         const auto facetName = rawFacet.first;
 
-        auto pipeline = Pipeline::parse(rawFacet.second, expCtx, [](const Pipeline& pipeline) {
+        auto facetExpCtx = mayRunInParallel ? expCtx->copyWith(expCtx->ns, expCtx->uuid) : expCtx;
+        auto pipeline = Pipeline::parse(rawFacet.second, facetExpCtx, [](const Pipeline& pipeline) {
             auto sources = pipeline.getSources();
             std::for_each(sources.begin(), sources.end(), [](auto& stage) {
                 auto stageConstraints = stage->constraints();
@@ -37,6 +37,7 @@
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/lite_parsed_document_source.h"
 #include "mongo/db/pipeline/lite_parsed_pipeline.h"
+#include "mongo/db/pipeline/memory_usage_tracker.h"
 #include "mongo/db/pipeline/pipeline.h"
 
 namespace mongo {
@@ -162,11 +163,28 @@ private:
 
     Value serialize(boost::optional<ExplainOptions::Verbosity> explain = boost::none) const final;
 
+    /**
+     * Returns true if the facets can run on threads other than the one of the operation: there is
+     * more than one facet, each facet has its own ExpressionContext, no facet reads from another
+     * collection and we are not in a multi-document transaction.
+     */
+    bool canRunFacetsInParallel() const;
+
+    /**
+     * Produces the result of the stage by running up to 'maxParallelism' facets at a time on the
+     * facet thread pool. The '_teeBuffer' is loaded on this thread, one batch at a time, and the
+     * facets consume each batch concurrently.
+     */
+    GetNextResult runFacetsInParallel(size_t maxParallelism);
+
     boost::intrusive_ptr<TeeBuffer> _teeBuffer;
     std::vector<FacetPipeline> _facets;
 
     const size_t _maxOutputDocSizeBytes;
 
+    // Tracks the size of the output of each facet when they run in parallel.
+    MemoryUsageTracker _memoryTracker;
+
     bool _done = false;
 
     DocumentSourceFacetStats _stats;
@@ -44,6 +44,7 @@
 #include "mongo/db/pipeline/document_source_limit.h"
 #include "mongo/db/pipeline/document_source_mock.h"
 #include "mongo/db/pipeline/document_source_skip.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/unittest.h"
 
@@ -434,6 +435,70 @@ TEST_F(DocumentSourceFacetTest,
     ASSERT(facetStage->getNext().isEOF());
 }
 
+TEST_F(DocumentSourceFacetTest, ShouldProduceSameResultsWhenRunningFacetsInParallel) {
+    RAIIServerParameterControllerForTest controller("internalQueryFacetMaxParallelism", 2);
+    auto ctx = getExpCtx();
+
+    deque<DocumentSource::GetNextResult> inputs;
+    vector<Value> expectedPassthroughOutput;
+    for (int i = 0; i < 10; ++i) {
+        inputs.emplace_back(Document{{"_id", i}});
+        expectedPassthroughOutput.emplace_back(Document{{"_id", i}});
+    }
+    auto mock = DocumentSourceMock::createForTest(inputs, ctx);
+
+    // Each facet runs with its own ExpressionContext, as when parsed with parallelism enabled.
+    std::vector<DocumentSourceFacet::FacetPipeline> facets;
+    for (auto&& name : {"all", "allAgain"}) {
+        auto facetCtx = ctx->copyWith(ctx->ns);
+        auto passthrough = DocumentSourcePassthrough::create(facetCtx);
+        facets.emplace_back(name, Pipeline::create({passthrough}, facetCtx));
+    }
+    auto limitCtx = ctx->copyWith(ctx->ns);
+    facets.emplace_back("first",
+                        Pipeline::create({DocumentSourceLimit::create(limitCtx, 1)}, limitCtx));
+
+    const size_t bufferBytes = 1;  // Each document is a batch of its own.
+    auto facetStage = DocumentSourceFacet::create(std::move(facets), ctx, bufferBytes);
+    facetStage->setSource(mock.get());
+
+    auto output = facetStage->getNext();
+    ASSERT(output.isAdvanced());
+    ASSERT_EQ(output.getDocument().computeSize(), 3ULL);
+    ASSERT_VALUE_EQ(output.getDocument()["all"], Value(expectedPassthroughOutput));
+    ASSERT_VALUE_EQ(output.getDocument()["allAgain"], Value(expectedPassthroughOutput));
+    ASSERT_VALUE_EQ(output.getDocument()["first"],
+                    Value(vector<Value>{Value(expectedPassthroughOutput.front())}));
+
+    // Should be exhausted now.
+    ASSERT(facetStage->getNext().isEOF());
+    ASSERT(facetStage->getNext().isEOF());
+}
+
+TEST_F(DocumentSourceFacetTest, ShouldEnforceOutputSizeLimitWhenRunningFacetsInParallel) {
+    RAIIServerParameterControllerForTest controller("internalQueryFacetMaxParallelism", 2);
+    auto ctx = getExpCtx();
+
+    deque<DocumentSource::GetNextResult> inputs = {
+        Document{{"_id", 0}}, Document{{"_id", 1}}, Document{{"_id", 2}}};
+    auto mock = DocumentSourceMock::createForTest(inputs, ctx);
+
+    std::vector<DocumentSourceFacet::FacetPipeline> facets;
+    for (auto&& name : {"a", "b"}) {
+        auto facetCtx = ctx->copyWith(ctx->ns);
+        auto passthrough = DocumentSourcePassthrough::create(facetCtx);
+        facets.emplace_back(name, Pipeline::create({passthrough}, facetCtx));
+    }
+
+    // Each facet fits on its own, but not both of them together.
+    const size_t maxOutputDocBytes = 3 * Document{{"_id", 0}}.getApproximateSize();
+    auto facetStage = DocumentSourceFacet::create(
+        std::move(facets), ctx, 1 /* bufferSizeBytes */, maxOutputDocBytes);
+    facetStage->setSource(mock.get());
+
+    ASSERT_THROWS_CODE(facetStage->getNext(), AssertionException, 4031700);
+}
+
 TEST_F(DocumentSourceFacetTest, ShouldBeAbleToEvaluateMultipleStagesWithinOneSubPipeline) {
     auto ctx = getExpCtx();
 
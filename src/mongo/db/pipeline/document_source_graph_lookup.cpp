@@ -204,6 +204,7 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::getNextUnwound() {
 void DocumentSourceGraphLookUp::doDispose() {
     _cache.clear();
     _frontier.clear();
+    _queried.clear();
     _visited.clear();
 }
 
@@ -242,6 +243,13 @@ void DocumentSourceGraphLookUp::doBreadthFirstSearch() {
 
         shouldPerformAnotherQuery = false;
 
+        // Every value on the frontier is about to be resolved, either from the cache or by the
+        // query below, so it never needs to be looked up again during this search.
+        for (auto&& value : _frontier) {
+            _queried.insert(value);
+            _queriedUsageBytes += value.getApproximateSize();
+        }
+
         // Check whether each key in the frontier exists in the cache or needs to be queried.
         auto cached = pExpCtx->getDocumentComparator().makeUnorderedDocumentSet();
         auto matchStage = makeMatchStageFromFrontier(&cached);
@@ -333,6 +341,8 @@ void DocumentSourceGraphLookUp::doBreadthFirstSearch() {
 
     _frontier.clear();
     _frontierUsageBytes = 0;
+    _queried.clear();
+    _queriedUsageBytes = 0;
 }
 
 bool DocumentSourceGraphLookUp::addToVisitedAndFrontier(Document result, long long depth) {
@@ -356,8 +366,10 @@ bool DocumentSourceGraphLookUp::addToVisitedAndFrontier(Document result, long lo
     // '_frontier'.
     document_path_support::visitAllValuesAtPath(
         result, _connectFromField, [this](const Value& nextFrontierValue) {
-            _frontier.insert(nextFrontierValue);
-            _frontierUsageBytes += nextFrontierValue.getApproximateSize();
+            if (_queried.find(nextFrontierValue) == _queried.end() &&
+                _frontier.insert(nextFrontierValue).second) {
+                _frontierUsageBytes += nextFrontierValue.getApproximateSize();
+            }
         });
 
     // Add the object to our '_visited' list and update the size of '_visited' appropriately.
@@ -540,8 +552,10 @@ void DocumentSourceGraphLookUp::checkMemoryUsage() {
     // TODO SERVER-23980: Implement spilling to disk if allowDiskUse is specified.
     uassert(40099,
             "$graphLookup reached maximum memory consumption",
-            (_visitedUsageBytes + _frontierUsageBytes) < _maxMemoryUsageBytes);
-    _cache.evictDownTo(_maxMemoryUsageBytes - _frontierUsageBytes - _visitedUsageBytes);
+            (_visitedUsageBytes + _frontierUsageBytes + _queriedUsageBytes) <
+                _maxMemoryUsageBytes);
+    _cache.evictDownTo(_maxMemoryUsageBytes - _frontierUsageBytes - _visitedUsageBytes -
+                       _queriedUsageBytes);
 }
 
 void DocumentSourceGraphLookUp::serializeToArray(
@@ -619,7 +633,9 @@ DocumentSourceGraphLookUp::DocumentSourceGraphLookUp(
       _additionalFilter(additionalFilter),
       _depthField(depthField),
       _maxDepth(maxDepth),
+      _maxMemoryUsageBytes(internalDocumentSourceGraphLookupMaxMemoryBytes.load()),
       _frontier(pExpCtx->getValueComparator().makeUnorderedValueSet()),
+      _queried(pExpCtx->getValueComparator().makeUnorderedValueSet()),
       _visited(ValueComparator::kInstance.makeUnorderedValueMap<Document>()),
       _cache(pExpCtx->getValueComparator()),
       _unwind(unwindSrc),
@@ -652,7 +668,9 @@ DocumentSourceGraphLookUp::DocumentSourceGraphLookUp(
           original._fromExpCtx->copyWith(original.pExpCtx->getResolvedNamespace(_from).ns,
                                          original.pExpCtx->getResolvedNamespace(_from).uuid)),
       _fromPipeline(original._fromPipeline),
+      _maxMemoryUsageBytes(internalDocumentSourceGraphLookupMaxMemoryBytes.load()),
       _frontier(pExpCtx->getValueComparator().makeUnorderedValueSet()),
+      _queried(pExpCtx->getValueComparator().makeUnorderedValueSet()),
       _visited(ValueComparator::kInstance.makeUnorderedValueMap<Document>()),
       _cache(pExpCtx->getValueComparator()),
       _variables(original._variables),
@@ -229,8 +229,9 @@ private:
     void addToCache(const Document& result, const ValueUnorderedSet& queried);
 
     /**
-     * Assert that '_visited' and '_frontier' have not exceeded the maximum meory usage, and then
-     * evict from '_cache' until this source is using less than '_maxMemoryUsageBytes'.
+     * Assert that '_visited', '_frontier' and '_queried' have not exceeded the maximum memory
+     * usage, and then evict from '_cache' until this source is using less than
+     * '_maxMemoryUsageBytes'.
      */
     void checkMemoryUsage();
 
@@ -264,15 +265,23 @@ private:
     // The aggregation pipeline to perform against the '_from' namespace.
     std::vector<BSONObj> _fromPipeline;
 
-    size_t _maxMemoryUsageBytes = 100 * 1024 * 1024;
+    // Set from 'internalDocumentSourceGraphLookupMaxMemoryBytes' when the stage is created.
+    size_t _maxMemoryUsageBytes;
 
     // Track memory usage to ensure we don't exceed '_maxMemoryUsageBytes'.
     size_t _visitedUsageBytes = 0;
     size_t _frontierUsageBytes = 0;
+    size_t _queriedUsageBytes = 0;
 
     // Only used during the breadth-first search, tracks the set of values on the current frontier.
     ValueUnorderedSet _frontier;
 
+    // Only used during the breadth-first search, tracks every value that has been on the frontier
+    // so far. All documents connecting to such a value have already been visited, so the value is
+    // never placed on the frontier again. This keeps densely connected or cyclic graphs from
+    // querying for the same values at every depth.
+    ValueUnorderedSet _queried;
+
     // Tracks nodes that have been discovered for a given input. Keys are the '_id' value of the
     // document from the foreign collection, value is the document itself.  The keys are compared
     // using the simple collation.
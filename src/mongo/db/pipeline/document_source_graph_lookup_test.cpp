@@ -39,6 +39,7 @@
 #include "mongo/db/pipeline/document_source_graph_lookup.h"
 #include "mongo/db/pipeline/document_source_mock.h"
 #include "mongo/db/pipeline/process_interface/stub_mongo_process_interface.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/str.h"
@@ -71,11 +72,17 @@ public:
             ownedPipeline, PipelineDeleter(ownedPipeline->getContext()->opCtx));
         pipeline->addInitialSource(
             DocumentSourceMock::createForTest(_results, pipeline->getContext()));
+        ++_numPipelinesAttached;
         return pipeline;
     }
 
+    int numPipelinesAttached() const {
+        return _numPipelinesAttached;
+    }
+
 private:
     std::deque<DocumentSource::GetNextResult> _results;
+    int _numPipelinesAttached = 0;
 };
 
 // Tests that $graphLookup with special 'from' syntax from: {db: local, coll:
@@ -713,5 +720,104 @@ TEST_F(DocumentSourceGraphLookUpTest, ShouldNotExpandArraysWithinArraysAtEndOfCo
     ASSERT(graphLookupStage->getNext().isEOF());
 }
 
+TEST_F(DocumentSourceGraphLookUpTest, ShouldNotQueryForValueAlreadyOnAnEarlierFrontier) {
+    auto expCtx = getExpCtx();
+
+    std::deque<DocumentSource::GetNextResult> inputs{Document{{"_id", 0}, {"startVal", 0}}};
+    auto inputMock = DocumentSourceMock::createForTest(std::move(inputs), expCtx);
+
+    /* Make the following graph, where no document has an '_id' of 99:
+     * 0 -> 1 -> 99
+     *  \        ^
+     *   `-------'
+     *
+     * 99 is on the frontier at depth 1 and is reached again at depth 2. As no document matches
+     * it, it is never cached, so only the record of queried values prevents a third query.
+     */
+    Document startDoc{{"_id", 0}, {"to", std::vector{1, 99}}};
+    Document middleDoc{{"_id", 1}, {"to", 99}};
+
+    std::deque<DocumentSource::GetNextResult> fromContents{Document(startDoc), Document(middleDoc)};
+
+    NamespaceString fromNs("test", "graph_lookup");
+    expCtx->setResolvedNamespaces(StringMap<ExpressionContext::ResolvedNamespace>{
+        {fromNs.coll().toString(), {fromNs, std::vector<BSONObj>()}}});
+    auto mongoInterface = std::make_shared<MockMongoInterface>(std::move(fromContents));
+    expCtx->mongoProcessInterface = mongoInterface;
+    auto graphLookupStage = DocumentSourceGraphLookUp::create(
+        expCtx,
+        fromNs,
+        "results",
+        "to",
+        "_id",
+        ExpressionFieldPath::deprecatedCreate(expCtx.get(), "startVal"),
+        boost::none,
+        boost::none,
+        boost::none,
+        boost::none);
+    graphLookupStage->setSource(inputMock.get());
+
+    auto next = graphLookupStage->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+
+    auto resultsValue = next.getDocument().getField("results");
+    ASSERT(resultsValue.isArray());
+    auto resultsArray = resultsValue.getArray();
+    ASSERT_EQ(2U, resultsArray.size());
+    ASSERT(arrayContains(expCtx, resultsArray, Value(startDoc)));
+    ASSERT(arrayContains(expCtx, resultsArray, Value(middleDoc)));
+    ASSERT(graphLookupStage->getNext().isEOF());
+
+    // One query for {_id: {$in: [0]}} and one for {_id: {$in: [1, 99]}}.
+    ASSERT_EQ(2, mongoInterface->numPipelinesAttached());
+}
+
+TEST_F(DocumentSourceGraphLookUpTest, ShouldFailWhenExceedingConfiguredMemoryLimit) {
+    auto expCtx = getExpCtx();
+
+    std::deque<DocumentSource::GetNextResult> inputs{Document{{"_id", 0}, {"startVal", 0}},
+                                                     Document{{"_id", 1}, {"startVal", 0}}};
+    auto inputMock = DocumentSourceMock::createForTest(std::move(inputs), expCtx);
+
+    std::deque<DocumentSource::GetNextResult> fromContents{
+        Document{{"_id", 0}, {"to", 1}, {"padding", std::string(1024, 'x')}},
+        Document{{"_id", 1}}};
+
+    NamespaceString fromNs("test", "graph_lookup");
+    expCtx->setResolvedNamespaces(StringMap<ExpressionContext::ResolvedNamespace>{
+        {fromNs.coll().toString(), {fromNs, std::vector<BSONObj>()}}});
+    expCtx->mongoProcessInterface = std::make_shared<MockMongoInterface>(std::move(fromContents));
+
+    auto makeStage = [&] {
+        auto stage = DocumentSourceGraphLookUp::create(
+            expCtx,
+            fromNs,
+            "results",
+            "to",
+            "_id",
+            ExpressionFieldPath::deprecatedCreate(expCtx.get(), "startVal"),
+            boost::none,
+            boost::none,
+            boost::none,
+            boost::none);
+        stage->setSource(inputMock.get());
+        return stage;
+    };
+
+    // The limit is read when the stage is created, so a stage created under the default limit
+    // keeps it after the knob is lowered.
+    auto defaultLimitStage = makeStage();
+    {
+        RAIIServerParameterControllerForTest maxMemory(
+            "internalDocumentSourceGraphLookupMaxMemoryBytes", 512);
+        auto lowLimitStage = makeStage();
+        ASSERT_THROWS_CODE(lowLimitStage->getNext(), AssertionException, 40099);
+
+        auto next = defaultLimitStage->getNext();
+        ASSERT_TRUE(next.isAdvanced());
+        ASSERT_EQ(2U, next.getDocument().getField("results").getArray().size());
+    }
+}
+
 }  // namespace
 }  // namespace mongo
@@ -930,6 +930,26 @@ private:
     }
 };
 
+/** Null and missing monotonic values may be interleaved, but still form separate groups. */
+class StreamingNullishIds final : public CheckResultsBase {
+public:
+    StreamingNullishIds() : CheckResultsBase(GroupStageType::Streaming) {}
+
+private:
+    deque<DocumentSource::GetNextResult> inputData() final {
+        return {Document(BSON("a" << BSONNULL << "b" << 1)),
+                Document(BSON("b" << 2)),
+                Document(BSON("a" << BSONNULL << "b" << 4)),
+                Document(BSON("a" << 1 << "b" << 8))};
+    }
+    BSONObj groupSpec() final {
+        return fromjson("{_id: {x: '$a'}, sum: {$sum: '$b'}, $monotonicIdFields: ['x']}");
+    }
+    string expectedResultSetString() final {
+        return "[{_id:{},sum:2},{_id:{x:null},sum:5},{_id:{x:1},sum:8}]";
+    }
+};
+
 constexpr size_t kBigStringSize = 1024;
 const std::string kBigString(kBigStringSize, 'a');
 
@@ -1225,6 +1245,7 @@ public:
         add<StreamingAlternatingSpillAndNoSpillBatches>();
         add<StreamingComplex>();
         add<StreamingMultipleMonotonicFields>();
+        add<StreamingNullishIds>();
 #if 0
         // Disabled tests until SERVER-23318 is implemented.
         add<StreamingOptimization>();
@@ -551,7 +551,27 @@ void DocumentSourceInternalUnpackBucket::serializeToArray(
 
 boost::optional<Document> DocumentSourceInternalUnpackBucket::getNextMatchingMeasure() {
     while (_bucketUnpacker.hasNext()) {
-        if (_eventFilter) {
+        if (_eventFilter && !_bucketUnpacker.bucketMatchedQuery() &&
+            !_eventFilterDeps.needWholeDocument) {
+            // Evaluate the filter on only the fields it depends on, and skip over measurements
+            // which do not match without materializing them.
+            if (!_eventFilterTopLevelFields) {
+                _eventFilterTopLevelFields.emplace();
+                for (auto&& path : _eventFilterDeps.fields) {
+                    _eventFilterTopLevelFields->insert(path.substr(0, path.find('.')));
+                }
+            }
+            BSONObjBuilder filterFields;
+            _bucketUnpacker.peekNextBson(filterFields, *_eventFilterTopLevelFields);
+            if (!_eventFilter->matchesBSON(filterFields.done())) {
+                _bucketUnpacker.skipNext();
+                continue;
+            }
+            if (_unpackToBson) {
+                return Document(_bucketUnpacker.getNextBson());
+            }
+            return _bucketUnpacker.getNext();
+        } else if (_eventFilter) {
             if (_unpackToBson) {
                 auto measure = _bucketUnpacker.getNextBson();
                 if (_bucketUnpacker.bucketMatchedQuery() || _eventFilter->matchesBSON(measure)) {
@@ -750,28 +770,55 @@ DocumentSourceInternalUnpackBucket::rewriteGroupByMinMax(Pipeline::SourceContain
     }
     const auto& metaField = *_bucketUnpacker.bucketSpec().metaField();
 
-    const auto& idFields = groupPtr->getIdFields();
+    // Rewrites a group key expression in terms of the bucket-level fields, or returns nullptr if
+    // it cannot be computed from the bucket. Constants are kept as they are, and paths must be at
+    // or under the metaField (the zero component of a path is always CURRENT).
+    auto rewriteIdExpression =
+        [&](const boost::intrusive_ptr<Expression>& expr) -> boost::intrusive_ptr<Expression> {
+        if (dynamic_cast<const ExpressionConstant*>(expr.get())) {
+            return expr;
+        }
 
-    // Currently, we only support simple group key. TODO: SERVER-68811. Allow rewrites of object
-    // group key if all its fields depend on the metaField only.
-    if (idFields.size() != 1) {
-        return {};
-    }
+        const auto* exprIdPath = dynamic_cast<const ExpressionFieldPath*>(expr.get());
+        if (exprIdPath == nullptr) {
+            return nullptr;
+        }
 
-    const auto& exprId = idFields.cbegin()->second;
-    const auto* exprIdPath = dynamic_cast<const ExpressionFieldPath*>(exprId.get());
+        const auto& idPath = exprIdPath->getFieldPath();
+        if (idPath.getPathLength() < 2 || idPath.getFieldName(1) != metaField) {
+            return nullptr;
+        }
 
-    // Currently, we only support group key expression of the form {_id : "<path>"}.
-    // TODO: SERVER-68811. Allow rewrites if expression is constant.
-    if (exprIdPath == nullptr) {
-        return {};
-    }
+        std::ostringstream os;
+        os << timeseries::kBucketMetaFieldName;
+        for (size_t index = 2; index < idPath.getPathLength(); index++) {
+            os << "." << idPath.getFieldName(index);
+        }
+        return ExpressionFieldPath::createPathFromString(
+            pExpCtx.get(), os.str(), pExpCtx->variablesParseState);
+    };
 
-    const auto& idPath = exprIdPath->getFieldPath();
-    // {The path must be at or under the metaField for this re-write to be correct (and the zero
-    // component is always CURRENT).}
-    if (idPath.getPathLength() < 2 || idPath.getFieldName(1) != metaField) {
-        return {};
+    // The group key is either a single expression or an object whose fields must all depend on
+    // the metaField only.
+    boost::intrusive_ptr<Expression> rewrittenIdExpression;
+    const auto& idFields = groupPtr->getIdFields();
+    const auto& idFieldNames = groupPtr->getIdFieldNames();
+    if (idFieldNames.empty()) {
+        rewrittenIdExpression = rewriteIdExpression(idFields.cbegin()->second);
+        if (!rewrittenIdExpression) {
+            return {};
+        }
+    } else {
+        std::vector<std::pair<std::string, boost::intrusive_ptr<Expression>>> rewrittenIdFields;
+        for (const auto& idFieldName : idFieldNames) {
+            auto rewritten = rewriteIdExpression(idFields.at("_id." + idFieldName));
+            if (!rewritten) {
+                return {};
+            }
+            rewrittenIdFields.emplace_back(idFieldName, std::move(rewritten));
+        }
+        rewrittenIdExpression =
+            ExpressionObject::create(pExpCtx.get(), std::move(rewrittenIdFields));
     }
 
     std::vector<AccumulationStatement> accumulationStatementsBucket;
@@ -846,27 +893,6 @@ DocumentSourceInternalUnpackBucket::rewriteGroupByMinMax(Pipeline::SourceContain
         accumulationStatementsBucket.emplace_back(stmt.fieldName, std::move(accExpr));
     }
 
-    // Re-create the group key using the bucket-level path.
-    std::ostringstream os;
-    os << timeseries::kBucketMetaFieldName;
-    for (size_t index = 2; index < idPath.getPathLength(); index++) {
-        os << "." << idPath.getFieldName(index);
-    }
-    auto exprIdBucket = ExpressionFieldPath::createPathFromString(
-        pExpCtx.get(), os.str(), pExpCtx->variablesParseState);
-
-    boost::intrusive_ptr<Expression> rewrittenIdExpression;
-    const auto& idFieldNames = groupPtr->getIdFieldNames();
-    if (idFieldNames.empty()) {
-        rewrittenIdExpression = exprIdBucket;
-    } else {
-        // idFieldNames can only have size 1 here since we only support simple group key.
-        // TODO: SERVER-68811. Allow rewrites of object group key if all its fields depend on the
-        // metaField only.
-        rewrittenIdExpression =
-            ExpressionObject::create(pExpCtx.get(), {{idFieldNames[0], exprIdBucket}});
-    }
-
     auto newGroup = DocumentSourceGroup::create(pExpCtx,
                                                 std::move(rewrittenIdExpression),
                                                 std::move(accumulationStatementsBucket),
@@ -296,6 +296,9 @@ private:
     std::unique_ptr<MatchExpression> _eventFilter;
     BSONObj _eventFilterBson;
     DepsTracker _eventFilterDeps;
+    // The top-level fields '_eventFilter' depends on. Computed on first use, once the filter can
+    // no longer change.
+    boost::optional<StringSet> _eventFilterTopLevelFields;
     std::unique_ptr<MatchExpression> _wholeBucketFilter;
     BSONObj _wholeBucketFilterBson;
 
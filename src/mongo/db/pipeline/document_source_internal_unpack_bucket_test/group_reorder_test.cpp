@@ -185,5 +185,54 @@ TEST_F(InternalUnpackBucketGroupReorder, MinMaxGroupOnMetafieldIdObj) {
     ASSERT_BSONOBJ_EQ(optimized, serialized[0]);
 }
 
+TEST_F(InternalUnpackBucketGroupReorder, MinMaxGroupOnMetafieldCompoundIdObj) {
+    auto unpackSpecObj = fromjson(
+        "{$_internalUnpackBucket: { include: ['a', 'b', 'c'], metaField: 'meta1', timeField: 't', "
+        "bucketMaxSpanSeconds: 3600}}");
+
+    auto groupSpecObj = fromjson(
+        "{$group: {_id: {d: '$meta1.a.b', e: '$meta1.c', f: 'x'}, accmax: {$max: '$b'}}}");
+
+    auto pipeline = Pipeline::parse(makeVector(unpackSpecObj, groupSpecObj), getExpCtx());
+    pipeline->optimizePipeline();
+    auto serialized = pipeline->serializeToBson();
+    ASSERT_EQ(1, serialized.size());
+    auto optimized = fromjson(
+        "{$group: {_id: {d: '$meta.a.b', e: '$meta.c', f: {$const: 'x'}}, accmax: {$max: "
+        "'$control.max.b'}}}");
+    ASSERT_BSONOBJ_EQ(optimized, serialized[0]);
+}
+
+TEST_F(InternalUnpackBucketGroupReorder, MinMaxGroupOnConstantId) {
+    auto unpackSpecObj = fromjson(
+        "{$_internalUnpackBucket: { include: ['a', 'b', 'c'], metaField: 'meta1', timeField: 't', "
+        "bucketMaxSpanSeconds: 3600}}");
+
+    auto groupSpecObj = fromjson("{$group: {_id: null, accmin: {$min: '$b'}}}");
+
+    auto pipeline = Pipeline::parse(makeVector(unpackSpecObj, groupSpecObj), getExpCtx());
+    pipeline->optimizePipeline();
+    auto serialized = pipeline->serializeToBson();
+    ASSERT_EQ(1, serialized.size());
+    auto optimized = fromjson("{$group: {_id: {$const: null}, accmin: {$min: '$control.min.b'}}}");
+    ASSERT_BSONOBJ_EQ(optimized, serialized[0]);
+}
+
+TEST_F(InternalUnpackBucketGroupReorder, MinMaxGroupOnCompoundIdObjNegative) {
+    auto unpackSpecObj = fromjson(
+        "{$_internalUnpackBucket: { include: ['a', 'b', 'c'], timeField: 't', metaField: 'meta', "
+        "bucketMaxSpanSeconds: 3600}}");
+
+    // One of the group key fields is a measurement field, so the rewrite does not apply.
+    auto groupSpecObj =
+        fromjson("{$group: {_id: {d: '$meta.a', e: '$a'}, accmin: {$min: '$b'}}}");
+
+    auto pipeline = Pipeline::parse(makeVector(unpackSpecObj, groupSpecObj), getExpCtx());
+    pipeline->optimizePipeline();
+    auto serialized = pipeline->serializeToBson();
+    ASSERT_EQ(2, serialized.size());
+    ASSERT_BSONOBJ_EQ(unpackSpecObj, serialized[0]);
+}
+
 }  // namespace
 }  // namespace mongo
@@ -39,6 +39,7 @@
 #include "mongo/db/pipeline/aggregation_request_helper.h"
 #include "mongo/db/pipeline/document_path_support.h"
 #include "mongo/db/pipeline/document_source_documents.h"
+#include "mongo/db/pipeline/document_source_limit.h"
 #include "mongo/db/pipeline/document_source_merge_gen.h"
 #include "mongo/db/pipeline/document_source_sort.h"
 #include "mongo/db/pipeline/expression.h"
@@ -50,6 +51,7 @@
 #include "mongo/logv2/log.h"
 #include "mongo/platform/overflow_arithmetic.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/string_map.h"
 
 namespace mongo {
 namespace {
@@ -459,6 +461,18 @@ DocumentSource::GetNextResult DocumentSourceLookUp::doGetNext() {
         _resolvedPipeline[*_fieldMatchPipelineIdx] = matchStage;
     }
 
+    // Serve the results from the memo if the same correlated values have been seen before.
+    auto resultMemo = getResultMemo();
+    BSONObj resultMemoKey;
+    if (resultMemo) {
+        resultMemoKey = makeResultMemoKey(inputDoc);
+        if (auto memoized = resultMemo->find(resultMemoKey)) {
+            MutableDocument output(std::move(inputDoc));
+            output.setNestedField(_as, Value(*memoized));
+            return output.freeze();
+        }
+    }
+
     std::unique_ptr<Pipeline, PipelineDeleter> pipeline;
     try {
         pipeline = buildPipeline(inputDoc);
@@ -498,11 +512,75 @@ DocumentSource::GetNextResult DocumentSourceLookUp::doGetNext() {
     }
 
     accumulatePipelinePlanSummaryStats(*pipeline, _stats.planSummaryStats);
+    if (resultMemo) {
+        resultMemo->insert(resultMemoKey, results);
+    }
+
     MutableDocument output(std::move(inputDoc));
     output.setNestedField(_as, Value(std::move(results)));
     return output.freeze();
 }
 
+namespace {
+/**
+ * Stages and expressions whose output may differ between two runs over the same data. A
+ * sub-pipeline using any of them cannot have its results memoized.
+ */
+const StringDataSet kNonDeterministicNames{"$sample",
+                                           "$sampleRate",
+                                           "$rand",
+                                           "$function",
+                                           "$accumulator",
+                                           "$where",
+                                           "$currentOp",
+                                           "$listLocalSessions",
+                                           "$listSessions",
+                                           "$collStats",
+                                           "$indexStats",
+                                           "$planCacheStats"};
+
+bool containsNonDeterministicName(const BSONObj& obj) {
+    for (auto&& elem : obj) {
+        if (kNonDeterministicNames.count(elem.fieldNameStringData())) {
+            return true;
+        }
+        if (elem.isABSONObj() && containsNonDeterministicName(elem.Obj())) {
+            return true;
+        }
+    }
+    return false;
+}
+}  // namespace
+
+LookupResultMemo* DocumentSourceLookUp::getResultMemo() {
+    if (!_resultMemoAllowed) {
+        // Results read inside a multi-document transaction can change with the transaction's own
+        // writes between batches, so they are never memoized.
+        const auto maxSizeBytes = internalDocumentSourceLookupResultMemoSizeBytes.load();
+        _resultMemoAllowed = maxSizeBytes > 0 && !_unwindSrc &&
+            !(pExpCtx->opCtx && pExpCtx->opCtx->inMultiDocumentTransaction()) &&
+            std::none_of(_resolvedPipeline.begin(),
+                         _resolvedPipeline.end(),
+                         [](const BSONObj& stage) { return containsNonDeterministicName(stage); });
+        if (*_resultMemoAllowed) {
+            _resultMemo.emplace(maxSizeBytes);
+        }
+    }
+    return _resultMemo.get_ptr();
+}
+
+BSONObj DocumentSourceLookUp::makeResultMemoKey(const Document& inputDoc) {
+    BSONObjBuilder keyBuilder;
+    for (auto& letVar : _letVariables) {
+        letVar.expression->evaluate(inputDoc, &pExpCtx->variables)
+            .addToBsonObj(&keyBuilder, letVar.name);
+    }
+    if (hasLocalFieldForeignFieldJoin()) {
+        keyBuilder.append("$match", _resolvedPipeline[*_fieldMatchPipelineIdx]);
+    }
+    return keyBuilder.obj();
+}
+
 std::unique_ptr<Pipeline, PipelineDeleter> DocumentSourceLookUp::buildPipelineFromViewDefinition(
     std::vector<BSONObj> serializedPipeline,
     ExpressionContext::ResolvedNamespace resolvedNamespace) {
@@ -703,12 +781,25 @@ Pipeline::SourceContainer::iterator DocumentSourceLookUp::doOptimizeAt(
     if (nextUnwind && !_unwindSrc && nextUnwind->getUnwindPath() == _as.fullPath()) {
         _unwindSrc = std::move(nextUnwind);
 
-        // We cannot push absorbed $unwind stages into SBE.
-        _sbeCompatible = false;
+        // An absorbed $unwind of the "as" field does not prevent pushing this stage into SBE:
+        // the SBE stage builder unwinds the matched documents itself.
         container->erase(std::next(itr));
         return itr;
     }
 
+    // A $lookup which unwinds its "as" field and preserves the documents without a match produces
+    // at least one result per input document, in the order of its input. The first N results thus
+    // come from the first N input documents, so we can add a duplicate of a following $limit
+    // before this stage, where a preceding $sort can absorb it and keep only its top N documents.
+    auto nextLimit = dynamic_cast<DocumentSourceLimit*>(std::next(itr)->get());
+    if (nextLimit && _unwindSrc && _unwindSrc->preserveNullAndEmptyArrays() && !_matchSrc &&
+        (!_smallestLimitPushedDown || nextLimit->getLimit() < *_smallestLimitPushedDown)) {
+        _smallestLimitPushedDown = nextLimit->getLimit();
+        auto newStageItr = container->insert(
+            itr, DocumentSourceLimit::create(nextLimit->getContext(), nextLimit->getLimit()));
+        return newStageItr == container->begin() ? newStageItr : std::prev(newStageItr);
+    }
+
     // Attempt to internalize any predicates of a $match upon the "_as" field.
     auto nextMatch = dynamic_cast<DocumentSourceMatch*>((*std::next(itr)).get());
 
@@ -789,10 +880,9 @@ Pipeline::SourceContainer::iterator DocumentSourceLookUp::doOptimizeAt(
         return std::next(itr);
     }
 
-    // We can internalize the $match. This $lookup should already be marked as SBE incompatible
-    // because a $match can only be internalized if an $unwind, which is SBE incompatible, was
-    // absorbed as well.
-    tassert(5843701, "This $lookup cannot be compatible with SBE", !_sbeCompatible);
+    // We can internalize the $match. SBE does not apply a filter to the foreign collection, so
+    // this $lookup can no longer be pushed down.
+    _sbeCompatible = false;
     if (!_matchSrc) {
         _matchSrc = nextMatch;
     } else {
@@ -1021,6 +1111,11 @@ void DocumentSourceLookUp::appendSpecificExecStats(MutableDocument& doc) const {
                    std::back_inserter(indexesUsedVec),
                    [](std::string idx) -> Value { return Value(idx); });
     doc["indexesUsed"] = Value{std::move(indexesUsedVec)};
+    if (_resultMemo) {
+        doc["resultMemo"] = Value(DOC("hits" << _resultMemo->hits() << "misses"
+                                             << _resultMemo->misses() << "peakSizeBytes"
+                                             << _resultMemo->peakSizeBytes()));
+    }
 }
 
 void DocumentSourceLookUp::serializeToArray(
@@ -38,6 +38,7 @@
 #include "mongo/db/pipeline/document_source_unwind.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/lite_parsed_pipeline.h"
+#include "mongo/db/pipeline/lookup_result_memo.h"
 #include "mongo/db/pipeline/lookup_set_cache.h"
 
 namespace mongo {
@@ -186,6 +187,13 @@ public:
         _unwindSrc = unwind;
     }
 
+    /**
+     * Returns the $unwind of the "as" field absorbed by this stage, or nullptr if there isn't one.
+     */
+    const DocumentSourceUnwind* getUnwindSource() const {
+        return _unwindSrc.get();
+    }
+
     bool hasLocalFieldForeignFieldJoin() const {
         return _localField != boost::none;
     }
@@ -348,6 +356,18 @@ private:
         _cache.emplace(maxCacheSizeBytes);
     }
 
+    /**
+     * Returns the memo to use for the results of the sub-pipeline, creating it on first use, or
+     * nullptr if the results may not be memoized.
+     */
+    LookupResultMemo* getResultMemo();
+
+    /**
+     * Builds the key under which the sub-pipeline results for 'inputDoc' are memoized: the values
+     * of the 'let' variables and, for a localField/foreignField join, the generated $match.
+     */
+    BSONObj makeResultMemoKey(const Document& inputDoc);
+
     /**
      * Method to add a DocumentSourceSequentialDocumentCache stage and optimize the pipeline to
      * move the cache to its final position.
@@ -396,6 +416,12 @@ private:
     // from a cursor source.
     boost::optional<SequentialDocumentCache> _cache;
 
+    // Memoizes the complete sub-pipeline results per distinct set of correlated values, across
+    // calls to getNext(). Unlike '_cache', this also serves correlated sub-pipelines. Only used
+    // when a $unwind has not been absorbed, and only if the sub-pipeline is deterministic.
+    boost::optional<bool> _resultMemoAllowed;
+    boost::optional<LookupResultMemo> _resultMemo;
+
     // The ExpressionContext used when performing aggregation pipelines against the '_resolvedNs'
     // namespace.
     boost::intrusive_ptr<ExpressionContext> _fromExpCtx;
@@ -424,6 +450,9 @@ private:
     boost::intrusive_ptr<DocumentSourceMatch> _matchSrc;
     boost::intrusive_ptr<DocumentSourceUnwind> _unwindSrc;
 
+    // The smallest $limit duplicated before this stage, if any. See doOptimizeAt().
+    boost::optional<long long> _smallestLimitPushedDown;
+
     // The following members are used to hold onto state across getNext() calls when '_unwindSrc' is
     // not null.
     long long _cursorIndex = 0;
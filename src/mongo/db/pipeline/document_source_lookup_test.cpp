@@ -1397,6 +1397,84 @@ TEST_F(DocumentSourceLookUpTest,
         secondResult.getDocument());
 }
 
+TEST_F(DocumentSourceLookUpTest, ShouldMemoizeResultsForRepeatedLetVariableValues) {
+    auto expCtx = getExpCtx();
+    NamespaceString fromNs("test", "coll");
+    expCtx->setResolvedNamespaces(StringMap<ExpressionContext::ResolvedNamespace>{
+        {fromNs.coll().toString(), {fromNs, std::vector<BSONObj>()}}});
+
+    deque<DocumentSource::GetNextResult> mockForeignContents{Document{{"x", 0}},
+                                                             Document{{"x", 1}}};
+    expCtx->mongoProcessInterface = std::make_shared<MockMongoInterface>(mockForeignContents);
+
+    auto docSource = DocumentSourceLookUp::createFromBson(
+        fromjson("{$lookup: {let: {var1: '$k'}, pipeline: [{$addFields: {varField: {$sum: ['$x', "
+                 "'$$var1']}}}], from: 'coll', as: 'as'}}")
+            .firstElement(),
+        expCtx);
+
+    auto lookupStage = static_cast<DocumentSourceLookUp*>(docSource.get());
+    ASSERT(lookupStage);
+
+    auto mockLocalSource = DocumentSourceMock::createForTest({Document{{"_id", 0}, {"k", 1}},
+                                                              Document{{"_id", 1}, {"k", 2}},
+                                                              Document{{"_id", 2}, {"k", 1}}},
+                                                             expCtx);
+    lookupStage->setSource(mockLocalSource.get());
+
+    ASSERT_DOCUMENT_EQ(
+        Document{fromjson("{_id: 0, k: 1, as: [{x: 0, varField: 1}, {x: 1, varField: 2}]}")},
+        lookupStage->getNext().getDocument());
+    ASSERT_DOCUMENT_EQ(
+        Document{fromjson("{_id: 1, k: 2, as: [{x: 0, varField: 2}, {x: 1, varField: 3}]}")},
+        lookupStage->getNext().getDocument());
+    ASSERT_DOCUMENT_EQ(
+        Document{fromjson("{_id: 2, k: 1, as: [{x: 0, varField: 1}, {x: 1, varField: 2}]}")},
+        lookupStage->getNext().getDocument());
+    ASSERT_TRUE(lookupStage->getNext().isEOF());
+
+    // The third local document shares its 'let' value with the first, so it is served from the
+    // memo.
+    std::vector<Value> serialization;
+    lookupStage->serializeToArray(serialization, ExplainOptions::Verbosity::kExecStats);
+    ASSERT_EQ(serialization.size(), 1UL);
+    auto resultMemo = serialization[0].getDocument()["$lookup"]["resultMemo"];
+    ASSERT_VALUE_EQ(resultMemo["hits"], Value(1LL));
+    ASSERT_VALUE_EQ(resultMemo["misses"], Value(2LL));
+}
+
+TEST_F(DocumentSourceLookUpTest, ShouldNotMemoizeResultsOfNonDeterministicSubPipeline) {
+    auto expCtx = getExpCtx();
+    NamespaceString fromNs("test", "coll");
+    expCtx->setResolvedNamespaces(StringMap<ExpressionContext::ResolvedNamespace>{
+        {fromNs.coll().toString(), {fromNs, std::vector<BSONObj>()}}});
+
+    deque<DocumentSource::GetNextResult> mockForeignContents{Document{{"x", 0}}};
+    expCtx->mongoProcessInterface = std::make_shared<MockMongoInterface>(mockForeignContents);
+
+    auto docSource = DocumentSourceLookUp::createFromBson(
+        fromjson("{$lookup: {let: {var1: '$k'}, pipeline: [{$addFields: {r: {$rand: {}}, v: "
+                 "'$$var1'}}], from: 'coll', as: 'as'}}")
+            .firstElement(),
+        expCtx);
+
+    auto lookupStage = static_cast<DocumentSourceLookUp*>(docSource.get());
+    ASSERT(lookupStage);
+
+    auto mockLocalSource = DocumentSourceMock::createForTest(
+        {Document{{"_id", 0}, {"k", 1}}, Document{{"_id", 1}, {"k", 1}}}, expCtx);
+    lookupStage->setSource(mockLocalSource.get());
+
+    ASSERT_TRUE(lookupStage->getNext().isAdvanced());
+    ASSERT_TRUE(lookupStage->getNext().isAdvanced());
+    ASSERT_TRUE(lookupStage->getNext().isEOF());
+
+    std::vector<Value> serialization;
+    lookupStage->serializeToArray(serialization, ExplainOptions::Verbosity::kExecStats);
+    ASSERT_EQ(serialization.size(), 1UL);
+    ASSERT_TRUE(serialization[0].getDocument()["$lookup"]["resultMemo"].missing());
+}
+
 TEST_F(DocumentSourceLookUpTest, ShouldNotCacheIfCorrelatedStageIsAbsorbedIntoPlanExecutor) {
     auto expCtx = getExpCtx();
     NamespaceString fromNs("test", "coll");
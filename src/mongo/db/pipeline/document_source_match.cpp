@@ -115,6 +115,38 @@ DocumentSource::GetNextResult DocumentSourceMatch::doGetNext() {
     return nextInput;
 }
 
+DocumentSource::GetNextResult::ReturnStatus DocumentSourceMatch::doGetNextBatch(
+    std::vector<Document>* batch, size_t maxBatchSize) {
+    massert(
+        7027101, "Should never call getNext on a $match stage with $text clause", !_isTextQuery);
+
+    const auto batchStart = batch->size();
+    auto status = GetNextResult::ReturnStatus::kAdvanced;
+    // Keep filtering batches of the source until one survives, so that a kAdvanced status always
+    // comes with at least one result.
+    while (batch->size() == batchStart && status == GetNextResult::ReturnStatus::kAdvanced) {
+        status = pSource->getNextBatch(batch, maxBatchSize);
+
+        // Compact the matching documents to the front of the new part of the batch, moving rather
+        // than copying them so that no document is shared.
+        auto out = batch->begin() + batchStart;
+        for (auto in = out; in != batch->end(); ++in) {
+            BSONObj toMatch = _dependencies.needWholeDocument
+                ? in->toBson<BSONObj::LargeSizeTrait>()
+                : document_path_support::documentToBsonWithPaths<BSONObj::LargeSizeTrait>(
+                      *in, _dependencies.fields);
+            if (_expression->matchesBSON(toMatch)) {
+                if (out != in) {
+                    *out = std::move(*in);
+                }
+                ++out;
+            }
+        }
+        batch->erase(out, batch->end());
+    }
+    return status;
+}
+
 Pipeline::SourceContainer::iterator DocumentSourceMatch::doOptimizeAt(
     Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container) {
     invariant(*itr == this);
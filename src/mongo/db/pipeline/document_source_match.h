@@ -213,6 +213,8 @@ protected:
               newExpCtx ? newExpCtx : other.pExpCtx) {}
 
     GetNextResult doGetNext() override;
+    GetNextResult::ReturnStatus doGetNextBatch(std::vector<Document>* batch,
+                                               size_t maxBatchSize) override;
     DocumentSourceMatch(const BSONObj& query,
                         const boost::intrusive_ptr<ExpressionContext>& expCtx);
 
@@ -533,6 +533,38 @@ TEST_F(DocumentSourceMatchTest, ShouldPropagatePauses) {
     ASSERT_TRUE(match->getNext().isEOF());
 }
 
+TEST_F(DocumentSourceMatchTest, GetNextBatchShouldFilterBatchesAndPropagatePauses) {
+    auto match = DocumentSourceMatch::create(BSON("a" << 1), getExpCtx());
+    auto mock =
+        DocumentSourceMock::createForTest({Document{{"a", 1}, {"b", 1}},
+                                           Document{{"a", 2}},
+                                           Document{{"a", 1}, {"b", 2}},
+                                           DocumentSource::GetNextResult::makePauseExecution(),
+                                           Document{{"a", 2}},
+                                           Document{{"a", 2}},
+                                           Document{{"a", 1}, {"b", 3}}},
+                                          getExpCtx());
+    match->setSource(mock.get());
+
+    using ReturnStatus = DocumentSource::GetNextResult::ReturnStatus;
+    std::vector<Document> batch;
+    ASSERT(match->getNextBatch(&batch, 10) == ReturnStatus::kPauseExecution);
+    ASSERT_EQ(batch.size(), 2U);
+    ASSERT_DOCUMENT_EQ(batch[0], (Document{{"a", 1}, {"b", 1}}));
+    ASSERT_DOCUMENT_EQ(batch[1], (Document{{"a", 1}, {"b", 2}}));
+
+    // The batches of non-matching documents are skipped until a document matches.
+    batch.clear();
+    ASSERT(match->getNextBatch(&batch, 1) == ReturnStatus::kAdvanced);
+    ASSERT_EQ(batch.size(), 1U);
+    ASSERT_DOCUMENT_EQ(batch[0], (Document{{"a", 1}, {"b", 3}}));
+
+    batch.clear();
+    ASSERT(match->getNextBatch(&batch, 10) == ReturnStatus::kEOF);
+    ASSERT(batch.empty());
+    ASSERT_TRUE(match->getNext().isEOF());
+}
+
 TEST_F(DocumentSourceMatchTest, ShouldCorrectlyJoinWithSubsequentMatch) {
     const auto match = DocumentSourceMatch::create(BSON("a" << 1), getExpCtx());
     const auto secondMatch = DocumentSourceMatch::create(BSON("b" << 1), getExpCtx());
@@ -84,6 +84,13 @@ constexpr auto kPipelineDiscardMode = MergeMode{WhenMatched::kPipeline, WhenNotM
 const auto kDefaultPipelineLet = BSON("new"
                                       << "$$ROOT");
 
+// Fields of the checkpoint documents in 'config.aggregateCheckpoints'.
+constexpr auto kCheckpointSourceNsField = "ns"_sd;
+constexpr auto kCheckpointPipelineHashField = "pipelineHash"_sd;
+constexpr auto kCheckpointResumeAfterField = "resumeAfter"_sd;
+constexpr auto kCheckpointCompletedField = "completed"_sd;
+constexpr auto kCheckpointLastModifiedField = "lastModified"_sd;
+
 BatchedCommandGenerator makeInsertCommandGenerator() {
     return [](const auto& expCtx, const auto& ns) -> BatchedCommandRequest {
         return DocumentSourceMerge::DocumentSourceWriter::makeInsertCommand(
@@ -438,11 +445,13 @@ std::unique_ptr<DocumentSourceMerge::LiteParsed> DocumentSourceMerge::LiteParsed
         invariant(pipeline);
         liteParsedPipeline = LiteParsedPipeline(nss, *pipeline);
     }
-    return std::make_unique<DocumentSourceMerge::LiteParsed>(spec.fieldName(),
-                                                             std::move(targetNss),
-                                                             whenMatched,
-                                                             whenNotMatched,
-                                                             std::move(liteParsedPipeline));
+    return std::make_unique<DocumentSourceMerge::LiteParsed>(
+        spec.fieldName(),
+        std::move(targetNss),
+        whenMatched,
+        whenNotMatched,
+        std::move(liteParsedPipeline),
+        static_cast<bool>(mergeSpec.getCheckpointId()));
 }
 
 PrivilegeVector DocumentSourceMerge::LiteParsed::requiredPrivileges(
@@ -453,7 +462,14 @@ PrivilegeVector DocumentSourceMerge::LiteParsed::requiredPrivileges(
         actions.addAction(ActionType::bypassDocumentValidation);
     }
 
-    return {{ResourcePattern::forExactNamespace(*_foreignNss), actions}};
+    PrivilegeVector privileges{{ResourcePattern::forExactNamespace(*_foreignNss), actions}};
+    if (_recordsCheckpoints) {
+        privileges.push_back(
+            {ResourcePattern::forExactNamespace(
+                 NamespaceString::kConfigAggregateCheckpointsNamespace),
+             ActionSet{ActionType::find, ActionType::insert, ActionType::update}});
+    }
+    return privileges;
 }
 
 DocumentSourceMerge::DocumentSourceMerge(NamespaceString outputNs,
@@ -462,13 +478,15 @@ DocumentSourceMerge::DocumentSourceMerge(NamespaceString outputNs,
                                          boost::optional<BSONObj> letVariables,
                                          boost::optional<std::vector<BSONObj>> pipeline,
                                          std::set<FieldPath> mergeOnFields,
-                                         boost::optional<ChunkVersion> targetCollectionVersion)
+                                         boost::optional<ChunkVersion> targetCollectionVersion,
+                                         boost::optional<std::string> checkpointId)
     : DocumentSourceWriter(kStageName.rawData(), std::move(outputNs), expCtx),
       _targetCollectionVersion(targetCollectionVersion),
       _descriptor(descriptor),
       _pipeline(std::move(pipeline)),
       _mergeOnFields(std::move(mergeOnFields)),
-      _mergeOnFieldsIncludesId(_mergeOnFields.count("_id") == 1) {
+      _mergeOnFieldsIncludesId(_mergeOnFields.count("_id") == 1),
+      _checkpointId(std::move(checkpointId)) {
     if (letVariables) {
         _letVariables.emplace();
 
@@ -491,7 +509,8 @@ boost::intrusive_ptr<DocumentSource> DocumentSourceMerge::create(
     boost::optional<BSONObj> letVariables,
     boost::optional<std::vector<BSONObj>> pipeline,
     std::set<FieldPath> mergeOnFields,
-    boost::optional<ChunkVersion> targetCollectionVersion) {
+    boost::optional<ChunkVersion> targetCollectionVersion,
+    boost::optional<std::string> checkpointId) {
     uassert(51189,
             "Combination of {} modes 'whenMatched: {}' and 'whenNotMatched: {}' "
             "is not supported"_format(kStageName,
@@ -535,13 +554,30 @@ boost::intrusive_ptr<DocumentSource> DocumentSourceMerge::create(
                 !letVariables);
     }
 
+    if (checkpointId) {
+        // After an interruption, the documents written since the last checkpoint are written
+        // again, so the merge must give the same result when a document is merged twice.
+        uassert(7027000,
+                "{} with a 'checkpointId' requires 'whenMatched' to be 'replace', 'merge' or "
+                "'keepExisting'"_format(kStageName),
+                whenMatched == WhenMatched::kReplace || whenMatched == WhenMatched::kMerge ||
+                    whenMatched == WhenMatched::kKeepExisting);
+        uassert(7027001,
+                "{} with a 'checkpointId' is not supported in a sharded cluster"_format(kStageName),
+                !expCtx->inMongos && !expCtx->fromMongos && !expCtx->needsMerge);
+        uassert(7027002,
+                "{} 'checkpointId' must not be empty"_format(kStageName),
+                !checkpointId->empty());
+    }
+
     return new DocumentSourceMerge(outputNs,
                                    expCtx,
                                    getDescriptors().at({whenMatched, whenNotMatched}),
                                    std::move(letVariables),
                                    std::move(pipeline),
                                    std::move(mergeOnFields),
-                                   targetCollectionVersion);
+                                   targetCollectionVersion,
+                                   std::move(checkpointId));
 }
 
 boost::intrusive_ptr<DocumentSource> DocumentSourceMerge::createFromBson(
@@ -568,7 +604,9 @@ boost::intrusive_ptr<DocumentSource> DocumentSourceMerge::createFromBson(
                                        mergeSpec.getLet(),
                                        std::move(pipeline),
                                        std::move(mergeOnFields),
-                                       targetCollectionVersion);
+                                       targetCollectionVersion,
+                                       mergeSpec.getCheckpointId().map(
+                                           [](StringData id) { return id.toString(); }));
 }
 
 StageConstraints DocumentSourceMerge::constraints(Pipeline::SplitState pipeState) const {
@@ -629,6 +667,7 @@ Value DocumentSourceMerge::serialize(boost::optional<ExplainOptions::Verbosity>
         return mergeOnFields;
     }());
     spec.setTargetCollectionVersion(_targetCollectionVersion);
+    spec.setCheckpointId(_checkpointId.map([](const std::string& id) { return StringData(id); }));
     return Value(Document{{getSourceName(), spec.toBSON()}});
 }
 
@@ -636,6 +675,11 @@ std::pair<DocumentSourceMerge::BatchObject, int> DocumentSourceMerge::makeBatchO
     Document&& doc) const {
     // Generate an _id if the uniqueKey includes _id but the document doesn't have one.
     if (_mergeOnFieldsIncludesId && doc.getField("_id"_sd).missing()) {
+        // A generated _id would differ when the document is written again after resuming.
+        uassert(7027003,
+                "{} with a 'checkpointId' requires each document to have an _id"_format(
+                    kStageName),
+                !_checkpointId);
         MutableDocument mutableDoc(std::move(doc));
         mutableDoc["_id"_sd] = Value(OID::gen());
         doc = mutableDoc.freeze();
@@ -690,6 +734,82 @@ void DocumentSourceMerge::spill(BatchedCommandRequest&& bcr, BatchedObjects&& ba
     }
 }
 
+BSONObj DocumentSourceMerge::getCheckpointedResumeToken(std::string pipelineHash) {
+    invariant(_checkpointId);
+    _pipelineHash = std::move(pipelineHash);
+    auto checkpoint = pExpCtx->mongoProcessInterface->lookupSingleDocumentLocally(
+        pExpCtx,
+        NamespaceString::kConfigAggregateCheckpointsNamespace,
+        Document{{"_id"_sd, *_checkpointId}});
+
+    // A checkpoint left by a completed run is ignored.
+    if (!checkpoint || (*checkpoint)[kCheckpointCompletedField].coerceToBool()) {
+        return BSONObj();
+    }
+
+    // Resuming another aggregation from this position would skip documents it has never written.
+    auto pipelineHash = (*checkpoint)[kCheckpointPipelineHashField];
+    uassert(7027505,
+            "{} cannot resume from the unfinished checkpoint '{}' of a different aggregation; "
+            "remove it from {} to start over"_format(
+                kStageName,
+                *_checkpointId,
+                NamespaceString::kConfigAggregateCheckpointsNamespace.ns()),
+            (*checkpoint)[kCheckpointSourceNsField].getStringData() == pExpCtx->ns.ns() &&
+                pipelineHash.getType() == BSONType::String &&
+                pipelineHash.getStringData() == _pipelineHash);
+
+    auto resumeAfter = (*checkpoint)[kCheckpointResumeAfterField];
+    return resumeAfter.getType() == BSONType::Object ? resumeAfter.getDocument().toBson()
+                                                     : BSONObj();
+}
+
+void DocumentSourceMerge::onBatchWritten(const boost::optional<RecordId>& lastRecordId) {
+    if (!_checkpointId || !lastRecordId) {
+        return;
+    }
+
+    BSONObjBuilder resumeAfter;
+    lastRecordId->serializeToken("$recordId", &resumeAfter);
+    writeCheckpoint(BSON(kCheckpointResumeAfterField << resumeAfter.obj()
+                                                     << kCheckpointCompletedField << false));
+}
+
+void DocumentSourceMerge::finalize() {
+    if (_checkpointId) {
+        writeCheckpoint(BSON(kCheckpointCompletedField << true));
+    }
+}
+
+void DocumentSourceMerge::writeCheckpoint(BSONObj fields) {
+    BSONObjBuilder checkpoint;
+    checkpoint.append("_id", *_checkpointId);
+    checkpoint.append(kCheckpointSourceNsField, pExpCtx->ns.ns());
+    checkpoint.append(kCheckpointPipelineHashField, _pipelineHash);
+    checkpoint.appendElements(fields);
+    checkpoint.append(kCheckpointLastModifiedField, Date_t::now());
+
+    write_ops::UpdateOpEntry entry;
+    entry.setQ(BSON("_id" << *_checkpointId));
+    entry.setU(UpdateModification(
+        checkpoint.obj(), UpdateModification::ClassicTag{}, true /* isReplacement */));
+    entry.setUpsert(true);
+    write_ops::UpdateCommandRequest updateOp(NamespaceString::kConfigAggregateCheckpointsNamespace,
+                                             {std::move(entry)});
+
+    DocumentSourceWriteBlock writeBlock(pExpCtx->opCtx);
+    uassertStatusOKWithContext(
+        pExpCtx->mongoProcessInterface->update(
+            pExpCtx,
+            NamespaceString::kConfigAggregateCheckpointsNamespace,
+            std::make_unique<write_ops::UpdateCommandRequest>(std::move(updateOp)),
+            _writeConcern,
+            UpsertType::kGenerateNewDoc,
+            false /* multi */,
+            boost::none),
+        "{} failed to record a checkpoint"_format(kStageName));
+}
+
 BatchedCommandRequest DocumentSourceMerge::initializeBatchedWriteRequest() const {
     return _descriptor.batchedCommandGenerator(pExpCtx, _outputNs);
 }
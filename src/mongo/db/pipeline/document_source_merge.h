@@ -89,11 +89,13 @@ public:
                    NamespaceString foreignNss,
                    MergeWhenMatchedModeEnum whenMatched,
                    MergeWhenNotMatchedModeEnum whenNotMatched,
-                   boost::optional<LiteParsedPipeline> onMatchedPipeline)
+                   boost::optional<LiteParsedPipeline> onMatchedPipeline,
+                   bool recordsCheckpoints)
             : LiteParsedDocumentSourceNestedPipelines(
                   std::move(parseTimeName), std::move(foreignNss), std::move(onMatchedPipeline)),
               _whenMatched(whenMatched),
-              _whenNotMatched(whenNotMatched) {}
+              _whenNotMatched(whenNotMatched),
+              _recordsCheckpoints(recordsCheckpoints) {}
 
         static std::unique_ptr<LiteParsed> parse(const NamespaceString& nss,
                                                  const BSONElement& spec);
@@ -123,6 +125,7 @@ public:
     private:
         MergeWhenMatchedModeEnum _whenMatched;
         MergeWhenNotMatchedModeEnum _whenNotMatched;
+        bool _recordsCheckpoints;
     };
 
     virtual ~DocumentSourceMerge() = default;
@@ -148,7 +151,8 @@ public:
         boost::optional<BSONObj> letVariables,
         boost::optional<std::vector<BSONObj>> pipeline,
         std::set<FieldPath> mergeOnFields,
-        boost::optional<ChunkVersion> targetCollectionVersion);
+        boost::optional<ChunkVersion> targetCollectionVersion,
+        boost::optional<std::string> checkpointId = boost::none);
 
     /**
      * Parses a $merge stage from the user-supplied BSON.
@@ -160,6 +164,25 @@ public:
         return _pipeline;
     }
 
+    /**
+     * The name under which this stage records the progress of the aggregation, if any. Progress is
+     * the RecordId of the last source document written to the target collection, so the query
+     * layer must scan the source collection in RecordId order and attach RecordIds to the
+     * documents it returns.
+     */
+    const boost::optional<std::string>& getCheckpointId() const {
+        return _checkpointId;
+    }
+
+    /**
+     * Returns the '$_resumeAfter' token from which an aggregation interrupted before completion
+     * continues its collection scan, or an empty object if the scan starts from the beginning.
+     * 'pipelineHash' identifies the aggregation. It is recorded with each checkpoint, and an
+     * unfinished checkpoint of an aggregation with another hash or source collection is rejected.
+     * Must only be called if this stage records checkpoints.
+     */
+    BSONObj getCheckpointedResumeToken(std::string pipelineHash);
+
     void initialize() override {
         // This implies that the stage will soon start to write, so it's safe to verify the target
         // collection version. This is done here instead of parse time since it requires that locks
@@ -185,7 +208,8 @@ private:
                         boost::optional<BSONObj> letVariables,
                         boost::optional<std::vector<BSONObj>> pipeline,
                         std::set<FieldPath> mergeOnFields,
-                        boost::optional<ChunkVersion> targetCollectionVersion);
+                        boost::optional<ChunkVersion> targetCollectionVersion,
+                        boost::optional<std::string> checkpointId);
 
     /**
      * Creates an UpdateModification object from the given 'doc' to be used with the batched update.
@@ -220,6 +244,15 @@ private:
 
     void spill(BatchedCommandRequest&& bcr, BatchedObjects&& batch) override;
 
+    void onBatchWritten(const boost::optional<RecordId>& lastRecordId) override;
+
+    void finalize() override;
+
+    /**
+     * Replaces the checkpoint document of this stage with one carrying 'fields'.
+     */
+    void writeCheckpoint(BSONObj fields);
+
     BatchedCommandRequest initializeBatchedWriteRequest() const override;
 
     void waitWhileFailPointEnabled() override;
@@ -252,6 +285,13 @@ private:
     // True if '_mergeOnFields' contains the _id. We store this as a separate boolean to avoid
     // repeated lookups into the set.
     bool _mergeOnFieldsIncludesId;
+
+    // If set, the _id of the document in 'config.aggregateCheckpoints' recording the progress of
+    // this stage.
+    boost::optional<std::string> _checkpointId;
+
+    // Identifies the aggregation which records checkpoints under '_checkpointId'.
+    std::string _pipelineHash;
 };
 
 }  // namespace mongo
@@ -77,6 +77,19 @@ public:
                                       ChunkVersion) const override {
         return;  // Assume it always matches for our tests here.
     }
+
+    /**
+     * Returns 'checkpoint' for any lookup, standing in for the checkpoint document recorded in
+     * 'config.aggregateCheckpoints'.
+     */
+    boost::optional<Document> lookupSingleDocumentLocally(
+        const boost::intrusive_ptr<ExpressionContext>& expCtx,
+        const NamespaceString& nss,
+        const Document& documentKey) override {
+        return checkpoint;
+    }
+
+    boost::optional<Document> checkpoint;
 };
 
 class DocumentSourceMergeTest : public AggregationContextFixture {
@@ -950,5 +963,94 @@ TEST_F(DocumentSourceMergeTest, FailsToParseIfOnFieldHaveDuplicates) {
     ASSERT_THROWS_CODE(createMergeStage(spec), AssertionException, 31465);
 }
 
+TEST_F(DocumentSourceMergeTest, SerializeCheckpointId) {
+    auto spec = BSON("$merge" << BSON("into"
+                                      << "target_collection"
+                                      << "checkpointId"
+                                      << "nightlyRollup"));
+    auto mergeStage = createMergeStage(spec);
+    ASSERT(mergeStage->getCheckpointId());
+    ASSERT_EQ(*mergeStage->getCheckpointId(), "nightlyRollup");
+
+    auto serialized = mergeStage->serialize().getDocument();
+    ASSERT_EQ(serialized["$merge"]["checkpointId"].getStringData(), "nightlyRollup"_sd);
+
+    // Make sure we can reparse the serialized BSON.
+    auto reparsedMergeStage = createMergeStage(serialized.toBson());
+    ASSERT_VALUE_EQ(reparsedMergeStage->serialize().getDocument()["$merge"]["checkpointId"],
+                    serialized["$merge"]["checkpointId"]);
+}
+
+TEST_F(DocumentSourceMergeTest, FailsToParseCheckpointIdWithNonIdempotentWhenMatchedMode) {
+    auto spec = BSON("$merge" << BSON("into"
+                                      << "target_collection"
+                                      << "whenMatched"
+                                      << "fail"
+                                      << "checkpointId"
+                                      << "nightlyRollup"));
+    ASSERT_THROWS_CODE(createMergeStage(spec), AssertionException, 7027000);
+
+    spec = BSON("$merge" << BSON("into"
+                                 << "target_collection"
+                                 << "whenMatched"
+                                 << BSON_ARRAY(BSON("$inc" << BSON("count" << 1)))
+                                 << "checkpointId"
+                                 << "nightlyRollup"));
+    ASSERT_THROWS_CODE(createMergeStage(spec), AssertionException, 7027000);
+}
+
+TEST_F(DocumentSourceMergeTest, ResumesFromUnfinishedCheckpointOfSameAggregation) {
+    auto processInterface = std::make_shared<MongoProcessInterfaceForTest>();
+    getExpCtx()->mongoProcessInterface = processInterface;
+    auto mergeStage = createMergeStage(BSON("$merge" << BSON("into"
+                                                             << "target_collection"
+                                                             << "checkpointId"
+                                                             << "nightlyRollup")));
+
+    // Without a checkpoint, or after a completed run, the scan starts from the beginning.
+    ASSERT_BSONOBJ_EQ(mergeStage->getCheckpointedResumeToken("hash"), BSONObj());
+
+    auto checkpoint = BSON("_id"
+                           << "nightlyRollup"
+                           << "ns" << getExpCtx()->ns.ns() << "pipelineHash"
+                           << "hash"
+                           << "resumeAfter" << BSON("$recordId" << 5LL) << "completed" << true);
+    processInterface->checkpoint = Document(checkpoint);
+    ASSERT_BSONOBJ_EQ(mergeStage->getCheckpointedResumeToken("otherHash"), BSONObj());
+
+    processInterface->checkpoint = Document(checkpoint.addFields(BSON("completed" << false)));
+    ASSERT_BSONOBJ_EQ(mergeStage->getCheckpointedResumeToken("hash"), BSON("$recordId" << 5LL));
+}
+
+TEST_F(DocumentSourceMergeTest, RejectsUnfinishedCheckpointOfAnotherAggregation) {
+    auto processInterface = std::make_shared<MongoProcessInterfaceForTest>();
+    getExpCtx()->mongoProcessInterface = processInterface;
+    auto mergeStage = createMergeStage(BSON("$merge" << BSON("into"
+                                                             << "target_collection"
+                                                             << "checkpointId"
+                                                             << "nightlyRollup")));
+
+    auto checkpoint = BSON("_id"
+                           << "nightlyRollup"
+                           << "ns" << getExpCtx()->ns.ns() << "pipelineHash"
+                           << "hash"
+                           << "resumeAfter" << BSON("$recordId" << 5LL) << "completed" << false);
+    processInterface->checkpoint = Document(checkpoint);
+    ASSERT_THROWS_CODE(
+        mergeStage->getCheckpointedResumeToken("otherHash"), AssertionException, 7027505);
+
+    processInterface->checkpoint = Document(checkpoint.addFields(BSON("ns"
+                                                                      << "otherdb.othercoll")));
+    ASSERT_THROWS_CODE(mergeStage->getCheckpointedResumeToken("hash"), AssertionException, 7027505);
+}
+
+TEST_F(DocumentSourceMergeTest, FailsToParseIfCheckpointIdIsEmpty) {
+    auto spec = BSON("$merge" << BSON("into"
+                                      << "target_collection"
+                                      << "checkpointId"
+                                      << ""));
+    ASSERT_THROWS_CODE(createMergeStage(spec), AssertionException, 7027002);
+}
+
 }  // namespace
 }  // namespace mongo
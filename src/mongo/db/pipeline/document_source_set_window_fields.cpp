@@ -288,6 +288,36 @@ intrusive_ptr<DocumentSource> DocumentSourceInternalSetWindowFields::optimize()
     return this;
 }
 
+bool DocumentSourceInternalSetWindowFields::canRunInParallelBeforeWriteStage(
+    const OrderedPathSet& nameOfShardKeyFieldsUponEntryToStage) const {
+    if (!_partitionBy || !*_partitionBy) {
+        return false;
+    }
+
+    // As for $group, this requires the partition key to reference each shard key path exactly,
+    // either as the whole 'partitionBy' or as one of the fields of an object 'partitionBy'.
+    auto representsPath = [](const boost::intrusive_ptr<Expression>& expr,
+                             const std::string& dottedPath) {
+        auto fieldExp = dynamic_cast<ExpressionFieldPath*>(expr.get());
+        return fieldExp && fieldExp->representsPath(dottedPath);
+    };
+    auto objectExp = dynamic_cast<ExpressionObject*>(_partitionBy->get());
+    for (auto&& currentPathOfShardKey : nameOfShardKeyFieldsUponEntryToStage) {
+        if (representsPath(*_partitionBy, currentPathOfShardKey)) {
+            continue;
+        }
+        if (!objectExp ||
+            std::none_of(objectExp->getChildExpressions().begin(),
+                         objectExp->getChildExpressions().end(),
+                         [&](const auto& child) {
+                             return representsPath(child.second, currentPathOfShardKey);
+                         })) {
+            return false;
+        }
+    }
+    return true;
+}
+
 Value DocumentSourceInternalSetWindowFields::serialize(
     boost::optional<ExplainOptions::Verbosity> explain) const {
     MutableDocument spec;
@@ -165,6 +165,13 @@ public:
         return DistributedPlanLogic{nullptr, this, boost::none};
     }
 
+    /**
+     * Returns true if 'partitionBy' includes every shard key path, so that each partition is
+     * computed entirely by one consumer of an $exchange.
+     */
+    bool canRunInParallelBeforeWriteStage(
+        const OrderedPathSet& nameOfShardKeyFieldsUponEntryToStage) const final;
+
     boost::intrusive_ptr<DocumentSource> optimize() final;
 
     Value serialize(boost::optional<ExplainOptions::Verbosity> explain) const;
@@ -212,5 +212,30 @@ TEST_F(DocumentSourceSetWindowFieldsTest, ReportsModifiedFields) {
     ASSERT_EQUALS(modified.paths.count("b"), 1U);
     ASSERT_TRUE(modified.renames.empty());
 }
+
+TEST_F(DocumentSourceSetWindowFieldsTest, CanRunInParallelOnlyWhenPartitionedByShardKey) {
+    auto canRunInParallel = [&](const char* json, const OrderedPathSet& shardKeyPaths) {
+        auto spec = fromjson(json);
+        auto parsedStage =
+            DocumentSourceInternalSetWindowFields::createFromBson(spec.firstElement(), getExpCtx());
+        return parsedStage->canRunInParallelBeforeWriteStage(shardKeyPaths);
+    };
+
+    ASSERT_TRUE(canRunInParallel(
+        R"({$_internalSetWindowFields: {partitionBy: '$a', output: {s: {$sum: 1}}}})", {"a"}));
+    ASSERT_TRUE(canRunInParallel(
+        R"({$_internalSetWindowFields: {partitionBy: {x: '$a', y: '$b.c'},
+            output: {s: {$sum: 1}}}})",
+        {"a", "b.c"}));
+    ASSERT_FALSE(canRunInParallel(
+        R"({$_internalSetWindowFields: {partitionBy: '$a', output: {s: {$sum: 1}}}})",
+        {"a", "b"}));
+    ASSERT_FALSE(canRunInParallel(
+        R"({$_internalSetWindowFields: {partitionBy: {$toUpper: '$a'},
+            output: {s: {$sum: 1}}}})",
+        {"a"}));
+    ASSERT_FALSE(
+        canRunInParallel(R"({$_internalSetWindowFields: {output: {s: {$sum: 1}}}})", {"a"}));
+}
 }  // namespace
 }  // namespace mongo
@@ -73,6 +73,21 @@ DocumentSource::GetNextResult DocumentSourceSingleDocumentTransformation::doGetN
     return _parsedTransform->applyTransformation(input.releaseDocument());
 }
 
+DocumentSource::GetNextResult::ReturnStatus
+DocumentSourceSingleDocumentTransformation::doGetNextBatch(std::vector<Document>* batch,
+                                                           size_t maxBatchSize) {
+    if (!_parsedTransform) {
+        return GetNextResult::ReturnStatus::kEOF;
+    }
+
+    const auto batchStart = batch->size();
+    auto status = pSource->getNextBatch(batch, maxBatchSize);
+    for (auto it = batch->begin() + batchStart; it != batch->end(); ++it) {
+        *it = _parsedTransform->applyTransformation(std::move(*it));
+    }
+    return status;
+}
+
 intrusive_ptr<DocumentSource> DocumentSourceSingleDocumentTransformation::optimize() {
     if (_parsedTransform) {
         _parsedTransform->optimize();
@@ -275,7 +275,7 @@ DocumentSource::GetNextResult DocumentSourceSort::doGetNext() {
         return GetNextResult::makeEOF();
     }
 
-    return GetNextResult{_sortExecutor->getNext().second};
+    return GetNextResult{_sortExecutor->getNextData()};
 }
 
 boost::intrusive_ptr<DocumentSource> DocumentSourceSort::clone(
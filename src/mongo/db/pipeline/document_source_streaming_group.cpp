@@ -242,19 +242,25 @@ template <typename IdValueGetter>
 bool DocumentSourceStreamingGroup::checkForBatchEndAndUpdateLastIdValues(
     const IdValueGetter& idValueGetter) {
     auto assertStreamable = [&](Value value) {
-        // Nullish and array values will mess us up because they sort differently than they group.
-        // A null and a missing value will compare equal in sorting, but could result in different
-        // groups, e.g. {_id: {x: null, y: null}} vs {_id: {}}. An array value will sort by the min
-        // or max element, with no tie breaking, but group by the whole array. This means that two
-        // of the exact same array could appear in the input sequence, but with a different array in
-        // the middle of them, and that would still be considered sorted. That would break our
-        // batching group logic.
-        uassert(7026708,
-                "Monotonic value should not be missing, null or an array",
-                !value.nullish() && !value.isArray());
+        // An array value will mess us up because it sorts differently than it groups. It will sort
+        // by the min or max element, with no tie breaking, but group by the whole array. This means
+        // that two of the exact same array could appear in the input sequence, but with a different
+        // array in the middle of them, and that would still be considered sorted. That would break
+        // our batching group logic.
+        uassert(7026708, "Monotonic value should not be an array", !value.isArray());
         return value;
     };
 
+    // Nullish values are a problem of a different kind: a null and a missing value compare equal in
+    // sorting, but could result in different groups, e.g. {_id: {x: null, y: null}} vs {_id: {}}.
+    // So all nullish values belong to the same batch, and the groups map tells them apart.
+    auto sameBatch = [&](const Value& lhs, const Value& rhs) {
+        if (lhs.nullish() || rhs.nullish()) {
+            return lhs.nullish() && rhs.nullish();
+        }
+        return pExpCtx->getValueComparator().compare(lhs, rhs) == 0;
+    };
+
     // If _lastMonotonicIdFieldValues is empty, it is the first document, so the only thing we need
     // to do is initialize it.
     if (_lastMonotonicIdFieldValues.empty()) {
@@ -267,7 +273,7 @@ bool DocumentSourceStreamingGroup::checkForBatchEndAndUpdateLastIdValues(
         for (size_t index = 0; index < _monotonicExpressionIndexes.size(); ++index) {
             Value& oldId = _lastMonotonicIdFieldValues[index];
             const Value& id = assertStreamable(idValueGetter(_monotonicExpressionIndexes[index]));
-            if (pExpCtx->getValueComparator().compare(oldId, id) != 0) {
+            if (!sameBatch(oldId, id)) {
                 oldId = id;
                 batchFinished = true;
             }
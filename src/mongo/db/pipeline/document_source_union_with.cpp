@@ -31,15 +31,20 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
 #include <iterator>
 
 #include "mongo/db/commands/test_commands_enabled.h"
 #include "mongo/db/pipeline/document_source_documents.h"
+#include "mongo/db/pipeline/document_source_limit.h"
 #include "mongo/db/pipeline/document_source_match.h"
 #include "mongo/db/pipeline/document_source_queue.h"
 #include "mongo/db/pipeline/document_source_single_document_transformation.h"
+#include "mongo/db/pipeline/document_source_sort.h"
 #include "mongo/db/pipeline/document_source_union_with.h"
 #include "mongo/db/pipeline/document_source_union_with_gen.h"
+#include "mongo/db/pipeline/skip_and_limit.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/views/resolved_view.h"
 #include "mongo/logv2/log.h"
 
@@ -209,9 +214,13 @@ DocumentSource::GetNextResult DocumentSourceUnionWith::doGetNext() {
     }
 
     if (_executionState == ExecutionProgress::kIteratingSource) {
-        auto nextInput = pSource->getNext();
-        if (!nextInput.isEOF()) {
-            return nextInput;
+        // When merging sorted inputs both of them are needed from the start, so the sub-pipeline
+        // is set up before anything is read from the base collection.
+        if (!_mergeSortPattern) {
+            auto nextInput = pSource->getNext();
+            if (!nextInput.isEOF()) {
+                return nextInput;
+            }
         }
         _executionState = ExecutionProgress::kStartingSubPipeline;
         // All documents from the base collection have been returned, switch to iterating the sub-
@@ -240,6 +249,10 @@ DocumentSource::GetNextResult DocumentSourceUnionWith::doGetNext() {
     // subpipeline.
     _pipeline.get_deleter().dismissDisposal();
 
+    if (_mergeSortPattern) {
+        return doGetNextMergeSorted();
+    }
+
     auto res = _pipeline->getNext();
     if (res)
         return std::move(*res);
@@ -251,6 +264,52 @@ DocumentSource::GetNextResult DocumentSourceUnionWith::doGetNext() {
     return GetNextResult::makeEOF();
 }
 
+DocumentSource::GetNextResult DocumentSourceUnionWith::doGetNextMergeSorted() {
+    if (!_mergeSortKeyGen) {
+        _mergeSortKeyGen.emplace(*_mergeSortPattern, pExpCtx->getCollator());
+        _mergeSortKeyComparator.emplace(*_mergeSortPattern);
+    }
+
+    if (!_nextSourceResult && !_sourceExhausted) {
+        auto nextInput = pSource->getNext();
+        if (nextInput.isAdvanced()) {
+            auto doc = nextInput.releaseDocument();
+            auto sortKey = _mergeSortKeyGen->computeSortKeyFromDocument(doc);
+            _nextSourceResult.emplace(std::move(sortKey), std::move(doc));
+        } else if (nextInput.isEOF()) {
+            _sourceExhausted = true;
+        } else {
+            return nextInput;
+        }
+    }
+
+    if (!_nextSubPipelineResult && !_subPipelineExhausted) {
+        if (auto doc = _pipeline->getNext()) {
+            auto sortKey = _mergeSortKeyGen->computeSortKeyFromDocument(*doc);
+            _nextSubPipelineResult.emplace(std::move(sortKey), std::move(*doc));
+        } else {
+            // Record the plan summary stats once the sub-pipeline is done.
+            accumulatePipelinePlanSummaryStats(*_pipeline, _stats.planSummaryStats);
+            _subPipelineExhausted = true;
+        }
+    }
+
+    if (!_nextSourceResult && !_nextSubPipelineResult) {
+        _executionState = ExecutionProgress::kFinished;
+        return GetNextResult::makeEOF();
+    }
+
+    // Ties go to the base collection, as they would if the inputs were concatenated and then sorted
+    // with a stable sort.
+    bool takeFromSource = _nextSourceResult &&
+        (!_nextSubPipelineResult ||
+         (*_mergeSortKeyComparator)(_nextSourceResult->first, _nextSubPipelineResult->first) <= 0);
+    auto& next = takeFromSource ? _nextSourceResult : _nextSubPipelineResult;
+    auto doc = std::move(next->second);
+    next.reset();
+    return std::move(doc);
+}
+
 // The use of these logging macros is done in separate NOINLINE functions to reduce the stack space
 // used on the hot getNext() path. This is done to avoid stack overflows.
 MONGO_COMPILER_NOINLINE void DocumentSourceUnionWith::logStartingSubPipeline(
@@ -274,26 +333,68 @@ MONGO_COMPILER_NOINLINE void DocumentSourceUnionWith::logShardedViewFound(
 
 Pipeline::SourceContainer::iterator DocumentSourceUnionWith::doOptimizeAt(
     Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container) {
-    auto duplicateAcrossUnion = [&](auto&& nextStage) {
-        _pipeline->addFinalSource(nextStage->clone(_pipeline->getContext()));
+    auto appendToSubPipeline = [&](auto&& stage) {
+        _pipeline->addFinalSource(stage->clone(_pipeline->getContext()));
         // Apply the same rewrite to the cached pipeline if available.
         if (pExpCtx->explain >= ExplainOptions::Verbosity::kExecStats) {
-            auto cloneForExplain = nextStage->clone(_pipeline->getContext());
+            auto cloneForExplain = stage->clone(_pipeline->getContext());
             if (!_cachedPipeline.empty()) {
                 cloneForExplain->setSource(_cachedPipeline.back().get());
             }
             _cachedPipeline.push_back(std::move(cloneForExplain));
         }
+    };
+    auto duplicateAcrossUnion = [&](auto&& nextStage) {
+        appendToSubPipeline(nextStage);
         auto newStageItr = container->insert(itr, std::move(nextStage));
         container->erase(std::next(itr));
         return newStageItr == container->begin() ? newStageItr : std::prev(newStageItr);
     };
+    // A $sort after the $unionWith can be applied to each input separately, after which the sorted
+    // inputs only need to be merged. Each input can then use an index to provide the sort, and
+    // only the first documents of each input need to be produced when the sort has a limit.
+    auto pushSortIntoBothInputs = [&](DocumentSourceSort* nextSort) {
+        auto sortItr = std::next(itr);
+        auto absorbedLimit = nextSort->getLimit();
+        auto userLimit = getUserLimit(std::next(sortItr), container);
+        auto limit = absorbedLimit;
+        if (userLimit && (!limit || *userLimit < *limit)) {
+            limit = userLimit;
+        }
+        auto sortPattern = nextSort->getSortKeyPattern();
+
+        appendToSubPipeline(
+            DocumentSourceSort::create(_pipeline->getContext(), sortPattern, limit.value_or(0)));
+        _mergeSortPattern = sortPattern;
+
+        // A limit which the $sort has already absorbed still has to be applied to the merged
+        // output. A $limit stage which has not been absorbed stays where it is.
+        if (absorbedLimit) {
+            *sortItr = DocumentSourceLimit::create(pExpCtx, *absorbedLimit);
+        } else {
+            container->erase(sortItr);
+        }
+        auto newStageItr = container->insert(
+            itr, DocumentSourceSort::create(pExpCtx, sortPattern, limit.value_or(0)));
+        return newStageItr == container->begin() ? newStageItr : std::prev(newStageItr);
+    };
     if (std::next(itr) != container->end()) {
         if (auto nextMatch = dynamic_cast<DocumentSourceMatch*>((*std::next(itr)).get()))
             return duplicateAcrossUnion(nextMatch);
         else if (auto nextProject = dynamic_cast<DocumentSourceSingleDocumentTransformation*>(
-                     (*std::next(itr)).get()))
-            return duplicateAcrossUnion(nextProject);
+                     (*std::next(itr)).get())) {
+            // Once the inputs are merged on their sort keys, a projection which could modify those
+            // keys has to stay behind the merge.
+            if (!_mergeSortPattern)
+                return duplicateAcrossUnion(nextProject);
+        } else if (auto nextSort = dynamic_cast<DocumentSourceSort*>((*std::next(itr)).get())) {
+            if (internalQueryUnionWithMergeSortedInputs.load() &&
+                !nextSort->isBoundedSortStage() &&
+                std::all_of(nextSort->getSortKeyPattern().begin(),
+                            nextSort->getSortKeyPattern().end(),
+                            [](auto&& part) { return !part.expression; }))
+                return pushSortIntoBothInputs(nextSort);
+        }
     }
     return std::next(itr);
 };
@@ -374,6 +475,27 @@ Value DocumentSourceUnionWith::serialize(boost::optional<ExplainOptions::Verbosi
     }
 }
 
+void DocumentSourceUnionWith::serializeToArray(
+    std::vector<Value>& array, boost::optional<ExplainOptions::Verbosity> explain) const {
+    auto serialized = serialize(explain);
+    if (!_mergeSortPattern) {
+        array.push_back(std::move(serialized));
+        return;
+    }
+
+    if (explain) {
+        MutableDocument spec(serialized.getDocument()[getSourceName()].getDocument());
+        spec["mergeSortPattern"] =
+            Value(_mergeSortPattern->serialize(SortPattern::SortKeySerialization::kForExplain));
+        array.push_back(Value(DOC(getSourceName() << spec.freeze())));
+        return;
+    }
+
+    array.push_back(std::move(serialized));
+    array.push_back(Value(DOC(DocumentSourceSort::kStageName << _mergeSortPattern->serialize(
+                                  SortPattern::SortKeySerialization::kForPipelineSerialization))));
+}
+
 // Extracting dependencies for the outer collection. Although, this method walks the inner pipeline,
 // the field dependencies are not collected - only variable dependencies are.
 DepsTracker::State DocumentSourceUnionWith::getDependencies(DepsTracker* deps) const {
@@ -30,11 +30,15 @@
 #pragma once
 
 #include <boost/optional.hpp>
+#include <utility>
 
+#include "mongo/db/exec/sort_key_comparator.h"
+#include "mongo/db/index/sort_key_generator.h"
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/lite_parsed_document_source.h"
 #include "mongo/db/pipeline/lite_parsed_pipeline.h"
 #include "mongo/db/pipeline/stage_constraints.h"
+#include "mongo/db/query/sort_pattern.h"
 
 namespace mongo {
 
@@ -72,7 +76,9 @@ public:
 
     DocumentSourceUnionWith(const DocumentSourceUnionWith& original,
                             const boost::intrusive_ptr<ExpressionContext>& newExpCtx)
-        : DocumentSource(kStageName, newExpCtx), _pipeline(original._pipeline->clone()) {}
+        : DocumentSource(kStageName, newExpCtx),
+          _pipeline(original._pipeline->clone()),
+          _mergeSortPattern(original._mergeSortPattern) {}
 
     ~DocumentSourceUnionWith();
 
@@ -80,6 +86,15 @@ public:
         return kStageName.rawData();
     }
 
+    /**
+     * When the $unionWith merges sorted inputs, a non-explain serialization is followed by a $sort
+     * on the merge pattern, so that the serialized pipeline still produces sorted output when it is
+     * parsed again, including by a version which does not know about the merge.
+     */
+    void serializeToArray(
+        std::vector<Value>& array,
+        boost::optional<ExplainOptions::Verbosity> explain = boost::none) const final;
+
     GetModPathsReturn getModifiedPaths() const final {
         // Since we might have a document arrive from the foreign pipeline with the same path as a
         // document in the main pipeline. Without introspecting the sub-pipeline, we must report
@@ -184,6 +199,12 @@ private:
 
     void addViewDefinition(NamespaceString nss, std::vector<BSONObj> viewPipeline);
 
+    /**
+     * Returns the next result when both inputs are sorted on '_mergeSortPattern', by interleaving
+     * them in sort order rather than returning all of the main input first.
+     */
+    GetNextResult doGetNextMergeSorted();
+
     void logStartingSubPipeline(const std::vector<BSONObj>& serializedPipeline);
     void logShardedViewFound(
         const ExceptionFor<ErrorCodes::CommandOnShardedViewNotSupportedOnMongod>& e);
@@ -192,6 +213,18 @@ private:
     Pipeline::SourceContainer _cachedPipeline;
     ExecutionProgress _executionState = ExecutionProgress::kIteratingSource;
     UnionWithStats _stats;
+
+    // Set when a following $sort has been pushed down into both the main pipeline and the
+    // sub-pipeline. Both inputs then arrive sorted on this pattern and are merged as they are read.
+    boost::optional<SortPattern> _mergeSortPattern;
+    boost::optional<SortKeyGenerator> _mergeSortKeyGen;
+    boost::optional<SortKeyComparator> _mergeSortKeyComparator;
+
+    // The next unreturned document from each input while merging, along with its sort key.
+    boost::optional<std::pair<Value, Document>> _nextSourceResult;
+    boost::optional<std::pair<Value, Document>> _nextSubPipelineResult;
+    bool _sourceExhausted = false;
+    bool _subPipelineExhausted = false;
 };
 
 }  // namespace mongo
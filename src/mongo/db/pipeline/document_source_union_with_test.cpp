@@ -45,10 +45,12 @@
 #include "mongo/db/pipeline/document_source_match.h"
 #include "mongo/db/pipeline/document_source_mock.h"
 #include "mongo/db/pipeline/document_source_replace_root.h"
+#include "mongo/db/pipeline/document_source_sort.h"
 #include "mongo/db/pipeline/document_source_union_with.h"
 #include "mongo/db/pipeline/pipeline.h"
 #include "mongo/db/pipeline/process_interface/stub_lookup_single_document_process_interface.h"
 #include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/intrusive_counter.h"
 
@@ -335,6 +337,31 @@ TEST_F(DocumentSourceUnionWithTest, ReturnEOFAfterBeingDisposed) {
     ASSERT_TRUE(unionWith.getNext().isEOF());
 }
 
+TEST_F(DocumentSourceUnionWithTest, MergesSortedInputsInSortOrder) {
+    RAIIServerParameterControllerForTest controller("internalQueryUnionWithMergeSortedInputs",
+                                                    true);
+    auto expCtx = getExpCtx();
+    const auto mockUnionInput = std::deque<DocumentSource::GetNextResult>{
+        Document{{"a", 6}}, Document{{"a", 2}}, Document{{"a", 4}}};
+    expCtx->mongoProcessInterface = std::make_unique<MockMongoInterface>(mockUnionInput);
+    const auto mock = DocumentSourceMock::createForTest({"{a: 5}", "{a: 1}", "{a: 3}"}, expCtx);
+    const auto unionWith = make_intrusive<DocumentSourceUnionWith>(
+        expCtx, Pipeline::create(std::list<boost::intrusive_ptr<DocumentSource>>{}, expCtx));
+    const auto sort = DocumentSourceSort::create(expCtx, BSON("a" << 1));
+    auto pipeline = Pipeline::create({mock, unionWith, sort}, expCtx);
+    pipeline->optimizePipeline();
+
+    // The $sort has been pushed into both inputs, so nothing follows the $unionWith.
+    ASSERT_TRUE(pipeline->getSources().back() == unionWith);
+
+    for (auto i = 1; i <= 6; ++i) {
+        auto next = pipeline->getNext();
+        ASSERT_TRUE(next);
+        ASSERT_DOCUMENT_EQ(*next, (Document{{"a", i}}));
+    }
+    ASSERT_FALSE(pipeline->getNext());
+}
+
 TEST_F(DocumentSourceUnionWithTest, DependencyAnalysisReportsFullDoc) {
     auto expCtx = getExpCtx();
     const auto replaceRoot =
@@ -219,6 +219,26 @@ DocumentSource::GetNextResult DocumentSourceUnwind::doGetNext() {
     return nextOut;
 }
 
+DocumentSource::GetNextResult::ReturnStatus DocumentSourceUnwind::doGetNextBatch(
+    std::vector<Document>* batch, size_t maxBatchSize) {
+    // Inputs are still read one at a time, since a single input may unwind into more results than
+    // the batch can hold. The documents unwound from an array are returned together.
+    while (batch->size() < maxBatchSize) {
+        auto nextOut = _unwinder->getNext();
+        if (nextOut.isAdvanced()) {
+            batch->push_back(nextOut.releaseDocument());
+            continue;
+        }
+
+        auto nextInput = pSource->getNext();
+        if (!nextInput.isAdvanced()) {
+            return nextInput.getStatus();
+        }
+        _unwinder->resetDocument(nextInput.releaseDocument());
+    }
+    return GetNextResult::ReturnStatus::kAdvanced;
+}
+
 DocumentSource::GetModPathsReturn DocumentSourceUnwind::getModifiedPaths() const {
     OrderedPathSet modifiedFields{_unwindPath.fullPath()};
     if (_indexPath) {
@@ -110,6 +110,8 @@ private:
                          bool strict);
 
     GetNextResult doGetNext() final;
+    GetNextResult::ReturnStatus doGetNextBatch(std::vector<Document>* batch,
+                                               size_t maxBatchSize) final;
 
     // Checks if a sort is eligible to be moved before the unwind.
     bool canPushSortBack(const DocumentSourceSort* sort) const;
@@ -709,6 +709,40 @@ TEST_F(UnwindStageTest, ShouldPropagatePauses) {
     ASSERT_TRUE(unwind->getNext().isEOF());
 }
 
+TEST_F(UnwindStageTest, GetNextBatchShouldSplitArraysAcrossBatches) {
+    const bool includeNullIfEmptyOrMissing = false;
+    const boost::optional<std::string> includeArrayIndex = boost::none;
+    auto unwind = DocumentSourceUnwind::create(
+        getExpCtx(), "array", includeNullIfEmptyOrMissing, includeArrayIndex);
+    auto source = DocumentSourceMock::createForTest(
+        {Document{{"array", vector<Value>{Value(1), Value(2), Value(3)}}},
+         DocumentSource::GetNextResult::makePauseExecution(),
+         Document{{"array", vector<Value>{Value(4)}}}},
+        getExpCtx());
+
+    unwind->setSource(source.get());
+
+    using ReturnStatus = DocumentSource::GetNextResult::ReturnStatus;
+    std::vector<Document> batch;
+    ASSERT(unwind->getNextBatch(&batch, 2) == ReturnStatus::kAdvanced);
+    ASSERT_EQ(batch.size(), 2U);
+    ASSERT_DOCUMENT_EQ(batch[0], (Document{{"array", 1}}));
+    ASSERT_DOCUMENT_EQ(batch[1], (Document{{"array", 2}}));
+
+    // The rest of the array is returned by getNext() as well as by getNextBatch().
+    auto next = unwind->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(), (Document{{"array", 3}}));
+
+    batch.clear();
+    ASSERT(unwind->getNextBatch(&batch, 2) == ReturnStatus::kPauseExecution);
+    ASSERT(batch.empty());
+
+    ASSERT(unwind->getNextBatch(&batch, 2) == ReturnStatus::kEOF);
+    ASSERT_EQ(batch.size(), 1U);
+    ASSERT_DOCUMENT_EQ(batch[0], (Document{{"array", 4}}));
+}
+
 TEST_F(UnwindStageTest, UnwindOnlyModifiesUnwoundPathWhenNotIncludingIndex) {
     const bool includeNullIfEmptyOrMissing = false;
     const boost::optional<std::string> includeArrayIndex = boost::none;
@@ -38,6 +38,7 @@
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/read_concern.h"
+#include "mongo/db/record_id.h"
 #include "mongo/db/storage/recovery_unit.h"
 #include "mongo/rpc/metadata/impersonated_user_metadata.h"
 #include "mongo/s/write_ops/batched_command_request.h"
@@ -97,7 +98,8 @@ public:
  *
  * Two other virtual methods exist which a subclass may override: 'initialize()' and 'finalize()',
  * which are called before the first element is read from the input source, and after the last one
- * has been read, respectively.
+ * has been read, respectively. A subclass may also override 'onBatchWritten()' to learn how far
+ * into its input the writes have progressed.
  */
 template <typename B>
 class DocumentSourceWriter : public DocumentSource {
@@ -162,6 +164,12 @@ protected:
      */
     virtual void finalize() {}
 
+    /**
+     * Called after each batch is written. 'lastRecordId' is the RecordId metadata of the last
+     * document of the batch, if it has one.
+     */
+    virtual void onBatchWritten(const boost::optional<RecordId>& lastRecordId) {}
+
     /**
      * Writes the documents in 'batch' to the output namespace via 'bcr'.
      */
@@ -267,11 +275,15 @@ DocumentSource::GetNextResult DocumentSourceWriter<B>::doGetNext() {
 
         BatchedObjects batch;
         size_t bufferedBytes = 0;
+        boost::optional<RecordId> batchLastRecordId;
         auto nextInput = pSource->getNext();
         for (; nextInput.isAdvanced(); nextInput = pSource->getNext()) {
             waitWhileFailPointEnabled();
 
             auto doc = nextInput.releaseDocument();
+            auto recordId = doc.metadata().hasRecordId()
+                ? boost::optional<RecordId>(doc.metadata().getRecordId())
+                : boost::none;
             auto [obj, objSize] = makeBatchObject(std::move(doc));
 
             bufferedBytes += objSize;
@@ -279,14 +291,17 @@ DocumentSource::GetNextResult DocumentSourceWriter<B>::doGetNext() {
                 (bufferedBytes > maxBatchSizeBytes ||
                  batch.size() >= write_ops::kMaxWriteBatchSize)) {
                 spill(std::move(batchWrite), std::move(batch));
+                onBatchWritten(batchLastRecordId);
                 batch.clear();
                 batchWrite = initializeBatchedWriteRequest();
                 bufferedBytes = objSize;
             }
             batch.push_back(obj);
+            batchLastRecordId = std::move(recordId);
         }
         if (!batch.empty()) {
             spill(std::move(batchWrite), std::move(batch));
+            onBatchWritten(batchLastRecordId);
             batch.clear();
         }
 
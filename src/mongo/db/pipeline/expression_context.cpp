@@ -213,6 +213,7 @@ intrusive_ptr<ExpressionContext> ExpressionContext::copyWith(
     expCtx->tempDir = tempDir;
     expCtx->jsHeapLimitMB = jsHeapLimitMB;
     expCtx->isParsingViewDefinition = isParsingViewDefinition;
+    expCtx->maxDegreeOfParallelism = maxDegreeOfParallelism;
 
     expCtx->variables = variables;
     expCtx->variablesParseState = variablesParseState.copyWith(expCtx->variables.useIdGenerator());
@@ -233,6 +234,21 @@ intrusive_ptr<ExpressionContext> ExpressionContext::copyWith(
     return expCtx;
 }
 
+bool ExpressionContext::canReadInParallel() const {
+    if (!opCtx || opCtx->inMultiDocumentTransaction()) {
+        return false;
+    }
+
+    switch (opCtx->recoveryUnit()->getTimestampReadSource()) {
+        case RecoveryUnit::ReadSource::kProvided:
+        case RecoveryUnit::ReadSource::kMajorityCommitted:
+        case RecoveryUnit::ReadSource::kAllDurableSnapshot:
+            return true;
+        default:
+            return false;
+    }
+}
+
 void ExpressionContext::startExpressionCounters() {
     if (enabledCounters && !_expressionCounters) {
         _expressionCounters = boost::make_optional<ExpressionCounters>({});
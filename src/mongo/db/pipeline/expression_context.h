@@ -403,6 +403,28 @@ public:
     bool bypassDocumentValidation = false;
     bool hasWhereClause = false;
 
+    // The maximum number of threads the query may use for parallel execution in SBE, if it was
+    // specified by the request. Otherwise the server-wide default applies.
+    boost::optional<int> maxDegreeOfParallelism;
+
+    /**
+     * Returns the maximum number of threads the query may use for parallel execution in SBE, which
+     * is never more than the server-wide thread budget.
+     */
+    int getMaxDegreeOfParallelism() const {
+        return std::min(maxDegreeOfParallelism.value_or(
+                            internalQuerySlotBasedExecutionMaxDegreeOfParallelism.load()),
+                        internalQuerySlotBasedExecutionParallelThreadBudget.load());
+    }
+
+    /**
+     * Returns true if the operation may hand parts of the query to threads with operation contexts
+     * of their own. Those threads cannot see the writes of a multi-document transaction, and they
+     * can only observe the same snapshot as the operation if it reads at a timestamp which is known
+     * when they start.
+     */
+    bool canReadInParallel() const;
+
     NamespaceString ns;
 
     // If known, the UUID of the execution namespace for this aggregation command.
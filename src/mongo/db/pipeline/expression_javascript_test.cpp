@@ -34,10 +34,13 @@
 #include "mongo/db/exec/document_value/document_value_test_util.h"
 #include "mongo/db/pipeline/expression_context_for_test.h"
 #include "mongo/db/pipeline/expression_function.h"
+#include "mongo/db/pipeline/javascript_execution.h"
 #include "mongo/db/pipeline/process_interface/standalone_process_interface.h"
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/service_context_d_test_fixture.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/scripting/engine.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/unittest.h"
 
 namespace mongo {
@@ -274,5 +277,65 @@ TEST_F(MapReduceFixture, ExpressionInternalJsErrorsIfProducesTooManyDocumentsFor
     ASSERT_THROWS_CODE(
         expr->evaluate(Document{BSON("val" << 1)}, getVariables()), AssertionException, 31292);
 }
+/**
+ * Runs an operation on a new client of the current thread that uses a JsExecution for 'database',
+ * parking its scope when the operation finishes.
+ */
+void runJsOperation(ServiceContext* serviceContext, StringData database) {
+    auto client = serviceContext->makeClient("jsClient");
+    auto opCtx = client->makeOperationContext();
+    auto exec = JsExecution::get(opCtx.get(), BSONObj(), database, false, boost::none);
+    auto func = exec->createFunction("function() { return 1; }");
+    ASSERT_VALUE_EQ(exec->callFunction(func, BSONObj(), BSONObj()), Value(1));
+}
+
+TEST_F(MapReduceFixture, JsExecutionParksScopeUntilThreadExits) {
+    const auto numIdleBefore = JsExecution::getNumIdleScopes();
+
+    stdx::thread([&] {
+        runJsOperation(getServiceContext(), "db1");
+        ASSERT_EQ(JsExecution::getNumIdleScopes(), numIdleBefore + 1);
+
+        // An operation with the same key takes the parked scope and parks it again.
+        runJsOperation(getServiceContext(), "db1");
+        ASSERT_EQ(JsExecution::getNumIdleScopes(), numIdleBefore + 1);
+
+        runJsOperation(getServiceContext(), "db2");
+        ASSERT_EQ(JsExecution::getNumIdleScopes(), numIdleBefore + 2);
+    }).join();
+
+    ASSERT_EQ(JsExecution::getNumIdleScopes(), numIdleBefore);
+}
+
+TEST_F(MapReduceFixture, JsExecutionParksNoMoreScopesThanThePoolSize) {
+    const auto numIdleBefore = JsExecution::getNumIdleScopes();
+    RAIIServerParameterControllerForTest poolSize{"scriptingIdleScopePoolSize", numIdleBefore + 1};
+
+    stdx::thread([&] {
+        runJsOperation(getServiceContext(), "db1");
+        ASSERT_EQ(JsExecution::getNumIdleScopes(), numIdleBefore + 1);
+
+        // The pool is full, so this thread's least recently used scope makes room.
+        runJsOperation(getServiceContext(), "db2");
+        ASSERT_EQ(JsExecution::getNumIdleScopes(), numIdleBefore + 1);
+    }).join();
+
+    stdx::thread([&] {
+        RAIIServerParameterControllerForTest noPool{"scriptingIdleScopePoolSize", 0};
+        runJsOperation(getServiceContext(), "db1");
+        ASSERT_EQ(JsExecution::getNumIdleScopes(), numIdleBefore);
+    }).join();
+}
+
+TEST_F(MapReduceFixture, JsExecutionDoesNotParkScopesWhenReuseIsDisabled) {
+    const auto numIdleBefore = JsExecution::getNumIdleScopes();
+    RAIIServerParameterControllerForTest maxReuse{"scriptingScopeMaxReuseSecs", 0};
+
+    stdx::thread([&] {
+        runJsOperation(getServiceContext(), "db1");
+        ASSERT_EQ(JsExecution::getNumIdleScopes(), numIdleBefore);
+    }).join();
+}
+
 }  // namespace
 }  // namespace mongo
@@ -31,17 +31,155 @@
 
 #include "mongo/db/pipeline/javascript_execution.h"
 
+#include <algorithm>
 #include <iostream>
+#include <list>
 
 #include "mongo/base/status_with.h"
+#include "mongo/db/auth/authorization_session.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/scripting/engine_parameters_gen.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
 
 namespace {
 const auto getExec = OperationContext::declareDecoration<std::unique_ptr<JsExecution>>();
+
+// Number of scopes parked in all threads' IdleScopes, bounded by 'scriptingIdleScopePoolSize'.
+AtomicWord<int> numIdleScopes;
+
+bool reserveIdleScopeSlot() {
+    auto numIdle = numIdleScopes.load();
+    do {
+        if (numIdle >= gScriptingIdleScopePoolSize.load()) {
+            return false;
+        }
+    } while (!numIdleScopes.compareAndSwap(&numIdle, numIdle + 1));
+    return true;
+}
+
+/**
+ * Scopes are bound to the thread that created them and must also be destroyed on it, so rather
+ * than going through the global ScriptEngine scope pool, the scopes of finished JsExecutions are
+ * parked on their thread and handed to the next operation on that thread with the same key. This
+ * lets consecutive operations, such as the getMores of one cursor, skip creating a scope and
+ * recompiling their functions.
+ *
+ * The number of parked scopes is bounded process-wide by 'scriptingIdleScopePoolSize'. Scopes
+ * older than 'scriptingScopeMaxReuseSecs' are evicted whenever their thread parks or acquires a
+ * scope, and all of a thread's scopes are released when the thread exits.
+ */
+class IdleScopes {
+public:
+    ~IdleScopes() {
+        _evict([](const Entry&) { return true; });
+    }
+
+    std::unique_ptr<Scope> acquire(const std::string& key) {
+        _evictExpired();
+
+        auto it = std::find_if(
+            _entries.begin(), _entries.end(), [&](const Entry& entry) { return entry.key == key; });
+        if (it == _entries.end()) {
+            return nullptr;
+        }
+
+        auto scope = std::move(it->scope);
+        _entries.erase(it);
+        numIdleScopes.subtractAndFetch(1);
+
+        scope->reset();
+        return scope;
+    }
+
+    void park(std::string key, std::unique_ptr<Scope> scope) {
+        _evictExpired();
+
+        // Replaces any scope already parked with this key, preferring the most recently used one.
+        _evict([&](const Entry& entry) { return entry.key == key; });
+
+        if (_isExpired(*scope)) {
+            return;
+        }
+
+        if (!reserveIdleScopeSlot()) {
+            // Make room by dropping this thread's least recently used scope, if it has one.
+            if (_entries.empty()) {
+                return;
+            }
+            _entries.pop_back();
+        }
+
+        _entries.push_front({std::move(key), std::move(scope)});
+    }
+
+private:
+    struct Entry {
+        std::string key;
+        std::unique_ptr<Scope> scope;
+    };
+
+    static bool _isExpired(const Scope& scope) {
+        return Date_t::now() - scope.getCreateTime() > Seconds(gScriptingScopeMaxReuseSecs.load());
+    }
+
+    void _evictExpired() {
+        _evict([](const Entry& entry) { return _isExpired(*entry.scope); });
+    }
+
+    template <typename Pred>
+    void _evict(Pred&& pred) {
+        auto numEvicted = _entries.remove_if(std::forward<Pred>(pred));
+        if (numEvicted) {
+            numIdleScopes.subtractAndFetch(numEvicted);
+        }
+    }
+
+    std::list<Entry> _entries;  // More recently used scopes are kept at the front.
+};
+thread_local IdleScopes idleScopes;
+
+/**
+ * Scopes may only be shared between operations that agree on everything used to set them up, and
+ * as with the $where scope pool, only between operations run by the same authenticated users.
+ */
+std::string makeReuseKey(OperationContext* opCtx,
+                         StringData database,
+                         bool loadStoredProcedures,
+                         boost::optional<int> jsHeapLimitMB) {
+    StringBuilder sb;
+    sb << database << '\0' << loadStoredProcedures << '\0' << jsHeapLimitMB.value_or(0);
+
+    auto as = AuthorizationSession::get(opCtx->getClient());
+    for (auto nameIter = as->getAuthenticatedUserNames(); nameIter.more(); nameIter.next()) {
+        // Using a NUL byte which isn't valid in usernames to separate them.
+        if (const auto& tenant = nameIter->getTenant()) {
+            sb << '\0' << tenant->toString();
+        }
+        sb << '\0' << nameIter->getUnambiguousName();
+    }
+
+    return sb.str();
+}
+
 }  // namespace
 
+JsExecution::~JsExecution() {
+    _scope->unregisterOperation();
+
+    if (_reuseKey.empty() || gScriptingScopeMaxReuseSecs.load() == 0 ||
+        _scope->hasOutOfMemoryException() || !_scope->getError().empty()) {
+        return;
+    }
+
+    idleScopes.park(std::move(_reuseKey), std::move(_scope));
+}
+
+int JsExecution::getNumIdleScopes() {
+    return numIdleScopes.load();
+}
+
 JsExecution* JsExecution::get(OperationContext* opCtx,
                               const BSONObj& scope,
                               StringData database,
@@ -49,7 +187,13 @@ JsExecution* JsExecution::get(OperationContext* opCtx,
                               boost::optional<int> jsHeapLimitMB) {
     auto& exec = getExec(opCtx);
     if (!exec) {
-        exec = std::make_unique<JsExecution>(opCtx, scope, jsHeapLimitMB);
+        auto reuseKey = makeReuseKey(opCtx, database, loadStoredProcedures, jsHeapLimitMB);
+        if (auto idle = idleScopes.acquire(reuseKey)) {
+            exec = std::make_unique<JsExecution>(opCtx, scope, std::move(idle));
+        } else {
+            exec = std::make_unique<JsExecution>(opCtx, scope, jsHeapLimitMB);
+        }
+        exec->_reuseKey = std::move(reuseKey);
         exec->getScope()->setLocalDB(database);
         if (loadStoredProcedures) {
             exec->getScope()->loadStored(opCtx, true);
@@ -64,16 +64,34 @@ public:
     JsExecution(OperationContext* opCtx,
                 const BSONObj& scopeVars,
                 boost::optional<int> jsHeapLimitMB = boost::none)
-        : _scope(getGlobalScriptEngine()->newScopeForCurrentThread(jsHeapLimitMB)) {
+        : JsExecution(opCtx,
+                      scopeVars,
+                      std::unique_ptr<Scope>(
+                          getGlobalScriptEngine()->newScopeForCurrentThread(jsHeapLimitMB))) {}
+
+    /**
+     * Construct around an existing thread-local scope and initialize it with the given scope
+     * variables.
+     */
+    JsExecution(OperationContext* opCtx, const BSONObj& scopeVars, std::unique_ptr<Scope> scope)
+        : _scope(std::move(scope)) {
         _scopeVars = scopeVars.getOwned();
         _scope->init(&_scopeVars);
         _fnCallTimeoutMillis = internalQueryJavaScriptFnTimeoutMillis.load();
         _scope->registerOperation(opCtx);
     }
 
-    ~JsExecution() {
-        _scope->unregisterOperation();
-    };
+    /**
+     * If this instance was created by get(), hands its scope back to the current thread so that
+     * the next operation with the same database, user and settings reuses it along with its
+     * compiled functions.
+     */
+    ~JsExecution();
+
+    /**
+     * Returns the number of scopes currently parked for reuse across all threads.
+     */
+    static int getNumIdleScopes();
 
     /**
      * Invokes the javascript function given by 'func' with the arguments 'params' and input object
@@ -115,6 +133,9 @@ public:
 private:
     BSONObj _scopeVars;
     std::unique_ptr<Scope> _scope;
+    // Identifies which operations may reuse '_scope' once this instance is destroyed. Empty if the
+    // scope must not be reused.
+    std::string _reuseKey;
     bool _storedProceduresLoaded = false;
     int _fnCallTimeoutMillis;
 
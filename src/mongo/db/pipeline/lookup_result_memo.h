@@ -0,0 +1,148 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <list>
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/exec/document_value/value.h"
+#include "mongo/db/pipeline/memory_usage_tracker.h"
+#include "mongo/stdx/unordered_map.h"
+
+namespace mongo {
+
+/**
+ * A least-recently-used memo of complete $lookup sub-pipeline results, keyed by the values that
+ * the sub-pipeline is correlated on. Keys are compared by their exact BSON representation, so two
+ * keys that compare equal but differ in type (e.g. 1 and 1.0) are memoized separately. The memo
+ * is bounded by the approximate size of the keys and results it holds.
+ */
+class LookupResultMemo {
+public:
+    explicit LookupResultMemo(size_t maxSizeBytes) : _maxSizeBytes(maxSizeBytes) {}
+
+    /**
+     * Returns the results memoized under 'key' and marks them as most recently used, or nullptr if
+     * there are none. Counts towards the hit and miss totals.
+     */
+    const std::vector<Value>* find(const BSONObj& key) {
+        auto it = _index.find(_makeKey(key));
+        if (it == _index.end()) {
+            ++_misses;
+            return nullptr;
+        }
+
+        ++_hits;
+        _entries.splice(_entries.begin(), _entries, it->second);
+        return &it->second->results;
+    }
+
+    /**
+     * Memoizes 'results' under 'key', evicting least recently used entries as needed to stay
+     * within the size limit. Results that would not fit on their own are not memoized.
+     */
+    void insert(const BSONObj& key, std::vector<Value> results) {
+        auto keyString = _makeKey(key);
+        size_t entrySize = keyString.size();
+        for (auto&& result : results) {
+            entrySize += result.getApproximateSize();
+        }
+        if (entrySize > _maxSizeBytes) {
+            return;
+        }
+
+        if (auto it = _index.find(keyString); it != _index.end()) {
+            _erase(it->second);
+        }
+
+        while (_sizeBytes + entrySize > _maxSizeBytes) {
+            _erase(std::prev(_entries.end()));
+        }
+
+        _entries.push_front({keyString, std::move(results), entrySize});
+        _index.emplace(std::move(keyString), _entries.begin());
+        _sizeBytes += entrySize;
+        _memoryTracker.set(_sizeBytes);
+    }
+
+    size_t size() const {
+        return _entries.size();
+    }
+
+    size_t sizeBytes() const {
+        return _sizeBytes;
+    }
+
+    long long peakSizeBytes() const {
+        return _memoryTracker.maxMemoryBytes();
+    }
+
+    long long hits() const {
+        return _hits;
+    }
+
+    long long misses() const {
+        return _misses;
+    }
+
+private:
+    struct Entry {
+        std::string key;
+        std::vector<Value> results;
+        size_t sizeBytes;
+    };
+    using EntryList = std::list<Entry>;
+
+    static std::string _makeKey(const BSONObj& key) {
+        return std::string(key.objdata(), key.objsize());
+    }
+
+    void _erase(EntryList::iterator it) {
+        _sizeBytes -= it->sizeBytes;
+        _memoryTracker.set(_sizeBytes);
+        _index.erase(it->key);
+        _entries.erase(it);
+    }
+
+    const size_t _maxSizeBytes;
+    size_t _sizeBytes = 0;
+    MemoryUsageTracker _memoryTracker;
+
+    // Most recently used entries are at the front.
+    EntryList _entries;
+    stdx::unordered_map<std::string, EntryList::iterator> _index;
+
+    long long _hits = 0;
+    long long _misses = 0;
+};
+
+}  // namespace mongo
@@ -0,0 +1,136 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <vector>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/exec/document_value/document_value_test_util.h"
+#include "mongo/db/pipeline/lookup_result_memo.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+std::vector<Value> makeResults(std::vector<int> values) {
+    std::vector<Value> results;
+    for (auto value : values) {
+        results.push_back(Value(Document{{"n", value}}));
+    }
+    return results;
+}
+
+size_t resultsSize(const std::vector<Value>& results) {
+    size_t size = 0;
+    for (auto&& result : results) {
+        size += result.getApproximateSize();
+    }
+    return size;
+}
+
+TEST(LookupResultMemoTest, InsertAndFindPreserveResultOrder) {
+    LookupResultMemo memo(1024 * 1024);
+    memo.insert(BSON("" << 1), makeResults({3, 1, 2}));
+
+    auto results = memo.find(BSON("" << 1));
+    ASSERT(results);
+    ASSERT_EQ(3U, results->size());
+    ASSERT_VALUE_EQ((*results)[0], Value(Document{{"n", 3}}));
+    ASSERT_VALUE_EQ((*results)[1], Value(Document{{"n", 1}}));
+    ASSERT_VALUE_EQ((*results)[2], Value(Document{{"n", 2}}));
+    ASSERT_EQ(1, memo.hits());
+    ASSERT_EQ(0, memo.misses());
+}
+
+TEST(LookupResultMemoTest, KeysAreComparedByExactBSON) {
+    LookupResultMemo memo(1024 * 1024);
+    memo.insert(BSON("" << 1), makeResults({1}));
+
+    ASSERT_FALSE(memo.find(BSON("" << 1.0)));
+    ASSERT_FALSE(memo.find(BSON("" << 2)));
+    ASSERT(memo.find(BSON("" << 1)));
+    ASSERT_EQ(1, memo.hits());
+    ASSERT_EQ(2, memo.misses());
+}
+
+TEST(LookupResultMemoTest, EmptyResultsAreMemoized) {
+    LookupResultMemo memo(1024 * 1024);
+    memo.insert(BSON("" << 1), {});
+
+    auto results = memo.find(BSON("" << 1));
+    ASSERT(results);
+    ASSERT_TRUE(results->empty());
+}
+
+TEST(LookupResultMemoTest, EvictsLeastRecentlyUsedEntryWhenFull) {
+    const auto entrySize = BSON("" << 0).objsize() + resultsSize(makeResults({0}));
+    LookupResultMemo memo(2 * entrySize);
+
+    memo.insert(BSON("" << 0), makeResults({0}));
+    memo.insert(BSON("" << 1), makeResults({1}));
+
+    // Using key 0 makes key 1 the least recently used entry.
+    ASSERT(memo.find(BSON("" << 0)));
+    memo.insert(BSON("" << 2), makeResults({2}));
+
+    ASSERT_EQ(2U, memo.size());
+    ASSERT(memo.find(BSON("" << 0)));
+    ASSERT_FALSE(memo.find(BSON("" << 1)));
+    ASSERT(memo.find(BSON("" << 2)));
+    ASSERT_LTE(memo.sizeBytes(), 2 * entrySize);
+}
+
+TEST(LookupResultMemoTest, DoesNotMemoizeResultsLargerThanTheLimit) {
+    const auto entrySize = BSON("" << 0).objsize() + resultsSize(makeResults({0, 1}));
+    LookupResultMemo memo(entrySize - 1);
+
+    memo.insert(BSON("" << 0), makeResults({0, 1}));
+    ASSERT_EQ(0U, memo.size());
+    ASSERT_EQ(0U, memo.sizeBytes());
+    ASSERT_FALSE(memo.find(BSON("" << 0)));
+}
+
+TEST(LookupResultMemoTest, ReinsertingAKeyReplacesItsResults) {
+    LookupResultMemo memo(1024 * 1024);
+    memo.insert(BSON("" << 0), makeResults({0}));
+    const auto sizeAfterFirstInsert = memo.sizeBytes();
+    memo.insert(BSON("" << 0), makeResults({1}));
+
+    ASSERT_EQ(1U, memo.size());
+    ASSERT_EQ(sizeAfterFirstInsert, memo.sizeBytes());
+    auto results = memo.find(BSON("" << 0));
+    ASSERT(results);
+    ASSERT_VALUE_EQ((*results)[0], Value(Document{{"n", 1}}));
+    ASSERT_GTE(memo.peakSizeBytes(), static_cast<long long>(sizeAfterFirstInsert));
+}
+
+}  // namespace
+}  // namespace mongo
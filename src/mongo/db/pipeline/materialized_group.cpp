@@ -0,0 +1,184 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/materialized_group.h"
+
+#include "mongo/db/pipeline/dependencies.h"
+#include "mongo/db/pipeline/document_source.h"
+#include "mongo/db/pipeline/window_function/window_function_avg.h"
+#include "mongo/db/pipeline/window_function/window_function_sum.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Returns true if 'obj' uses an operator which runs JavaScript, whose result may change from one
+ * call to the next.
+ */
+bool containsJavaScript(const BSONObj& obj) {
+    for (auto&& elem : obj) {
+        const auto name = elem.fieldNameStringData();
+        if (name == "$function"_sd || name == "$where"_sd || name == "$accumulator"_sd) {
+            return true;
+        }
+        if (elem.isABSONObj() && containsJavaScript(elem.Obj())) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace
+
+MaterializedGroup::MaterializedGroup(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                     std::vector<BSONObj> pipeline)
+    : _expCtx(expCtx),
+      _pipeline(std::move(pipeline)),
+      _groups(expCtx->getValueComparator().makeUnorderedValueMap<Group>()) {
+    uassert(7000121,
+            "A materialized $group pipeline must consist of an optional $match stage followed by "
+            "a $group stage",
+            _pipeline.size() == 1 || _pipeline.size() == 2);
+
+    for (size_t i = 0; i < _pipeline.size(); ++i) {
+        auto sources = DocumentSource::parse(_expCtx, _pipeline[i]);
+        uassert(7000122,
+                str::stream() << "Invalid stage in a materialized $group pipeline: "
+                              << _pipeline[i],
+                sources.size() == 1);
+
+        const bool isLast = i == _pipeline.size() - 1;
+        if (!isLast) {
+            _match = dynamic_cast<DocumentSourceMatch*>(sources.front().get());
+            uassert(7000122,
+                    str::stream() << "Invalid stage in a materialized $group pipeline: "
+                                  << _pipeline[i],
+                    _match && !_match->isTextQuery());
+        } else {
+            _group = dynamic_cast<DocumentSourceGroup*>(sources.front().get());
+            uassert(7000122,
+                    str::stream() << "Invalid stage in a materialized $group pipeline: "
+                                  << _pipeline[i],
+                    _group);
+        }
+    }
+
+    // Removing a document must exactly undo adding it, and the result must not depend on when the
+    // document was written, so the filter, the group key and the inputs of the accumulators have
+    // to be deterministic functions of the document.
+    DepsTracker deps;
+    if (_match) {
+        _match->getDependencies(&deps);
+    }
+    _group->getDependencies(&deps);
+    uassert(7000123,
+            "A materialized $group pipeline cannot use random values, metadata, the current time "
+            "or JavaScript",
+            !deps.needRandomGenerator && !deps.getNeedsAnyMetadata() &&
+                !deps.hasVariableReferenceTo({Variables::kNowId, Variables::kClusterTimeId}) &&
+                std::none_of(_pipeline.begin(), _pipeline.end(), containsJavaScript));
+
+    for (auto&& accumulatedField : _group->getAccumulatedFields()) {
+        const auto name = accumulatedField.expr.name;
+        if (name == AccumulatorSum::kName) {
+            _factories.push_back(&WindowFunctionSum::create);
+        } else if (name == AccumulatorAvg::kName) {
+            _factories.push_back(&WindowFunctionAvg::create);
+        } else {
+            uasserted(7000124,
+                      str::stream() << "The accumulator " << name << " of field '"
+                                    << accumulatedField.fieldName
+                                    << "' cannot be maintained incrementally; only $sum, $count "
+                                       "and $avg are supported");
+        }
+    }
+
+    _idExpression = _group->getIdExpression();
+}
+
+void MaterializedGroup::_apply(const BSONObj& doc, bool isAdd) {
+    if (_match && !_match->getMatchExpression()->matchesBSON(doc)) {
+        return;
+    }
+
+    const Document root(doc);
+    auto& variables = _expCtx->variables;
+
+    // Like $group, put documents for which the group key is missing in the null group.
+    Value id = _idExpression->evaluate(root, &variables);
+    if (id.missing()) {
+        id = Value(BSONNULL);
+    }
+
+    auto& accumulatedFields = _group->getAccumulatedFields();
+    auto it = _groups.find(id);
+    if (it == _groups.end()) {
+        tassert(7000125, "Removing a document from a non-existent materialized group", isAdd);
+        Group group;
+        for (auto&& factory : _factories) {
+            group.accumulators.push_back(factory(_expCtx.get()));
+        }
+        it = _groups.emplace(std::move(id), std::move(group)).first;
+    }
+
+    auto& group = it->second;
+    for (size_t i = 0; i < accumulatedFields.size(); ++i) {
+        Value input = accumulatedFields[i].expr.argument->evaluate(root, &variables);
+        if (isAdd) {
+            group.accumulators[i]->add(std::move(input));
+        } else {
+            group.accumulators[i]->remove(std::move(input));
+        }
+    }
+
+    group.numDocs += isAdd ? 1 : -1;
+    if (group.numDocs == 0) {
+        _groups.erase(it);
+    }
+}
+
+boost::optional<Document> MaterializedGroup::lookup(const Value& id) const {
+    auto it = _groups.find(id);
+    if (it == _groups.end()) {
+        return boost::none;
+    }
+
+    MutableDocument output;
+    output.addField("_id", it->first);
+
+    auto& accumulatedFields = _group->getAccumulatedFields();
+    for (size_t i = 0; i < accumulatedFields.size(); ++i) {
+        output.addField(accumulatedFields[i].fieldName, it->second.accumulators[i]->getValue());
+    }
+    return output.freeze();
+}
+
+}  // namespace mongo
@@ -0,0 +1,129 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/exec/document_value/value_comparator.h"
+#include "mongo/db/pipeline/document_source_group.h"
+#include "mongo/db/pipeline/document_source_match.h"
+#include "mongo/db/pipeline/expression_context.h"
+#include "mongo/db/pipeline/window_function/window_function.h"
+
+namespace mongo {
+
+/**
+ * The result of a $match -> $group pipeline over a collection, maintained incrementally as
+ * documents are inserted into, updated in and deleted from the collection.
+ *
+ * The defining pipeline consists of an optional $match stage followed by a $group stage whose
+ * accumulators are all decomposable, that is they can remove an input as well as add one. These
+ * are $sum, $count and $avg, which are backed by the removable window function states. Every
+ * group also counts its input documents, so that it disappears once its last input is removed.
+ *
+ * This class is not thread-safe.
+ */
+class MaterializedGroup {
+    MaterializedGroup(const MaterializedGroup&) = delete;
+    MaterializedGroup& operator=(const MaterializedGroup&) = delete;
+
+public:
+    /**
+     * Parses 'pipeline'. Throws if it is not a $match -> $group pipeline with decomposable
+     * accumulators.
+     */
+    MaterializedGroup(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                      std::vector<BSONObj> pipeline);
+
+    const std::vector<BSONObj>& getPipeline() const {
+        return _pipeline;
+    }
+
+    ExpressionContext* getExpressionContext() const {
+        return _expCtx.get();
+    }
+
+    /**
+     * Adds 'doc' to its group if it matches the $match stage.
+     */
+    void add(const BSONObj& doc) {
+        _apply(doc, true /* isAdd */);
+    }
+
+    /**
+     * Removes 'doc', which must have been added before, from its group.
+     */
+    void remove(const BSONObj& doc) {
+        _apply(doc, false /* isAdd */);
+    }
+
+    /**
+     * Removes all the groups.
+     */
+    void clear() {
+        _groups.clear();
+    }
+
+    /**
+     * Returns the $group output document for the group with the given '_id', or boost::none if
+     * no document in the collection belongs to the group.
+     */
+    boost::optional<Document> lookup(const Value& id) const;
+
+    size_t numGroups() const {
+        return _groups.size();
+    }
+
+private:
+    struct Group {
+        long long numDocs = 0;
+        std::vector<std::unique_ptr<WindowFunctionState>> accumulators;
+    };
+
+    void _apply(const BSONObj& doc, bool isAdd);
+
+    boost::intrusive_ptr<ExpressionContext> _expCtx;
+    std::vector<BSONObj> _pipeline;
+
+    boost::intrusive_ptr<DocumentSourceMatch> _match;
+    boost::intrusive_ptr<DocumentSourceGroup> _group;
+    boost::intrusive_ptr<Expression> _idExpression;
+
+    // One factory per accumulated field of '_group', in the same order.
+    std::vector<std::unique_ptr<WindowFunctionState> (*)(ExpressionContext*)> _factories;
+
+    ValueUnorderedMap<Group> _groups;
+};
+
+}  // namespace mongo
@@ -0,0 +1,306 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kQuery
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/materialized_group_catalog.h"
+
+#include "mongo/db/query/collation/collator_interface.h"
+#include "mongo/logv2/log.h"
+#include "mongo/util/str.h"
+#include "mongo/util/timer.h"
+
+namespace mongo {
+namespace {
+
+const auto getMaterializedGroupCatalog =
+    ServiceContext::declareDecoration<MaterializedGroupCatalog>();
+
+}  // namespace
+
+MaterializedGroupCatalog& MaterializedGroupCatalog::get(ServiceContext* serviceContext) {
+    return getMaterializedGroupCatalog(serviceContext);
+}
+
+MaterializedGroupCatalog& MaterializedGroupCatalog::get(OperationContext* opCtx) {
+    return get(opCtx->getServiceContext());
+}
+
+void MaterializedGroupCatalog::_scan(OperationContext* opCtx,
+                                     const CollectionPtr& collection,
+                                     MaterializedGroup* group) {
+    auto cursor = collection->getCursor(opCtx);
+    while (auto record = cursor->next()) {
+        group->add(record->data.toBson());
+    }
+}
+
+void MaterializedGroupCatalog::create(OperationContext* opCtx,
+                                      const CollectionPtr& collection,
+                                      const std::string& name,
+                                      std::vector<BSONObj> pipeline) {
+    auto expCtx = make_intrusive<ExpressionContext>(
+        opCtx,
+        CollatorInterface::cloneCollator(collection->getDefaultCollator()),
+        collection->ns());
+    expCtx->variables.setDefaultRuntimeConstants(opCtx);
+
+    auto group = std::make_unique<MaterializedGroup>(expCtx, std::move(pipeline));
+    _scan(opCtx, collection, group.get());
+
+    // Like a collection validator, the materialized group outlives the OperationContext it was
+    // created under.
+    expCtx->opCtx = nullptr;
+
+    auto entry = std::make_shared<Entry>(std::move(group));
+    entry->lastRefresh = Date_t::now();
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto& entries = _collections[collection->uuid()];
+    entries[name] = std::move(entry);
+    _numCollections.store(_collections.size());
+
+    LOGV2(7000126,
+          "Created materialized group",
+          "namespace"_attr = collection->ns(),
+          "name"_attr = name);
+}
+
+bool MaterializedGroupCatalog::drop(const UUID& uuid, StringData name) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto collIt = _collections.find(uuid);
+    if (collIt == _collections.end() || collIt->second.erase(name) == 0) {
+        return false;
+    }
+
+    if (collIt->second.empty()) {
+        _collections.erase(collIt);
+        _numCollections.store(_collections.size());
+    }
+    return true;
+}
+
+boost::optional<Document> MaterializedGroupCatalog::lookup(const UUID& uuid,
+                                                           StringData name,
+                                                           const Value& id) const {
+    std::shared_ptr<Entry> entry;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        auto collIt = _collections.find(uuid);
+        uassert(ErrorCodes::NamespaceNotFound,
+                str::stream() << "No materialized group named '" << name << "'",
+                collIt != _collections.end() && collIt->second.count(name));
+        entry = collIt->second.find(name)->second;
+    }
+
+    stdx::lock_guard<Latch> lk(entry->mutex);
+    uassert(7027516,
+            str::stream() << "The materialized group '" << name
+                          << "' may have missed writes to its collection and must be created again",
+            !entry->invalid);
+    return entry->group->lookup(id);
+}
+
+MaterializedGroupCatalog::Entries MaterializedGroupCatalog::_getEntries(const UUID& uuid) const {
+    if (_numCollections.load() == 0) {
+        return {};
+    }
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto collIt = _collections.find(uuid);
+    if (collIt == _collections.end()) {
+        return {};
+    }
+
+    Entries entries;
+    for (auto&& [_, entry] : collIt->second) {
+        entries.push_back(entry);
+    }
+    return entries;
+}
+
+void MaterializedGroupCatalog::_applyOnCommit(OperationContext* opCtx,
+                                              Entries entries,
+                                              long long numDeltas,
+                                              std::function<void(MaterializedGroup*)> fn) {
+    const auto writeTime = Date_t::now();
+    opCtx->recoveryUnit()->onCommit([entries = std::move(entries),
+                                     numDeltas,
+                                     fn = std::move(fn),
+                                     writeTime](boost::optional<Timestamp>) {
+        for (auto&& entry : entries) {
+            stdx::lock_guard<Latch> lk(entry->mutex);
+            if (entry->invalid) {
+                continue;
+            }
+
+            Timer timer;
+            try {
+                fn(entry->group.get());
+            } catch (const DBException& ex) {
+                // The materialized group may have been left half-updated.
+                LOGV2_WARNING(7000127,
+                              "Failed to maintain materialized group, marking it invalid",
+                              "error"_attr = ex.toStatus());
+                entry->invalid = true;
+            }
+
+            entry->deltasApplied += numDeltas;
+            entry->maintenanceTime += Microseconds(timer.micros());
+            entry->lastRefresh = Date_t::now();
+            entry->lastRefreshLag = entry->lastRefresh - writeTime;
+        }
+    });
+}
+
+void MaterializedGroupCatalog::onInserts(OperationContext* opCtx,
+                                         const UUID& uuid,
+                                         std::vector<BSONObj> docs) {
+    auto entries = _getEntries(uuid);
+    if (entries.empty()) {
+        return;
+    }
+
+    for (auto&& doc : docs) {
+        doc = doc.getOwned();
+    }
+    const auto numDeltas = static_cast<long long>(docs.size());
+    _applyOnCommit(
+        opCtx, std::move(entries), numDeltas, [docs = std::move(docs)](MaterializedGroup* group) {
+            for (auto&& doc : docs) {
+                group->add(doc);
+            }
+        });
+}
+
+void MaterializedGroupCatalog::onUpdate(OperationContext* opCtx,
+                                        const UUID& uuid,
+                                        const boost::optional<BSONObj>& preImageDoc,
+                                        const BSONObj& updatedDoc) {
+    auto entries = _getEntries(uuid);
+    if (entries.empty()) {
+        return;
+    }
+
+    if (!preImageDoc) {
+        // Without the pre-image there is no way to tell which group the document is leaving. Mark
+        // the materialized groups invalid right away rather than when the write commits, so that
+        // no read can miss the update, even if the write ends up aborting.
+        _markInvalid(entries);
+        return;
+    }
+
+    _applyOnCommit(opCtx,
+                   std::move(entries),
+                   1,
+                   [pre = preImageDoc->getOwned(),
+                    post = updatedDoc.getOwned()](MaterializedGroup* group) {
+                       group->remove(pre);
+                       group->add(post);
+                   });
+}
+
+void MaterializedGroupCatalog::onDelete(OperationContext* opCtx,
+                                        const UUID& uuid,
+                                        const BSONObj& doc) {
+    auto entries = _getEntries(uuid);
+    if (entries.empty()) {
+        return;
+    }
+
+    _applyOnCommit(opCtx, std::move(entries), 1, [doc = doc.getOwned()](MaterializedGroup* group) {
+        group->remove(doc);
+    });
+}
+
+void MaterializedGroupCatalog::onEmptyCapped(OperationContext* opCtx, const UUID& uuid) {
+    auto entries = _getEntries(uuid);
+    if (entries.empty()) {
+        return;
+    }
+
+    _applyOnCommit(
+        opCtx, std::move(entries), 1, [](MaterializedGroup* group) { group->clear(); });
+}
+
+void MaterializedGroupCatalog::onDropCollection(OperationContext* opCtx, const UUID& uuid) {
+    if (_getEntries(uuid).empty()) {
+        return;
+    }
+
+    opCtx->recoveryUnit()->onCommit([this, uuid](boost::optional<Timestamp>) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _collections.erase(uuid);
+        _numCollections.store(_collections.size());
+    });
+}
+
+void MaterializedGroupCatalog::_markInvalid(const Entries& entries) {
+    for (auto&& entry : entries) {
+        stdx::lock_guard<Latch> lk(entry->mutex);
+        entry->invalid = true;
+    }
+}
+
+void MaterializedGroupCatalog::markAllInvalid() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    for (auto&& [uuid, entries] : _collections) {
+        for (auto&& [name, entry] : entries) {
+            stdx::lock_guard<Latch> entryLk(entry->mutex);
+            entry->invalid = true;
+        }
+    }
+}
+
+void MaterializedGroupCatalog::appendCollectionStats(const UUID& uuid,
+                                                     BSONObjBuilder* builder) const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto collIt = _collections.find(uuid);
+    if (collIt == _collections.end()) {
+        return;
+    }
+
+    BSONObjBuilder groupsBob(builder->subobjStart("materializedGroups"));
+    for (auto&& [name, entry] : collIt->second) {
+        stdx::lock_guard<Latch> entryLk(entry->mutex);
+        BSONObjBuilder bob(groupsBob.subobjStart(name));
+        bob.append("pipeline", entry->group->getPipeline());
+        bob.append("invalid", entry->invalid);
+        bob.appendNumber("numGroups", static_cast<long long>(entry->group->numGroups()));
+        bob.appendNumber("deltasApplied", entry->deltasApplied);
+        bob.appendNumber("maintenanceMicros", durationCount<Microseconds>(entry->maintenanceTime));
+        bob.appendNumber("lastRefreshLagMillis",
+                         durationCount<Milliseconds>(entry->lastRefreshLag));
+        bob.appendDate("lastRefresh", entry->lastRefresh);
+    }
+}
+
+}  // namespace mongo
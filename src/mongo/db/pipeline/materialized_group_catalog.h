@@ -0,0 +1,172 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/pipeline/materialized_group.h"
+#include "mongo/db/service_context.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/string_map.h"
+#include "mongo/util/time_support.h"
+#include "mongo/util/uuid.h"
+
+namespace mongo {
+
+/**
+ * The materialized $group pipelines of all the collections, keyed by collection UUID and name.
+ *
+ * A materialized group is built from a scan of its collection and from then on kept up to date by
+ * the MaterializedGroupOpObserver, which hands every insert, update and delete to the catalog. The
+ * catalog applies the change to the materialized groups of the collection once the write commits,
+ * so that a read never observes the effect of a write which later aborts. A write whose effect
+ * cannot be determined, such as an update without a pre-image, marks the materialized groups of
+ * the collection invalid instead. Reading from an invalid materialized group fails until it is
+ * created again; it is never rebuilt implicitly, which would scan the whole collection with writes
+ * to it blocked.
+ *
+ * Materialized groups live in memory only, and have to be recreated after a restart. All methods
+ * are thread-safe.
+ */
+class MaterializedGroupCatalog {
+    MaterializedGroupCatalog(const MaterializedGroupCatalog&) = delete;
+    MaterializedGroupCatalog& operator=(const MaterializedGroupCatalog&) = delete;
+
+public:
+    MaterializedGroupCatalog() = default;
+
+    static MaterializedGroupCatalog& get(ServiceContext* serviceContext);
+    static MaterializedGroupCatalog& get(OperationContext* opCtx);
+
+    /**
+     * Creates the materialized group 'name' of 'collection' from 'pipeline', replacing any
+     * existing one with the same name. The caller must hold a lock which excludes writes to the
+     * collection, so that no write is missed between the scan and the registration.
+     */
+    void create(OperationContext* opCtx,
+                const CollectionPtr& collection,
+                const std::string& name,
+                std::vector<BSONObj> pipeline);
+
+    /**
+     * Drops the materialized group 'name' of the collection 'uuid'. Returns false if there is no
+     * such materialized group.
+     */
+    bool drop(const UUID& uuid, StringData name);
+
+    /**
+     * Looks up the group with the given '_id' in the materialized group 'name' of the collection
+     * 'uuid'. Throws if there is no such materialized group, or if it is invalid.
+     */
+    boost::optional<Document> lookup(const UUID& uuid, StringData name, const Value& id) const;
+
+    // Notifications from the OpObserver. These take effect when the current write unit of work
+    // commits.
+
+    void onInserts(OperationContext* opCtx, const UUID& uuid, std::vector<BSONObj> docs);
+    void onUpdate(OperationContext* opCtx,
+                  const UUID& uuid,
+                  const boost::optional<BSONObj>& preImageDoc,
+                  const BSONObj& updatedDoc);
+    void onDelete(OperationContext* opCtx, const UUID& uuid, const BSONObj& doc);
+    void onEmptyCapped(OperationContext* opCtx, const UUID& uuid);
+    void onDropCollection(OperationContext* opCtx, const UUID& uuid);
+
+    /**
+     * Marks all the materialized groups invalid, for example after a replication rollback.
+     */
+    void markAllInvalid();
+
+    /**
+     * Appends the state and maintenance statistics of the materialized groups of the collection
+     * 'uuid' to 'builder' as a 'materializedGroups' sub-object. Appends nothing if the collection
+     * has no materialized group.
+     */
+    void appendCollectionStats(const UUID& uuid, BSONObjBuilder* builder) const;
+
+private:
+    struct Entry {
+        explicit Entry(std::unique_ptr<MaterializedGroup> group) : group(std::move(group)) {}
+
+        mutable Mutex mutex = MONGO_MAKE_LATCH("MaterializedGroupCatalog::Entry::mutex");
+        std::unique_ptr<MaterializedGroup> group;
+        bool invalid = false;
+
+        // Maintenance statistics.
+        long long deltasApplied = 0;
+        Microseconds maintenanceTime{0};
+        Milliseconds lastRefreshLag{0};
+        Date_t lastRefresh;
+    };
+
+    using Entries = std::vector<std::shared_ptr<Entry>>;
+
+    /**
+     * Returns the materialized groups of the collection 'uuid'.
+     */
+    Entries _getEntries(const UUID& uuid) const;
+
+    /**
+     * Applies 'fn' to the materialized group of every entry in 'entries' once the current write
+     * unit of work commits, and accounts for the time it takes. Marks an entry invalid if 'fn'
+     * throws.
+     */
+    void _applyOnCommit(OperationContext* opCtx,
+                        Entries entries,
+                        long long numDeltas,
+                        std::function<void(MaterializedGroup*)> fn);
+
+    /**
+     * Marks every entry in 'entries' invalid.
+     */
+    static void _markInvalid(const Entries& entries);
+
+    static void _scan(OperationContext* opCtx,
+                      const CollectionPtr& collection,
+                      MaterializedGroup* group);
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("MaterializedGroupCatalog::_mutex");
+
+    // The number of collections with materialized groups, so that writes to other collections need
+    // not take the mutex while there are none.
+    AtomicWord<size_t> _numCollections{0};
+
+    stdx::unordered_map<UUID, StringMap<std::shared_ptr<Entry>>, UUID::Hash> _collections;
+};
+
+}  // namespace mongo
@@ -0,0 +1,183 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/json.h"
+#include "mongo/db/catalog/catalog_test_fixture.h"
+#include "mongo/db/db_raii.h"
+#include "mongo/db/exec/document_value/document_value_test_util.h"
+#include "mongo/db/pipeline/materialized_group_catalog.h"
+#include "mongo/db/repl/storage_interface.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+class MaterializedGroupCatalogTest : public CatalogTestFixture {
+protected:
+    MaterializedGroupCatalogTest() : CatalogTestFixture(Options{}.engine("ephemeralForTest")) {}
+
+    void setUp() override {
+        CatalogTestFixture::setUp();
+        ASSERT_OK(
+            storageInterface()->createCollection(operationContext(), _nss, CollectionOptions()));
+        ASSERT_OK(storageInterface()->insertDocuments(
+            operationContext(),
+            _nss,
+            {InsertStatement(fromjson("{_id: 1, tenant: 'a', amount: 2}")),
+             InsertStatement(fromjson("{_id: 2, tenant: 'a', amount: 4}")),
+             InsertStatement(fromjson("{_id: 3, tenant: 'b', amount: 1}"))}));
+
+        AutoGetCollection collection(operationContext(), _nss, MODE_S);
+        _uuid = collection->uuid();
+        catalog().create(operationContext(),
+                         collection.getCollection(),
+                         "byTenant",
+                         {fromjson("{$group: {_id: '$tenant', total: {$sum: '$amount'}}}")});
+    }
+
+    MaterializedGroupCatalog& catalog() {
+        return MaterializedGroupCatalog::get(operationContext());
+    }
+
+    Value total(StringData tenant) {
+        auto group = catalog().lookup(_uuid, "byTenant", Value(tenant));
+        return group ? (*group)["total"] : Value();
+    }
+
+    const NamespaceString _nss{"test", "materialized_group_catalog"};
+    UUID _uuid = UUID::gen();
+};
+
+TEST_F(MaterializedGroupCatalogTest, CreateScansTheCollection) {
+    ASSERT_VALUE_EQ(total("a"), Value(6));
+    ASSERT_VALUE_EQ(total("b"), Value(1));
+}
+
+TEST_F(MaterializedGroupCatalogTest, AppliesWritesOnlyWhenTheyCommit) {
+    auto opCtx = operationContext();
+    {
+        AutoGetCollection collection(opCtx, _nss, MODE_IX);
+        WriteUnitOfWork wuow(opCtx);
+        catalog().onInserts(opCtx, _uuid, {fromjson("{_id: 4, tenant: 'b', amount: 10}")});
+        catalog().onDelete(opCtx, _uuid, fromjson("{_id: 1, tenant: 'a', amount: 2}"));
+
+        // Nothing is applied before the write commits.
+        ASSERT_VALUE_EQ(total("a"), Value(6));
+        ASSERT_VALUE_EQ(total("b"), Value(1));
+        wuow.commit();
+    }
+    ASSERT_VALUE_EQ(total("a"), Value(4));
+    ASSERT_VALUE_EQ(total("b"), Value(11));
+
+    {
+        AutoGetCollection collection(opCtx, _nss, MODE_IX);
+        WriteUnitOfWork wuow(opCtx);
+        catalog().onUpdate(opCtx,
+                           _uuid,
+                           fromjson("{_id: 2, tenant: 'a', amount: 4}"),
+                           fromjson("{_id: 2, tenant: 'b', amount: 4}"));
+        // Abort the write.
+    }
+    ASSERT_VALUE_EQ(total("a"), Value(4));
+    ASSERT_VALUE_EQ(total("b"), Value(11));
+}
+
+TEST_F(MaterializedGroupCatalogTest, UpdateMovesDocumentBetweenGroups) {
+    auto opCtx = operationContext();
+    {
+        AutoGetCollection collection(opCtx, _nss, MODE_IX);
+        WriteUnitOfWork wuow(opCtx);
+        catalog().onUpdate(opCtx,
+                           _uuid,
+                           fromjson("{_id: 2, tenant: 'a', amount: 4}"),
+                           fromjson("{_id: 2, tenant: 'b', amount: 5}"));
+        wuow.commit();
+    }
+
+    ASSERT_VALUE_EQ(total("a"), Value(2));
+    ASSERT_VALUE_EQ(total("b"), Value(6));
+}
+
+TEST_F(MaterializedGroupCatalogTest, UpdateWithoutPreImageInvalidatesUntilCreatedAgain) {
+    auto opCtx = operationContext();
+    {
+        AutoGetCollection collection(opCtx, _nss, MODE_IX);
+        WriteUnitOfWork wuow(opCtx);
+        catalog().onUpdate(opCtx, _uuid, boost::none, fromjson("{_id: 2, tenant: 'b', amount: 4}"));
+
+        // The materialized group is invalid as soon as the update happens, not only once the write
+        // commits, and it is not rebuilt on a read.
+        ASSERT_THROWS_CODE(total("a"), DBException, 7027516);
+        wuow.commit();
+    }
+    ASSERT_THROWS_CODE(total("a"), DBException, 7027516);
+
+    BSONObjBuilder stats;
+    catalog().appendCollectionStats(_uuid, &stats);
+    ASSERT_TRUE(stats.obj()["materializedGroups"]["byTenant"]["invalid"].trueValue());
+
+    // Writes to an invalid materialized group are ignored.
+    {
+        AutoGetCollection collection(opCtx, _nss, MODE_IX);
+        WriteUnitOfWork wuow(opCtx);
+        catalog().onInserts(opCtx, _uuid, {fromjson("{_id: 4, tenant: 'a', amount: 1}")});
+        wuow.commit();
+    }
+    ASSERT_THROWS_CODE(total("a"), DBException, 7027516);
+
+    // Creating the materialized group again scans the collection.
+    AutoGetCollection collection(opCtx, _nss, MODE_S);
+    catalog().create(opCtx,
+                     collection.getCollection(),
+                     "byTenant",
+                     {fromjson("{$group: {_id: '$tenant', total: {$sum: '$amount'}}}")});
+    ASSERT_VALUE_EQ(total("a"), Value(6));
+}
+
+TEST_F(MaterializedGroupCatalogTest, MarkAllInvalidInvalidatesEveryMaterializedGroup) {
+    catalog().markAllInvalid();
+    ASSERT_THROWS_CODE(total("a"), DBException, 7027516);
+}
+
+TEST_F(MaterializedGroupCatalogTest, DroppingTheCollectionDropsItsMaterializedGroups) {
+    auto opCtx = operationContext();
+    {
+        AutoGetCollection collection(opCtx, _nss, MODE_IX);
+        WriteUnitOfWork wuow(opCtx);
+        catalog().onDropCollection(opCtx, _uuid);
+        wuow.commit();
+    }
+    ASSERT_THROWS_CODE(total("a"), DBException, ErrorCodes::NamespaceNotFound);
+}
+
+}  // namespace
+}  // namespace mongo
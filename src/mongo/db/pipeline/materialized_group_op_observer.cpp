@@ -0,0 +1,108 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/materialized_group_op_observer.h"
+
+#include "mongo/db/pipeline/materialized_group_catalog.h"
+
+namespace mongo {
+
+void MaterializedGroupOpObserver::onInserts(OperationContext* opCtx,
+                                            const NamespaceString& nss,
+                                            const UUID& uuid,
+                                            std::vector<InsertStatement>::const_iterator first,
+                                            std::vector<InsertStatement>::const_iterator last,
+                                            bool fromMigrate) {
+    std::vector<BSONObj> docs;
+    docs.reserve(std::distance(first, last));
+    for (auto it = first; it != last; ++it) {
+        docs.push_back(it->doc);
+    }
+    MaterializedGroupCatalog::get(opCtx).onInserts(opCtx, uuid, std::move(docs));
+}
+
+void MaterializedGroupOpObserver::onUpdate(OperationContext* opCtx,
+                                           const OplogUpdateEntryArgs& args) {
+    MaterializedGroupCatalog::get(opCtx).onUpdate(
+        opCtx, args.uuid, args.updateArgs->preImageDoc, args.updateArgs->updatedDoc);
+}
+
+void MaterializedGroupOpObserver::aboutToDelete(OperationContext* opCtx,
+                                                const NamespaceString& nss,
+                                                const UUID& uuid,
+                                                const BSONObj& doc) {
+    MaterializedGroupCatalog::get(opCtx).onDelete(opCtx, uuid, doc);
+}
+
+void MaterializedGroupOpObserver::onEmptyCapped(OperationContext* opCtx,
+                                                const NamespaceString& collectionName,
+                                                const UUID& uuid) {
+    MaterializedGroupCatalog::get(opCtx).onEmptyCapped(opCtx, uuid);
+}
+
+repl::OpTime MaterializedGroupOpObserver::onDropCollection(OperationContext* opCtx,
+                                                           const NamespaceString& collectionName,
+                                                           const UUID& uuid,
+                                                           std::uint64_t numRecords,
+                                                           CollectionDropType dropType) {
+    MaterializedGroupCatalog::get(opCtx).onDropCollection(opCtx, uuid);
+    return {};
+}
+
+void MaterializedGroupOpObserver::onRenameCollection(OperationContext* opCtx,
+                                                     const NamespaceString& fromCollection,
+                                                     const NamespaceString& toCollection,
+                                                     const UUID& uuid,
+                                                     const boost::optional<UUID>& dropTargetUUID,
+                                                     std::uint64_t numRecords,
+                                                     bool stayTemp) {
+    postRenameCollection(opCtx, fromCollection, toCollection, uuid, dropTargetUUID, stayTemp);
+}
+
+void MaterializedGroupOpObserver::postRenameCollection(OperationContext* opCtx,
+                                                       const NamespaceString& fromCollection,
+                                                       const NamespaceString& toCollection,
+                                                       const UUID& uuid,
+                                                       const boost::optional<UUID>& dropTargetUUID,
+                                                       bool stayTemp) {
+    // Materialized groups are keyed by UUID, so they follow the renamed collection. Only the
+    // materialized groups of a dropped target go away.
+    if (dropTargetUUID) {
+        MaterializedGroupCatalog::get(opCtx).onDropCollection(opCtx, *dropTargetUUID);
+    }
+}
+
+void MaterializedGroupOpObserver::_onReplicationRollback(OperationContext* opCtx,
+                                                        const RollbackObserverInfo& rbInfo) {
+    MaterializedGroupCatalog::get(opCtx).markAllInvalid();
+}
+
+}  // namespace mongo
@@ -0,0 +1,158 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/json.h"
+#include "mongo/db/exec/document_value/document_value_test_util.h"
+#include "mongo/db/pipeline/aggregation_context_fixture.h"
+#include "mongo/db/pipeline/materialized_group.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using MaterializedGroupTest = AggregationContextFixture;
+
+TEST_F(MaterializedGroupTest, MaintainsGroupsAcrossAddsAndRemoves) {
+    MaterializedGroup group(getExpCtx(),
+                            {fromjson("{$match: {status: 'ok'}}"),
+                             fromjson("{$group: {_id: '$tenant', n: {$count: {}}, "
+                                      "total: {$sum: '$amount'}, mean: {$avg: '$amount'}}}")});
+
+    group.add(fromjson("{tenant: 'a', status: 'ok', amount: 2}"));
+    group.add(fromjson("{tenant: 'a', status: 'ok', amount: 4}"));
+    group.add(fromjson("{tenant: 'a', status: 'failed', amount: 100}"));
+    group.add(fromjson("{tenant: 'b', status: 'ok', amount: 1}"));
+    ASSERT_EQ(group.numGroups(), 2U);
+
+    auto a = group.lookup(Value("a"_sd));
+    ASSERT(a);
+    ASSERT_DOCUMENT_EQ(*a, Document(fromjson("{_id: 'a', n: 2, total: 6, mean: 3.0}")));
+
+    group.remove(fromjson("{tenant: 'a', status: 'ok', amount: 4}"));
+    a = group.lookup(Value("a"_sd));
+    ASSERT(a);
+    ASSERT_DOCUMENT_EQ(*a, Document(fromjson("{_id: 'a', n: 1, total: 2, mean: 2.0}")));
+
+    // Removing a document which does not match the $match stage has no effect.
+    group.remove(fromjson("{tenant: 'a', status: 'failed', amount: 100}"));
+    ASSERT_EQ(group.numGroups(), 2U);
+
+    // A group disappears with its last document.
+    group.remove(fromjson("{tenant: 'b', status: 'ok', amount: 1}"));
+    ASSERT_FALSE(group.lookup(Value("b"_sd)));
+    ASSERT_EQ(group.numGroups(), 1U);
+}
+
+TEST_F(MaterializedGroupTest, PutsDocumentsWithMissingKeyInNullGroup) {
+    MaterializedGroup group(getExpCtx(), {fromjson("{$group: {_id: '$k', n: {$sum: 1}}}")});
+
+    group.add(fromjson("{x: 1}"));
+    group.add(fromjson("{k: null}"));
+
+    auto nullGroup = group.lookup(Value(BSONNULL));
+    ASSERT(nullGroup);
+    ASSERT_DOCUMENT_EQ(*nullGroup, Document(fromjson("{_id: null, n: 2}")));
+}
+
+TEST_F(MaterializedGroupTest, SupportsCompoundGroupKeys) {
+    MaterializedGroup group(getExpCtx(),
+                            {fromjson("{$group: {_id: {t: '$tenant', d: '$day'}, n: {$sum: 1}}}")});
+
+    group.add(fromjson("{tenant: 'a', day: 1}"));
+    group.add(fromjson("{tenant: 'a', day: 2}"));
+    group.add(fromjson("{tenant: 'a', day: 1}"));
+
+    auto key = Value(Document(fromjson("{t: 'a', d: 1}")));
+    auto result = group.lookup(key);
+    ASSERT(result);
+    ASSERT_VALUE_EQ((*result)["n"], Value(2));
+}
+
+TEST_F(MaterializedGroupTest, RejectsNonDecomposableAccumulators) {
+    ASSERT_THROWS_CODE(
+        MaterializedGroup(getExpCtx(), {fromjson("{$group: {_id: '$k', m: {$max: '$v'}}}")}),
+        DBException,
+        7000124);
+}
+
+TEST_F(MaterializedGroupTest, RejectsPipelinesOfOtherShapes) {
+    ASSERT_THROWS_CODE(MaterializedGroup(getExpCtx(), {fromjson("{$match: {a: 1}}")}),
+                       DBException,
+                       7000122);
+    ASSERT_THROWS_CODE(MaterializedGroup(getExpCtx(),
+                                         {fromjson("{$group: {_id: '$k'}}"),
+                                          fromjson("{$match: {a: 1}}")}),
+                       DBException,
+                       7000122);
+    ASSERT_THROWS_CODE(MaterializedGroup(getExpCtx(), {}), DBException, 7000121);
+}
+
+TEST_F(MaterializedGroupTest, RejectsRandomGroupKeys) {
+    ASSERT_THROWS_CODE(
+        MaterializedGroup(getExpCtx(), {fromjson("{$group: {_id: {$rand: {}}, n: {$sum: 1}}}")}),
+        DBException,
+        7000123);
+}
+
+TEST_F(MaterializedGroupTest, RejectsNonDeterministicMatch) {
+    const auto group = fromjson("{$group: {_id: '$k', n: {$sum: 1}}}");
+    ASSERT_THROWS_CODE(
+        MaterializedGroup(getExpCtx(), {fromjson("{$match: {$sampleRate: 0.5}}"), group}),
+        DBException,
+        7000123);
+    ASSERT_THROWS_CODE(
+        MaterializedGroup(getExpCtx(),
+                          {fromjson("{$match: {$expr: {$lt: ['$ts', '$$NOW']}}}"), group}),
+        DBException,
+        7000123);
+}
+
+TEST_F(MaterializedGroupTest, RejectsTimeDependentAccumulatorInputs) {
+    ASSERT_THROWS_CODE(
+        MaterializedGroup(getExpCtx(),
+                          {fromjson("{$group: {_id: '$k', t: {$sum: {$toLong: '$$NOW'}}}}")}),
+        DBException,
+        7000123);
+    const auto clusterTimeKey = fromjson("{$group: {_id: '$$CLUSTER_TIME', n: {$sum: 1}}}");
+    ASSERT_THROWS_CODE(MaterializedGroup(getExpCtx(), {clusterTimeKey}), DBException, 7000123);
+}
+
+TEST_F(MaterializedGroupTest, RejectsJavaScript) {
+    ASSERT_THROWS_CODE(
+        MaterializedGroup(getExpCtx(),
+                          {fromjson("{$group: {_id: {$function: {body: 'function() {return 1;}', "
+                                    "args: [], lang: 'js'}}, n: {$sum: 1}}}")}),
+        DBException,
+        7000123);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -552,6 +552,16 @@ boost::optional<Document> Pipeline::getNext() {
                               : boost::optional<Document>{nextResult.releaseDocument()};
 }
 
+bool Pipeline::getNextBatch(std::vector<Document>* batch, size_t maxBatchSize) {
+    invariant(!_sources.empty());
+    auto status = _sources.back()->getNextBatch(batch, maxBatchSize);
+    while (status == DocumentSource::GetNextResult::ReturnStatus::kPauseExecution &&
+           batch->size() < maxBatchSize) {
+        status = _sources.back()->getNextBatch(batch, maxBatchSize);
+    }
+    return status != DocumentSource::GetNextResult::ReturnStatus::kEOF;
+}
+
 vector<Value> Pipeline::writeExplainOps(ExplainOptions::Verbosity verbosity) const {
     vector<Value> array;
     for (auto&& stage : _sources) {
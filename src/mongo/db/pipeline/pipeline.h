@@ -322,6 +322,13 @@ public:
      */
     boost::optional<Document> getNext();
 
+    /**
+     * Batched form of getNext(). Appends up to 'maxBatchSize' results to 'batch', which must hold
+     * fewer than 'maxBatchSize' documents, and returns false if the pipeline reached EOF after
+     * them.
+     */
+    bool getNextBatch(std::vector<Document>* batch, size_t maxBatchSize);
+
     /**
      * Write the pipeline's operators to a std::vector<Value>, providing the level of detail
      * specified by 'verbosity'.
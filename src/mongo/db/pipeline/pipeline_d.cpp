@@ -57,6 +57,7 @@
 #include "mongo/db/exec/unpack_timeseries_bucket.h"
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/index/index_access_method.h"
+#include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/matcher/expression_expr.h"
 #include "mongo/db/matcher/extensions_callback_real.h"
 #include "mongo/db/namespace_string.h"
@@ -71,10 +72,12 @@
 #include "mongo/db/pipeline/document_source_internal_unpack_bucket.h"
 #include "mongo/db/pipeline/document_source_lookup.h"
 #include "mongo/db/pipeline/document_source_match.h"
+#include "mongo/db/pipeline/document_source_merge.h"
 #include "mongo/db/pipeline/document_source_sample.h"
 #include "mongo/db/pipeline/document_source_sample_from_random_cursor.h"
 #include "mongo/db/pipeline/document_source_single_document_transformation.h"
 #include "mongo/db/pipeline/document_source_sort.h"
+#include "mongo/db/pipeline/document_source_streaming_group.h"
 #include "mongo/db/pipeline/inner_pipeline_stage_impl.h"
 #include "mongo/db/pipeline/pipeline.h"
 #include "mongo/db/pipeline/skip_and_limit.h"
@@ -99,6 +102,7 @@
 #include "mongo/db/timeseries/timeseries_gen.h"
 #include "mongo/rpc/metadata/client_metadata.h"
 #include "mongo/s/query/document_source_merge_cursors.h"
+#include "mongo/util/md5.hpp"
 #include "mongo/util/time_support.h"
 
 namespace mongo {
@@ -126,6 +130,13 @@ namespace {
  *    - When the 'featureFlagSBELookupPushdown' feature flag is 'true'.
  *    - The $lookup uses only the 'localField'/'foreignField' syntax (no pipelines).
  *    - The foreign collection is neither sharded nor a view.
+ *    - When the $lookup has absorbed an $unwind of its "as" field, the
+ *      'internalQuerySlotBasedExecutionDisableLookupUnwindPushdown' query knob is 'false'.
+ *
+ * The prefix ends at the first other stage. In particular $project, $replaceRoot, a standalone
+ * $unwind and $setWindowFields are not pushed down: 'QueryPlanner::extendWithAggPipeline()' only
+ * has solution nodes for $group and $lookup, so they and every stage after them run in the classic
+ * engine.
  */
 std::vector<std::unique_ptr<InnerPipelineStageInterface>> extractSbeCompatibleStagesForPushdown(
     const intrusive_ptr<ExpressionContext>& expCtx,
@@ -192,7 +203,9 @@ std::vector<std::unique_ptr<InnerPipelineStageInterface>> extractSbeCompatibleSt
 
         // $lookup pushdown logic.
         if (auto lookupStage = dynamic_cast<DocumentSourceLookUp*>(itr->get())) {
-            if (disallowLookupPushdown) {
+            if (disallowLookupPushdown ||
+                (lookupStage->getUnwindSource() &&
+                 internalQuerySlotBasedExecutionDisableLookupUnwindPushdown.load())) {
                 break;
             }
 
@@ -248,7 +261,8 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> attemptToGetExe
     const AggregateCommandRequest* aggRequest,
     const QueryPlannerParams& plannerOpts,
     const MatchExpressionParser::AllowedFeatureSet& matcherFeatures,
-    Pipeline* pipeline) {
+    Pipeline* pipeline,
+    boost::optional<BSONObj> resumeAfter = boost::none) {
     auto findCommand = std::make_unique<FindCommandRequest>(nss);
     query_request_helper::setTailableMode(expCtx->tailableMode, findCommand.get());
     findCommand->setFilter(queryObj.getOwned());
@@ -267,6 +281,16 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> attemptToGetExe
         findCommand->setHint(aggRequest->getHint().value_or(BSONObj()).getOwned());
     }
 
+    // Scanning in RecordId order lets a checkpointed $merge record how far the scan has got, and
+    // continue from there after an interruption.
+    if (resumeAfter) {
+        findCommand->setHint(BSON(query_request_helper::kNaturalSortField << 1));
+        findCommand->setRequestResumeToken(true);
+        if (!resumeAfter->isEmpty()) {
+            findCommand->setResumeAfter(resumeAfter->getOwned());
+        }
+    }
+
     // The collation on the ExpressionContext has been resolved to either the user-specified
     // collation or the collection default. This BSON should never be empty even if the resolved
     // collator is simple.
@@ -910,6 +934,147 @@ auto buildProjectionForPushdown(const DepsTracker& deps,
         return BSONObj();
     return deps.toProjectionWithoutMetadata();
 }
+
+/**
+ * The sort to request from the query layer so that a $group can run as a streaming group, along
+ * with the positions of the group's id fields which are monotonic in that sort.
+ */
+struct StreamingGroupIndexOrder {
+    BSONObj sortObj;
+    std::vector<size_t> monotonicIdFields;
+};
+
+/**
+ * Looks for a ready index whose order keeps every batch of 'groupStage' contiguous, that is an
+ * index whose leading field at least one of the group's id fields is monotonic in. The leading
+ * field must not be multikey, and the index must be neither sparse nor partial so that it holds
+ * every document. To avoid trading a selective plan for a scan of the whole index, each top-level
+ * field of the query predicate must also be a field of the index.
+ */
+boost::optional<StreamingGroupIndexOrder> findIndexOrderForStreamingGroup(
+    const intrusive_ptr<ExpressionContext>& expCtx,
+    const CollectionPtr& collection,
+    const BSONObj& queryObj,
+    DocumentSourceGroup* groupStage) {
+    if (!collection) {
+        return boost::none;
+    }
+
+    for (auto&& elem : queryObj) {
+        if (elem.fieldNameStringData().startsWith("$"_sd)) {
+            return boost::none;
+        }
+    }
+
+    auto opCtx = expCtx->opCtx;
+    auto ii = collection->getIndexCatalog()->getIndexIterator(
+        opCtx, IndexCatalog::InclusionPolicy::kReady);
+    while (ii->more()) {
+        const IndexCatalogEntry* ice = ii->next();
+        const IndexDescriptor* desc = ice->descriptor();
+        if (desc->hidden() || desc->isSparse() || desc->isPartial() ||
+            desc->getIndexType() != IndexType::INDEX_BTREE) {
+            continue;
+        }
+        if (!CollatorInterface::collatorsMatch(ice->getCollator(), expCtx->getCollator())) {
+            continue;
+        }
+
+        const BSONObj& keyPattern = desc->keyPattern();
+        if (!std::all_of(queryObj.begin(), queryObj.end(), [&](const BSONElement& elem) {
+                return keyPattern.hasField(elem.fieldNameStringData());
+            })) {
+            continue;
+        }
+
+        StringData leadingField = keyPattern.firstElementFieldNameStringData();
+        if (isAnyComponentOfPathMultikey(keyPattern,
+                                         ice->isMultikey(opCtx, collection),
+                                         ice->getMultikeyPaths(opCtx, collection),
+                                         leadingField)) {
+            continue;
+        }
+
+        const FieldPath sortedFieldPath(leadingField);
+        const auto& idFields = groupStage->getMutableIdFields();
+        std::vector<size_t> monotonicIdFields;
+        for (size_t i = 0; i < idFields.size(); ++i) {
+            auto monotonicState = idFields[i]->getMonotonicState(sortedFieldPath);
+            if (monotonicState == monotonic::State::Increasing ||
+                monotonicState == monotonic::State::Decreasing) {
+                monotonicIdFields.push_back(i);
+            }
+        }
+        if (monotonicIdFields.empty()) {
+            continue;
+        }
+
+        return StreamingGroupIndexOrder{BSON(leadingField << 1), std::move(monotonicIdFields)};
+    }
+    return boost::none;
+}
+
+/**
+ * Returns the $merge stage which ends 'pipeline' if that stage records checkpoints, or nullptr
+ * otherwise.
+ */
+DocumentSourceMerge* getCheckpointedMerge(const Pipeline* pipeline) {
+    const auto& sources = pipeline->getSources();
+    if (sources.empty()) {
+        return nullptr;
+    }
+    auto merge = dynamic_cast<DocumentSourceMerge*>(sources.back().get());
+    return merge && merge->getCheckpointId() ? merge : nullptr;
+}
+
+/**
+ * Returns a digest of the serialized 'pipeline', which tells a checkpointed $merge whether a
+ * checkpoint was recorded by the same aggregation.
+ */
+std::string hashCheckpointedPipeline(const Pipeline* pipeline) {
+    md5_state_t state;
+    md5_init(&state);
+    for (auto&& stage : pipeline->serializeToBson()) {
+        md5_append(&state, reinterpret_cast<const md5_byte_t*>(stage.objdata()), stage.objsize());
+    }
+    md5digest digest;
+    md5_finish(&state, digest);
+    return digestToString(digest);
+}
+
+/**
+ * Returns the '$_resumeAfter' token for a forward scan of 'collection' which continues after the
+ * position recorded in 'resumeAfter'. The record at that position may have been deleted since the
+ * checkpoint was taken, in which case the scan continues after the closest record before it, or
+ * from the start of the collection if there is none. Resuming at the deleted record itself would
+ * fail with KeyNotFound on every attempt.
+ */
+BSONObj resolveCheckpointedResumeToken(OperationContext* opCtx,
+                                       const CollectionPtr& collection,
+                                       const BSONObj& resumeAfter) {
+    if (resumeAfter.isEmpty() || !collection) {
+        return resumeAfter;
+    }
+
+    const auto recordId = RecordId::deserializeToken(resumeAfter.firstElement());
+    auto cursor = collection->getCursor(opCtx, false /* forward */);
+
+    // seekNear() may position the cursor on either side of 'recordId'.
+    auto record = cursor->seekNear(recordId);
+    if (record && record->id == recordId) {
+        return resumeAfter;
+    }
+    while (record && record->id > recordId) {
+        record = cursor->next();
+    }
+    if (!record) {
+        return BSONObj();
+    }
+
+    BSONObjBuilder token;
+    record->id.serializeToken("$recordId", &token);
+    return token.obj();
+}
 }  // namespace
 
 boost::optional<std::pair<PipelineD::IndexSortOrderAgree, PipelineD::IndexOrderedByMinTime>>
@@ -1479,12 +1644,20 @@ PipelineD::buildInnerQueryExecutorGeneric(const MultipleCollectionAccessor& coll
         (pipeline->peekFront() && pipeline->peekFront()->constraints().isChangeStreamStage()) ||
         (aggRequest && aggRequest->getRequestReshardingResumeToken());
 
+    // A checkpointed $merge reads the RecordId of the last document it wrote from its metadata.
+    const bool attachRecordIds = getCheckpointedMerge(pipeline) != nullptr;
+
     auto attachExecutorCallback =
-        [cursorType, trackOplogTS](const MultipleCollectionAccessor& collections,
-                                   std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> exec,
-                                   Pipeline* pipeline) {
-            auto cursor = DocumentSourceCursor::create(
-                collections, std::move(exec), pipeline->getContext(), cursorType, trackOplogTS);
+        [cursorType, trackOplogTS, attachRecordIds](
+            const MultipleCollectionAccessor& collections,
+            std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> exec,
+            Pipeline* pipeline) {
+            auto cursor = DocumentSourceCursor::create(collections,
+                                                       std::move(exec),
+                                                       pipeline->getContext(),
+                                                       cursorType,
+                                                       trackOplogTS,
+                                                       attachRecordIds);
             pipeline->addInitialSource(std::move(cursor));
         };
     return std::make_pair(std::move(attachExecutorCallback), std::move(exec));
@@ -1583,6 +1756,50 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> PipelineD::prep
                                 QueryPlannerParams::ASSERT_MIN_TS_HAS_NOT_FALLEN_OFF_OPLOG);
     }
 
+    // Aggregations do not promise any order without a $sort, so their collection scans may join
+    // the concurrent scans of the same collection.
+    if (!isChangeStream && expCtx->tailableMode == TailableModeEnum::kNormal &&
+        internalQueryEnableSharedCollectionScans.load()) {
+        plannerOpts.options |= QueryPlannerParams::SHARE_COLLECTION_SCANS;
+    }
+
+    // A $merge which records checkpoints resumes a collection scan from the last RecordId it wrote.
+    // This is only correct if every source document maps to at most one output document, in the
+    // order of the scan, so only $match and single document transformations may precede it.
+    boost::optional<BSONObj> resumeAfter;
+    if (auto merge = getCheckpointedMerge(pipeline)) {
+        const auto& sources = pipeline->getSources();
+        const bool onlyPerDocumentStages =
+            std::all_of(sources.begin(), std::prev(sources.end()), [](const auto& stage) {
+                return dynamic_cast<DocumentSourceMatch*>(stage.get()) ||
+                    dynamic_cast<DocumentSourceSingleDocumentTransformation*>(stage.get());
+            });
+        uassert(7027004,
+                str::stream() << DocumentSourceMerge::kStageName
+                              << " with a 'checkpointId' may only follow $match and projection "
+                                 "stages",
+                onlyPerDocumentStages && !sortStage && !rewrittenGroupStage &&
+                    !skipThenLimit.getSkip() && !skipThenLimit.getLimit());
+        uassert(7027005,
+                str::stream() << DocumentSourceMerge::kStageName
+                              << " with a 'checkpointId' cannot be combined with a hint",
+                !(aggRequest && aggRequest->getHint()));
+
+        // A checkpoint records a RecordId, which must still designate the same document after a
+        // failover or on a node which went through an initial sync. Only the RecordIds of a
+        // clustered collection are derived from the documents themselves and hence the same on
+        // every node.
+        const auto& collection = collections.getMainCollection();
+        uassert(7027515,
+                str::stream() << DocumentSourceMerge::kStageName
+                              << " with a 'checkpointId' requires a collection clustered by _id",
+                !collection || collection->isClustered());
+        resumeAfter = resolveCheckpointedResumeToken(
+            expCtx->opCtx,
+            collections.getMainCollection(),
+            merge->getCheckpointedResumeToken(hashCheckpointedPipeline(pipeline)));
+    }
+
     // If there is a sort stage eligible for pushdown, serialize its SortPattern to a BSONObj. The
     // BSONObj format is currently necessary to request that the sort is computed by the query layer
     // inside the inner PlanExecutor. We also remove the $sort stage from the Pipeline, since it
@@ -1685,6 +1902,57 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> PipelineD::prep
         }
     }
 
+    // If the pipeline begins with a $group whose key follows the order of an index, ask the query
+    // layer for that order and turn the $group into a streaming group, which only holds one batch
+    // of groups in memory and produces results before the scan finishes. The sort is requested
+    // with STRICT_NON_BLOCKING_SORT, so if no plan gets it from an index we fall back to planning
+    // without it. A $group which will be pushed down to SBE is left alone.
+    auto groupStage = dynamic_cast<DocumentSourceGroup*>(pipeline->peekFront());
+    const bool groupGoesToSbe = groupStage && groupStage->sbeCompatible() &&
+        serverGlobalParams.featureCompatibility.isVersionInitialized() &&
+        feature_flags::gFeatureFlagSBEGroupPushdown.isEnabled(
+            serverGlobalParams.featureCompatibility) &&
+        !internalQuerySlotBasedExecutionDisableGroupPushdown.load();
+    if (groupStage && !groupGoesToSbe && !groupStage->doingMerge() && !sortStage &&
+        !skipThenLimit.getSkip() && !skipThenLimit.getLimit() && !isChangeStream &&
+        !(aggRequest && aggRequest->getHint()) &&
+        internalQueryEnableStreamingGroupFromIndexOrder.load()) {
+        if (auto indexOrder = findIndexOrderForStreamingGroup(
+                expCtx, collections.getMainCollection(), queryObj, groupStage)) {
+            QueryPlannerParams sortedPlannerOpts = plannerOpts;
+            sortedPlannerOpts.options |= QueryPlannerParams::STRICT_NON_BLOCKING_SORT;
+            auto swExecutorSorted = attemptToGetExecutor(expCtx,
+                                                         collections,
+                                                         nss,
+                                                         queryObj,
+                                                         projObj,
+                                                         deps.metadataDeps(),
+                                                         indexOrder->sortObj,
+                                                         skipThenLimit,
+                                                         boost::none, /* groupIdForDistinctScan */
+                                                         aggRequest,
+                                                         sortedPlannerOpts,
+                                                         matcherFeatures,
+                                                         pipeline);
+            if (swExecutorSorted.isOK()) {
+                // Keep the original stage alive while we move its accumulators to the new one.
+                auto originalGroup = pipeline->popFrontWithName(DocumentSourceGroup::kStageName);
+                invariant(originalGroup.get() == groupStage);
+                pipeline->addInitialSource(DocumentSourceStreamingGroup::create(
+                    expCtx,
+                    groupStage->getIdExpression(),
+                    std::move(indexOrder->monotonicIdFields),
+                    std::move(groupStage->getMutableAccumulatedFields()),
+                    groupStage->getMaxMemoryUsageBytes()));
+                return swExecutorSorted;
+            } else if (swExecutorSorted != ErrorCodes::NoQueryExecutionPlans) {
+                return swExecutorSorted.getStatus().withContext(
+                    "Failed to determine whether an index can provide the order for a streaming "
+                    "$group");
+            }
+        }
+    }
+
     // If this pipeline is a change stream, then the cursor must use the simple collation, so we
     // temporarily switch the collator on the ExpressionContext to nullptr. We do this here because
     // by this point, all the necessary pipeline analyses and optimizations have already been
@@ -1705,7 +1973,8 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> PipelineD::prep
                                 aggRequest,
                                 plannerOpts,
                                 matcherFeatures,
-                                pipeline);
+                                pipeline,
+                                std::move(resumeAfter));
 }
 
 Timestamp PipelineD::getLatestOplogTimestamp(const Pipeline* pipeline) {
@@ -1483,6 +1483,82 @@ TEST(PipelineOptimizationTest, LookupWithUnwindPreservingNullAndEmptyArraysShoul
     assertPipelineOptimizesAndSerializesTo(inputPipe, outputPipe, serializedPipe);
 }
 
+TEST(PipelineOptimizationTest, SortLimitBecomesTopKSortBeforeLookupUnwindingWithPreserveNull) {
+    string inputPipe =
+        "[{$sort: {b: 1}}, "
+        " {$lookup: {from: 'lookupColl', as: 'asField', localField: 'y', foreignField: "
+        "'z'}}, "
+        " {$unwind: {path: '$asField', preserveNullAndEmptyArrays: true}}, "
+        " {$limit: 20}]";
+    string outputPipe =
+        "[{$sort: {sortKey: {b: 1}, limit: 20}}, "
+        " {$lookup: { "
+        "      from: 'lookupColl', "
+        "      as: 'asField', "
+        "      localField: 'y', "
+        "      foreignField: 'z', "
+        "      unwinding: { "
+        "          preserveNullAndEmptyArrays: true"
+        "      } "
+        " }}, "
+        " {$limit: 20}]";
+    string serializedPipe =
+        "[{$sort: {b: 1}}, "
+        " {$limit: 20}, "
+        " {$lookup: {from: 'lookupColl', as: 'asField', localField: 'y', foreignField: "
+        "'z'}}, "
+        " {$unwind: {path: '$asField', preserveNullAndEmptyArrays: true}}, "
+        " {$limit: 20}]";
+    assertPipelineOptimizesAndSerializesTo(inputPipe, outputPipe, serializedPipe);
+}
+
+TEST(PipelineOptimizationTest, LimitDoesNotDuplicateBeforeLookupUnwindingWithoutPreserveNull) {
+    string inputPipe =
+        "[{$sort: {b: 1}}, "
+        " {$lookup: {from: 'lookupColl', as: 'asField', localField: 'y', foreignField: "
+        "'z'}}, "
+        " {$unwind: {path: '$asField'}}, "
+        " {$limit: 20}]";
+    string outputPipe =
+        "[{$sort: {sortKey: {b: 1}}}, "
+        " {$lookup: { "
+        "      from: 'lookupColl', "
+        "      as: 'asField', "
+        "      localField: 'y', "
+        "      foreignField: 'z', "
+        "      unwinding: { "
+        "          preserveNullAndEmptyArrays: false"
+        "      } "
+        " }}, "
+        " {$limit: 20}]";
+    string serializedPipe =
+        "[{$sort: {b: 1}}, "
+        " {$lookup: {from: 'lookupColl', as: 'asField', localField: 'y', foreignField: "
+        "'z'}}, "
+        " {$unwind: {path: '$asField'}}, "
+        " {$limit: 20}]";
+    assertPipelineOptimizesAndSerializesTo(inputPipe, outputPipe, serializedPipe);
+}
+
+TEST(PipelineOptimizationTest, SortLimitBecomesTopKSortBeforeLookupAndAddFields) {
+    string inputPipe =
+        "[{$sort: {b: 1}}, "
+        " {$lookup: {from: 'lookupColl', as: 'asField', localField: 'y', foreignField: "
+        "'z'}}, "
+        " {$addFields: {c: 1}}, "
+        " {$limit: 20}]";
+    string outputPipe =
+        "[{$sort: {sortKey: {b: 1}, limit: 20}}, "
+        " {$lookup: {from: 'lookupColl', as: 'asField', localField: 'y', foreignField: 'z'}}, "
+        " {$addFields: {c: {$const: 1}}}]";
+    string serializedPipe =
+        "[{$sort: {b: 1}}, "
+        " {$limit: 20}, "
+        " {$lookup: {from: 'lookupColl', as: 'asField', localField: 'y', foreignField: 'z'}}, "
+        " {$addFields: {c: {$const: 1}}}]";
+    assertPipelineOptimizesAndSerializesTo(inputPipe, outputPipe, serializedPipe);
+}
+
 TEST(PipelineOptimizationTest, LookupDoesNotAbsorbElemMatch) {
     string inputPipe =
         "[{$lookup: {from: 'lookupColl', as: 'x', localField: 'y', foreignField: 'z'}}, "
@@ -3155,6 +3231,73 @@ TEST(PipelineOptimizationTest, UnionWithViewsSampleUseCase) {
         "]");
 }
 
+TEST(PipelineOptimizationTest, SortGetsPushedIntoBothChildrenOfUnionWhenMergingSortedInputs) {
+    RAIIServerParameterControllerForTest controller("internalQueryUnionWithMergeSortedInputs",
+                                                    true);
+    assertPipelineOptimizesAndSerializesTo(
+        "["
+        " {$unionWith: 'unionColl'},"
+        " {$sort: {x: 1}}"
+        "]",
+        "[{$sort: {sortKey: {x: 1}}},"
+        " {$unionWith: {"
+        "   coll: 'unionColl',"
+        "   pipeline: [{$sort: {sortKey: {x: 1}}}],"
+        "   mergeSortPattern: {x: 1}"
+        " }}]",
+        "[{$sort: {x: 1}},"
+        " {$unionWith: {"
+        "   coll: 'unionColl',"
+        "   pipeline: [{$sort: {x: 1}}]"
+        " }},"
+        " {$sort: {x: 1}}]");
+
+    // Test that a following $limit is applied to each input as well as to the merged output.
+    assertPipelineOptimizesAndSerializesTo(
+        "["
+        " {$unionWith: 'unionColl'},"
+        " {$sort: {x: 1}},"
+        " {$limit: 5}"
+        "]",
+        "[{$sort: {sortKey: {x: 1}, limit: 5}},"
+        " {$unionWith: {"
+        "   coll: 'unionColl',"
+        "   pipeline: [{$sort: {sortKey: {x: 1}, limit: 5}}],"
+        "   mergeSortPattern: {x: 1}"
+        " }},"
+        " {$limit: 5}]",
+        "[{$sort: {x: 1}},"
+        " {$limit: 5},"
+        " {$unionWith: {"
+        "   coll: 'unionColl',"
+        "   pipeline: [{$sort: {x: 1}}, {$limit: 5}]"
+        " }},"
+        " {$sort: {x: 1}},"
+        " {$limit: 5}]");
+
+    // Test that a projection after the merge is not pushed in front of it, since it could modify
+    // the sort keys.
+    assertPipelineOptimizesAndSerializesTo(
+        "["
+        " {$unionWith: 'unionColl'},"
+        " {$sort: {x: 1}},"
+        " {$project: {x: true}}"
+        "]",
+        "[{$sort: {sortKey: {x: 1}}},"
+        " {$unionWith: {"
+        "   coll: 'unionColl',"
+        "   pipeline: [{$sort: {sortKey: {x: 1}}}],"
+        "   mergeSortPattern: {x: 1}"
+        " }},"
+        " {$project: {_id: true, x: true}}]",
+        "[{$sort: {x: 1}},"
+        " {$unionWith: {"
+        "   coll: 'unionColl',"
+        "   pipeline: [{$sort: {x: 1}}]"
+        " }},"
+        " {$sort: {x: 1}},"
+        " {$project: {_id: true, x: true}}]");
+}
 
 std::unique_ptr<Pipeline, PipelineDeleter> getOptimizedPipeline(const BSONObj inputBson) {
     QueryTestServiceContext testServiceContext;
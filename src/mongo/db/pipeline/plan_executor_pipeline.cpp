@@ -36,6 +36,7 @@
 #include "mongo/db/pipeline/pipeline_d.h"
 #include "mongo/db/pipeline/plan_explainer_pipeline.h"
 #include "mongo/db/pipeline/resume_token.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/repl/speculative_majority_read_info.h"
 
 namespace mongo {
@@ -130,6 +131,9 @@ boost::optional<Document> PlanExecutorPipeline::_getNext() {
 }
 
 boost::optional<Document> PlanExecutorPipeline::_tryGetNext() try {
+    if (ResumableScanType::kNone == _resumableScanType) {
+        return _getNextFromBatch();
+    }
     return _pipeline->getNext();
 } catch (const ExceptionFor<ErrorCodes::ChangeStreamTopologyChange>& ex) {
     // This exception contains the next document to be returned by the pipeline.
@@ -143,6 +147,25 @@ boost::optional<Document> PlanExecutorPipeline::_tryGetNext() try {
     return Document::fromBsonWithMetaData(extraInfo->getStartAfterInvalidateEvent());
 }
 
+boost::optional<Document> PlanExecutorPipeline::_getNextFromBatch() {
+    if (_batchPos == _batch.size()) {
+        // Report the EOF which followed the last batch before pulling again, as getNext() would.
+        if (std::exchange(_batchEndedWithEof, false)) {
+            return boost::none;
+        }
+
+        _batch.clear();
+        _batchPos = 0;
+        _batchEndedWithEof =
+            !_pipeline->getNextBatch(&_batch, internalPipelineExecutorBatchSize.load());
+        if (_batch.empty()) {
+            _batchEndedWithEof = false;
+            return boost::none;
+        }
+    }
+    return std::move(_batch[_batchPos++]);
+}
+
 BSONObj PlanExecutorPipeline::_trySerializeToBson(const Document& doc) try {
     // Include metadata if the output will be consumed by a merging node.
     return _expCtx->needsMerge || _expCtx->forPerShardCursor ? doc.toBsonWithMetaData()
@@ -181,6 +181,12 @@ private:
      */
     boost::optional<Document> _tryGetNext();
 
+    /**
+     * Returns the next result of a pipeline which is not a resumable scan, pulling a new batch of
+     * results from the pipeline once the previous one has been returned.
+     */
+    boost::optional<Document> _getNextFromBatch();
+
     /**
      * Serialize the given document to BSON while updating stats for BSONObjectTooLarge exception.
      */
@@ -228,6 +234,15 @@ private:
 
     std::queue<BSONObj> _stash;
 
+    // Results pulled from '_pipeline' in one batch, of which those from '_batchPos' onwards have
+    // not been returned yet. Resumable scans pull one result at a time instead, since they track
+    // their position as each result is returned.
+    std::vector<Document> _batch;
+    size_t _batchPos = 0;
+
+    // Set if the pipeline reached EOF after the results in '_batch'.
+    bool _batchEndedWithEof = false;
+
     // If _killStatus has a non-OK value, then we have been killed and the value represents the
     // reason for the kill.
     Status _killStatus = Status::OK();
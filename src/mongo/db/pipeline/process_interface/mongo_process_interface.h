@@ -58,9 +58,11 @@
 #include "mongo/db/storage/temporary_record_store.h"
 #include "mongo/executor/task_executor.h"
 #include "mongo/s/chunk_version.h"
+#include "mongo/s/shard_id.h"
 
 namespace mongo {
 
+class ChunkManager;
 class ShardFilterer;
 class ExpressionContext;
 class JsExecution;
@@ -489,6 +491,24 @@ public:
         const NamespaceString& nss,
         const boost::optional<DatabaseVersion>& dbVersion) = 0;
 
+    /**
+     * Used to enforce the constraint that every chunk of the sharded collection 'nss' which a
+     * query targets, as described by 'targetedShards', is owned by this shard, so that the query
+     * can be served by a local read. For the lifetime of the returned object the operation carries
+     * this shard's version from 'cm', so a local read will fail with a stale shard version error
+     * if the routing information has since changed. Throws IllegalOperation if this node is not
+     * the single targeted shard, or if the operation already carries a shard version for 'nss'.
+     */
+    class ScopedExpectShardedCollection {
+    public:
+        virtual ~ScopedExpectShardedCollection() = default;
+    };
+    virtual std::unique_ptr<ScopedExpectShardedCollection>
+    expectShardedCollectionOnThisShardInScope(OperationContext* opCtx,
+                                              const NamespaceString& nss,
+                                              const ChunkManager& cm,
+                                              const std::set<ShardId>& targetedShards) = 0;
+
     /**
      * Checks if this process is on the primary shard for db specified by the given namespace.
      * Throws an IllegalOperation exception otherwise. Assumes the operation context has a db
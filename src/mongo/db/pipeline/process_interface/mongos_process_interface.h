@@ -234,6 +234,14 @@ public:
         MONGO_UNREACHABLE;
     }
 
+    std::unique_ptr<ScopedExpectShardedCollection> expectShardedCollectionOnThisShardInScope(
+        OperationContext* opCtx,
+        const NamespaceString& nss,
+        const ChunkManager& cm,
+        const std::set<ShardId>& targetedShards) override {
+        MONGO_UNREACHABLE;
+    }
+
     void checkOnPrimaryShardForDb(OperationContext* opCtx, const NamespaceString& nss) override {
         MONGO_UNREACHABLE;
     }
@@ -46,6 +46,7 @@
 #include "mongo/db/s/operation_sharding_state.h"
 #include "mongo/db/s/sharding_state.h"
 #include "mongo/rpc/get_status_from_command_result.h"
+#include "mongo/s/chunk_manager.h"
 #include "mongo/s/cluster_commands_helpers.h"
 #include "mongo/s/cluster_write.h"
 #include "mongo/s/query/document_source_merge_cursors.h"
@@ -420,6 +421,40 @@ ShardServerProcessInterface::expectUnshardedCollectionInScope(
     return std::make_unique<ScopedExpectUnshardedCollectionImpl>(opCtx, nss, dbVersion);
 }
 
+std::unique_ptr<MongoProcessInterface::ScopedExpectShardedCollection>
+ShardServerProcessInterface::expectShardedCollectionOnThisShardInScope(
+    OperationContext* opCtx,
+    const NamespaceString& nss,
+    const ChunkManager& cm,
+    const std::set<ShardId>& targetedShards) {
+    class ScopedExpectShardedCollectionImpl : public ScopedExpectShardedCollection {
+    public:
+        ScopedExpectShardedCollectionImpl(OperationContext* opCtx,
+                                          const NamespaceString& nss,
+                                          const ChunkVersion& shardVersion)
+            : _expectSharded(opCtx, nss, shardVersion, boost::none) {}
+
+    private:
+        ScopedSetShardRole _expectSharded;
+    };
+
+    invariant(cm.isSharded());
+    const auto& thisShardId = ShardingState::get(opCtx)->shardId();
+    uassert(ErrorCodes::IllegalOperation,
+            str::stream() << "Query on " << nss.ns() << " does not target only shard "
+                          << thisShardId,
+            targetedShards.size() == 1 && *targetedShards.begin() == thisShardId);
+
+    // A shard role cannot be changed once set, so if this operation already carries a version for
+    // 'nss', e.g. because it was attached by the router, leave it to the normal targeting path.
+    uassert(ErrorCodes::IllegalOperation,
+            str::stream() << "Operation already has a shard version for " << nss.ns(),
+            !OperationShardingState::get(opCtx).getShardVersion(nss));
+
+    return std::make_unique<ScopedExpectShardedCollectionImpl>(
+        opCtx, nss, cm.getVersion(thisShardId));
+}
+
 void ShardServerProcessInterface::checkOnPrimaryShardForDb(OperationContext* opCtx,
                                                            const NamespaceString& nss) {
     DatabaseShardingState::checkIsPrimaryShardForDb(opCtx, nss.db());
@@ -130,6 +130,12 @@ public:
         const NamespaceString& nss,
         const boost::optional<DatabaseVersion>& dbVersion) override;
 
+    std::unique_ptr<ScopedExpectShardedCollection> expectShardedCollectionOnThisShardInScope(
+        OperationContext* opCtx,
+        const NamespaceString& nss,
+        const ChunkManager& cm,
+        const std::set<ShardId>& targetedShards) override;
+
     void checkOnPrimaryShardForDb(OperationContext* opCtx, const NamespaceString& nss) final;
 };
 
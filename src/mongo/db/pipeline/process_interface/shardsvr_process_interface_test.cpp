@@ -31,6 +31,8 @@
 #include "mongo/db/pipeline/document_source_out.h"
 #include "mongo/db/pipeline/document_source_queue.h"
 #include "mongo/db/pipeline/process_interface/shardsvr_process_interface.h"
+#include "mongo/db/s/operation_sharding_state.h"
+#include "mongo/db/s/sharding_state.h"
 #include "mongo/s/query/sharded_agg_test_fixture.h"
 #include "mongo/unittest/unittest.h"
 
@@ -117,5 +119,59 @@ TEST_F(ShardedProcessInterfaceTest, TestInsert) {
     future.default_timed_get();
 }
 
+class ShardedProcessInterfaceLocalReadTest : public ShardedProcessInterfaceTest {
+protected:
+    void setUp() override {
+        ShardedProcessInterfaceTest::setUp();
+        ShardingState::get(getServiceContext())->setInitialized(kThisShard, OID::gen());
+        _cm.emplace(makeChunkManager(
+            kForeignNss, ShardKeyPattern(BSON("_id" << 1)), nullptr, false, {BSON("_id" << 0)}));
+        _processInterface = std::make_shared<ShardServerProcessInterface>(executor());
+    }
+
+    const ShardId kThisShard{"0"};
+    const NamespaceString kForeignNss{"unittests", "foreign"};
+
+    boost::optional<ChunkManager> _cm;
+    std::shared_ptr<ShardServerProcessInterface> _processInterface;
+};
+
+TEST_F(ShardedProcessInterfaceLocalReadTest, AttachesThisShardsVersionWhileInScope) {
+    {
+        auto expectSharded = _processInterface->expectShardedCollectionOnThisShardInScope(
+            operationContext(), kForeignNss, *_cm, {kThisShard});
+        auto shardVersion =
+            OperationShardingState::get(operationContext()).getShardVersion(kForeignNss);
+        ASSERT(shardVersion);
+        ASSERT_EQ(*shardVersion, _cm->getVersion(kThisShard));
+    }
+    ASSERT_FALSE(OperationShardingState::get(operationContext()).getShardVersion(kForeignNss));
+}
+
+TEST_F(ShardedProcessInterfaceLocalReadTest, RejectsQueryTargetingOtherShards) {
+    ASSERT_THROWS_CODE(_processInterface->expectShardedCollectionOnThisShardInScope(
+                           operationContext(), kForeignNss, *_cm, {kThisShard, ShardId("1")}),
+                       DBException,
+                       ErrorCodes::IllegalOperation);
+    ASSERT_THROWS_CODE(_processInterface->expectShardedCollectionOnThisShardInScope(
+                           operationContext(), kForeignNss, *_cm, {ShardId("1")}),
+                       DBException,
+                       ErrorCodes::IllegalOperation);
+}
+
+TEST_F(ShardedProcessInterfaceLocalReadTest, RejectsNamespaceThatAlreadyHasAShardVersion) {
+    // The router attached a different version for the foreign namespace, as it does when a $lookup
+    // or $unionWith reads from the collection being aggregated.
+    const auto routerVersion = _cm->getVersion(ShardId("1"));
+    ScopedSetShardRole routerShardRole{operationContext(), kForeignNss, routerVersion, boost::none};
+
+    ASSERT_THROWS_CODE(_processInterface->expectShardedCollectionOnThisShardInScope(
+                           operationContext(), kForeignNss, *_cm, {kThisShard}),
+                       DBException,
+                       ErrorCodes::IllegalOperation);
+    ASSERT_EQ(*OperationShardingState::get(operationContext()).getShardVersion(kForeignNss),
+              routerVersion);
+}
+
 }  // namespace
 }  // namespace mongo
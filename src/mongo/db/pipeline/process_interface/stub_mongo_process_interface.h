@@ -315,6 +315,14 @@ public:
         return std::make_unique<ScopedExpectUnshardedCollectionNoop>();
     }
 
+    std::unique_ptr<ScopedExpectShardedCollection> expectShardedCollectionOnThisShardInScope(
+        OperationContext* opCtx,
+        const NamespaceString& nss,
+        const ChunkManager& cm,
+        const std::set<ShardId>& targetedShards) override {
+        uasserted(ErrorCodes::IllegalOperation, "Cannot read a sharded collection locally");
+    }
+
     void checkOnPrimaryShardForDb(OperationContext* opCtx, const NamespaceString& nss) override {
         // Do nothing.
     }
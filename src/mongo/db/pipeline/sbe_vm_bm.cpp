@@ -0,0 +1,185 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/db/exec/sbe/expressions/expression.h"
+#include "mongo/db/exec/sbe/stages/co_scan.h"
+#include "mongo/db/exec/sbe/values/slot.h"
+#include "mongo/db/exec/sbe/vm/vm.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+namespace {
+/**
+ * Benchmarks the SBE bytecode interpreter. Each benchmark compiles an SBE expression reading a
+ * document from a single slot, and then runs it against every document in 'documents'.
+ */
+void benchmarkSbeExpression(std::unique_ptr<sbe::EExpression> expr,
+                            sbe::value::SlotId inputSlot,
+                            benchmark::State& state,
+                            const std::vector<BSONObj>& documents) {
+    sbe::CoScanStage emptyStage{sbe::kEmptyPlanNodeId};
+    sbe::CompileCtx ctx{std::make_unique<sbe::RuntimeEnvironment>()};
+    ctx.root = &emptyStage;
+
+    sbe::value::ViewOfValueAccessor inputAccessor;
+    ctx.pushCorrelated(inputSlot, &inputAccessor);
+
+    auto code = expr->compile(ctx);
+    sbe::vm::ByteCode vm;
+
+    for (auto keepRunning : state) {
+        for (const auto& document : documents) {
+            inputAccessor.reset(sbe::value::TypeTags::bsonObject,
+                                sbe::value::bitcastFrom<const char*>(document.objdata()));
+            auto [owned, tag, val] = vm.run(code.get());
+            if (owned) {
+                sbe::value::releaseValue(tag, val);
+            }
+            benchmark::DoNotOptimize(tag);
+            benchmark::DoNotOptimize(val);
+        }
+        benchmark::ClobberMemory();
+    }
+}
+
+/**
+ * Generates 'numDocuments' documents with 'numFields' integer fields named "f0" ... "f<n-1>", with
+ * "a" appended as the last field.
+ */
+std::vector<BSONObj> makeDocuments(int numDocuments, int numFields) {
+    std::vector<BSONObj> documents;
+    for (int i = 0; i < numDocuments; ++i) {
+        BSONObjBuilder builder;
+        for (int field = 0; field < numFields; ++field) {
+            builder.append(str::stream() << "f" << field, field);
+        }
+        builder.append("a", i % 10);
+        documents.push_back(builder.obj());
+    }
+    return documents;
+}
+
+std::unique_ptr<sbe::EExpression> makeGetField(sbe::value::SlotId slot, StringData fieldName) {
+    return sbe::makeE<sbe::EFunction>(
+        "getField",
+        sbe::makeEs(sbe::makeE<sbe::EVariable>(slot), sbe::makeE<sbe::EConstant>(fieldName)));
+}
+
+std::unique_ptr<sbe::EExpression> makeInt32Constant(int32_t value) {
+    return sbe::makeE<sbe::EConstant>(sbe::value::TypeTags::NumberInt32,
+                                      sbe::value::bitcastFrom<int32_t>(value));
+}
+
+std::unique_ptr<sbe::EExpression> makeFillEmptyFalse(std::unique_ptr<sbe::EExpression> expr) {
+    return sbe::makeE<sbe::EFunction>(
+        "fillEmpty",
+        sbe::makeEs(std::move(expr),
+                    sbe::makeE<sbe::EConstant>(sbe::value::TypeTags::Boolean,
+                                               sbe::value::bitcastFrom<bool>(false))));
+}
+
+/**
+ * The shape emitted by the stage builder for a scalar equality predicate such as {a: 5}:
+ *   fillEmpty(getField(s1, "a") == 5, false)
+ */
+void BM_GetFieldEq(benchmark::State& state) {
+    sbe::value::SlotId inputSlot = 1;
+    auto expr = makeFillEmptyFalse(sbe::makeE<sbe::EPrimBinary>(
+        sbe::EPrimBinary::eq, makeGetField(inputSlot, "a"), makeInt32Constant(5)));
+
+    benchmarkSbeExpression(
+        std::move(expr), inputSlot, state, makeDocuments(1000, static_cast<int>(state.range(0))));
+}
+
+/**
+ * The shape emitted by the stage builder for a predicate on a possibly array-valued path:
+ *   traverseF(getField(s1, "a"), \l1. fillEmpty(l1 == 5, false), false)
+ */
+void BM_TraverseFGetFieldEq(benchmark::State& state) {
+    sbe::value::SlotId inputSlot = 1;
+    sbe::FrameId frameId = 10;
+    auto lambda = sbe::makeE<sbe::ELocalLambda>(
+        frameId,
+        makeFillEmptyFalse(sbe::makeE<sbe::EPrimBinary>(
+            sbe::EPrimBinary::eq, sbe::makeE<sbe::EVariable>(frameId, 0), makeInt32Constant(5))));
+    auto expr = sbe::makeE<sbe::EFunction>(
+        "traverseF",
+        sbe::makeEs(makeGetField(inputSlot, "a"),
+                    std::move(lambda),
+                    sbe::makeE<sbe::EConstant>(sbe::value::TypeTags::Boolean,
+                                               sbe::value::bitcastFrom<bool>(false))));
+
+    benchmarkSbeExpression(
+        std::move(expr), inputSlot, state, makeDocuments(1000, static_cast<int>(state.range(0))));
+}
+
+/**
+ * A conjunction of range predicates on two fields, which exercises the logical and jump
+ * instructions:
+ *   fillEmpty(getField(s1, "a") >= 2, false) && fillEmpty(getField(s1, "f0") < 7, false)
+ */
+void BM_ConjunctionOfRanges(benchmark::State& state) {
+    sbe::value::SlotId inputSlot = 1;
+    auto expr = sbe::makeE<sbe::EPrimBinary>(
+        sbe::EPrimBinary::logicAnd,
+        makeFillEmptyFalse(sbe::makeE<sbe::EPrimBinary>(
+            sbe::EPrimBinary::greaterEq, makeGetField(inputSlot, "a"), makeInt32Constant(2))),
+        makeFillEmptyFalse(sbe::makeE<sbe::EPrimBinary>(
+            sbe::EPrimBinary::less, makeGetField(inputSlot, "f0"), makeInt32Constant(7))));
+
+    benchmarkSbeExpression(
+        std::move(expr), inputSlot, state, makeDocuments(1000, static_cast<int>(state.range(0))));
+}
+
+/**
+ * Arithmetic over two fields: (getField(s1, "a") + getField(s1, "f0")) * 2
+ */
+void BM_Arithmetic(benchmark::State& state) {
+    sbe::value::SlotId inputSlot = 1;
+    auto expr = sbe::makeE<sbe::EPrimBinary>(
+        sbe::EPrimBinary::mul,
+        sbe::makeE<sbe::EPrimBinary>(
+            sbe::EPrimBinary::add, makeGetField(inputSlot, "a"), makeGetField(inputSlot, "f0")),
+        makeInt32Constant(2));
+
+    benchmarkSbeExpression(
+        std::move(expr), inputSlot, state, makeDocuments(1000, static_cast<int>(state.range(0))));
+}
+
+BENCHMARK(BM_GetFieldEq)->Arg(0)->Arg(10)->Arg(50);
+BENCHMARK(BM_TraverseFGetFieldEq)->Arg(0)->Arg(10)->Arg(50);
+BENCHMARK(BM_ConjunctionOfRanges)->Arg(0)->Arg(10)->Arg(50);
+BENCHMARK(BM_Arithmetic)->Arg(0)->Arg(10)->Arg(50);
+
+}  // namespace
+}  // namespace mongo
@@ -1645,6 +1645,43 @@ std::unique_ptr<Pipeline, PipelineDeleter> attachCursorToPipeline(
                 }
             }
 
+            if (cm.isSharded() && !isMongos() &&
+                shardTargetingPolicy == ShardTargetingPolicy::kAllowed) {
+                // If the collection is sharded but every chunk the pipeline targets is owned by
+                // this shard (e.g. a $lookup or $unionWith whose foreign collection is co-located
+                // on the shard key), read locally instead of dispatching a cursor to ourselves.
+                // The local read attaches this shard's version, so a concurrent migration is
+                // caught by the usual stale shard version check and we fall back to targeting.
+                try {
+                    auto targetedShards = getTargetedShardsForQuery(
+                        expCtx, cm, pipelineToTarget->getInitialQuery(), expCtx->getCollatorBSON());
+                    auto expectShardedCollection(
+                        expCtx->mongoProcessInterface->expectShardedCollectionOnThisShardInScope(
+                            expCtx->opCtx, expCtx->ns, cm, targetedShards));
+
+                    LOGV2_DEBUG(7027500,
+                                3,
+                                "Performing local read of sharded collection",
+                                logAttrs(expCtx->ns),
+                                "pipeline"_attr = pipelineToTarget->serializeToBson(),
+                                "comment"_attr = expCtx->opCtx->getComment());
+
+                    return expCtx->mongoProcessInterface->attachCursorSourceToPipelineForLocalRead(
+                        pipelineToTarget.release());
+                } catch (ExceptionFor<ErrorCodes::IllegalOperation>&) {
+                    // The pipeline targets other shards, proceed with shard targeting.
+                } catch (ExceptionForCat<ErrorCategory::StaleShardVersionError>&) {
+                    // The current node has stale information about this collection, proceed with
+                    // shard targeting, which has logic to handle refreshing that may be needed.
+                } catch (ExceptionFor<ErrorCodes::CommandNotSupportedOnView>&) {
+                    // The namespace may be an unresolved view, proceed with shard targeting.
+                }
+
+                if (!pipelineToTarget) {
+                    pipelineToTarget = pipeline->clone();
+                }
+            }
+
             return targetShardsAndAddMergeCursors(expCtx,
                                                   std::move(pipelineToTarget),
                                                   boost::none,
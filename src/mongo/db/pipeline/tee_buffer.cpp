@@ -50,6 +50,17 @@ boost::intrusive_ptr<TeeBuffer> TeeBuffer::create(size_t nConsumers, int bufferS
 }
 
 DocumentSource::GetNextResult TeeBuffer::getNext(size_t consumerId) {
+    if (_loadedByOwner) {
+        if (_consumers[consumerId].nLeftToReturn == 0) {
+            // Either wait for the owner to load the next batch, or the last load found no input.
+            return _buffer.empty() ? DocumentSource::GetNextResult::makeEOF()
+                                   : DocumentSource::GetNextResult::makePauseExecution();
+        }
+        const size_t bufferIndex = _buffer.size() - _consumers[consumerId].nLeftToReturn;
+        --_consumers[consumerId].nLeftToReturn;
+        return _buffer[bufferIndex];
+    }
+
     size_t nConsumersStillProcessingThisBatch =
         std::count_if(_consumers.begin(), _consumers.end(), [](const ConsumerInfo& info) {
             return info.nLeftToReturn > 0;
@@ -76,6 +87,16 @@ DocumentSource::GetNextResult TeeBuffer::getNext(size_t consumerId) {
     return _buffer[bufferIndex];
 }
 
+bool TeeBuffer::loadNextBatchForConsumers() {
+    invariant(_loadedByOwner);
+    if (!anyConsumerStillInUse()) {
+        disposeSource();
+        return false;
+    }
+    loadNextBatch();
+    return !_buffer.empty();
+}
+
 void TeeBuffer::loadNextBatch() {
     _buffer.clear();
     size_t bytesInBuffer = 0;
@@ -62,17 +62,42 @@ public:
     /**
      * Removes 'consumerId' as a consumer of this buffer. This is required to be called if a
      * consumer will not consume all input.
+     *
+     * When the batches are loaded by the owner, see loadNextBatchForConsumers(), this only updates
+     * the state of 'consumerId', and the source is disposed of by the next load instead.
      */
     void dispose(size_t consumerId) {
         _consumers[consumerId].stillInUse = false;
         _consumers[consumerId].nLeftToReturn = 0;
-        if (std::none_of(_consumers.begin(), _consumers.end(), [](const ConsumerInfo& info) {
-                return info.stillInUse;
-            })) {
-            _buffer.clear();
-            if (_source) {
-                _source->dispose();
-            }
+        if (!_loadedByOwner && !anyConsumerStillInUse()) {
+            disposeSource();
+        }
+    }
+
+    /**
+     * Makes the owner of this buffer responsible for loading batches with
+     * loadNextBatchForConsumers(), rather than the consumers through getNext(). A consumer then
+     * only reads the shared batch and updates its own state, so that different consumers can run on
+     * different threads while the owner waits for them.
+     */
+    void setLoadedByOwner() {
+        _loadedByOwner = true;
+    }
+
+    /**
+     * Loads the next batch for all the consumers still in use. Returns false if the input is
+     * exhausted or no consumer is left, in which case every subsequent getNext() returns EOF.
+     * Must only be called while no consumer is running.
+     */
+    bool loadNextBatchForConsumers();
+
+    /**
+     * Disposes of the source if no consumer is left. Only needed when batches are loaded by the
+     * owner, since dispose() then leaves the source alone.
+     */
+    void disposeSourceIfUnused() {
+        if (_loadedByOwner && !anyConsumerStillInUse()) {
+            disposeSource();
         }
     }
 
@@ -93,8 +118,24 @@ private:
      */
     void loadNextBatch();
 
+    bool anyConsumerStillInUse() const {
+        return std::any_of(_consumers.begin(), _consumers.end(), [](const ConsumerInfo& info) {
+            return info.stillInUse;
+        });
+    }
+
+    void disposeSource() {
+        _buffer.clear();
+        if (_source) {
+            _source->dispose();
+        }
+    }
+
     DocumentSource* _source = nullptr;
 
+    // True if batches are loaded by loadNextBatchForConsumers() rather than by getNext().
+    bool _loadedByOwner = false;
+
     const size_t _bufferSizeBytes;
     std::vector<DocumentSource::GetNextResult> _buffer;
 
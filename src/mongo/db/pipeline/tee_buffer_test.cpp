@@ -170,5 +170,69 @@ TEST_F(TeeBufferTest, ShouldAllowOtherConsumersToAdvanceOnceTrailingConsumerIsDi
     ASSERT_TRUE(teeBuffer->getNext(0).isEOF());
     ASSERT_TRUE(teeBuffer->getNext(0).isEOF());
 }
+
+TEST_F(TeeBufferTest, ShouldOnlyAdvanceConsumersWhenOwnerLoadsNextBatch) {
+    std::deque<DocumentSource::GetNextResult> inputs{Document{{"a", 1}}, Document{{"a", 2}}};
+    auto mock = DocumentSourceMock::createForTest(inputs, getExpCtx());
+
+    const size_t nConsumers = 2;
+    const size_t bufferBytes = 1;  // Both docs won't fit in a single batch.
+    auto teeBuffer = TeeBuffer::create(nConsumers, bufferBytes);
+    teeBuffer->setSource(mock.get());
+    teeBuffer->setLoadedByOwner();
+
+    ASSERT_TRUE(teeBuffer->loadNextBatchForConsumers());
+    for (size_t consumerId = 0; consumerId < nConsumers; ++consumerId) {
+        auto next = teeBuffer->getNext(consumerId);
+        ASSERT_TRUE(next.isAdvanced());
+        ASSERT_DOCUMENT_EQ(next.getDocument(), inputs.front().getDocument());
+
+        // A consumer which finished the batch waits for the owner, even if it is the last one.
+        ASSERT_TRUE(teeBuffer->getNext(consumerId).isPaused());
+    }
+
+    ASSERT_TRUE(teeBuffer->loadNextBatchForConsumers());
+    for (size_t consumerId = 0; consumerId < nConsumers; ++consumerId) {
+        auto next = teeBuffer->getNext(consumerId);
+        ASSERT_TRUE(next.isAdvanced());
+        ASSERT_DOCUMENT_EQ(next.getDocument(), inputs.back().getDocument());
+        ASSERT_TRUE(teeBuffer->getNext(consumerId).isPaused());
+    }
+
+    ASSERT_FALSE(teeBuffer->loadNextBatchForConsumers());
+    for (size_t consumerId = 0; consumerId < nConsumers; ++consumerId) {
+        ASSERT_TRUE(teeBuffer->getNext(consumerId).isEOF());
+        ASSERT_TRUE(teeBuffer->getNext(consumerId).isEOF());
+    }
+}
+
+TEST_F(TeeBufferTest, ShouldNotLoadFromSourceOnceAllConsumersAreDisposedWhenLoadedByOwner) {
+    std::deque<DocumentSource::GetNextResult> inputs{Document{{"a", 1}}, Document{{"a", 2}}};
+    auto mock = DocumentSourceMock::createForTest(inputs, getExpCtx());
+
+    const size_t nConsumers = 2;
+    const size_t bufferBytes = 1;  // Both docs won't fit in a single batch.
+    auto teeBuffer = TeeBuffer::create(nConsumers, bufferBytes);
+    teeBuffer->setSource(mock.get());
+    teeBuffer->setLoadedByOwner();
+
+    ASSERT_TRUE(teeBuffer->loadNextBatchForConsumers());
+    teeBuffer->dispose(0);
+    ASSERT_TRUE(teeBuffer->getNext(0).isPaused());
+    ASSERT_TRUE(teeBuffer->getNext(1).isAdvanced());
+
+    // Consumer #1 still reads the remaining input once consumer #0 is gone.
+    ASSERT_TRUE(teeBuffer->loadNextBatchForConsumers());
+    auto next1 = teeBuffer->getNext(1);
+    ASSERT_TRUE(next1.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next1.getDocument(), inputs.back().getDocument());
+
+    teeBuffer->dispose(1);
+    ASSERT_FALSE(mock->isDisposed);
+    ASSERT_FALSE(teeBuffer->loadNextBatchForConsumers());
+    ASSERT_TRUE(mock->isDisposed);
+    ASSERT_TRUE(teeBuffer->getNext(0).isEOF());
+    ASSERT_TRUE(teeBuffer->getNext(1).isEOF());
+}
 }  // namespace
 }  // namespace mongo
@@ -356,6 +356,35 @@ bool CanonicalQuery::isSimpleIdQuery(const BSONObj& query) {
     return hasID;
 }
 
+bool CanonicalQuery::isSimpleIdInQuery(const BSONObj& query) {
+    if (query.nFields() != 1) {
+        return false;
+    }
+
+    BSONElement elt = query.firstElement();
+    if (elt.fieldNameStringData() != "_id" || elt.type() != Object) {
+        return false;
+    }
+
+    BSONObj inObj = elt.Obj();
+    if (inObj.nFields() != 1 || inObj.firstElementFieldNameStringData() != "$in" ||
+        inObj.firstElement().type() != Array) {
+        return false;
+    }
+
+    BSONObj values = inObj.firstElement().Obj();
+    if (values.isEmpty()) {
+        return false;
+    }
+    for (auto&& value : values) {
+        // Values such as regexes, null or arrays match more than the _id equal to them.
+        if (!Indexability::isExactBoundsGenerating(value)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 size_t CanonicalQuery::countNodes(const MatchExpression* root, MatchExpression::MatchType type) {
     size_t sum = 0;
     if (type == root->matchType()) {
@@ -92,6 +92,12 @@ public:
      */
     static bool isSimpleIdQuery(const BSONObj& query);
 
+    /**
+     * Returns true if "query" is of the form {_id: {$in: [...]}} and every value in the $in list
+     * could be matched exactly by an IDHACK lookup.
+     */
+    static bool isSimpleIdInQuery(const BSONObj& query);
+
     /**
      * Validates the match expression 'root' as well as the query specified by 'request', checking
      * for illegal combinations of operators. Returns a non-OK status if any such illegal
@@ -105,6 +105,7 @@ void encodeUserString(StringData s, BuilderType* builder) {
             case kEncodeRegexFlagsSeparator:
             case kEncodeSortSection:
             case kEncodeEngineSection:
+            case kEncodeParallelismSection:
             case kEncodeParamMarker:
             case kEncodeConstantLiteralMarker:
             case '\\':
@@ -1057,6 +1058,17 @@ std::string encodeSBE(const CanonicalQuery& cq) {
 
     encodeFindCommandRequest(cq.getFindCommandRequest(), &bufBuilder);
 
+    // Plans built for a query which may run in parallel differ from the serial ones, hence queries
+    // which may use a different number of threads must not share plan cache entries. A query which
+    // cannot read in parallel gets the serial plan whatever its degree, and must not reuse a
+    // parallel one.
+    const auto& expCtx = cq.getExpCtx();
+    if (auto degree = expCtx->getMaxDegreeOfParallelism();
+        degree > 1 && expCtx->canReadInParallel()) {
+        bufBuilder.appendChar(kEncodeParallelismSection);
+        bufBuilder.appendNum(degree);
+    }
+
     return base64::encode(StringData(bufBuilder.buf(), bufBuilder.len()));
 }
 
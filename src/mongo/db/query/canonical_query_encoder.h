@@ -43,6 +43,7 @@ inline constexpr char kEncodeProjectionRequirementSeparator = '-';
 inline constexpr char kEncodeRegexFlagsSeparator = '/';
 inline constexpr char kEncodeSortSection = '~';
 inline constexpr char kEncodeEngineSection = '@';
+inline constexpr char kEncodeParallelismSection = '%';
 
 // These special bytes are used in the encoding of auto-parameterized match expressions in the SBE
 // plan cache key.
@@ -36,6 +36,7 @@
 #include "mongo/db/query/canonical_query.h"
 #include "mongo/db/query/plan_cache_key_factory.h"
 #include "mongo/db/query/query_test_service_context.h"
+#include "mongo/db/storage/recovery_unit_noop.h"
 #include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/assert_util.h"
@@ -389,6 +390,72 @@ TEST(CanonicalQueryEncoderTest, CheckCollationIsEncoded) {
     testComputeKey(*cq, "an[eqa,eqb]#mock_reverse_string02300000@f");
 }
 
+TEST(CanonicalQueryEncoderTest, DegreeOfParallelismIsNotEncodedInClassicKey) {
+    RAIIServerParameterControllerForTest controllerSBE("internalQueryForceClassicEngine", true);
+    RAIIServerParameterControllerForTest degree(
+        "internalQuerySlotBasedExecutionMaxDegreeOfParallelism", 4);
+
+    testComputeKey("{a: 1}", "{}", "{}", "eqa@f");
+}
+
+/**
+ * A recovery unit which only remembers the timestamp read source it is given.
+ */
+class ReadSourceRecoveryUnit : public RecoveryUnitNoop {
+public:
+    void setTimestampReadSource(ReadSource source,
+                                boost::optional<Timestamp> provided = boost::none) override {
+        _source = source;
+    }
+
+    ReadSource getTimestampReadSource() const override {
+        return _source;
+    }
+
+private:
+    ReadSource _source = ReadSource::kNoTimestamp;
+};
+
+TEST(CanonicalQueryEncoderTest, DegreeOfParallelismIsEncodedInSBEKeyOnlyIfQueryCanReadInParallel) {
+    RAIIServerParameterControllerForTest controllerSBE("internalQueryForceClassicEngine", false);
+    RAIIServerParameterControllerForTest controllerSBEPlanCache("featureFlagSbePlanCache", true);
+
+    QueryTestServiceContext serviceContext;
+    auto opCtx = serviceContext.makeOperationContext();
+    opCtx->setRecoveryUnit(std::make_unique<ReadSourceRecoveryUnit>(),
+                           WriteUnitOfWork::RecoveryUnitState::kNotInUnitOfWork);
+
+    auto sbeKey = [&] {
+        auto findCommand = std::make_unique<FindCommandRequest>(nss);
+        findCommand->setFilter(fromjson("{a: 1}"));
+        auto cq =
+            uassertStatusOK(CanonicalQuery::canonicalize(opCtx.get(), std::move(findCommand)));
+        cq->setSbeCompatible(true);
+        return makeKey(*cq).toString();
+    };
+
+    const auto serialKey = sbeKey();
+
+    RAIIServerParameterControllerForTest degree(
+        "internalQuerySlotBasedExecutionMaxDegreeOfParallelism", 4);
+
+    // A query which does not read at a known timestamp runs serially whatever its degree, so it
+    // shares the serial plan cache entry.
+    ASSERT_EQ(sbeKey(), serialKey);
+
+    opCtx->recoveryUnit()->setTimestampReadSource(RecoveryUnit::ReadSource::kProvided,
+                                                  Timestamp(1, 1));
+    const auto parallelKey = sbeKey();
+    ASSERT_NE(parallelKey, serialKey);
+
+    // The degree is capped by the server-wide thread budget.
+    RAIIServerParameterControllerForTest budget(
+        "internalQuerySlotBasedExecutionParallelThreadBudget", 2);
+    const auto cappedKey = sbeKey();
+    ASSERT_NE(cappedKey, serialKey);
+    ASSERT_NE(cappedKey, parallelKey);
+}
+
 TEST(CanonicalQueryEncoderTest, ComputeKeySBE) {
     // Generated cache keys should be treated as opaque to the user.
 
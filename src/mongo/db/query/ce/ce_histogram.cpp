@@ -0,0 +1,251 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/db/query/ce/ce_histogram.h"
+
+#include "mongo/db/exec/sbe/values/bson.h"
+#include "mongo/db/query/optimizer/cascades/ce_heuristic.h"
+#include "mongo/db/query/optimizer/utils/memo_utils.h"
+#include "mongo/db/query/stats/stats_catalog.h"
+
+namespace mongo::optimizer::cascades {
+
+using namespace properties;
+
+namespace {
+
+/**
+ * Returns the dotted field path matched by 'path', or boost::none if it is not a simple chain of
+ * field accesses. Traversals are skipped: histograms are only used for fields that do not hold
+ * arrays, where traversing is the identity.
+ */
+boost::optional<std::string> getFieldPath(const ABT& path) {
+    std::string fieldPath;
+    const ABT* current = &path;
+    while (!current->is<PathIdentity>()) {
+        if (auto get = current->cast<PathGet>()) {
+            if (!fieldPath.empty()) {
+                fieldPath += '.';
+            }
+            fieldPath += get->name();
+            current = &get->getPath();
+        } else if (auto traverse = current->cast<PathTraverse>()) {
+            current = &traverse->getPath();
+        } else {
+            return boost::none;
+        }
+    }
+
+    if (fieldPath.empty()) {
+        return boost::none;
+    }
+    return fieldPath;
+}
+
+/**
+ * Converts 'bound' to a single-element BSON object, or returns boost::none if it is not a constant.
+ * An infinite bound is converted to 'infiniteValue'.
+ */
+boost::optional<BSONObj> boundToBSON(const BoundRequirement& bound, const BSONObj& infiniteValue) {
+    if (bound.isInfinite()) {
+        return infiniteValue;
+    }
+
+    auto constant = bound.getBound().cast<Constant>();
+    if (!constant) {
+        return boost::none;
+    }
+
+    BSONObjBuilder builder;
+    const auto [tag, val] = constant->get();
+    sbe::bson::appendValueToBsonObj(builder, "", tag, val);
+    return builder.obj();
+}
+
+boost::optional<SelectivityType> estimateInterval(const stats::Histogram& histogram,
+                                                  const IntervalRequirement& interval) {
+    static const BSONObj kMinKey = BSON("" << MINKEY);
+    static const BSONObj kMaxKey = BSON("" << MAXKEY);
+
+    const auto& lowBound = interval.getLowBound();
+    const auto& highBound = interval.getHighBound();
+    auto low = boundToBSON(lowBound, kMinKey);
+    auto high = boundToBSON(highBound, kMaxKey);
+    if (!low || !high) {
+        return boost::none;
+    }
+
+    return histogram.estimateInterval(low->firstElement(),
+                                      lowBound.isInfinite() || lowBound.isInclusive(),
+                                      high->firstElement(),
+                                      highBound.isInfinite() || highBound.isInclusive());
+}
+
+/**
+ * Estimates the selectivity of 'intervals', which is expected to be in disjunctive normal form.
+ * The intervals of a conjunction apply to the same field, so the conjunction is estimated as its
+ * most selective interval, while disjunctions are assumed to be disjoint.
+ */
+boost::optional<SelectivityType> estimateIntervals(const stats::Histogram& histogram,
+                                                   const IntervalReqExpr::Node& intervals) {
+    auto disjunction = intervals.cast<IntervalReqExpr::Disjunction>();
+    if (!disjunction) {
+        return boost::none;
+    }
+
+    SelectivityType disjunctionSel = 0.0;
+    for (const auto& child : disjunction->nodes()) {
+        auto conjunction = child.cast<IntervalReqExpr::Conjunction>();
+        if (!conjunction) {
+            return boost::none;
+        }
+
+        SelectivityType conjunctionSel = 1.0;
+        for (const auto& atom : conjunction->nodes()) {
+            auto interval = atom.cast<IntervalReqExpr::Atom>();
+            if (!interval) {
+                return boost::none;
+            }
+            auto sel = estimateInterval(histogram, interval->getExpr());
+            if (!sel) {
+                return boost::none;
+            }
+            conjunctionSel = std::min(conjunctionSel, *sel);
+        }
+        disjunctionSel += conjunctionSel;
+    }
+    return std::min(1.0, disjunctionSel);
+}
+
+}  // namespace
+
+class CEHistogramTransportImpl {
+public:
+    CEHistogramTransportImpl(OperationContext* opCtx, NamespaceString nss)
+        : _opCtx(opCtx), _nss(std::move(nss)), _heuristicCE() {}
+
+    CEType transport(const ABT& n,
+                     const SargableNode& node,
+                     const Memo& memo,
+                     const LogicalProps& logicalProps,
+                     CEType childResult,
+                     CEType /*bindResult*/,
+                     CEType /*refsResult*/) {
+        if (!hasProperty<IndexingAvailability>(logicalProps)) {
+            return _heuristicCE.deriveCE(memo, logicalProps, n.ref());
+        }
+        const auto& scanProjection =
+            getPropertyConst<IndexingAvailability>(logicalProps).getScanProjection();
+
+        // Estimate individual requirements separately, assuming that they are independent. If any
+        // of them cannot be estimated from a histogram, fall back to heuristics for the whole node.
+        CEType result = childResult;
+        for (const auto& [key, req] : node.getReqMap()) {
+            if (isIntervalReqFullyOpenDNF(req.getIntervals())) {
+                continue;
+            }
+
+            auto histogram = key._projectionName == scanProjection ? getHistogram(key._path)
+                                                                    : nullptr;
+            auto sel = histogram ? estimateIntervals(*histogram, req.getIntervals()) : boost::none;
+            if (!sel) {
+                return _heuristicCE.deriveCE(memo, logicalProps, n.ref());
+            }
+            result *= *sel;
+        }
+
+        return result;
+    }
+
+    /**
+     * Other ABT types.
+     */
+    template <typename T, typename... Ts>
+    CEType transport(const ABT& n,
+                     const T& /*node*/,
+                     const Memo& memo,
+                     const LogicalProps& logicalProps,
+                     Ts&&...) {
+        if (canBeLogicalNode<T>()) {
+            return _heuristicCE.deriveCE(memo, logicalProps, n.ref());
+        }
+        return 0.0;
+    }
+
+    CEType derive(const Memo& memo,
+                  const properties::LogicalProps& logicalProps,
+                  const ABT::reference_type logicalNodeRef) {
+        return algebra::transport<true>(logicalNodeRef, *this, memo, logicalProps);
+    }
+
+private:
+    /**
+     * Returns the histogram for the field matched by 'path', if it can be used for estimation.
+     */
+    std::shared_ptr<const stats::Histogram> getHistogram(const ABT& path) {
+        auto fieldPath = getFieldPath(path);
+        if (!fieldPath) {
+            return nullptr;
+        }
+
+        auto it = _histograms.find(*fieldPath);
+        if (it == _histograms.end()) {
+            auto histogram =
+                stats::StatsCatalog::get(_opCtx).getHistogram(_opCtx, _nss, *fieldPath);
+            if (histogram && !histogram->canEstimate()) {
+                histogram = nullptr;
+            }
+            it = _histograms.emplace(*fieldPath, std::move(histogram)).first;
+        }
+        return it->second;
+    }
+
+    // We don't own this.
+    OperationContext* _opCtx;
+    const NamespaceString _nss;
+
+    // Histograms looked up so far, by field path. Holds nullptr for the fields without a usable
+    // histogram.
+    StringMap<std::shared_ptr<const stats::Histogram>> _histograms;
+
+    HeuristicCE _heuristicCE;
+};
+
+CEHistogramTransport::CEHistogramTransport(OperationContext* opCtx, NamespaceString nss)
+    : _impl(std::make_unique<CEHistogramTransportImpl>(opCtx, std::move(nss))) {}
+
+CEHistogramTransport::~CEHistogramTransport() {}
+
+CEType CEHistogramTransport::deriveCE(const Memo& memo,
+                                      const LogicalProps& logicalProps,
+                                      const ABT::reference_type logicalNodeRef) const {
+    return _impl->derive(memo, logicalProps, logicalNodeRef);
+}
+
+}  // namespace mongo::optimizer::cascades
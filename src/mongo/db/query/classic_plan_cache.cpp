@@ -29,12 +29,35 @@
 
 #include "mongo/db/query/classic_plan_cache.h"
 
+#include <algorithm>
+
 #include "mongo/db/commands/server_status_metric.h"
+#include "mongo/util/str.h"
 
 namespace mongo {
 namespace {
 ServerStatusMetricField<Counter64> totalPlanCacheSizeEstimateBytesMetric(
     "query.planCacheTotalSizeEstimateBytes", &mongo::planCacheTotalSizeEstimateBytes);
+
+void appendIndexIdentifier(const IndexEntry::Identifier& identifier, BSONObjBuilder* builder) {
+    builder->append("index", identifier.catalogName);
+    if (!identifier.disambiguator.empty()) {
+        builder->append("disambiguator", identifier.disambiguator);
+    }
+}
+
+IndexEntry::Identifier parseIndexIdentifier(const BSONObj& obj) {
+    return {obj.getStringField("index").toString(), obj.getStringField("disambiguator").toString()};
+}
+
+StatusWith<size_t> parsePosition(const BSONObj& obj) {
+    auto elem = obj["pos"];
+    if (!elem.isNumber() || elem.safeNumberLong() < 0) {
+        return Status(ErrorCodes::BadValue,
+                      str::stream() << "Invalid index position in plan cache data: " << obj);
+    }
+    return static_cast<size_t>(elem.safeNumberLong());
+}
 }  // namespace
 
 Counter64 planCacheTotalSizeEstimateBytes;
@@ -96,6 +119,109 @@ std::string PlanCacheIndexTree::toString(int indents) const {
     return result.str();
 }
 
+BSONObj PlanCacheIndexTree::toBSON() const {
+    BSONObjBuilder builder;
+    if (entry) {
+        appendIndexIdentifier(entry->identifier, &builder);
+        builder.append("pos", static_cast<long long>(index_pos));
+        builder.append("canCombineBounds", canCombineBounds);
+    }
+
+    if (!orPushdowns.empty()) {
+        BSONArrayBuilder orPushdownsBuilder(builder.subarrayStart("orPushdowns"));
+        for (const auto& orPushdown : orPushdowns) {
+            BSONObjBuilder orPushdownBuilder(orPushdownsBuilder.subobjStart());
+            appendIndexIdentifier(orPushdown.indexEntryId, &orPushdownBuilder);
+            orPushdownBuilder.append("pos", static_cast<long long>(orPushdown.position));
+            orPushdownBuilder.append("canCombineBounds", orPushdown.canCombineBounds);
+            BSONArrayBuilder routeBuilder(orPushdownBuilder.subarrayStart("route"));
+            for (auto position : orPushdown.route) {
+                routeBuilder.append(static_cast<long long>(position));
+            }
+        }
+    }
+
+    if (!children.empty()) {
+        BSONArrayBuilder childrenBuilder(builder.subarrayStart("children"));
+        for (const auto& child : children) {
+            childrenBuilder.append(child->toBSON());
+        }
+    }
+    return builder.obj();
+}
+
+StatusWith<std::unique_ptr<PlanCacheIndexTree>> PlanCacheIndexTree::parse(
+    const BSONObj& obj, const std::vector<IndexEntry>& indices) {
+    auto tree = std::make_unique<PlanCacheIndexTree>();
+
+    if (obj.hasField("index")) {
+        auto identifier = parseIndexIdentifier(obj);
+        auto index = std::find_if(indices.begin(), indices.end(), [&](const auto& entry) {
+            return entry.identifier == identifier;
+        });
+        if (index == indices.end()) {
+            return Status(ErrorCodes::BadValue,
+                          str::stream() << "Did not find index with name: " << identifier);
+        }
+        auto position = parsePosition(obj);
+        if (!position.isOK()) {
+            return position.getStatus();
+        }
+        tree->setIndexEntry(*index);
+        tree->index_pos = position.getValue();
+        tree->canCombineBounds = obj["canCombineBounds"].trueValue();
+    }
+
+    auto orPushdowns = obj["orPushdowns"];
+    if (!orPushdowns.eoo() && orPushdowns.type() != BSONType::Array) {
+        return Status(ErrorCodes::BadValue,
+                      str::stream() << "Invalid OR pushdowns in plan cache data: " << obj);
+    }
+    for (auto&& elem : orPushdowns.eoo() ? BSONObj() : orPushdowns.embeddedObject()) {
+        if (elem.type() != BSONType::Object) {
+            return Status(ErrorCodes::BadValue,
+                          str::stream() << "Invalid OR pushdown in plan cache data: " << elem);
+        }
+        auto orPushdownObj = elem.embeddedObject();
+        auto position = parsePosition(orPushdownObj);
+        if (!position.isOK()) {
+            return position.getStatus();
+        }
+
+        OrPushdown orPushdown{parseIndexIdentifier(orPushdownObj),
+                              position.getValue(),
+                              orPushdownObj["canCombineBounds"].trueValue(),
+                              {}};
+        for (auto&& routeElem : orPushdownObj.getObjectField("route")) {
+            if (!routeElem.isNumber() || routeElem.safeNumberLong() < 0) {
+                return Status(ErrorCodes::BadValue,
+                              str::stream() << "Invalid OR pushdown route in plan cache data: "
+                                            << orPushdownObj);
+            }
+            orPushdown.route.push_back(static_cast<size_t>(routeElem.safeNumberLong()));
+        }
+        tree->orPushdowns.push_back(std::move(orPushdown));
+    }
+
+    auto children = obj["children"];
+    if (!children.eoo() && children.type() != BSONType::Array) {
+        return Status(ErrorCodes::BadValue,
+                      str::stream() << "Invalid children in plan cache data: " << obj);
+    }
+    for (auto&& elem : children.eoo() ? BSONObj() : children.embeddedObject()) {
+        if (elem.type() != BSONType::Object) {
+            return Status(ErrorCodes::BadValue,
+                          str::stream() << "Invalid child in plan cache data: " << elem);
+        }
+        auto child = parse(elem.embeddedObject(), indices);
+        if (!child.isOK()) {
+            return child.getStatus();
+        }
+        tree->children.push_back(std::move(child.getValue()));
+    }
+    return {std::move(tree)};
+}
+
 std::unique_ptr<SolutionCacheData> SolutionCacheData::clone() const {
     auto other = std::make_unique<SolutionCacheData>();
     if (nullptr != this->tree.get()) {
@@ -125,6 +251,50 @@ std::string SolutionCacheData::toString() const {
     MONGO_UNREACHABLE;
 }
 
+BSONObj SolutionCacheData::toBSON() const {
+    BSONObjBuilder builder;
+    builder.append("solnType", static_cast<int>(solnType));
+    builder.append("wholeIXSolnDir", wholeIXSolnDir);
+    builder.append("indexFilterApplied", indexFilterApplied);
+    if (tree) {
+        builder.append("tree", tree->toBSON());
+    }
+    return builder.obj();
+}
+
+StatusWith<std::unique_ptr<SolutionCacheData>> SolutionCacheData::parse(
+    const BSONObj& obj, const std::vector<IndexEntry>& indices) {
+    auto data = std::make_unique<SolutionCacheData>();
+
+    auto solnType = obj["solnType"];
+    if (!solnType.isNumber() || solnType.numberInt() < WHOLE_IXSCAN_SOLN ||
+        solnType.numberInt() > USE_INDEX_TAGS_SOLN) {
+        return Status(ErrorCodes::BadValue,
+                      str::stream() << "Invalid solution type in plan cache data: " << obj);
+    }
+    data->solnType = static_cast<SolutionType>(solnType.numberInt());
+    data->wholeIXSolnDir = obj["wholeIXSolnDir"].numberInt() < 0 ? -1 : 1;
+    data->indexFilterApplied = obj["indexFilterApplied"].trueValue();
+
+    auto tree = obj["tree"];
+    if (tree.type() == BSONType::Object) {
+        auto parsedTree = PlanCacheIndexTree::parse(tree.embeddedObject(), indices);
+        if (!parsedTree.isOK()) {
+            return parsedTree.getStatus();
+        }
+        data->tree = std::move(parsedTree.getValue());
+    } else if (data->solnType != COLLSCAN_SOLN) {
+        return Status(ErrorCodes::BadValue,
+                      str::stream() << "Missing index tree in plan cache data: " << obj);
+    }
+    if (data->solnType == WHOLE_IXSCAN_SOLN && !data->tree->entry) {
+        return Status(ErrorCodes::BadValue,
+                      str::stream() << "Missing index for whole index scan in plan cache data: "
+                                    << obj);
+    }
+    return {std::move(data)};
+}
+
 bool shouldCacheQuery(const CanonicalQuery& query) {
     const FindCommandRequest& findCommand = query.getFindCommandRequest();
     const MatchExpression* expr = query.root();
@@ -149,6 +149,20 @@ struct PlanCacheIndexTree {
      */
     std::string toString(int indents = 0) const;
 
+    /**
+     * Serializes this tree to BSON. Indexes are only referred to by their identifiers, so the
+     * result remains meaningful across restarts as long as the indexes exist.
+     */
+    BSONObj toBSON() const;
+
+    /**
+     * Parses a tree serialized by 'toBSON()'. Each index is looked up by its identifier among
+     * 'indices', so that the parsed tree reflects the current state of the index. Fails if 'obj'
+     * is malformed or if any of the indexes it refers to is not among 'indices'.
+     */
+    static StatusWith<std::unique_ptr<PlanCacheIndexTree>> parse(
+        const BSONObj& obj, const std::vector<IndexEntry>& indices);
+
     uint64_t estimateObjectSizeInBytes() const {
         return  // Recursively add size of each element in 'children' vector.
             container_size_helper::estimateObjectSizeInBytes(
@@ -198,6 +212,14 @@ struct SolutionCacheData {
     // For debugging.
     std::string toString() const;
 
+    /**
+     * Serializes and parses the cache data, see 'PlanCacheIndexTree::toBSON()' and
+     * 'PlanCacheIndexTree::parse()'.
+     */
+    BSONObj toBSON() const;
+    static StatusWith<std::unique_ptr<SolutionCacheData>> parse(
+        const BSONObj& obj, const std::vector<IndexEntry>& indices);
+
     uint64_t estimateObjectSizeInBytes() const {
         return (tree ? tree->estimateObjectSizeInBytes() : 0) + sizeof(*this);
     }
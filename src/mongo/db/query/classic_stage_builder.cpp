@@ -87,6 +87,7 @@ std::unique_ptr<PlanStage> ClassicStageBuilder::build(const QuerySolutionNode* r
             params.resumeAfterRecordId = csn->resumeAfterRecordId;
             params.stopApplyingFilterAfterFirstMatch = csn->stopApplyingFilterAfterFirstMatch;
             params.boundInclusion = csn->boundInclusion;
+            params.shareScanPosition = csn->shareScanPosition;
             return std::make_unique<CollectionScan>(
                 expCtx, _collection, params, _ws, csn->filter.get());
         }
@@ -230,6 +231,7 @@ std::unique_ptr<PlanStage> ClassicStageBuilder::build(const QuerySolutionNode* r
             MergeSortStageParams params;
             params.dedup = msn->dedup;
             params.pattern = msn->sort;
+            params.mergeByRecordId = msn->mergeByRecordId;
             params.collator = _cq.getCollator();
             auto ret = std::make_unique<MergeSortStage>(expCtx, params, _ws);
             for (size_t i = 0; i < msn->children.size(); ++i) {
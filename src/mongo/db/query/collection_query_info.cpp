@@ -45,10 +45,12 @@
 #include "mongo/db/fts/fts_spec.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/index/wildcard_access_method.h"
+#include "mongo/db/index_names.h"
 #include "mongo/db/query/classic_plan_cache.h"
 #include "mongo/db/query/collection_index_usage_tracker_decoration.h"
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/planner_ixselect.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/service_context.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/clock_source.h"
@@ -77,6 +79,92 @@ CoreIndexInfo indexInfoFromIndexCatalogEntry(const IndexCatalogEntry& ice) {
             projExec};
 }
 
+/**
+ * Returns true if the cached plan 'tree' uses any of the indexes named in 'indexNames'.
+ */
+bool indexTreeUsesIndex(const PlanCacheIndexTree& tree, const StringSet& indexNames) {
+    if (tree.entry && indexNames.contains(tree.entry->identifier.catalogName)) {
+        return true;
+    }
+    for (auto&& orPushdown : tree.orPushdowns) {
+        if (indexNames.contains(orPushdown.indexEntryId.catalogName)) {
+            return true;
+        }
+    }
+    return std::any_of(tree.children.begin(), tree.children.end(), [&](auto&& child) {
+        return indexTreeUsesIndex(*child, indexNames);
+    });
+}
+
+/**
+ * Adds the paths referenced by the query predicate 'filter' to 'paths'. Returns false if the
+ * predicate contains an operator whose paths cannot be told from its BSON, such as $expr.
+ */
+bool addFilterPaths(const BSONObj& filter, std::vector<StringData>* paths) {
+    for (auto&& elem : filter) {
+        auto fieldName = elem.fieldNameStringData();
+        if (!fieldName.startsWith("$")) {
+            paths->push_back(fieldName);
+        } else if (fieldName == "$and"_sd || fieldName == "$or"_sd || fieldName == "$nor"_sd) {
+            for (auto&& child : elem.Obj()) {
+                if (child.type() != BSONType::Object || !addFilterPaths(child.Obj(), paths)) {
+                    return false;
+                }
+            }
+        } else if (fieldName != "$comment"_sd) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Returns true if one of the paths is a prefix of, or equal to, the other.
+ */
+bool pathsOverlap(StringData lhs, StringData rhs) {
+    auto isPrefix = [](StringData prefix, StringData path) {
+        return path.startsWith(prefix) &&
+            (path.size() == prefix.size() || path[prefix.size()] == '.');
+    };
+    return isPrefix(lhs, rhs) || isPrefix(rhs, lhs);
+}
+
+/**
+ * Returns true if the query a cached plan was created from might be answered with one of the
+ * indexes described by 'indexSpecs', that is if it has a predicate or a sort on one of their key
+ * fields. Errs on the side of returning true when the query is unknown.
+ */
+bool queryMayUseIndexes(const plan_cache_debug_info::DebugInfo* debugInfo,
+                        const std::vector<BSONObj>& indexSpecs) {
+    if (!debugInfo) {
+        return true;
+    }
+
+    std::vector<StringData> paths;
+    if (!addFilterPaths(debugInfo->createdFromQuery.filter, &paths)) {
+        return true;
+    }
+    for (auto&& sortElem : debugInfo->createdFromQuery.sort) {
+        paths.push_back(sortElem.fieldNameStringData());
+    }
+
+    for (auto&& spec : indexSpecs) {
+        auto keyPattern = spec.getObjectField(IndexDescriptor::kKeyPatternFieldName);
+        auto indexType = IndexNames::nameToType(IndexNames::findPluginName(keyPattern));
+        if (indexType == IndexType::INDEX_WILDCARD || indexType == IndexType::INDEX_TEXT) {
+            return true;
+        }
+        for (auto&& keyElem : keyPattern) {
+            for (auto&& path : paths) {
+                if (pathsOverlap(keyElem.fieldNameStringData(), path)) {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
 }  // namespace
 
 CollectionQueryInfo::PlanCacheState::PlanCacheState()
@@ -97,6 +185,8 @@ CollectionQueryInfo::PlanCacheState::PlanCacheState(OperationContext* opCtx,
         if (ice->accessMethod()) {
             indexCores.emplace_back(indexInfoFromIndexCatalogEntry(*ice));
         }
+        indexSpecs.emplace(ice->descriptor()->indexName(),
+                           std::make_pair(ice->descriptor()->infoObj(), ice->isReady(opCtx)));
     }
 
     planCacheIndexabilityState.updateDiscriminators(indexCores);
@@ -107,6 +197,41 @@ void CollectionQueryInfo::PlanCacheState::clearPlanCache() {
     planCacheInvalidator.clearPlanCache();
 }
 
+size_t CollectionQueryInfo::PlanCacheState::copyClassicPlanCacheEntries(
+    const PlanCacheState& previous) {
+    // Collect the indexes present in only one of the states, or whose spec or readiness differ.
+    // Modified indexes are described by both their old and new spec.
+    StringSet changedIndexNames;
+    std::vector<BSONObj> changedIndexSpecs;
+    auto collectChangedIndexes = [&](const auto& fromSpecs, const auto& toSpecs) {
+        for (auto&& [indexName, spec] : fromSpecs) {
+            auto it = toSpecs.find(indexName);
+            if (it == toSpecs.end() || it->second.second != spec.second ||
+                !it->second.first.binaryEqual(spec.first)) {
+                changedIndexNames.insert(indexName);
+                changedIndexSpecs.push_back(spec.first);
+            }
+        }
+    };
+    collectChangedIndexes(previous.indexSpecs, indexSpecs);
+    collectChangedIndexes(indexSpecs, previous.indexSpecs);
+
+    // Entries whose query may use a changed index are skipped even when their plan does not use
+    // it: either their key changed with the indexability discriminators and they are unreachable,
+    // or the query should be replanned to consider the new version of the index.
+    return classicPlanCache.copyIf(
+        previous.classicPlanCache, [&](const PlanCacheKey&, const PlanCacheEntry& entry) {
+            if (changedIndexNames.empty()) {
+                return true;
+            }
+            if (entry.cachedPlan->tree &&
+                indexTreeUsesIndex(*entry.cachedPlan->tree, changedIndexNames)) {
+                return false;
+            }
+            return !queryMayUseIndexes(entry.debugInfo.get(), changedIndexSpecs);
+        });
+}
+
 CollectionQueryInfo::CollectionQueryInfo()
     : _keysComputed{false}, _planCacheState{std::make_shared<PlanCacheState>()} {}
 
@@ -225,17 +350,47 @@ void CollectionQueryInfo::clearQueryCache(OperationContext* opCtx, const Collect
     }
 }
 
-void CollectionQueryInfo::clearQueryCacheForSetMultikey(const CollectionPtr& coll) const {
-    LOGV2_DEBUG(5014500,
+void CollectionQueryInfo::clearQueryCacheForSetMultikey(const CollectionPtr& coll,
+                                                        StringData indexName) const {
+    if (!internalQueryCacheIncrementalInvalidation.load()) {
+        LOGV2_DEBUG(5014500,
+                    1,
+                    "Clearing plan cache for multikey - collection info cache cleared",
+                    "namespace"_attr = coll->ns());
+        _planCacheState->clearPlanCache();
+        return;
+    }
+
+    // Plans which do not use the index are unaffected by its multikeyness. The SBE plan cache
+    // entries are not tracked per index and are all invalidated.
+    StringSet indexNames{indexName.toString()};
+    auto nRemoved = _planCacheState->classicPlanCache.removeIf(
+        [&](const PlanCacheKey&, const PlanCacheEntry& entry) {
+            return entry.cachedPlan->tree &&
+                indexTreeUsesIndex(*entry.cachedPlan->tree, indexNames);
+        });
+    _planCacheState->planCacheInvalidator.clearPlanCache();
+    LOGV2_DEBUG(7000116,
                 1,
-                "Clearing plan cache for multikey - collection info cache cleared",
-                "namespace"_attr = coll->ns());
-    _planCacheState->clearPlanCache();
+                "Removed the cached plans using an index set to multikey",
+                "namespace"_attr = coll->ns(),
+                "index"_attr = indexName,
+                "numRemoved"_attr = nRemoved);
 }
 
 void CollectionQueryInfo::updatePlanCacheIndexEntries(OperationContext* opCtx,
                                                       const CollectionPtr& coll) {
-    _planCacheState = std::make_shared<PlanCacheState>(opCtx, coll);
+    auto planCacheState = std::make_shared<PlanCacheState>(opCtx, coll);
+    if (internalQueryCacheIncrementalInvalidation.load()) {
+        auto nCopied = planCacheState->copyClassicPlanCacheEntries(*_planCacheState);
+        LOGV2_DEBUG(7000117,
+                    1,
+                    "Carried cached plans over to the rebuilt plan cache",
+                    "namespace"_attr = coll->ns(),
+                    "numCopied"_attr = nCopied,
+                    "numPrevious"_attr = _planCacheState->classicPlanCache.size());
+    }
+    _planCacheState = std::move(planCacheState);
 }
 
 void CollectionQueryInfo::init(OperationContext* opCtx, const CollectionPtr& coll) {
@@ -35,6 +35,7 @@
 #include "mongo/db/query/plan_cache_invalidator.h"
 #include "mongo/db/query/plan_summary_stats.h"
 #include "mongo/db/update_index_data.h"
+#include "mongo/util/string_map.h"
 
 namespace mongo {
 
@@ -92,7 +93,8 @@ public:
 
     /**
      * Rebuilds cached index information. Must be called when an index is modified or an index is
-     * dropped/created.
+     * dropped/created. Cached classic plans which neither use nor could use the indexes which
+     * changed are carried over to the rebuilt plan cache.
      *
      * Must be called under exclusive collection lock.
      */
@@ -106,11 +108,11 @@ public:
     void clearQueryCache(OperationContext* opCtx, const CollectionPtr& coll);
 
     /**
-     * Removes all cached query plans without ensuring that the PlanCache is uniquely owned, only
-     * allowed when setting an index to multikey. Setting an index to multikey can only go one way
-     * and has its own concurrency handling.
+     * Removes the cached query plans which use the index 'indexName' without ensuring that the
+     * PlanCache is uniquely owned, only allowed when setting an index to multikey. Setting an index
+     * to multikey can only go one way and has its own concurrency handling.
      */
-    void clearQueryCacheForSetMultikey(const CollectionPtr& coll) const;
+    void clearQueryCacheForSetMultikey(const CollectionPtr& coll, StringData indexName) const;
 
     void notifyOfQuery(OperationContext* opCtx,
                        const CollectionPtr& coll,
@@ -133,6 +135,14 @@ private:
          */
         void clearPlanCache();
 
+        /**
+         * Copies the classic cache entries of 'previous' which are still valid for the indexes of
+         * this state: entries whose plan uses an index which was created, dropped or modified in
+         * between are skipped, as well as entries whose query the changed indexes may now answer.
+         * Returns the number of copied entries.
+         */
+        size_t copyClassicPlanCacheEntries(const PlanCacheState& previous);
+
         // Per collection version classic plan cache.
         PlanCache classicPlanCache;
 
@@ -143,6 +153,10 @@ private:
         // Holds computed information about the collection's indexes. Used for generating plan
         // cache keys.
         PlanCacheIndexabilityState planCacheIndexabilityState;
+
+        // The spec of each index the state above was computed from, by index name, along with
+        // whether the index was ready.
+        StringMap<std::pair<BSONObj, bool>> indexSpecs;
     };
 
     void computeIndexKeys(OperationContext* opCtx, const CollectionPtr& coll);
@@ -477,6 +477,10 @@ void Explain::planCacheEntryToBSON(const sbe::PlanCacheEntry& entry, BSONObjBuil
 
     out->append("indexFilterSet", entry.cachedPlan->indexFilterApplied);
     out->append("isPinned", entry.isPinned());
+    if (auto&& compileStats = entry.cachedPlan->planStageData.compileStats) {
+        out->append("numCompilations", compileStats->numCompilations.load());
+        out->append("compileTimeMicros", compileStats->compileTimeMicros.load());
+    }
     out->append("estimatedSizeBytes", static_cast<long long>(entry.estimatedEntrySizeBytes));
 }
 }  // namespace mongo
@@ -37,7 +37,9 @@
 #include "mongo/db/curop.h"
 #include "mongo/db/curop_failpoint_helpers.h"
 #include "mongo/db/query/canonical_query.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_request_helper.h"
+#include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/assert_util.h"
 
@@ -87,6 +89,24 @@ bool FindCommon::haveSpaceForNext(const BSONObj& nextDoc, long long numDocs, siz
     return (bytesBuffered + nextDoc.objsize()) <= kMaxBytesToReturnToClientAtOnce;
 }
 
+bool FindCommon::shouldReadOnce(OperationContext* opCtx,
+                                const NamespaceString& nss,
+                                bool requested,
+                                bool isTailable) {
+    if (requested) {
+        return true;
+    }
+    if (!internalQueryUseReadOnceCursorsOnSecondaries.load() || isTailable ||
+        opCtx->inMultiDocumentTransaction()) {
+        return false;
+    }
+
+    // Lock-free reads do not hold the RSTL, so the replication state can only be sampled here. A
+    // stale answer only affects whether the storage engine caches the data read.
+    auto replCoord = repl::ReplicationCoordinator::get(opCtx);
+    return replCoord && !replCoord->canAcceptWritesFor_UNSAFE(opCtx, nss);
+}
+
 void FindCommon::waitInFindBeforeMakingBatch(OperationContext* opCtx, const CanonicalQuery& cq) {
     auto whileWaitingFunc = [&, hasLogged = false]() mutable {
         if (!std::exchange(hasLogged, true)) {
@@ -104,7 +124,7 @@ void FindCommon::waitInFindBeforeMakingBatch(OperationContext* opCtx, const Cano
 }
 
 std::size_t FindCommon::getBytesToReserveForGetMoreReply(bool isTailable,
-                                                         size_t firstResultSize,
+                                                         size_t estimatedResultSize,
                                                          size_t batchSize) {
 #ifdef _WIN32
     // SERVER-22100: In Windows DEBUG builds, the CRT heap debugging overhead, in
@@ -118,13 +138,13 @@ std::size_t FindCommon::getBytesToReserveForGetMoreReply(bool isTailable,
     // A tailable cursor may often return 0 or very few results. Allocate a small initial
     // buffer. This buffer should be big-enough to accomodate for at least one document.
     if (isTailable) {
-        return std::max(firstResultSize, kTailableGetMoreReplyBufferSize);
+        return std::max(estimatedResultSize, kTailableGetMoreReplyBufferSize);
     }
 
     // A getMore with batchSize is likely to return limited results. Allocate a medium
     // initial buffer based on an estimate of document sizes and the given batch size.
     if (batchSize > 0) {
-        size_t estmtObjSize = std::max(kMinDocSizeForGetMorePreAllocation, firstResultSize);
+        size_t estmtObjSize = std::max(kMinDocSizeForGetMorePreAllocation, estimatedResultSize);
         return std::min(estmtObjSize * batchSize, kMaxBytesToReturnToClientAtOnce);
     }
 
@@ -133,6 +153,39 @@ std::size_t FindCommon::getBytesToReserveForGetMoreReply(bool isTailable,
     // command metadata to the reply.
     return kMaxBytesToReturnToClientAtOnce;
 }
+std::size_t FindCommon::getBytesToReserveForFirstBatch(const FindCommandRequest& findCommand,
+                                                       size_t firstResultSize) {
+#ifdef _WIN32
+    // See SERVER-22100 above.
+    if (kDebugBuild)
+        return 0;
+#endif
+
+    // A singleBatch find returns only this batch, so it is bounded the same way.
+    std::int64_t maxResults =
+        findCommand.getBatchSize().value_or(query_request_helper::kDefaultBatchSize);
+    if (auto limit = findCommand.getLimit()) {
+        maxResults = std::min(maxResults, *limit);
+    }
+
+    // A batch of a single result, e.g. a findOne, fits in the default buffer with no reallocation
+    // worth avoiding.
+    if (maxResults <= 1) {
+        return 0;
+    }
+
+    size_t estimatedBytes = std::max(kMinDocSizeForGetMorePreAllocation, firstResultSize) *
+        static_cast<size_t>(maxResults);
+
+    // A tailable cursor may often return only a few results, so don't reserve more than for a
+    // tailable getMore.
+    if (findCommand.getTailable()) {
+        estimatedBytes =
+            std::min(estimatedBytes, std::max(firstResultSize, kTailableGetMoreReplyBufferSize));
+    }
+    return std::min(estimatedBytes, kMaxBytesToReturnToClientAtOnce);
+}
+
 bool FindCommon::BSONArrayResponseSizeTracker::haveSpaceForNext(const BSONObj& document) {
     return FindCommon::haveSpaceForNext(document, _numberOfDocuments, _bsonArraySizeInBytes);
 }
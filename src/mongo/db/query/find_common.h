@@ -133,6 +133,20 @@ public:
      */
     static bool haveSpaceForNext(const BSONObj& nextDoc, long long numDocs, size_t bytesBuffered);
 
+    /**
+     * Returns true if storage-layer cursors opened on behalf of this read should assume the data
+     * they read will not be needed again, so that it need not be cached. This is the case when
+     * the client asked for 'readOnce', or when 'internalQueryUseReadOnceCursorsOnSecondaries' is
+     * enabled and the node cannot accept writes for 'nss'. Tailable cursors and reads in a
+     * multi-document transaction never use readOnce cursors implicitly.
+     *
+     * Does not require the RSTL to be held, so it may be called from lock-free reads.
+     */
+    static bool shouldReadOnce(OperationContext* opCtx,
+                               const NamespaceString& nss,
+                               bool requested,
+                               bool isTailable);
+
     /**
      * This function wraps waitWhileFailPointEnabled() on waitInFindBeforeMakingBatch.
      *
@@ -144,11 +158,21 @@ public:
 
     /**
      * Computes an initial preallocation size for the GetMore reply buffer based on its properties.
+     * 'estimatedResultSize' is the expected size of each result in the batch.
      */
     static std::size_t getBytesToReserveForGetMoreReply(bool isTailable,
-                                                        size_t firstResultSize,
+                                                        size_t estimatedResultSize,
                                                         size_t batchSize);
 
+    /**
+     * Computes an initial preallocation size for the reply buffer of the first batch of
+     * 'findCommand', given the size of its first result. The estimate never exceeds the number of
+     * results the first batch can hold, as bounded by the limit and the batch size, so that e.g. a
+     * findOne reserves nothing beyond its single result.
+     */
+    static std::size_t getBytesToReserveForFirstBatch(const FindCommandRequest& findCommand,
+                                                      size_t firstResultSize);
+
     /**
      * Tracker of a size of a server response presented as a BSON array. Facilitates limiting the
      * server response size to 16MB + certain epsilon. Accounts for array element and it's overhead
@@ -33,7 +33,14 @@
 
 #include "mongo/bson/bsonobj.h"
 #include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/config.h"
+#include "mongo/db/db_raii.h"
+#include "mongo/db/query/find_command_gen.h"
 #include "mongo/db/query/find_common.h"
+#include "mongo/db/query/query_request_helper.h"
+#include "mongo/db/repl/replication_coordinator_mock.h"
+#include "mongo/db/service_context_d_test_fixture.h"
+#include "mongo/idl/server_parameter_test_util.h"
 
 #include "mongo/unittest/unittest.h"
 
@@ -71,4 +78,96 @@ TEST(BSONArrayResponseSizeTrackerTest, CanAddAtLeastOneDocument) {
     // If the BSON object is successfully constructed, then space accounting was correct.
     bsonObjBuilder.obj();
 }
+
+// Windows DEBUG builds never preallocate reply buffers, see SERVER-22100.
+#if !defined(_WIN32) || !defined(MONGO_CONFIG_DEBUG_BUILD)
+TEST(FirstBatchReplyBufferTest, ReservesNothingForASingleResult) {
+    FindCommandRequest findOne(NamespaceString("test.coll"));
+    findOne.setLimit(1);
+    findOne.setSingleBatch(true);
+    ASSERT_EQ(FindCommon::getBytesToReserveForFirstBatch(findOne, 100), 0U);
+
+    FindCommandRequest emptyBatch(NamespaceString("test.coll"));
+    emptyBatch.setBatchSize(0);
+    ASSERT_EQ(FindCommon::getBytesToReserveForFirstBatch(emptyBatch, 100), 0U);
+}
+
+TEST(FirstBatchReplyBufferTest, ReservesForTheResultsTheFirstBatchCanHold) {
+    const auto minDocSize = FindCommon::kMinDocSizeForGetMorePreAllocation;
+
+    FindCommandRequest unbounded(NamespaceString("test.coll"));
+    ASSERT_EQ(FindCommon::getBytesToReserveForFirstBatch(unbounded, 100),
+              minDocSize * query_request_helper::kDefaultBatchSize);
+
+    FindCommandRequest limited(NamespaceString("test.coll"));
+    limited.setLimit(10);
+    limited.setSingleBatch(true);
+    ASSERT_EQ(FindCommon::getBytesToReserveForFirstBatch(limited, 100), minDocSize * 10);
+    ASSERT_EQ(FindCommon::getBytesToReserveForFirstBatch(limited, 2 * minDocSize),
+              2 * minDocSize * 10);
+
+    limited.setBatchSize(5);
+    ASSERT_EQ(FindCommon::getBytesToReserveForFirstBatch(limited, 100), minDocSize * 5);
+
+    FindCommandRequest largeDocs(NamespaceString("test.coll"));
+    ASSERT_EQ(FindCommon::getBytesToReserveForFirstBatch(largeDocs, 1024 * 1024),
+              FindCommon::kMaxBytesToReturnToClientAtOnce);
+}
+
+TEST(FirstBatchReplyBufferTest, TailableFindReservesAtMostATailableGetMoreBuffer) {
+    FindCommandRequest tailable(NamespaceString("test.coll"));
+    tailable.setTailable(true);
+    ASSERT_EQ(FindCommon::getBytesToReserveForFirstBatch(tailable, 100),
+              FindCommon::kMinDocSizeForGetMorePreAllocation *
+                  query_request_helper::kDefaultBatchSize);
+    ASSERT_EQ(FindCommon::getBytesToReserveForFirstBatch(tailable, 1024 * 1024),
+              FindCommon::kTailableGetMoreReplyBufferSize);
+}
+#endif
+
+class ShouldReadOnceTest : public ServiceContextMongoDTest {
+protected:
+    void setUp() override {
+        ServiceContextMongoDTest::setUp();
+        auto replCoord = std::make_unique<repl::ReplicationCoordinatorMock>(getServiceContext());
+        ASSERT_OK(replCoord->setFollowerMode(repl::MemberState::RS_SECONDARY));
+        repl::ReplicationCoordinator::set(getServiceContext(), std::move(replCoord));
+    }
+
+    const NamespaceString _nss{"test.coll"};
+};
+
+TEST_F(ShouldReadOnceTest, LockFreeReadOnSecondaryUsesReadOnceWhenEnabled) {
+    RAIIServerParameterControllerForTest knob("internalQueryUseReadOnceCursorsOnSecondaries",
+                                              true);
+    auto opCtx = makeOperationContext();
+
+    // A lock-free read does not hold the RSTL, so deciding on readOnce must not require it.
+    AutoGetCollectionForReadLockFree autoColl(opCtx.get(), _nss);
+    ASSERT_FALSE(opCtx->lockState()->isRSTLLocked());
+
+    ASSERT_TRUE(FindCommon::shouldReadOnce(opCtx.get(), _nss, false /* requested */, false));
+    ASSERT_FALSE(FindCommon::shouldReadOnce(opCtx.get(), _nss, false /* requested */, true));
+}
+
+TEST_F(ShouldReadOnceTest, OnlyRequestedReadOnceWhenKnobIsOff) {
+    RAIIServerParameterControllerForTest knob("internalQueryUseReadOnceCursorsOnSecondaries",
+                                              false);
+    auto opCtx = makeOperationContext();
+    AutoGetCollectionForReadLockFree autoColl(opCtx.get(), _nss);
+
+    ASSERT_FALSE(FindCommon::shouldReadOnce(opCtx.get(), _nss, false /* requested */, false));
+    ASSERT_TRUE(FindCommon::shouldReadOnce(opCtx.get(), _nss, true /* requested */, false));
+}
+
+TEST_F(ShouldReadOnceTest, PrimaryDoesNotUseReadOnceImplicitly) {
+    RAIIServerParameterControllerForTest knob("internalQueryUseReadOnceCursorsOnSecondaries",
+                                              true);
+    auto replCoord = repl::ReplicationCoordinator::get(getServiceContext());
+    ASSERT_OK(replCoord->setFollowerMode(repl::MemberState::RS_PRIMARY));
+    auto opCtx = makeOperationContext();
+    AutoGetCollectionForReadLockFree autoColl(opCtx.get(), _nss);
+
+    ASSERT_FALSE(FindCommon::shouldReadOnce(opCtx.get(), _nss, false /* requested */, false));
+}
 }  // namespace
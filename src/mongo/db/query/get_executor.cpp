@@ -93,6 +93,8 @@
 #include "mongo/db/query/sbe_sub_planner.h"
 #include "mongo/db/query/sbe_utils.h"
 #include "mongo/db/query/stage_builder_util.h"
+#include "mongo/db/query/stats/plan_pruning.h"
+#include "mongo/db/query/stats/stats_catalog.h"
 #include "mongo/db/query/util/make_data_structure.h"
 #include "mongo/db/query/wildcard_multikey_paths.h"
 #include "mongo/db/query/yield_policy_callbacks_impl.h"
@@ -164,6 +166,21 @@ bool isIdHackEligibleQuery(const CollectionPtr& collection, const CanonicalQuery
         !findCommand.getTailable() &&
         CollatorInterface::collatorsMatch(query.getCollator(), collection->getDefaultCollator());
 }
+
+/**
+ * Returns 'true' if 'query' on the given 'collection' can be answered using an IDHACK plan which
+ * looks up each value of an $in over _id. Such a plan returns the documents in storage order and
+ * does not apply a limit, so the query must not have a sort or a limit.
+ */
+bool isBatchedIdHackEligibleQuery(const CollectionPtr& collection, const CanonicalQuery& query) {
+    const auto& findCommand = query.getFindCommandRequest();
+    return internalQueryEnableBatchedIdHack.load() && !findCommand.getShowRecordId() &&
+        findCommand.getHint().isEmpty() && findCommand.getMin().isEmpty() &&
+        findCommand.getMax().isEmpty() && !findCommand.getSkip() && !findCommand.getLimit() &&
+        findCommand.getSort().isEmpty() && !findCommand.getReturnKey() &&
+        !findCommand.getTailable() && CanonicalQuery::isSimpleIdInQuery(findCommand.getFilter()) &&
+        CollatorInterface::collatorsMatch(query.getCollator(), collection->getDefaultCollator());
+}
 }  // namespace
 
 bool isAnyComponentOfPathMultikey(const BSONObj& indexKeyPattern,
@@ -309,6 +326,31 @@ void fillOutIndexEntries(OperationContext* opCtx,
             indexEntryFromIndexCatalogEntry(opCtx, collection, *ice, canonicalQuery));
     }
 }
+
+/**
+ * Allows skip-scanning the compound indexes whose leading field has at most
+ * 'internalQueryPlannerMaxSkipScanLeadingValues' distinct values according to its histogram. Only
+ * the cached histograms are consulted, so no index is skip-scanned until the statistics of the
+ * collection have been loaded in the background.
+ */
+void markSkipScanIndexes(OperationContext* opCtx,
+                         const CollectionPtr& collection,
+                         QueryPlannerParams* plannerParams) {
+    const int maxLeadingValues = internalQueryPlannerMaxSkipScanLeadingValues.load();
+    if (maxLeadingValues <= 0) {
+        return;
+    }
+
+    for (auto&& entry : plannerParams->indices) {
+        if (entry.type != INDEX_BTREE || entry.multikey || entry.keyPattern.nFields() < 2) {
+            continue;
+        }
+        auto histogram = stats::StatsCatalog::get(opCtx).getHistogram(
+            opCtx, collection->ns(), entry.keyPattern.firstElementFieldName());
+        entry.allowSkipScan = histogram && histogram->canEstimate() &&
+            histogram->getDistinctValues() <= maxLeadingValues;
+    }
+}
 }  // namespace
 
 void fillOutPlannerParams(OperationContext* opCtx,
@@ -325,6 +367,8 @@ void fillOutPlannerParams(OperationContext* opCtx,
         plannerParams->columnarIndexes.push_back(ColumnIndexEntry{"fakeColumnIndex"});
     }
 
+    markSkipScanIndexes(opCtx, collection, plannerParams);
+
     // If query supports index filters, filter params.indices by indices in query settings.
     // Ignore index filters when it is possible to use the id-hack.
     applyIndexFilters(collection, *canonicalQuery, plannerParams);
@@ -690,6 +734,10 @@ public:
             }
         }
 
+        if (solutions.size() > 1 && internalQueryPlannerEnableHistogramPruning.load()) {
+            stats::pruneSolutions(_opCtx, mainColl, &solutions);
+        }
+
         if (1 == solutions.size()) {
             // Only one possible plan. Build the stages from the solution.
             auto result = makeResult();
@@ -799,7 +847,12 @@ protected:
     }
 
     std::unique_ptr<ClassicPrepareExecutionResult> buildIdHackPlan() {
-        if (!isIdHackEligibleQuery(_collection, *_cq))
+        const bool isBatched = !isIdHackEligibleQuery(_collection, *_cq);
+        if (isBatched && !isBatchedIdHackEligibleQuery(_collection, *_cq))
+            return nullptr;
+        // Unlike single _id lookups, $in queries on _id are subject to index filters. Leave them to
+        // the planner when a filter applies to their shape.
+        if (isBatched && _plannerParams.indexFiltersApplied)
             return nullptr;
         const IndexDescriptor* descriptor = _collection->getIndexCatalog()->findIdIndex(_opCtx);
         if (!descriptor)
@@ -811,8 +864,18 @@ protected:
                     "canonicalQuery"_attr = redact(_cq->toStringShort()));
 
         auto result = makeResult();
-        std::unique_ptr<PlanStage> stage =
-            std::make_unique<IDHackStage>(_cq->getExpCtxRaw(), _cq, _ws, _collection, descriptor);
+        std::unique_ptr<PlanStage> stage;
+        if (isBatched) {
+            std::vector<BSONObj> keys;
+            for (auto&& value : _cq->getQueryObj()["_id"]["$in"].Obj()) {
+                keys.push_back(value.wrap("_id"));
+            }
+            stage = std::make_unique<IDHackStage>(
+                _cq->getExpCtxRaw(), std::move(keys), _ws, _collection, descriptor);
+        } else {
+            stage = std::make_unique<IDHackStage>(
+                _cq->getExpCtxRaw(), _cq, _ws, _collection, descriptor);
+        }
 
         // Might have to filter out orphaned docs.
         if (_plannerParams.options & QueryPlannerParams::INCLUDE_SHARD_FILTER) {
@@ -1100,7 +1163,7 @@ protected:
                 auto&& planCache = sbe::getPlanCache(_opCtx);
                 auto cacheEntry = planCache.getCacheEntryIfActive(planCacheKey);
                 if (!cacheEntry) {
-                    return nullptr;
+                    return buildCachedPlanFromSharedShapeCache(planCacheKey);
                 }
 
                 auto&& cachedPlan = std::move(cacheEntry->cachedPlan);
@@ -1121,6 +1184,55 @@ protected:
         return buildIdHackPlan();
     }
 
+    // Rebuilds the plan from a solution which was picked for another collection with the same
+    // query shape and indexes, see 'sbe::SharedShapePlanCache'. Returns nullptr if there's none.
+    std::unique_ptr<SlotBasedPrepareExecutionResult> buildCachedPlanFromSharedShapeCache(
+        const sbe::PlanCacheKey& planCacheKey) {
+        auto&& sharedCache = sbe::SharedShapePlanCache::get(_opCtx->getServiceContext());
+        if (!sharedCache.isEnabled()) {
+            return nullptr;
+        }
+
+        initializePlannerParamsIfNeeded();
+        if (_plannerParams.indexFiltersApplied) {
+            // Index filters are set per collection, so a solution picked for another collection
+            // might not obey them.
+            return nullptr;
+        }
+
+        auto entry = sharedCache.find(
+            plan_cache_key_factory::makeSharedShapeKey(_opCtx, planCacheKey, getMainCollection()));
+        if (!entry) {
+            return nullptr;
+        }
+
+        // Resolve the indexes of the cached solution against those of this collection, which
+        // might differ in how they are multikey.
+        auto cacheData = SolutionCacheData::parse(entry->solution, _plannerParams.indices);
+        if (!cacheData.isOK()) {
+            return nullptr;
+        }
+
+        CachedSolution cs{std::move(cacheData.getValue()), entry->decisionWorks, nullptr};
+        auto statusWithQs = QueryPlanner::planFromCache(*_cq, _plannerParams, cs);
+        if (!statusWithQs.isOK()) {
+            return nullptr;
+        }
+
+        auto querySolution = std::move(statusWithQs.getValue());
+        if ((_plannerParams.options & QueryPlannerParams::IS_COUNT) &&
+            turnIxscanIntoCount(querySolution.get())) {
+            LOGV2_DEBUG(
+                7000107, 2, "Using fast count", "query"_attr = redact(_cq->toStringShort()));
+        }
+
+        auto result = makeResult();
+        auto&& execTree = buildExecutableTree(*querySolution);
+        result->emplace(std::move(execTree), std::move(querySolution));
+        result->setDecisionWorks(entry->decisionWorks);
+        return result;
+    }
+
     // A temporary function to allow recovering SBE plans from the classic plan cache.
     // TODO SERVER-61314: Remove this function when "featureFlagSbePlanCache" is removed.
     std::unique_ptr<SlotBasedPrepareExecutionResult> buildCachedPlanFromClassicCache() {
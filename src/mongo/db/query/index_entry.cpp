@@ -51,6 +51,10 @@ std::string IndexEntry::toString() const {
         sb << " unique";
     }
 
+    if (allowSkipScan) {
+        sb << " allowSkipScan";
+    }
+
     sb << " name: '" << identifier << "'";
 
     if (filterExpr) {
@@ -252,6 +252,11 @@ struct IndexEntry : CoreIndexInfo {
 
     // Geo indices have extra parameters.  We need those available to plan correctly.
     BSONObj infoObj;
+
+    // Whether the leading field of this index has few enough distinct values that the index can be
+    // skip-scanned for predicates on its second field: the scan covers all values of the leading
+    // field, and the index bounds checker seeks from one leading value to the next.
+    bool allowSkipScan = false;
 };
 
 /**
@@ -582,6 +582,7 @@ Memo::Memo(DebugInfo debugInfo,
     : _groups(),
       _inputGroupsToNodeIdMap(),
       _nodeIdToInputGroupsMap(),
+      _nodeIdToHashMap(),
       _metadata(metadata),
       _logicalPropsDerivation(std::move(logicalPropsDerivation)),
       _ceDerivation(std::move(ceDerivation)),
@@ -623,11 +624,13 @@ ABT::reference_type Memo::getNode(const MemoLogicalNodeId nodeMemoId) const {
     return getGroup(nodeMemoId._groupId)._logicalNodes.at(nodeMemoId._index);
 }
 
-std::pair<MemoLogicalNodeId, bool> Memo::findNode(const GroupIdVector& groups, const ABT& node) {
+std::pair<MemoLogicalNodeId, bool> Memo::findNode(const GroupIdVector& groups,
+                                                  const ABT& node,
+                                                  const size_t nodeHash) {
     const auto it = _inputGroupsToNodeIdMap.find(groups);
     if (it != _inputGroupsToNodeIdMap.cend()) {
         for (const MemoLogicalNodeId& nodeMemoId : it->second) {
-            if (getNode(nodeMemoId) == node) {
+            if (_nodeIdToHashMap.at(nodeMemoId) == nodeHash && getNode(nodeMemoId) == node) {
                 return {nodeMemoId, true};
             }
         }
@@ -678,7 +681,8 @@ MemoLogicalNodeId Memo::addNode(GroupIdVector groupVector,
         uassert(6624127, "Target group appears inside group vector", groupId != targetGroupId);
     }
 
-    auto [existingId, foundNode] = findNode(groupVector, n);
+    const size_t nodeHash = ABTHashGenerator::generate(n);
+    auto [existingId, foundNode] = findNode(groupVector, n, nodeHash);
 
     if (foundNode) {
         uassert(6624054,
@@ -701,6 +705,7 @@ MemoLogicalNodeId Memo::addNode(GroupIdVector groupVector,
         insertedNodeIds.insert(newId);
         _inputGroupsToNodeIdMap[groupVector].insert(newId);
         _nodeIdToInputGroupsMap[newId] = groupVector;
+        _nodeIdToHashMap[newId] = nodeHash;
 
         if (noTargetGroup) {
             estimateCE(groupId);
@@ -743,6 +748,7 @@ void Memo::clearLogicalNodes(const GroupIdType groupId) {
         const auto& groupVector = _nodeIdToInputGroupsMap.at(nodeId);
         _inputGroupsToNodeIdMap.at(groupVector).erase(nodeId);
         _nodeIdToInputGroupsMap.erase(nodeId);
+        _nodeIdToHashMap.erase(nodeId);
     }
 
     logicalNodes.clear();
@@ -762,6 +768,7 @@ void Memo::clear() {
     _groups.clear();
     _inputGroupsToNodeIdMap.clear();
     _nodeIdToInputGroupsMap.clear();
+    _nodeIdToHashMap.clear();
 }
 
 const Memo::Stats& Memo::getStats() const {
@@ -227,7 +227,9 @@ private:
 
     std::pair<MemoLogicalNodeId, bool> addNode(GroupIdType groupId, ABT n);
 
-    std::pair<MemoLogicalNodeId, bool> findNode(const GroupIdVector& groups, const ABT& node);
+    std::pair<MemoLogicalNodeId, bool> findNode(const GroupIdVector& groups,
+                                                const ABT& node,
+                                                size_t nodeHash);
 
     std::vector<std::unique_ptr<Group>> _groups;
 
@@ -236,6 +238,10 @@ private:
 
     NodeIdToInputGroupsMap _nodeIdToInputGroupsMap;
 
+    // Hash of each logical node, computed once on insertion. Many nodes can share the same input
+    // groups, so findNode() compares hashes before falling back to a deep ABT comparison.
+    opt::unordered_map<MemoLogicalNodeId, size_t, NodeIdHash> _nodeIdToHashMap;
+
     const Metadata& _metadata;
     std::unique_ptr<LogicalPropsInterface> _logicalPropsDerivation;
     std::unique_ptr<CEInterface> _ceDerivation;
@@ -0,0 +1,127 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/db/query/optimizer/metadata.h"
+#include "mongo/db/query/optimizer/node.h"
+#include "mongo/db/query/optimizer/opt_phase_manager.h"
+#include "mongo/db/query/optimizer/utils/unit_test_utils.h"
+
+namespace mongo::optimizer {
+namespace {
+
+std::string fieldName(int i) {
+    return "a" + std::to_string(i);
+}
+
+ABT makeEqPath(const std::string& field, int64_t value) {
+    return make<PathGet>(
+        field, make<PathTraverse>(make<PathCompare>(Operations::Eq, Constant::int64(value))));
+}
+
+/**
+ * Metadata for collection "c1" with a single-field index on each of the first 'numIndexes' fields.
+ */
+Metadata makeMetadata(int numIndexes) {
+    opt::unordered_map<std::string, IndexDefinition> indexDefs;
+    for (int i = 0; i < numIndexes; ++i) {
+        indexDefs.emplace("index_" + fieldName(i),
+                          makeIndexDefinition(fieldName(i), CollationOp::Ascending));
+    }
+    return {{{"c1", ScanDefinition{{}, std::move(indexDefs)}}}};
+}
+
+/**
+ * Optimizes 'rootNode' with every rewrite phase enabled and production debug settings, and
+ * reports the size of the resulting memo.
+ */
+void benchmarkOptimize(benchmark::State& state, const ABT& rootNode, const Metadata& metadata) {
+    size_t groups = 0;
+    size_t logicalNodes = 0;
+    size_t physicalNodes = 0;
+    for (auto keepRunning : state) {
+        PrefixId prefixId;
+        OptPhaseManager phaseManager(OptPhaseManager::getAllRewritesSet(),
+                                     prefixId,
+                                     metadata,
+                                     DebugInfo::kDefaultForProd);
+        ABT optimized = rootNode;
+        invariant(phaseManager.optimize(optimized));
+        benchmark::DoNotOptimize(optimized);
+
+        groups = phaseManager.getMemo().getGroupCount();
+        logicalNodes = phaseManager.getMemo().getLogicalNodeCount();
+        physicalNodes = phaseManager.getMemo().getPhysicalNodeCount();
+    }
+    state.counters["memoGroups"] = groups;
+    state.counters["memoLogicalNodes"] = logicalNodes;
+    state.counters["memoPhysicalNodes"] = physicalNodes;
+}
+
+/**
+ * A chain of state.range(0) equality filters on distinct fields, each of which has an index.
+ */
+void BM_OptimizeIndexedConjunction(benchmark::State& state) {
+    const int numPredicates = state.range(0);
+    ABT node = make<ScanNode>("root", "c1");
+    for (int i = 0; i < numPredicates; ++i) {
+        node = make<FilterNode>(
+            make<EvalFilter>(makeEqPath(fieldName(i), i), make<Variable>("root")),
+            std::move(node));
+    }
+    ABT rootNode = make<RootNode>(
+        properties::ProjectionRequirement{ProjectionNameVector{"root"}}, std::move(node));
+    benchmarkOptimize(state, rootNode, makeMetadata(numPredicates));
+}
+
+/**
+ * A single filter which is a disjunction of state.range(0) equality predicates on distinct indexed
+ * fields, the shape of a $or with one branch per field.
+ */
+void BM_OptimizeIndexedDisjunction(benchmark::State& state) {
+    const int numBranches = state.range(0);
+    ABT path = makeEqPath(fieldName(0), 0);
+    for (int i = 1; i < numBranches; ++i) {
+        path = make<PathComposeA>(std::move(path), makeEqPath(fieldName(i), i));
+    }
+    ABT rootNode = make<RootNode>(
+        properties::ProjectionRequirement{ProjectionNameVector{"root"}},
+        make<FilterNode>(make<EvalFilter>(std::move(path), make<Variable>("root")),
+                         make<ScanNode>("root", "c1")));
+    benchmarkOptimize(state, rootNode, makeMetadata(numBranches));
+}
+
+BENCHMARK(BM_OptimizeIndexedConjunction)->DenseRange(1, 4)->Arg(8)->Arg(16);
+BENCHMARK(BM_OptimizeIndexedDisjunction)->DenseRange(1, 4)->Arg(8)->Arg(16);
+
+}  // namespace
+}  // namespace mongo::optimizer
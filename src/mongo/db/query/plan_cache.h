@@ -63,6 +63,13 @@ public:
           decisionWorks(entry.works),
           debugInfo(entry.debugInfo) {}
 
+    CachedPlanHolder(std::unique_ptr<CachedPlanType> cachedPlan,
+                     boost::optional<size_t> decisionWorks,
+                     std::shared_ptr<const DebugInfoType> debugInfo)
+        : cachedPlan(std::move(cachedPlan)),
+          decisionWorks(decisionWorks),
+          debugInfo(std::move(debugInfo)) {}
+
     /**
      * Indicates whether or not the cached plan is pinned to cache.
      */
@@ -558,6 +565,32 @@ public:
         return nRemoved;
     }
 
+    /**
+     * Copies into this cache the entries of 'other' for which the predicate returns true, keeping
+     * their relative recency. Cache entries are never mutated once added, so the copies share the
+     * entries of 'other' rather than cloning them. Returns the number of copied entries.
+     */
+    template <typename BinaryPredicate>
+    size_t copyIf(const PlanCacheBase& other, BinaryPredicate predicate) {
+        std::vector<std::pair<KeyType, std::shared_ptr<const Entry>>> entries;
+        for (size_t partitionId = 0; partitionId < other._numPartitions; ++partitionId) {
+            auto lockedPartition = other._partitionedCache->lockOnePartitionById(partitionId);
+            for (auto&& [key, entry] : *lockedPartition) {
+                if (predicate(key, *entry)) {
+                    entries.emplace_back(key, entry);
+                }
+            }
+        }
+
+        // Partitions are iterated from the most to the least recently used entry, so add the
+        // entries in reverse order for the least recently used ones to be evicted first here too.
+        for (auto it = entries.rbegin(); it != entries.rend(); ++it) {
+            auto partition = _partitionedCache->lockOnePartition(it->first);
+            partition->add(it->first, std::move(it->second));
+        }
+        return entries.size();
+    }
+
     /**
      * Remove *all* cached plans.  Does not clear index information.
      */
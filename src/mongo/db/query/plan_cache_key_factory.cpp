@@ -33,6 +33,8 @@
 #include "mongo/db/query/collection_query_info.h"
 #include "mongo/db/query/planner_ixselect.h"
 #include "mongo/db/s/operation_sharding_state.h"
+#include "mongo/util/ctype.h"
+#include "mongo/util/str.h"
 
 namespace mongo {
 namespace plan_cache_detail {
@@ -166,4 +168,56 @@ sbe::PlanCacheKey make(const CanonicalQuery& query,
             keyShardingEpoch};
 }
 }  // namespace plan_cache_detail
+
+namespace plan_cache_key_factory {
+std::string makeIndexCatalogFingerprint(OperationContext* opCtx, const CollectionPtr& collection) {
+    // Order the index specs by name, so that the fingerprint doesn't depend on the order in which
+    // the indexes were created.
+    std::vector<BSONObj> indexSpecs;
+    auto ii = collection->getIndexCatalog()->getIndexIterator(
+        opCtx, IndexCatalog::InclusionPolicy::kReady);
+    while (ii->more()) {
+        indexSpecs.push_back(ii->next()->descriptor()->infoObj());
+    }
+    std::sort(indexSpecs.begin(), indexSpecs.end(), [](const BSONObj& lhs, const BSONObj& rhs) {
+        return lhs.getStringField(IndexDescriptor::kIndexNameFieldName) <
+            rhs.getStringField(IndexDescriptor::kIndexNameFieldName);
+    });
+
+    std::string fingerprint;
+    for (auto&& spec : indexSpecs) {
+        fingerprint.append(spec.objdata(), spec.objsize());
+    }
+    return fingerprint;
+}
+
+std::string makeSharedShapeKey(OperationContext* opCtx,
+                               const sbe::PlanCacheKey& planCacheKey,
+                               const CollectionPtr& collection) {
+    const auto fingerprint = makeIndexCatalogFingerprint(opCtx, collection);
+    return str::stream() << fingerprint.size() << ':' << fingerprint << planCacheKey.toString();
+}
+
+boost::optional<StringData> getIndexCatalogFingerprint(StringData sharedShapeKey) {
+    const auto separator = sharedShapeKey.find(':');
+    if (separator == std::string::npos || separator == 0) {
+        return boost::none;
+    }
+
+    size_t length = 0;
+    for (auto c : sharedShapeKey.substr(0, separator)) {
+        if (!ctype::isDigit(c)) {
+            return boost::none;
+        }
+        length = length * 10 + (c - '0');
+        if (length > sharedShapeKey.size()) {
+            return boost::none;
+        }
+    }
+    if (separator + 1 + length > sharedShapeKey.size()) {
+        return boost::none;
+    }
+    return sharedShapeKey.substr(separator + 1, length);
+}
+}  // namespace plan_cache_key_factory
 }  // namespace mongo
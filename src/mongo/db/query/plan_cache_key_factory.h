@@ -77,5 +77,27 @@ template <typename Key>
 Key make(const CanonicalQuery& query, const CollectionPtr& collection) {
     return plan_cache_detail::make(query, collection, plan_cache_detail::PlanCacheKeyTag<Key>{});
 }
+
+/**
+ * Returns the specs of the ready indexes of 'collection', ordered by name, which is the same for
+ * all collections with the same set of indexes.
+ */
+std::string makeIndexCatalogFingerprint(OperationContext* opCtx, const CollectionPtr& collection);
+
+/**
+ * Builds the key of the 'sbe::SharedShapePlanCache' from the index catalog fingerprint of
+ * 'collection', prefixed with its length, followed by the shape and indexability encoding of
+ * 'planCacheKey'. Unlike the plan cache key itself, it doesn't identify the collection, so it is
+ * equal for all collections with the same set of indexes.
+ */
+std::string makeSharedShapeKey(OperationContext* opCtx,
+                               const sbe::PlanCacheKey& planCacheKey,
+                               const CollectionPtr& collection);
+
+/**
+ * Returns the index catalog fingerprint embedded in a key built by 'makeSharedShapeKey()', or
+ * boost::none if 'sharedShapeKey' is malformed.
+ */
+boost::optional<StringData> getIndexCatalogFingerprint(StringData sharedShapeKey);
 }  // namespace plan_cache_key_factory
 }  // namespace mongo
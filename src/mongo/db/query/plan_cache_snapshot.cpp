@@ -0,0 +1,258 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kQuery
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/plan_cache_snapshot.h"
+
+#include <vector>
+
+#include "mongo/client/read_preference.h"
+#include "mongo/db/catalog/collection_catalog.h"
+#include "mongo/db/client.h"
+#include "mongo/db/concurrency/d_concurrency.h"
+#include "mongo/db/dbdirectclient.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/query/find_command_gen.h"
+#include "mongo/db/query/plan_cache_key_factory.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/query/sbe_plan_cache.h"
+#include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/logv2/log.h"
+#include "mongo/rpc/get_status_from_command_result.h"
+#include "mongo/stdx/unordered_set.h"
+#include "mongo/util/periodic_runner.h"
+#include "mongo/util/str.h"
+
+namespace mongo::plan_cache_snapshot {
+namespace {
+
+// The maximum number of entries written with a single insert.
+constexpr size_t kInsertBatchSize = 500;
+
+const auto periodicJobDecoration =
+    ServiceContext::declareDecoration<boost::optional<PeriodicJobAnchor>>();
+
+const NamespaceString& getSnapshotNamespace() {
+    return internalQueryPlanCacheSnapshotReplicated.load()
+        ? NamespaceString::kConfigPlanCacheSnapshotNamespace
+        : NamespaceString::kLocalPlanCacheSnapshotNamespace;
+}
+
+/**
+ * The snapshot is built in this collection and then renamed over the snapshot namespace, so that
+ * readers never see a partially written snapshot.
+ */
+NamespaceString getTempSnapshotNamespace(const NamespaceString& nss) {
+    return NamespaceString(nss.db(), nss.coll() + ".tmp");
+}
+
+/**
+ * Returns the index catalog fingerprints of all the collections, which a snapshot entry must match
+ * to be loaded.
+ */
+stdx::unordered_set<std::string> getIndexCatalogFingerprints(OperationContext* opCtx) {
+    Lock::GlobalLock globalLock(opCtx, MODE_IS);
+    const auto catalog = CollectionCatalog::get(opCtx);
+
+    stdx::unordered_set<std::string> fingerprints;
+    for (auto&& tenantDbName : catalog->getAllDbNames()) {
+        for (auto&& collection : catalog->range(tenantDbName)) {
+            fingerprints.insert(
+                plan_cache_key_factory::makeIndexCatalogFingerprint(opCtx, collection));
+        }
+    }
+    return fingerprints;
+}
+
+}  // namespace
+
+bool write(OperationContext* opCtx) {
+    return write(opCtx, sbe::SharedShapePlanCache::get(opCtx->getServiceContext()));
+}
+
+bool write(OperationContext* opCtx, const sbe::SharedShapePlanCache& cache) {
+    if (!cache.isEnabled()) {
+        return false;
+    }
+
+    const auto& nss = getSnapshotNamespace();
+    if (nss.isConfigDB() &&
+        !repl::ReplicationCoordinator::get(opCtx)->canAcceptWritesForDatabase_UNSAFE(opCtx,
+                                                                                     nss.db())) {
+        return false;
+    }
+
+    auto entries = cache.getAllEntries();
+
+    const auto tempNss = getTempSnapshotNamespace(nss);
+    DBDirectClient client(opCtx);
+    client.dropCollection(tempNss.ns());
+    uassert(7027518,
+            str::stream() << "Failed to create " << tempNss,
+            client.createCollection(tempNss.ns()));
+
+    std::vector<BSONObj> batch;
+    for (auto&& [key, entry] : entries) {
+        batch.push_back(BSON("_id" << BSONBinData(key.data(), key.size(), BinDataGeneral)
+                                   << "solution" << entry.solution << "decisionWorks"
+                                   << static_cast<long long>(entry.decisionWorks)));
+        if (batch.size() == kInsertBatchSize) {
+            client.insert(tempNss.ns(), batch);
+            batch.clear();
+        }
+    }
+    if (!batch.empty()) {
+        client.insert(tempNss.ns(), batch);
+    }
+
+    BSONObj info;
+    client.runCommand(
+        NamespaceString::kAdminDb.toString(),
+        BSON("renameCollection" << tempNss.ns() << "to" << nss.ns() << "dropTarget" << true),
+        info);
+    uassertStatusOKWithContext(getStatusFromCommandResult(info),
+                               str::stream() << "Failed to rename " << tempNss << " to " << nss);
+
+    LOGV2_DEBUG(7000108,
+                2,
+                "Wrote plan cache snapshot",
+                "namespace"_attr = nss,
+                "numEntries"_attr = entries.size());
+    return true;
+}
+
+size_t load(OperationContext* opCtx) {
+    return load(opCtx, sbe::SharedShapePlanCache::get(opCtx->getServiceContext()));
+}
+
+size_t load(OperationContext* opCtx, sbe::SharedShapePlanCache& cache) {
+    if (!cache.isEnabled()) {
+        return 0;
+    }
+
+    const auto& nss = getSnapshotNamespace();
+    DBDirectClient client(opCtx);
+    auto cursor = client.find(FindCommandRequest{nss},
+                              ReadPreferenceSetting{ReadPreference::SecondaryPreferred});
+
+    // Only load the entries which apply to some existing collection. The others were written for an
+    // index catalog that no longer exists, or the snapshot was written by a different node.
+    const auto fingerprints = getIndexCatalogFingerprints(opCtx);
+
+    std::vector<std::pair<std::string, sbe::SharedShapePlanCache::Entry>> entries;
+    size_t numSkipped = 0;
+    while (cursor->more()) {
+        auto doc = cursor->next();
+        auto id = doc["_id"];
+        auto solution = doc["solution"];
+        if (id.type() != BSONType::BinData || solution.type() != BSONType::Object) {
+            continue;
+        }
+
+        int keyLength = 0;
+        auto keyData = id.binData(keyLength);
+        auto fingerprint =
+            plan_cache_key_factory::getIndexCatalogFingerprint(StringData(keyData, keyLength));
+        if (!fingerprint || !fingerprints.contains(fingerprint->toString())) {
+            ++numSkipped;
+            continue;
+        }
+
+        entries.push_back({std::string(keyData, keyLength),
+                           {solution.Obj().getOwned(),
+                            static_cast<size_t>(doc["decisionWorks"].safeNumberLong())}});
+    }
+
+    // The snapshot lists entries from the most to the least recently used, so add them in reverse
+    // order to preserve their recency in the cache.
+    size_t numLoaded = 0;
+    for (auto it = entries.rbegin(); it != entries.rend(); ++it) {
+        if (!cache.find(it->first)) {
+            cache.set(it->first, std::move(it->second));
+            ++numLoaded;
+        }
+    }
+
+    LOGV2_DEBUG(7000109,
+                2,
+                "Loaded plan cache snapshot",
+                "namespace"_attr = nss,
+                "numEntries"_attr = numLoaded,
+                "numSkipped"_attr = numSkipped);
+    return numLoaded;
+}
+
+void startPeriodicJob(ServiceContext* serviceContext) {
+    const auto intervalSecs = internalQueryPlanCacheSnapshotIntervalSecs.load();
+    if (intervalSecs <= 0 || !sbe::SharedShapePlanCache::get(serviceContext).isEnabled()) {
+        return;
+    }
+
+    auto periodicRunner = serviceContext->getPeriodicRunner();
+    invariant(periodicRunner);
+
+    // The first run happens as soon as the job starts, and loads the snapshot left by the previous
+    // run of the server off the startup path. Every later run writes a new snapshot, or, on nodes
+    // which can't write the replicated snapshot, loads the one the primary wrote.
+    PeriodicRunner::PeriodicJob job(
+        "planCacheSnapshot",
+        [loaded = false](Client* client) mutable {
+            auto opCtx = client->makeOperationContext();
+            try {
+                if (!loaded) {
+                    loaded = true;
+                    load(opCtx.get());
+                } else if (!write(opCtx.get())) {
+                    load(opCtx.get());
+                }
+            } catch (ExceptionForCat<ErrorCategory::CancellationError>& ex) {
+                LOGV2_DEBUG(7000110, 2, "Periodic job canceled", "reason"_attr = ex.reason());
+            } catch (const DBException& ex) {
+                LOGV2_WARNING(7000111, "Failed to snapshot the plan cache", "error"_attr = ex);
+            }
+        },
+        Seconds(intervalSecs));
+
+    auto& anchor = periodicJobDecoration(serviceContext);
+    anchor.emplace(periodicRunner->makeJob(std::move(job)));
+    anchor->start();
+}
+
+void shutdownPeriodicJob(ServiceContext* serviceContext) {
+    auto& anchor = periodicJobDecoration(serviceContext);
+    if (anchor) {
+        anchor->stop();
+        anchor->detach();
+    }
+}
+
+}  // namespace mongo::plan_cache_snapshot
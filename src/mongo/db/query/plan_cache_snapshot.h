@@ -0,0 +1,85 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include "mongo/db/operation_context.h"
+#include "mongo/db/service_context.h"
+
+namespace mongo::sbe {
+class SharedShapePlanCache;
+}  // namespace mongo::sbe
+
+namespace mongo::plan_cache_snapshot {
+
+/**
+ * Snapshots of the 'sbe::SharedShapePlanCache' let its entries survive restarts. Each entry is
+ * stored as a document {_id: <key>, solution: <solution>, decisionWorks: <works>}, where the key
+ * starts with the fingerprint of the index catalog of the collections the solution applies to, and
+ * the solution refers to indexes by name. Entries whose fingerprint matches no existing collection
+ * are skipped on load, and the others are validated again against the index catalog when they are
+ * used, see 'SolutionCacheData::parse()'.
+ *
+ * The snapshot lives in 'local.planCacheSnapshot'. When 'internalQueryPlanCacheSnapshotReplicated'
+ * is set, the primary writes it to 'config.planCacheSnapshot' instead, which secondaries replicate
+ * and load, so that a newly elected primary starts with a warm cache.
+ */
+
+/**
+ * Replaces the snapshot with the current entries of the shared cache. The new snapshot is written
+ * to a temporary collection which is then renamed over the old one, so the snapshot is never seen
+ * partially written. Returns false, without writing anything, if the shared cache is disabled or
+ * the snapshot is replicated and this node cannot accept writes.
+ */
+bool write(OperationContext* opCtx);
+bool write(OperationContext* opCtx, const sbe::SharedShapePlanCache& cache);
+
+/**
+ * Adds the entries of the snapshot which are not in the shared cache yet and match the index
+ * catalog of some existing collection to it. Returns the number of entries added.
+ */
+size_t load(OperationContext* opCtx);
+size_t load(OperationContext* opCtx, sbe::SharedShapePlanCache& cache);
+
+/**
+ * Starts a background job which loads the snapshot once and then writes one every
+ * 'internalQueryPlanCacheSnapshotIntervalSecs', or loads it again if it can't be written here.
+ * Does nothing if the interval is 0 or the shared
+ * cache is disabled.
+ */
+void startPeriodicJob(ServiceContext* serviceContext);
+
+/**
+ * Stops the job started by 'startPeriodicJob()', if any.
+ */
+void shutdownPeriodicJob(ServiceContext* serviceContext);
+
+}  // namespace mongo::plan_cache_snapshot
@@ -431,6 +431,75 @@ TEST(PlanCacheTest, PlanCacheFlushDeletesInactiveEntries) {
     ASSERT_EQ(planCache.get(key).state, PlanCache::CacheEntryState::kNotPresent);
 }
 
+TEST(PlanCacheTest, CopyIfCopiesMatchingEntriesAndKeepsRecency) {
+    PlanCache planCache(5000);
+    QueryTestServiceContext serviceContext;
+
+    unique_ptr<CanonicalQuery> cqA(canonicalize("{a: 1}"));
+    unique_ptr<CanonicalQuery> cqB(canonicalize("{b: 1}"));
+    unique_ptr<CanonicalQuery> cqC(canonicalize("{c: 1}"));
+    addCacheEntryForShape(*cqA, &planCache);
+    addCacheEntryForShape(*cqB, &planCache);
+    addCacheEntryForShape(*cqC, &planCache);
+
+    // Copy every entry but the one for {b: 1} into a cache which only fits two entries. The entry
+    // already in that cache is the least recently used one and gets ejected.
+    const size_t kCacheSize = 2;
+    PlanCache copy(kCacheSize);
+    unique_ptr<CanonicalQuery> cqD(canonicalize("{d: 1}"));
+    addCacheEntryForShape(*cqD, &copy);
+    auto keyB = makeKey(*cqB);
+    ASSERT_EQ(copy.copyIf(planCache,
+                          [&](const PlanCacheKey& key, const PlanCacheEntry&) {
+                              return key != keyB;
+                          }),
+              2U);
+
+    // The source cache is left untouched.
+    ASSERT_EQ(planCache.size(), 3U);
+
+    ASSERT_EQ(copy.size(), kCacheSize);
+    ASSERT_EQ(copy.get(keyB).state, PlanCache::CacheEntryState::kNotPresent);
+    ASSERT_EQ(copy.get(makeKey(*cqD)).state, PlanCache::CacheEntryState::kNotPresent);
+
+    // {a: 1} was less recently used than {c: 1} in the source cache, so it is the one ejected when
+    // another entry is added.
+    unique_ptr<CanonicalQuery> cqE(canonicalize("{e: 1}"));
+    addCacheEntryForShape(*cqE, &copy);
+    ASSERT_EQ(copy.get(makeKey(*cqA)).state, PlanCache::CacheEntryState::kNotPresent);
+    ASSERT_EQ(copy.get(makeKey(*cqC)).state, PlanCache::CacheEntryState::kPresentInactive);
+    ASSERT_EQ(copy.get(makeKey(*cqE)).state, PlanCache::CacheEntryState::kPresentInactive);
+}
+
+TEST(PlanCacheTest, CopyIfPastCapacityEvictsLeastRecentlyUsedEntries) {
+    PlanCache planCache(5000);
+    QueryTestServiceContext serviceContext;
+
+    std::vector<unique_ptr<CanonicalQuery>> queries;
+    for (auto&& filter : {"{a: 1}", "{b: 1}", "{c: 1}", "{d: 1}"}) {
+        queries.push_back(canonicalize(filter));
+        addCacheEntryForShape(*queries.back(), &planCache);
+    }
+
+    // Looking up {a: 1} makes it the most recently used entry, followed by {d: 1} and {c: 1}.
+    ASSERT_EQ(planCache.get(makeKey(*queries[0])).state,
+              PlanCache::CacheEntryState::kPresentInactive);
+
+    // All four entries are copied into a cache which only fits two, so the two least recently used
+    // ones in the source cache are evicted as the later ones are added.
+    const size_t kCacheSize = 2;
+    PlanCache copy(kCacheSize);
+    auto copyAll = [](const PlanCacheKey&, const PlanCacheEntry&) {
+        return true;
+    };
+    ASSERT_EQ(copy.copyIf(planCache, copyAll), 4U);
+    ASSERT_EQ(copy.size(), kCacheSize);
+    ASSERT_EQ(copy.get(makeKey(*queries[0])).state, PlanCache::CacheEntryState::kPresentInactive);
+    ASSERT_EQ(copy.get(makeKey(*queries[3])).state, PlanCache::CacheEntryState::kPresentInactive);
+    ASSERT_EQ(copy.get(makeKey(*queries[1])).state, PlanCache::CacheEntryState::kNotPresent);
+    ASSERT_EQ(copy.get(makeKey(*queries[2])).state, PlanCache::CacheEntryState::kNotPresent);
+}
+
 TEST(PlanCacheTest, AddActiveCacheEntry) {
     PlanCache planCache(5000);
     unique_ptr<CanonicalQuery> cq(canonicalize("{a: 1}"));
@@ -1939,4 +2008,65 @@ TEST(PlanCacheTest, PlanCacheMaxSizeParameterCanBeZero) {
         planCache.set(makeKey(*query), qs->cacheData->clone(), *decision, Date_t{}, &callbacks));
     ASSERT_EQ(0U, planCache.size());
 }
+
+IndexEntry makeSimpleIndexEntry(BSONObj keyPattern, const std::string& indexName, bool multikey) {
+    return IndexEntry(keyPattern,
+                      IndexNames::nameToType(IndexNames::findPluginName(keyPattern)),
+                      IndexDescriptor::kLatestIndexVersion,
+                      multikey,
+                      {},
+                      {},
+                      false,  // sparse
+                      false,  // unique
+                      IndexEntry::Identifier{indexName},
+                      nullptr,
+                      BSONObj(),
+                      nullptr,
+                      nullptr);
+}
+
+TEST(PlanCacheTest, SolutionCacheDataRoundTripsThroughBSON) {
+    std::vector<IndexEntry> indices{makeSimpleIndexEntry(BSON("a" << 1), "a_1", false),
+                                    makeSimpleIndexEntry(BSON("b" << 1), "b_1", false)};
+
+    SolutionCacheData data;
+    data.solnType = SolutionCacheData::USE_INDEX_TAGS_SOLN;
+    data.tree = std::make_unique<PlanCacheIndexTree>();
+
+    auto indexedChild = std::make_unique<PlanCacheIndexTree>();
+    indexedChild->setIndexEntry(indices[0]);
+    indexedChild->index_pos = 1;
+    indexedChild->canCombineBounds = false;
+    data.tree->children.push_back(std::move(indexedChild));
+
+    auto pushedDownChild = std::make_unique<PlanCacheIndexTree>();
+    pushedDownChild->orPushdowns.push_back({IndexEntry::Identifier{"b_1"}, 0, true, {0, 2}});
+    data.tree->children.push_back(std::move(pushedDownChild));
+
+    auto parsed = SolutionCacheData::parse(data.toBSON(), indices);
+    ASSERT_OK(parsed.getStatus());
+    ASSERT_EQ(parsed.getValue()->toString(), data.toString());
+    ASSERT_BSONOBJ_EQ(parsed.getValue()->toBSON(), data.toBSON());
+}
+
+TEST(PlanCacheTest, SolutionCacheDataIsParsedAgainstTheCurrentIndexes) {
+    SolutionCacheData data;
+    data.solnType = SolutionCacheData::WHOLE_IXSCAN_SOLN;
+    data.wholeIXSolnDir = -1;
+    data.tree = std::make_unique<PlanCacheIndexTree>();
+    data.tree->setIndexEntry(makeSimpleIndexEntry(BSON("a" << 1), "a_1", false));
+    auto serialized = data.toBSON();
+
+    // The index has become multikey since the solution was cached.
+    auto parsed =
+        SolutionCacheData::parse(serialized, {makeSimpleIndexEntry(BSON("a" << 1), "a_1", true)});
+    ASSERT_OK(parsed.getStatus());
+    ASSERT_EQ(parsed.getValue()->wholeIXSolnDir, -1);
+    ASSERT_TRUE(parsed.getValue()->tree->entry->multikey);
+
+    // The index has been dropped.
+    ASSERT_NOT_OK(
+        SolutionCacheData::parse(serialized, {makeSimpleIndexEntry(BSON("b" << 1), "b_1", false)})
+            .getStatus());
+}
 }  // namespace
@@ -1020,6 +1020,34 @@ void PlanEnumerator::enumerateOneIndex(
             andAssignment->choices.push_back(std::move(state));
         }
     }
+
+    // Indexes with no predicate over their leading field can still be skip-scanned if their
+    // leading field has few distinct values and there is a predicate over their second field.
+    for (IndexToPredMap::const_iterator it = idxToNotFirst.begin(); it != idxToNotFirst.end();
+         ++it) {
+        const IndexEntry& thisIndex = (*_indices)[it->first];
+        if (!thisIndex.allowSkipScan || thisIndex.multikey ||
+            idxToFirst.find(it->first) != idxToFirst.end()) {
+            continue;
+        }
+
+        OneIndexAssignment indexAssign;
+        indexAssign.index = it->first;
+
+        bool hasPredOverSecondField = false;
+        for (auto pred : it->second) {
+            const size_t position = getPosition(thisIndex, pred);
+            hasPredOverSecondField = hasPredOverSecondField || position == 1;
+            assignPredicate(outsidePreds, pred, position, &indexAssign);
+        }
+
+        // Do not output this assignment if it consists only of outside predicates.
+        if (hasPredOverSecondField && !indexAssign.preds.empty()) {
+            AndEnumerableState state;
+            state.assignments.push_back(std::move(indexAssign));
+            andAssignment->choices.push_back(std::move(state));
+        }
+    }
 }
 
 void PlanEnumerator::enumerateAndIntersect(const IndexToPredMap& idxToFirst,
@@ -474,7 +474,8 @@ PlanExecutor::ExecState PlanExecutorImpl::_getNextImpl(Snapshotted<Document>* ob
                 return PlanExecutor::IS_EOF;
             }
 
-            insert_listener::waitForInserts(_opCtx, _yieldPolicy.get(), &cappedInsertNotifierData);
+            insert_listener::waitForInserts(
+                _opCtx, _cq.get(), _yieldPolicy.get(), &cappedInsertNotifierData);
 
             // There may be more results, keep going.
             continue;
@@ -317,7 +317,8 @@ PlanExecutor::ExecState PlanExecutorSBE::getNextImpl(ObjectType* out, RecordId*
                 return PlanExecutor::ExecState::IS_EOF;
             }
 
-            insert_listener::waitForInserts(_opCtx, _yieldPolicy.get(), &cappedInsertNotifierData);
+            insert_listener::waitForInserts(
+                _opCtx, _cq.get(), _yieldPolicy.get(), &cappedInsertNotifierData);
             // There may be more results, keep going.
             continue;
         } else if (_resumeRecordIdSlot) {
@@ -454,6 +454,9 @@ void statsToBSON(const PlanStageStats& stats,
     } else if (STAGE_SORT_MERGE == stats.stageType) {
         MergeSortStats* spec = static_cast<MergeSortStats*>(stats.specific.get());
         bob->append("sortPattern", spec->sortPattern);
+        if (spec->mergeByRecordId) {
+            bob->appendBool("mergeByRecordId", true);
+        }
 
         if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
             bob->appendNumber("dupsTested", static_cast<long long>(spec->dupsTested));
@@ -156,6 +156,9 @@ void statsToBSON(const QuerySolutionNode* node,
         case STAGE_SORT_MERGE: {
             auto smn = static_cast<const MergeSortNode*>(node);
             bob->append("sortPattern", smn->sort);
+            if (smn->mergeByRecordId) {
+                bob->appendBool("mergeByRecordId", true);
+            }
             break;
         }
         case STAGE_TEXT_MATCH: {
@@ -181,6 +184,14 @@ void statsToBSON(const QuerySolutionNode* node,
                 bob->append("indexName", eln->idxEntry->identifier.catalogName);
                 bob->append("indexKeyPattern", eln->idxEntry->keyPattern);
             }
+            if (eln->unwindSpec) {
+                BSONObjBuilder unwindBob(bob->subobjStart("unwind"));
+                unwindBob.append("preserveNullAndEmptyArrays",
+                                 eln->unwindSpec->preserveNullAndEmptyArrays);
+                if (eln->unwindSpec->indexPath) {
+                    unwindBob.append("includeArrayIndex", eln->unwindSpec->indexPath->fullPath());
+                }
+            }
             break;
         }
         default:
@@ -241,6 +252,11 @@ void statsToBSONHelper(const sbe::PlanStageStats* stats,
     // Include executionTimeMillis if it was recorded.
     if (stats->common.executionTimeMillis) {
         bob->appendNumber("executionTimeMillisEstimate", *stats->common.executionTimeMillis);
+        bob->appendNumber("valueAllocations",
+                          static_cast<long long>(stats->common.valueAllocations));
+    }
+    if (stats->common.cpuTimeNanos) {
+        bob->appendNumber("cpuTimeNanos", *stats->common.cpuTimeNanos);
     }
     bob->appendNumber("opens", static_cast<long long>(stats->common.opens));
     bob->appendNumber("closes", static_cast<long long>(stats->common.closes));
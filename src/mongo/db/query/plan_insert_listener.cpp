@@ -36,8 +36,10 @@
 #include "mongo/db/catalog/database_holder.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/query/find_common.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo::insert_listener {
 namespace {
@@ -90,6 +92,7 @@ std::shared_ptr<CappedInsertNotifier> getCappedInsertNotifier(OperationContext*
 }
 
 void waitForInserts(OperationContext* opCtx,
+                    CanonicalQuery* cq,
                     PlanYieldPolicy* yieldPolicy,
                     CappedInsertNotifierData* notifierData) {
     invariant(notifierData->notifier);
@@ -103,10 +106,27 @@ void waitForInserts(OperationContext* opCtx,
     curOp->pauseTimer();
     ON_BLOCK_EXIT([curOp] { curOp->resumeTimer(); });
 
+    const auto coalescingInterval = cq && cq->getExpCtx()->changeStreamSpec
+        ? Milliseconds(internalQueryChangeStreamWakeupCoalescingMS.load())
+        : Milliseconds(0);
+
     uint64_t currentNotifierVersion = notifierData->notifier->getVersion();
-    auto yieldResult = yieldPolicy->yieldOrInterrupt(opCtx, [opCtx, notifierData] {
+    auto yieldResult = yieldPolicy->yieldOrInterrupt(opCtx, [&] {
         const auto deadline = awaitDataState(opCtx).waitForInsertsDeadline;
         notifierData->notifier->waitUntil(notifierData->lastEOFVersion, deadline);
+
+        // Every open change stream on the node is woken by each insert into the oplog. Holding the
+        // wakeup back lets one scan pick up all the entries inserted meanwhile, rather than one
+        // scan per entry for each stream.
+        if (coalescingInterval > Milliseconds(0) &&
+            notifierData->lastEOFVersion == currentNotifierVersion &&
+            notifierData->notifier->getVersion() != currentNotifierVersion) {
+            auto clock = opCtx->getServiceContext()->getPreciseClockSource();
+            auto wakeAt = std::min(clock->now() + coalescingInterval, deadline);
+            if (auto delay = wakeAt - clock->now(); delay > Milliseconds(0)) {
+                sleepFor(delay);
+            }
+        }
         if (MONGO_unlikely(planExecutorHangWhileYieldedInWaitForInserts.shouldFail())) {
             LOGV2(4452903,
                   "PlanExecutor - planExecutorHangWhileYieldedInWaitForInserts fail point enabled. "
@@ -73,9 +73,13 @@ std::shared_ptr<CappedInsertNotifier> getCappedInsertNotifier(OperationContext*
  * the collection being tailed. Returns control to the caller once there has been an insertion
  * and there may be new results. If the PlanExecutor was killed during a yield, throws an
  * exception.
+ *
+ * For a change stream, a wakeup is held back for internalQueryChangeStreamWakeupCoalescingMS so
+ * that the inserts made in the meantime are read by a single scan of the oplog.
  */
 
 void waitForInserts(OperationContext* opCtx,
+                    CanonicalQuery* cq,
                     PlanYieldPolicy* yieldPolicy,
                     CappedInsertNotifierData* notifierData);
 }  // namespace mongo::insert_listener
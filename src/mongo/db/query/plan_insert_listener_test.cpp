@@ -0,0 +1,143 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/curop.h"
+#include "mongo/db/pipeline/document_source_change_stream_gen.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/db/query/canonical_query.h"
+#include "mongo/db/query/find_common.h"
+#include "mongo/db/query/mock_yield_policies.h"
+#include "mongo/db/query/plan_insert_listener.h"
+#include "mongo/db/query/query_test_service_context.h"
+#include "mongo/idl/server_parameter_test_util.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/timer.h"
+
+namespace mongo::insert_listener {
+namespace {
+
+/**
+ * Simulates an insert arriving while the executor is yielded: notifies 'notifier' and then runs
+ * the wait as a yielding policy would.
+ */
+class InsertWhileYieldedPolicy final : public MockYieldPolicy {
+public:
+    InsertWhileYieldedPolicy(OperationContext* opCtx,
+                             ClockSource* cs,
+                             std::shared_ptr<CappedInsertNotifier> notifier)
+        : MockYieldPolicy(opCtx, cs, PlanYieldPolicy::YieldPolicy::YIELD_AUTO),
+          _notifier(std::move(notifier)) {}
+
+    Status yieldOrInterrupt(OperationContext*, std::function<void()> whileYieldingFn) override {
+        _notifier->notifyAll();
+        whileYieldingFn();
+        return Status::OK();
+    }
+
+private:
+    std::shared_ptr<CappedInsertNotifier> _notifier;
+};
+
+class WaitForInsertsTest : public unittest::Test {
+public:
+    WaitForInsertsTest() : _opCtx(_serviceContext.makeOperationContext()) {
+        CurOp::get(opCtx())->ensureStarted();
+    }
+
+    OperationContext* opCtx() {
+        return _opCtx.get();
+    }
+
+    std::unique_ptr<CanonicalQuery> makeQuery(bool isChangeStream) {
+        const NamespaceString nss("local.oplog.rs");
+        auto expCtx = make_intrusive<ExpressionContextForTest>(opCtx(), nss);
+        if (isChangeStream) {
+            expCtx->changeStreamSpec = DocumentSourceChangeStreamSpec();
+        }
+        auto cq = CanonicalQuery::canonicalize(
+            opCtx(), std::make_unique<FindCommandRequest>(nss), false, expCtx);
+        ASSERT_OK(cq.getStatus());
+        return std::move(cq.getValue());
+    }
+
+    /**
+     * Waits for inserts as on the second EOF in a row, with an insert arriving once the executor
+     * has yielded, and returns how long the wait took.
+     */
+    Milliseconds timeWaitForInserts(CanonicalQuery* cq, Milliseconds awaitDataTimeout) {
+        auto notifier = std::make_shared<CappedInsertNotifier>();
+        CappedInsertNotifierData notifierData{notifier, notifier->getVersion()};
+        InsertWhileYieldedPolicy yieldPolicy(
+            opCtx(), _serviceContext.getServiceContext()->getFastClockSource(), notifier);
+        awaitDataState(opCtx()).waitForInsertsDeadline =
+            _serviceContext.getServiceContext()->getPreciseClockSource()->now() +
+            awaitDataTimeout;
+
+        Timer timer;
+        waitForInserts(opCtx(), cq, &yieldPolicy, &notifierData);
+        return Milliseconds(timer.millis());
+    }
+
+private:
+    QueryTestServiceContext _serviceContext;
+    ServiceContext::UniqueOperationContext _opCtx;
+};
+
+TEST_F(WaitForInsertsTest, ChangeStreamWakeupIsHeldBackForCoalescingInterval) {
+    RAIIServerParameterControllerForTest coalescing("internalQueryChangeStreamWakeupCoalescingMS",
+                                                    200);
+    auto cq = makeQuery(true /* isChangeStream */);
+    ASSERT_GTE(timeWaitForInserts(cq.get(), Minutes(1)), Milliseconds(200));
+}
+
+TEST_F(WaitForInsertsTest, ChangeStreamWakeupIsNotHeldBackPastAwaitDataDeadline) {
+    RAIIServerParameterControllerForTest coalescing("internalQueryChangeStreamWakeupCoalescingMS",
+                                                    1000);
+    auto cq = makeQuery(true /* isChangeStream */);
+    ASSERT_LT(timeWaitForInserts(cq.get(), Milliseconds(10)), Milliseconds(1000));
+}
+
+TEST_F(WaitForInsertsTest, WakeupIsNotHeldBackForOtherOplogReaders) {
+    RAIIServerParameterControllerForTest coalescing("internalQueryChangeStreamWakeupCoalescingMS",
+                                                    1000);
+    auto cq = makeQuery(false /* isChangeStream */);
+    ASSERT_LT(timeWaitForInserts(cq.get(), Minutes(1)), Milliseconds(1000));
+    ASSERT_LT(timeWaitForInserts(nullptr, Minutes(1)), Milliseconds(1000));
+}
+
+TEST_F(WaitForInsertsTest, WakeupIsNotHeldBackWhenCoalescingIsDisabled) {
+    auto cq = makeQuery(true /* isChangeStream */);
+    ASSERT_LT(timeWaitForInserts(cq.get(), Minutes(1)), Milliseconds(1000));
+}
+
+}  // namespace
+}  // namespace mongo::insert_listener
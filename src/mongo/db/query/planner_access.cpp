@@ -426,6 +426,26 @@ void handleRIDRangeMinMax(const CanonicalQuery& query,
     return true;
 }
 
+/**
+ * Returns true if a predicate with INEXACT_COVERED bounds over the field at position 'pos' of
+ * 'index' can be evaluated against the index keys. This is not the case if the field has multikey
+ * components: suppose that we had the multikey index {x: 1} and a document {x: ["a", "b"]}. If we
+ * query for {x: /b/} the filter might only ever be applied to the index key "a", and we'd
+ * incorrectly conclude that the document does not match. Fields without multikey components hold
+ * the same value in every index key of the document, so they can still be filtered on.
+ */
+bool canUseCoveredFilter(const IndexEntry& index, size_t pos) {
+    if (!index.multikey) {
+        return true;
+    }
+
+    BSONObjIterator it(index.keyPattern);
+    for (size_t i = 0; i < pos && it.more(); ++i) {
+        it.next();
+    }
+    return it.more() && !index.pathHasMultikeyComponent(it.next().fieldNameStringData());
+}
+
 }  // namespace
 
 std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::makeCollectionScan(
@@ -535,6 +555,16 @@ std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::makeCollectionScan(
         handleRIDRangeMinMax(query, csn.get(), params, queryCollator);
     }
 
+    // A scan may only share its position if nothing depends on it returning records in RecordId
+    // order: the order of a clustered collection provides a sort, and $natural asks for it.
+    if ((params.options & QueryPlannerParams::SHARE_COLLECTION_SCANS) && csn->direction == 1 &&
+        !tailable && !isOplog && !csn->clusteredIndex && !csn->minRecord && !csn->maxRecord &&
+        !csn->resumeAfterRecordId && !csn->requestResumeToken &&
+        !hint[query_request_helper::kNaturalSortField] &&
+        !query.getFindCommandRequest().getSort()[query_request_helper::kNaturalSortField]) {
+        csn->shareScanPosition = true;
+    }
+
     return csn;
 }
 
@@ -991,9 +1021,10 @@ bool QueryPlannerAccess::orNeedsFetch(const ScanBuildingState* scanState) {
     } else if (scanState->loosestBounds == IndexBoundsBuilder::INEXACT_FETCH) {
         return true;
     } else {
+        // handleFilterOr() has already loosened the tightness of the predicates which cannot be
+        // evaluated against the index keys.
         invariant(scanState->loosestBounds == IndexBoundsBuilder::INEXACT_COVERED);
-        const IndexEntry& index = scanState->indices[scanState->currentIndexNumber];
-        return index.multikey;
+        return false;
     }
 }
 
@@ -1685,6 +1716,19 @@ std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::buildIndexedOr(
             msn->sort = query.getFindCommandRequest().getSort();
             msn->addChildren(std::move(ixscanNodes));
             orResult = std::move(msn);
+        } else if (!query.getSortPattern() &&
+                   internalQueryPlannerEnableRecordIdMergeOr.load() &&
+                   std::all_of(ixscanNodes.begin(), ixscanNodes.end(), [](const auto& ixscan) {
+                       return ixscan->sortedByDiskLoc();
+                   })) {
+            // Every branch returns its results in RecordId order, so merging them on RecordId
+            // brings duplicates next to each other and drops them without a set of the RecordIds
+            // seen so far. Sorted queries keep the OR, which explodeForSort() may turn into a
+            // merge on the sort pattern.
+            auto msn = std::make_unique<MergeSortNode>();
+            msn->mergeByRecordId = true;
+            msn->addChildren(std::move(ixscanNodes));
+            orResult = std::move(msn);
         } else {
             auto orn = std::make_unique<OrNode>();
             orn->addChildren(std::move(ixscanNodes));
@@ -1778,7 +1822,7 @@ std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::_buildIndexedDataAccess(
             if (tightness == IndexBoundsBuilder::EXACT) {
                 return soln;
             } else if (tightness == IndexBoundsBuilder::INEXACT_COVERED &&
-                       !indices[tag->index].multikey) {
+                       canUseCoveredFilter(indices[tag->index], tag->pos)) {
                 verify(nullptr == soln->filter.get());
                 soln->filter = std::move(ownedRoot);
                 return soln;
@@ -1901,6 +1945,13 @@ void QueryPlannerAccess::handleFilterOr(ScanBuildingState* scanState) {
         // for affixing later.
         ++scanState->curChild;
     } else {
+        // A predicate over a field with multikey components must be evaluated after the fetch.
+        if (scanState->tightness == IndexBoundsBuilder::INEXACT_COVERED &&
+            !canUseCoveredFilter(scanState->indices[scanState->currentIndexNumber],
+                                 scanState->ixtag->pos)) {
+            scanState->tightness = IndexBoundsBuilder::INEXACT_FETCH;
+        }
+
         if (scanState->tightness < scanState->loosestBounds) {
             scanState->loosestBounds = scanState->tightness;
         }
@@ -1926,18 +1977,13 @@ void QueryPlannerAccess::handleFilterAnd(ScanBuildingState* scanState) {
         // returns to handleIndexedAnd we know that we don't need it to create a FETCH stage.
         root->getChildVector()->erase(root->getChildVector()->begin() + scanState->curChild);
     } else if (scanState->tightness == IndexBoundsBuilder::INEXACT_COVERED &&
-               (INDEX_TEXT == index.type || !index.multikey)) {
+               (INDEX_TEXT == index.type || canUseCoveredFilter(index, scanState->ixtag->pos))) {
         // The bounds are not exact, but the information needed to
         // evaluate the predicate is in the index key. Remove the
         // MatchExpression from its parent and attach it to the filter
-        // of the index scan we're building.
-        //
-        // We can only use this optimization if the index is NOT multikey.
-        // Suppose that we had the multikey index {x: 1} and a document
-        // {x: ["a", "b"]}. Now if we query for {x: /b/} the filter might
-        // ever only be applied to the index key "a". We'd incorrectly
-        // conclude that the document does not match the query :( so we
-        // gotta stick to non-multikey indices.
+        // of the index scan we're building. This is only possible if
+        // the field which the predicate is over has no multikey
+        // components.
         auto child = std::move((*root->getChildVector())[scanState->curChild]);
         root->getChildVector()->erase(root->getChildVector()->begin() + scanState->curChild);
 
@@ -628,6 +628,26 @@ bool isEligibleForHashJoin(const SecondaryCollectionInfo& foreignCollInfo) {
         internalQueryCollectionMaxStorageSizeBytesToChooseHashJoin.load();
 }
 
+// Costs of the $lookup strategies, in units of the cost of reading one document from a collection
+// scan. Probing an index means seeking a cursor, which is an order of magnitude more expensive than
+// advancing one, whereas probing the hash table of a hash join is cheap.
+constexpr double kLookupIndexProbeCost = 10.0;
+constexpr double kLookupHashTableProbeCost = 0.5;
+
+// Selectivity assumed for a non-trivial predicate on the local side of a $lookup, as in the
+// heuristic cardinality estimator.
+constexpr double kLookupLocalPredicateSelectivity = 0.1;
+
+// Returns true if a hash join, which reads the whole foreign collection of 'foreignCollInfo' once,
+// is expected to be cheaper than probing an index on it for each of 'localCardinality' documents.
+bool isHashJoinCheaperThanIndexedLoopJoin(const SecondaryCollectionInfo& foreignCollInfo,
+                                          double localCardinality) {
+    const double indexedLoopJoinCost = localCardinality * kLookupIndexProbeCost;
+    const double hashJoinCost = static_cast<double>(foreignCollInfo.noOfRecords) +
+        localCardinality * kLookupHashTableProbeCost;
+    return hashJoinCost < indexedLoopJoinCost;
+}
+
 // Determines whether 'index' is eligible for executing the right side of a pushed down $lookup over
 // 'foreignField'.
 bool isIndexEligibleForRightSideOfLookupPushdown(const IndexEntry& index,
@@ -657,7 +677,8 @@ QueryPlannerAnalysis::determineLookupStrategy(
     const std::string& foreignField,
     const std::map<NamespaceString, SecondaryCollectionInfo>& collectionsInfo,
     bool allowDiskUse,
-    const CollatorInterface* collator) {
+    const CollatorInterface* collator,
+    boost::optional<double> localCardinality) {
     auto foreignCollItr = collectionsInfo.find(NamespaceString(foreignCollName));
     tassert(5842600,
             str::stream() << "Expected collection info, but found none; target collection: "
@@ -695,6 +716,10 @@ QueryPlannerAnalysis::determineLookupStrategy(
 
     if (!foreignCollItr->second.exists) {
         return {EqLookupNode::LookupStrategy::kNonExistentForeignCollection, boost::none};
+    } else if (foreignIndex && localCardinality && allowDiskUse &&
+               isEligibleForHashJoin(foreignCollItr->second) &&
+               isHashJoinCheaperThanIndexedLoopJoin(foreignCollItr->second, *localCardinality)) {
+        return {EqLookupNode::LookupStrategy::kHashJoin, boost::none};
     } else if (foreignIndex) {
         return {EqLookupNode::LookupStrategy::kIndexedLoopJoin, std::move(foreignIndex)};
     } else if (allowDiskUse && isEligibleForHashJoin(foreignCollItr->second)) {
@@ -704,6 +729,24 @@ QueryPlannerAnalysis::determineLookupStrategy(
     }
 }
 
+// static
+boost::optional<double> QueryPlannerAnalysis::estimateLookupLocalCardinality(
+    const CanonicalQuery& query,
+    const std::map<NamespaceString, SecondaryCollectionInfo>& collectionsInfo) {
+    if (!internalQueryEnableCostBasedLookupStrategy.load()) {
+        return boost::none;
+    }
+
+    // The main collection is also recorded among the secondary collections.
+    auto localCollItr = collectionsInfo.find(query.nss());
+    if (localCollItr == collectionsInfo.end() || !localCollItr->second.exists) {
+        return boost::none;
+    }
+
+    return static_cast<double>(localCollItr->second.noOfRecords) *
+        (query.root()->isTriviallyTrue() ? 1.0 : kLookupLocalPredicateSelectivity);
+}
+
 // static
 void QueryPlannerAnalysis::analyzeGeo(const QueryPlannerParams& params,
                                       QuerySolutionNode* solnRoot) {
@@ -1009,6 +1052,12 @@ QuerySolutionNode* QueryPlannerAnalysis::analyzeSort(const CanonicalQuery& query
 
     // If we're here, we need to add a sort stage.
 
+    // The caller asked for a plan whose order comes from the data access path only.
+    if (params.options & QueryPlannerParams::STRICT_NON_BLOCKING_SORT) {
+        delete solnRoot;
+        return nullptr;
+    }
+
     if (!solnRoot->fetched()) {
         const bool sortIsCovered =
             std::all_of(sortObj.begin(), sortObj.end(), [solnRoot](BSONElement e) {
@@ -133,6 +133,12 @@ public:
      * - A hash join is chosen if disk use is allowed and if the foreign collection is sufficiently
      * small.
      * - A nested loop join is chosen in all other cases.
+     *
+     * If both an indexed nested loop join and a hash join are eligible and 'localCardinality'
+     * estimates the number of documents the $lookup reads from its local side, the cheaper of the
+     * two is chosen: the indexed nested loop join probes the index once per local document, while
+     * the hash join scans the foreign collection once. Otherwise the indexed nested loop join is
+     * preferred.
      */
     static std::pair<EqLookupNode::LookupStrategy, boost::optional<IndexEntry>>
     determineLookupStrategy(
@@ -140,7 +146,17 @@ public:
         const std::string& foreignField,
         const std::map<NamespaceString, SecondaryCollectionInfo>& collectionsInfo,
         bool allowDiskUse,
-        const CollatorInterface* collator);
+        const CollatorInterface* collator,
+        boost::optional<double> localCardinality = boost::none);
+
+    /**
+     * Estimates the number of documents 'query' reads from its collection, to be passed as the
+     * 'localCardinality' of determineLookupStrategy(). Returns boost::none if cost-based $lookup
+     * strategy selection is disabled or the size of the collection is not in 'collectionsInfo'.
+     */
+    static boost::optional<double> estimateLookupLocalCardinality(
+        const CanonicalQuery& query,
+        const std::map<NamespaceString, SecondaryCollectionInfo>& collectionsInfo);
 };
 
 }  // namespace mongo
@@ -281,4 +281,36 @@ TEST(QueryPlannerAnalysis, GeoSkipValidation) {
     ASSERT_EQ(expr->getCanSkipValidation(), true);
 }
 
+TEST(QueryPlannerAnalysis, LookupStrategyComparesIndexProbesWithHashJoinWhenLocalSizeIsKnown) {
+    SecondaryCollectionInfo foreignInfo;
+    foreignInfo.indexes.push_back(buildSimpleIndexEntry(BSON("b" << 1)));
+    foreignInfo.noOfRecords = 1000;
+    std::map<NamespaceString, SecondaryCollectionInfo> collectionsInfo{
+        {NamespaceString("test.foreign"), foreignInfo}};
+
+    auto determineStrategy = [&](boost::optional<double> localCardinality) {
+        return QueryPlannerAnalysis::determineLookupStrategy("test.foreign",
+                                                             "b",
+                                                             collectionsInfo,
+                                                             true /* allowDiskUse */,
+                                                             nullptr /* collator */,
+                                                             localCardinality)
+            .first;
+    };
+
+    // Without an estimate of the local side, an eligible index is always used.
+    ASSERT(determineStrategy(boost::none) == EqLookupNode::LookupStrategy::kIndexedLoopJoin);
+
+    // Few local documents make few index probes.
+    ASSERT(determineStrategy(10.0) == EqLookupNode::LookupStrategy::kIndexedLoopJoin);
+
+    // Many local documents make scanning the small foreign collection once cheaper.
+    ASSERT(determineStrategy(10000.0) == EqLookupNode::LookupStrategy::kHashJoin);
+
+    // The hash join still requires disk use to be allowed.
+    ASSERT(QueryPlannerAnalysis::determineLookupStrategy(
+               "test.foreign", "b", collectionsInfo, false /* allowDiskUse */, nullptr, 10000.0)
+               .first == EqLookupNode::LookupStrategy::kIndexedLoopJoin);
+}
+
 }  // namespace
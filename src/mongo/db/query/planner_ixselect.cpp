@@ -322,8 +322,15 @@ std::vector<IndexEntry> QueryPlannerIXSelect::findRelevantIndices(
 
         // If the index is non-sparse we can use the field regardless its sparsity, otherwise we
         // should find the field that can be answered by a sparse index.
-        if (fields.contains(fieldName) &&
-            (!index.sparse || fields.find(fieldName)->second.isSparse)) {
+        auto isRelevant = [&](const std::string& field) {
+            return fields.contains(field) &&
+                (!index.sparse || fields.find(field)->second.isSparse);
+        };
+        if (isRelevant(fieldName)) {
+            out.push_back(index);
+        } else if (index.allowSkipScan && it.more() &&
+                   isRelevant(it.next().fieldNameStringData().toString())) {
+            // The index can be skip-scanned for the predicates on its second field.
             out.push_back(index);
         }
     }
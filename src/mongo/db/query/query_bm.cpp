@@ -0,0 +1,193 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/db/dbdirectclient.h"
+#include "mongo/db/ops/write_ops.h"
+#include "mongo/db/pipeline/aggregate_command_gen.h"
+#include "mongo/db/query/find_command_gen.h"
+#include "mongo/db/service_context_d_bm_fixture.h"
+#include "mongo/idl/server_parameter_test_util.h"
+
+namespace mongo {
+namespace {
+
+const NamespaceString kNss("query_bm.coll");
+const size_t kInsertBatchSize = 1000;
+
+enum class Engine : int64_t { kClassic, kSbe, kBonsai };
+
+/**
+ * Stands up a mongod-like ServiceContext on an ephemeral WiredTiger instance so that queries go
+ * through the full command path (parsing, planning, execution and storage access) exactly as they
+ * would in a real server. Each benchmark run owns its own instance and its own dataset.
+ */
+class QueryBenchmarkFixture : public ServiceContextMongoDBenchmarkFixture {
+public:
+    QueryBenchmarkFixture() {
+        _opCtx = makeOperationContext();
+        _client.emplace(_opCtx.get());
+    }
+
+    ~QueryBenchmarkFixture() {
+        _client.reset();
+        _opCtx.reset();
+    }
+
+    /**
+     * Inserts 'numDocs' documents of the shape {_id: i, a: i % 100, b: <string>, c: i} and builds
+     * an index on 'a'.
+     */
+    void loadDataset(int numDocs) {
+        std::vector<BSONObj> batch;
+        batch.reserve(kInsertBatchSize);
+        for (int i = 0; i < numDocs; ++i) {
+            batch.push_back(BSON("_id" << i << "a" << i % 100 << "b"
+                                       << "payload"
+                                       << "c" << i));
+            if (batch.size() == kInsertBatchSize || i == numDocs - 1) {
+                write_ops::InsertCommandRequest insertOp(kNss);
+                insertOp.setDocuments(std::move(batch));
+                auto reply = _client->insert(insertOp);
+                invariant(!reply.getWriteErrors());
+                batch.clear();
+            }
+        }
+        _client->createIndex(kNss.ns(), BSON("a" << 1));
+    }
+
+    DBDirectClient& client() {
+        return *_client;
+    }
+
+private:
+    ServiceContext::UniqueOperationContext _opCtx;
+    boost::optional<DBDirectClient> _client;
+};
+
+/**
+ * Sets the knobs which select the query engine for the lifetime of this object.
+ */
+class ScopedEngineSelection {
+public:
+    explicit ScopedEngineSelection(Engine engine)
+        : _forceClassic("internalQueryForceClassicEngine", engine == Engine::kClassic),
+          _commonQueryFramework("featureFlagCommonQueryFramework", engine == Engine::kBonsai),
+          _cascades("internalQueryEnableCascadesOptimizer", engine == Engine::kBonsai) {}
+
+private:
+    RAIIServerParameterControllerForTest _forceClassic;
+    RAIIServerParameterControllerForTest _commonQueryFramework;
+    RAIIServerParameterControllerForTest _cascades;
+};
+
+size_t drain(DBClientCursor& cursor) {
+    size_t n = 0;
+    while (cursor.more()) {
+        benchmark::DoNotOptimize(cursor.next());
+        ++n;
+    }
+    return n;
+}
+
+/**
+ * Runs 'runQuery' against a freshly loaded collection of state.range(1) documents using the engine
+ * given by state.range(0). Items processed are counted per document in the collection, so the
+ * reported rate reflects the per-document cost of the query regardless of its selectivity.
+ */
+template <typename RunQuery>
+void benchmarkQuery(benchmark::State& state, RunQuery runQuery) {
+    const auto engine = static_cast<Engine>(state.range(0));
+    const auto numDocs = static_cast<int>(state.range(1));
+
+    QueryBenchmarkFixture fixture;
+    fixture.loadDataset(numDocs);
+    ScopedEngineSelection engineSelection(engine);
+
+    size_t numResults = 0;
+    for (auto keepRunning : state) {
+        numResults = runQuery(fixture.client());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * numDocs);
+    state.counters["results"] = numResults;
+}
+
+void BM_FindCollScan(benchmark::State& state) {
+    benchmarkQuery(state, [](DBDirectClient& client) {
+        FindCommandRequest findCmd(kNss);
+        findCmd.setFilter(BSON("c" << BSON("$lt" << 100)));
+        return drain(*client.find(std::move(findCmd)));
+    });
+}
+
+void BM_FindIndexScan(benchmark::State& state) {
+    benchmarkQuery(state, [](DBDirectClient& client) {
+        FindCommandRequest findCmd(kNss);
+        findCmd.setFilter(BSON("a" << 7));
+        findCmd.setProjection(BSON("_id" << 0 << "a" << 1 << "c" << 1));
+        return drain(*client.find(std::move(findCmd)));
+    });
+}
+
+void BM_AggregateMatchGroup(benchmark::State& state) {
+    benchmarkQuery(state, [](DBDirectClient& client) {
+        AggregateCommandRequest aggCmd(
+            kNss,
+            std::vector<BSONObj>{
+                BSON("$match" << BSON("a" << BSON("$lt" << 50))),
+                BSON("$group" << BSON("_id"
+                                      << "$a"
+                                      << "total" << BSON("$sum"
+                                                         << "$c"))),
+            });
+        auto cursor = uassertStatusOK(DBClientCursor::fromAggregationRequest(
+            &client, std::move(aggCmd), false /* secondaryOk */, false /* useExhaust */));
+        return drain(*cursor);
+    });
+}
+
+void engineAndDatasetArgs(benchmark::internal::Benchmark* b) {
+    for (auto engine : {Engine::kClassic, Engine::kSbe, Engine::kBonsai}) {
+        for (int64_t numDocs : {1000, 100000}) {
+            b->Args({static_cast<int64_t>(engine), numDocs});
+        }
+    }
+    b->ArgNames({"engine", "docs"});
+}
+
+BENCHMARK(BM_FindCollScan)->Apply(engineAndDatasetArgs);
+BENCHMARK(BM_FindIndexScan)->Apply(engineAndDatasetArgs);
+BENCHMARK(BM_AggregateMatchGroup)->Apply(engineAndDatasetArgs);
+
+}  // namespace
+}  // namespace mongo
@@ -342,6 +342,12 @@ string optionString(size_t options) {
             case QueryPlannerParams::STRICT_NO_TABLE_SCAN:
                 ss << "STRICT_NO_TABLE_SCAN ";
                 break;
+            case QueryPlannerParams::STRICT_NON_BLOCKING_SORT:
+                ss << "STRICT_NON_BLOCKING_SORT ";
+                break;
+            case QueryPlannerParams::SHARE_COLLECTION_SCANS:
+                ss << "SHARE_COLLECTION_SCANS ";
+                break;
             case QueryPlannerParams::DEFAULT:
                 MONGO_UNREACHABLE;
                 break;
@@ -1455,10 +1461,22 @@ std::unique_ptr<QuerySolution> QueryPlanner::extendWithAggPipeline(
         return nullptr;
     }
 
+    // The estimated number of documents output by the stages planned so far, which is the local
+    // side of the next $lookup.
+    auto localCardinality =
+        QueryPlannerAnalysis::estimateLookupLocalCardinality(query, secondaryCollInfos);
+
     std::unique_ptr<QuerySolutionNode> solnForAgg = std::make_unique<SentinelNode>();
     for (auto& innerStage : query.pipeline()) {
         auto groupStage = dynamic_cast<DocumentSourceGroup*>(innerStage->documentSource());
         if (groupStage) {
+            // A $group with a constant key outputs a single document. The number of groups is
+            // unknown otherwise.
+            if (!dynamic_cast<ExpressionConstant*>(groupStage->getIdExpression().get())) {
+                localCardinality = boost::none;
+            } else if (localCardinality) {
+                localCardinality = 1.0;
+            }
             solnForAgg =
                 std::make_unique<GroupNode>(std::move(solnForAgg),
                                             groupStage->getIdExpression(),
@@ -1478,7 +1496,13 @@ std::unique_ptr<QuerySolution> QueryPlanner::extendWithAggPipeline(
                 lookupStage->getForeignField()->fullPath(),
                 secondaryCollInfos,
                 query.getExpCtx()->allowDiskUse,
-                query.getCollator());
+                query.getCollator(),
+                localCardinality);
+            boost::optional<EqLookupNode::UnwindSpec> unwindSpec;
+            if (auto unwindSrc = lookupStage->getUnwindSource()) {
+                unwindSpec = EqLookupNode::UnwindSpec{unwindSrc->preserveNullAndEmptyArrays(),
+                                                      unwindSrc->indexPath()};
+            }
             auto eqLookupNode =
                 std::make_unique<EqLookupNode>(std::move(solnForAgg),
                                                lookupStage->getFromNs().toString(),
@@ -1487,8 +1511,15 @@ std::unique_ptr<QuerySolution> QueryPlanner::extendWithAggPipeline(
                                                lookupStage->getAsField().fullPath(),
                                                strategy,
                                                std::move(idxEntry),
-                                               innerStage->isLastSource() /* shouldProduceBson */);
+                                               innerStage->isLastSource() /* shouldProduceBson */,
+                                               std::move(unwindSpec));
             solnForAgg = std::move(eqLookupNode);
+
+            // A $lookup outputs one document per local one, unless it unwinds the matches into an
+            // unknown number of documents.
+            if (lookupStage->getUnwindSource()) {
+                localCardinality = boost::none;
+            }
             continue;
         }
 
@@ -1175,6 +1175,42 @@ TEST_F(QueryPlannerTest, CannotIntersectBoundsWhenFirstFieldIsMultikey) {
         "bounds: {a: [[-Infinity, 10, true, false]], b: [['MinKey', 'MaxKey', true, true]]}}}}}");
 }
 
+TEST_F(QueryPlannerTest, CoveredFilterOnNonMultikeyFieldOfMultikeyIndex) {
+    MultikeyPaths multikeyPaths{{0U}, MultikeyComponents{}};
+    addIndex(BSON("a" << 1 << "b" << 1), multikeyPaths);
+    runQuery(fromjson("{a: 2, b: /foo/}"));
+
+    assertNumSolutions(2U);
+    assertSolutionExists("{cscan: {dir: 1, filter: {$and: [{a: 2}, {b: /foo/}]}}}");
+    assertSolutionExists(
+        "{fetch: {filter: null, node: {ixscan: {filter: {b: /foo/}, pattern: {a: 1, b: 1}}}}}");
+}
+
+TEST_F(QueryPlannerTest, CoveredProjectionWithFilterOnNonMultikeyFieldOfMultikeyIndex) {
+    MultikeyPaths multikeyPaths{{0U}, MultikeyComponents{}};
+    addIndex(BSON("a" << 1 << "b" << 1), multikeyPaths);
+    runQuerySortProj(fromjson("{a: 2, b: /foo/}"), BSONObj(), fromjson("{_id: 0, b: 1}"));
+
+    assertNumSolutions(2U);
+    assertSolutionExists(
+        "{proj: {spec: {_id: 0, b: 1}, node: "
+        "{cscan: {dir: 1, filter: {$and: [{a: 2}, {b: /foo/}]}}}}}");
+    assertSolutionExists(
+        "{proj: {spec: {_id: 0, b: 1}, node: "
+        "{ixscan: {filter: {b: /foo/}, pattern: {a: 1, b: 1}}}}}");
+}
+
+TEST_F(QueryPlannerTest, MustFetchToFilterOnMultikeyField) {
+    MultikeyPaths multikeyPaths{MultikeyComponents{}, {0U}};
+    addIndex(BSON("a" << 1 << "b" << 1), multikeyPaths);
+    runQuery(fromjson("{a: 2, b: /foo/}"));
+
+    assertNumSolutions(2U);
+    assertSolutionExists("{cscan: {dir: 1, filter: {$and: [{a: 2}, {b: /foo/}]}}}");
+    assertSolutionExists(
+        "{fetch: {filter: {b: /foo/}, node: {ixscan: {filter: null, pattern: {a: 1, b: 1}}}}}");
+}
+
 TEST_F(QueryPlannerTest, CanIntersectBoundsWhenFirstFieldIsMultikeyButHasElemMatch) {
     MultikeyPaths multikeyPaths{{0U}, MultikeyComponents{}};
     addIndex(BSON("a" << 1 << "b" << 1), multikeyPaths);
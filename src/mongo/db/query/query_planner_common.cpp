@@ -103,6 +103,7 @@ void QueryPlannerCommon::reverseScans(QuerySolutionNode* node, bool reverseCollS
     } else if (STAGE_SORT_MERGE == type) {
         // reverse direction of comparison for merge
         MergeSortNode* msn = static_cast<MergeSortNode*>(node);
+        tassert(7000120, "Cannot reverse a merge on RecordId", !msn->mergeByRecordId);
         msn->sort = reverseSortObj(msn->sort);
     } else if (reverseCollScans && STAGE_COLLSCAN == type) {
         CollectionScanNode* collScan = static_cast<CollectionScanNode*>(node);
@@ -514,6 +514,25 @@ TEST_F(QueryPlannerTest, ShardFilterNoIndexNotCovered) {
         "{ixscan: {pattern: {b: 1}}}}}}}}}");
 }
 
+TEST_F(QueryPlannerTest, StrictNonBlockingSortKeepsOnlyIndexProvidedSorts) {
+    params.options = QueryPlannerParams::STRICT_NON_BLOCKING_SORT;
+    addIndex(BSON("a" << 1));
+    addIndex(BSON("b" << 1));
+
+    runQuerySortProj(fromjson("{a: {$gt: 1}, b: 1}"), fromjson("{a: -1}"), BSONObj());
+
+    assertNumSolutions(1U);
+    assertSolutionExists(
+        "{fetch: {filter: {b: 1}, node: {ixscan: {pattern: {a: 1}, dir: -1}}}}");
+}
+
+TEST_F(QueryPlannerTest, StrictNonBlockingSortFailsWhenNoIndexProvidesSort) {
+    params.options = QueryPlannerParams::STRICT_NON_BLOCKING_SORT;
+    addIndex(BSON("b" << 1));
+
+    runInvalidQuerySortProj(fromjson("{b: 1}"), fromjson("{a: 1}"), BSONObj());
+}
+
 TEST_F(QueryPlannerTest, CannotTrimIxisectParam) {
     params.options = QueryPlannerParams::INDEX_INTERSECTION;
     params.options |= QueryPlannerParams::NO_TABLE_SCAN;
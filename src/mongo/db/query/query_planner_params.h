@@ -158,6 +158,17 @@ struct QueryPlannerParams {
         // avoid a CLUSTEREDIDX_SCAN which comes built into a collection scan when the collection is
         // clustered.
         STRICT_NO_TABLE_SCAN = 1 << 13,
+
+        // Only output solutions which obtain the requested sort order from an index or from the
+        // order of a clustered collection scan. Solutions which would need a blocking SORT stage
+        // are discarded, so planning fails with NoQueryExecutionPlans if no index provides the
+        // sort. Used when the caller only wants the sort if it comes for free, e.g. to feed a
+        // streaming $group.
+        STRICT_NON_BLOCKING_SORT = 1 << 14,
+
+        // Let collection scans which need not return records in RecordId order start at the
+        // position of the concurrent scans of the same collection, see SharedScanRegistry.
+        SHARE_COLLECTION_SCANS = 1 << 15,
     };
 
     // See Options enum above.
@@ -29,6 +29,7 @@
 
 #include "mongo/platform/basic.h"
 
+#include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/json.h"
 #include "mongo/db/pipeline/document_source_group.h"
 #include "mongo/db/pipeline/document_source_mock.h"
@@ -36,6 +37,7 @@
 #include "mongo/db/pipeline/inner_pipeline_stage_interface.h"
 #include "mongo/db/query/query_planner_test_fixture.h"
 #include "mongo/db/query/query_planner_test_lib.h"
+#include "mongo/idl/server_parameter_test_util.h"
 
 namespace {
 using namespace mongo;
@@ -245,4 +247,58 @@ TEST_F(QueryPlannerPipelinePushdownTest, PushdownOfTwoLookupsAndTwoGroups) {
         solution->root()))
         << solution->root()->toString();
 }
+
+TEST_F(QueryPlannerPipelinePushdownTest, LookupStrategyUsesCardinalityOfPrecedingStages) {
+    RAIIServerParameterControllerForTest costBasedLookup{
+        "internalQueryEnableCostBasedLookupStrategy", true};
+
+    // A large local collection and a small foreign one with an index on the join field.
+    SecondaryCollectionInfo localInfo;
+    localInfo.noOfRecords = 100000;
+    SecondaryCollectionInfo foreignInfo;
+    foreignInfo.indexes.push_back(IndexEntry(BSON("y" << 1),
+                                             INDEX_BTREE,
+                                             IndexDescriptor::kLatestIndexVersion,
+                                             false /* multikey */,
+                                             {} /* multikeyPaths */,
+                                             {} /* multikeyPathSet */,
+                                             false /* sparse */,
+                                             false /* unique */,
+                                             CoreIndexInfo::Identifier("y_1"),
+                                             nullptr /* filterExpr */,
+                                             BSONObj() /* infoObj */,
+                                             nullptr /* collator */,
+                                             nullptr /* wildcardProjection */));
+    foreignInfo.noOfRecords = 1000;
+    const std::map<NamespaceString, SecondaryCollectionInfo> collectionsInfo{
+        {nss, localInfo}, {kSecondaryNamespace, foreignInfo}};
+
+    auto planLookupStrategy = [&](std::vector<BSONObj> rawPipeline) {
+        rawPipeline.push_back(fromjson("{$lookup: {from: '" +
+                                       kSecondaryNamespace.coll().toString() +
+                                       "', localField: 'x', foreignField: 'y', as: 'out'}}"));
+        auto pipeline = buildTestPipeline(rawPipeline);
+        runQueryWithPipeline(BSONObj(), makeInnerPipelineStages(*pipeline.get()));
+        ASSERT_EQUALS(getNumSolutions(), 1U);
+        // A hash join requires disk use to be allowed.
+        cq->getExpCtx()->allowDiskUse = true;
+        auto solution =
+            QueryPlanner::extendWithAggPipeline(*cq, std::move(solns[0]), collectionsInfo);
+        auto eqLookupNode = dynamic_cast<const EqLookupNode*>(solution->root());
+        ASSERT(eqLookupNode) << solution->root()->toString();
+        return eqLookupNode->lookupStrategy;
+    };
+
+    // Probing the index for each document of the local collection costs more than scanning the
+    // foreign collection once.
+    ASSERT(planLookupStrategy({}) == EqLookupNode::LookupStrategy::kHashJoin);
+
+    // The $group before the $lookup outputs a single document, which makes one index probe.
+    ASSERT(planLookupStrategy({fromjson("{$group: {_id: null, x: {$sum: '$a'}}}")}) ==
+           EqLookupNode::LookupStrategy::kIndexedLoopJoin);
+
+    // The number of groups is unknown, so the index is preferred.
+    ASSERT(planLookupStrategy({fromjson("{$group: {_id: '$a', x: {$sum: '$b'}}}")}) ==
+           EqLookupNode::LookupStrategy::kIndexedLoopJoin);
+}
 }  //  namespace
@@ -1124,7 +1124,16 @@ Status QueryPlannerTestLib::solutionMatches(const BSONObj& testSoln,
                     "corresponding 'mergeSort' object in the provided JSON"};
         }
         BSONObj mergeSortObj = el.Obj();
-        invariant(bsonObjFieldsAreInSet(mergeSortObj, {"nodes"}));
+        invariant(bsonObjFieldsAreInSet(mergeSortObj, {"nodes", "mergeByRecordId"}));
+
+        BSONElement mergeByRecordIdEl = mergeSortObj["mergeByRecordId"];
+        if (!mergeByRecordIdEl.eoo() && mergeByRecordIdEl.trueValue() != msn->mergeByRecordId) {
+            return {ErrorCodes::Error{7000119},
+                    str::stream() << "found a merge sort stage in the solution with mismatching "
+                                     "'mergeByRecordId'. Expected: "
+                                  << mergeByRecordIdEl.trueValue()
+                                  << " Found: " << msn->mergeByRecordId};
+        }
         return childrenMatch(mergeSortObj, msn, relaxBoundsCheck)
             .withContext("mismatching children below merge sort");
     } else if (STAGE_SKIP == trueSoln->getType()) {
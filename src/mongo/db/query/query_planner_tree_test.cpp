@@ -163,6 +163,53 @@ TEST_F(QueryPlannerTest, OrCollapsesToSingleScan3) {
         "bounds: {a: [[1,1,true,true], [3,3,true,true]]}}}}}");
 }
 
+TEST_F(QueryPlannerTest, OrOfPointScansMergesByRecordIdWhenEnabled) {
+    RAIIServerParameterControllerForTest controller("internalQueryPlannerEnableRecordIdMergeOr",
+                                                    true);
+    addIndex(BSON("a" << 1));
+    addIndex(BSON("b" << 1));
+    runQuery(fromjson("{$or: [{a: 1}, {b: 2}]}"));
+
+    ASSERT_EQUALS(getNumSolutions(), 2U);
+    assertSolutionExists("{cscan: {dir: 1}}");
+    assertSolutionExists(
+        "{fetch: {filter: null, node: {mergeSort: {mergeByRecordId: true, nodes: ["
+        "{ixscan: {filter: null, pattern: {a: 1}}}, "
+        "{ixscan: {filter: null, pattern: {b: 1}}}]}}}}");
+}
+
+TEST_F(QueryPlannerTest, OrWithRangeScanIsNotMergedByRecordId) {
+    RAIIServerParameterControllerForTest controller("internalQueryPlannerEnableRecordIdMergeOr",
+                                                    true);
+    addIndex(BSON("a" << 1));
+    addIndex(BSON("b" << 1));
+    runQuery(fromjson("{$or: [{a: 1}, {b: {$gt: 2}}]}"));
+
+    ASSERT_EQUALS(getNumSolutions(), 2U);
+    assertSolutionExists("{cscan: {dir: 1}}");
+    assertSolutionExists(
+        "{fetch: {filter: null, node: {or: {nodes: ["
+        "{ixscan: {filter: null, pattern: {a: 1}}}, "
+        "{ixscan: {filter: null, pattern: {b: 1}}}]}}}}");
+}
+
+TEST_F(QueryPlannerTest, SortedOrOfPointScansIsNotMergedByRecordId) {
+    RAIIServerParameterControllerForTest controller("internalQueryPlannerEnableRecordIdMergeOr",
+                                                    true);
+    addIndex(BSON("a" << 1));
+    addIndex(BSON("b" << 1));
+    runQuerySortProj(fromjson("{$or: [{a: 1}, {b: 2}]}"), fromjson("{c: 1}"), BSONObj());
+
+    ASSERT_EQUALS(getNumSolutions(), 2U);
+    assertSolutionExists(
+        "{sort: {pattern: {c: 1}, limit: 0, node: {sortKeyGen: {node: {cscan: {dir: 1}}}}}}");
+    assertSolutionExists(
+        "{sort: {pattern: {c: 1}, limit: 0, node: {sortKeyGen: {node: "
+        "{fetch: {filter: null, node: {or: {nodes: ["
+        "{ixscan: {filter: null, pattern: {a: 1}}}, "
+        "{ixscan: {filter: null, pattern: {b: 1}}}]}}}}}}}}");
+}
+
 TEST_F(QueryPlannerTest, OrOnlyOneBranchCanUseIndex) {
     addIndex(BSON("a" << 1));
     runQuery(fromjson("{$or: [{a:1}, {b:2}]}"));
@@ -0,0 +1,233 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/query_result_cache.h"
+
+#include <algorithm>
+#include <boost/functional/hash.hpp>
+#include <limits>
+
+#include "mongo/db/commands/server_status_metric.h"
+#include "mongo/db/query/query_result_cache_gen.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+namespace {
+
+const auto getQueryResultCache = ServiceContext::declareDecoration<QueryResultCache>();
+
+// Whether 'queryResultCacheNamespaces' is non-empty, so that queries against other collections
+// need not take the parameter's mutex.
+AtomicWord<bool> queryResultCacheEnabled{false};
+
+Counter64 queryResultCacheHits;
+Counter64 queryResultCacheMisses;
+Counter64 queryResultCacheTotalSizeEstimateBytes;
+
+ServerStatusMetricField<Counter64> queryResultCacheHitsMetric("query.resultCache.hits",
+                                                              &queryResultCacheHits);
+ServerStatusMetricField<Counter64> queryResultCacheMissesMetric("query.resultCache.misses",
+                                                                &queryResultCacheMisses);
+ServerStatusMetricField<Counter64> queryResultCacheTotalSizeEstimateBytesMetric(
+    "query.resultCache.totalSizeEstimateBytes", &queryResultCacheTotalSizeEstimateBytes);
+
+}  // namespace
+
+Status validateQueryResultCacheNamespaces(const std::vector<std::string> value) {
+    for (const auto& nsStr : value) {
+        if (!NamespaceString(nsStr).isValid()) {
+            return Status(ErrorCodes::BadValue,
+                          str::stream() << "'" << nsStr << "' is not a valid namespace");
+        }
+    }
+    return Status::OK();
+}
+
+Status onQueryResultCacheNamespacesUpdate(const std::vector<std::string>& value) {
+    queryResultCacheEnabled.store(!value.empty());
+
+    // Start from scratch so that the collections which are no longer listed release their memory.
+    if (hasGlobalServiceContext()) {
+        QueryResultCache::get(getGlobalServiceContext()).clear();
+    }
+    return Status::OK();
+}
+
+size_t QueryResultCache::KeyHasher::operator()(const Key& key) const {
+    size_t hash = UUID::Hash{}(key.first);
+    boost::hash_combine(hash, std::hash<std::string>{}(key.second));
+    return hash;
+}
+
+QueryResultCache::QueryResultCache() : _cache(std::numeric_limits<size_t>::max()) {}
+
+QueryResultCache& QueryResultCache::get(ServiceContext* serviceContext) {
+    return getQueryResultCache(serviceContext);
+}
+
+QueryResultCache& QueryResultCache::get(OperationContext* opCtx) {
+    return get(opCtx->getServiceContext());
+}
+
+bool QueryResultCache::isEnabled() {
+    return queryResultCacheEnabled.load();
+}
+
+bool QueryResultCache::isEnabledForNamespace(const NamespaceString& nss) {
+    if (!isEnabled()) {
+        return false;
+    }
+
+    auto namespaces = gQueryResultCacheNamespaces.synchronize();
+    return std::find(namespaces->begin(), namespaces->end(), nss.ns()) != namespaces->end();
+}
+
+boost::optional<std::vector<BSONObj>> QueryResultCache::lookup(const UUID& uuid,
+                                                               const std::string& key) {
+    stdx::lock_guard<Latch> lk(_mutex);
+
+    auto collIt = _collections.find(uuid);
+    if (collIt == _collections.end()) {
+        collIt = _collections.emplace(uuid, CollectionState{_epoch.addAndFetch(1)}).first;
+    }
+    auto& coll = collIt->second;
+
+    auto it = _cache.find(Key{uuid, key});
+    if (it != _cache.end()) {
+        if (it->second.epoch == coll.epoch) {
+            ++coll.hits;
+            queryResultCacheHits.increment();
+            return it->second.results;
+        }
+
+        // The collection has been written to since this entry was added.
+        _erase_inlock(it);
+    }
+
+    ++coll.misses;
+    queryResultCacheMisses.increment();
+    return boost::none;
+}
+
+void QueryResultCache::add(const UUID& uuid,
+                           const std::string& key,
+                           uint64_t epoch,
+                           std::vector<BSONObj> results) {
+    size_t sizeBytes = sizeof(Entry) + sizeof(Key) + key.size();
+    for (auto&& obj : results) {
+        sizeBytes += obj.objsize();
+    }
+
+    const auto maxSizeBytes = static_cast<size_t>(internalQueryResultCacheMaxSizeBytes.load());
+    if (sizeBytes > maxSizeBytes) {
+        return;
+    }
+
+    stdx::lock_guard<Latch> lk(_mutex);
+
+    auto collIt = _collections.find(uuid);
+    if (collIt == _collections.end() || collIt->second.epoch > epoch) {
+        return;
+    }
+
+    Key cacheKey{uuid, key};
+    if (auto it = _cache.cfind(cacheKey); it != _cache.cend()) {
+        _sizeBytes -= it->second.sizeBytes;
+        queryResultCacheTotalSizeEstimateBytes.decrement(it->second.sizeBytes);
+    }
+    _cache.add(cacheKey, Entry{std::move(results), collIt->second.epoch, sizeBytes});
+    _sizeBytes += sizeBytes;
+    queryResultCacheTotalSizeEstimateBytes.increment(sizeBytes);
+
+    while (_sizeBytes > maxSizeBytes) {
+        _erase_inlock(std::prev(_cache.end()));
+    }
+}
+
+void QueryResultCache::notifyOfWrite(const UUID& uuid) {
+    stdx::lock_guard<Latch> lk(_mutex);
+
+    // The entries of the collection are reclaimed lazily, by lookups and by LRU eviction.
+    if (auto it = _collections.find(uuid); it != _collections.end()) {
+        it->second.epoch = _epoch.addAndFetch(1);
+    }
+}
+
+void QueryResultCache::notifyOfDrop(const UUID& uuid) {
+    stdx::lock_guard<Latch> lk(_mutex);
+
+    if (_collections.erase(uuid) == 0) {
+        return;
+    }
+
+    for (auto it = _cache.begin(); it != _cache.end();) {
+        auto next = std::next(it);
+        if (it->first.first == uuid) {
+            _erase_inlock(it);
+        }
+        it = next;
+    }
+}
+
+void QueryResultCache::clear() {
+    stdx::lock_guard<Latch> lk(_mutex);
+
+    _collections.clear();
+    _cache.clear();
+    queryResultCacheTotalSizeEstimateBytes.decrement(_sizeBytes);
+    _sizeBytes = 0;
+}
+
+void QueryResultCache::appendCollectionStats(const UUID& uuid, BSONObjBuilder* builder) const {
+    stdx::lock_guard<Latch> lk(_mutex);
+
+    auto it = _collections.find(uuid);
+    if (it == _collections.end()) {
+        return;
+    }
+
+    BSONObjBuilder bob(builder->subobjStart("queryResultCache"));
+    bob.appendNumber("hits", it->second.hits);
+    bob.appendNumber("misses", it->second.misses);
+}
+
+size_t QueryResultCache::getSizeBytes() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _sizeBytes;
+}
+
+void QueryResultCache::_erase_inlock(Cache::iterator it) {
+    _sizeBytes -= it->second.sizeBytes;
+    queryResultCacheTotalSizeEstimateBytes.decrement(it->second.sizeBytes);
+    _cache.erase(it);
+}
+
+}  // namespace mongo
@@ -0,0 +1,174 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/service_context.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/lru_cache.h"
+#include "mongo/util/uuid.h"
+
+namespace mongo {
+
+/**
+ * Validates and applies the 'queryResultCacheNamespaces' server parameter.
+ */
+Status validateQueryResultCacheNamespaces(std::vector<std::string> value);
+Status onQueryResultCacheNamespacesUpdate(const std::vector<std::string>& value);
+
+/**
+ * An opt-in cache of complete find results for read-mostly collections. Entries are keyed by the
+ * collection UUID and a string which identifies the query and all of its parameters, and hold the
+ * documents which the query returned.
+ *
+ * Every tracked collection has a write epoch which the OpObserver advances when a write to the
+ * collection commits. A reader obtains the current epoch through getEpoch() before it opens its
+ * storage snapshot and passes it to add(), which rejects the results if any write to the
+ * collection has committed since. An entry is only served while the epoch at which it was added
+ * is still current, so a result which predates a write is never returned after the write has
+ * committed. Writes to collections which are not tracked yet do not advance any epoch, so the
+ * first lookup on a collection only starts tracking it.
+ *
+ * The total size of the cached results is bounded by 'internalQueryResultCacheMaxSizeBytes', with
+ * the least recently used entries evicted first. All methods are thread-safe.
+ */
+class QueryResultCache {
+    QueryResultCache(const QueryResultCache&) = delete;
+    QueryResultCache& operator=(const QueryResultCache&) = delete;
+
+public:
+    QueryResultCache();
+
+    static QueryResultCache& get(ServiceContext* serviceContext);
+    static QueryResultCache& get(OperationContext* opCtx);
+
+    /**
+     * Returns true if the 'queryResultCacheNamespaces' server parameter is non-empty. Writes need
+     * not notify the cache otherwise.
+     */
+    static bool isEnabled();
+
+    /**
+     * Returns true if 'nss' is listed in the 'queryResultCacheNamespaces' server parameter.
+     */
+    static bool isEnabledForNamespace(const NamespaceString& nss);
+
+    /**
+     * Returns the current epoch. Must be called before the storage snapshot from which the
+     * results passed to add() are read is opened.
+     */
+    uint64_t getEpoch() const {
+        return _epoch.load();
+    }
+
+    /**
+     * Returns the cached results for 'key' on the collection 'uuid', counting a hit or a miss,
+     * and starts tracking writes to the collection if it is not tracked yet.
+     */
+    boost::optional<std::vector<BSONObj>> lookup(const UUID& uuid, const std::string& key);
+
+    /**
+     * Caches 'results' for 'key' on the collection 'uuid', unless a write to the collection has
+     * committed since getEpoch() returned 'epoch' or the results do not fit in the cache.
+     */
+    void add(const UUID& uuid,
+             const std::string& key,
+             uint64_t epoch,
+             std::vector<BSONObj> results);
+
+    /**
+     * Invalidates all the cached results for the collection 'uuid'. Called on commit of every
+     * write to the collection.
+     */
+    void notifyOfWrite(const UUID& uuid);
+
+    /**
+     * Forgets the collection 'uuid' altogether, for example because it has been dropped.
+     */
+    void notifyOfDrop(const UUID& uuid);
+
+    /**
+     * Removes all the entries and stops tracking all the collections.
+     */
+    void clear();
+
+    /**
+     * Appends the hit and miss counters of the collection 'uuid' to 'builder' as a
+     * 'queryResultCache' sub-object. Appends nothing if the collection is not tracked.
+     */
+    void appendCollectionStats(const UUID& uuid, BSONObjBuilder* builder) const;
+
+    size_t getSizeBytes() const;
+
+private:
+    struct CollectionState {
+        uint64_t epoch;
+        long long hits = 0;
+        long long misses = 0;
+    };
+
+    struct Entry {
+        std::vector<BSONObj> results;
+        uint64_t epoch;
+        size_t sizeBytes;
+    };
+
+    using Key = std::pair<UUID, std::string>;
+
+    struct KeyHasher {
+        size_t operator()(const Key& key) const;
+    };
+
+    using Cache = LRUCache<Key, Entry, KeyHasher>;
+
+    void _erase_inlock(Cache::iterator it);
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("QueryResultCache::_mutex");
+
+    // The epochs of all the collections are drawn from this single counter, so that a reader can
+    // capture one value before it knows which collection it reads, and so that a collection which
+    // stops being tracked and is tracked again never reuses the epoch of a stale entry.
+    AtomicWord<uint64_t> _epoch{0};
+
+    stdx::unordered_map<UUID, CollectionState, UUID::Hash> _collections;
+    Cache _cache;
+    size_t _sizeBytes = 0;
+};
+
+}  // namespace mongo
@@ -0,0 +1,135 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/query_result_cache_op_observer.h"
+
+#include "mongo/db/query/query_result_cache.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Invalidates the cached results of the collection 'uuid' once the current write has committed.
+ * The invalidation must not happen any earlier: a reader which obtained the epoch before the
+ * commit may still be reading from a snapshot which does not contain the write.
+ *
+ * Writes which started before the cache was enabled register no handler, so results cached while
+ * such a write is still in progress are not invalidated by it.
+ */
+void invalidateOnCommit(OperationContext* opCtx, const UUID& uuid) {
+    if (!QueryResultCache::isEnabled()) {
+        return;
+    }
+
+    auto& cache = QueryResultCache::get(opCtx);
+    opCtx->recoveryUnit()->onCommit(
+        [&cache, uuid](boost::optional<Timestamp>) { cache.notifyOfWrite(uuid); });
+}
+
+void dropOnCommit(OperationContext* opCtx, const UUID& uuid) {
+    if (!QueryResultCache::isEnabled()) {
+        return;
+    }
+
+    auto& cache = QueryResultCache::get(opCtx);
+    opCtx->recoveryUnit()->onCommit(
+        [&cache, uuid](boost::optional<Timestamp>) { cache.notifyOfDrop(uuid); });
+}
+
+}  // namespace
+
+void QueryResultCacheOpObserver::onInserts(OperationContext* opCtx,
+                                           const NamespaceString& nss,
+                                           const UUID& uuid,
+                                           std::vector<InsertStatement>::const_iterator first,
+                                           std::vector<InsertStatement>::const_iterator last,
+                                           bool fromMigrate) {
+    invalidateOnCommit(opCtx, uuid);
+}
+
+void QueryResultCacheOpObserver::onUpdate(OperationContext* opCtx,
+                                          const OplogUpdateEntryArgs& args) {
+    invalidateOnCommit(opCtx, args.uuid);
+}
+
+void QueryResultCacheOpObserver::onDelete(OperationContext* opCtx,
+                                          const NamespaceString& nss,
+                                          const UUID& uuid,
+                                          StmtId stmtId,
+                                          const OplogDeleteEntryArgs& args) {
+    invalidateOnCommit(opCtx, uuid);
+}
+
+void QueryResultCacheOpObserver::onEmptyCapped(OperationContext* opCtx,
+                                               const NamespaceString& collectionName,
+                                               const UUID& uuid) {
+    invalidateOnCommit(opCtx, uuid);
+}
+
+repl::OpTime QueryResultCacheOpObserver::onDropCollection(OperationContext* opCtx,
+                                                          const NamespaceString& collectionName,
+                                                          const UUID& uuid,
+                                                          std::uint64_t numRecords,
+                                                          CollectionDropType dropType) {
+    dropOnCommit(opCtx, uuid);
+    return {};
+}
+
+void QueryResultCacheOpObserver::onRenameCollection(OperationContext* opCtx,
+                                                    const NamespaceString& fromCollection,
+                                                    const NamespaceString& toCollection,
+                                                    const UUID& uuid,
+                                                    const boost::optional<UUID>& dropTargetUUID,
+                                                    std::uint64_t numRecords,
+                                                    bool stayTemp) {
+    postRenameCollection(opCtx, fromCollection, toCollection, uuid, dropTargetUUID, stayTemp);
+}
+
+void QueryResultCacheOpObserver::postRenameCollection(OperationContext* opCtx,
+                                                      const NamespaceString& fromCollection,
+                                                      const NamespaceString& toCollection,
+                                                      const UUID& uuid,
+                                                      const boost::optional<UUID>& dropTargetUUID,
+                                                      bool stayTemp) {
+    // The collection keeps its UUID, but it may no longer be listed for caching under its new
+    // name.
+    dropOnCommit(opCtx, uuid);
+    if (dropTargetUUID) {
+        dropOnCommit(opCtx, *dropTargetUUID);
+    }
+}
+
+void QueryResultCacheOpObserver::_onReplicationRollback(OperationContext* opCtx,
+                                                       const RollbackObserverInfo& rbInfo) {
+    QueryResultCache::get(opCtx).clear();
+}
+
+}  // namespace mongo
@@ -0,0 +1,168 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/query_result_cache.h"
+
+#include "mongo/bson/json.h"
+#include "mongo/idl/server_parameter_test_util.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+std::vector<BSONObj> makeResults(std::initializer_list<const char*> docs) {
+    std::vector<BSONObj> results;
+    for (auto&& doc : docs) {
+        results.push_back(fromjson(doc));
+    }
+    return results;
+}
+
+void assertResultsEqual(const std::vector<BSONObj>& expected,
+                        const boost::optional<std::vector<BSONObj>>& actual) {
+    ASSERT(actual);
+    ASSERT_EQ(expected.size(), actual->size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_BSONOBJ_EQ(expected[i], (*actual)[i]);
+    }
+}
+
+TEST(QueryResultCacheTest, FirstLookupOnlyStartsTrackingTheCollection) {
+    QueryResultCache cache;
+    const auto uuid = UUID::gen();
+    const auto results = makeResults({"{_id: 1}", "{_id: 2}"});
+
+    // A write to the collection could have committed before the first lookup without advancing
+    // any epoch, so results read before it must not be cached.
+    const auto untrackedEpoch = cache.getEpoch();
+    ASSERT_FALSE(cache.lookup(uuid, "q"));
+    cache.add(uuid, "q", untrackedEpoch, results);
+    ASSERT_FALSE(cache.lookup(uuid, "q"));
+
+    const auto epoch = cache.getEpoch();
+    ASSERT_FALSE(cache.lookup(uuid, "q"));
+    cache.add(uuid, "q", epoch, results);
+    assertResultsEqual(results, cache.lookup(uuid, "q"));
+    ASSERT_FALSE(cache.lookup(uuid, "other"));
+    ASSERT_FALSE(cache.lookup(UUID::gen(), "q"));
+}
+
+TEST(QueryResultCacheTest, WriteInvalidatesEntriesOfTheCollectionOnly) {
+    QueryResultCache cache;
+    const auto uuid = UUID::gen();
+    const auto otherUuid = UUID::gen();
+    const auto results = makeResults({"{_id: 1}"});
+
+    cache.lookup(uuid, "q");
+    cache.lookup(otherUuid, "q");
+    const auto epoch = cache.getEpoch();
+    cache.add(uuid, "q", epoch, results);
+    cache.add(otherUuid, "q", epoch, results);
+
+    cache.notifyOfWrite(uuid);
+    ASSERT_FALSE(cache.lookup(uuid, "q"));
+    assertResultsEqual(results, cache.lookup(otherUuid, "q"));
+
+    // Results read before the write committed are rejected.
+    cache.add(uuid, "q", epoch, results);
+    ASSERT_FALSE(cache.lookup(uuid, "q"));
+
+    cache.add(uuid, "q", cache.getEpoch(), results);
+    assertResultsEqual(results, cache.lookup(uuid, "q"));
+}
+
+TEST(QueryResultCacheTest, DropForgetsTheCollection) {
+    QueryResultCache cache;
+    const auto uuid = UUID::gen();
+
+    cache.lookup(uuid, "q");
+    const auto epoch = cache.getEpoch();
+    cache.add(uuid, "q", epoch, makeResults({"{_id: 1}"}));
+    ASSERT_GT(cache.getSizeBytes(), 0U);
+
+    cache.notifyOfDrop(uuid);
+    ASSERT_EQ(0U, cache.getSizeBytes());
+
+    BSONObjBuilder bob;
+    cache.appendCollectionStats(uuid, &bob);
+    ASSERT_BSONOBJ_EQ(BSONObj(), bob.obj());
+
+    // The collection is not tracked any more, so the results are not cached.
+    cache.add(uuid, "q", epoch, makeResults({"{_id: 1}"}));
+    ASSERT_FALSE(cache.lookup(uuid, "q"));
+}
+
+TEST(QueryResultCacheTest, EvictsLeastRecentlyUsedEntriesToStayWithinSizeLimit) {
+    QueryResultCache cache;
+    const auto uuid = UUID::gen();
+    const auto results = makeResults({"{_id: 1, s: 'xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx'}"});
+
+    cache.lookup(uuid, "a");
+    auto epoch = cache.getEpoch();
+    cache.add(uuid, "a", epoch, results);
+    const auto entrySize = cache.getSizeBytes();
+
+    RAIIServerParameterControllerForTest controller("internalQueryResultCacheMaxSizeBytes",
+                                                    static_cast<long long>(2 * entrySize));
+    cache.add(uuid, "b", epoch, results);
+    ASSERT_EQ(2 * entrySize, cache.getSizeBytes());
+
+    // Use "a" so that "b" is the least recently used entry.
+    assertResultsEqual(results, cache.lookup(uuid, "a"));
+    cache.add(uuid, "c", epoch, results);
+    ASSERT_EQ(2 * entrySize, cache.getSizeBytes());
+    ASSERT_TRUE(cache.lookup(uuid, "a"));
+    ASSERT_FALSE(cache.lookup(uuid, "b"));
+    ASSERT_TRUE(cache.lookup(uuid, "c"));
+
+    // Results which would not fit even in an empty cache are not cached.
+    cache.add(uuid, "d", epoch, std::vector<BSONObj>(10, results[0]));
+    ASSERT_FALSE(cache.lookup(uuid, "d"));
+    ASSERT_TRUE(cache.lookup(uuid, "a"));
+}
+
+TEST(QueryResultCacheTest, CountsHitsAndMissesPerCollection) {
+    QueryResultCache cache;
+    const auto uuid = UUID::gen();
+
+    cache.lookup(uuid, "q");
+    cache.add(uuid, "q", cache.getEpoch(), makeResults({"{_id: 1}"}));
+    cache.lookup(uuid, "q");
+    cache.lookup(uuid, "q");
+    cache.lookup(uuid, "other");
+
+    BSONObjBuilder bob;
+    cache.appendCollectionStats(uuid, &bob);
+    ASSERT_BSONOBJ_EQ(fromjson("{queryResultCache: {hits: 2, misses: 2}}"), bob.obj());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -0,0 +1,229 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/query_shape_stats.h"
+
+#include <algorithm>
+
+#include "mongo/db/commands/server_status.h"
+#include "mongo/db/query/query_shape_stats_gen.h"
+#include "mongo/platform/bits.h"
+#include "mongo/util/hex.h"
+
+namespace mongo {
+namespace {
+
+const auto getQueryShapeStatsStore = ServiceContext::declareDecoration<QueryShapeStatsStore>();
+
+/**
+ * Returns the index of the power-of-two bucket which holds 'micros': bucket 0 holds zero, and
+ * bucket i > 0 holds the values in [2^(i-1), 2^i), with the last bucket open-ended.
+ */
+size_t latencyBucket(long long micros) {
+    if (micros <= 0) {
+        return 0;
+    }
+    return std::min<size_t>(64 - countLeadingZeros64(micros),
+                            QueryShapeStatsStore::kNumLatencyBuckets - 1);
+}
+
+/**
+ * Returns an upper bound on the given percentile of the latencies counted in 'buckets'.
+ */
+long long estimatePercentile(
+    const std::array<long long, QueryShapeStatsStore::kNumLatencyBuckets>& buckets,
+    long long count,
+    long long maxMicros,
+    int percentile) {
+    const long long rank = std::max(1LL, (count * percentile + 99) / 100);
+    long long seen = 0;
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            return i == 0 ? 0 : std::min(maxMicros, (1LL << i) - 1);
+        }
+    }
+    return maxMicros;
+}
+
+class QueryShapeStatsSSS : public ServerStatusSection {
+public:
+    QueryShapeStatsSSS() : ServerStatusSection("queryShapeStats") {}
+
+    bool includeByDefault() const override {
+        // The section holds one object per tracked shape, which is too large to be collected on
+        // every serverStatus call.
+        return false;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx, const BSONElement& configElem) const override {
+        auto& store = QueryShapeStatsStore::get(opCtx);
+        if (!store.isEnabled()) {
+            return BSONObj();
+        }
+
+        BSONObjBuilder bob;
+        bob.appendNumber("numShapes", static_cast<long long>(store.size()));
+        bob.appendNumber("numReplacements", store.getNumReplacements());
+        BSONArrayBuilder shapes(bob.subarrayStart("shapes"));
+        store.appendShapes(&shapes);
+        shapes.done();
+        return bob.obj();
+    }
+} queryShapeStatsSSS;
+
+}  // namespace
+
+QueryShapeStatsStore::QueryShapeStatsStore()
+    : QueryShapeStatsStore(static_cast<size_t>(internalQueryShapeStatsMaxEntries.load())) {}
+
+QueryShapeStatsStore::QueryShapeStatsStore(size_t capacity) : _capacity(capacity) {
+    _entries.reserve(_capacity);
+    _positions.reserve(_capacity);
+}
+
+QueryShapeStatsStore& QueryShapeStatsStore::get(ServiceContext* serviceContext) {
+    return getQueryShapeStatsStore(serviceContext);
+}
+
+QueryShapeStatsStore& QueryShapeStatsStore::get(OperationContext* opCtx) {
+    return get(opCtx->getServiceContext());
+}
+
+void QueryShapeStatsStore::record(uint32_t queryHash,
+                                  Microseconds executionTime,
+                                  long long keysExamined,
+                                  long long docsExamined) {
+    if (!isEnabled()) {
+        return;
+    }
+
+    const long long micros = durationCount<Microseconds>(executionTime);
+
+    stdx::lock_guard<Latch> lk(_mutex);
+
+    size_t pos;
+    if (auto it = _positions.find(queryHash); it != _positions.end()) {
+        pos = it->second;
+    } else if (_entries.size() < _capacity) {
+        // A new shape has the smallest count, so it belongs at the end.
+        pos = _entries.size();
+        _positions.emplace(queryHash, pos);
+        _entries.emplace_back().queryHash = queryHash;
+    } else {
+        // Replace the least frequent shape, which is the last one.
+        pos = _entries.size() - 1;
+        Entry& victim = _entries[pos];
+        _positions.erase(victim.queryHash);
+        _positions.emplace(queryHash, pos);
+
+        const long long inheritedCount = victim.count;
+        victim = Entry{};
+        victim.queryHash = queryHash;
+        victim.count = inheritedCount;
+        victim.countError = inheritedCount;
+        ++_numReplacements;
+    }
+
+    Entry* entry = &_entries[_incrementCount(pos)];
+    entry->totalExecMicros += micros;
+    entry->maxExecMicros = std::max(entry->maxExecMicros, micros);
+    entry->keysExamined += keysExamined;
+    entry->docsExamined += docsExamined;
+    ++entry->latencyBuckets[latencyBucket(micros)];
+}
+
+size_t QueryShapeStatsStore::_incrementCount(size_t pos) {
+    // Swap the entry with the first one of equal count, so that incrementing it keeps '_entries'
+    // sorted by decreasing count.
+    const long long count = _entries[pos].count;
+    auto first = std::partition_point(_entries.begin(),
+                                      _entries.begin() + pos,
+                                      [&](const Entry& entry) { return entry.count > count; });
+    const size_t newPos = first - _entries.begin();
+    if (newPos != pos) {
+        std::swap(_entries[newPos], _entries[pos]);
+        _positions[_entries[newPos].queryHash] = newPos;
+        _positions[_entries[pos].queryHash] = pos;
+    }
+    ++_entries[newPos].count;
+    return newPos;
+}
+
+void QueryShapeStatsStore::appendShapes(BSONArrayBuilder* builder) const {
+    std::vector<Entry> entries;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        entries = _entries;
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const Entry& lhs, const Entry& rhs) {
+        return lhs.totalExecMicros > rhs.totalExecMicros;
+    });
+    for (auto&& entry : entries) {
+        BSONObjBuilder entryBuilder(builder->subobjStart());
+        _appendEntry(entry, &entryBuilder);
+    }
+}
+
+size_t QueryShapeStatsStore::size() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _entries.size();
+}
+
+long long QueryShapeStatsStore::getNumReplacements() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _numReplacements;
+}
+
+void QueryShapeStatsStore::_appendEntry(const Entry& entry, BSONObjBuilder* builder) {
+    // The operations counted before the shape replaced another one carry no statistics.
+    const long long measured = entry.count - entry.countError;
+
+    builder->append("queryHash", zeroPaddedHex(entry.queryHash));
+    builder->appendNumber("count", entry.count);
+    builder->appendNumber("countError", entry.countError);
+    builder->appendNumber("totalExecMicros", entry.totalExecMicros);
+    builder->appendNumber("maxExecMicros", entry.maxExecMicros);
+    builder->appendNumber(
+        "p50ExecMicros",
+        estimatePercentile(entry.latencyBuckets, measured, entry.maxExecMicros, 50));
+    builder->appendNumber(
+        "p95ExecMicros",
+        estimatePercentile(entry.latencyBuckets, measured, entry.maxExecMicros, 95));
+    builder->appendNumber(
+        "p99ExecMicros",
+        estimatePercentile(entry.latencyBuckets, measured, entry.maxExecMicros, 99));
+    builder->appendNumber("keysExamined", entry.keysExamined);
+    builder->appendNumber("docsExamined", entry.docsExamined);
+}
+
+}  // namespace mongo
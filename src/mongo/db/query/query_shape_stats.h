@@ -0,0 +1,131 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <absl/container/flat_hash_map.h>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/service_context.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/duration.h"
+
+namespace mongo {
+
+/**
+ * A fixed-size, in-memory store of execution statistics per query shape, keyed by the query hash
+ * which the planner records in OpDebug. Each operation which ran against a known shape, including
+ * the getMores of its cursor, adds its latency and the number of keys and documents it examined.
+ *
+ * At most 'internalQueryShapeStatsMaxEntries' shapes are tracked. When the store is full, the
+ * shapes are kept by the Space-Saving algorithm: a new shape replaces the tracked shape with the
+ * smallest execution count and inherits that count, which is reported as the shape's 'countError'.
+ * Every shape which executed more than 1/capacity of all operations is therefore guaranteed to be
+ * tracked, so the store always holds the heavy hitters, while the statistics of a replaced shape
+ * start over. Latencies are summarised in power-of-two buckets, from which the percentiles are
+ * estimated to within a factor of two.
+ *
+ * All methods are thread-safe.
+ */
+class QueryShapeStatsStore {
+    QueryShapeStatsStore(const QueryShapeStatsStore&) = delete;
+    QueryShapeStatsStore& operator=(const QueryShapeStatsStore&) = delete;
+
+public:
+    static constexpr size_t kNumLatencyBuckets = 32;
+
+    /**
+     * Creates a store sized by the 'internalQueryShapeStatsMaxEntries' startup parameter.
+     */
+    QueryShapeStatsStore();
+
+    explicit QueryShapeStatsStore(size_t capacity);
+
+    static QueryShapeStatsStore& get(ServiceContext* serviceContext);
+    static QueryShapeStatsStore& get(OperationContext* opCtx);
+
+    bool isEnabled() const {
+        return _capacity > 0;
+    }
+
+    /**
+     * Adds the statistics of one operation on the shape 'queryHash'.
+     */
+    void record(uint32_t queryHash,
+                Microseconds executionTime,
+                long long keysExamined,
+                long long docsExamined);
+
+    /**
+     * Appends one object per tracked shape to 'builder', in decreasing order of total execution
+     * time.
+     */
+    void appendShapes(BSONArrayBuilder* builder) const;
+
+    size_t size() const;
+
+    long long getNumReplacements() const;
+
+private:
+    struct Entry {
+        uint32_t queryHash;
+        long long count = 0;
+        long long countError = 0;
+        long long totalExecMicros = 0;
+        long long maxExecMicros = 0;
+        long long keysExamined = 0;
+        long long docsExamined = 0;
+        std::array<long long, kNumLatencyBuckets> latencyBuckets{};
+    };
+
+    static void _appendEntry(const Entry& entry, BSONObjBuilder* builder);
+
+    /**
+     * Increments the count of the entry at 'pos' and returns its new position.
+     */
+    size_t _incrementCount(size_t pos);
+
+    const size_t _capacity;
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("QueryShapeStatsStore::_mutex");
+
+    // The tracked shapes in decreasing order of count, and the position of each of them in
+    // '_entries'. Since counts only ever grow by one, an increment moves an entry to the front of
+    // its run of equal counts, and the least frequent shape is always the last one.
+    std::vector<Entry> _entries;
+    absl::flat_hash_map<uint32_t, size_t> _positions;
+
+    long long _numReplacements = 0;
+};
+
+}  // namespace mongo
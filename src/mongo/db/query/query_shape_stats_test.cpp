@@ -0,0 +1,156 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/query_shape_stats.h"
+
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/hex.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+namespace {
+
+std::vector<BSONObj> getShapes(const QueryShapeStatsStore& store) {
+    BSONArrayBuilder builder;
+    store.appendShapes(&builder);
+
+    std::vector<BSONObj> shapes;
+    for (auto&& elem : builder.arr()) {
+        shapes.push_back(elem.Obj().getOwned());
+    }
+    return shapes;
+}
+
+TEST(QueryShapeStatsStoreTest, DisabledStoreRecordsNothing) {
+    QueryShapeStatsStore store(0);
+    ASSERT_FALSE(store.isEnabled());
+
+    store.record(1, Microseconds(10), 1, 1);
+    ASSERT_EQ(0U, store.size());
+}
+
+TEST(QueryShapeStatsStoreTest, AccumulatesStatisticsPerShape) {
+    QueryShapeStatsStore store(4);
+    store.record(1, Microseconds(100), 5, 2);
+    store.record(1, Microseconds(300), 7, 3);
+    store.record(2, Microseconds(50), 1, 1);
+
+    auto shapes = getShapes(store);
+    ASSERT_EQ(2U, shapes.size());
+
+    // Shapes are reported in decreasing order of total execution time.
+    ASSERT_EQ(zeroPaddedHex(uint32_t{1}), shapes[0]["queryHash"].String());
+    ASSERT_EQ(2, shapes[0]["count"].numberLong());
+    ASSERT_EQ(0, shapes[0]["countError"].numberLong());
+    ASSERT_EQ(400, shapes[0]["totalExecMicros"].numberLong());
+    ASSERT_EQ(300, shapes[0]["maxExecMicros"].numberLong());
+    ASSERT_EQ(12, shapes[0]["keysExamined"].numberLong());
+    ASSERT_EQ(5, shapes[0]["docsExamined"].numberLong());
+
+    ASSERT_EQ(zeroPaddedHex(uint32_t{2}), shapes[1]["queryHash"].String());
+    ASSERT_EQ(1, shapes[1]["count"].numberLong());
+}
+
+TEST(QueryShapeStatsStoreTest, PercentilesAreBoundedByBucketAndMaximum) {
+    QueryShapeStatsStore store(1);
+    for (int i = 0; i < 98; ++i) {
+        store.record(1, Microseconds(100), 0, 0);
+    }
+    store.record(1, Microseconds(5000), 0, 0);
+    store.record(1, Microseconds(6000), 0, 0);
+
+    auto shapes = getShapes(store);
+    ASSERT_EQ(1U, shapes.size());
+
+    // 100us falls in the [64, 128) bucket.
+    ASSERT_EQ(127, shapes[0]["p50ExecMicros"].numberLong());
+    ASSERT_EQ(127, shapes[0]["p95ExecMicros"].numberLong());
+    // 5000us and 6000us fall in the [4096, 8192) bucket, which is capped by the maximum.
+    ASSERT_EQ(6000, shapes[0]["p99ExecMicros"].numberLong());
+}
+
+TEST(QueryShapeStatsStoreTest, FullStoreReplacesLeastFrequentShape) {
+    QueryShapeStatsStore store(2);
+    for (int i = 0; i < 5; ++i) {
+        store.record(1, Microseconds(10), 0, 0);
+    }
+    store.record(2, Microseconds(10), 0, 0);
+
+    // Shape 3 replaces shape 2 and inherits its count as the error bound.
+    store.record(3, Microseconds(1000), 0, 0);
+    ASSERT_EQ(2U, store.size());
+    ASSERT_EQ(1, store.getNumReplacements());
+
+    auto shapes = getShapes(store);
+    ASSERT_EQ(2U, shapes.size());
+    ASSERT_EQ(zeroPaddedHex(uint32_t{3}), shapes[0]["queryHash"].String());
+    ASSERT_EQ(2, shapes[0]["count"].numberLong());
+    ASSERT_EQ(1, shapes[0]["countError"].numberLong());
+    ASSERT_EQ(1000, shapes[0]["totalExecMicros"].numberLong());
+    ASSERT_EQ(zeroPaddedHex(uint32_t{1}), shapes[1]["queryHash"].String());
+    ASSERT_EQ(5, shapes[1]["count"].numberLong());
+
+    // A frequent shape is never replaced by rare ones.
+    store.record(4, Microseconds(10), 0, 0);
+    store.record(5, Microseconds(10), 0, 0);
+    shapes = getShapes(store);
+    ASSERT_EQ(2U, shapes.size());
+    bool foundShape1 = false;
+    for (auto&& shape : shapes) {
+        foundShape1 |= shape["queryHash"].String() == zeroPaddedHex(uint32_t{1});
+    }
+    ASSERT_TRUE(foundShape1);
+}
+
+TEST(QueryShapeStatsStoreTest, ReplacesLeastFrequentShapeWhateverTheArrivalOrder) {
+    QueryShapeStatsStore store(4);
+    // Interleave the shapes so that their counts, 4, 1, 3 and 2, end up out of arrival order.
+    for (uint32_t queryHash : {1, 2, 3, 4, 1, 3, 4, 1, 3, 1}) {
+        store.record(queryHash, Microseconds(10), 0, 0);
+    }
+
+    store.record(5, Microseconds(10), 0, 0);
+    ASSERT_EQ(1, store.getNumReplacements());
+
+    StringMap<long long> counts;
+    for (auto&& shape : getShapes(store)) {
+        counts[shape["queryHash"].String()] = shape["count"].numberLong();
+    }
+    ASSERT_EQ(4U, counts.size());
+    ASSERT_EQ(0U, counts.count(zeroPaddedHex(uint32_t{2})));
+    ASSERT_EQ(4, counts[zeroPaddedHex(uint32_t{1})]);
+    ASSERT_EQ(3, counts[zeroPaddedHex(uint32_t{3})]);
+    ASSERT_EQ(2, counts[zeroPaddedHex(uint32_t{4})]);
+    ASSERT_EQ(2, counts[zeroPaddedHex(uint32_t{5})]);
+}
+
+}  // namespace
+}  // namespace mongo
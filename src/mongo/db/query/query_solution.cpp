@@ -345,6 +345,7 @@ QuerySolutionNode* CollectionScanNode::clone() const {
     copy->shouldWaitForOplogVisibility = this->shouldWaitForOplogVisibility;
     copy->clusteredIndex = this->clusteredIndex;
     copy->hasCompatibleCollation = this->hasCompatibleCollation;
+    copy->shareScanPosition = this->shareScanPosition;
     return copy;
 }
 
@@ -548,6 +549,10 @@ void MergeSortNode::appendToString(str::stream* ss, int indent) const {
         addIndent(ss, indent + 1);
         *ss << " filter = " << filter->debugString() << '\n';
     }
+    if (mergeByRecordId) {
+        addIndent(ss, indent + 1);
+        *ss << "mergeByRecordId = 1\n";
+    }
     addCommon(ss, indent);
     for (size_t i = 0; i < children.size(); ++i) {
         addIndent(ss, indent + 1);
@@ -588,6 +593,7 @@ QuerySolutionNode* MergeSortNode::clone() const {
 
     copy->dedup = this->dedup;
     copy->sort = this->sort;
+    copy->mergeByRecordId = this->mergeByRecordId;
 
     return copy;
 }
@@ -1616,6 +1622,14 @@ void EqLookupNode::appendToString(str::stream* ss, int indent) const {
     *ss << "foreignField = " << joinFieldForeign.fullPath() << "\n";
     addIndent(ss, indent + 1);
     *ss << "lookupStrategy = " << serializeLookupStrategy(lookupStrategy) << "\n";
+    if (unwindSpec) {
+        addIndent(ss, indent + 1);
+        *ss << "unwind = {preserveNullAndEmptyArrays: " << unwindSpec->preserveNullAndEmptyArrays;
+        if (unwindSpec->indexPath) {
+            *ss << ", includeArrayIndex: " << unwindSpec->indexPath->fullPath();
+        }
+        *ss << "}\n";
+    }
     addCommon(ss, indent);
     addIndent(ss, indent + 1);
     *ss << "Child:" << '\n';
@@ -1631,7 +1645,8 @@ QuerySolutionNode* EqLookupNode::clone() const {
                                        joinField,
                                        lookupStrategy,
                                        idxEntry,
-                                       shouldProduceBson);
+                                       shouldProduceBson,
+                                       unwindSpec);
     return copy.release();
 }
 /**
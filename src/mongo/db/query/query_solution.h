@@ -518,6 +518,10 @@ struct CollectionScanNode : public QuerySolutionNodeWithSortSet {
 
     // Once the first matching document is found, assume that all documents after it must match.
     bool stopApplyingFilterAfterFirstMatch = false;
+
+    // Whether the scan may start at the position of concurrent scans of the same collection and
+    // wrap around, in which case records are not returned in RecordId order.
+    bool shareScanPosition = false;
 };
 
 struct ColumnIndexScanNode : public QuerySolutionNode {
@@ -722,7 +726,7 @@ struct MergeSortNode : public QuerySolutionNodeWithSortSet {
     bool fetched() const;
     FieldAvailability getFieldAvailability(const std::string& field) const;
     bool sortedByDiskLoc() const {
-        return false;
+        return mergeByRecordId;
     }
 
     QuerySolutionNode* clone() const;
@@ -736,6 +740,10 @@ struct MergeSortNode : public QuerySolutionNodeWithSortSet {
 
     BSONObj sort;
     bool dedup;
+
+    // If true, the children are sorted by RecordId and merged on it rather than on 'sort', which
+    // is then empty.
+    bool mergeByRecordId = false;
 };
 
 struct FetchNode : public QuerySolutionNode {
@@ -1492,6 +1500,14 @@ struct EqLookupNode : public QuerySolutionNode {
         }
     }
 
+    /**
+     * Describes an $unwind of the "as" field which has been absorbed into the $lookup.
+     */
+    struct UnwindSpec {
+        bool preserveNullAndEmptyArrays = false;
+        boost::optional<FieldPath> indexPath;
+    };
+
     EqLookupNode(std::unique_ptr<QuerySolutionNode> child,
                  const std::string& foreignCollection,
                  const FieldPath& joinFieldLocal,
@@ -1499,7 +1515,8 @@ struct EqLookupNode : public QuerySolutionNode {
                  const FieldPath& joinField,
                  EqLookupNode::LookupStrategy lookupStrategy,
                  boost::optional<IndexEntry> idxEntry,
-                 bool shouldProduceBson)
+                 bool shouldProduceBson,
+                 boost::optional<UnwindSpec> unwindSpec = boost::none)
         : QuerySolutionNode(std::move(child)),
           foreignCollection(foreignCollection),
           joinFieldLocal(joinFieldLocal),
@@ -1507,7 +1524,8 @@ struct EqLookupNode : public QuerySolutionNode {
           joinField(joinField),
           lookupStrategy(lookupStrategy),
           idxEntry(std::move(idxEntry)),
-          shouldProduceBson(shouldProduceBson) {}
+          shouldProduceBson(shouldProduceBson),
+          unwindSpec(std::move(unwindSpec)) {}
 
     StageType getType() const override {
         return STAGE_EQ_LOOKUP;
@@ -1520,7 +1538,8 @@ struct EqLookupNode : public QuerySolutionNode {
     }
 
     FieldAvailability getFieldAvailability(const std::string& field) const {
-        if (field == joinField) {
+        if (field == joinField ||
+            (unwindSpec && unwindSpec->indexPath && field == unwindSpec->indexPath->fullPath())) {
             // This field is available, but isn't mapped to the original document.
             return FieldAvailability::kNotProvided;
         } else {
@@ -1580,6 +1599,12 @@ struct EqLookupNode : public QuerySolutionNode {
      * 'sbe::Object' is produced instead.
      */
     bool shouldProduceBson;
+
+    /**
+     * If set, the matched foreign documents are unwound so that one output document is produced
+     * per match, with 'joinField' holding a single foreign document rather than an array.
+     */
+    boost::optional<UnwindSpec> unwindSpec;
 };
 
 struct SentinelNode : public QuerySolutionNode {
@@ -32,6 +32,7 @@
 #include "mongo/db/query/sbe_plan_cache.h"
 
 #include "mongo/db/query/plan_cache_size_parameter.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/server_options.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/processinfo.h"
@@ -42,6 +43,9 @@ namespace {
 const auto sbePlanCacheDecoration =
     ServiceContext::declareDecoration<std::unique_ptr<sbe::PlanCache>>();
 
+const auto sharedShapePlanCacheDecoration =
+    ServiceContext::declareDecoration<std::unique_ptr<SharedShapePlanCache>>();
+
 size_t convertToSizeInBytes(const plan_cache_util::PlanCacheSizeParameter& param) {
     constexpr size_t kBytesInMB = 1024 * 1024;
     constexpr size_t kMBytesInGB = 1024;
@@ -115,6 +119,7 @@ public:
             auto& globalPlanCache = sbePlanCacheDecoration(serviceCtx);
             globalPlanCache->clear();
         }
+        SharedShapePlanCache::get(serviceCtx).clear();
     }
 };
 
@@ -131,10 +136,42 @@ ServiceContext::ConstructorActionRegisterer planCacheRegisterer{
             auto& globalPlanCache = sbePlanCacheDecoration(serviceCtx);
             globalPlanCache = std::make_unique<sbe::PlanCache>(size, ProcessInfo::getNumCores());
         }
+
+        sharedShapePlanCacheDecoration(serviceCtx) = std::make_unique<SharedShapePlanCache>(
+            internalQuerySBESharedShapePlanCacheMaxEntries.load());
     }};
 
 }  // namespace
 
+SharedShapePlanCache& SharedShapePlanCache::get(ServiceContext* serviceCtx) {
+    return *sharedShapePlanCacheDecoration(serviceCtx);
+}
+
+boost::optional<SharedShapePlanCache::Entry> SharedShapePlanCache::find(const std::string& key) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto it = _cache.find(key);
+    if (it == _cache.end()) {
+        return boost::none;
+    }
+    return it->second;
+}
+
+void SharedShapePlanCache::set(const std::string& key, Entry entry) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _cache.add(key, std::move(entry));
+}
+
+void SharedShapePlanCache::clear() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _cache.clear();
+}
+
+std::vector<std::pair<std::string, SharedShapePlanCache::Entry>>
+SharedShapePlanCache::getAllEntries() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return {_cache.begin(), _cache.end()};
+}
+
 sbe::PlanCache& getPlanCache(ServiceContext* serviceCtx) {
     uassert(5933402,
             "Cannot getPlanCache() if gFeatureFlagSbePlanCache is disabled",
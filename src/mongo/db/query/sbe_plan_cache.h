@@ -34,10 +34,13 @@
 #include "mongo/db/exec/sbe/stages/stages.h"
 #include "mongo/db/hasher.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/query/classic_plan_cache.h"
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/plan_cache_key_info.h"
 #include "mongo/db/query/sbe_stage_builder.h"
 #include "mongo/db/service_context.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/lru_cache.h"
 
 namespace mongo {
 namespace sbe {
@@ -172,6 +175,9 @@ struct CachedSbePlan {
     CachedSbePlan(std::unique_ptr<sbe::PlanStage> root, stage_builder::PlanStageData data)
         : root(std::move(root)), planStageData(std::move(data)) {
         tassert(5968206, "The RuntimeEnvironment should not be null", planStageData.env);
+        if (!planStageData.compileStats) {
+            planStageData.compileStats = std::make_shared<stage_builder::CachedPlanCompileStats>();
+        }
     }
 
     std::unique_ptr<CachedSbePlan> clone() const {
@@ -202,6 +208,55 @@ using PlanCache = PlanCacheBase<PlanCacheKey,
                                 PlanCachePartitioner,
                                 PlanCacheKeyHasher>;
 
+/**
+ * An optional second-level plan cache which is shared across collections. It maps a query shape
+ * together with the index catalog of the collection, see
+ * 'plan_cache_key_factory::makeSharedShapeKey()', to the winning solution of the last
+ * multi-planning of that shape. A collection with the same shape and the same indexes as another
+ * one, e.g. one of many identical per-tenant collections, can rebuild its plan from the cached
+ * solution instead of running the multi-planner again.
+ *
+ * The cache stores solutions rather than SBE plans because a compiled SBE plan is bound to the
+ * collection and indexes it was built for. It is disabled unless
+ * 'internalQuerySBESharedShapePlanCacheMaxEntries' is positive.
+ */
+class SharedShapePlanCache {
+public:
+    struct Entry {
+        // The solution serialized with 'SolutionCacheData::toBSON()'. It refers to indexes by name
+        // only, and is parsed against the indexes of the collection being queried.
+        BSONObj solution;
+        // The number of works it took to pick the cached solution.
+        size_t decisionWorks;
+    };
+
+    static SharedShapePlanCache& get(ServiceContext* serviceCtx);
+
+    explicit SharedShapePlanCache(size_t maxEntries)
+        : _maxEntries(maxEntries), _cache(maxEntries) {}
+
+    bool isEnabled() const {
+        return _maxEntries > 0;
+    }
+
+    boost::optional<Entry> find(const std::string& key);
+
+    void set(const std::string& key, Entry entry);
+
+    void clear();
+
+    /**
+     * Returns all the entries of the cache, from the most to the least recently used.
+     */
+    std::vector<std::pair<std::string, Entry>> getAllEntries() const;
+
+private:
+    const size_t _maxEntries;
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("SharedShapePlanCache::_mutex");
+    LRUCache<std::string, Entry> _cache;
+};
+
 /**
  * A helper method to get the global SBE plan cache decorated in 'serviceCtx'.
  */
@@ -0,0 +1,120 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/sbe_plan_cache.h"
+
+#include "mongo/bson/json.h"
+#include "mongo/db/query/plan_cache_key_factory.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Builds a key in the format of 'plan_cache_key_factory::makeSharedShapeKey()'.
+ */
+std::string makeKey(StringData indexCatalogFingerprint, StringData shape) {
+    return str::stream() << indexCatalogFingerprint.size() << ":" << indexCatalogFingerprint
+                         << shape;
+}
+
+sbe::SharedShapePlanCache::Entry makeEntry(size_t decisionWorks) {
+    return {fromjson("{solution: 1}"), decisionWorks};
+}
+
+const auto kIndexesA = "[{v: 2, key: {a: 1}, name: 'a_1'}]"_sd;
+const auto kIndexesAB = "[{v: 2, key: {a: 1}, name: 'a_1'}, {v: 2, key: {b: 1}, name: 'b_1'}]"_sd;
+
+TEST(SharedShapePlanCacheTest, KeyEmbedsIndexCatalogFingerprint) {
+    auto fingerprint = plan_cache_key_factory::getIndexCatalogFingerprint(makeKey(kIndexesA, "eq"));
+    ASSERT(fingerprint);
+    ASSERT_EQ(*fingerprint, kIndexesA);
+
+    ASSERT_FALSE(plan_cache_key_factory::getIndexCatalogFingerprint("eq"));
+    ASSERT_FALSE(plan_cache_key_factory::getIndexCatalogFingerprint("100:short"));
+}
+
+TEST(SharedShapePlanCacheTest, DisabledWithoutEntries) {
+    sbe::SharedShapePlanCache cache(0);
+    ASSERT_FALSE(cache.isEnabled());
+    ASSERT_TRUE(sbe::SharedShapePlanCache(1).isEnabled());
+}
+
+TEST(SharedShapePlanCacheTest, HitForSameShapeAndIndexes) {
+    sbe::SharedShapePlanCache cache(4);
+    cache.set(makeKey(kIndexesA, "eq"), makeEntry(7));
+
+    // Any collection with the same shape and indexes builds the same key.
+    auto entry = cache.find(makeKey(kIndexesA, "eq"));
+    ASSERT(entry);
+    ASSERT_BSONOBJ_EQ(entry->solution, fromjson("{solution: 1}"));
+    ASSERT_EQ(entry->decisionWorks, 7U);
+}
+
+TEST(SharedShapePlanCacheTest, MissForOtherShapeOrIndexes) {
+    sbe::SharedShapePlanCache cache(4);
+    cache.set(makeKey(kIndexesA, "eq"), makeEntry(7));
+
+    ASSERT_FALSE(cache.find(makeKey(kIndexesA, "lt")));
+    // Adding an index changes the fingerprint, so the plans cached for the old indexes no longer
+    // match.
+    ASSERT_FALSE(cache.find(makeKey(kIndexesAB, "eq")));
+}
+
+TEST(SharedShapePlanCacheTest, ClearInvalidatesAllEntries) {
+    sbe::SharedShapePlanCache cache(4);
+    cache.set(makeKey(kIndexesA, "eq"), makeEntry(7));
+    cache.set(makeKey(kIndexesAB, "eq"), makeEntry(8));
+    ASSERT_EQ(cache.getAllEntries().size(), 2U);
+
+    cache.clear();
+    ASSERT_TRUE(cache.getAllEntries().empty());
+    ASSERT_FALSE(cache.find(makeKey(kIndexesA, "eq")));
+    ASSERT_FALSE(cache.find(makeKey(kIndexesAB, "eq")));
+}
+
+TEST(SharedShapePlanCacheTest, SetReplacesEntryAndEvictsLeastRecentlyUsed) {
+    sbe::SharedShapePlanCache cache(2);
+    cache.set(makeKey(kIndexesA, "eq"), makeEntry(1));
+    cache.set(makeKey(kIndexesA, "lt"), makeEntry(2));
+    cache.set(makeKey(kIndexesA, "eq"), makeEntry(3));
+    ASSERT_EQ(cache.find(makeKey(kIndexesA, "eq"))->decisionWorks, 3U);
+
+    // "lt" is now the least recently used entry.
+    cache.set(makeKey(kIndexesA, "gt"), makeEntry(4));
+    ASSERT_FALSE(cache.find(makeKey(kIndexesA, "lt")));
+    ASSERT(cache.find(makeKey(kIndexesA, "eq")));
+    ASSERT(cache.find(makeKey(kIndexesA, "gt")));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -30,14 +30,28 @@
 
 #include "mongo/db/query/sbe_runtime_planner.h"
 
+#include "mongo/base/init.h"
 #include "mongo/db/catalog/collection.h"
+#include "mongo/db/catalog/collection_catalog.h"
+#include "mongo/db/client.h"
 #include "mongo/db/exec/sbe/expressions/expression.h"
 #include "mongo/db/exec/trial_period_utils.h"
 #include "mongo/db/exec/trial_run_tracker.h"
+#include "mongo/db/operation_context.h"
 #include "mongo/db/query/plan_executor_sbe.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/storage/recovery_unit.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
+#include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/fail_point.h"
+#include "mongo/util/future.h"
 #include "mongo/util/histogram.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo::sbe {
+
+MONGO_FAIL_POINT_DEFINE(hangDuringSbeParallelTrials);
+
 namespace {
 
 Counter64 sbeMicrosTotal;
@@ -97,6 +111,23 @@ ServerStatusMetricField<Histogram<uint64_t>> sbeNumReadsHistogramDisplay(
 ServerStatusMetricField<Histogram<uint64_t>> sbeNumPlansHistogramDisplay(
     "query.multiPlanner.histograms.sbeNumPlans", sbeNumPlansHistogram);
 
+/**
+ * The pool running the trial periods of candidate plans when the multi-planner runs them in
+ * parallel, see 'internalQueryPlanEvaluationMaxParallelTrialsSbe'.
+ */
+std::unique_ptr<ThreadPool> trialPlanningThreadPool;
+
+MONGO_INITIALIZER(trialPlanningThreadPool)(InitializerContext* context) {
+    ThreadPool::Options options;
+    options.poolName = "trial planning pool";
+    options.threadNamePrefix = "TrialPlan";
+    options.minThreads = 0;
+    options.maxThreads = 64;
+    options.onCreateThread = [](const std::string& name) { Client::initThread(name); };
+    trialPlanningThreadPool = std::make_unique<ThreadPool>(options);
+    trialPlanningThreadPool->startup();
+}
+
 /**
  * Fetches a next document form the given plan stage tree and returns 'true' if the plan stage
  * returns EOF, or throws 'TrialRunTracker::EarlyExitException' exception. Otherwise, the
@@ -148,11 +179,20 @@ StatusWith<std::tuple<value::SlotAccessor*, value::SlotAccessor*, bool>>
 BaseRuntimePlanner::prepareExecutionPlan(PlanStage* root,
                                          stage_builder::PlanStageData* data,
                                          const bool preparingFromCache) const {
+    return prepareExecutionPlan(_opCtx, _yieldPolicy, root, data, preparingFromCache);
+}
+
+StatusWith<std::tuple<value::SlotAccessor*, value::SlotAccessor*, bool>>
+BaseRuntimePlanner::prepareExecutionPlan(OperationContext* opCtx,
+                                         PlanYieldPolicySBE* yieldPolicy,
+                                         PlanStage* root,
+                                         stage_builder::PlanStageData* data,
+                                         const bool preparingFromCache) const {
     invariant(root);
     invariant(data);
 
     stage_builder::prepareSlotBasedExecutableTree(
-        _opCtx, root, data, _cq, _collections, _yieldPolicy, preparingFromCache);
+        opCtx, root, data, _cq, _collections, yieldPolicy, preparingFromCache);
 
     value::SlotAccessor* resultSlot{nullptr};
     if (auto slot = data->outputs.getIfExists(stage_builder::PlanStageSlots::kResult); slot) {
@@ -184,7 +224,16 @@ void BaseRuntimePlanner::executeCandidateTrial(plan_ranker::CandidatePlan* candi
                                                const bool isCachedPlanTrial) {
     _indexExistenceChecker.check();
 
-    auto status = prepareExecutionPlan(candidate->root.get(), &candidate->data, isCachedPlanTrial);
+    runCandidateTrial(_opCtx, _yieldPolicy, candidate, maxNumResults, isCachedPlanTrial);
+}
+
+void BaseRuntimePlanner::runCandidateTrial(OperationContext* opCtx,
+                                           PlanYieldPolicySBE* yieldPolicy,
+                                           plan_ranker::CandidatePlan* candidate,
+                                           size_t maxNumResults,
+                                           const bool isCachedPlanTrial) const {
+    auto status = prepareExecutionPlan(
+        opCtx, yieldPolicy, candidate->root.get(), &candidate->data, isCachedPlanTrial);
     if (!status.isOK()) {
         candidate->status = status.getStatus();
         return;
@@ -206,6 +255,148 @@ void BaseRuntimePlanner::executeCandidateTrial(plan_ranker::CandidatePlan* candi
     }
 }
 
+void BaseRuntimePlanner::executeCandidateTrialsInParallel(
+    const std::vector<std::pair<plan_ranker::CandidatePlan*, TrialRunTracker*>>& trials,
+    size_t maxNumResults,
+    size_t maxParallelTrials) {
+    _indexExistenceChecker.check();
+
+    // The trial runs use their own operation contexts. They read at this planner's timestamp and
+    // through its catalog, so that all candidates observe the same snapshot of the data and the
+    // same collections as this planner would. They also stop at the same deadline.
+    const auto readTimestamp = _opCtx->recoveryUnit()->getPointInTimeReadTimestamp(_opCtx);
+    invariant(readTimestamp);
+    const auto catalog = CollectionCatalog::get(_opCtx);
+    const auto deadline = _opCtx->getDeadline();
+    const auto timeoutError = _opCtx->getTimeoutError();
+
+    // The operation contexts of the running trials, so that they can be killed if this planner's
+    // operation is interrupted while it waits for them.
+    Mutex workerOpCtxsMutex = MONGO_MAKE_LATCH("BaseRuntimePlanner::workerOpCtxsMutex");
+    std::vector<OperationContext*> workerOpCtxs;
+    boost::optional<ErrorCodes::Error> workerKillCode;
+    auto killWorker = [&](WithLock, OperationContext* opCtx) {
+        stdx::lock_guard<Client> clientLock(*opCtx->getClient());
+        opCtx->getServiceContext()->killOperation(clientLock, opCtx, *workerKillCode);
+    };
+
+    // Set by the first candidate which completes its trial period, to stop all the others.
+    AtomicWord<bool> trialPeriodCompleted{false};
+    for (auto&& [candidate, tracker] : trials) {
+        tracker->setStopRequestedFlag(&trialPeriodCompleted);
+    }
+
+    // Each thread keeps picking the next candidate to run until there are none left.
+    AtomicWord<size_t> nextTrial{0};
+    auto runTrials = [&](OperationContext* opCtx) {
+        hangDuringSbeParallelTrials.pauseWhileSet(opCtx);
+
+        PlanYieldPolicySBE yieldPolicy(opCtx,
+                                       PlanYieldPolicy::YieldPolicy::INTERRUPT_ONLY,
+                                       opCtx->getServiceContext()->getFastClockSource(),
+                                       internalQueryExecYieldIterations.load(),
+                                       Milliseconds{internalQueryExecYieldPeriodMS.load()},
+                                       nullptr /* yieldable */,
+                                       nullptr /* callbacks */,
+                                       gYieldingSupportForSBE);
+
+        for (auto ix = nextTrial.fetchAndAdd(1); ix < trials.size();
+             ix = nextTrial.fetchAndAdd(1)) {
+            auto candidate = trials[ix].first;
+            auto root = candidate->root.get();
+
+            // A plan must not keep any storage cursors of 'opCtx' once the thread is done with it.
+            ScopeGuard closeGuard([&] {
+                root->close();
+                root->detachFromOperationContext();
+            });
+            runCandidateTrial(
+                opCtx, &yieldPolicy, candidate, maxNumResults, false /* isCachedPlanTrial */);
+
+            if (candidate->status.isOK() && !candidate->exitedEarly) {
+                trialPeriodCompleted.store(true);
+                closeGuard.dismiss();
+                root->saveState(true /* relinquishCursor */);
+                root->detachFromOperationContext();
+            }
+        }
+    };
+
+    const auto numThreads = std::min(maxParallelTrials, trials.size());
+    std::vector<Future<void>> futures;
+    for (size_t i = 0; i < numThreads; ++i) {
+        auto pf = makePromiseFuture<void>();
+        trialPlanningThreadPool->schedule(
+            [&, promise = std::move(pf.promise)](auto status) mutable {
+                invariant(status);
+
+                auto opCtx = cc().makeOperationContext();
+                opCtx->recoveryUnit()->setTimestampReadSource(RecoveryUnit::ReadSource::kProvided,
+                                                              *readTimestamp);
+                CollectionCatalog::stash(opCtx.get(), catalog);
+                if (deadline != Date_t::max()) {
+                    opCtx->setDeadlineByDate(deadline, timeoutError);
+                }
+
+                {
+                    stdx::lock_guard lk(workerOpCtxsMutex);
+                    workerOpCtxs.push_back(opCtx.get());
+                    if (workerKillCode) {
+                        killWorker(lk, opCtx.get());
+                    }
+                }
+                ON_BLOCK_EXIT([&] {
+                    stdx::lock_guard lk(workerOpCtxsMutex);
+                    workerOpCtxs.erase(
+                        std::find(workerOpCtxs.begin(), workerOpCtxs.end(), opCtx.get()));
+                });
+
+                promise.setWith([&] {
+                    // The trials take no locks of their own, as a lock request queued behind a
+                    // conflicting one would wait for this planner, which keeps its locks until
+                    // all the trials are done. They read lock-free through its catalog instead.
+                    LockFreeReadsBlock lockFreeReadsBlock(opCtx.get());
+                    runTrials(opCtx.get());
+                });
+            });
+        futures.push_back(std::move(pf.future));
+    }
+
+    // If this planner's operation is killed or times out while it waits, pass it on to the trials.
+    Status trialStatus = Status::OK();
+    for (auto&& future : futures) {
+        auto status = future.waitNoThrow(_opCtx);
+        if (!status.isOK()) {
+            stdx::lock_guard lk(workerOpCtxsMutex);
+            workerKillCode = status.code();
+            for (auto opCtx : workerOpCtxs) {
+                killWorker(lk, opCtx);
+            }
+            trialStatus = status;
+            break;
+        }
+    }
+
+    // Wait for all threads before reporting any error, as they reference this stack frame.
+    for (auto&& future : futures) {
+        auto status = future.getNoThrow();
+        if (trialStatus.isOK() && !status.isOK()) {
+            trialStatus = status;
+        }
+    }
+
+    for (auto&& [candidate, tracker] : trials) {
+        auto root = candidate->root.get();
+        root->attachNewYieldPolicy(_yieldPolicy);
+        root->attachToOperationContext(_opCtx);
+        _yieldPolicy->registerPlan(root);
+        if (trialStatus.isOK() && candidate->status.isOK() && !candidate->exitedEarly) {
+            root->restoreState(true /* relinquishCursor */);
+        }
+    }
+    uassertStatusOK(trialStatus);
+}
+
 std::vector<plan_ranker::CandidatePlan> BaseRuntimePlanner::collectExecutionStats(
     std::vector<std::unique_ptr<QuerySolution>> solutions,
     std::vector<std::pair<std::unique_ptr<PlanStage>, stage_builder::PlanStageData>> roots,
@@ -252,41 +443,88 @@ std::vector<plan_ranker::CandidatePlan> BaseRuntimePlanner::collectExecutionStat
 
     uint64_t totalNumReads = 0;
 
+    // Candidate plans run in parallel only when each of them can use an operation context of its
+    // own. This rules out multi-document transactions, and sharded collections whose shard
+    // filterer is bound to the operation context of the query. The trials must also observe the
+    // same snapshot as the query, which requires it to read at a timestamp known up front.
+    const auto readSource = _opCtx->recoveryUnit()->getTimestampReadSource();
+    const bool readsAtKnownTimestamp = readSource == RecoveryUnit::ReadSource::kProvided ||
+        readSource == RecoveryUnit::ReadSource::kMajorityCommitted ||
+        readSource == RecoveryUnit::ReadSource::kAllDurableSnapshot;
+    const size_t maxParallelTrials = (_opCtx->inMultiDocumentTransaction() ||
+                                      _collections.getMainCollection().isSharded() ||
+                                      !readsAtKnownTimestamp)
+        ? 1
+        : internalQueryPlanEvaluationMaxParallelTrialsSbe.load();
+    candidates.reserve(solutions.size());
+
+    // Adds the plan at 'planIndex' to the candidates, attaching a unique TrialRunTracker to it,
+    // which is configured to use at most 'maxNumReads' reads.
+    auto addCandidate = [&](size_t planIndex, size_t maxNumReads) {
+        auto&& [root, data] = roots[planIndex];
+        // Make a copy of the original plan. This pristine copy will be inserted into the plan
+        // cache if this candidate becomes the winner.
+        auto origPlan = std::make_pair<std::unique_ptr<PlanStage>, stage_builder::PlanStageData>(
+            root->clone(), stage_builder::PlanStageData(data));
+
+        auto tracker = std::make_unique<TrialRunTracker>(trackerResultsBudget, maxNumReads);
+        root->attachToTrialRunTracker(tracker.get());
+
+        candidates.push_back({std::move(solutions[planIndex]),
+                              std::move(root),
+                              std::move(data),
+                              false /* exitedEarly */,
+                              Status::OK()});
+        // Store the original plan in the CandidatePlan.
+        candidates.back().clonedPlan.emplace(std::move(origPlan));
+        return tracker;
+    };
+
+    auto recordTrial = [&](const plan_ranker::CandidatePlan& candidate,
+                           const TrialRunTracker& tracker,
+                           size_t& maxNumReads) {
+        auto reads = tracker.getMetric<TrialRunTracker::TrialRunMetric::kNumReads>();
+        // We intentionally increment the metrics outside of the isOk/existedEarly check.
+        totalNumReads += reads;
+
+        // Reduce the number of reads the next candidates are allocated if this candidate is
+        // more efficient than the current bound.
+        if (candidate.status.isOK() && !candidate.exitedEarly) {
+            maxNumReads = std::min(maxNumReads, reads);
+        }
+    };
+
     auto runPlans = [&](const std::vector<size_t>& planIndexes, size_t& maxNumReads) -> void {
+        if (maxParallelTrials > 1 && planIndexes.size() > 1) {
+            std::vector<std::unique_ptr<TrialRunTracker>> trackers;
+            std::vector<std::pair<plan_ranker::CandidatePlan*, TrialRunTracker*>> trials;
+            for (auto planIndex : planIndexes) {
+                trackers.push_back(addCandidate(planIndex, maxNumReads));
+                trials.emplace_back(&candidates.back(), trackers.back().get());
+            }
+            ON_BLOCK_EXIT([&] {
+                for (auto&& trial : trials) {
+                    trial.first->root->detachFromTrialRunTracker();
+                }
+            });
+
+            executeCandidateTrialsInParallel(trials, maxNumResults, maxParallelTrials);
+
+            // As all these plans ran at the same time, the tightened bound only applies to the
+            // plans of the next call.
+            for (auto&& [candidate, tracker] : trials) {
+                recordTrial(*candidate, *tracker, maxNumReads);
+            }
+            return;
+        }
+
         for (auto planIndex : planIndexes) {
-            // Prepare the plan.
-            auto&& [root, data] = roots[planIndex];
-            // Make a copy of the original plan. This pristine copy will be inserted into the plan
-            // cache if this candidate becomes the winner.
-            auto origPlan =
-                std::make_pair<std::unique_ptr<PlanStage>, stage_builder::PlanStageData>(
-                    root->clone(), stage_builder::PlanStageData(data));
-
-            // Attach a unique TrialRunTracker to the plan, which is configured to use at most
-            // 'maxNumReads' reads.
-            auto tracker = std::make_unique<TrialRunTracker>(trackerResultsBudget, maxNumReads);
-            ON_BLOCK_EXIT([rootPtr = root.get()] { rootPtr->detachFromTrialRunTracker(); });
-            root->attachToTrialRunTracker(tracker.get());
-
-            candidates.push_back({std::move(solutions[planIndex]),
-                                  std::move(root),
-                                  std::move(data),
-                                  false /* exitedEarly */,
-                                  Status::OK()});
+            auto tracker = addCandidate(planIndex, maxNumReads);
             auto& currentCandidate = candidates.back();
-            // Store the original plan in the CandidatePlan.
-            currentCandidate.clonedPlan.emplace(std::move(origPlan));
+            ON_BLOCK_EXIT(
+                [rootPtr = currentCandidate.root.get()] { rootPtr->detachFromTrialRunTracker(); });
             executeCandidateTrial(&currentCandidate, maxNumResults, /*isCachedPlanTrial*/ false);
-
-            auto reads = tracker->getMetric<TrialRunTracker::TrialRunMetric::kNumReads>();
-            // We intentionally increment the metrics outside of the isOk/existedEarly check.
-            totalNumReads += reads;
-
-            // Reduce the number of reads the next candidates are allocated if this candidate is
-            // more efficient than the current bound.
-            if (currentCandidate.status.isOK() && !currentCandidate.exitedEarly) {
-                maxNumReads = std::min(maxNumReads, reads);
-            }
+            recordTrial(currentCandidate, *tracker, maxNumReads);
         }
     };
 
@@ -31,6 +31,7 @@
 
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/exec/sbe/stages/stages.h"
+#include "mongo/db/exec/trial_run_tracker.h"
 #include "mongo/db/query/all_indices_required_checker.h"
 #include "mongo/db/query/canonical_query.h"
 #include "mongo/db/query/multiple_collection_accessor.h"
@@ -137,6 +138,10 @@ protected:
      *
      * After the trial period ends, all plans remain open, but 'exitedEarly' plans are in an invalid
      * state. Any 'exitedEarly' plans must be closed and reopened before they can be executed.
+     *
+     * If 'internalQueryPlanEvaluationMaxParallelTrialsSbe' is greater than 1, the candidate plans
+     * run concurrently on the trial planning thread pool instead, see
+     * 'executeCandidateTrialsInParallel()'.
      */
     std::vector<plan_ranker::CandidatePlan> collectExecutionStats(
         std::vector<std::unique_ptr<QuerySolution>> solutions,
@@ -149,5 +154,44 @@ protected:
     const QueryPlannerParams _queryParams;
     PlanYieldPolicySBE* const _yieldPolicy;
     const AllIndicesRequiredChecker _indexExistenceChecker;
+
+private:
+    /**
+     * Same as above, but prepares the plan on behalf of the given 'opCtx' and 'yieldPolicy' rather
+     * than those of this planner.
+     */
+    StatusWith<std::tuple<sbe::value::SlotAccessor*, sbe::value::SlotAccessor*, bool>>
+    prepareExecutionPlan(OperationContext* opCtx,
+                         PlanYieldPolicySBE* yieldPolicy,
+                         PlanStage* root,
+                         stage_builder::PlanStageData* data,
+                         bool preparingFromCache) const;
+
+    /**
+     * Runs the trial period of 'candidate' on behalf of the given 'opCtx' and 'yieldPolicy', see
+     * 'executeCandidateTrial()'.
+     */
+    void runCandidateTrial(OperationContext* opCtx,
+                           PlanYieldPolicySBE* yieldPolicy,
+                           plan_ranker::CandidatePlan* candidate,
+                           size_t maxNumResults,
+                           bool isCachedPlanTrial) const;
+
+    /**
+     * Runs the trial periods of the given candidate plans on up to 'maxParallelTrials' threads of
+     * the trial planning pool. Each thread uses its own operation context, which reads at the
+     * timestamp of this planner's operation through its catalog, holds the same collection locks
+     * and shares its deadline. If this planner's operation is killed while it waits, the trials
+     * are killed too. Each thread has its own interrupt-only yield policy. The first candidate to
+     * complete its trial period without exiting early stops all the others through their trackers.
+     *
+     * On return all candidate plans are attached back to this planner's operation context and
+     * yield policy. Candidates which completed their trial period remain open, all others are
+     * closed.
+     */
+    void executeCandidateTrialsInParallel(
+        const std::vector<std::pair<plan_ranker::CandidatePlan*, TrialRunTracker*>>& trials,
+        size_t maxNumResults,
+        size_t maxParallelTrials);
 };
 }  // namespace mongo::sbe
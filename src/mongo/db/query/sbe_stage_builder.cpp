@@ -39,6 +39,7 @@
 #include "mongo/db/exec/sbe/abt/abt_lower.h"
 #include "mongo/db/exec/sbe/stages/co_scan.h"
 #include "mongo/db/exec/sbe/stages/column_scan.h"
+#include "mongo/db/exec/sbe/stages/exchange.h"
 #include "mongo/db/exec/sbe/stages/filter.h"
 #include "mongo/db/exec/sbe/stages/hash_agg.h"
 #include "mongo/db/exec/sbe/stages/hash_join.h"
@@ -60,6 +61,7 @@
 #include "mongo/db/fts/fts_spec.h"
 #include "mongo/db/index/fts_access_method.h"
 #include "mongo/db/pipeline/abt/field_map_builder.h"
+#include "mongo/db/pipeline/accumulator.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_visitor.h"
 #include "mongo/db/query/bind_input_params.h"
@@ -67,6 +69,7 @@
 #include "mongo/db/query/index_bounds_builder.h"
 #include "mongo/db/query/optimizer/rewrites/const_eval.h"
 #include "mongo/db/query/optimizer/rewrites/path_lower.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/sbe_stage_builder_accumulator.h"
 #include "mongo/db/query/sbe_stage_builder_coll_scan.h"
 #include "mongo/db/query/sbe_stage_builder_expression.h"
@@ -78,6 +81,7 @@
 #include "mongo/db/s/collection_sharding_state.h"
 #include "mongo/db/storage/execution_context.h"
 #include "mongo/logv2/log.h"
+#include "mongo/util/timer.h"
 
 namespace mongo::stage_builder {
 namespace {
@@ -402,11 +406,21 @@ void prepareSlotBasedExecutableTree(OperationContext* opCtx,
     if (expCtx->explain || expCtx->mayDbProfile) {
         root->markShouldCollectTimingInfo();
     }
+    if (expCtx->explain && *expCtx->explain >= ExplainOptions::Verbosity::kExecStats) {
+        root->markShouldCollectCpuTime();
+    }
 
     // Register this plan to yield according to the configured policy.
     yieldPolicy->registerPlan(root);
 
-    root->prepare(data->ctx);
+    if (preparingFromCache && data->compileStats) {
+        // Account for the time spent compiling the plan in the stats of its cache entry.
+        Timer timer;
+        root->prepare(data->ctx);
+        data->compileStats->recordCompilation(timer.elapsed());
+    } else {
+        root->prepare(data->ctx);
+    }
 
     auto env = data->env;
     // Populate/renew "shardFilterer" if there exists a "shardFilterer" slot. The slot value should
@@ -657,11 +671,13 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder
     invariant(!reqs.getIndexKeyBitset());
 
     auto csn = static_cast<const CollectionScanNode*>(root);
-    auto [stage, outputs] = generateCollScan(_state,
-                                             getCurrentCollection(reqs),
-                                             csn,
-                                             _yieldPolicy,
-                                             reqs.getIsTailableCollScanResumeBranch());
+    auto [stage, outputs] = reqs.getIsParallelCollScan()
+        ? generateParallelCollScan(_state, getCurrentCollection(reqs), csn)
+        : generateCollScan(_state,
+                           getCurrentCollection(reqs),
+                           csn,
+                           _yieldPolicy,
+                           reqs.getIsTailableCollScanResumeBranch());
 
     if (reqs.has(kReturnKey)) {
         // Assign the 'returnKeySlot' to be the empty object.
@@ -854,8 +870,13 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder
 
     PlanStageSlots outputs;
 
-    auto recordSlot = _slotIdGenerator.generate();
-    outputs.set(kResult, recordSlot);
+    // Reconstructing the document is the expensive part of the scan, so only do it when a parent
+    // consumes the result (e.g. not for a count).
+    boost::optional<sbe::value::SlotId> recordSlot;
+    if (reqs.has(kResult)) {
+        recordSlot = _slotIdGenerator.generate();
+        outputs.set(kResult, *recordSlot);
+    }
 
     boost::optional<sbe::value::SlotId> ridSlot;
 
@@ -872,22 +893,25 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder
         pathExprs.emplace_back(emptyExpr->clone());
     }
 
-    std::string rootStr = "rowStoreRoot";
-    optimizer::FieldMapBuilder builder(rootStr, true);
-    for (const std::string& field : csn->allFields) {
-        builder.integrateFieldPath(FieldPath(field),
-                                   [](const bool isLastElement, optimizer::FieldMapEntry& entry) {
-                                       entry._hasLeadingObj = true;
-                                       entry._hasKeep = true;
-                                   });
-    }
+    std::unique_ptr<sbe::EExpression> exprOut;
+    if (recordSlot) {
+        std::string rootStr = "rowStoreRoot";
+        optimizer::FieldMapBuilder builder(rootStr, true);
+        for (const std::string& field : csn->allFields) {
+            builder.integrateFieldPath(
+                FieldPath(field), [](const bool isLastElement, optimizer::FieldMapEntry& entry) {
+                    entry._hasLeadingObj = true;
+                    entry._hasKeep = true;
+                });
+        }
 
-    // Generate expression that reconstructs the whole object (runs against the row store bson for
-    // now).
-    optimizer::SlotVarMap slotMap{};
-    slotMap[rootStr] = rowStoreSlot;
-    auto abt = builder.generateABT();
-    auto exprOut = abt ? abtToExpr(*abt, slotMap) : emptyExpr->clone();
+        // Generate expression that reconstructs the whole object (runs against the row store bson
+        // for now).
+        optimizer::SlotVarMap slotMap{};
+        slotMap[rootStr] = rowStoreSlot;
+        auto abt = builder.generateABT();
+        exprOut = abt ? abtToExpr(*abt, slotMap) : emptyExpr->clone();
+    }
     auto stage = std::make_unique<sbe::ColumnScanStage>(
         getCurrentCollection(reqs)->uuid(),
         csn->indexEntry.catalogName,
@@ -1416,6 +1440,9 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder
     const QuerySolutionNode* root, const PlanStageReqs& reqs) {
     using namespace std::literals;
     auto mergeSortNode = static_cast<const MergeSortNode*>(root);
+    if (mergeSortNode->mergeByRecordId) {
+        return buildSortMergeByRecordId(root, reqs);
+    }
 
     const auto sortPattern = SortPattern{mergeSortNode->sort, _cq.getExpCtx()};
     std::vector<sbe::value::SortDirection> direction;
@@ -1572,6 +1599,54 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder
     return {std::move(stage), std::move(outputs)};
 }
 
+std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots>
+SlotBasedStageBuilder::buildSortMergeByRecordId(const QuerySolutionNode* root,
+                                                const PlanStageReqs& reqs) {
+    invariant(!reqs.getIndexKeyBitset());
+    auto mergeSortNode = static_cast<const MergeSortNode*>(root);
+
+    sbe::PlanStage::Vector inputStages;
+    std::vector<sbe::value::SlotVector> inputKeys;
+    std::vector<sbe::value::SlotVector> inputVals;
+
+    // Children must produce all of the slots required by the parent of this SortMergeNode. In
+    // addition, children must always produce the 'recordIdSlot' which they are merged on.
+    auto childReqs = reqs.copy().set(kRecordId);
+
+    for (auto&& child : mergeSortNode->children) {
+        auto [stage, outputs] = build(child, childReqs);
+
+        inputKeys.push_back(sbe::makeSV(outputs.get(kRecordId)));
+        inputStages.push_back(std::move(stage));
+
+        auto sv = sbe::makeSV();
+        outputs.forEachSlot(childReqs, [&](auto&& slot) { sv.push_back(slot); });
+        inputVals.push_back(std::move(sv));
+    }
+
+    auto outputVals = sbe::makeSV();
+
+    PlanStageSlots outputs(childReqs, &_slotIdGenerator);
+    outputs.forEachSlot(childReqs, [&](auto&& slot) { outputVals.push_back(slot); });
+
+    auto stage = sbe::makeS<sbe::SortedMergeStage>(
+        std::move(inputStages),
+        std::move(inputKeys),
+        std::vector<sbe::value::SortDirection>{sbe::value::SortDirection::Ascending},
+        std::move(inputVals),
+        std::move(outputVals),
+        root->nodeId());
+
+    // The merged output is sorted by RecordId, but there is no SBE stage relying on that to drop
+    // duplicates, so they are still dropped through the hash set of a unique stage.
+    if (mergeSortNode->dedup) {
+        stage = sbe::makeS<sbe::UniqueStage>(
+            std::move(stage), sbe::makeSV(outputs.get(kRecordId)), root->nodeId());
+    }
+
+    return {std::move(stage), std::move(outputs)};
+}
+
 std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots>
 SlotBasedStageBuilder::buildProjectionSimple(const QuerySolutionNode* root,
                                              const PlanStageReqs& reqs) {
@@ -2507,6 +2582,54 @@ sbe::value::SlotVector dedupGroupBySlots(const sbe::value::SlotVector& groupBySl
 
     return dedupedGroupBySlots;
 }
+
+/**
+ * Returns the number of producers which should compute partial aggregates for 'groupNode' in
+ * parallel, or 1 if the group should be computed by a single thread. Only a group directly over a
+ * plain forward collection scan is parallelized, and only when all of its accumulators produce the
+ * same result no matter in which order the ranges of the collection are scanned and combined.
+ */
+size_t getParallelGroupDegree(const CanonicalQuery& cq,
+                              const GroupNode* groupNode,
+                              const CollectionPtr& collection) {
+    static const StringDataSet kOrderInsensitiveAccumulators = {AccumulatorAddToSet::kName,
+                                                                AccumulatorAvg::kName,
+                                                                AccumulatorMax::kName,
+                                                                AccumulatorMin::kName,
+                                                                AccumulatorStdDevPop::kName,
+                                                                AccumulatorStdDevSamp::kName,
+                                                                AccumulatorSum::kName};
+
+    const auto& expCtx = cq.getExpCtx();
+    const int degree = expCtx->getMaxDegreeOfParallelism();
+    if (degree < 2 || !collection || collection->ns().isOplog() || expCtx->hasWhereClause) {
+        return 1;
+    }
+
+    // The producers read using their own operation contexts.
+    if (!expCtx->canReadInParallel()) {
+        return 1;
+    }
+
+    const auto& childNode = groupNode->children[0];
+    if (childNode->getType() != STAGE_COLLSCAN) {
+        return 1;
+    }
+    auto csn = static_cast<const CollectionScanNode*>(childNode.get());
+    if (csn->direction != CollectionScanParams::FORWARD || csn->tailable ||
+        csn->resumeAfterRecordId || csn->requestResumeToken || csn->minRecord || csn->maxRecord ||
+        csn->isOplog || csn->shouldTrackLatestOplogTimestamp) {
+        return 1;
+    }
+
+    for (const auto& accStmt : groupNode->accumulators) {
+        if (!kOrderInsensitiveAccumulators.count(accStmt.expr.name)) {
+            return 1;
+        }
+    }
+
+    return degree;
+}
 }  // namespace
 
 /**
@@ -2556,6 +2679,12 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder
         childReqs.clear(kResult);
     }
 
+    // When the group is computed in parallel, every producer scans some of the collection's record
+    // id ranges and computes partial aggregates over them, which are then combined above an
+    // exchange.
+    const auto parallelDegree = getParallelGroupDegree(_cq, groupNode, getCurrentCollection(reqs));
+    childReqs.setIsParallelCollScan(parallelDegree > 1);
+
     // Builds the child and gets the child result slot.
     auto [childStage, childOutputs] = build(childNode, childReqs);
     _shouldProduceRecordIdSlot = false;
@@ -2610,6 +2739,52 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder
                                       std::move(mergingExprs),
                                       nodeId);
 
+    if (parallelDegree > 1) {
+        // The group stage built above computes partial aggregates in each of the producers. Build
+        // an exchange to gather them, and another group stage which combines the partial
+        // aggregates of the same group the same way as the ones recovered from a spill.
+        auto exchangeSlots = groupEvalStage.outSlots;
+        auto exchange = sbe::makeS<sbe::ExchangeConsumer>(std::move(groupEvalStage.stage),
+                                                         parallelDegree,
+                                                         exchangeSlots,
+                                                         sbe::ExchangePolicy::roundrobin,
+                                                         nullptr /* partition */,
+                                                         nullptr /* orderLess */,
+                                                         nodeId,
+                                                         getCurrentCollection(reqs)->uuid());
+
+        auto collatorSlot = _state.data->env->getSlotIfExists("collator"_sd);
+        sbe::SlotExprPairVector combiningExprs;
+        sbe::SlotExprPairVector finalMergingExprs;
+        std::vector<sbe::value::SlotVector> combinedAggSlotsVec;
+        for (size_t idxAcc = 0; idxAcc < accStmts.size(); ++idxAcc) {
+            auto exprs = buildCombinePartialAggregates(
+                accStmts[idxAcc], aggSlotsVec[idxAcc], collatorSlot, _frameIdGenerator);
+
+            sbe::value::SlotVector combinedAggSlots;
+            for (auto& expr : exprs) {
+                combinedAggSlots.push_back(_slotIdGenerator.generate());
+                combiningExprs.push_back({combinedAggSlots.back(), std::move(expr)});
+            }
+
+            auto curMergingExprs =
+                generateMergingExpressions(_state, accStmts[idxAcc], combinedAggSlots.size());
+            finalMergingExprs.insert(finalMergingExprs.end(),
+                                     std::make_move_iterator(curMergingExprs.begin()),
+                                     std::make_move_iterator(curMergingExprs.end()));
+            combinedAggSlotsVec.emplace_back(std::move(combinedAggSlots));
+        }
+
+        groupEvalStage = makeHashAgg(EvalStage{std::move(exchange), std::move(exchangeSlots)},
+                                     dedupedGroupBySlots,
+                                     std::move(combiningExprs),
+                                     collatorSlot,
+                                     _cq.getExpCtx()->allowDiskUse,
+                                     std::move(finalMergingExprs),
+                                     nodeId);
+        aggSlotsVec = std::move(combinedAggSlotsVec);
+    }
+
     tassert(
         5851603,
         "Group stage's output slots must include deduped slots for group-by keys and slots for all "
@@ -40,6 +40,8 @@
 #include "mongo/db/query/sbe_stage_builder_helpers.h"
 #include "mongo/db/query/shard_filterer_factory_interface.h"
 #include "mongo/db/query/stage_builder.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/duration.h"
 
 namespace mongo::stage_builder {
 /**
@@ -234,6 +236,14 @@ public:
         _isTailableCollScanResumeBranch = b;
     }
 
+    bool getIsParallelCollScan() const {
+        return _isParallelCollScan;
+    }
+
+    void setIsParallelCollScan(bool b) {
+        _isParallelCollScan = b;
+    }
+
     void setTargetNamespace(const NamespaceString& nss) {
         _targetNamespace = nss;
     }
@@ -264,6 +274,10 @@ private:
     // branch. At all other times, this flag will be false.
     bool _isTailableCollScanResumeBranch{false};
 
+    // When true, the collection scan is built to run as one of several producers beneath an
+    // exchange, each of which scans a different range of record ids.
+    bool _isParallelCollScan{false};
+
     // Tracks the current namespace that we're building a plan over. Given that the stage builder
     // can build plans for multiple namespaces, a node in the tree that targets a namespace
     // different from its parent node can set this value to notify any child nodes of the correct
@@ -299,6 +313,21 @@ struct IndexBoundsEvaluationInfo {
     ParameterizedIndexScanSlots slots;
 };
 
+/**
+ * Counters shared by every copy of a plan recovered from the same SBE plan cache entry. They track
+ * how many times the cached plan has been prepared for execution, which compiles all of its
+ * expressions to bytecode, and the total time spent doing so.
+ */
+struct CachedPlanCompileStats {
+    void recordCompilation(Microseconds elapsed) {
+        numCompilations.fetchAndAdd(1);
+        compileTimeMicros.fetchAndAdd(durationCount<Microseconds>(elapsed));
+    }
+
+    AtomicWord<long long> numCompilations{0};
+    AtomicWord<long long> compileTimeMicros{0};
+};
+
 /**
  * Some auxiliary data returned by a 'SlotBasedStageBuilder' along with a PlanStage tree root, which
  * is needed to execute the PlanStage tree.
@@ -350,6 +379,11 @@ struct PlanStageData {
     // Note that 'debugInfo' is present only if this PlanStageData is recovered from the plan cache.
     std::shared_ptr<const plan_cache_debug_info::DebugInfoSBE> debugInfo;
 
+    // Compilation counters of the plan cache entry this plan belongs to. Unlike the rest of this
+    // struct the counters are not deep copied, so that all the plans recovered from an entry update
+    // the same counters. Present only for plans which are in or recovered from the plan cache.
+    std::shared_ptr<CachedPlanCompileStats> compileStats;
+
     // If the query has been auto-parameterized, then the mapping from input parameter id to the
     // id of a slot in the runtime environment is maintained here. This mapping is established
     // during stage building and stored in the cache. When a cached plan is used for a subsequent
@@ -390,6 +424,7 @@ private:
         } else {
             debugInfo.reset();
         }
+        compileStats = other.compileStats;
         inputParamToSlotMap = other.inputParamToSlotMap;
         variableIdToSlotMap = other.variableIdToSlotMap;
         indexBoundsEvaluationInfos = other.indexBoundsEvaluationInfos;
@@ -455,6 +490,9 @@ private:
     std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> buildSortMerge(
         const QuerySolutionNode* root, const PlanStageReqs& reqs);
 
+    std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> buildSortMergeByRecordId(
+        const QuerySolutionNode* root, const PlanStageReqs& reqs);
+
     std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> buildProjectionSimple(
         const QuerySolutionNode* root, const PlanStageReqs& reqs);
 
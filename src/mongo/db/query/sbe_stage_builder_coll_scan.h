@@ -59,4 +59,15 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateCollScan(
     PlanYieldPolicy* yieldPolicy,
     bool isTailableResumeBranch);
 
+/**
+ * Generates an SBE plan stage sub-tree implementing a collection scan which can be cloned into
+ * several producers of an exchange. The producers share the collection's record id ranges between
+ * them, so that each document is returned by exactly one of them. Only a plain forward scan of a
+ * non-oplog collection, optionally with a filter, can be generated this way.
+ *
+ * Returns the same slots as 'generateCollScan()', except for the oplog timestamp slot.
+ */
+std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateParallelCollScan(
+    StageBuilderState& state, const CollectionPtr& collection, const CollectionScanNode* csn);
+
 }  // namespace mongo::stage_builder
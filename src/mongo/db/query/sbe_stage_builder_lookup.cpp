@@ -996,7 +996,7 @@ std::pair<SlotId, std::unique_ptr<sbe::PlanStage>> buildNonExistentForeignCollLo
 std::pair<SlotId, std::unique_ptr<sbe::PlanStage>> buildLookupResultObject(
     std::unique_ptr<sbe::PlanStage> stage,
     SlotId localDocumentSlot,
-    SlotId resultArraySlot,
+    SlotId fieldValueSlot,
     const FieldPath& fieldPath,
     const PlanNodeId nodeId,
     SlotIdGenerator& slotIdGenerator,
@@ -1020,7 +1020,7 @@ std::pair<SlotId, std::unique_ptr<sbe::PlanStage>> buildLookupResultObject(
     for (int32_t i = pathLength - 1; i >= 0; i--) {
         const auto rootObjectSlot = i == 0 ? localDocumentSlot : fieldSlots[i - 1];
         const auto fieldName = fieldPath.getFieldName(i).toString();
-        const auto valueSlot = i == pathLength - 1 ? resultArraySlot : objectSlots[i + 1];
+        const auto valueSlot = i == pathLength - 1 ? fieldValueSlot : objectSlots[i + 1];
         if (shouldProduceBson) {
             stage =
                 makeS<MakeBsonObjStage>(std::move(stage),
@@ -1139,13 +1139,51 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder
         }
     }();
 
+    // If the $lookup has absorbed an $unwind of its "as" field, produce one output document per
+    // matched foreign document instead of a single document holding the array of matches.
+    SlotId joinFieldValueSlot = matchedDocumentsSlot;
+    boost::optional<SlotId> arrayIndexSlot;
+    if (const auto& unwindSpec = eqLookupNode->unwindSpec) {
+        joinFieldValueSlot = _slotIdGenerator.generate();
+        SlotId unwindIndexSlot = _slotIdGenerator.generate();
+        foreignStage = makeS<UnwindStage>(std::move(foreignStage),
+                                          matchedDocumentsSlot,
+                                          joinFieldValueSlot,
+                                          unwindIndexSlot,
+                                          unwindSpec->preserveNullAndEmptyArrays,
+                                          eqLookupNode->nodeId());
+
+        if (unwindSpec->indexPath) {
+            // $unwind reports a null index for a document preserved without any match, while the
+            // SBE unwind stage reports 0 for an empty array.
+            arrayIndexSlot = _slotIdGenerator.generate();
+            foreignStage = makeProjectStage(
+                std::move(foreignStage),
+                eqLookupNode->nodeId(),
+                *arrayIndexSlot,
+                makeE<EIf>(makeFunction("exists"_sd, makeVariable(joinFieldValueSlot)),
+                           makeVariable(unwindIndexSlot),
+                           makeConstant(TypeTags::Null, 0)));
+        }
+    }
+
     auto [resultSlot, resultStage] = buildLookupResultObject(std::move(foreignStage),
                                                              localDocumentSlot,
-                                                             matchedDocumentsSlot,
+                                                             joinFieldValueSlot,
                                                              eqLookupNode->joinField,
                                                              eqLookupNode->nodeId(),
                                                              _slotIdGenerator,
                                                              eqLookupNode->shouldProduceBson);
+    if (arrayIndexSlot) {
+        std::tie(resultSlot, resultStage) =
+            buildLookupResultObject(std::move(resultStage),
+                                    resultSlot,
+                                    *arrayIndexSlot,
+                                    *eqLookupNode->unwindSpec->indexPath,
+                                    eqLookupNode->nodeId(),
+                                    _slotIdGenerator,
+                                    eqLookupNode->shouldProduceBson);
+    }
 
     PlanStageSlots outputs;
     outputs.set(kResult, resultSlot);
@@ -118,10 +118,12 @@ public:
     };
 
     // Constructs ready-to-execute SBE tree for $lookup specified by the arguments.
-    CompiledTree buildLookupSbeTree(EqLookupNode::LookupStrategy strategy,
-                                    const std::string& localKey,
-                                    const std::string& foreignKey,
-                                    const std::string& asKey) {
+    CompiledTree buildLookupSbeTree(
+        EqLookupNode::LookupStrategy strategy,
+        const std::string& localKey,
+        const std::string& foreignKey,
+        const std::string& asKey,
+        boost::optional<EqLookupNode::UnwindSpec> unwindSpec = boost::none) {
         // Documents from the local collection are provided using collection scan.
         auto localScanNode = std::make_unique<CollectionScanNode>();
         localScanNode->name = _nss.toString();
@@ -135,7 +137,8 @@ public:
                                                          asKey,
                                                          strategy,
                                                          boost::none /* idxEntry */,
-                                                         true /* shouldProduceBson */);
+                                                         true /* shouldProduceBson */,
+                                                         std::move(unwindSpec));
         auto solution = makeQuerySolution(std::move(lookupNode));
 
         // Convert logical solution into the physical SBE plan.
@@ -159,18 +162,20 @@ public:
     }
 
     // Check that SBE plan for '$lookup' returns expected documents.
-    void assertReturnedDocuments(EqLookupNode::LookupStrategy strategy,
-                                 const std::string& localKey,
-                                 const std::string& foreignKey,
-                                 const std::string& asKey,
-                                 const std::vector<BSONObj>& expected) {
+    void assertReturnedDocuments(
+        EqLookupNode::LookupStrategy strategy,
+        const std::string& localKey,
+        const std::string& foreignKey,
+        const std::string& asKey,
+        const std::vector<BSONObj>& expected,
+        const boost::optional<EqLookupNode::UnwindSpec>& unwindSpec = boost::none) {
         if (enableDebugOutput) {
             std::cout << std::endl
                       << "LookupStrategy: " << EqLookupNode::serializeLookupStrategy(strategy)
                       << std::endl;
         }
 
-        auto tree = buildLookupSbeTree(strategy, localKey, foreignKey, asKey);
+        auto tree = buildLookupSbeTree(strategy, localKey, foreignKey, asKey, unwindSpec);
         auto& stage = tree.stage;
 
         size_t i = 0;
@@ -207,12 +212,14 @@ public:
         stage->close();
     }
 
-    void assertReturnedDocuments(const std::string& localKey,
-                                 const std::string& foreignKey,
-                                 const std::string& asKey,
-                                 const std::vector<BSONObj>& expected) {
+    void assertReturnedDocuments(
+        const std::string& localKey,
+        const std::string& foreignKey,
+        const std::string& asKey,
+        const std::vector<BSONObj>& expected,
+        const boost::optional<EqLookupNode::UnwindSpec>& unwindSpec = boost::none) {
         for (auto strategy : strategies) {
-            assertReturnedDocuments(strategy, localKey, foreignKey, asKey, expected);
+            assertReturnedDocuments(strategy, localKey, foreignKey, asKey, expected, unwindSpec);
         }
     }
 
@@ -787,4 +794,45 @@ TEST_F(LookupStageBuilderTest, ThreeComponentAsPathDoesNotPerformArrayTraversal)
         "_id", "_id", "one.two.three", {fromjson("{_id: 0, one: {two: {three: [{_id: 0}]}}}")});
 }
 
+TEST_F(LookupStageBuilderTest, AbsorbedUnwind_Basic) {
+    insertDocuments({fromjson("{_id: 0, lkey: 1}"),
+                     fromjson("{_id: 1, lkey: 12}"),
+                     fromjson("{_id: 2, lkey: 3}")},
+                    {fromjson("{_id: 0, fkey: 1}"),
+                     fromjson("{_id: 1, fkey: 3}"),
+                     fromjson("{_id: 2, fkey: 1}")});
+
+    assertReturnedDocuments("lkey",
+                            "fkey",
+                            "result",
+                            {fromjson("{_id: 0, lkey: 1, result: {_id: 0, fkey: 1}}"),
+                             fromjson("{_id: 0, lkey: 1, result: {_id: 2, fkey: 1}}"),
+                             fromjson("{_id: 2, lkey: 3, result: {_id: 1, fkey: 3}}")},
+                            EqLookupNode::UnwindSpec{false /* preserveNullAndEmptyArrays */});
+}
+
+TEST_F(LookupStageBuilderTest, AbsorbedUnwind_PreserveNullAndEmptyArraysWithArrayIndex) {
+    insertDocuments({fromjson("{_id: 0, lkey: 1}"), fromjson("{_id: 1, lkey: 12, result: 5}")},
+                    {fromjson("{_id: 0, fkey: 1}"), fromjson("{_id: 1, fkey: 1}")});
+
+    assertReturnedDocuments("lkey",
+                            "fkey",
+                            "result",
+                            {fromjson("{_id: 0, lkey: 1, result: {_id: 0, fkey: 1}, idx: 0}"),
+                             fromjson("{_id: 0, lkey: 1, result: {_id: 1, fkey: 1}, idx: 1}"),
+                             fromjson("{_id: 1, lkey: 12, idx: null}")},
+                            EqLookupNode::UnwindSpec{true /* preserveNullAndEmptyArrays */,
+                                                     FieldPath("idx")});
+}
+
+TEST_F(LookupStageBuilderTest, AbsorbedUnwind_PreserveNullAndEmptyArraysOnDottedAsPath) {
+    insertDocuments({fromjson("{_id: 0, lkey: 12}")}, {fromjson("{_id: 0, fkey: 1}")});
+
+    assertReturnedDocuments("lkey",
+                            "fkey",
+                            "one.two",
+                            {fromjson("{_id: 0, lkey: 12, one: {}}")},
+                            EqLookupNode::UnwindSpec{true /* preserveNullAndEmptyArrays */});
+}
+
 }  // namespace mongo::sbe
@@ -0,0 +1,309 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/stats/histogram.h"
+
+#include <algorithm>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/util/str.h"
+
+namespace mongo::stats {
+namespace {
+
+int compareValues(const BSONElement& lhs, const BSONElement& rhs) {
+    // The values of a field come from different documents, so their names are irrelevant.
+    return lhs.woCompare(rhs, 0 /* rules */);
+}
+
+/**
+ * Returns the position of 'value' relative to the range between 'low' and 'high', as a fraction
+ * between 0 and 1. Only numbers and dates can be interpolated; other values are assumed to lie in
+ * the middle of the range.
+ */
+double interpolate(const BSONElement& low, const BSONElement& value, const BSONElement& high) {
+    if (low.canonicalType() != high.canonicalType() ||
+        value.canonicalType() != low.canonicalType()) {
+        return 0.5;
+    }
+
+    if (!low.isNumber() && low.type() != BSONType::Date) {
+        return 0.5;
+    }
+
+    auto toDouble = [](const BSONElement& elem) {
+        return elem.type() == BSONType::Date
+            ? static_cast<double>(elem.date().toMillisSinceEpoch())
+            : elem.numberDouble();
+    };
+
+    const double width = toDouble(high) - toDouble(low);
+    const double offset = toDouble(value) - toDouble(low);
+    if (!(width > 0.0) || !(offset >= 0.0)) {
+        return 0.5;
+    }
+    return std::min(1.0, offset / width);
+}
+
+const BSONElement& nullElement() {
+    static const BSONObj nullObj = BSON("" << BSONNULL);
+    static const BSONElement elem = nullObj.firstElement();
+    return elem;
+}
+
+}  // namespace
+
+Histogram::Histogram(double documents,
+                     double missing,
+                     std::map<BSONType, double> typeCounts,
+                     std::vector<Bucket> buckets,
+                     BSONObj bounds)
+    : _documents(documents),
+      _missing(missing),
+      _typeCounts(std::move(typeCounts)),
+      _buckets(std::move(buckets)),
+      _bounds(std::move(bounds)) {
+    for (auto&& bound : _bounds) {
+        _boundElements.push_back(bound);
+    }
+    invariant(_boundElements.size() == _buckets.size());
+
+    double cumulativeFreq = 0.0;
+    for (auto&& bucket : _buckets) {
+        cumulativeFreq += bucket.equalFreq + bucket.rangeFreq;
+        bucket.cumulativeFreq = cumulativeFreq;
+    }
+}
+
+Histogram Histogram::build(std::vector<BSONElement> values, size_t maxBuckets) {
+    invariant(maxBuckets >= 2);
+
+    double missing = 0.0;
+    std::map<BSONType, double> typeCounts;
+    std::vector<BSONElement> scalars;
+    for (auto&& value : values) {
+        if (value.eoo()) {
+            ++missing;
+            continue;
+        }
+        ++typeCounts[value.type()];
+        if (value.type() != BSONType::Array) {
+            scalars.push_back(value);
+        }
+    }
+
+    std::sort(scalars.begin(), scalars.end(), [](const BSONElement& lhs, const BSONElement& rhs) {
+        return compareValues(lhs, rhs) < 0;
+    });
+
+    // The smallest value gets a bucket of its own, so that the range of every other bucket has a
+    // lower bound to interpolate from. Each of the remaining buckets accumulates distinct values
+    // until it holds at least 'depth' of them, while keeping room for the bucket of the largest
+    // value.
+    const double depth = static_cast<double>(scalars.size()) / (maxBuckets - 1);
+    std::vector<Bucket> buckets;
+    BSONArrayBuilder bounds;
+    Bucket current;
+    for (size_t begin = 0; begin < scalars.size();) {
+        size_t end = begin + 1;
+        while (end < scalars.size() && compareValues(scalars[begin], scalars[end]) == 0) {
+            ++end;
+        }
+
+        const double freq = end - begin;
+        const bool isLast = end == scalars.size();
+        const bool isFull = current.rangeFreq + freq >= depth && buckets.size() + 1 < maxBuckets;
+        if (buckets.empty() || isLast || isFull) {
+            current.equalFreq = freq;
+            buckets.push_back(current);
+            bounds.append(scalars[begin]);
+            current = Bucket{};
+        } else {
+            current.rangeFreq += freq;
+            current.ndv += 1.0;
+        }
+        begin = end;
+    }
+
+    return Histogram(
+        values.size(), missing, std::move(typeCounts), std::move(buckets), bounds.arr());
+}
+
+StatusWith<Histogram> Histogram::parse(const BSONObj& obj) {
+    auto documents = obj["documents"];
+    auto missing = obj["missing"];
+    auto typeCounts = obj["typeCounts"];
+    auto buckets = obj["buckets"];
+    auto bounds = obj["bounds"];
+    if (!documents.isNumber() || !missing.isNumber() || typeCounts.type() != BSONType::Array ||
+        buckets.type() != BSONType::Array || bounds.type() != BSONType::Array) {
+        return {ErrorCodes::BadValue,
+                str::stream() << "Malformed histogram: " << obj.toString()};
+    }
+
+    std::map<BSONType, double> parsedTypeCounts;
+    for (auto&& elem : typeCounts.Obj()) {
+        if (elem.type() != BSONType::Object || !elem["type"].isNumber() ||
+            !elem["count"].isNumber() || !isValidBSONType(elem["type"].numberInt())) {
+            return {ErrorCodes::BadValue,
+                    str::stream() << "Malformed histogram type count: " << elem.toString()};
+        }
+        parsedTypeCounts[static_cast<BSONType>(elem["type"].numberInt())] =
+            elem["count"].numberDouble();
+    }
+
+    std::vector<Bucket> parsedBuckets;
+    for (auto&& elem : buckets.Obj()) {
+        if (elem.type() != BSONType::Object || !elem["equalFreq"].isNumber() ||
+            !elem["rangeFreq"].isNumber() || !elem["ndv"].isNumber()) {
+            return {ErrorCodes::BadValue,
+                    str::stream() << "Malformed histogram bucket: " << elem.toString()};
+        }
+        parsedBuckets.push_back({elem["equalFreq"].numberDouble(),
+                                 elem["rangeFreq"].numberDouble(),
+                                 elem["ndv"].numberDouble()});
+    }
+
+    auto parsedBounds = bounds.Obj().getOwned();
+    if (static_cast<size_t>(parsedBounds.nFields()) != parsedBuckets.size()) {
+        return {ErrorCodes::BadValue,
+                str::stream() << "Histogram has " << parsedBuckets.size() << " buckets but "
+                              << parsedBounds.nFields() << " bounds"};
+    }
+
+    return Histogram(documents.numberDouble(),
+                     missing.numberDouble(),
+                     std::move(parsedTypeCounts),
+                     std::move(parsedBuckets),
+                     std::move(parsedBounds));
+}
+
+BSONObj Histogram::toBSON() const {
+    BSONObjBuilder builder;
+    builder.append("documents", _documents);
+    builder.append("missing", _missing);
+    {
+        BSONArrayBuilder typeCounts(builder.subarrayStart("typeCounts"));
+        for (auto&& [type, count] : _typeCounts) {
+            typeCounts.append(BSON("type" << static_cast<int>(type) << "count" << count));
+        }
+    }
+    {
+        BSONArrayBuilder buckets(builder.subarrayStart("buckets"));
+        for (auto&& bucket : _buckets) {
+            buckets.append(BSON("equalFreq" << bucket.equalFreq << "rangeFreq" << bucket.rangeFreq
+                                            << "ndv" << bucket.ndv));
+        }
+    }
+    builder.appendArray("bounds", _bounds);
+    return builder.obj();
+}
+
+bool Histogram::canEstimate() const {
+    return _documents > 0.0 && _typeCounts.find(BSONType::Array) == _typeCounts.end();
+}
+
+size_t Histogram::findBucket(const BSONElement& value) const {
+    auto it = std::lower_bound(_boundElements.begin(),
+                               _boundElements.end(),
+                               value,
+                               [](const BSONElement& bound, const BSONElement& value) {
+                                   return compareValues(bound, value) < 0;
+                               });
+    return std::distance(_boundElements.begin(), it);
+}
+
+double Histogram::estimateLess(const BSONElement& value, bool inclusive) const {
+    const size_t index = findBucket(value);
+    if (index == _buckets.size()) {
+        return _buckets.empty() ? 0.0 : _buckets.back().cumulativeFreq;
+    }
+
+    const auto& bucket = _buckets[index];
+    const double preceding = bucket.cumulativeFreq - bucket.equalFreq - bucket.rangeFreq;
+    if (compareValues(_boundElements[index], value) == 0) {
+        return preceding + bucket.rangeFreq + (inclusive ? bucket.equalFreq : 0.0);
+    }
+    if (index == 0) {
+        // 'value' is smaller than any value in the histogram.
+        return 0.0;
+    }
+
+    // 'value' lies strictly inside the range of the bucket. If it is included, count it with the
+    // average frequency of the distinct values in the range.
+    double less =
+        bucket.rangeFreq * interpolate(_boundElements[index - 1], value, _boundElements[index]);
+    if (inclusive && bucket.ndv > 0.0) {
+        less = std::min(bucket.rangeFreq, less + bucket.rangeFreq / bucket.ndv);
+    }
+    return preceding + less;
+}
+
+double Histogram::estimateInterval(const BSONElement& low,
+                                   bool lowInclusive,
+                                   const BSONElement& high,
+                                   bool highInclusive) const {
+    const int cmp = compareValues(low, high);
+    if (_documents <= 0.0 || cmp > 0 || (cmp == 0 && !(lowInclusive && highInclusive))) {
+        return 0.0;
+    }
+
+    double freq =
+        std::max(0.0, estimateLess(high, highInclusive) - estimateLess(low, !lowInclusive));
+
+    const int cmpLow = compareValues(low, nullElement());
+    const int cmpHigh = compareValues(nullElement(), high);
+    if ((cmpLow < 0 || (cmpLow == 0 && lowInclusive)) &&
+        (cmpHigh < 0 || (cmpHigh == 0 && highInclusive))) {
+        freq += _missing;
+    }
+
+    return std::min(1.0, freq / _documents);
+}
+
+double Histogram::estimateEquality(const BSONElement& value) const {
+    return estimateInterval(value, true, value, true);
+}
+
+double Histogram::getDistinctValues() const {
+    double ndv = 0.0;
+    for (auto&& bucket : _buckets) {
+        ndv += bucket.ndv + 1.0;
+    }
+
+    // Missing fields are only an additional value if there is no null in the histogram.
+    if (_missing > 0.0 && _typeCounts.find(BSONType::jstNULL) == _typeCounts.end()) {
+        ndv += 1.0;
+    }
+    return ndv;
+}
+
+}  // namespace mongo::stats
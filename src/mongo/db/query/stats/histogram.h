@@ -0,0 +1,144 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <map>
+#include <vector>
+
+#include "mongo/base/status_with.h"
+#include "mongo/bson/bsonelement.h"
+#include "mongo/bson/bsonobj.h"
+
+namespace mongo::stats {
+
+/**
+ * A bucket of an equi-depth histogram. A bucket covers the values in the range (previous bound,
+ * bound], where 'equalFreq' is the number of values equal to the bound, and 'rangeFreq' and
+ * 'ndv' are the number of values, respectively of distinct values, strictly inside the range.
+ */
+struct Bucket {
+    double equalFreq = 0.0;
+    double rangeFreq = 0.0;
+    double ndv = 0.0;
+
+    // Total frequency of this bucket and of all the buckets preceding it.
+    double cumulativeFreq = 0.0;
+};
+
+/**
+ * Statistics describing the values of a single field across a (sample of a) collection: the
+ * number of documents per BSON type of the field and an equi-depth histogram over its non-array
+ * values. Estimates are returned as selectivities, that is as fractions of the documents the
+ * statistics were built from, so that they can be applied to the current collection size.
+ */
+class Histogram {
+public:
+    /**
+     * Builds the statistics for 'values', holding the value of the field in each sampled document
+     * or EOO if the field was missing. The histogram has at most 'maxBuckets' buckets.
+     */
+    static Histogram build(std::vector<BSONElement> values, size_t maxBuckets);
+
+    static StatusWith<Histogram> parse(const BSONObj& obj);
+
+    Histogram() = default;
+
+    BSONObj toBSON() const;
+
+    /**
+     * Returns whether the histogram can be used for estimation. A histogram over a field that
+     * holds arrays cannot, since predicates on such a field match the array elements.
+     */
+    bool canEstimate() const;
+
+    /**
+     * Returns the estimated fraction of the documents whose field value lies in the interval
+     * between 'low' and 'high'. Either bound may be MinKey or MaxKey. Documents missing the field
+     * are counted as null.
+     */
+    double estimateInterval(const BSONElement& low,
+                            bool lowInclusive,
+                            const BSONElement& high,
+                            bool highInclusive) const;
+
+    /**
+     * Returns the estimated fraction of the documents whose field value is equal to 'value'.
+     */
+    double estimateEquality(const BSONElement& value) const;
+
+    /**
+     * Returns the number of distinct non-array values of the field, counting a missing field as
+     * null.
+     */
+    double getDistinctValues() const;
+
+    double getDocuments() const {
+        return _documents;
+    }
+
+    const std::vector<Bucket>& getBuckets() const {
+        return _buckets;
+    }
+
+    const std::map<BSONType, double>& getTypeCounts() const {
+        return _typeCounts;
+    }
+
+private:
+    Histogram(double documents,
+              double missing,
+              std::map<BSONType, double> typeCounts,
+              std::vector<Bucket> buckets,
+              BSONObj bounds);
+
+    /**
+     * Returns the estimated number of values less than 'value', or less than or equal to it if
+     * 'inclusive' is set.
+     */
+    double estimateLess(const BSONElement& value, bool inclusive) const;
+
+    /**
+     * Returns the index of the first bucket whose bound is not less than 'value', or the number of
+     * buckets if there is none.
+     */
+    size_t findBucket(const BSONElement& value) const;
+
+    double _documents = 0.0;
+    double _missing = 0.0;
+    std::map<BSONType, double> _typeCounts;
+
+    std::vector<Bucket> _buckets;
+
+    // Array holding the bound of each bucket, and views of its elements.
+    BSONObj _bounds;
+    std::vector<BSONElement> _boundElements;
+};
+
+}  // namespace mongo::stats
@@ -0,0 +1,154 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/query/stats/histogram.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo::stats {
+namespace {
+
+/**
+ * Returns views of the elements of 'values', which must outlive them.
+ */
+std::vector<BSONElement> toElements(const BSONArray& values) {
+    std::vector<BSONElement> elements;
+    for (auto&& elem : values) {
+        elements.push_back(elem);
+    }
+    return elements;
+}
+
+BSONArray makeRange(int low, int high) {
+    BSONArrayBuilder builder;
+    for (int i = low; i <= high; ++i) {
+        builder.append(i);
+    }
+    return builder.arr();
+}
+
+TEST(HistogramTest, BuildsEquiDepthBuckets) {
+    auto values = makeRange(1, 100);
+    auto histogram = Histogram::build(toElements(values), 11);
+
+    const auto& buckets = histogram.getBuckets();
+    ASSERT_EQ(buckets.size(), 11U);
+
+    // The smallest value is alone in the first bucket.
+    ASSERT_EQ(buckets[0].equalFreq, 1.0);
+    ASSERT_EQ(buckets[0].rangeFreq, 0.0);
+    ASSERT_EQ(buckets[1].rangeFreq, 9.0);
+    ASSERT_EQ(buckets[1].ndv, 9.0);
+    ASSERT_EQ(buckets.back().cumulativeFreq, 100.0);
+    ASSERT_EQ(histogram.getDocuments(), 100.0);
+}
+
+TEST(HistogramTest, EstimatesFrequentValuesExactly) {
+    BSONArrayBuilder builder;
+    for (int i = 0; i < 900; ++i) {
+        builder.append(0);
+    }
+    for (int i = 1; i <= 100; ++i) {
+        builder.append(i);
+    }
+    auto values = builder.arr();
+    auto histogram = Histogram::build(toElements(values), 10);
+
+    ASSERT_EQ(histogram.estimateEquality(BSON("" << 0).firstElement()), 0.9);
+    ASSERT_APPROX_EQUAL(histogram.estimateEquality(BSON("" << 50).firstElement()), 0.001, 1e-9);
+}
+
+TEST(HistogramTest, EstimatesRangesByInterpolation) {
+    auto values = makeRange(1, 1000);
+    auto histogram = Histogram::build(toElements(values), 11);
+
+    auto bounds = BSON_ARRAY(100 << 200);
+    ASSERT_APPROX_EQUAL(
+        histogram.estimateInterval(bounds[0], true, bounds[1], true), 0.101, 0.001);
+    ASSERT_APPROX_EQUAL(
+        histogram.estimateInterval(bounds[0], false, bounds[1], false), 0.099, 0.001);
+}
+
+TEST(HistogramTest, IntervalOfAnotherTypeIsEmpty) {
+    auto values = makeRange(1, 100);
+    auto histogram = Histogram::build(toElements(values), 10);
+
+    auto bounds = BSON_ARRAY("a"
+                             << "z");
+    ASSERT_EQ(histogram.estimateInterval(bounds[0], true, bounds[1], true), 0.0);
+}
+
+TEST(HistogramTest, CountsMissingFieldsAsNull) {
+    auto values = makeRange(1, 90);
+    auto elements = toElements(values);
+    elements.resize(100);
+
+    auto histogram = Histogram::build(std::move(elements), 10);
+    ASSERT_EQ(histogram.getDocuments(), 100.0);
+    ASSERT_EQ(histogram.getDistinctValues(), 91.0);
+    ASSERT_EQ(histogram.estimateEquality(BSON("" << BSONNULL).firstElement()), 0.1);
+
+    auto bounds = BSON_ARRAY(MINKEY << MAXKEY);
+    ASSERT_EQ(histogram.estimateInterval(bounds[0], true, bounds[1], true), 1.0);
+}
+
+TEST(HistogramTest, CannotEstimateFieldsHoldingArrays) {
+    auto values = BSON_ARRAY(1 << 2 << BSON_ARRAY(3 << 4));
+    auto histogram = Histogram::build(toElements(values), 10);
+
+    ASSERT_FALSE(histogram.canEstimate());
+    ASSERT_EQ(histogram.getTypeCounts().at(BSONType::NumberInt), 2.0);
+    ASSERT_EQ(histogram.getTypeCounts().at(BSONType::Array), 1.0);
+}
+
+TEST(HistogramTest, RoundTripsThroughBSON) {
+    auto values = BSON_ARRAY(1 << 2.5 << "str" << BSONNULL << 1 << 7LL);
+    auto elements = toElements(values);
+    elements.emplace_back();
+    auto histogram = Histogram::build(std::move(elements), 3);
+
+    auto parsed = Histogram::parse(histogram.toBSON());
+    ASSERT_OK(parsed.getStatus());
+    ASSERT_BSONOBJ_EQ(parsed.getValue().toBSON(), histogram.toBSON());
+
+    auto bounds = BSON_ARRAY(1 << 10);
+    ASSERT_EQ(parsed.getValue().estimateInterval(bounds[0], true, bounds[1], true),
+              histogram.estimateInterval(bounds[0], true, bounds[1], true));
+}
+
+TEST(HistogramTest, RejectsMismatchedBuckets) {
+    auto bson = BSON("documents" << 1 << "missing" << 0 << "typeCounts" << BSONArray()
+                                 << "buckets" << BSONArray() << "bounds" << BSON_ARRAY(1));
+    ASSERT_EQ(Histogram::parse(bson).getStatus(), ErrorCodes::BadValue);
+}
+
+}  // namespace
+}  // namespace mongo::stats
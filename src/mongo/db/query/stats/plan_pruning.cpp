@@ -0,0 +1,200 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kQuery
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/stats/plan_pruning.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/query/stats/stats_catalog.h"
+#include "mongo/logv2/log.h"
+
+namespace mongo::stats {
+namespace {
+
+/**
+ * Returns the estimated fraction of the index keys examined by 'node', or boost::none if it cannot
+ * be estimated from the histogram of the leading index field.
+ */
+boost::optional<double> estimateIndexScan(OperationContext* opCtx,
+                                          const NamespaceString& nss,
+                                          const IndexScanNode& node) {
+    const auto& index = node.index;
+    if (index.type != INDEX_BTREE || index.collator || node.bounds.isSimpleRange ||
+        node.bounds.fields.empty()) {
+        return boost::none;
+    }
+
+    auto histogram =
+        StatsCatalog::get(opCtx).getHistogram(opCtx, nss, index.keyPattern.firstElementFieldName());
+    if (!histogram || !histogram->canEstimate()) {
+        return boost::none;
+    }
+
+    double selectivity = 0.0;
+    for (auto&& interval : node.bounds.fields[0].intervals) {
+        // The intervals of a descending index field run from the highest to the lowest value.
+        const bool ascending = interval.start.woCompare(interval.end, false) <= 0;
+        selectivity += ascending
+            ? histogram->estimateInterval(
+                  interval.start, interval.startInclusive, interval.end, interval.endInclusive)
+            : histogram->estimateInterval(
+                  interval.end, interval.endInclusive, interval.start, interval.startInclusive);
+    }
+    return std::min(1.0, selectivity);
+}
+
+/**
+ * Returns the estimated fraction of the collection read by the leaves of the tree rooted at
+ * 'node', or boost::none if any leaf cannot be estimated.
+ */
+boost::optional<double> estimateSolution(OperationContext* opCtx,
+                                         const NamespaceString& nss,
+                                         const QuerySolutionNode* node) {
+    if (node->children.empty()) {
+        switch (node->getType()) {
+            case STAGE_COLLSCAN:
+                return 1.0;
+            case STAGE_IXSCAN:
+                return estimateIndexScan(opCtx, nss, static_cast<const IndexScanNode&>(*node));
+            default:
+                return boost::none;
+        }
+    }
+
+    double estimate = 0.0;
+    for (auto&& child : node->children) {
+        auto childEstimate = estimateSolution(opCtx, nss, child);
+        if (!childEstimate) {
+            return boost::none;
+        }
+        estimate += *childEstimate;
+    }
+    return estimate;
+}
+
+/**
+ * Returns false if the tree rooted at 'node' has an AND_HASH or AND_SORTED stage estimated to cost
+ * more than fetching all the documents matched by its most selective child alone.
+ */
+bool isIntersectionWorthwhile(OperationContext* opCtx,
+                              const NamespaceString& nss,
+                              const QuerySolutionNode* node,
+                              double fetchCost) {
+    for (auto&& child : node->children) {
+        if (!isIntersectionWorthwhile(opCtx, nss, child, fetchCost)) {
+            return false;
+        }
+    }
+    if (node->getType() != STAGE_AND_HASH && node->getType() != STAGE_AND_SORTED) {
+        return true;
+    }
+
+    double keysExamined = 0.0;
+    double intersection = 1.0;
+    double mostSelective = 1.0;
+    for (auto&& child : node->children) {
+        auto childEstimate = estimateSolution(opCtx, nss, child);
+        if (!childEstimate) {
+            return true;
+        }
+        keysExamined += *childEstimate;
+        intersection *= std::min(1.0, *childEstimate);
+        mostSelective = std::min(mostSelective, *childEstimate);
+    }
+    return keysExamined + fetchCost * intersection < (1.0 + fetchCost) * mostSelective;
+}
+
+}  // namespace
+
+void pruneSolutions(OperationContext* opCtx,
+                    const CollectionPtr& collection,
+                    std::vector<std::unique_ptr<QuerySolution>>* solutions) {
+    const auto& nss = collection->ns();
+    const double numRecords = collection->numRecords(opCtx);
+
+    // Candidates intersecting several indexes are discarded first, unless that would leave no
+    // candidate at all.
+    const double fetchCost = internalQueryPlannerIndexIntersectionFetchCost.load();
+    std::vector<bool> discard;
+    for (auto&& solution : *solutions) {
+        discard.push_back(!isIntersectionWorthwhile(opCtx, nss, solution->root(), fetchCost));
+    }
+    if (std::all_of(discard.begin(), discard.end(), [](bool d) { return d; })) {
+        discard.assign(solutions->size(), false);
+    }
+
+    std::vector<boost::optional<double>> estimates;
+    boost::optional<double> minEstimate;
+    for (size_t i = 0; i < solutions->size(); ++i) {
+        auto estimate =
+            discard[i] ? boost::none : estimateSolution(opCtx, nss, (*solutions)[i]->root());
+        if (estimate) {
+            *estimate *= numRecords;
+            minEstimate = std::min(minEstimate.value_or(*estimate), *estimate);
+        }
+        estimates.push_back(estimate);
+    }
+
+    // Estimates are approximate, so never make the threshold depend on a candidate estimated to
+    // examine less than one key.
+    const double threshold = minEstimate
+        ? std::max(*minEstimate, 1.0) * internalQueryPlannerHistogramPruneRatio.load()
+        : std::numeric_limits<double>::infinity();
+
+    size_t numKept = 0;
+    for (size_t i = 0; i < solutions->size(); ++i) {
+        if (discard[i]) {
+            LOGV2_DEBUG(7000115,
+                        2,
+                        "Discarding index intersection plan estimated to cost more than a single "
+                        "index scan",
+                        "planSummary"_attr = (*solutions)[i]->summaryString());
+            continue;
+        }
+        if (estimates[i] && *estimates[i] > threshold) {
+            LOGV2_DEBUG(7000114,
+                        2,
+                        "Discarding candidate plan estimated to examine too many keys",
+                        "planSummary"_attr = (*solutions)[i]->summaryString(),
+                        "estimatedKeys"_attr = *estimates[i],
+                        "threshold"_attr = threshold);
+            continue;
+        }
+        (*solutions)[numKept++] = std::move((*solutions)[i]);
+    }
+    solutions->resize(numKept);
+}
+
+}  // namespace mongo::stats
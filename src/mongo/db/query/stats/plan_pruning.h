@@ -0,0 +1,55 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/query/query_solution.h"
+
+namespace mongo::stats {
+
+/**
+ * Uses the histograms of the leading fields of the indexes scanned by the candidate 'solutions' to
+ * discard, before the multi-planning trials, the candidates estimated to examine more than
+ * 'internalQueryPlannerHistogramPruneRatio' times as many keys as the most selective one. A
+ * candidate that cannot be estimated is never discarded, and neither is the most selective one.
+ *
+ * Index intersection candidates are also discarded unless, assuming the intersected predicates are
+ * independent, fetching only the intersection pays for examining the keys of every intersected
+ * index (see 'internalQueryPlannerIndexIntersectionFetchCost').
+ */
+void pruneSolutions(OperationContext* opCtx,
+                    const CollectionPtr& collection,
+                    std::vector<std::unique_ptr<QuerySolution>>* solutions);
+
+}  // namespace mongo::stats
@@ -0,0 +1,190 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kQuery
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/stats/stats_catalog.h"
+
+#include "mongo/base/init.h"
+#include "mongo/client/read_preference.h"
+#include "mongo/db/client.h"
+#include "mongo/db/dbdirectclient.h"
+#include "mongo/db/query/find_command_gen.h"
+#include "mongo/logv2/log.h"
+#include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo::stats {
+namespace {
+
+const auto statsCatalogDecoration = ServiceContext::declareDecoration<StatsCatalog>();
+
+// Loads statistics off the planning path, one collection at a time.
+std::unique_ptr<ThreadPool> statsLoaderThreadPool;
+
+MONGO_INITIALIZER(statsLoaderThreadPool)(InitializerContext* context) {
+    ThreadPool::Options options;
+    options.poolName = "statistics loader pool";
+    options.threadNamePrefix = "StatsLoader";
+    options.minThreads = 0;
+    options.maxThreads = 1;
+    options.onCreateThread = [](const std::string& name) { Client::initThread(name); };
+    statsLoaderThreadPool = std::make_unique<ThreadPool>(options);
+    statsLoaderThreadPool->startup();
+}
+
+}  // namespace
+
+StatsCatalog::~StatsCatalog() {
+    waitForLoads();
+}
+
+StatsCatalog& StatsCatalog::get(ServiceContext* svcCtx) {
+    return statsCatalogDecoration(svcCtx);
+}
+
+StatsCatalog& StatsCatalog::get(OperationContext* opCtx) {
+    return get(opCtx->getServiceContext());
+}
+
+std::shared_ptr<const Histogram> StatsCatalog::getHistogram(OperationContext* opCtx,
+                                                            const NamespaceString& nss,
+                                                            StringData path) {
+    auto svcCtx = opCtx->getServiceContext();
+    const auto now = svcCtx->getFastClockSource()->now();
+
+    std::shared_ptr<const CollectionStats> stats;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        if (auto it = _stats.find(nss.ns()); it != _stats.end()) {
+            stats = it->second;
+        }
+
+        // Keep using the outdated statistics while they are reloaded.
+        if (!stats || now - stats->loadTime >= kRefreshInterval) {
+            _scheduleLoad(lk, svcCtx, nss);
+        }
+    }
+
+    if (!stats) {
+        return nullptr;
+    }
+    auto it = stats->histograms.find(path);
+    return it != stats->histograms.end() ? it->second : nullptr;
+}
+
+void StatsCatalog::invalidate(const NamespaceString& nss) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _stats.erase(nss.ns());
+    ++_epoch;
+}
+
+void StatsCatalog::waitForLoads() {
+    stdx::unique_lock<Latch> lk(_mutex);
+    _loadDone.wait(lk, [&] { return _loading.empty(); });
+}
+
+void StatsCatalog::_scheduleLoad(WithLock, ServiceContext* svcCtx, const NamespaceString& nss) {
+    if (!_loading.insert(nss.ns()).second) {
+        return;
+    }
+
+    statsLoaderThreadPool->schedule([this, svcCtx, nss, epoch = _epoch](Status status) {
+        ON_BLOCK_EXIT([&] {
+            stdx::lock_guard<Latch> lk(_mutex);
+            _loading.erase(nss.ns());
+            _loadDone.notify_all();
+        });
+        if (!status.isOK()) {
+            return;
+        }
+
+        std::shared_ptr<const CollectionStats> stats;
+        try {
+            auto opCtx = cc().makeOperationContext();
+            stats = _load(opCtx.get(), nss);
+        } catch (const DBException& ex) {
+            LOGV2_DEBUG(7027517,
+                        1,
+                        "Failed to load statistics",
+                        "namespace"_attr = nss,
+                        "error"_attr = ex.toStatus());
+        }
+
+        stdx::lock_guard<Latch> lk(_mutex);
+        if (epoch != _epoch) {
+            return;
+        }
+        if (!stats) {
+            // Keep the previous statistics, if any, and retry once the refresh interval has passed
+            // rather than on the next lookup.
+            auto it = _stats.find(nss.ns());
+            auto kept = it != _stats.end() ? std::make_shared<CollectionStats>(*it->second)
+                                           : std::make_shared<CollectionStats>();
+            kept->loadTime = svcCtx->getFastClockSource()->now();
+            stats = std::move(kept);
+        }
+        _stats[nss.ns()] = std::move(stats);
+    });
+}
+
+std::shared_ptr<const StatsCatalog::CollectionStats> StatsCatalog::_load(
+    OperationContext* opCtx, const NamespaceString& nss) {
+    auto stats = std::make_shared<CollectionStats>();
+    stats->loadTime = opCtx->getServiceContext()->getFastClockSource()->now();
+
+    DBDirectClient client(opCtx);
+    auto cursor = client.find(FindCommandRequest{nss.makeStatisticsNamespace()},
+                              ReadPreferenceSetting{ReadPreference::SecondaryPreferred});
+    while (cursor->more()) {
+        auto doc = cursor->next();
+        auto path = doc["_id"];
+        auto statistics = doc["statistics"];
+        if (path.type() != BSONType::String || statistics.type() != BSONType::Object) {
+            continue;
+        }
+
+        auto histogram = Histogram::parse(statistics.Obj());
+        if (!histogram.isOK()) {
+            LOGV2_WARNING(7000113,
+                          "Ignoring malformed statistics",
+                          "namespace"_attr = nss,
+                          "path"_attr = path.valueStringData(),
+                          "error"_attr = histogram.getStatus());
+            continue;
+        }
+        stats->histograms[path.valueStringData()] =
+            std::make_shared<const Histogram>(std::move(histogram.getValue()));
+    }
+    return stats;
+}
+
+}  // namespace mongo::stats
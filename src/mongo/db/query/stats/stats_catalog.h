@@ -0,0 +1,111 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/query/stats/histogram.h"
+#include "mongo/db/service_context.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/util/concurrency/with_lock.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo::stats {
+
+/**
+ * In-memory cache of the statistics built by the 'analyze' command. The statistics of a collection
+ * 'db.coll' are stored in 'db.system.statistics.coll' as one document per analyzed field:
+ *
+ *     {_id: <field path>, statistics: <histogram>}
+ *
+ * The statistics of a collection are loaded in the background on first use and reloaded
+ * periodically, so that nodes pick up the statistics replicated from an 'analyze' run on another
+ * node. Lookups only ever read the cache, as they are made while planning a query.
+ */
+class StatsCatalog {
+public:
+    // How long the cached statistics of a collection are used before being reloaded.
+    static constexpr Seconds kRefreshInterval{30};
+
+    StatsCatalog() = default;
+    ~StatsCatalog();
+
+    static StatsCatalog& get(ServiceContext* svcCtx);
+    static StatsCatalog& get(OperationContext* opCtx);
+
+    /**
+     * Returns the cached histogram for the field 'path' of 'nss', or nullptr if that field has not
+     * been analyzed or the statistics of 'nss' have not been loaded yet. If the statistics of 'nss'
+     * are missing or older than kRefreshInterval, schedules a background load which a later lookup
+     * picks up.
+     */
+    std::shared_ptr<const Histogram> getHistogram(OperationContext* opCtx,
+                                                  const NamespaceString& nss,
+                                                  StringData path);
+
+    /**
+     * Drops the cached statistics of 'nss' so that the next lookup reloads them.
+     */
+    void invalidate(const NamespaceString& nss);
+
+    /**
+     * Waits until no statistics are being loaded. Only meant for tests.
+     */
+    void waitForLoads();
+
+private:
+    struct CollectionStats {
+        Date_t loadTime;
+        StringMap<std::shared_ptr<const Histogram>> histograms;
+    };
+
+    /**
+     * Loads the statistics of 'nss' on the loader thread, unless they are being loaded already.
+     */
+    void _scheduleLoad(WithLock, ServiceContext* svcCtx, const NamespaceString& nss);
+
+    static std::shared_ptr<const CollectionStats> _load(OperationContext* opCtx,
+                                                        const NamespaceString& nss);
+
+    Mutex _mutex = MONGO_MAKE_LATCH("StatsCatalog::_mutex");
+    StringMap<std::shared_ptr<const CollectionStats>> _stats;
+
+    // The namespaces whose statistics are being loaded, and a condition signaled when a load ends.
+    StringSet _loading;
+    stdx::condition_variable _loadDone;
+
+    // Incremented by every invalidation, so that a load which started before it is discarded.
+    uint64_t _epoch = 0;
+};
+
+}  // namespace mongo::stats
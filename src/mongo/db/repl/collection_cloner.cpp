@@ -431,9 +431,9 @@ void CollectionCloner::handleNextBatch(DBClientCursorBatchIterator& iter) {
 void CollectionCloner::insertDocumentsCallback(const executor::TaskExecutor::CallbackArgs& cbd) {
     uassertStatusOK(cbd.status);
 
+    std::vector<BSONObj> docs;
     {
         stdx::lock_guard<Latch> lk(_mutex);
-        std::vector<BSONObj> docs;
         // Increment 'fetchedBatches' even if no documents were inserted to match the number of
         // 'receivedBatches'.
         ++_stats.fetchedBatches;
@@ -448,13 +448,15 @@ void CollectionCloner::insertDocumentsCallback(const executor::TaskExecutor::Cal
         _stats.documentsCopied += docs.size();
         _stats.approxBytesCopied = ((long)_stats.documentsCopied) * _stats.avgObjSize;
         _progressMeter.hit(int(docs.size()));
-        invariant(_collLoader);
-
-        // The insert must be done within the lock, because CollectionBulkLoader is not
-        // thread safe.
-        uassertStatusOK(_collLoader->insertDocuments(docs.cbegin(), docs.cend()));
     }
 
+    // CollectionBulkLoader is not thread safe, but all database work for this cloner runs
+    // serially on '_dbWorkTaskRunner', so the insert does not need '_mutex'. Inserting outside
+    // the lock lets handleNextBatch() buffer the next batch from the sync source while this one
+    // is written, instead of stalling the network side for the length of the insert.
+    invariant(_collLoader);
+    uassertStatusOK(_collLoader->insertDocuments(docs.cbegin(), docs.cend()));
+
     initialSyncHangDuringCollectionClone.executeIf(
         [&](const BSONObj&) {
             LOGV2(21138,
@@ -33,15 +33,80 @@
 
 #include "mongo/db/repl/oplog_applier.h"
 
+#ifdef __linux__
+#include <fstream>
+#include <pthread.h>
+#include <sched.h>
+#include <sstream>
+#endif
+
 #include "mongo/db/auth/authorization_session.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/logv2/log.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/errno_util.h"
 #include "mongo/util/processinfo.h"
 #include "mongo/util/time_support.h"
 
 namespace mongo {
 namespace repl {
+namespace {
+
+#ifdef __linux__
+/**
+ * Returns the CPUs of each NUMA node of the host, as listed in sysfs. Returns an empty vector on
+ * hosts with a single node, where there is nothing to pin to.
+ */
+std::vector<std::vector<int>> getNumaNodeCpus() {
+    std::vector<std::vector<int>> nodes;
+    for (int node = 0;; ++node) {
+        std::ifstream cpulist(str::stream()
+                              << "/sys/devices/system/node/node" << node << "/cpulist");
+        if (!cpulist) {
+            break;
+        }
+
+        // The list is made of comma separated CPUs and CPU ranges, e.g. "0-7,16-23".
+        std::vector<int> cpus;
+        std::string range;
+        while (std::getline(cpulist, range, ',')) {
+            std::istringstream in(range);
+            int first;
+            if (!(in >> first)) {
+                continue;
+            }
+            int last = first;
+            if (in.peek() == '-') {
+                in.get();
+                in >> last;
+            }
+            for (int cpu = first; cpu <= last; ++cpu) {
+                cpus.push_back(cpu);
+            }
+        }
+        nodes.push_back(std::move(cpus));
+    }
+    return nodes.size() > 1 ? nodes : std::vector<std::vector<int>>{};
+}
+
+void pinCurrentThreadToCpus(const std::vector<int>& cpus) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (auto cpu : cpus) {
+        if (cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &set);
+        }
+    }
+    if (int err = pthread_setaffinity_np(pthread_self(), sizeof(set), &set)) {
+        LOGV2_WARNING(7027507,
+                      "Failed to pin an oplog writer thread to its NUMA node",
+                      "error"_attr = errorMessage(posixError(err)));
+    }
+}
+#endif
+
+}  // namespace
 
 NoopOplogApplierObserver noopOplogApplierObserver;
 
@@ -164,7 +229,26 @@ std::unique_ptr<ThreadPool> makeReplWriterPool(int threadCount,
     options.minThreads =
         replWriterMinThreadCount < threadCount ? replWriterMinThreadCount : threadCount;
     options.maxThreads = static_cast<size_t>(threadCount);
-    options.onCreateThread = [isKillableByStepdown](const std::string&) {
+
+#ifdef __linux__
+    std::vector<std::vector<int>> numaNodeCpus;
+    if (replWriterPinToNumaNodes) {
+        numaNodeCpus = getNumaNodeCpus();
+        LOGV2(7027508,
+              "Pinning oplog writer threads to NUMA nodes",
+              "pool"_attr = options.poolName,
+              "numNodes"_attr = numaNodeCpus.size());
+    }
+    auto threadsCreated = std::make_shared<AtomicWord<size_t>>(0);
+#endif
+
+    options.onCreateThread = [=](const std::string&) {
+#ifdef __linux__
+        if (!numaNodeCpus.empty()) {
+            auto node = threadsCreated->fetchAndAdd(1) % numaNodeCpus.size();
+            pinCurrentThreadToCpus(numaNodeCpus[node]);
+        }
+#endif
         Client::initThread(getThreadName());
         auto client = Client::getCurrent();
         AuthorizationSession::get(*client)->grantInternalAuthorization(client);
@@ -51,6 +51,7 @@
 #include "mongo/platform/basic.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/log_with_sampling.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 namespace repl {
@@ -72,6 +73,40 @@ ServerStatusMetricField<Counter64> displayOplogApplicationBatchSize("repl.apply.
 TimerStats applyBatchStats;
 ServerStatusMetricField<TimerStats> displayOpBatchesApplied("repl.apply.batches", &applyBatchStats);
 
+// How evenly the ops of each batch were spread over the writer threads. The ratio of
+// 'parallelism.ops' to 'parallelism.busiestWriterOps' is the average speedup over applying every
+// batch on a single thread; it is bounded by the number of writer threads.
+Counter64 writerVectorOpsStats;
+ServerStatusMetricField<Counter64> displayWriterVectorOps("repl.apply.parallelism.ops",
+                                                          &writerVectorOpsStats);
+Counter64 busiestWriterOpsStats;
+ServerStatusMetricField<Counter64> displayBusiestWriterOps(
+    "repl.apply.parallelism.busiestWriterOps", &busiestWriterOpsStats);
+Counter64 writersUsedStats;
+ServerStatusMetricField<Counter64> displayWritersUsed("repl.apply.parallelism.writersUsed",
+                                                      &writersUsedStats);
+
+void recordWriterVectorStats(const std::vector<std::vector<const OplogEntry*>>& writerVectors) {
+    size_t totalOps = 0;
+    size_t busiestWriterOps = 0;
+    size_t writersUsed = 0;
+    for (const auto& writer : writerVectors) {
+        totalOps += writer.size();
+        busiestWriterOps = std::max(busiestWriterOps, writer.size());
+        writersUsed += writer.empty() ? 0 : 1;
+    }
+    writerVectorOpsStats.increment(totalOps);
+    busiestWriterOpsStats.increment(busiestWriterOps);
+    writersUsedStats.increment(writersUsed);
+}
+
+// Time the applier spends waiting for the oplog writes of a batch after it has finished
+// partitioning the batch into writer vectors. Oplog writes and partitioning run concurrently, so
+// this is the part of the oplog write that is not hidden behind batch preparation.
+TimerStats oplogWriteWaitStats;
+ServerStatusMetricField<TimerStats> displayOplogWriteWait("repl.apply.oplogWriteWait",
+                                                          &oplogWriteWaitStats);
+
 /**
  * Used for logging a report of ops that take longer than "slowMS" to apply. This is called
  * right before returning from applyOplogEntryOrGroupedInserts, and it returns the same status.
@@ -333,7 +368,10 @@ void OplogApplierImpl::_run(OplogBuffer* oplogBuffer) {
 
         // Apply the operations in this batch. '_applyOplogBatch' returns the optime of the
         // last op that was applied, which should be the last optime in the batch.
+        const auto numOpsInBatch = ops.getBatch().size();
+        Timer applyTimer;
         auto swLastOpTimeAppliedInBatch = _applyOplogBatch(&opCtx, ops.releaseBatch());
+        _oplogBatcher->recordBatchApplied(numOpsInBatch, applyTimer.elapsed());
         if (swLastOpTimeAppliedInBatch.getStatus().code() == ErrorCodes::InterruptedAtShutdown) {
             // If an operation was interrupted at shutdown, fail the batch without advancing
             // appliedThrough as if this were an unclean shutdown. This ensures the stable timestamp
@@ -479,9 +517,13 @@ StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
         std::vector<std::vector<const OplogEntry*>> writerVectors(
             _writerPool->getStats().options.maxThreads);
         fillWriterVectors(opCtx, &ops, &writerVectors, &derivedOps);
+        recordWriterVectorStats(writerVectors);
 
         // Wait for writes to finish before applying ops.
-        _writerPool->waitForIdle();
+        {
+            TimerHolder waitTimer(&oplogWriteWaitStats);
+            _writerPool->waitForIdle();
+        }
 
         // Use this fail point to hold the PBWM lock after we have written the oplog entries but
         // before we have applied them.
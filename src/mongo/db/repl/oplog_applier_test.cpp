@@ -38,7 +38,9 @@
 #include "mongo/db/repl/oplog_applier.h"
 #include "mongo/db/repl/oplog_batcher_test_fixture.h"
 #include "mongo/db/repl/oplog_buffer_blocking_queue.h"
+#include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/db/service_context_test_fixture.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/clock_source_mock.h"
 
@@ -364,6 +366,57 @@ TEST_F(OplogApplierTest, LastOpInLargeTransactionIsProcessedIndividually) {
     ASSERT_EQUALS(srcOps[4], batch[0]);
 }
 
+TEST_F(OplogApplierTest, AdaptiveBatchLimitIsOffByDefault) {
+    RAIIServerParameterControllerForTest limitOps("replBatchLimitOperations", 5000);
+    OplogBatcher batcher(_applier.get(), _buffer.get());
+
+    batcher.recordBatchApplied(10, Milliseconds(100));
+    ASSERT_EQUALS(5000U, batcher.getBatchLimitOps());
+}
+
+TEST_F(OplogApplierTest, AdaptiveBatchLimitTracksAverageApplyCost) {
+    RAIIServerParameterControllerForTest limitOps("replBatchLimitOperations", 5000);
+    RAIIServerParameterControllerForTest targetMillis("replBatchTargetApplyMillis", 1);
+    RAIIServerParameterControllerForTest minOps("replBatchAdaptiveMinOperations", 1);
+    OplogBatcher batcher(_applier.get(), _buffer.get());
+
+    // Nothing has been measured yet.
+    ASSERT_EQUALS(5000U, batcher.getBatchLimitOps());
+
+    // 1000ns per op, so 1000 ops fit in 1ms.
+    batcher.recordBatchApplied(100, Microseconds(100));
+    ASSERT_EQUALS(1000U, batcher.getBatchLimitOps());
+
+    // A batch at 5000ns per op moves the average a quarter of the way: (3 * 1000 + 5000) / 4.
+    batcher.recordBatchApplied(100, Microseconds(500));
+    ASSERT_EQUALS(500U, batcher.getBatchLimitOps());
+
+    // Empty batches carry no information.
+    batcher.recordBatchApplied(0, Seconds(1));
+    ASSERT_EQUALS(500U, batcher.getBatchLimitOps());
+
+    // Cheap operations never lift the limit above replBatchLimitOperations.
+    for (int i = 0; i < 20; ++i) {
+        batcher.recordBatchApplied(1000, Microseconds(1));
+    }
+    ASSERT_EQUALS(5000U, batcher.getBatchLimitOps());
+}
+
+TEST_F(OplogApplierTest, AdaptiveBatchLimitDoesNotGoBelowMinimum) {
+    RAIIServerParameterControllerForTest limitOps("replBatchLimitOperations", 5000);
+    RAIIServerParameterControllerForTest targetMillis("replBatchTargetApplyMillis", 1);
+    RAIIServerParameterControllerForTest minOps("replBatchAdaptiveMinOperations", 100);
+    OplogBatcher batcher(_applier.get(), _buffer.get());
+
+    // 100ms per op would allow no operations at all within the target.
+    batcher.recordBatchApplied(10, Seconds(1));
+    ASSERT_EQUALS(100U, batcher.getBatchLimitOps());
+
+    // replBatchLimitOperations still caps the floor.
+    RAIIServerParameterControllerForTest lowLimitOps("replBatchLimitOperations", 50);
+    ASSERT_EQUALS(50U, batcher.getBatchLimitOps());
+}
+
 class OplogApplierDelayTest : public OplogApplierTest, public ScopedGlobalServiceContextForTest {
 public:
     void setUp() override {
@@ -31,7 +31,10 @@
 
 #include "mongo/db/repl/oplog_batcher.h"
 
+#include <algorithm>
+
 #include "mongo/db/catalog_raii.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/commands/txn_cmds_gen.h"
 #include "mongo/db/repl/oplog_applier.h"
 #include "mongo/db/repl/repl_server_parameters_gen.h"
@@ -42,6 +45,23 @@ namespace repl {
 MONGO_FAIL_POINT_DEFINE(skipOplogBatcherWaitForData);
 MONGO_FAIL_POINT_DEFINE(oplogBatcherPauseAfterSuccessfulPeek);
 
+namespace {
+// Last values used by adaptive batch sizing, for serverStatus.
+AtomicWord<long long> adaptiveApplyNanosPerOp{0};
+AtomicWord<long long> adaptiveBatchLimitOps{0};
+
+class AdaptiveBatchSizeSSM : public ServerStatusMetric {
+public:
+    AdaptiveBatchSizeSSM() : ServerStatusMetric("repl.batcher.adaptive") {}
+    void appendAtLeaf(BSONObjBuilder& b) const override {
+        BSONObjBuilder sub(b.subobjStart(_leafName));
+        sub.append("targetApplyMillis", replBatchTargetApplyMillis.load());
+        sub.append("applyNanosPerOp", adaptiveApplyNanosPerOp.load());
+        sub.append("batchLimitOps", adaptiveBatchLimitOps.load());
+    }
+} adaptiveBatchSizeSSM;
+}  // namespace
+
 OplogBatcher::OplogBatcher(OplogApplier* oplogApplier, OplogBuffer* oplogBuffer)
     : _oplogApplier(oplogApplier), _oplogBuffer(oplogBuffer), _ops(0) {}
 OplogBatcher::~OplogBatcher() {
@@ -71,6 +91,31 @@ OplogBatch OplogBatcher::getNextBatch(Seconds maxWaitTime) {
     return ops;
 }
 
+void OplogBatcher::recordBatchApplied(std::size_t numOps, Microseconds elapsed) {
+    if (numOps == 0) {
+        return;
+    }
+    auto sample = durationCount<Nanoseconds>(elapsed) / static_cast<long long>(numOps);
+    auto previous = _applyNanosPerOp.load();
+    // Weight the newest batch by 1/4 so that a single outlier batch does not swing the batch size.
+    auto average = previous == 0 ? sample : (previous * 3 + sample) / 4;
+    _applyNanosPerOp.store(std::max(average, 1LL));
+    adaptiveApplyNanosPerOp.store(average);
+}
+
+std::size_t OplogBatcher::getBatchLimitOps() const {
+    auto limit = getBatchLimitOplogEntries();
+    auto targetMillis = replBatchTargetApplyMillis.load();
+    auto nanosPerOp = _applyNanosPerOp.load();
+    if (targetMillis > 0 && nanosPerOp > 0) {
+        auto targetNanos = durationCount<Nanoseconds>(Milliseconds(targetMillis));
+        auto minOps = std::min(std::size_t(replBatchAdaptiveMinOperations.load()), limit);
+        limit = std::clamp(std::size_t(targetNanos / nanosPerOp), minOps, limit);
+    }
+    adaptiveBatchLimitOps.store(static_cast<long long>(limit));
+    return limit;
+}
+
 void OplogBatcher::startup(StorageInterface* storageInterface) {
     _thread = std::make_unique<stdx::thread>([this, storageInterface] { _run(storageInterface); });
 }
@@ -289,7 +334,7 @@ void OplogBatcher::_run(StorageInterface* storageInterface) {
             _calculateSecondaryDelaySecsLatestTimestamp();
 
         // Check the limits once per batch since users can change them at runtime.
-        batchLimits.ops = getBatchLimitOplogEntries();
+        batchLimits.ops = getBatchLimitOps();
 
         // Use the OplogBuffer to populate a local OplogBatch. Note that the buffer may be empty.
         OplogBatch ops(batchLimits.ops);
@@ -320,8 +365,10 @@ void OplogBatcher::_run(StorageInterface* storageInterface) {
             auto oplogEntries = fassertNoTrace(
                 31004,
                 getNextApplierBatch(opCtx.get(), batchLimits, Milliseconds(oplogBatchDelayMillis)));
-            for (const auto& oplogEntry : oplogEntries) {
-                ops.emplace_back(oplogEntry);
+            // Move the entries rather than copying them: each OplogEntry owns its parsed
+            // fields, and the raw BSON is shared with the oplog buffer.
+            for (auto& oplogEntry : oplogEntries) {
+                ops.emplace_back(std::move(oplogEntry));
             }
         } catch (const ExceptionForCat<ErrorCategory::Interruption>& e) {
             LOGV2_DEBUG(6133400,
@@ -32,8 +32,10 @@
 #include "mongo/db/repl/oplog_buffer.h"
 #include "mongo/db/repl/oplog_entry.h"
 #include "mongo/db/repl/storage_interface.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/duration.h"
 #include "mongo/util/fail_point.h"
 
 namespace mongo {
@@ -180,6 +182,20 @@ public:
         const BatchLimits& batchLimits,
         Milliseconds waitToFillBatch = Milliseconds(0));
 
+    /**
+     * Reports that a batch of 'numOps' operations produced by this batcher took 'elapsed' to
+     * apply. When 'replBatchTargetApplyMillis' is set, the per-operation cost derived from these
+     * reports sizes subsequent batches.
+     */
+    void recordBatchApplied(std::size_t numOps, Microseconds elapsed);
+
+    /**
+     * Returns the maximum number of operations for the next batch: replBatchLimitOperations,
+     * lowered to hit 'replBatchTargetApplyMillis' when adaptive batch sizing is enabled, but never
+     * below 'replBatchAdaptiveMinOperations'.
+     */
+    std::size_t getBatchLimitOps() const;
+
     /**
      * Helper method indicating that this oplog entry must be in a batch of its own.
      */
@@ -218,6 +234,10 @@ private:
     OplogBatch _ops;
 
     std::unique_ptr<stdx::thread> _thread;
+
+    // Exponentially weighted moving average of the time to apply one operation, in nanoseconds.
+    // Written by the applier thread and read by the batcher thread. 0 until a batch is recorded.
+    AtomicWord<long long> _applyNanosPerOp{0};
 };
 
 /**
@@ -0,0 +1,264 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/db/repl/drop_pending_collection_reaper.h"
+#include "mongo/db/repl/oplog.h"
+#include "mongo/db/repl/oplog_applier_impl.h"
+#include "mongo/db/repl/oplog_entry_test_helpers.h"
+#include "mongo/db/repl/replication_consistency_markers_mock.h"
+#include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/db/repl/storage_interface_impl.h"
+#include "mongo/db/service_context_d_bm_fixture.h"
+#include "mongo/db/vector_clock_mutable.h"
+#include "mongo/util/concurrency/thread_pool.h"
+
+namespace mongo {
+namespace repl {
+namespace {
+
+const int kBatchSize = 1000;
+const int kManyCollections = 64;
+const NamespaceString kAdminCmdNss("admin.$cmd");
+
+enum class Workload : int64_t {
+    kInsertsFewCollections,
+    kInsertsManyCollections,
+    kUpdatesUniqueIndex,
+    kDeletes,
+    kApplyOps,
+};
+
+/**
+ * Sets up a ServiceContext backed by an ephemeral WiredTiger instance along with the replication
+ * services OplogApplierImpl needs, mirroring OplogApplierImplTest but usable outside of a unit
+ * test. Every collection has a unique secondary index on 'u' so that updates and inserts pay for
+ * index maintenance as they would in a typical deployment.
+ */
+class ReplApplyBenchmarkFixture : public ServiceContextMongoDBenchmarkFixture {
+public:
+    ReplApplyBenchmarkFixture(int numCollections, int numWriterThreads) {
+        auto service = getServiceContext();
+        _opCtx = makeOperationContext();
+
+        StorageInterface::set(service, std::make_unique<StorageInterfaceImpl>());
+        DropPendingCollectionReaper::set(
+            service, std::make_unique<DropPendingCollectionReaper>(StorageInterface::get(service)));
+        VectorClockMutable::get(_opCtx.get())->tickClusterTimeTo(LogicalTime(Timestamp(1, 0)));
+
+        auto storageInterface = StorageInterface::get(service);
+        for (int i = 0; i < numCollections; ++i) {
+            _collections.emplace_back("repl_apply_bm", "coll" + std::to_string(i));
+            invariant(
+                storageInterface->createCollection(_opCtx.get(), _collections.back(), {}));
+            invariant(storageInterface->createIndexesOnEmptyCollection(
+                _opCtx.get(),
+                _collections.back(),
+                {BSON("v" << 2 << "key" << BSON("u" << 1) << "name"
+                          << "u_1"
+                          << "unique" << true)}));
+        }
+
+        _writerPool = makeReplWriterPool(numWriterThreads);
+        _applier = std::make_unique<OplogApplierImpl>(
+            nullptr,  // executor
+            nullptr,  // oplogBuffer
+            &noopOplogApplierObserver,
+            ReplicationCoordinator::get(service),
+            &_consistencyMarkers,
+            storageInterface,
+            OplogApplier::Options(OplogApplication::Mode::kSecondary),
+            _writerPool.get());
+    }
+
+    ~ReplApplyBenchmarkFixture() {
+        _applier.reset();
+        _writerPool->shutdown();
+        _writerPool->join();
+        _opCtx.reset();
+        DropPendingCollectionReaper::set(getServiceContext(), {});
+        StorageInterface::set(getServiceContext(), {});
+    }
+
+    /**
+     * Generates the next batch for 'workload'. Updates and deletes target documents that are
+     * inserted by an untimed batch first, so that every operation in the timed batch finds its
+     * document.
+     */
+    std::vector<OplogEntry> makeBatch(Workload workload) {
+        std::vector<OplogEntry> ops;
+        ops.reserve(kBatchSize);
+        switch (workload) {
+            case Workload::kInsertsFewCollections:
+            case Workload::kInsertsManyCollections:
+                for (int i = 0; i < kBatchSize; ++i) {
+                    ops.push_back(_makeInsert());
+                }
+                break;
+            case Workload::kUpdatesUniqueIndex:
+            case Workload::kDeletes: {
+                auto firstId = _nextId;
+                apply(makeBatch(Workload::kInsertsFewCollections));
+                for (int i = 0; i < kBatchSize; ++i) {
+                    auto id = firstId + i;
+                    const auto& nss = _collectionFor(id);
+                    if (workload == Workload::kDeletes) {
+                        ops.push_back(
+                            makeDeleteDocumentOplogEntry(_nextOpTime(), nss, BSON("_id" << id)));
+                    } else {
+                        ops.push_back(makeUpdateDocumentOplogEntry(
+                            _nextOpTime(),
+                            nss,
+                            BSON("_id" << id),
+                            BSON("_id" << id << "u" << -id << "x" << id)));
+                    }
+                }
+                break;
+            }
+            case Workload::kApplyOps: {
+                // Groups of ten inserts wrapped in a single applyOps command, the shape of an
+                // unprepared transaction's oplog entry.
+                const int kOpsPerApplyOps = 10;
+                for (int i = 0; i < kBatchSize / kOpsPerApplyOps; ++i) {
+                    BSONArrayBuilder applyOps;
+                    for (int j = 0; j < kOpsPerApplyOps; ++j) {
+                        auto id = _nextId++;
+                        applyOps.append(BSON("op"
+                                             << "i"
+                                             << "ns" << _collectionFor(id).ns() << "o"
+                                             << BSON("_id" << id << "u" << id)));
+                    }
+                    ops.push_back(makeCommandOplogEntry(
+                        _nextOpTime(), kAdminCmdNss, BSON("applyOps" << applyOps.arr())));
+                }
+                break;
+            }
+        }
+        return ops;
+    }
+
+    void apply(std::vector<OplogEntry> ops) {
+        uassertStatusOK(_applier->applyOplogBatch(_opCtx.get(), std::move(ops)));
+    }
+
+    void fillWriterVectors(std::vector<OplogEntry>* ops) {
+        std::vector<std::vector<const OplogEntry*>> writerVectors(
+            _writerPool->getStats().options.maxThreads);
+        std::vector<std::vector<OplogEntry>> derivedOps;
+        _applier->fillWriterVectors_forTest(_opCtx.get(), ops, &writerVectors, &derivedOps);
+        benchmark::DoNotOptimize(writerVectors.data());
+    }
+
+private:
+    OpTime _nextOpTime() {
+        return OpTime(Timestamp(Seconds(_lastSecond++), 0), 1LL);
+    }
+
+    const NamespaceString& _collectionFor(long long id) const {
+        return _collections[id % _collections.size()];
+    }
+
+    OplogEntry _makeInsert() {
+        auto id = _nextId++;
+        return makeInsertDocumentOplogEntry(
+            _nextOpTime(), _collectionFor(id), BSON("_id" << id << "u" << id));
+    }
+
+    ServiceContext::UniqueOperationContext _opCtx;
+    ReplicationConsistencyMarkersMock _consistencyMarkers;
+    std::vector<NamespaceString> _collections;
+    std::unique_ptr<ThreadPool> _writerPool;
+    std::unique_ptr<OplogApplierImpl> _applier;
+    long long _lastSecond = 2;
+    long long _nextId = 0;
+};
+
+int numCollectionsFor(Workload workload) {
+    return workload == Workload::kInsertsFewCollections ? 1 : kManyCollections;
+}
+
+/**
+ * Measures OplogApplierImpl::applyOplogBatch end to end: the oplog writes, the writer vector
+ * partitioning and the parallel application on the writer pool. Items processed are oplog entries,
+ * so the reported rate is the applier's throughput in ops per second.
+ */
+void BM_ApplyOplogBatch(benchmark::State& state) {
+    const auto workload = static_cast<Workload>(state.range(0));
+    ReplApplyBenchmarkFixture fixture(numCollectionsFor(workload), state.range(1));
+
+    for (auto keepRunning : state) {
+        state.PauseTiming();
+        auto ops = fixture.makeBatch(workload);
+        state.ResumeTiming();
+
+        fixture.apply(std::move(ops));
+    }
+    state.SetItemsProcessed(state.iterations() * kBatchSize);
+}
+
+/**
+ * Measures only the partitioning of a batch into writer vectors, which runs on the applier thread
+ * while the writer pool is writing the batch to the oplog.
+ */
+void BM_FillWriterVectors(benchmark::State& state) {
+    const auto workload = static_cast<Workload>(state.range(0));
+    ReplApplyBenchmarkFixture fixture(numCollectionsFor(workload), state.range(1));
+
+    for (auto keepRunning : state) {
+        state.PauseTiming();
+        auto ops = fixture.makeBatch(workload);
+        state.ResumeTiming();
+
+        fixture.fillWriterVectors(&ops);
+    }
+    state.SetItemsProcessed(state.iterations() * kBatchSize);
+}
+
+void workloadAndThreadArgs(benchmark::internal::Benchmark* b) {
+    for (auto workload : {Workload::kInsertsFewCollections,
+                          Workload::kInsertsManyCollections,
+                          Workload::kUpdatesUniqueIndex,
+                          Workload::kDeletes,
+                          Workload::kApplyOps}) {
+        for (int64_t numWriterThreads : {1, 4, 16}) {
+            b->Args({static_cast<int64_t>(workload), numWriterThreads});
+        }
+    }
+    b->ArgNames({"workload", "writers"});
+}
+
+BENCHMARK(BM_ApplyOplogBatch)->Apply(workloadAndThreadArgs)->UseRealTime();
+BENCHMARK(BM_FillWriterVectors)->Apply(workloadAndThreadArgs);
+
+}  // namespace
+}  // namespace repl
+}  // namespace mongo
@@ -5099,10 +5099,35 @@ ReplicationCoordinatorImpl::_setCurrentRSConfig(WithLock lk,
 }
 
 void ReplicationCoordinatorImpl::_wakeReadyWaiters(WithLock lk, boost::optional<OpTime> opTime) {
+    // Waiters are visited in OpTime order, and whether an OpTime-based write concern is satisfied
+    // is monotonic in the OpTime: once a write concern is not satisfied at some OpTime, it is not
+    // satisfied at any later one. Remember the write concerns that failed so that the waiters
+    // queued behind them skip the (comparatively expensive) check. With many concurrent writers
+    // sharing a handful of write concerns, this makes a wakeup cost one check per distinct write
+    // concern plus one per satisfied waiter.
+    std::vector<const WriteConcernOptions*> unsatisfied;
+    auto knownUnsatisfied = [&](const WriteConcernOptions& wc) {
+        if (wc.checkCondition != WriteConcernOptions::CheckCondition::OpTime) {
+            return false;
+        }
+        return std::any_of(unsatisfied.begin(), unsatisfied.end(), [&](const auto* other) {
+            return other->w == wc.w && other->syncMode == wc.syncMode &&
+                other->checkCondition == wc.checkCondition;
+        });
+    };
+
     _replicationWaiterList.setValueIf_inlock(
-        [this](const OpTime& opTime, const SharedWaiterHandle& waiter) {
+        [&](const OpTime& opTime, const SharedWaiterHandle& waiter) {
             invariant(waiter->writeConcern);
-            return _doneWaitingForReplication_inlock(opTime, waiter->writeConcern.get());
+            const auto& wc = waiter->writeConcern.get();
+            if (knownUnsatisfied(wc)) {
+                return false;
+            }
+            if (_doneWaitingForReplication_inlock(opTime, wc)) {
+                return true;
+            }
+            unsatisfied.push_back(&wc);
+            return false;
         },
         opTime);
 }
@@ -77,6 +77,9 @@ const auto kRecoveryOperationLogLevel = logv2::LogSeverity::Debug(3);
  */
 class RecoveryOplogApplierStats : public OplogApplier::Observer {
 public:
+    RecoveryOplogApplierStats(Timestamp startPoint, Timestamp endPoint)
+        : _startPoint(startPoint), _endPoint(endPoint) {}
+
     void onBatchBegin(const std::vector<OplogEntry>& batch) final {
         _numBatches++;
         LOGV2_FOR_RECOVERY(24098,
@@ -110,7 +113,34 @@ public:
         }
     }
 
-    void onBatchEnd(const StatusWith<OpTime>&, const std::vector<OplogEntry>&) final {}
+    void onBatchEnd(const StatusWith<OpTime>&, const std::vector<OplogEntry>& batch) final {
+        if (batch.empty() || _timer.elapsed() - _lastProgressLog < kProgressLogInterval) {
+            return;
+        }
+        _lastProgressLog = _timer.elapsed();
+
+        // Estimate the remaining time from how much of the oplog's wall clock range, in seconds,
+        // has been replayed so far. This assumes that the write rate was roughly uniform.
+        const auto lastTs = batch.back().getTimestamp();
+        const auto secsApplied = lastTs.getSecs() - _startPoint.getSecs();
+        const auto secsRemaining =
+            _endPoint.getSecs() > lastTs.getSecs() ? _endPoint.getSecs() - lastTs.getSecs() : 0;
+        const auto elapsed = duration_cast<Seconds>(_timer.elapsed());
+        boost::optional<Seconds> estimatedRemaining;
+        if (secsApplied > 0) {
+            estimatedRemaining = Seconds(durationCount<Seconds>(elapsed) * secsRemaining /
+                                         static_cast<long long>(secsApplied));
+        }
+
+        LOGV2(7027502,
+              "Recovery oplog application progress",
+              "numOpsApplied"_attr = _numOpsApplied,
+              "numBatches"_attr = _numBatches,
+              "lastAppliedTimestamp"_attr = lastTs,
+              "endPoint"_attr = _endPoint,
+              "elapsed"_attr = elapsed,
+              "estimatedRemaining"_attr = estimatedRemaining);
+    }
 
     void complete(const OpTime& applyThroughOpTime) const {
         LOGV2(21536,
@@ -123,6 +153,12 @@ public:
     }
 
 private:
+    static constexpr Seconds kProgressLogInterval{10};
+
+    const Timestamp _startPoint;
+    const Timestamp _endPoint;
+    Timer _timer;
+    Microseconds _lastProgressLog{0};
     std::size_t _numBatches = 0;
     std::size_t _numOpsApplied = 0;
 };
@@ -709,7 +745,7 @@ Timestamp ReplicationRecoveryImpl::_applyOplogOperations(OperationContext* opCtx
     OplogBufferLocalOplog oplogBuffer(startPoint, endPoint);
     oplogBuffer.startup(opCtx);
 
-    RecoveryOplogApplierStats stats;
+    RecoveryOplogApplierStats stats(startPoint, endPoint);
 
     auto oplogApplicationMode = (recoveryMode == RecoveryMode::kStartupFromStableTimestamp ||
                                  recoveryMode == RecoveryMode::kRollbackFromStableTimestamp)
@@ -708,17 +708,21 @@ void RollbackImpl::_correctRecordStoreCounts(OperationContext* opCtx) {
             invariant(coll == collToScan.getCollection(),
                       str::stream() << "Catalog returned invalid collection: " << nss.ns() << " ("
                                     << uuid.toString() << ")");
-            auto exec = collToScan->makePlanExecutor(opCtx,
-                                                     collToScan.getCollection(),
-                                                     PlanYieldPolicy::YieldPolicy::INTERRUPT_ONLY,
-                                                     Collection::ScanDirection::kForward);
+            // Only the number of records is needed, so walk the record store directly rather than
+            // through a collection scan plan, which would set up a working set member for every
+            // document. The cursor is not yielded but is interruptible, matching the INTERRUPT_ONLY
+            // policy used before.
             long long countFromScan = 0;
-            PlanExecutor::ExecState state;
-            while (PlanExecutor::ADVANCED ==
-                   (state = exec->getNext(static_cast<BSONObj*>(nullptr), nullptr))) {
-                ++countFromScan;
-            }
-            if (PlanExecutor::IS_EOF != state) {
+            try {
+                auto cursor = collToScan->getRecordStore()->getCursor(opCtx, true /* forward */);
+                while (cursor->next()) {
+                    ++countFromScan;
+                    opCtx->checkForInterrupt();
+                }
+            } catch (const ExceptionForCat<ErrorCategory::Interruption>&) {
+                // Rollback must stop when it is interrupted, e.g. at shutdown.
+                throw;
+            } catch (const DBException& ex) {
                 // We ignore errors here because crashing or leaving rollback would only leave
                 // collection counts more inaccurate.
                 LOGV2_WARNING(21637,
@@ -728,7 +732,7 @@ void RollbackImpl::_correctRecordStoreCounts(OperationContext* opCtx) {
                               "namespace"_attr = nss.ns(),
                               "uuid"_attr = uuid.toString(),
                               "ident"_attr = ident,
-                              "error"_attr = exec->stateToStr(state));
+                              "error"_attr = ex.toStatus());
                 continue;
             }
             newCount = countFromScan;
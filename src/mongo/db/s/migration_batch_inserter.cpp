@@ -31,10 +31,13 @@
 
 #include "mongo/db/s/migration_batch_inserter.h"
 
+#include <algorithm>
+
 #include "mongo/db/s/migration_util.h"
 #include "mongo/db/transaction_participant.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/concurrency/ticketholder.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 
@@ -48,6 +51,11 @@ void checkOutSessionAndVerifyTxnState(OperationContext* opCtx) {
                                                        boost::none /* startTransaction */);
 }
 
+// Converts 'bytes' to the number of microseconds they take at 'bytesPerSec'.
+long long bytesToMicros(long long bytes, long long bytesPerSec) {
+    return static_cast<long long>(static_cast<double>(bytes) * 1000 * 1000 / bytesPerSec);
+}
+
 template <typename Callable>
 constexpr bool returnsVoid() {
     return std::is_void_v<std::invoke_result_t<Callable>>;
@@ -82,6 +90,46 @@ void runWithoutSession(OperationContext* opCtx, Callable callable) {
 }  // namespace
 
 
+MigrationCloneInsertionBandwidth& MigrationCloneInsertionBandwidth::get() {
+    static MigrationCloneInsertionBandwidth bandwidth;
+    return bandwidth;
+}
+
+Microseconds MigrationCloneInsertionBandwidth::reserve(long long batchBytes,
+                                                       long long maxBytesPerSec,
+                                                       long long nowMicros) {
+    stdx::lock_guard lk(_mutex);
+    if (maxBytesPerSec <= 0) {
+        _nextAllowedMicros = 0;
+        return Microseconds(0);
+    }
+
+    // Re-price the reserved but not yet started bytes at the current limit when it is higher than
+    // the one they were reserved at, so a backlog built up under a lower limit does not keep
+    // inserters waiting for longer than the current limit calls for.
+    if (_nextAllowedMicros > nowMicros && _reservedAtBytesPerSec < maxBytesPerSec) {
+        const auto backlogBytes =
+            static_cast<double>(_nextAllowedMicros - nowMicros) * _reservedAtBytesPerSec;
+        _nextAllowedMicros = nowMicros + static_cast<long long>(backlogBytes / maxBytesPerSec);
+    }
+    _reservedAtBytesPerSec = maxBytesPerSec;
+
+    const auto start = std::max(_nextAllowedMicros, nowMicros);
+    _nextAllowedMicros = start + bytesToMicros(batchBytes, maxBytesPerSec);
+    return Microseconds(start - nowMicros);
+}
+
+void MigrationCloneInsertionBandwidth::reset() {
+    stdx::lock_guard lk(_mutex);
+    _nextAllowedMicros = 0;
+    _reservedAtBytesPerSec = 0;
+}
+
+Status onUpdateMigrateCloneInsertionMaxBytesPerSec(const long long&) {
+    MigrationCloneInsertionBandwidth::get().reset();
+    return Status::OK();
+}
+
 void MigrationBatchInserter::onCreateThread(const std::string& threadName) {
     Client::initThread(threadName, getGlobalServiceContext(), nullptr);
     {
@@ -198,6 +246,14 @@ void MigrationBatchInserter::run(Status status) const try {
             }
         }
 
+        if (auto wait = MigrationCloneInsertionBandwidth::get().reserve(
+                batchClonedBytes,
+                migrateCloneInsertionMaxBytesPerSec.load(),
+                static_cast<long long>(curTimeMicros64()));
+            wait > Microseconds(0)) {
+            opCtx->sleepFor(wait);
+        }
+
         sleepmillis(migrateCloneInsertionBatchDelayMS.load());
     }
 } catch (const DBException& e) {
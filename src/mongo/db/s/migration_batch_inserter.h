@@ -87,6 +87,32 @@ public:
     }
 };
 
+// Paces the insertion of cloned documents by all the incoming migrations of this node, so that
+// together they insert at most migrateCloneInsertionMaxBytesPerSec bytes per second. Each batch
+// reserves a slot after the slots of the batches before it, and waits until that slot begins.
+class MigrationCloneInsertionBandwidth {
+public:
+    // The instance shared by all inserter threads of all migrations.
+    static MigrationCloneInsertionBandwidth& get();
+
+    // Reserves 'batchBytes' of the budget at a limit of 'maxBytesPerSec' and returns how long the
+    // caller must wait, from 'nowMicros', before it may insert its batch. A limit of zero or less
+    // means no limit.
+    Microseconds reserve(long long batchBytes, long long maxBytesPerSec, long long nowMicros);
+
+    // Drops all the outstanding reservations.
+    void reset();
+
+private:
+    Mutex _mutex = MONGO_MAKE_LATCH("MigrationCloneInsertionBandwidth::_mutex");
+
+    // Time, in microseconds since the epoch, at which the last reservation ends.
+    long long _nextAllowedMicros = 0;
+
+    // The limit at which the outstanding reservations were priced.
+    long long _reservedAtBytesPerSec = 0;
+};
+
 // This type contains a BSONObj _batch corresponding to a _migrateClone response.
 // The purpose of this type is to perform the insertions for this batch.
 // Those insertions happen in its "run" method.  The MigrationBatchFetcher
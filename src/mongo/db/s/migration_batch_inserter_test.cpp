@@ -0,0 +1,104 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/s/migration_batch_inserter.h"
+
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+constexpr long long kStartMicros = 1000 * 1000;
+
+TEST(MigrationCloneInsertionBandwidth, NoLimitNeverWaits) {
+    MigrationCloneInsertionBandwidth bandwidth;
+    ASSERT_EQ(bandwidth.reserve(1024 * 1024, 0, kStartMicros), Microseconds(0));
+    ASSERT_EQ(bandwidth.reserve(1024 * 1024, 0, kStartMicros), Microseconds(0));
+}
+
+TEST(MigrationCloneInsertionBandwidth, ReservationsQueueBehindEachOther) {
+    MigrationCloneInsertionBandwidth bandwidth;
+    ASSERT_EQ(bandwidth.reserve(500, 1000, kStartMicros), Microseconds(0));
+    ASSERT_EQ(bandwidth.reserve(500, 1000, kStartMicros), Milliseconds(500));
+    ASSERT_EQ(bandwidth.reserve(1000, 1000, kStartMicros), Seconds(1));
+    ASSERT_EQ(bandwidth.reserve(1000, 1000, kStartMicros + 1000 * 1000), Seconds(1));
+}
+
+TEST(MigrationCloneInsertionBandwidth, IdleTimeIsNotBanked) {
+    MigrationCloneInsertionBandwidth bandwidth;
+    ASSERT_EQ(bandwidth.reserve(100, 1000, kStartMicros), Microseconds(0));
+    ASSERT_EQ(bandwidth.reserve(100, 1000, kStartMicros + 10 * 1000 * 1000), Microseconds(0));
+    ASSERT_EQ(bandwidth.reserve(100, 1000, kStartMicros + 10 * 1000 * 1000), Milliseconds(100));
+}
+
+TEST(MigrationCloneInsertionBandwidth, RaisingTheLimitShrinksTheBacklog) {
+    MigrationCloneInsertionBandwidth bandwidth;
+    // At 1 byte per second the first batch holds the budget for the next 10 seconds.
+    ASSERT_EQ(bandwidth.reserve(10, 1, kStartMicros), Microseconds(0));
+    ASSERT_EQ(bandwidth.reserve(1, 1, kStartMicros), Seconds(10));
+
+    // At 1000 bytes per second the 11 bytes reserved before only take 11 milliseconds.
+    ASSERT_EQ(bandwidth.reserve(1000, 1000, kStartMicros), Milliseconds(11));
+    ASSERT_EQ(bandwidth.reserve(1000, 1000, kStartMicros), Milliseconds(1011));
+}
+
+TEST(MigrationCloneInsertionBandwidth, LoweringTheLimitKeepsTheBacklog) {
+    MigrationCloneInsertionBandwidth bandwidth;
+    ASSERT_EQ(bandwidth.reserve(1000, 1000, kStartMicros), Microseconds(0));
+    ASSERT_EQ(bandwidth.reserve(10, 10, kStartMicros), Seconds(1));
+    ASSERT_EQ(bandwidth.reserve(10, 10, kStartMicros), Seconds(2));
+}
+
+TEST(MigrationCloneInsertionBandwidth, ResetDropsTheBacklog) {
+    MigrationCloneInsertionBandwidth bandwidth;
+    ASSERT_EQ(bandwidth.reserve(10, 1, kStartMicros), Microseconds(0));
+    bandwidth.reset();
+    ASSERT_EQ(bandwidth.reserve(1, 1, kStartMicros), Microseconds(0));
+}
+
+TEST(MigrationCloneInsertionBandwidth, RemovingTheLimitDropsTheBacklog) {
+    MigrationCloneInsertionBandwidth bandwidth;
+    ASSERT_EQ(bandwidth.reserve(10, 1, kStartMicros), Microseconds(0));
+    ASSERT_EQ(bandwidth.reserve(1, 0, kStartMicros), Microseconds(0));
+    ASSERT_EQ(bandwidth.reserve(1, 1, kStartMicros), Microseconds(0));
+}
+
+TEST(MigrationCloneInsertionBandwidth, ChangingTheParameterResetsTheSharedBudget) {
+    auto& bandwidth = MigrationCloneInsertionBandwidth::get();
+    bandwidth.reset();
+    ASSERT_EQ(bandwidth.reserve(10, 1, kStartMicros), Microseconds(0));
+    ASSERT_OK(onUpdateMigrateCloneInsertionMaxBytesPerSec(1));
+    ASSERT_EQ(bandwidth.reserve(1, 1, kStartMicros), Microseconds(0));
+    bandwidth.reset();
+}
+
+}  // namespace
+}  // namespace mongo
@@ -42,6 +42,7 @@
 #include "mongo/logv2/log.h"
 #include "mongo/s/sharding_feature_flags_gen.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/cancellation.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/uuid.h"
 
@@ -133,19 +134,48 @@ SemiFuture<void> ReshardingOplogApplier::run(
     CancellationToken cancelToken,
     CancelableOperationContextFactory factory) {
     struct ChainContext {
+        explicit ChainContext(const CancellationToken& cancelToken)
+            : prefetchCancelSource(cancelToken) {}
+
         std::unique_ptr<ReshardingDonorOplogIteratorInterface> oplogIter;
+        // The next batch, fetched from the oplog buffer concurrently with applying the current one.
+        boost::optional<SharedSemiFuture<OplogBatch>> prefetchedBatch;
+        // Lets the prefetch stop waiting for more oplog entries once the applier has finished, even
+        // when it finished because of an error rather than because 'cancelToken' was canceled.
+        CancellationSource prefetchCancelSource;
     };
 
-    auto chainCtx = std::make_shared<ChainContext>();
+    auto chainCtx = std::make_shared<ChainContext>(cancelToken);
     chainCtx->oplogIter = std::move(_oplogIter);
 
     return AsyncTry([this, chainCtx, executor, cancelToken, factory] {
-               return chainCtx->oplogIter->getNextBatch(executor, cancelToken, factory)
+               auto nextBatch = [&] {
+                   if (auto prefetched = std::exchange(chainCtx->prefetchedBatch, boost::none)) {
+                       return prefetched->thenRunOn(executor);
+                   }
+                   return chainCtx->oplogIter->getNextBatch(executor, cancelToken, factory);
+               }();
+
+               return std::move(nextBatch)
                    .thenRunOn(executor)
-                   .then([this, executor, cancelToken, factory](OplogBatch batch) {
+                   .then([this, chainCtx, executor, cancelToken, factory](OplogBatch batch) {
                        LOGV2_DEBUG(5391002, 3, "Starting batch", "batchSize"_attr = batch.size());
                        _currentBatchToApply = std::move(batch);
 
+                       if (!_currentBatchToApply.empty()) {
+                           // Read the next batch out of the oplog buffer while this one is being
+                           // applied, so that the writer threads are not left idle between batches.
+                           auto oplogIter = chainCtx->oplogIter.get();
+                           auto prefetchToken = chainCtx->prefetchCancelSource.token();
+                           chainCtx->prefetchedBatch =
+                               ExecutorFuture<void>(executor)
+                                   .then([oplogIter, executor, prefetchToken, factory] {
+                                       return oplogIter->getNextBatch(
+                                           executor, prefetchToken, factory);
+                                   })
+                                   .share();
+                       }
+
                        return _applyBatch(executor, cancelToken, factory);
                    })
                    .then([this, executor, cancelToken, factory] {
@@ -183,6 +213,14 @@ SemiFuture<void> ReshardingOplogApplier::run(
         // RecipientStateMachine, along with its ReshardingOplogApplier member, may have already
         // been destructed.
         .onCompletion([chainCtx](Status status) {
+            if (chainCtx->prefetchedBatch) {
+                // The prefetch may still be reading from the oplog iterator, which must not be
+                // disposed of underneath it.
+                chainCtx->prefetchCancelSource.cancel();
+                chainCtx->prefetchedBatch->waitNoThrow().ignore();
+                chainCtx->prefetchedBatch.reset();
+            }
+
             if (chainCtx->oplogIter) {
                 // Use a separate Client to make a better effort of calling dispose() even when the
                 // CancellationToken has been canceled.
@@ -61,6 +61,7 @@
 #include "mongo/rpc/metadata/egress_metadata_hook_list.h"
 #include "mongo/s/catalog_cache_loader_mock.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/concurrency/notification.h"
 #include "mongo/util/str.h"
 #include "mongo/util/uuid.h"
 
@@ -84,6 +85,10 @@ public:
         // getNextBatch() doesn't already have an operation context.
         auto opCtx = factory.makeOperationContext(&cc());
 
+        if (++_numBatchesRequested == 2) {
+            _secondBatchRequested.set();
+        }
+
         return ExecutorFuture(std::move(executor)).then([this] {
             std::vector<repl::OplogEntry> ret;
 
@@ -107,10 +112,19 @@ public:
         _doThrow = true;
     }
 
+    /**
+     * Blocks until getNextBatch has been called a second time.
+     */
+    void waitForSecondBatchRequest() {
+        _secondBatchRequested.get();
+    }
+
 private:
     std::deque<repl::OplogEntry> _oplogToReturn;
     const size_t _batchSize;
     bool _doThrow{false};
+    AtomicWord<int> _numBatchesRequested{0};
+    Notification<void> _secondBatchRequested;
 };
 
 class ReshardingOplogApplierTest : public ShardingMongodTestFixture {
@@ -446,6 +460,51 @@ TEST_F(ReshardingOplogApplierTest, ApplyBasicCrud) {
     ASSERT_EQ(4, progressDoc->getNumEntriesApplied());
 }
 
+TEST_F(ReshardingOplogApplierTest, NextBatchIsFetchedWhileCurrentBatchIsApplied) {
+    std::deque<repl::OplogEntry> crudOps;
+    for (int i = 1; i <= 4; ++i) {
+        crudOps.push_back(makeOplog(repl::OpTime(Timestamp(4 + i, 3), 1),
+                                    repl::OpTypeEnum::kInsert,
+                                    BSON("_id" << i),
+                                    boost::none));
+    }
+
+    auto iterator = std::make_unique<OplogIteratorMock>(std::move(crudOps), 2 /* batchSize */);
+    auto iteratorPtr = iterator.get();
+    boost::optional<ReshardingOplogApplier> applier;
+    applier.emplace(makeApplierEnv(),
+                    sourceId(),
+                    oplogBufferNs(),
+                    appliedToNs(),
+                    stashCollections(),
+                    0U /* myStashIdx */,
+                    chunkManager(),
+                    std::move(iterator));
+
+    // Hold an exclusive lock on the output collection so the first batch cannot finish applying.
+    // The second batch can then only be requested by the prefetch.
+    boost::optional<AutoGetCollection> appliedToColl;
+    appliedToColl.emplace(operationContext(), appliedToNs(), MODE_X);
+
+    auto cancelToken = operationContext()->getCancellationToken();
+    CancelableOperationContextFactory factory(cancelToken, getCancelableOpCtxExecutor());
+    auto future = applier->run(getExecutor(), getExecutor(), cancelToken, factory);
+
+    iteratorPtr->waitForSecondBatchRequest();
+    appliedToColl.reset();
+    ASSERT_OK(future.getNoThrow());
+
+    DBDirectClient client(operationContext());
+    for (int i = 1; i <= 4; ++i) {
+        ASSERT_BSONOBJ_EQ(BSON("_id" << i), client.findOne(appliedToNs(), BSON("_id" << i)));
+    }
+
+    auto progressDoc = ReshardingOplogApplier::checkStoredProgress(operationContext(), sourceId());
+    ASSERT_TRUE(progressDoc);
+    ASSERT_EQ(Timestamp(8, 3), progressDoc->getProgress().getTs());
+    ASSERT_EQ(4, progressDoc->getNumEntriesApplied());
+}
+
 TEST_F(ReshardingOplogApplierTest, CanceledApplyingBatch) {
     std::deque<repl::OplogEntry> crudOps;
     crudOps.push_back(makeOplog(repl::OpTime(Timestamp(5, 3), 1),
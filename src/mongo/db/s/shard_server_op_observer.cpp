@@ -186,6 +186,10 @@ void incrementChunkOnInsertOrUpdate(OperationContext* opCtx,
     // Don't trigger chunk splits from inserts happening due to migration since
     // we don't necessarily own that chunk yet
     if (!fromMigrate) {
+        // Migration inserts are not client load, so only count the writes which reflect how hot
+        // the range is.
+        chunkWritesTracker->addWriteOps(1);
+
         const auto balancerConfig = Grid::get(opCtx)->getBalancerConfiguration();
 
         const uint64_t maxChunkSizeBytes = [&] {
@@ -69,4 +69,9 @@ inline Status validateChunkMigrationFetcherMaxBufferedSizeBytesPerThread(const i
     return Status::OK();
 }
 
+/**
+ * Drops the reservations made under the previous value of migrateCloneInsertionMaxBytesPerSec.
+ */
+Status onUpdateMigrateCloneInsertionMaxBytesPerSec(const long long&);
+
 }  // namespace mongo
@@ -104,7 +104,7 @@ ServiceContext::ServiceContext()
 
 
 ServiceContext::~ServiceContext() {
-    stdx::lock_guard<Latch> lk(_mutex);
+    stdx::lock_guard<Latch> lk(_clientsMutex);
     for (const auto& client : _clients) {
         LOGV2_ERROR(23828,
                     "{client} exists while destroying {serviceContext}",
@@ -172,7 +172,7 @@ ServiceContext::UniqueClient ServiceContext::makeClient(std::string desc,
     std::unique_ptr<Client> client(new Client(std::move(desc), this, std::move(session)));
     onCreate(client.get(), _clientObservers);
     {
-        stdx::lock_guard<Latch> lk(_mutex);
+        stdx::lock_guard<Latch> lk(_clientsMutex);
         invariant(_clients.insert(client.get()).second);
     }
     return UniqueClient(client.release());
@@ -228,7 +228,7 @@ void ServiceContext::setTransportLayer(std::unique_ptr<transport::TransportLayer
 void ServiceContext::ClientDeleter::operator()(Client* client) const {
     ServiceContext* const service = client->getServiceContext();
     {
-        stdx::lock_guard<Latch> lk(service->_mutex);
+        stdx::lock_guard<Latch> lk(service->_clientsMutex);
         invariant(service->_clients.erase(client));
     }
     onDestroy(client, service->_clientObservers);
@@ -329,7 +329,9 @@ void ServiceContext::registerClientObserver(std::unique_ptr<ClientObserver> obse
 }
 
 ServiceContext::LockedClientsCursor::LockedClientsCursor(ServiceContext* service)
-    : _lock(service->_mutex), _curr(service->_clients.cbegin()), _end(service->_clients.cend()) {}
+    : _lock(service->_clientsMutex),
+      _curr(service->_clients.cbegin()),
+      _end(service->_clients.cend()) {}
 
 Client* ServiceContext::LockedClientsCursor::next() {
     if (_curr == _end)
@@ -347,6 +349,7 @@ void ServiceContext::setKillAllOperations(const std::set<std::string>& excludedC
     auto opsKilled = 0;
 
     // Interrupt all active operations
+    stdx::unique_lock<Latch> clientsLock(_clientsMutex);
     for (auto&& client : _clients) {
         stdx::lock_guard<Client> lk(*client);
 
@@ -361,6 +364,7 @@ void ServiceContext::setKillAllOperations(const std::set<std::string>& excludedC
             opsKilled++;
         }
     }
+    clientsLock.unlock();
 
     // Shared by mongos and mongod shutdown code paths
     LOGV2(4695300, "Interrupted all currently running operations", "opsKilled"_attr = opsKilled);
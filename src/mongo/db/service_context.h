@@ -714,6 +714,15 @@ private:
      * Vector of registered observers.
      */
     std::vector<ClientObserverHolder> _clientObservers;
+
+    /**
+     * The live Clients. This has its own mutex, separate from _mutex, so that client churn and
+     * walks over all clients (e.g. currentOp) do not serialize operation context creation and
+     * destruction, which only need _mutex for _clientByOperationId.
+     *
+     * If both are needed, _mutex must be acquired before _clientsMutex.
+     */
+    Mutex _clientsMutex = MONGO_MAKE_LATCH("ServiceContext::_clientsMutex");
     ClientSet _clients;
 
     /**
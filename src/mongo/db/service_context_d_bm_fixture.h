@@ -0,0 +1,62 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include "mongo/db/service_context_d_test_fixture.h"
+
+namespace mongo {
+
+/**
+ * Base class for benchmarks which run operations through a mongod-like ServiceContext on an
+ * ephemeral storage engine, so that they take the same command, replication and storage paths as
+ * in a server. The node is a replica set primary on the latest FCV, and has an oplog.
+ */
+class ServiceContextMongoDBenchmarkFixture : public ServiceContextMongoDTest {
+public:
+    /**
+     * Returns the instance of 'Fixture' shared by every benchmark and every benchmark thread in
+     * the binary. The first call creates it, and must happen on the main thread, whose Client then
+     * belongs to it. It is deliberately never destroyed.
+     */
+    template <typename Fixture>
+    static Fixture& getShared() {
+        static auto fixture = new Fixture();
+        return *fixture;
+    }
+
+protected:
+    ServiceContextMongoDBenchmarkFixture();
+    ~ServiceContextMongoDBenchmarkFixture();
+
+private:
+    void _doTest() override {}
+};
+
+}  // namespace mongo
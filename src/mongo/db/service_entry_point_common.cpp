@@ -1875,9 +1875,10 @@ void ExecCommandDatabase::_handleFailure(Status status) {
 }
 
 /**
- * Fills out CurOp / OpDebug with basic command info.
+ * Fills out CurOp / OpDebug with basic command info, including the logical op if the command was
+ * found. Everything is published under a single acquisition of the Client lock.
  */
-void curOpCommandSetup(OperationContext* opCtx, const OpMsgRequest& request) {
+void curOpCommandSetup(OperationContext* opCtx, const OpMsgRequest& request, const Command* c) {
     auto curop = CurOp::get(opCtx);
     curop->debug().iscommand = true;
 
@@ -1889,6 +1890,9 @@ void curOpCommandSetup(OperationContext* opCtx, const OpMsgRequest& request) {
     curop->setOpDescription_inlock(request.body);
     curop->markCommand_inlock();
     curop->setNS_inlock(nss.ns());
+    if (c) {
+        curop->setLogicalOp_inlock(c->getLogicalOp());
+    }
 }
 
 Future<void> parseCommand(std::shared_ptr<HandleRequest::ExecutionContext> execContext) try {
@@ -1924,14 +1928,14 @@ Future<void> executeCommand(std::shared_ptr<HandleRequest::ExecutionContext> exe
                 // Prepare environment for command execution (e.g., find command object in registry)
                 auto opCtx = execContext->getOpCtx();
                 auto& request = execContext->getRequest();
-                curOpCommandSetup(opCtx, request);
+                execContext->setCommand(CommandHelpers::findCommand(request.getCommandName()));
+                curOpCommandSetup(opCtx, request, execContext->getCommand());
 
                 // In the absence of a Command object, no redaction is possible. Therefore to avoid
                 // displaying potentially sensitive information in the logs, we restrict the log
                 // message to the name of the unrecognized command. However, the complete command
                 // object will still be echoed to the client.
-                if (execContext->setCommand(CommandHelpers::findCommand(request.getCommandName()));
-                    !execContext->getCommand()) {
+                if (!execContext->getCommand()) {
                     globalCommandRegistry()->incrementUnknownCommands();
                     LOGV2_DEBUG(21964,
                                 2,
@@ -1955,13 +1959,6 @@ Future<void> executeCommand(std::shared_ptr<HandleRequest::ExecutionContext> exe
                     "commandArgs"_attr = redact(
                         ServiceEntryPointCommon::getRedactedCopyForLogging(c, request.body)));
 
-                {
-                    // Try to set this as early as possible, as soon as we have figured out the
-                    // command.
-                    stdx::lock_guard<Client> lk(*opCtx->getClient());
-                    CurOp::get(opCtx)->setLogicalOp_inlock(c->getLogicalOp());
-                }
-
                 opCtx->setExhaust(
                     OpMsg::isFlagSet(execContext->getMessage(), OpMsg::kExhaustSupported));
 
@@ -2239,7 +2236,8 @@ void HandleRequest::completeOperation(DbResponse& response) {
         .incrementGlobalLatencyStats(
             opCtx,
             durationCount<Microseconds>(currentOp.elapsedTimeExcludingPauses()),
-            currentOp.getReadWriteType());
+            currentOp.getReadWriteType(),
+            currentOp.getCommand());
 
     if (shouldProfile) {
         // Performance profiling is on
@@ -312,8 +312,12 @@ void SessionCatalog::_releaseSession(SessionRuntimeInfo* sri,
     stdx::unique_lock<Latch> ul(_mutex);
 
     // Make sure we have exactly the same session on the map and that it is still associated with an
-    // operation context (meaning checked-out)
-    invariant(_sessions[sri->parentSession.getSessionId()].get() == sri);
+    // operation context (meaning checked-out). The map lookup is only done in debug builds, since
+    // this runs under '_mutex' on every release of a checked-out session.
+    dassert([&] {
+        auto it = _sessions.find(sri->parentSession.getSessionId());
+        return it != _sessions.end() && it->second.get() == sri;
+    }());
     invariant(sri->checkoutOpCtx);
     if (killToken) {
         dassert(killToken->lsidToKill == session->getSessionId());
@@ -442,9 +442,7 @@ public:
             std::push_heap(_heap.begin(), _heap.end(), _greater);
 
             if (_greater(_current, _heap.front())) {
-                std::pop_heap(_heap.begin(), _heap.end(), _greater);
-                std::swap(_current, _heap.back());
-                std::push_heap(_heap.begin(), _heap.end(), _greater);
+                replaceTop();
             }
         } else {
             iter->closeSource();
@@ -491,13 +489,37 @@ public:
             _current = _heap.back();
             _heap.pop_back();
         } else if (!_heap.empty() && _greater(_current, _heap.front())) {
-            std::pop_heap(_heap.begin(), _heap.end(), _greater);
-            std::swap(_current, _heap.back());
-            std::push_heap(_heap.begin(), _heap.end(), _greater);
+            replaceTop();
         }
     }
 
 private:
+    /**
+     * Exchanges '_current' with the smallest stream in the heap, and sifts the former '_current'
+     * down from the root. This needs about half the comparisons of a pop followed by a push, which
+     * matters when merging many runs.
+     */
+    void replaceTop() {
+        std::swap(_current, _heap.front());
+
+        const size_t size = _heap.size();
+        size_t idx = 0;
+        while (true) {
+            size_t child = 2 * idx + 1;
+            if (child >= size) {
+                break;
+            }
+            if (child + 1 < size && _greater(_heap[child], _heap[child + 1])) {
+                ++child;
+            }
+            if (!_greater(_heap[idx], _heap[child])) {
+                break;
+            }
+            std::swap(_heap[idx], _heap[child]);
+            idx = child;
+        }
+    }
+
     /**
      * Data iterator over an Input stream.
      *
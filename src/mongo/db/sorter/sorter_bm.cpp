@@ -0,0 +1,256 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <numeric>
+
+#include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/exec/sbe/values/slot.h"
+#include "mongo/db/sorter/sorter.h"
+#include "mongo/db/storage/key_string.h"
+#include "mongo/platform/random.h"
+#include "mongo/unittest/temp_dir.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Generates a new file name on each call using a static, atomic and monotonically increasing
+ * number. Each user of the Sorter must implement this function to ensure that all temporary files
+ * that the Sorter instances produce are uniquely identified using a unique file name extension
+ * with separate atomic variable.
+ */
+std::string nextFileName() {
+    static AtomicWord<unsigned> sorterBenchmarkFileCounter;
+    return "extsort-sorter-bm." + std::to_string(sorterBenchmarkFileCounter.fetchAndAdd(1));
+}
+
+}  // namespace
+}  // namespace mongo
+
+#include "mongo/db/sorter/sorter.cpp"
+
+namespace mongo {
+namespace {
+
+const int kNumItems = 100 * 1000;
+const std::string kPayload(64, 'x');
+
+/**
+ * Returns the integers [0, kNumItems) in a fixed pseudo-random order.
+ */
+std::vector<int> shuffledInts() {
+    std::vector<int> ints(kNumItems);
+    std::iota(ints.begin(), ints.end(), 0);
+    PseudoRandom random(1);
+    std::shuffle(ints.begin(), ints.end(), random.urbg());
+    return ints;
+}
+
+template <typename Key, typename Value>
+long long serializedSize(const std::vector<std::pair<Key, Value>>& input) {
+    long long size = 0;
+    for (auto&& [key, value] : input) {
+        BufBuilder buf;
+        key.serializeForSorter(buf);
+        value.serializeForSorter(buf);
+        size += buf.len();
+    }
+    return size;
+}
+
+/**
+ * Sorts 'input' with a memory limit of state.range(0) kilobytes, spilling to disk whenever the
+ * limit is hit, or entirely in memory if the limit is zero. Bytes processed are the serialized size
+ * of the input, and the spill counters are normalized by the same size so that changes to the
+ * merge or file format show up as bytes written per sorted byte.
+ */
+template <typename Key, typename Value, typename Comparator>
+void benchmarkSorter(benchmark::State& state,
+                     const std::vector<std::pair<Key, Value>>& input,
+                     const Comparator& comp,
+                     const typename Sorter<Key, Value>::Settings& settings) {
+    const size_t memoryLimitBytes = state.range(0) * 1024;
+    const auto inputBytes = serializedSize(input);
+
+    long long bytesSpilled = 0;
+    long long bytesSpilledUncompressed = 0;
+    for (auto keepRunning : state) {
+        unittest::TempDir tempDir("sorter_bm");
+        SorterFileStats fileStats(nullptr);
+        auto opts = SortOptions().TempDir(tempDir.path()).FileStats(&fileStats);
+        if (memoryLimitBytes) {
+            opts.MaxMemoryUsageBytes(memoryLimitBytes).ExtSortAllowed();
+        }
+
+        std::unique_ptr<Sorter<Key, Value>> sorter(Sorter<Key, Value>::make(opts, comp, settings));
+        for (auto&& [key, value] : input) {
+            sorter->add(key, value);
+        }
+        std::unique_ptr<SortIteratorInterface<Key, Value>> it(sorter->done());
+        while (it->more()) {
+            benchmark::DoNotOptimize(it->next());
+        }
+
+        bytesSpilled += fileStats.bytesSpilled.load();
+        bytesSpilledUncompressed += fileStats.bytesSpilledUncompressed.load();
+    }
+
+    const double sortedBytes = static_cast<double>(state.iterations() * inputBytes);
+    state.SetBytesProcessed(state.iterations() * inputBytes);
+    state.SetItemsProcessed(state.iterations() * input.size());
+    state.counters["spilledPerSortedByte"] = bytesSpilled / sortedBytes;
+    state.counters["spilledUncompressedPerSortedByte"] = bytesSpilledUncompressed / sortedBytes;
+}
+
+void BM_SortKeyString(benchmark::State& state) {
+    std::vector<std::pair<KeyString::Value, NullValue>> input;
+    for (auto i : shuffledInts()) {
+        KeyString::Builder builder(
+            KeyString::Version::V1, BSON("" << i << "" << kPayload), KeyString::ALL_ASCENDING);
+        input.emplace_back(builder.getValueCopy(), NullValue());
+    }
+    benchmarkSorter(
+        state,
+        input,
+        [](const auto& lhs, const auto& rhs) { return lhs.first.compare(rhs.first); },
+        {KeyString::Version::V1, {}});
+}
+
+void BM_SortBSONObj(benchmark::State& state) {
+    std::vector<std::pair<BSONObj, BSONObj>> input;
+    for (auto i : shuffledInts()) {
+        input.emplace_back(BSON("" << i), BSON("_id" << i << "payload" << kPayload));
+    }
+    benchmarkSorter(
+        state,
+        input,
+        [](const auto& lhs, const auto& rhs) { return lhs.first.woCompare(rhs.first); },
+        {});
+}
+
+void BM_SortMaterializedRow(benchmark::State& state) {
+    using sbe::value::MaterializedRow;
+    std::vector<std::pair<MaterializedRow, MaterializedRow>> input;
+    for (auto i : shuffledInts()) {
+        MaterializedRow key{1};
+        key.reset(0, false, sbe::value::TypeTags::NumberInt64, sbe::value::bitcastFrom<int64_t>(i));
+        MaterializedRow value{1};
+        auto [tag, val] = sbe::value::makeNewString(kPayload);
+        value.reset(0, true, tag, val);
+        input.emplace_back(std::move(key), std::move(value));
+    }
+    benchmarkSorter(
+        state,
+        input,
+        [](const auto& lhs, const auto& rhs) {
+            auto [lhsTag, lhsVal] = lhs.first.getViewOfValue(0);
+            auto [rhsTag, rhsVal] = rhs.first.getViewOfValue(0);
+            auto [tag, val] = sbe::value::compareValue(lhsTag, lhsVal, rhsTag, rhsVal);
+            return sbe::value::bitcastTo<int32_t>(val);
+        },
+        {});
+}
+
+// The BoundedSorter is fed input that is out of order by at most 'kBoundedSortWindow' keys, which
+// is how $_internalBoundedSort sees time-series buckets read in control.min order.
+const int kBoundedSortWindow = 1000;
+
+struct BoundedCompare {
+    int operator()(const BSONObj& lhs, const BSONObj& rhs) const {
+        return lhs.woCompare(rhs);
+    }
+};
+
+struct BoundedBoundMaker {
+    BSONObj operator()(const BSONObj& key, const BSONObj&) const {
+        return BSON("" << key.firstElement().numberLong() - kBoundedSortWindow);
+    }
+    Document serialize() const {
+        MONGO_UNREACHABLE;
+    }
+};
+
+using BenchmarkBoundedSorter = BoundedSorter<BSONObj, BSONObj, BoundedCompare, BoundedBoundMaker>;
+
+void BM_BoundedSortBSONObj(benchmark::State& state) {
+    std::vector<std::pair<BSONObj, BSONObj>> input;
+    PseudoRandom random(1);
+    for (long long i = 0; i < kNumItems; ++i) {
+        auto key = i + random.nextInt32(kBoundedSortWindow);
+        input.emplace_back(BSON("" << key), BSON("_id" << i << "payload" << kPayload));
+    }
+    const size_t memoryLimitBytes = state.range(0) * 1024;
+    const auto inputBytes = serializedSize(input);
+
+    long long bytesSpilled = 0;
+    for (auto keepRunning : state) {
+        unittest::TempDir tempDir("sorter_bm");
+        SorterFileStats fileStats(nullptr);
+        auto opts = SortOptions().TempDir(tempDir.path()).FileStats(&fileStats);
+        if (memoryLimitBytes) {
+            opts.MaxMemoryUsageBytes(memoryLimitBytes).ExtSortAllowed();
+        }
+
+        BenchmarkBoundedSorter sorter(opts, BoundedCompare(), BoundedBoundMaker());
+        for (auto&& [key, value] : input) {
+            sorter.add(key, value);
+            while (sorter.getState() == BenchmarkBoundedSorter::State::kReady) {
+                benchmark::DoNotOptimize(sorter.next());
+            }
+        }
+        sorter.done();
+        while (sorter.getState() == BenchmarkBoundedSorter::State::kReady) {
+            benchmark::DoNotOptimize(sorter.next());
+        }
+        bytesSpilled += fileStats.bytesSpilled.load();
+    }
+
+    state.SetBytesProcessed(state.iterations() * inputBytes);
+    state.SetItemsProcessed(state.iterations() * input.size());
+    state.counters["spilledPerSortedByte"] =
+        bytesSpilled / static_cast<double>(state.iterations() * inputBytes);
+}
+
+// Memory limits in kilobytes. Zero sorts entirely in memory; the others force one or many spills
+// for the ~10MB of input.
+void memoryLimitArgs(benchmark::internal::Benchmark* b) {
+    b->ArgName("memLimitKB")->Arg(0)->Arg(16 * 1024)->Arg(1024)->Arg(64);
+}
+
+BENCHMARK(BM_SortKeyString)->Apply(memoryLimitArgs);
+BENCHMARK(BM_SortBSONObj)->Apply(memoryLimitArgs);
+BENCHMARK(BM_SortMaterializedRow)->Apply(memoryLimitArgs);
+BENCHMARK(BM_BoundedSortBSONObj)->Apply(memoryLimitArgs);
+
+}  // namespace
+}  // namespace mongo
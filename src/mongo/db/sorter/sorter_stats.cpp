@@ -52,11 +52,13 @@ void SorterStats::setSpilledRanges(long long spills) {
 SorterFileStats::SorterFileStats(SorterTracker* sorterTracker) : _sorterTracker(sorterTracker){};
 
 void SorterFileStats::addSpilledDataSize(long long data) {
+    bytesSpilled.fetchAndAdd(data);
     if (_sorterTracker) {
         _sorterTracker->bytesSpilled.fetchAndAdd(data);
     }
 }
 void SorterFileStats::addSpilledDataSizeUncompressed(long long data) {
+    bytesSpilledUncompressed.fetchAndAdd(data);
     if (_sorterTracker) {
         _sorterTracker->bytesSpilledUncompressed.fetchAndAdd(data);
     }
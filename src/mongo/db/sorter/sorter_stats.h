@@ -50,6 +50,11 @@ public:
     AtomicWord<long long> opened;
     AtomicWord<long long> closed;
 
+    // The number of bytes written to the files, and the number of bytes that were written before
+    // compression.
+    AtomicWord<long long> bytesSpilled;
+    AtomicWord<long long> bytesSpilledUncompressed;
+
 private:
     SorterTracker* _sorterTracker;
 };
@@ -51,12 +51,20 @@ public:
         BSONObjBuilder latencyBuilder;
         bool includeHistograms = false;
         bool slowBuckets = false;
+        bool includePercentiles = false;
+        bool includeCommands = false;
         if (configElem.type() == BSONType::Object) {
             includeHistograms = configElem.Obj()["histograms"].trueValue();
             slowBuckets = configElem.Obj()["slowBuckets"].trueValue();
+            includePercentiles = configElem.Obj()["percentiles"].trueValue();
+            includeCommands = configElem.Obj()["commands"].trueValue();
         }
         Top::get(opCtx->getServiceContext())
-            .appendGlobalLatencyStats(includeHistograms, slowBuckets, &latencyBuilder);
+            .appendGlobalLatencyStats(includeHistograms,
+                                      slowBuckets,
+                                      includePercentiles,
+                                      includeCommands,
+                                      &latencyBuilder);
         return latencyBuilder.obj();
     }
 } globalHistogramServerStatusSection;
@@ -32,6 +32,7 @@
 #include "mongo/db/stats/operation_latency_histogram.h"
 
 #include <algorithm>
+#include <cmath>
 
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/namespace_string.h"
@@ -92,10 +93,52 @@ const std::array<uint64_t, OperationLatencyHistogram::kMaxBuckets>
                                                549755813888,
                                                1099511627776};
 
+uint64_t OperationLatencyHistogram::_estimateQuantile(const HistogramData& data,
+                                                      double quantile) {
+    if (data.entryCount == 0) {
+        return 0;
+    }
+
+    const uint64_t rank =
+        std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(quantile * data.entryCount)));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kMaxBuckets; i++) {
+        if (seen + data.buckets[i] < rank) {
+            seen += data.buckets[i];
+            continue;
+        }
+
+        // The last bucket is unbounded, so report its lower bound.
+        if (i == kMaxBuckets - 1) {
+            return kLowerBounds[i];
+        }
+        const double fraction = static_cast<double>(rank - seen) / data.buckets[i];
+        return kLowerBounds[i] +
+            static_cast<uint64_t>(fraction * (kLowerBounds[i + 1] - kLowerBounds[i]));
+    }
+    MONGO_UNREACHABLE;
+}
+
+const OperationLatencyHistogram::HistogramData& OperationLatencyHistogram::_getData(
+    Command::ReadWriteType type) const {
+    switch (type) {
+        case Command::ReadWriteType::kRead:
+            return _reads;
+        case Command::ReadWriteType::kWrite:
+            return _writes;
+        case Command::ReadWriteType::kCommand:
+            return _commands;
+        case Command::ReadWriteType::kTransaction:
+            return _transactions;
+    }
+    MONGO_UNREACHABLE;
+}
+
 void OperationLatencyHistogram::_append(const HistogramData& data,
-                                        const char* key,
+                                        StringData key,
                                         bool includeHistograms,
                                         bool slowMSBucketsOnly,
+                                        bool includePercentiles,
                                         BSONObjBuilder* builder) const {
 
     uint64_t filteredCount = 0;
@@ -141,16 +184,41 @@ void OperationLatencyHistogram::_append(const HistogramData& data,
 
     histogramBuilder.append("latency", static_cast<long long>(data.sum));
     histogramBuilder.append("ops", static_cast<long long>(data.entryCount));
+    if (includePercentiles) {
+        histogramBuilder.append("p50", static_cast<long long>(_estimateQuantile(data, 0.5)));
+        histogramBuilder.append("p95", static_cast<long long>(_estimateQuantile(data, 0.95)));
+        histogramBuilder.append("p99", static_cast<long long>(_estimateQuantile(data, 0.99)));
+        histogramBuilder.append("p999", static_cast<long long>(_estimateQuantile(data, 0.999)));
+    }
     histogramBuilder.doneFast();
 }
 
 void OperationLatencyHistogram::append(bool includeHistograms,
                                        bool slowMSBucketsOnly,
-                                       BSONObjBuilder* builder) const {
-    _append(_reads, "reads", includeHistograms, slowMSBucketsOnly, builder);
-    _append(_writes, "writes", includeHistograms, slowMSBucketsOnly, builder);
-    _append(_commands, "commands", includeHistograms, slowMSBucketsOnly, builder);
-    _append(_transactions, "transactions", includeHistograms, slowMSBucketsOnly, builder);
+                                       BSONObjBuilder* builder,
+                                       bool includePercentiles) const {
+    _append(_reads, "reads", includeHistograms, slowMSBucketsOnly, includePercentiles, builder);
+    _append(_writes, "writes", includeHistograms, slowMSBucketsOnly, includePercentiles, builder);
+    _append(_commands,
+            "commands",
+            includeHistograms,
+            slowMSBucketsOnly,
+            includePercentiles,
+            builder);
+    _append(_transactions,
+            "transactions",
+            includeHistograms,
+            slowMSBucketsOnly,
+            includePercentiles,
+            builder);
+}
+
+void OperationLatencyHistogram::appendForType(Command::ReadWriteType type,
+                                              StringData key,
+                                              bool includeHistograms,
+                                              bool includePercentiles,
+                                              BSONObjBuilder* builder) const {
+    _append(_getData(type), key, includeHistograms, false, includePercentiles, builder);
 }
 
 // Computes the log base 2 of value, and checks for cases of split buckets.
@@ -55,9 +55,23 @@ public:
     void increment(uint64_t latency, Command::ReadWriteType type);
 
     /**
-     * Appends the four histograms with latency totals and operation counts.
+     * Appends the four histograms with latency totals and operation counts. If
+     * 'includePercentiles' is true, also appends estimates of the p50, p95, p99 and p99.9
+     * latencies of each histogram.
      */
-    void append(bool includeHistograms, bool slowMSBucketsOnly, BSONObjBuilder* builder) const;
+    void append(bool includeHistograms,
+                bool slowMSBucketsOnly,
+                BSONObjBuilder* builder,
+                bool includePercentiles = false) const;
+
+    /**
+     * Appends only the histogram of operations of the given type, under 'key'.
+     */
+    void appendForType(Command::ReadWriteType type,
+                       StringData key,
+                       bool includeHistograms,
+                       bool includePercentiles,
+                       BSONObjBuilder* builder) const;
 
 private:
     struct HistogramData {
@@ -70,10 +84,19 @@ private:
 
     static uint64_t _getBucketMicros(int bucket);
 
+    /**
+     * Estimates the latency below which the fraction 'quantile' of the operations counted in
+     * 'data' fall, interpolating linearly within the bucket which holds it.
+     */
+    static uint64_t _estimateQuantile(const HistogramData& data, double quantile);
+
+    const HistogramData& _getData(Command::ReadWriteType type) const;
+
     void _append(const HistogramData& data,
-                 const char* key,
+                 StringData key,
                  bool includeHistograms,
                  bool slowMSBucketsOnly,
+                 bool includePercentiles,
                  BSONObjBuilder* builder) const;
 
     void _incrementData(uint64_t latency, int bucket, HistogramData* data);
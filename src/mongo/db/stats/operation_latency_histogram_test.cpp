@@ -93,6 +93,45 @@ TEST(OperationLatencyHistogram, CheckBucketCountsAndTotalLatency) {
     }
 }
 
+TEST(OperationLatencyHistogram, PercentilesAreInterpolatedWithinBuckets) {
+    OperationLatencyHistogram hist;
+    // 990 operations in the [1024, 2048) bucket and 10 in the [8192, 12288) bucket.
+    for (int i = 0; i < 990; i++) {
+        hist.increment(1500, Command::ReadWriteType::kRead);
+    }
+    for (int i = 0; i < 10; i++) {
+        hist.increment(10000, Command::ReadWriteType::kRead);
+    }
+
+    BSONObjBuilder outBuilder;
+    hist.append(false, false, &outBuilder, true);
+    BSONObj out = outBuilder.done();
+    ASSERT_EQUALS(out["reads"]["p50"].Long(), 1024 + 1024 * 500 / 990);
+    ASSERT_EQUALS(out["reads"]["p99"].Long(), 2048);
+    ASSERT_EQUALS(out["reads"]["p999"].Long(), 8192 + 4096 * 9 / 10);
+
+    // Histograms without operations report zero.
+    ASSERT_EQUALS(out["writes"]["p50"].Long(), 0);
+
+    // Percentiles are only appended on request.
+    BSONObjBuilder defaultBuilder;
+    hist.append(false, false, &defaultBuilder);
+    ASSERT_FALSE(defaultBuilder.done()["reads"].Obj().hasField("p50"));
+}
+
+TEST(OperationLatencyHistogram, AppendForTypeOnlyAppendsThatType) {
+    OperationLatencyHistogram hist;
+    hist.increment(100, Command::ReadWriteType::kWrite);
+    hist.increment(300, Command::ReadWriteType::kWrite);
+
+    BSONObjBuilder outBuilder;
+    hist.appendForType(Command::ReadWriteType::kWrite, "insert", false, false, &outBuilder);
+    BSONObj out = outBuilder.done();
+    ASSERT_EQUALS(out.nFields(), 1);
+    ASSERT_EQUALS(out["insert"]["ops"].Long(), 2);
+    ASSERT_EQUALS(out["insert"]["latency"].Long(), 400);
+}
+
 TEST(OperationLatencyHistogram, CheckBucketCountsAndTotalLatencySlowBuckets) {
     OperationLatencyHistogram hist;
     // Increment at the boundary, boundary+1, and boundary-1.
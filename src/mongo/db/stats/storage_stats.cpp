@@ -38,6 +38,8 @@
 #include "mongo/db/db_raii.h"
 #include "mongo/db/index/index_access_method.h"
 #include "mongo/db/index/index_descriptor.h"
+#include "mongo/db/pipeline/materialized_group_catalog.h"
+#include "mongo/db/query/query_result_cache.h"
 #include "mongo/db/s/balancer_stats_registry.h"
 #include "mongo/db/timeseries/bucket_catalog.h"
 #include "mongo/db/timeseries/timeseries_stats.h"
@@ -150,6 +152,9 @@ Status appendCollectionStorageStats(OperationContext* opCtx,
         result->appendNumber("maxSize", collection->getCappedMaxSize() / scale);
     }
 
+    QueryResultCache::get(opCtx).appendCollectionStats(collection->uuid(), result);
+    MaterializedGroupCatalog::get(opCtx).appendCollectionStats(collection->uuid(), result);
+
     if (numericOnly) {
         recordStore->appendNumericCustomStats(opCtx, result, scale);
     } else {
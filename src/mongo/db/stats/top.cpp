@@ -82,9 +82,9 @@ void Top::record(OperationContext* opCtx,
         return;
 
     auto hashedNs = UsageMap::hasher().hashed_key(ns);
-    stdx::lock_guard<SimpleMutex> lk(_lock);
+    auto partition = _usage.lockOnePartitionById(_usagePartitionOf(hashedNs.hash()));
 
-    CollectionData& coll = _usage[hashedNs];
+    CollectionData& coll = (*partition)[hashedNs];
     _record(opCtx, coll, logicalOp, lockType, micros, readWriteType);
 }
 
@@ -146,18 +146,24 @@ void Top::_record(OperationContext* opCtx,
 }
 
 void Top::collectionDropped(const NamespaceString& nss) {
-    stdx::lock_guard<SimpleMutex> lk(_lock);
-    _usage.erase(nss.ns());
+    auto hashedNs = UsageMap::hasher().hashed_key(nss.ns());
+    auto partition = _usage.lockOnePartitionById(_usagePartitionOf(hashedNs.hash()));
+    partition->erase(hashedNs);
 }
 
 void Top::cloneMap(Top::UsageMap& out) const {
-    stdx::lock_guard<SimpleMutex> lk(_lock);
-    out = _usage;
+    out.clear();
+    auto allPartitions = _usage.lockAllPartitions();
+    for (auto&& partition : allPartitions) {
+        out.insert(partition->begin(), partition->end());
+    }
 }
 
 void Top::append(BSONObjBuilder& b) {
-    stdx::lock_guard<SimpleMutex> lk(_lock);
-    _appendToUsageMap(b, _usage);
+    // Merge the partitions into a snapshot so that no partition stays locked while building.
+    UsageMap usage;
+    cloneMap(usage);
+    _appendToUsageMap(b, usage);
 }
 
 void Top::_appendToUsageMap(BSONObjBuilder& b, const UsageMap& map) const {
@@ -202,32 +208,61 @@ void Top::appendLatencyStats(const NamespaceString& nss,
                              bool includeHistograms,
                              BSONObjBuilder* builder) {
     auto hashedNs = UsageMap::hasher().hashed_key(nss.ns());
-    stdx::lock_guard<SimpleMutex> lk(_lock);
+    auto partition = _usage.lockOnePartitionById(_usagePartitionOf(hashedNs.hash()));
     BSONObjBuilder latencyStatsBuilder;
-    _usage[hashedNs].opLatencyHistogram.append(includeHistograms, false, &latencyStatsBuilder);
+    (*partition)[hashedNs].opLatencyHistogram.append(
+        includeHistograms, false, &latencyStatsBuilder);
     builder->append("ns", nss.ns());
     builder->append("latencyStats", latencyStatsBuilder.obj());
 }
 
 void Top::incrementGlobalLatencyStats(OperationContext* opCtx,
                                       uint64_t latency,
-                                      Command::ReadWriteType readWriteType) {
+                                      Command::ReadWriteType readWriteType,
+                                      const Command* command) {
     if (!opCtx->shouldIncrementLatencyStats())
         return;
 
-    stdx::lock_guard<SimpleMutex> guard(_lock);
+    stdx::lock_guard<SimpleMutex> guard(_latencyLock);
     _incrementHistogram(opCtx, latency, &_globalHistogramStats, readWriteType);
+    if (command) {
+        auto& commandData = _commandLatencyStats[command->getName()];
+        commandData.readWriteType = readWriteType;
+        _incrementHistogram(opCtx, latency, &commandData.histogram, readWriteType);
+    }
 }
 
 void Top::appendGlobalLatencyStats(bool includeHistograms,
                                    bool slowMSBucketsOnly,
+                                   bool includePercentiles,
+                                   bool includeCommands,
                                    BSONObjBuilder* builder) {
-    stdx::lock_guard<SimpleMutex> guard(_lock);
-    _globalHistogramStats.append(includeHistograms, slowMSBucketsOnly, builder);
+    stdx::lock_guard<SimpleMutex> guard(_latencyLock);
+    _globalHistogramStats.append(includeHistograms, slowMSBucketsOnly, builder, includePercentiles);
+
+    if (includeCommands) {
+        // Sort the names so that the output is stable.
+        std::vector<StringData> names;
+        for (auto&& [name, commandData] : _commandLatencyStats) {
+            names.push_back(name);
+        }
+        std::sort(names.begin(), names.end());
+
+        BSONObjBuilder commandsBuilder(builder->subobjStart("commandsByName"));
+        for (auto&& name : names) {
+            // A command only records operations of its own type, so append that histogram alone.
+            const auto& commandData = _commandLatencyStats.find(name)->second;
+            commandData.histogram.appendForType(commandData.readWriteType,
+                                                name,
+                                                includeHistograms,
+                                                includePercentiles,
+                                                &commandsBuilder);
+        }
+    }
 }
 
 void Top::incrementGlobalTransactionLatencyStats(uint64_t latency) {
-    stdx::lock_guard<SimpleMutex> guard(_lock);
+    stdx::lock_guard<SimpleMutex> guard(_latencyLock);
     _globalHistogramStats.increment(latency, Command::ReadWriteType::kTransaction);
 }
 
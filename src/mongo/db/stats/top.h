@@ -35,6 +35,7 @@
 
 #include <boost/date_time/posix_time/posix_time.hpp>
 
+#include "mongo/db/catalog/util/partitioned.h"
 #include "mongo/db/commands.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/stats/operation_latency_histogram.h"
@@ -47,6 +48,10 @@ class ServiceContext;
 
 /**
  * tracks usage by collection
+ *
+ * Per-collection usage is kept in a map partitioned by namespace, so that operations on different
+ * collections record under different mutexes. The global and per-command latency histograms are
+ * guarded by a separate mutex.
  */
 class Top {
 public:
@@ -129,11 +134,13 @@ public:
                             BSONObjBuilder* builder);
 
     /**
-     * Increments the global histogram only if the operation came from a user.
+     * Increments the global histogram, and the histogram of 'command' if it is not null, only if
+     * the operation came from a user.
      */
     void incrementGlobalLatencyStats(OperationContext* opCtx,
                                      uint64_t latency,
-                                     Command::ReadWriteType readWriteType);
+                                     Command::ReadWriteType readWriteType,
+                                     const Command* command = nullptr);
 
     /**
      * Increments the global transactions histogram.
@@ -141,13 +148,21 @@ public:
     void incrementGlobalTransactionLatencyStats(uint64_t latency);
 
     /**
-     * Appends the global latency statistics.
+     * Appends the global latency statistics. If 'includeCommands' is true, also appends the
+     * latency statistics of each command which has run, under 'commandsByName'.
      */
     void appendGlobalLatencyStats(bool includeHistograms,
                                   bool slowMSBucketsOnly,
+                                  bool includePercentiles,
+                                  bool includeCommands,
                                   BSONObjBuilder* builder);
 
 private:
+    struct CommandLatencyData {
+        Command::ReadWriteType readWriteType = Command::ReadWriteType::kCommand;
+        OperationLatencyHistogram histogram;
+    };
+
     void _appendToUsageMap(BSONObjBuilder& b, const UsageMap& map) const;
 
     void _appendStatsEntry(BSONObjBuilder& b, const char* statsName, const UsageData& map) const;
@@ -164,9 +179,30 @@ private:
                              OperationLatencyHistogram* histogram,
                              Command::ReadWriteType readWriteType);
 
-    mutable SimpleMutex _lock;
+    static constexpr std::size_t kNumUsagePartitions = 16;
+
+    /**
+     * Picks the partition from the high bits of the namespace hash. The low bits also select the
+     * slot within the partition's map, so using them here would cluster each partition's keys.
+     */
+    static std::size_t _usagePartitionOf(std::size_t nsHash) {
+        return (nsHash >> 32) % kNumUsagePartitions;
+    }
+
+    struct UsagePartitioner {
+        std::size_t operator()(const std::string& ns, std::size_t nPartitions) const {
+            invariant(nPartitions == kNumUsagePartitions);
+            return _usagePartitionOf(UsageMap::hasher()(ns));
+        }
+    };
+
+    // Guards '_globalHistogramStats' and '_commandLatencyStats'.
+    mutable SimpleMutex _latencyLock;
     OperationLatencyHistogram _globalHistogramStats;
-    UsageMap _usage;
+    // Keyed by command name, so bounded by the number of registered commands.
+    StringMap<CommandLatencyData> _commandLatencyStats;
+
+    mutable Partitioned<UsageMap, UsagePartitioner> _usage{kNumUsagePartitions};
 };
 
 }  // namespace mongo
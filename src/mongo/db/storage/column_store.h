@@ -346,12 +346,13 @@ struct SplitCellView {
 
     template <class ValueEncoder>
     auto subcellValuesGenerator(ValueEncoder&& valEncoder) const {
+        using Encoder = std::decay_t<ValueEncoder>;
         struct Cursor {
-            typename ValueEncoder::Out nextValue() {
+            typename Encoder::Out nextValue() {
                 if (!elemPtr)
-                    return ValueEncoder::Out();
+                    return typename Encoder::Out();
                 if (elemPtr == end)
-                    return ValueEncoder::Out();
+                    return typename Encoder::Out();
 
                 invariant(elemPtr < end);
                 return decodeAndAdvance(elemPtr, encoder);
@@ -359,9 +360,10 @@ struct SplitCellView {
 
             const char* elemPtr;
             const char* end;
-            ValueEncoder encoder;
+            Encoder encoder;
         };
-        return Cursor{firstElementPtr, arrInfo.rawData(), std::forward(valEncoder)};
+        return Cursor{
+            firstElementPtr, arrInfo.rawData(), std::forward<ValueEncoder>(valEncoder)};
     }
 
     static SplitCellView parse(CellView cell) {
@@ -384,7 +386,7 @@ struct SplitCellView {
                 firstByte = *++firstByteAddr;
             }
 
-            if (Bytes::kFirstArrInfoSize >= firstByte && firstByte <= Bytes::kLastArrInfoSize) {
+            if (Bytes::kFirstArrInfoSize <= firstByte && firstByte <= Bytes::kLastArrInfoSize) {
                 firstByteAddr++;  // Skip size-kind byte.
 
                 // TODO SERVER-63284: This check for the tiny array info case would be more
@@ -438,11 +440,11 @@ struct SplitCellView {
         }
 
         // TODO SERVER-63284: This would be more concisely expressed using the case range syntax.
-        if (Bytes::kTinyIntMin >= byte && byte <= Bytes::kTinyIntMax) {
+        if (Bytes::kTinyIntMin <= byte && byte <= Bytes::kTinyIntMax) {
             return encoder(int32_t(int8_t(byte - TinyNum::kTinyIntZero)));
-        } else if (Bytes::kTinyLongMin >= byte && byte <= Bytes::kTinyLongMax) {
+        } else if (Bytes::kTinyLongMin <= byte && byte <= Bytes::kTinyLongMax) {
             return encoder(int64_t(int8_t(byte - TinyNum::kTinyLongZero)));
-        } else if (Bytes::kStringSizeMin >= byte && byte <= Bytes::kStringSizeMax) {
+        } else if (Bytes::kStringSizeMin <= byte && byte <= Bytes::kStringSizeMax) {
             auto size = size_t(byte - Bytes::kStringSizeMin);
             return encoder(StringData(std::exchange(ptr, ptr + size), size));
         } else {
@@ -0,0 +1,111 @@
+/**
+ *    Copyright (C) 2022-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/column_store.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using Bytes = ColumnStore::Bytes;
+
+/**
+ * Decodes each subcell value into a single-field BSONObj with an empty field name.
+ */
+struct ToBSON {
+    using Out = BSONObj;
+
+    BSONObj operator()(const BSONElement& elem) const {
+        BSONObjBuilder bob;
+        bob.appendAs(elem, "");
+        return bob.obj();
+    }
+
+    BSONObj operator()(const UUID& uuid) const {
+        BSONObjBuilder bob;
+        uuid.appendToBuilder(&bob, "");
+        return bob.obj();
+    }
+
+    template <typename T>
+    BSONObj operator()(const T& val) const {
+        BSONObjBuilder bob;
+        bob << "" << val;
+        return bob.obj();
+    }
+};
+
+BSONObj decodeOne(StringData encoded) {
+    const char* ptr = encoded.rawData();
+    auto out = SplitCellView::decodeAndAdvance(ptr, ToBSON{});
+    ASSERT_EQ(ptr, encoded.rawData() + encoded.size());
+    return out;
+}
+
+TEST(ColumnStoreCellTest, DecodeTinyNumbers) {
+    const char tinyInt[] = {char(Bytes::TinyNum::kTinyIntZero + 5)};
+    ASSERT_BSONOBJ_EQ(decodeOne(StringData(tinyInt, 1)), BSON("" << 5));
+
+    const char tinyLong[] = {char(Bytes::TinyNum::kTinyLongZero - 3)};
+    ASSERT_BSONOBJ_EQ(decodeOne(StringData(tinyLong, 1)), BSON("" << -3LL));
+}
+
+TEST(ColumnStoreCellTest, DecodeShortString) {
+    const char str[] = {char(Bytes::kStringSizeMin + 3), 'a', 'b', 'c'};
+    ASSERT_BSONOBJ_EQ(decodeOne(StringData(str, sizeof(str))), BSON(""
+                                                                     << "abc"));
+}
+
+TEST(ColumnStoreCellTest, DecodeSizedInt) {
+    const char int1[] = {char(Bytes::kInt1), char(100)};
+    ASSERT_BSONOBJ_EQ(decodeOne(StringData(int1, sizeof(int1))), BSON("" << 100));
+}
+
+TEST(ColumnStoreCellTest, ParseTinyArrInfo) {
+    // Two bytes of array info trail two tiny ints.
+    const char cell[] = {char(Bytes::TinySize::kArrInfoZero + 2),
+                         char(Bytes::TinyNum::kTinyIntZero + 1),
+                         char(Bytes::TinyNum::kTinyIntZero + 2),
+                         '[',
+                         '1'};
+    auto split = SplitCellView::parse(CellView(cell, sizeof(cell)));
+    ASSERT_FALSE(split.hasSubObjects);
+    ASSERT_EQ(split.arrInfo, "[1"_sd);
+    ASSERT_EQ(split.firstElementPtr, cell + 1);
+
+    auto cursor = split.subcellValuesGenerator(ToBSON{});
+    ASSERT_BSONOBJ_EQ(cursor.nextValue(), BSON("" << 1));
+    ASSERT_BSONOBJ_EQ(cursor.nextValue(), BSON("" << 2));
+    ASSERT_BSONOBJ_EQ(cursor.nextValue(), BSONObj());
+}
+
+}  // namespace
+}  // namespace mongo
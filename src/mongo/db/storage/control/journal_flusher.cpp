@@ -37,6 +37,7 @@
 #include "mongo/db/operation_context.h"
 #include "mongo/db/storage/recovery_unit.h"
 #include "mongo/db/storage/storage_options.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/logv2/log.h"
 #include "mongo/stdx/future.h"
 #include "mongo/util/concurrency/idle_thread_block.h"
@@ -63,6 +64,10 @@ JournalFlusher* JournalFlusher::get(OperationContext* opCtx) {
     return get(opCtx->getServiceContext());
 }
 
+JournalFlusher* JournalFlusher::getIfSet(ServiceContext* serviceCtx) {
+    return getJournalFlusher(serviceCtx).get();
+}
+
 void JournalFlusher::set(ServiceContext* serviceCtx, std::unique_ptr<JournalFlusher> flusher) {
     auto& journalFlusher = getJournalFlusher(serviceCtx);
     if (journalFlusher) {
@@ -119,6 +124,9 @@ void JournalFlusher::run() {
 
             _uniqueCtx->get()->recoveryUnit()->waitUntilDurable(_uniqueCtx->get());
 
+            _numFlushes.fetchAndAdd(1);
+            _numFlushWaiters.fetchAndAdd(_numWaitersForCurrentRound);
+
             // Signal the waiters that a round completed.
             _currentSharedPromise->emplaceValue();
         } catch (const AssertionException& e) {
@@ -167,6 +175,17 @@ void JournalFlusher::run() {
             });
         }
 
+        // When the last flush was shared by several writers, writes are arriving concurrently, so
+        // briefly hold back a requested flush to let more of them share it. Waiters arriving in the
+        // meantime see '_flushJournalNow' already set and do not wake this thread.
+        const auto groupCommitDelay = Microseconds(gJournalFlushGroupCommitDelayMicros.load());
+        if (_flushJournalNow && _numWaitersForCurrentRound > 1 &&
+            groupCommitDelay > Microseconds(0)) {
+            _flushJournalNowCV.wait_for(lk, groupCommitDelay.toSystemDuration(), [&] {
+                return _needToPause || _shuttingDown;
+            });
+        }
+
         if (_needToPause) {
             _state = States::Paused;
             _stateChangeCV.notify_all();
@@ -195,6 +214,7 @@ void JournalFlusher::run() {
         // Take the next promise as current and reset the next promise.
         _currentSharedPromise =
             std::exchange(_nextSharedPromise, std::make_unique<SharedPromise<void>>());
+        _numWaitersForCurrentRound = std::exchange(_numWaitersForNextRound, 0);
     }
 }
 
@@ -261,6 +281,11 @@ void JournalFlusher::interruptJournalFlusherForReplStateChange() {
     }
 }
 
+void JournalFlusher::appendStats(BSONObjBuilder* builder) const {
+    builder->append("flushes", _numFlushes.load());
+    builder->append("waiters", _numFlushWaiters.load());
+}
+
 void JournalFlusher::_waitForJournalFlushNoRetry() {
     auto myFuture = [&]() {
         stdx::unique_lock<Latch> lk(_stateMutex);
@@ -268,6 +293,7 @@ void JournalFlusher::_waitForJournalFlushNoRetry() {
             _flushJournalNow = true;
             _flushJournalNowCV.notify_one();
         }
+        ++_numWaitersForNextRound;
         return _nextSharedPromise->getFuture();
     }();
     // Throws on error if the flusher round is interrupted or the flusher thread is shutdown.
@@ -29,7 +29,9 @@
 
 #pragma once
 
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/service_context.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/util/background.h"
 #include "mongo/util/future.h"
@@ -67,6 +69,11 @@ public:
 
     static JournalFlusher* get(ServiceContext* serviceCtx);
     static JournalFlusher* get(OperationContext* opCtx);
+
+    /**
+     * Returns nullptr if no JournalFlusher has been set on 'serviceCtx'.
+     */
+    static JournalFlusher* getIfSet(ServiceContext* serviceCtx);
     static void set(ServiceContext* serviceCtx, std::unique_ptr<JournalFlusher> journalFlusher);
 
     std::string name() const {
@@ -121,6 +128,13 @@ public:
      */
     void interruptJournalFlusherForReplStateChange();
 
+    /**
+     * Appends the number of completed flushes and the total number of callers of
+     * waitForJournalFlush() they served. The average number of waiters per flush over an interval
+     * is the ratio of the deltas of the two.
+     */
+    void appendStats(BSONObjBuilder* builder) const;
+
 private:
     // Journal flusher internal states.
     enum class States {
@@ -170,6 +184,16 @@ private:
     std::unique_ptr<SharedPromise<void>> _nextSharedPromise =
         std::make_unique<SharedPromise<void>>();
 
+    // The number of callers waiting on '_nextSharedPromise'. Swapped into
+    // '_numWaitersForCurrentRound', which only the JournalFlusher thread accesses, along with the
+    // promise.
+    int64_t _numWaitersForNextRound = 0;
+    int64_t _numWaitersForCurrentRound = 0;
+
+    // Cumulative statistics reported by appendStats().
+    AtomicWord<long long> _numFlushes{0};
+    AtomicWord<long long> _numFlushWaiters{0};
+
     // Controls whether to ignore the 'storageGlobalParams.journalCommitIntervalMs' setting. If set,
     // data flushes will only be executed upon explicit request, no longer periodically in addition
     // to upon request.
@@ -222,6 +222,13 @@ BSONObj FlowControl::generateSection(OperationContext* opCtx,
     bob.append("isLaggedCount", _isLaggedCount.load());
     bob.append("isLaggedTimeMicros", _isLaggedTimeMicros.load());
 
+    // Per-application ticket stats vary in shape from one sample to the next, so they are only
+    // reported on request, e.g. serverStatus({flowControl: {sources: 1}}), and not in FTDC.
+    if (configElement.type() == BSONType::Object && configElement.Obj()["sources"].trueValue()) {
+        BSONObjBuilder sources(bob.subobjStart("sources"));
+        FlowControlTicketholder::get(opCtx)->appendSourceStats(&sources);
+    }
+
     return bob.obj();
 }
 
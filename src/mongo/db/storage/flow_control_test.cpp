@@ -286,4 +286,21 @@ TEST_F(FlowControlTest, DisableUntil) {
     // After the deadline passes, the override should take effect.
     ASSERT_EQ(ticketOverride, flowControl->getNumTickets(reenabled));
 }
+
+TEST_F(FlowControlTest, TicketholderReportsPerSourceStats) {
+    FlowControlTicketholder ticketholder(2);
+    FlowControlTicketholder::CurOp stats;
+    ticketholder.getTicket(opCtx.get(), &stats);
+    ticketholder.getTicket(opCtx.get(), &stats);
+
+    BSONObjBuilder bob;
+    ticketholder.appendSourceStats(&bob);
+    auto sources = bob.obj();
+
+    // The test client sends no client metadata, so its tickets are reported as unnamed.
+    auto unnamed = sources[FlowControlTicketholder::kUnnamedSourceName].Obj();
+    ASSERT_EQ(2, unnamed["acquireCount"].numberLong());
+    ASSERT_EQ(0, unnamed["acquireWaitCount"].numberLong());
+    ASSERT_EQ(1, sources.nFields());
+}
 }  // namespace mongo
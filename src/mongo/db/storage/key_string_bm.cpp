@@ -31,6 +31,7 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
 #include <benchmark/benchmark.h>
 #include <random>
 #include <vector>
@@ -227,6 +228,51 @@ void BM_KeyStringRecordIdStrDecode(benchmark::State& state, const size_t size) {
     }
 }
 
+// Builds the keys of a compound {tenantId: 1, type: 1, ts: 1} index, where few distinct tenants and
+// types lead many keys, and reports how many bytes of each key repeat the previous one.
+void BM_KeyStringCompoundSharedPrefix(benchmark::State& state) {
+    const int kNumTenants = 10;
+    const int kNumTypes = 5;
+    std::vector<OID> tenants;
+    for (int i = 0; i < kNumTenants; i++) {
+        tenants.push_back(OID::gen());
+    }
+    std::vector<BSONObj> bsons;
+    for (int i = 0; i < kSampleSize; i++) {
+        bsons.push_back(BSON("" << tenants[i % kNumTenants] << ""
+                                << ("type" + std::to_string(i / kNumTenants % kNumTypes)) << ""
+                                << Date_t::fromMillisSinceEpoch(i)));
+    }
+    std::sort(bsons.begin(), bsons.end(), [](const BSONObj& lhs, const BSONObj& rhs) {
+        return lhs.woCompare(rhs) < 0;
+    });
+
+    int64_t keyBytes = 0;
+    int64_t sharedBytes = 0;
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        keyBytes = 0;
+        sharedBytes = 0;
+        KeyString::Value prev;
+        for (size_t i = 0; i < bsons.size(); i++) {
+            KeyString::Builder ks(
+                KeyString::Version::V1, bsons[i], ALL_ASCENDING, RecordId(static_cast<int64_t>(i)));
+            auto value = ks.getValueCopy();
+            const auto size = std::min(value.getSize(), prev.getSize());
+            sharedBytes += std::mismatch(value.getBuffer(),
+                                         value.getBuffer() + size,
+                                         prev.getBuffer())
+                               .first -
+                value.getBuffer();
+            keyBytes += value.getSize();
+            prev = std::move(value);
+        }
+    }
+    state.counters["keyBytes"] = keyBytes;
+    state.counters["sharedPrefixBytes"] = sharedBytes;
+    state.SetItemsProcessed(state.iterations() * bsons.size());
+}
+
 BENCHMARK_CAPTURE(BM_KeyStringValueAssign, Int, INT);
 BENCHMARK_CAPTURE(BM_KeyStringValueAssign, Double, DOUBLE);
 BENCHMARK_CAPTURE(BM_KeyStringValueAssign, Decimal, DECIMAL);
@@ -265,6 +311,8 @@ BENCHMARK_CAPTURE(BM_KeyStringToBSON, V1_String, KeyString::Version::V1, STRING)
 BENCHMARK_CAPTURE(BM_KeyStringToBSON, V0_Array, KeyString::Version::V0, ARRAY);
 BENCHMARK_CAPTURE(BM_KeyStringToBSON, V1_Array, KeyString::Version::V1, ARRAY);
 
+BENCHMARK(BM_KeyStringCompoundSharedPrefix);
+
 BENCHMARK_CAPTURE(BM_KeyStringRecordIdStrAppend, 16B, 16);
 BENCHMARK_CAPTURE(BM_KeyStringRecordIdStrAppend, 512B, 512);
 BENCHMARK_CAPTURE(BM_KeyStringRecordIdStrAppend, 1kB, 1024);
@@ -42,6 +42,21 @@ void validateWriteAllowed() {
 }
 }  // namespace
 
+void RecordCursor::nextBatch(size_t n, std::vector<Record>* out) {
+    out->clear();
+    while (out->size() < n) {
+        // Advancing the cursor invalidates the data of the previous record unless it is owned.
+        if (!out->empty()) {
+            out->back().data.makeOwned();
+        }
+        auto record = next();
+        if (!record) {
+            return;
+        }
+        out->push_back(std::move(*record));
+    }
+}
+
 void RecordStore::deleteRecord(OperationContext* opCtx, const RecordId& dl) {
     validateWriteAllowed();
     doDeleteRecord(opCtx, dl);
@@ -116,6 +116,19 @@ public:
      */
     virtual boost::optional<Record> next() = 0;
 
+    /**
+     * Clears 'out' and moves forward up to 'n' records, appending them to 'out' in the same order
+     * next() would return them. An empty batch means EOF; implementations may return fewer than
+     * 'n' records before EOF, for example to bound the memory held by a batch. The data of the
+     * returned records stays valid until the next call to next() or nextBatch() on this cursor,
+     * so callers must consume the whole batch before advancing again. If this throws, the records
+     * read before the error are left in 'out' and are valid under the same rules.
+     *
+     * The default implementation calls next() repeatedly and copies every record but the last.
+     * Storage engines can override this to avoid a separate allocation for each record.
+     */
+    virtual void nextBatch(size_t n, std::vector<Record>* out);
+
     //
     // Saving and restoring state
     //
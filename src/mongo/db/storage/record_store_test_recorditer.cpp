@@ -96,6 +96,51 @@ TEST(RecordStoreTestHarness, IterateOverMultipleRecords) {
     }
 }
 
+// Insert multiple records and read them in batches. The data of every record in a batch stays
+// valid until the cursor moves again, and an empty batch signals EOF.
+TEST(RecordStoreTestHarness, IterateOverMultipleRecordsInBatches) {
+    const auto harnessHelper(newRecordStoreHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newRecordStore());
+
+    const int nToInsert = 10;
+    RecordId locs[nToInsert];
+    std::string datas[nToInsert];
+    for (int i = 0; i < nToInsert; i++) {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        stringstream ss;
+        ss << "record " << i;
+        string data = ss.str();
+
+        WriteUnitOfWork uow(opCtx.get());
+        StatusWith<RecordId> res =
+            rs->insertRecord(opCtx.get(), data.c_str(), data.size() + 1, Timestamp());
+        ASSERT_OK(res.getStatus());
+        locs[i] = res.getValue();
+        datas[i] = data;
+        uow.commit();
+    }
+
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+    auto cursor = rs->getCursor(opCtx.get());
+    std::vector<Record> batch;
+    int i = 0;
+    while (true) {
+        cursor->nextBatch(4, &batch);
+        if (batch.empty()) {
+            break;
+        }
+        ASSERT_LTE(batch.size(), 4U);
+        for (const auto& record : batch) {
+            ASSERT_LT(i, nToInsert);
+            ASSERT_EQUALS(locs[i], record.id);
+            ASSERT_EQUALS(datas[i], record.data.data());
+            ++i;
+        }
+    }
+    ASSERT_EQUALS(nToInsert, i);
+    ASSERT(!cursor->next());
+}
+
 // Insert multiple records and iterate through them in the reverse direction.
 // When curr() or getNext() is called on an iterator positioned at EOF,
 // the iterator returns RecordId() and stays at EOF.
@@ -96,6 +96,29 @@ public:
                           const KeyString::Value& keyString,
                           bool dupsAllowed) = 0;
 
+    /**
+     * Inserts the sorted keys in ['first', 'last') as if by calling insert() on each of them in
+     * order, stopping at the first key which fails to insert. On return, 'numInserted' holds the
+     * number of keys which were inserted, which on error is the position of the failing key.
+     *
+     * Since the keys are sorted, implementations can insert all of them through a single cursor.
+     */
+    virtual Status insertBatch(OperationContext* opCtx,
+                               KeyStringSet::const_iterator first,
+                               KeyStringSet::const_iterator last,
+                               bool dupsAllowed,
+                               size_t* numInserted) {
+        *numInserted = 0;
+        for (auto it = first; it != last; ++it) {
+            auto status = insert(opCtx, *it, dupsAllowed);
+            if (!status.isOK()) {
+                return status;
+            }
+            ++*numInserted;
+        }
+        return Status::OK();
+    }
+
     /**
      * Remove the entry from the index with the specified KeyString, which must have a RecordId
      * appended to the end.
@@ -116,6 +139,22 @@ public:
     virtual boost::optional<RecordId> findLoc(OperationContext* opCtx,
                                               const KeyString::Value& keyString) const = 0;
 
+    /**
+     * Returns the RecordIds that findLoc() returns for each of 'keyStrings', omitting the
+     * KeyStrings without a match. Implementations may look all of them up through a single cursor,
+     * which is cheapest if 'keyStrings' are sorted.
+     */
+    virtual std::vector<RecordId> findLocs(OperationContext* opCtx,
+                                           const std::vector<KeyString::Value>& keyStrings) const {
+        std::vector<RecordId> locs;
+        for (auto&& keyString : keyStrings) {
+            if (auto loc = findLoc(opCtx, keyString)) {
+                locs.push_back(std::move(*loc));
+            }
+        }
+        return locs;
+    }
+
     /**
      * Return ErrorCodes::DuplicateKey if there is more than one occurence of 'KeyString' in this
      * index, and Status::OK() otherwise. This call is only allowed on a unique index, and will
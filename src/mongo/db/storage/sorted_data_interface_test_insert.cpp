@@ -101,6 +101,69 @@ TEST(SortedDataInterface, InsertKeyString) {
     }
 }
 
+// Insert a batch of keys and verify that all of them are in the index.
+TEST(SortedDataInterface, InsertBatch) {
+    const auto harnessHelper(newSortedDataInterfaceHarnessHelper());
+    const std::unique_ptr<SortedDataInterface> sorted(
+        harnessHelper->newSortedDataInterface(/*unique=*/false, /*partial=*/false));
+
+    KeyStringSet keys{makeKeyString(sorted.get(), key1, loc1),
+                      makeKeyString(sorted.get(), key2, loc1),
+                      makeKeyString(sorted.get(), key3, loc1)};
+
+    {
+        const ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        {
+            WriteUnitOfWork uow(opCtx.get());
+            size_t numInserted = 0;
+            ASSERT_OK(
+                sorted->insertBatch(opCtx.get(), keys.begin(), keys.end(), true, &numInserted));
+            ASSERT_EQ(3U, numInserted);
+            uow.commit();
+        }
+    }
+
+    {
+        const ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        ASSERT_EQUALS(3, sorted->numEntries(opCtx.get()));
+
+        const std::unique_ptr<SortedDataInterface::Cursor> cursor(sorted->newCursor(opCtx.get()));
+        ASSERT_EQ(cursor->seek(makeKeyStringForSeek(sorted.get(), key1, true, true)),
+                  IndexKeyEntry(key1, loc1));
+        ASSERT_EQ(cursor->next(), IndexKeyEntry(key2, loc1));
+        ASSERT_EQ(cursor->next(), IndexKeyEntry(key3, loc1));
+        ASSERT_EQ(cursor->next(), boost::none);
+    }
+}
+
+// Insert a batch of keys into a unique index, one of which is a duplicate. Verify that the batch
+// stops at the duplicate and reports how many keys were inserted before it.
+TEST(SortedDataInterface, InsertBatchStopsAtDuplicateKey) {
+    const auto harnessHelper(newSortedDataInterfaceHarnessHelper());
+    const std::unique_ptr<SortedDataInterface> sorted(
+        harnessHelper->newSortedDataInterface(/*unique=*/true, /*partial=*/false));
+
+    {
+        const ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        WriteUnitOfWork uow(opCtx.get());
+        ASSERT_OK(sorted->insert(opCtx.get(), makeKeyString(sorted.get(), key2, loc1), false));
+        uow.commit();
+    }
+
+    KeyStringSet keys{makeKeyString(sorted.get(), key1, loc2),
+                      makeKeyString(sorted.get(), key2, loc2),
+                      makeKeyString(sorted.get(), key3, loc2)};
+
+    {
+        const ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        WriteUnitOfWork uow(opCtx.get());
+        size_t numInserted = 0;
+        ASSERT_EQ(ErrorCodes::DuplicateKey,
+                  sorted->insertBatch(opCtx.get(), keys.begin(), keys.end(), false, &numInserted));
+        ASSERT_EQ(1U, numInserted);
+    }
+}
+
 // Insert a compound key and verify that the number of entries in the index equals 1.
 TEST(SortedDataInterface, InsertCompoundKey) {
     const auto harnessHelper(newSortedDataInterfaceHarnessHelper());
@@ -69,6 +69,16 @@ void TicketHolders::setGlobalThrottling(std::unique_ptr<TicketHolder> reading,
     _openWriteTransaction = std::move(writing);
 }
 
+void TicketHolders::setWriteThrottle(std::function<void(OperationContext*)> throttle) {
+    _writeThrottle = std::move(throttle);
+}
+
+void TicketHolders::throttleWrite(OperationContext* opCtx) const {
+    if (_writeThrottle) {
+        _writeThrottle(opCtx);
+    }
+}
+
 TicketHolder* TicketHolders::getTicketHolder(LockMode mode) {
     switch (mode) {
         case MODE_S:
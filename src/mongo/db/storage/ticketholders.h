@@ -33,10 +33,12 @@
 #include "mongo/db/concurrency/lock_manager_defs.h"
 #include "mongo/db/service_context.h"
 
+#include <functional>
 #include <memory>
 
 namespace mongo {
 
+class OperationContext;
 class TicketHolder;
 
 class TicketHolders {
@@ -59,9 +61,19 @@ public:
 
     TicketHolder* getTicketHolder(LockMode mode);
 
+    /**
+     * Sets a function, called before an operation which participates in flow control takes the
+     * global lock in MODE_IX, that lets the storage engine delay writers while it is under
+     * pressure. Must be set before operations start.
+     */
+    void setWriteThrottle(std::function<void(OperationContext*)> throttle);
+
+    void throttleWrite(OperationContext* opCtx) const;
+
 private:
     std::unique_ptr<TicketHolder> _openWriteTransaction;
     std::unique_ptr<TicketHolder> _openReadTransaction;
+    std::function<void(OperationContext*)> _writeThrottle;
 };
 
 }  // namespace mongo
@@ -60,6 +60,8 @@ public:
     std::string engineConfig;
 
     std::string collectionBlockCompressor;
+    // Empty unless configured, in which case the oplog uses 'collectionBlockCompressor'.
+    std::string oplogBlockCompressor;
     bool useCollectionPrefixCompression;
     bool useIndexPrefixCompression;
     std::string collectionConfig;
@@ -286,6 +286,31 @@ Status WiredTigerIndex::insert(OperationContext* opCtx,
     return _insert(opCtx, c, keyString, dupsAllowed);
 }
 
+Status WiredTigerIndex::insertBatch(OperationContext* opCtx,
+                                    KeyStringSet::const_iterator first,
+                                    KeyStringSet::const_iterator last,
+                                    bool dupsAllowed,
+                                    size_t* numInserted) {
+    dassert(opCtx->lockState()->isWriteLocked());
+    *numInserted = 0;
+
+    // Share one cursor between all the keys rather than getting one from the session's cursor
+    // cache for each of them.
+    WiredTigerCursor curwrap(_uri, _tableId, false, opCtx);
+    curwrap.assertInActiveTxn();
+    WT_CURSOR* c = curwrap.get();
+
+    for (auto it = first; it != last; ++it) {
+        dassertRecordIdAtEnd(*it, _rsKeyFormat);
+        auto status = _insert(opCtx, c, *it, dupsAllowed);
+        if (!status.isOK()) {
+            return status;
+        }
+        ++*numInserted;
+    }
+    return Status::OK();
+}
+
 void WiredTigerIndex::unindex(OperationContext* opCtx,
                               const KeyString::Value& keyString,
                               bool dupsAllowed) {
@@ -302,11 +327,28 @@ void WiredTigerIndex::unindex(OperationContext* opCtx,
 
 boost::optional<RecordId> WiredTigerIndex::findLoc(OperationContext* opCtx,
                                                    const KeyString::Value& key) const {
+    return _findLoc(newCursor(opCtx).get(), key);
+}
+
+std::vector<RecordId> WiredTigerIndex::findLocs(
+    OperationContext* opCtx, const std::vector<KeyString::Value>& keyStrings) const {
+    // Reposition a single cursor for every key rather than opening one per key.
+    auto cursor = newCursor(opCtx);
+    std::vector<RecordId> locs;
+    for (auto&& key : keyStrings) {
+        if (auto loc = _findLoc(cursor.get(), key)) {
+            locs.push_back(std::move(*loc));
+        }
+    }
+    return locs;
+}
+
+boost::optional<RecordId> WiredTigerIndex::_findLoc(SortedDataInterface::Cursor* cursor,
+                                                    const KeyString::Value& key) const {
     dassert(KeyString::decodeDiscriminator(
                 key.getBuffer(), key.getSize(), getOrdering(), key.getTypeBits()) ==
             KeyString::Discriminator::kInclusive);
 
-    auto cursor = newCursor(opCtx);
     auto ksEntry = cursor->seekForKeyString(key);
     if (!ksEntry) {
         return boost::none;
@@ -419,8 +461,7 @@ bool WiredTigerIndex::appendCustomStats(OperationContext* opCtx,
 
     WiredTigerSession* session = WiredTigerRecoveryUnit::get(opCtx)->getSession();
     WT_SESSION* s = session->getSession();
-    Status status =
-        WiredTigerUtil::exportTableToBSON(s, "statistics:" + uri(), "statistics=(fast)", output);
+    Status status = WiredTigerUtil::exportTableStatisticsToBSON(s, uri(), output);
     if (!status.isOK()) {
         output->append("error", "unable to retrieve statistics");
         output->append("code", static_cast<int>(status.code()));
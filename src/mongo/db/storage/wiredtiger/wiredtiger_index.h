@@ -133,6 +133,12 @@ public:
                           const KeyString::Value& keyString,
                           bool dupsAllowed);
 
+    Status insertBatch(OperationContext* opCtx,
+                       KeyStringSet::const_iterator first,
+                       KeyStringSet::const_iterator last,
+                       bool dupsAllowed,
+                       size_t* numInserted) override;
+
     virtual void unindex(OperationContext* opCtx,
                          const KeyString::Value& keyString,
                          bool dupsAllowed);
@@ -140,6 +146,9 @@ public:
     virtual boost::optional<RecordId> findLoc(OperationContext* opCtx,
                                               const KeyString::Value& keyString) const override;
 
+    std::vector<RecordId> findLocs(OperationContext* opCtx,
+                                   const std::vector<KeyString::Value>& keyStrings) const override;
+
     virtual void fullValidate(OperationContext* opCtx,
                               long long* numKeysOut,
                               IndexValidateResults* fullResults) const;
@@ -207,6 +216,12 @@ protected:
                           const KeyString::Value& keyString,
                           bool dupsAllowed) = 0;
 
+    /**
+     * Seeks 'cursor' to 'keyString' and returns the RecordId of the key found there if it matches.
+     */
+    boost::optional<RecordId> _findLoc(SortedDataInterface::Cursor* cursor,
+                                       const KeyString::Value& keyString) const;
+
     void setKey(WT_CURSOR* cursor, const WT_ITEM* item);
     void getKey(OperationContext* opCtx, WT_CURSOR* cursor, WT_ITEM* key);
 
@@ -35,6 +35,7 @@
 
 #include "mongo/platform/basic.h"
 
+#include "mongo/base/checked_cast.h"
 #include "mongo/base/init.h"
 #include "mongo/db/catalog/collection_options.h"
 #include "mongo/db/jsobj.h"
@@ -44,6 +45,7 @@
 #include "mongo/db/storage/storage_engine_lock_file.h"
 #include "mongo/db/storage/storage_engine_metadata.h"
 #include "mongo/db/storage/storage_options.h"
+#include "mongo/db/storage/ticketholders.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_global_options.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_index.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
@@ -130,6 +132,14 @@ public:
         kv->setRecordStoreExtraOptions(wiredTigerGlobalOptions.collectionConfig);
         kv->setSortedDataInterfaceExtraOptions(wiredTigerGlobalOptions.indexConfig);
 
+        // Looks up the engine on each call, so the hook never outlives the engine it throttles.
+        TicketHolders::get(opCtx->getServiceContext())
+            .setWriteThrottle([](OperationContext* opCtx) {
+                if (auto engine = opCtx->getServiceContext()->getStorageEngine()) {
+                    checked_cast<WiredTigerKVEngine*>(engine->getEngine())->throttleWrite(opCtx);
+                }
+            });
+
         // We must only add the server parameters to the global registry once during unit testing.
         static int setupCountForUnitTests = 0;
         if (setupCountForUnitTests == 0) {
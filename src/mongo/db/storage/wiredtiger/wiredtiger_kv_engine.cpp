@@ -310,6 +310,7 @@ WiredTigerKVEngine::WiredTigerKVEngine(const std::string& canonicalName,
       _oplogManager(std::make_unique<WiredTigerOplogManager>()),
       _canonicalName(canonicalName),
       _path(path),
+      _writeThrottle(cs),
       _sizeStorerSyncTracker(cs, 100000, Seconds(60)),
       _durable(durable),
       _ephemeral(ephemeral),
@@ -730,6 +731,15 @@ void WiredTigerKVEngine::cleanShutdown() {
         return;
     }
 
+    // The oplog record store may outlive the connection, so persist its truncation markers while
+    // the oplog can still be read.
+    {
+        stdx::lock_guard<Latch> lock(_oplogManagerMutex);
+        if (_oplogRecordStore) {
+            _oplogRecordStore->persistOplogStones();
+        }
+    }
+
     // these must be the last things we do before _conn->close();
     haltOplogManager(/*oplogRecordStore=*/nullptr, /*shuttingDown=*/true);
     if (_sessionSweeper) {
@@ -2037,6 +2047,18 @@ void WiredTigerKVEngine::_checkpoint(WT_SESSION* session, bool useTimestamp) {
                        2,
                        "Finished checkpoint, updated iteration counter",
                        "checkpointIteration"_attr = checkpointedIteration);
+
+    if (gWiredTigerFlushTierAfterCheckpoint) {
+        // Copy the data of the tiered tables as of this checkpoint to the object store configured
+        // with the 'tiered_storage' connection setting. A failed flush is retried with the next
+        // checkpoint, since the checkpoint itself is already durable locally.
+        if (auto status = wtRCToStatus(session->flush_tier(session, nullptr), session);
+            !status.isOK()) {
+            LOGV2_WARNING(7027506,
+                          "Failed to flush tiered tables to the object store",
+                          "error"_attr = status);
+        }
+    }
 }
 
 void WiredTigerKVEngine::_checkpoint(WT_SESSION* session) {
@@ -47,6 +47,7 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_oplog_manager.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_write_throttle.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/util/concurrency/with_lock.h"
 #include "mongo/util/elapsed_tracker.h"
@@ -296,6 +297,10 @@ public:
     WT_CONNECTION* getConnection() {
         return _conn;
     }
+
+    const std::string& getPath() const {
+        return _path;
+    }
     void dropSomeQueuedIdents();
     std::list<WiredTigerCachedCursor> filterCursorsWithQueuedDrops(
         std::list<WiredTigerCachedCursor>* cache);
@@ -328,6 +333,17 @@ public:
         return _oplogManager.get();
     }
 
+    WiredTigerWriteThrottle* getWriteThrottle() {
+        return &_writeThrottle;
+    }
+
+    /**
+     * Delays a writer that is about to take the global lock while the cache is under pressure.
+     */
+    void throttleWrite(OperationContext* opCtx) {
+        _writeThrottle.throttle(opCtx, _sessionCache.get());
+    }
+
     static void appendGlobalStats(OperationContext* opCtx, BSONObjBuilder& b);
 
     Timestamp getStableTimestamp() const override;
@@ -482,6 +498,8 @@ private:
     std::string _path;
     std::string _wtOpenConfig;
 
+    WiredTigerWriteThrottle _writeThrottle;
+
     std::unique_ptr<WiredTigerSizeStorer> _sizeStorer;
     std::string _sizeStorerUri;
     mutable ElapsedTracker _sizeStorerSyncTracker;
@@ -34,14 +34,18 @@
 
 #include "mongo/platform/basic.h"
 
+#include <boost/filesystem/operations.hpp>
 #include <fmt/format.h>
+#include <fstream>
 
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 
 #include <memory>
 
 #include "mongo/base/checked_cast.h"
+#include "mongo/base/data_view.h"
 #include "mongo/base/static_assert.h"
+#include "mongo/bson/bson_validate.h"
 #include "mongo/bson/util/builder.h"
 #include "mongo/db/catalog/validate_results.h"
 #include "mongo/db/concurrency/exception_util.h"
@@ -60,6 +64,7 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_customization_hooks.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_global_options.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_parameters_gen.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_prepare_conflict.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store_oplog_stones.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
@@ -107,6 +112,10 @@ MONGO_STATIC_ASSERT(kCurrentRecordStoreVersion <= kMaximumRecordStoreVersion);
 
 const double kNumMSInHour = 1000 * 60 * 60;
 
+std::string persistedOplogStonesPath(const std::string& dbpath) {
+    return (boost::filesystem::path(dbpath) / "oplogTruncationPoints.bson").string();
+}
+
 void checkOplogFormatVersion(OperationContext* opCtx, const std::string& uri) {
     StatusWith<BSONObj> appMetadata = WiredTigerUtil::getApplicationMetadata(opCtx, uri);
     fassert(39999, appMetadata);
@@ -115,8 +124,7 @@ void checkOplogFormatVersion(OperationContext* opCtx, const std::string& uri) {
 }
 
 void appendNumericStats(WT_SESSION* s, const std::string& uri, BSONObjBuilder& bob) {
-    Status status =
-        WiredTigerUtil::exportTableToBSON(s, "statistics:" + uri, "statistics=(fast)", &bob);
+    Status status = WiredTigerUtil::exportTableStatisticsToBSON(s, uri, &bob);
     if (!status.isOK()) {
         bob.append("error", "unable to retrieve statistics");
         bob.append("code", static_cast<int>(status.code()));
@@ -219,7 +227,9 @@ WiredTigerRecordStore::OplogStones::OplogStones(OperationContext* opCtx, WiredTi
     _minBytesPerStone = maxSize / numStonesToKeep;
     invariant(_minBytesPerStone > 0);
 
-    _calculateStones(opCtx, numStonesToKeep);
+    if (!_loadPersistedStones(opCtx)) {
+        _calculateStones(opCtx, numStonesToKeep);
+    }
     _pokeReclaimThreadIfNeeded();  // Reclaim stones if over the limit.
 }
 
@@ -420,6 +430,157 @@ void WiredTigerRecordStore::OplogStones::setMinBytesPerStone(int64_t size) {
     _minBytesPerStone = size;
 }
 
+void WiredTigerRecordStore::OplogStones::persist() const {
+    if (!gPersistOplogTruncationPoints || storageGlobalParams.readOnly || _persisted.swap(true)) {
+        return;
+    }
+
+    // Record the first and last records of the oplog, which the next startup checks the oplog
+    // still starts and ends with. No operation context is available here, so read them directly
+    // from the table, as of the latest committed data.
+    long long firstRecord = 0;
+    long long lastRecord = 0;
+    {
+        WiredTigerSession session(_rs->_kvEngine->getConnection());
+        WT_CURSOR* cursor = session.getNewCursor(_rs->getURI());
+        if (cursor->next(cursor) == 0) {
+            int64_t key;
+            invariantWTOK(cursor->get_key(cursor, &key), cursor->session);
+            firstRecord = key;
+        }
+        invariantWTOK(cursor->reset(cursor), cursor->session);
+        if (cursor->prev(cursor) == 0) {
+            int64_t key;
+            invariantWTOK(cursor->get_key(cursor, &key), cursor->session);
+            lastRecord = key;
+        }
+        session.closeCursor(cursor);
+    }
+
+    BSONObjBuilder builder;
+    builder.append("firstRecord", firstRecord);
+    builder.append("lastRecord", lastRecord);
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        builder.append("minBytesPerStone", _minBytesPerStone);
+        builder.append("numRecords", _rs->_sizeInfo->numRecords.load());
+        builder.append("dataSize", _rs->_sizeInfo->dataSize.load());
+        builder.append("currentRecords", _currentRecords.load());
+        builder.append("currentBytes", _currentBytes.load());
+
+        BSONArrayBuilder stones(builder.subarrayStart("stones"));
+        for (auto&& stone : _stones) {
+            BSONObjBuilder stoneBuilder(stones.subobjStart());
+            stoneBuilder.append("records", static_cast<long long>(stone.records));
+            stoneBuilder.append("bytes", static_cast<long long>(stone.bytes));
+            stoneBuilder.append("lastRecord", stone.lastRecord.getLong());
+            stoneBuilder.append("wallTime", stone.wallTime);
+        }
+    }
+    auto obj = builder.obj();
+
+    const auto path = persistedOplogStonesPath(_rs->_kvEngine->getPath());
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(obj.objdata(), obj.objsize());
+    out.close();
+    if (out.fail()) {
+        LOGV2_WARNING(
+            7027512, "Failed to persist the oplog truncation markers", "path"_attr = path);
+        boost::system::error_code ec;
+        boost::filesystem::remove(path, ec);
+    }
+}
+
+bool WiredTigerRecordStore::OplogStones::_loadPersistedStones(OperationContext* opCtx) {
+    const auto path = persistedOplogStonesPath(_rs->_kvEngine->getPath());
+    if (!boost::filesystem::exists(path)) {
+        return false;
+    }
+
+    // The file describes the oplog as of the time it was closed. Remove it right away, whether it
+    // is used or not, so that it cannot be used again after the oplog has been written to, e.g.
+    // once 'persistOplogTruncationPoints' is enabled again after a restart without it.
+    ON_BLOCK_EXIT([&] {
+        boost::system::error_code ec;
+        boost::filesystem::remove(path, ec);
+    });
+
+    if (!gPersistOplogTruncationPoints) {
+        return false;
+    }
+
+    auto ignore = [&](StringData reason) {
+        LOGV2(7027511,
+              "Ignoring the persisted oplog truncation markers",
+              "path"_attr = path,
+              "reason"_attr = reason);
+        return false;
+    };
+
+    std::string data;
+    {
+        std::ifstream in(path, std::ios::binary);
+        data.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    if (!validateBSON(data.data(), data.size()).isOK() ||
+        ConstDataView(data.data()).read<LittleEndian<int32_t>>() !=
+            static_cast<int32_t>(data.size())) {
+        return ignore("the file is not a valid BSON object");
+    }
+
+    try {
+        BSONObj obj(data.data());
+        if (obj["minBytesPerStone"].numberLong() != _minBytesPerStone) {
+            return ignore("the oplog size or the truncation point size changed");
+        }
+        if (obj["numRecords"].numberLong() != _rs->numRecords(opCtx) ||
+            obj["dataSize"].numberLong() != _rs->dataSize(opCtx)) {
+            return ignore("the oplog changed since the markers were written");
+        }
+
+        // The oplog must still start and end with the same entries, and every marker must still
+        // fall within it, in increasing order.
+        RecordId earliest;
+        RecordId latest;
+        if (auto record = _rs->getCursor(opCtx, true /* forward */)->next()) {
+            earliest = record->id;
+        }
+        if (auto record = _rs->getCursor(opCtx, false /* forward */)->next()) {
+            latest = record->id;
+        }
+        if (earliest.isNull() || obj["firstRecord"].Long() != earliest.getLong() ||
+            obj["lastRecord"].Long() != latest.getLong()) {
+            return ignore("the first or last oplog entry changed since the markers were written");
+        }
+
+        std::deque<Stone> stones;
+        for (auto&& elem : obj["stones"].Obj()) {
+            auto stone = elem.Obj();
+            RecordId lastRecord(stone["lastRecord"].Long());
+            if (earliest.isNull() || lastRecord < earliest || lastRecord > latest ||
+                (!stones.empty() && lastRecord <= stones.back().lastRecord)) {
+                return ignore("a marker is outside of the oplog");
+            }
+            stones.emplace_back(stone["records"].Long(),
+                                stone["bytes"].Long(),
+                                lastRecord,
+                                stone["wallTime"].Date());
+        }
+
+        _stones = std::move(stones);
+        _currentRecords.store(obj["currentRecords"].Long());
+        _currentBytes.store(obj["currentBytes"].Long());
+    } catch (const DBException& ex) {
+        return ignore(ex.toStatus().reason());
+    }
+
+    _loadedFromFile.store(true);
+    LOGV2(7027510,
+          "Loaded the oplog truncation markers persisted when the oplog was last closed",
+          "numMarkers"_attr = _stones.size());
+    return true;
+}
+
 void WiredTigerRecordStore::OplogStones::_calculateStones(OperationContext* opCtx,
                                                           size_t numStonesToKeep) {
     const std::uint64_t startWaitTime = curTimeMicros64();
@@ -668,7 +829,11 @@ StatusWith<std::string> WiredTigerRecordStore::parseOptionsField(const BSONObj o
 class WiredTigerRecordStore::RandomCursor final : public RecordCursor {
 public:
     RandomCursor(OperationContext* opCtx, const WiredTigerRecordStore& rs, StringData config)
-        : _cursor(nullptr), _rs(&rs), _opCtx(opCtx), _config(config.toString() + ",next_random") {
+        : _cursor(nullptr),
+          _rs(&rs),
+          _opCtx(opCtx),
+          _config(config.toString() + ",next_random"),
+          _recordsPerDescent(std::max(1, gWiredTigerRandomCursorRecordsPerDescent.load())) {
         restore();
     }
 
@@ -682,36 +847,41 @@ public:
     }
 
     boost::optional<Record> next() final {
+        // In block mode, keep walking forward from the last random position until the block is
+        // exhausted or we run off the end of the table.
+        if (_blockRemaining > 0) {
+            --_blockRemaining;
+            int ret = wiredTigerPrepareConflictRetry(
+                _opCtx, [&] { return _blockCursor->next(_blockCursor); });
+            if (ret != WT_NOTFOUND) {
+                invariantWTOK(ret, _blockCursor->session);
+                return _curr(_blockCursor);
+            }
+            _blockRemaining = 0;
+        }
+
         int advanceRet =
             wiredTigerPrepareConflictRetry(_opCtx, [&] { return _cursor->next(_cursor); });
         if (advanceRet == WT_NOTFOUND)
             return {};
         invariantWTOK(advanceRet, _cursor->session);
 
-        RecordId id;
-        if (_rs->keyFormat() == KeyFormat::String) {
-            WT_ITEM item;
-            invariantWTOK(_cursor->get_key(_cursor, &item), _cursor->session);
-            id = RecordId(static_cast<const char*>(item.data), item.size);
-        } else {
-            int64_t key;
-            invariantWTOK(_cursor->get_key(_cursor, &key), _cursor->session);
-            id = RecordId(key);
+        auto record = _curr(_cursor);
+        if (_recordsPerDescent > 1) {
+            _positionBlockCursor(record.id);
         }
-
-        WT_ITEM value;
-        invariantWTOK(_cursor->get_value(_cursor, &value), _cursor->session);
-
-        auto& metricsCollector = ResourceConsumption::MetricsCollector::get(_opCtx);
-
-        auto keyLength = computeRecordIdSize(id);
-        metricsCollector.incrementOneDocRead(value.size + keyLength);
-
-        return {
-            {std::move(id), {static_cast<const char*>(value.data), static_cast<int>(value.size)}}};
+        return record;
     }
 
     void save() final {
+        _blockRemaining = 0;
+        if (_blockCursor) {
+            try {
+                _blockCursor->reset(_blockCursor);
+            } catch (const WriteConflictException&) {
+                // Ignored for the same reason as below.
+            }
+        }
         if (_cursor) {
             try {
                 _cursor->reset(_cursor);
@@ -747,9 +917,16 @@ public:
     void detachFromOperationContext() final {
         invariant(_opCtx);
         _opCtx = nullptr;
-        if (_cursor && !_saveStorageCursorOnDetachFromOperationContext) {
-            invariantWTOK(_cursor->close(_cursor), _cursor->session);
-            _cursor = nullptr;
+        if (!_saveStorageCursorOnDetachFromOperationContext) {
+            _blockRemaining = 0;
+            if (_blockCursor) {
+                invariantWTOK(_blockCursor->close(_blockCursor), _blockCursor->session);
+                _blockCursor = nullptr;
+            }
+            if (_cursor) {
+                invariantWTOK(_cursor->close(_cursor), _cursor->session);
+                _cursor = nullptr;
+            }
         }
     }
 
@@ -763,11 +940,66 @@ public:
     }
 
 private:
+    Record _curr(WT_CURSOR* c) {
+        RecordId id;
+        if (_rs->keyFormat() == KeyFormat::String) {
+            WT_ITEM item;
+            invariantWTOK(c->get_key(c, &item), c->session);
+            id = RecordId(static_cast<const char*>(item.data), item.size);
+        } else {
+            int64_t key;
+            invariantWTOK(c->get_key(c, &key), c->session);
+            id = RecordId(key);
+        }
+
+        WT_ITEM value;
+        invariantWTOK(c->get_value(c, &value), c->session);
+
+        auto& metricsCollector = ResourceConsumption::MetricsCollector::get(_opCtx);
+
+        auto keyLength = computeRecordIdSize(id);
+        metricsCollector.incrementOneDocRead(value.size + keyLength);
+
+        return {
+            {std::move(id), {static_cast<const char*>(value.data), static_cast<int>(value.size)}}};
+    }
+
+    /**
+     * Positions '_blockCursor', a plain sequential cursor, on the record the random cursor just
+     * landed on so the next calls to next() return its physical successors.
+     */
+    void _positionBlockCursor(const RecordId& id) {
+        if (!_blockCursor) {
+            WT_SESSION* session = WiredTigerRecoveryUnit::get(_opCtx)->getSession()->getSession();
+            invariantWTOK(
+                session->open_cursor(session, _rs->_uri.c_str(), nullptr, nullptr, &_blockCursor),
+                session);
+        }
+
+        CursorKey key = makeCursorKey(id, _rs->keyFormat());
+        _rs->setKey(_blockCursor, &key);
+        int ret = wiredTigerPrepareConflictRetry(
+            _opCtx, [&] { return _blockCursor->search(_blockCursor); });
+        if (ret == WT_NOTFOUND) {
+            // The record vanished between the two reads; just take another random descent next.
+            _blockRemaining = 0;
+            return;
+        }
+        invariantWTOK(ret, _blockCursor->session);
+        _blockRemaining = _recordsPerDescent - 1;
+    }
+
     WT_CURSOR* _cursor;
     const WiredTigerRecordStore* _rs;
     OperationContext* _opCtx;
     const std::string _config;
     bool _saveStorageCursorOnDetachFromOperationContext = false;
+
+    // Number of consecutive records returned per random tree descent, and the sequential cursor
+    // used to read all but the first of them.
+    const int _recordsPerDescent;
+    WT_CURSOR* _blockCursor = nullptr;
+    int _blockRemaining = 0;
 };
 
 
@@ -824,6 +1056,10 @@ StatusWith<std::string> WiredTigerRecordStore::generateCreateString(
     if (options.timeseries) {
         // Time-series collections use zstd compression by default.
         ss << WiredTigerGlobalOptions::kDefaultTimeseriesCollectionCompressor;
+    } else if (nss.isOplog() && !wiredTigerGlobalOptions.oplogBlockCompressor.empty()) {
+        // Oplog entries on a page repeat the same field names and namespaces, so a stronger
+        // compressor than the collection default can pay off for the oplog alone.
+        ss << wiredTigerGlobalOptions.oplogBlockCompressor;
     } else {
         // All other collections use the globally configured default.
         ss << wiredTigerGlobalOptions.collectionBlockCompressor;
@@ -971,6 +1207,7 @@ WiredTigerRecordStore::~WiredTigerRecordStore() {
     }
 
     if (_oplogStones) {
+        persistOplogStones();
         _oplogStones->kill();
     }
 
@@ -1011,6 +1248,12 @@ void WiredTigerRecordStore::checkSize(OperationContext* opCtx) {
         _sizeStorer->store(_uri, _sizeInfo);
 }
 
+void WiredTigerRecordStore::persistOplogStones() const {
+    if (_oplogStones) {
+        _oplogStones->persist();
+    }
+}
+
 void WiredTigerRecordStore::postConstructorInit(OperationContext* opCtx) {
     // When starting up with recoverFromOplogAsStandalone=true, the readOnly flag is initially set
     // to false to allow oplog recovery to run and perform its necessary writes. After recovery is
@@ -1549,22 +1792,25 @@ Status WiredTigerRecordStore::doUpdateRecord(OperationContext* opCtx,
     WiredTigerItem value(data, len);
 
     // Check if we should modify rather than doing a full update.  Look for deltas for documents
-    // larger than 1KB, up to 16 changes representing up to 10% of the data.
+    // larger than wiredTigerModifyMinDocumentBytes (1KB by default), up to
+    // wiredTigerModifyMaxEntries changes (16 by default) representing up to
+    // wiredTigerModifyMaxDiffPercent of the data (10% by default).
     //
     // Skip modify for logged tables: don't trust WiredTiger's recovery with operations that are not
     // idempotent.
-    const int kMinLengthForDiff = 1024;
-    const int kMaxEntries = 16;
-    const int kMaxDiffBytes = len / 10;
+    const int minLengthForDiff = gWiredTigerModifyMinDocumentBytes.load();
+    const int maxEntries = gWiredTigerModifyMaxEntries.load();
+    const int maxDiffBytes =
+        static_cast<int>(static_cast<int64_t>(len) * gWiredTigerModifyMaxDiffPercent.load() / 100);
 
     bool skip_update = false;
-    if (!_forceUpdateWithFullDocument && !_isLogged && len > kMinLengthForDiff &&
-        len <= old_length + kMaxDiffBytes) {
-        int nentries = kMaxEntries;
+    if (!_forceUpdateWithFullDocument && !_isLogged && maxEntries > 0 && len > minLengthForDiff &&
+        len <= old_length + maxDiffBytes) {
+        int nentries = maxEntries;
         std::vector<WT_MODIFY> entries(nentries);
 
         if ((ret = wiredtiger_calc_modify(
-                 c->session, &old_value, value.Get(), kMaxDiffBytes, entries.data(), &nentries)) ==
+                 c->session, &old_value, value.Get(), maxDiffBytes, entries.data(), &nentries)) ==
             0) {
             invariantWTOK(WT_OP_CHECK(nentries == 0 ? c->reserve(c)
                                                     : wiredTigerCursorModify(
@@ -2255,6 +2501,36 @@ boost::optional<Record> WiredTigerRecordStoreCursorBase::next() {
     return {{std::move(id), {static_cast<const char*>(value.data), static_cast<int>(value.size)}}};
 }
 
+void WiredTigerRecordStoreCursorBase::nextBatch(size_t n, std::vector<Record>* out) {
+    // The data of a record read from a WT_CURSOR is only valid until the cursor moves, so each
+    // record is copied into a buffer which lives until the next batch. A batch stops growing once
+    // the buffer holds as much as a single maximum-size document.
+    static constexpr int kMaxBatchBytes = BSONObjMaxInternalSize;
+
+    out->clear();
+    _batchBuffer.reset();
+    _batchOffsets.clear();
+
+    // Point the records at their data once the buffer is done moving, including when a read in
+    // the middle of the batch throws.
+    ON_BLOCK_EXIT([&] {
+        for (size_t i = 0; i < out->size(); ++i) {
+            auto& data = (*out)[i].data;
+            data = RecordData(_batchBuffer.buf() + _batchOffsets[i], data.size());
+        }
+    });
+
+    while (out->size() < n && _batchBuffer.len() < kMaxBatchBytes) {
+        auto record = next();
+        if (!record) {
+            break;
+        }
+        _batchOffsets.push_back(_batchBuffer.len());
+        _batchBuffer.appendBuf(record->data.data(), record->data.size());
+        out->push_back({std::move(record->id), RecordData(nullptr, record->data.size())});
+    }
+}
+
 boost::optional<Record> WiredTigerRecordStoreCursorBase::seekExact(const RecordId& id) {
     invariant(_hasRestored);
     if (_readTimestampForOplog && id.getLong() > *_readTimestampForOplog) {
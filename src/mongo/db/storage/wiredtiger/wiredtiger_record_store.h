@@ -32,8 +32,10 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 #include <wiredtiger.h>
 
+#include "mongo/bson/util/builder.h"
 #include "mongo/db/storage/capped_callback.h"
 #include "mongo/db/storage/record_store.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_cursor.h"
@@ -270,6 +272,9 @@ public:
 
     class OplogStones;
 
+    // Writes the oplog truncation markers for the next startup, see 'OplogStones::persist()'.
+    void persistOplogStones() const;
+
     // Exposed only for testing.
     OplogStones* oplogStones() {
         return _oplogStones.get();
@@ -398,6 +403,8 @@ public:
 
     boost::optional<Record> next();
 
+    void nextBatch(size_t n, std::vector<Record>* out) override;
+
     boost::optional<Record> seekExact(const RecordId& id);
 
     boost::optional<Record> seekNear(const RecordId& start);
@@ -455,6 +462,12 @@ private:
      */
     boost::optional<std::int64_t> _readTimestampForOplog = boost::none;
     bool _saveStorageCursorOnDetachFromOperationContext = false;
+
+    // Holds the data of the records returned by the last call to nextBatch(), so that a batch
+    // costs no allocation once the buffer has grown to the size of a typical batch. The offsets
+    // of the records into the buffer are kept separately since the buffer may move as it grows.
+    BufBuilder _batchBuffer;
+    std::vector<int> _batchOffsets;
 };
 
 class WiredTigerRecordStoreStandardCursor final : public WiredTigerRecordStoreCursorBase {
@@ -43,6 +43,14 @@ class RecordId;
 
 // Keep "milestones" against the oplog to efficiently remove the old records when the collection
 // grows beyond its desired maximum size.
+//
+// Stones are rebuilt on startup, either by scanning a small oplog or by taking
+// kRandomSamplesPerStone random samples per expected stone. The number of samples, and so the
+// startup cost, is proportional to the oplog's current data size divided by the stone size;
+// 'maxOplogTruncationPointsDuringStartup' and 'oplogTruncationPointSizeMB' bound it. With
+// 'persistOplogTruncationPoints', the stones are saved when the oplog is closed and loaded on the
+// next startup instead, provided the oplog has not changed in between. The 'oplogTruncation'
+// section of serverStatus reports how long this took and which method was used.
 class WiredTigerRecordStore::OplogStones {
 public:
     struct Stone {
@@ -67,7 +75,10 @@ public:
 
     void getOplogStonesStats(BSONObjBuilder& builder) const {
         builder.append("totalTimeProcessingMicros", _totalTimeProcessing.load());
-        builder.append("processingMethod", _processBySampling.load() ? "sampling" : "scanning");
+        builder.append("processingMethod",
+                       _loadedFromFile.load()
+                           ? "persisted"
+                           : (_processBySampling.load() ? "sampling" : "scanning"));
         if (auto oplogMinRetentionHours = storageGlobalParams.oplogMinRetentionHours.load()) {
             builder.append("oplogMinRetentionHours", oplogMinRetentionHours);
         }
@@ -94,6 +105,11 @@ public:
     // Resize oplog size
     void adjust(int64_t maxSize);
 
+    // Writes the stones to the file read by the next startup, if 'persistOplogTruncationPoints' is
+    // set. Must only be called once no more writes to the oplog can happen, i.e. on clean shutdown
+    // or when the oplog record store is destroyed. Only the first call writes the file.
+    void persist() const;
+
     // The start point of where to truncate next. Used by the background reclaim thread to
     // efficiently truncate records with WiredTiger by skipping over tombstones, etc.
     RecordId firstRecord;
@@ -121,10 +137,15 @@ public:
         return _processBySampling.load();
     }
 
+    bool loadedFromFile() const {
+        return _loadedFromFile.load();
+    }
+
 private:
     class InsertChange;
 
     void _calculateStones(OperationContext* opCtx, size_t size);
+    bool _loadPersistedStones(OperationContext* opCtx);
     void _calculateStonesByScanning(OperationContext* opCtx);
     void _calculateStonesBySampling(OperationContext* opCtx,
                                     int64_t estRecordsPerStone,
@@ -152,6 +173,8 @@ private:
     AtomicWord<int64_t> _totalTimeProcessing;  // Amount of time spent scanning and/or sampling the
                                                // oplog during start up, if any.
     AtomicWord<bool> _processBySampling;       // Whether the oplog was sampled or scanned.
+    AtomicWord<bool> _loadedFromFile;          // Whether the stones were loaded from a file.
+    mutable AtomicWord<bool> _persisted;       // Whether the stones were written to a file.
 
     // Protects against concurrent access to the deque of oplog stones.
     mutable Mutex _mutex = MONGO_MAKE_LATCH("OplogStones::_mutex");
@@ -29,10 +29,13 @@
 
 #include "mongo/platform/basic.h"
 
+#include <boost/filesystem/operations.hpp>
+#include <map>
 #include <memory>
 #include <sstream>
 #include <string>
 #include <time.h>
+#include <vector>
 
 #include "mongo/base/checked_cast.h"
 #include "mongo/base/init.h"
@@ -42,12 +45,15 @@
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/json.h"
 #include "mongo/db/operation_context_noop.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_global_options.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store_oplog_stones.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store_test_harness.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_size_storer.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/unittest/barrier.h"
 #include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
@@ -357,6 +363,13 @@ TEST(WiredTigerRecordStoreTest, AppendCustomNumericStats) {
 
     BSONElement bytesElement = cache.getField("bytes currently in the cache");
     ASSERT_TRUE(bytesElement.isNumber());
+
+    BSONElement residencyElement = wiredTiger.getField("cacheResidency");
+    ASSERT_TRUE(residencyElement.isABSONObj());
+    BSONObj residency = residencyElement.Obj();
+    ASSERT_TRUE(residency["bytesInCache"].isNumber());
+    ASSERT_TRUE(residency["pagesEvicted"].isNumber());
+    ASSERT_FALSE(residency.hasField("errors"));
 }
 
 BSONObj makeBSONObjWithSize(const Timestamp& opTime, int size, char fill = 'x') {
@@ -944,6 +957,103 @@ TEST(WiredTigerRecordStoreTest, OplogStones_Duplicates) {
     }
 }
 
+// Reopens the oplog as on startup, with the size and the visibility it has after a restart.
+std::unique_ptr<RecordStore> reopenOplog(RecordStoreHarnessHelper* harnessHelper,
+                                         long long numRecords,
+                                         long long dataSize,
+                                         Timestamp lastTimestamp) {
+    auto wtHarnessHelper = dynamic_cast<WiredTigerHarnessHelper*>(harnessHelper);
+    std::unique_ptr<RecordStore> rs(wtHarnessHelper->newOplogRecordStoreNoInit());
+    auto wtKvEngine = dynamic_cast<WiredTigerKVEngine*>(harnessHelper->getEngine());
+    wtKvEngine->getOplogManager()->setOplogReadTimestamp(lastTimestamp);
+
+    auto wtrs = static_cast<WiredTigerRecordStore*>(rs.get());
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+    wtrs->setNumRecords(numRecords);
+    wtrs->setDataSize(dataSize);
+    wtrs->postConstructorInit(opCtx.get());
+    return rs;
+}
+
+std::string persistedOplogStonesPath(RecordStoreHarnessHelper* harnessHelper) {
+    auto wtKvEngine = dynamic_cast<WiredTigerKVEngine*>(harnessHelper->getEngine());
+    return (boost::filesystem::path(wtKvEngine->getPath()) / "oplogTruncationPoints.bson").string();
+}
+
+bool loadedFromFile(RecordStore* rs) {
+    return static_cast<WiredTigerRecordStore*>(rs)->oplogStones()->loadedFromFile();
+}
+
+TEST(WiredTigerRecordStoreTest, OplogStones_PersistedOnlyWhileEnabled) {
+    RAIIServerParameterControllerForTest persistEnabled("persistOplogTruncationPoints", true);
+    std::unique_ptr<RecordStoreHarnessHelper> harnessHelper = newRecordStoreHarnessHelper();
+    const auto path = persistedOplogStonesPath(harnessHelper.get());
+
+    std::unique_ptr<RecordStore> rs(harnessHelper->newOplogRecordStore());
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        ASSERT_EQ(insertBSONWithSize(opCtx.get(), rs.get(), Timestamp(1, 0), 100), RecordId(1, 0));
+        ASSERT_EQ(insertBSONWithSize(opCtx.get(), rs.get(), Timestamp(2, 0), 100), RecordId(2, 0));
+    }
+    rs.reset();
+    ASSERT(boost::filesystem::exists(path));
+
+    // The markers are loaded from the file, which is removed once read.
+    rs = reopenOplog(harnessHelper.get(), 2, 200, Timestamp(2, 0));
+    ASSERT(loadedFromFile(rs.get()));
+    ASSERT_FALSE(boost::filesystem::exists(path));
+    rs.reset();
+    ASSERT(boost::filesystem::exists(path));
+
+    {
+        // A startup without the parameter removes the file instead of leaving it behind, and
+        // doesn't write a new one.
+        RAIIServerParameterControllerForTest persistDisabled("persistOplogTruncationPoints", false);
+        rs = reopenOplog(harnessHelper.get(), 2, 200, Timestamp(2, 0));
+        ASSERT_FALSE(loadedFromFile(rs.get()));
+        ASSERT_FALSE(boost::filesystem::exists(path));
+        rs.reset();
+        ASSERT_FALSE(boost::filesystem::exists(path));
+    }
+
+    // So enabling the parameter again finds no file to trust.
+    rs = reopenOplog(harnessHelper.get(), 2, 200, Timestamp(2, 0));
+    ASSERT_FALSE(loadedFromFile(rs.get()));
+}
+
+TEST(WiredTigerRecordStoreTest, OplogStones_StalePersistedFileIsIgnored) {
+    RAIIServerParameterControllerForTest persistEnabled("persistOplogTruncationPoints", true);
+    std::unique_ptr<RecordStoreHarnessHelper> harnessHelper = newRecordStoreHarnessHelper();
+    const auto path = persistedOplogStonesPath(harnessHelper.get());
+    const auto stalePath = path + ".stale";
+
+    std::unique_ptr<RecordStore> rs(harnessHelper->newOplogRecordStore());
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        ASSERT_EQ(insertBSONWithSize(opCtx.get(), rs.get(), Timestamp(1, 0), 100), RecordId(1, 0));
+        ASSERT_EQ(insertBSONWithSize(opCtx.get(), rs.get(), Timestamp(2, 0), 100), RecordId(2, 0));
+    }
+    rs.reset();
+    boost::filesystem::copy_file(path, stalePath);
+
+    rs = reopenOplog(harnessHelper.get(), 2, 200, Timestamp(2, 0));
+    ASSERT(loadedFromFile(rs.get()));
+    {
+        // Replace the last entry with one of the same size, so that only the last entry of the
+        // oplog tells that the file is stale.
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        rs->cappedTruncateAfter(opCtx.get(), RecordId(1, 0), false /* inclusive */);
+        ASSERT_EQ(insertBSONWithSize(opCtx.get(), rs.get(), Timestamp(3, 0), 100), RecordId(3, 0));
+    }
+    rs.reset();
+    boost::filesystem::remove(path);
+    boost::filesystem::rename(stalePath, path);
+
+    rs = reopenOplog(harnessHelper.get(), 2, 200, Timestamp(3, 0));
+    ASSERT_FALSE(loadedFromFile(rs.get()));
+    ASSERT_FALSE(boost::filesystem::exists(path));
+}
+
 TEST(WiredTigerRecordStoreTest, GetLatestOplogTest) {
     unique_ptr<RecordStoreHarnessHelper> harnessHelper(newRecordStoreHarnessHelper());
     unique_ptr<RecordStore> rs(harnessHelper->newOplogRecordStore());
@@ -1033,6 +1143,95 @@ TEST(WiredTigerRecordStoreTest, CursorInActiveTxnAfterNext) {
     }
 }
 
+TEST(WiredTigerRecordStoreTest, RandomCursorBlockModeReturnsConsecutiveRecords) {
+    unique_ptr<RecordStoreHarnessHelper> harnessHelper(newRecordStoreHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newRecordStore());
+
+    const int nToInsert = 2000;
+    std::map<RecordId, std::string> inserted;
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        WriteUnitOfWork uow(opCtx.get());
+        for (int i = 0; i < nToInsert; i++) {
+            const auto data = "record " + std::to_string(i);
+            StatusWith<RecordId> res =
+                rs->insertRecord(opCtx.get(), data.c_str(), data.size() + 1, Timestamp());
+            ASSERT_OK(res.getStatus());
+            inserted.emplace(res.getValue(), data);
+        }
+        uow.commit();
+    }
+    const RecordId lastId = inserted.rbegin()->first;
+
+    const int recordsPerDescent = 4;
+    RAIIServerParameterControllerForTest blockMode("wiredTigerRandomCursorRecordsPerDescent",
+                                                   recordsPerDescent);
+
+    std::vector<RecordId> ids;
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        auto cursor = rs->getRandomCursor(opCtx.get());
+        ASSERT(cursor);
+        for (int i = 0; i < 400; i++) {
+            auto record = cursor->next();
+            ASSERT(record);
+            auto it = inserted.find(record->id);
+            ASSERT(it != inserted.end());
+            ASSERT_EQ(it->second, record->data.data());
+            ids.push_back(record->id);
+        }
+    }
+
+    // Each descent lands on a random record and is followed by its physical successors, until
+    // either the block is full or the end of the table is reached.
+    size_t fullBlocks = 0;
+    for (size_t start = 0; start < ids.size();) {
+        size_t next = start + 1;
+        for (; next < ids.size() && next < start + recordsPerDescent && ids[next - 1] != lastId;
+             ++next) {
+            ASSERT_EQ(ids[next], std::next(inserted.find(ids[next - 1]))->first);
+        }
+        if (next == start + recordsPerDescent) {
+            ++fullBlocks;
+        }
+        start = next;
+    }
+    ASSERT_GT(fullBlocks, 0U);
+}
+
+TEST(WiredTigerRecordStoreTest, RandomCursorBlockModeRestartsAfterSave) {
+    unique_ptr<RecordStoreHarnessHelper> harnessHelper(newRecordStoreHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newRecordStore());
+
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        WriteUnitOfWork uow(opCtx.get());
+        for (int i = 0; i < 100; i++) {
+            ASSERT_OK(rs->insertRecord(opCtx.get(), "data", 5, Timestamp()).getStatus());
+        }
+        uow.commit();
+    }
+
+    RAIIServerParameterControllerForTest blockMode("wiredTigerRandomCursorRecordsPerDescent", 10);
+
+    // Saving and restoring in the middle of a block, including across operation contexts, must
+    // leave the cursor usable.
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+    auto cursor = rs->getRandomCursor(opCtx.get());
+    ASSERT(cursor);
+    for (int i = 0; i < 20; i++) {
+        ASSERT(cursor->next());
+        cursor->save();
+        if (i % 2) {
+            cursor->detachFromOperationContext();
+            opCtx.reset();
+            opCtx = harnessHelper->newOperationContext();
+            cursor->reattachToOperationContext(opCtx.get());
+        }
+        ASSERT_TRUE(cursor->restore());
+    }
+}
+
 TEST(WiredTigerRecordStoreTest, CursorInActiveTxnAfterSeek) {
     unique_ptr<RecordStoreHarnessHelper> harnessHelper(newRecordStoreHarnessHelper());
     unique_ptr<RecordStore> rs(harnessHelper->newRecordStore());
@@ -1201,5 +1400,35 @@ TEST(WiredTigerRecordStoreTest, SizeInfoAccurateAfterRollbackWithDelete) {
     ASSERT_EQ(0, rs->dataSize(ctx.get()));
 }
 
+TEST(WiredTigerRecordStoreTest, OplogBlockCompressor) {
+    const auto generate = [](const NamespaceString& nss) {
+        auto result =
+            WiredTigerRecordStore::generateCreateString(kWiredTigerEngineName,
+                                                        nss,
+                                                        "",
+                                                        CollectionOptions(),
+                                                        "",
+                                                        KeyFormat::Long,
+                                                        WiredTigerUtil::useTableLogging(nss));
+        ASSERT_OK(result.getStatus());
+        return result.getValue();
+    };
+
+    const std::string originalCompressor = wiredTigerGlobalOptions.collectionBlockCompressor;
+    ON_BLOCK_EXIT([&] {
+        wiredTigerGlobalOptions.collectionBlockCompressor = originalCompressor;
+        wiredTigerGlobalOptions.oplogBlockCompressor.clear();
+    });
+    wiredTigerGlobalOptions.collectionBlockCompressor = "snappy";
+
+    // Without an oplog compressor the oplog uses the collection compressor.
+    ASSERT_STRING_CONTAINS(generate(NamespaceString::kRsOplogNamespace),
+                           "block_compressor=snappy,");
+
+    wiredTigerGlobalOptions.oplogBlockCompressor = "zstd";
+    ASSERT_STRING_CONTAINS(generate(NamespaceString::kRsOplogNamespace), "block_compressor=zstd,");
+    ASSERT_STRING_CONTAINS(generate(NamespaceString("test.coll")), "block_compressor=snappy,");
+}
+
 }  // namespace
 }  // namespace mongo
@@ -36,6 +36,7 @@
 #include "mongo/base/checked_cast.h"
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/concurrency/d_concurrency.h"
+#include "mongo/db/storage/control/journal_flusher.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
@@ -102,6 +103,16 @@ BSONObj WiredTigerServerStatusSection::generateSection(OperationContext* opCtx,
                           Timestamp(engine->getOplogManager()->getOplogReadTimestamp()));
     }
 
+    {
+        BSONObjBuilder subsection(bob.subobjStart("writeThrottle"));
+        engine->getWriteThrottle()->appendStats(&subsection);
+    }
+
+    if (auto journalFlusher = JournalFlusher::getIfSet(opCtx->getServiceContext())) {
+        BSONObjBuilder subsection(bob.subobjStart("journalFlusher"));
+        journalFlusher->appendStats(&subsection);
+    }
+
     return bob.obj();
 }
 
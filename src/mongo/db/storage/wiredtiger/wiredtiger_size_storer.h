@@ -37,6 +37,7 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
+#include "mongo/stdx/new.h"
 #include "mongo/util/string_map.h"
 
 namespace mongo {
@@ -59,7 +60,8 @@ public:
      * and their data size. Storing a SizeInfo in the WiredTigerSizeStorer results in shared
      * ownership. The SizeInfo may still be updated after it is stored in the SizeStorer.
      * The 'dirty' field is used by the size storer to cheaply merge duplicate stores of the same
-     * SizeInfo.
+     * SizeInfo: 'store()' returns early while it is set, and 'flush()' clears it before reading
+     * the counters, so every update made before a store is written by some later flush.
      */
     struct SizeInfo {
         SizeInfo() = default;
@@ -73,7 +75,9 @@ public:
 
     private:
         friend WiredTigerSizeStorer;
-        AtomicWord<bool> _dirty;
+        // Every insert and delete updates the counters, while 'store()' mostly only reads '_dirty',
+        // so keep it on its own cache line.
+        alignas(stdx::hardware_destructive_interference_size) AtomicWord<bool> _dirty;
     };
 
     WiredTigerSizeStorer(WT_CONNECTION* conn, const std::string& storageUri, bool readOnly = false);
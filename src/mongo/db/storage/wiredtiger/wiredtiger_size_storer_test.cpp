@@ -32,6 +32,7 @@
 #include "mongo/db/service_context_test_fixture.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_size_storer.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
 
@@ -180,5 +181,46 @@ TEST_F(WiredTigerSizeStorerTest, RemoveNonexistent) {
     ASSERT_EQ(loaded->dataSize.load(), sizeInfo->dataSize.load());
 }
 
+TEST_F(WiredTigerSizeStorerTest, ConcurrentUpdatesStoresAndFlushes) {
+    auto sizeStorer = makeSizeStorer();
+    auto sizeInfo = std::make_shared<WiredTigerSizeStorer::SizeInfo>(1, 10);
+    StringData uri{"uri1"};
+
+    // Writers update the counters and store the SizeInfo, as the record store does, while another
+    // thread keeps flushing. No update may be lost, whichever flush picks it up.
+    const int kNumThreads = 8;
+    const int kUpdatesPerThread = 1000;
+    AtomicWord<int> numWritersDone;
+    stdx::thread flusher([&] {
+        while (numWritersDone.load() < kNumThreads) {
+            sizeStorer.flush(false);
+        }
+    });
+    std::vector<stdx::thread> writers;
+    for (int i = 0; i < kNumThreads; ++i) {
+        writers.emplace_back([&] {
+            for (int j = 0; j < kUpdatesPerThread; ++j) {
+                sizeInfo->numRecords.addAndFetch(1);
+                sizeInfo->dataSize.addAndFetch(2);
+                sizeStorer.store(uri, sizeInfo);
+            }
+            numWritersDone.addAndFetch(1);
+        });
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    flusher.join();
+    sizeStorer.flush(false);
+
+    ASSERT_EQ(sizeInfo->numRecords.load(), 1 + kNumThreads * kUpdatesPerThread);
+    ASSERT_EQ(sizeInfo->dataSize.load(), 10 + 2 * kNumThreads * kUpdatesPerThread);
+
+    auto loaded = sizeStorer.load(uri);
+    ASSERT_NE(loaded, sizeInfo);
+    ASSERT_EQ(loaded->numRecords.load(), sizeInfo->numRecords.load());
+    ASSERT_EQ(loaded->dataSize.load(), sizeInfo->dataSize.load());
+}
+
 }  // namespace
 }  // namespace mongo
@@ -52,16 +52,14 @@ void WiredTigerSnapshotManager::setCommittedSnapshot(const Timestamp& timestamp)
 }
 
 void WiredTigerSnapshotManager::setLastApplied(const Timestamp& timestamp) {
-    stdx::lock_guard<Latch> lock(_lastAppliedMutex);
-    if (timestamp.isNull())
-        _lastApplied = boost::none;
-    else
-        _lastApplied = timestamp;
+    _lastApplied.store(timestamp.asULL());
 }
 
 boost::optional<Timestamp> WiredTigerSnapshotManager::getLastApplied() {
-    stdx::lock_guard<Latch> lock(_lastAppliedMutex);
-    return _lastApplied;
+    Timestamp lastApplied(_lastApplied.load());
+    if (lastApplied.isNull())
+        return boost::none;
+    return lastApplied;
 }
 
 void WiredTigerSnapshotManager::clearCommittedSnapshot() {
@@ -35,6 +35,7 @@
 #include "mongo/bson/timestamp.h"
 #include "mongo/db/storage/snapshot_manager.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_begin_transaction_block.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 
 namespace mongo {
@@ -85,9 +86,10 @@ private:
         MONGO_MAKE_LATCH("WiredTigerSnapshotManager::_committedSnapshotMutex");
     boost::optional<Timestamp> _committedSnapshot;
 
-    // Timestamp to use for reads at a the lastApplied timestamp.
-    mutable Mutex _lastAppliedMutex =  // Guards _lastApplied.
-        MONGO_MAKE_LATCH("WiredTigerSnapshotManager::_lastAppliedMutex");
-    boost::optional<Timestamp> _lastApplied;
+    // Timestamp to use for reads at a the lastApplied timestamp, stored as Timestamp::asULL(). A
+    // null timestamp means there is none. Every secondary read at kNoOverlap or kLastApplied
+    // consults this, so it is published without a lock to keep readers from contending with the
+    // applier that advances it after each batch.
+    AtomicWord<unsigned long long> _lastApplied;
 };
 }  // namespace mongo
@@ -33,10 +33,12 @@
 
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
 
+#include <algorithm>
 #include <limits>
 
 #include <boost/filesystem.hpp>
 #include <boost/filesystem/path.hpp>
+#include <boost/optional.hpp>
 #include <pcrecpp.h>
 
 #include "mongo/base/simple_string_data_comparator.h"
@@ -883,10 +885,7 @@ Status WiredTigerUtil::setTableLogging(OperationContext* opCtx, const std::strin
         return Status::OK();
     }
 
-    // Try to close as much as possible to avoid EBUSY errors.
-    WiredTigerRecoveryUnit::get(opCtx)->getSession()->closeAllCursors(uri);
     WiredTigerSessionCache* sessionCache = WiredTigerRecoveryUnit::get(opCtx)->getSessionCache();
-    sessionCache->closeAllCursors(uri);
 
     const std::string setting = on ? "log=(enabled=true)" : "log=(enabled=false)";
 
@@ -917,6 +916,13 @@ Status WiredTigerUtil::setTableLogging(OperationContext* opCtx, const std::strin
 
     LOGV2_DEBUG(
         22432, 1, "Changing table logging settings", "uri"_attr = uri, "loggingEnabled"_attr = on);
+
+    // Try to close as much as possible to avoid EBUSY errors. This is only needed ahead of an
+    // alter, and sweeping every cached session for each table opened at startup is not free on
+    // nodes with many collections and indexes.
+    WiredTigerRecoveryUnit::get(opCtx)->getSession()->closeAllCursors(uri);
+    sessionCache->closeAllCursors(uri);
+
     // Only alter the metadata once we're sure that we need to change the table settings, since
     // WT_SESSION::alter may return EBUSY and require taking a checkpoint to make progress.
     auto status = sessionCache->getKVEngine()->alterMetadata(uri, setting);
@@ -949,25 +955,11 @@ Status WiredTigerUtil::exportTableToBSON(WT_SESSION* session,
     return exportTableToBSON(session, uri, config, bob, {});
 }
 
-Status WiredTigerUtil::exportTableToBSON(WT_SESSION* session,
-                                         const std::string& uri,
-                                         const std::string& config,
-                                         BSONObjBuilder* bob,
-                                         const std::vector<std::string>& filter) {
-    invariant(session);
-    invariant(bob);
-    WT_CURSOR* c = nullptr;
-    const char* cursorConfig = config.empty() ? nullptr : config.c_str();
-    int ret = session->open_cursor(session, uri.c_str(), nullptr, cursorConfig, &c);
-    if (ret != 0) {
-        return Status(ErrorCodes::CursorNotFound,
-                      str::stream() << "unable to open cursor at URI " << uri
-                                    << ". reason: " << wiredtiger_strerror(ret));
-    }
-    bob->append("uri", uri);
-    invariant(c);
-    ON_BLOCK_EXIT([&] { c->close(c); });
+namespace {
 
+void exportCursorToBSON(WT_CURSOR* c,
+                        BSONObjBuilder* bob,
+                        const std::vector<std::string>& filter) {
     std::map<string, BSONObjBuilder*> subs;
     const char* desc;
     uint64_t value;
@@ -993,7 +985,7 @@ Status WiredTigerUtil::exportTableToBSON(WT_SESSION* session,
             suffix = "num";
         }
 
-        long long v = castStatisticsValue<long long>(value);
+        long long v = WiredTigerUtil::castStatisticsValue<long long>(value);
 
         if (prefix.size() == 0) {
             bob->appendNumber(desc, v);
@@ -1016,6 +1008,112 @@ Status WiredTigerUtil::exportTableToBSON(WT_SESSION* session,
         bob->append(s, it->second->obj());
         delete it->second;
     }
+}
+
+/**
+ * Appends a 'cacheResidency' summary read from the data source statistics cursor 'statsCursor'.
+ * A statistic which cannot be read is reported under 'cacheResidency.errors' and the values
+ * derived from it are omitted; the rest of the summary is still appended.
+ */
+void appendCacheResidency(WT_CURSOR* statsCursor, BSONObjBuilder* builder) {
+    BSONObjBuilder bob(builder->subobjStart("cacheResidency"));
+    BSONObjBuilder errors;
+
+    auto getValue = [&](StringData fieldName, int key) -> boost::optional<long long> {
+        statsCursor->set_key(statsCursor, key);
+        int ret = statsCursor->search(statsCursor);
+        uint64_t value;
+        if (ret == 0) {
+            ret = statsCursor->get_value(statsCursor, nullptr, nullptr, &value);
+        }
+        if (ret != 0) {
+            errors.append(fieldName, wiredtiger_strerror(ret));
+            return boost::none;
+        }
+        return WiredTigerUtil::castStatisticsValue<long long>(value);
+    };
+
+    auto bytesInCache = getValue("bytesInCache", WT_STAT_DSRC_CACHE_BYTES_INUSE);
+    auto fileBytes = getValue("fileBytes", WT_STAT_DSRC_BLOCK_SIZE);
+    auto pagesRequested = getValue("pagesRequested", WT_STAT_DSRC_CACHE_PAGES_REQUESTED);
+    auto pagesRead = getValue("pagesReadIntoCache", WT_STAT_DSRC_CACHE_READ);
+    auto cleanEvicted = getValue("cleanPagesEvicted", WT_STAT_DSRC_CACHE_EVICTION_CLEAN);
+    auto dirtyEvicted = getValue("dirtyPagesEvicted", WT_STAT_DSRC_CACHE_EVICTION_DIRTY);
+
+    if (bytesInCache) {
+        bob.append("bytesInCache", *bytesInCache);
+    }
+    if (fileBytes) {
+        bob.append("fileBytes", *fileBytes);
+    }
+    if (bytesInCache && fileBytes && *fileBytes > 0) {
+        bob.append("inCacheRatio", static_cast<double>(*bytesInCache) / *fileBytes);
+    }
+    if (pagesRequested) {
+        bob.append("pagesRequested", *pagesRequested);
+    }
+    if (pagesRead) {
+        bob.append("pagesReadIntoCache", *pagesRead);
+    }
+    if (pagesRequested && pagesRead && *pagesRequested > 0) {
+        bob.append("hitRatio",
+                   1.0 - static_cast<double>(std::min(*pagesRead, *pagesRequested)) /
+                       *pagesRequested);
+    }
+    if (cleanEvicted && dirtyEvicted) {
+        bob.append("pagesEvicted", *cleanEvicted + *dirtyEvicted);
+    }
+
+    auto errorsObj = errors.done();
+    if (!errorsObj.isEmpty()) {
+        bob.append("errors", errorsObj);
+    }
+}
+
+}  // namespace
+
+Status WiredTigerUtil::exportTableToBSON(WT_SESSION* session,
+                                         const std::string& uri,
+                                         const std::string& config,
+                                         BSONObjBuilder* bob,
+                                         const std::vector<std::string>& filter) {
+    invariant(session);
+    invariant(bob);
+    WT_CURSOR* c = nullptr;
+    const char* cursorConfig = config.empty() ? nullptr : config.c_str();
+    int ret = session->open_cursor(session, uri.c_str(), nullptr, cursorConfig, &c);
+    if (ret != 0) {
+        return Status(ErrorCodes::CursorNotFound,
+                      str::stream() << "unable to open cursor at URI " << uri
+                                    << ". reason: " << wiredtiger_strerror(ret));
+    }
+    bob->append("uri", uri);
+    invariant(c);
+    ON_BLOCK_EXIT([&] { c->close(c); });
+
+    exportCursorToBSON(c, bob, filter);
+    return Status::OK();
+}
+
+Status WiredTigerUtil::exportTableStatisticsToBSON(WT_SESSION* session,
+                                                   const std::string& uri,
+                                                   BSONObjBuilder* bob) {
+    invariant(session);
+    invariant(bob);
+    const std::string statsURI = "statistics:" + uri;
+    WT_CURSOR* c = nullptr;
+    int ret = session->open_cursor(session, statsURI.c_str(), nullptr, "statistics=(fast)", &c);
+    if (ret != 0) {
+        return Status(ErrorCodes::CursorNotFound,
+                      str::stream() << "unable to open cursor at URI " << statsURI
+                                    << ". reason: " << wiredtiger_strerror(ret));
+    }
+    bob->append("uri", statsURI);
+    invariant(c);
+    ON_BLOCK_EXIT([&] { c->close(c); });
+
+    exportCursorToBSON(c, bob, {});
+    appendCacheResidency(c, bob);
     return Status::OK();
 }
 
@@ -184,6 +184,17 @@ public:
                                     BSONObjBuilder* bob,
                                     const std::vector<std::string>& filter);
 
+    /**
+     * Exports the fast statistics of the table 'uri' like exportTableToBSON() does for
+     * "statistics:" + 'uri', then appends a 'cacheResidency' summary of how much of the table is
+     * held in the cache and how often its pages are found there, read from the same cursor. The
+     * in-memory form of a page is larger than its compressed on-disk form, so 'inCacheRatio' may
+     * exceed 1 for a table which is entirely cached.
+     */
+    static Status exportTableStatisticsToBSON(WT_SESSION* s,
+                                              const std::string& uri,
+                                              BSONObjBuilder* bob);
+
     /**
      * Creates an import configuration string suitable for the 'config' parameter in
      * WT_SESSION::create() given the storage engines metadata retrieved during the export.
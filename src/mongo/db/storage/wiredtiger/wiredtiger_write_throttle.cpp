@@ -0,0 +1,141 @@
+/**
+ *    Copyright (C) 2022-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kStorage
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_write_throttle.h"
+
+#include <algorithm>
+
+#include "mongo/db/operation_context.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_parameters_gen.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/logv2/log.h"
+#include "mongo/util/clock_source.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+Milliseconds WiredTigerWriteThrottle::computeDelay(double ratio,
+                                                   double threshold,
+                                                   Milliseconds maxDelay) {
+    if (threshold <= 0.0 || ratio <= threshold) {
+        return Milliseconds(0);
+    }
+
+    const double fraction = std::min(1.0, (ratio - threshold) / threshold);
+    return Milliseconds(static_cast<long long>(fraction * durationCount<Milliseconds>(maxDelay)));
+}
+
+void WiredTigerWriteThrottle::throttle(OperationContext* opCtx,
+                                       WiredTigerSessionCache* sessionCache) {
+    const double dirtyThreshold = gWiredTigerWriteThrottleDirtyThreshold.load();
+    const double updatesThreshold = gWiredTigerWriteThrottleUpdatesThreshold.load();
+    if (dirtyThreshold <= 0.0 && updatesThreshold <= 0.0) {
+        return;
+    }
+
+    // Only the writer that advances the sample time refreshes the sample, so that a burst of
+    // writers does not all open statistics cursors at once.
+    const long long now = _clockSource->now().toMillisSinceEpoch();
+    long long lastSample = _lastSampleMillis.load();
+    if (now - lastSample >= durationCount<Milliseconds>(kSampleInterval) &&
+        _lastSampleMillis.compareAndSwap(&lastSample, now)) {
+        auto session = sessionCache->getSession();
+        _sample(session->getSession());
+    }
+
+    const Milliseconds maxDelay{gWiredTigerWriteThrottleMaxDelayMillis.load()};
+    const auto dirtyDelay = computeDelay(_dirtyRatio.load(), dirtyThreshold, maxDelay);
+    const auto updatesDelay = computeDelay(_updatesRatio.load(), updatesThreshold, maxDelay);
+    if (dirtyDelay <= Milliseconds(0) && updatesDelay <= Milliseconds(0)) {
+        return;
+    }
+
+    // Attribute the stall to whichever ratio called for the longer delay.
+    const bool dirtyIsCause = dirtyDelay >= updatesDelay;
+    const auto delay = dirtyIsCause ? dirtyDelay : updatesDelay;
+    opCtx->sleepFor(delay);
+
+    const auto micros = durationCount<Microseconds>(delay);
+    if (dirtyIsCause) {
+        _dirtyStalls.fetchAndAddRelaxed(1);
+        _dirtyStallMicros.fetchAndAddRelaxed(micros);
+    } else {
+        _updatesStalls.fetchAndAddRelaxed(1);
+        _updatesStallMicros.fetchAndAddRelaxed(micros);
+    }
+}
+
+void WiredTigerWriteThrottle::_sample(WT_SESSION* session) {
+    auto maxBytes = WiredTigerUtil::getStatisticsValue(
+        session, "statistics:", "", WT_STAT_CONN_CACHE_BYTES_MAX);
+    auto dirtyBytes = WiredTigerUtil::getStatisticsValue(
+        session, "statistics:", "", WT_STAT_CONN_CACHE_BYTES_DIRTY);
+    auto updatesBytes = WiredTigerUtil::getStatisticsValue(
+        session, "statistics:", "", WT_STAT_CONN_CACHE_BYTES_UPDATES);
+    if (!maxBytes.isOK() || !dirtyBytes.isOK() || !updatesBytes.isOK() ||
+        maxBytes.getValue() <= 0) {
+        // Keep throttling on the previous sample rather than failing the write.
+        LOGV2_DEBUG(7027200,
+                    2,
+                    "Unable to sample the WiredTiger cache for write throttling",
+                    "maxBytes"_attr = maxBytes.getStatus(),
+                    "dirtyBytes"_attr = dirtyBytes.getStatus(),
+                    "updatesBytes"_attr = updatesBytes.getStatus());
+        return;
+    }
+
+    const double max = static_cast<double>(maxBytes.getValue());
+    _dirtyRatio.store(dirtyBytes.getValue() / max);
+    _updatesRatio.store(updatesBytes.getValue() / max);
+}
+
+void WiredTigerWriteThrottle::appendStats(BSONObjBuilder* builder) const {
+    builder->append("cacheDirtyRatio", _dirtyRatio.load());
+    builder->append("cacheUpdatesRatio", _updatesRatio.load());
+    {
+        BSONObjBuilder stalls(builder->subobjStart("stalls"));
+        {
+            BSONObjBuilder dirty(stalls.subobjStart("cacheDirty"));
+            dirty.append("count", _dirtyStalls.load());
+            dirty.append("totalMicros", _dirtyStallMicros.load());
+        }
+        {
+            BSONObjBuilder updates(stalls.subobjStart("cacheUpdates"));
+            updates.append("count", _updatesStalls.load());
+            updates.append("totalMicros", _updatesStallMicros.load());
+        }
+    }
+}
+
+}  // namespace mongo
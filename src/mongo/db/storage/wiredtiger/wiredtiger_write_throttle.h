@@ -0,0 +1,93 @@
+/**
+ *    Copyright (C) 2022-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <wiredtiger.h>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/duration.h"
+
+namespace mongo {
+
+class ClockSource;
+class OperationContext;
+class WiredTigerSessionCache;
+
+/**
+ * Delays writers while the WiredTiger cache holds a large fraction of dirty data or of updates, so
+ * that they slow down smoothly before the cache reaches the eviction triggers at which application
+ * threads are drafted into eviction. Writers are delayed as they are about to take the global lock
+ * in MODE_IX, alongside flow control, so a delayed writer holds no locks and no snapshot.
+ *
+ * The cache ratios are sampled from the connection statistics at most once per sampling interval,
+ * by whichever writer first finds the previous sample stale. For each ratio the delay grows
+ * linearly from zero at the configured threshold to 'wiredTigerWriteThrottleMaxDelayMillis' at
+ * twice the threshold. A threshold of zero disables throttling on that ratio.
+ */
+class WiredTigerWriteThrottle {
+public:
+    static constexpr Milliseconds kSampleInterval{100};
+
+    explicit WiredTigerWriteThrottle(ClockSource* clockSource) : _clockSource(clockSource) {}
+
+    /**
+     * Returns how long a writer should be delayed when 'ratio' of the cache is in the state
+     * limited by 'threshold'.
+     */
+    static Milliseconds computeDelay(double ratio, double threshold, Milliseconds maxDelay);
+
+    /**
+     * Sleeps for the delay called for by the most recent cache sample, refreshing the sample
+     * first if it is stale using a session from 'sessionCache'. The sleep is interruptible.
+     */
+    void throttle(OperationContext* opCtx, WiredTigerSessionCache* sessionCache);
+
+    /**
+     * Reports the last sampled cache ratios and the time writers spent stalled, by cause.
+     */
+    void appendStats(BSONObjBuilder* builder) const;
+
+private:
+    void _sample(WT_SESSION* session);
+
+    ClockSource* const _clockSource;
+
+    AtomicWord<long long> _lastSampleMillis{0};
+    AtomicWord<double> _dirtyRatio{0.0};
+    AtomicWord<double> _updatesRatio{0.0};
+
+    AtomicWord<long long> _dirtyStalls{0};
+    AtomicWord<long long> _dirtyStallMicros{0};
+    AtomicWord<long long> _updatesStalls{0};
+    AtomicWord<long long> _updatesStallMicros{0};
+};
+
+}  // namespace mongo
@@ -43,6 +43,7 @@
 #include "mongo/platform/compiler.h"
 #include "mongo/stdx/thread.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 namespace {
@@ -77,6 +78,13 @@ OperationId getOpId(OperationContext* opCtx,
     MONGO_UNREACHABLE;
 }
 
+/**
+ * Whether a bucket closed with 'numMeasurements' measurements counts towards fragmentation.
+ */
+bool isSmallBucket(uint32_t numMeasurements) {
+    return numMeasurements < static_cast<uint32_t>(gTimeseriesSmallBucketMaxCount.load());
+}
+
 BSONObj buildControlMinTimestampDoc(StringData timeField, Date_t roundedTime) {
     BSONObjBuilder builder;
     builder.append(timeField, roundedTime);
@@ -187,6 +195,11 @@ void BucketCatalog::ExecutionStatsController::incNumBucketsClosedDueToMemoryThre
     _globalStats->numBucketsClosedDueToMemoryThreshold.fetchAndAddRelaxed(increment);
 }
 
+void BucketCatalog::ExecutionStatsController::incNumSmallBucketsClosed(long long increment) {
+    _collectionStats->numSmallBucketsClosed.fetchAndAddRelaxed(increment);
+    _globalStats->numSmallBucketsClosed.fetchAndAddRelaxed(increment);
+}
+
 void BucketCatalog::ExecutionStatsController::incNumCommits(long long increment) {
     _collectionStats->numCommits.fetchAndAddRelaxed(increment);
     _globalStats->numCommits.fetchAndAddRelaxed(increment);
@@ -543,7 +556,7 @@ BucketCatalog& BucketCatalog::get(OperationContext* opCtx) {
 
 BSONObj BucketCatalog::getMetadata(const BucketHandle& handle) const {
     auto const& stripe = _stripes[handle.stripe];
-    stdx::lock_guard stripeLock{stripe.mutex};
+    auto stripeLock = _lockStripe(stripe);
 
     const Bucket* bucket = _findBucket(stripe, stripeLock, handle.id);
     if (!bucket) {
@@ -586,7 +599,7 @@ StatusWith<BucketCatalog::InsertResult> BucketCatalog::insert(
     CreationInfo info{key, stripeNumber, time, options, stats, &closedBuckets};
 
     auto& stripe = _stripes[stripeNumber];
-    stdx::lock_guard stripeLock{stripe.mutex};
+    auto stripeLock = _lockStripe(stripe);
 
     Bucket* bucket = _useOrCreateBucket(&stripe, stripeLock, info);
     invariant(bucket);
@@ -679,7 +692,7 @@ Status BucketCatalog::prepareCommit(std::shared_ptr<WriteBatch> batch) {
     auto& stripe = _stripes[batch->bucket().stripe];
     _waitToCommitBatch(&stripe, batch);
 
-    stdx::lock_guard stripeLock{stripe.mutex};
+    auto stripeLock = _lockStripe(stripe);
     Bucket* bucket =
         _useBucketInState(&stripe, stripeLock, batch->bucket().id, BucketState::kPrepared);
 
@@ -711,7 +724,7 @@ boost::optional<BucketCatalog::ClosedBucket> BucketCatalog::finish(
     batch->_finish(info);
 
     auto& stripe = _stripes[batch->bucket().stripe];
-    stdx::lock_guard stripeLock{stripe.mutex};
+    auto stripeLock = _lockStripe(stripe);
 
     Bucket* bucket =
         _useBucketInState(&stripe, stripeLock, batch->bucket().id, BucketState::kNormal);
@@ -784,7 +797,7 @@ void BucketCatalog::abort(std::shared_ptr<WriteBatch> batch, const Status& statu
     }
 
     auto& stripe = _stripes[batch->bucket().stripe];
-    stdx::lock_guard stripeLock{stripe.mutex};
+    auto stripeLock = _lockStripe(stripe);
 
     _abort(&stripe, stripeLock, batch, status);
 }
@@ -799,7 +812,7 @@ void BucketCatalog::clear(const OID& oid) {
 
 void BucketCatalog::clear(const std::function<bool(const NamespaceString&)>& shouldClear) {
     for (auto& stripe : _stripes) {
-        stdx::lock_guard stripeLock{stripe.mutex};
+        auto stripeLock = _lockStripe(stripe);
         for (auto it = stripe.allBuckets.begin(); it != stripe.allBuckets.end();) {
             auto nextIt = std::next(it);
 
@@ -845,6 +858,17 @@ void BucketCatalog::_appendExecutionStatsToBuilder(const ExecutionStats* stats,
                           stats->numBucketsClosedDueToTimeBackward.load());
     builder->appendNumber("numBucketsClosedDueToMemoryThreshold",
                           stats->numBucketsClosedDueToMemoryThreshold.load());
+    auto smallBucketsClosed = stats->numSmallBucketsClosed.load();
+    builder->appendNumber("numSmallBucketsClosed", smallBucketsClosed);
+    auto bucketsClosed = stats->numBucketsClosedDueToCount.load() +
+        stats->numBucketsClosedDueToSchemaChange.load() + stats->numBucketsClosedDueToSize.load() +
+        stats->numBucketsClosedDueToTimeForward.load() +
+        stats->numBucketsClosedDueToTimeBackward.load() +
+        stats->numBucketsClosedDueToMemoryThreshold.load();
+    if (bucketsClosed) {
+        builder->append("bucketFragmentationRatio",
+                        static_cast<double>(smallBucketsClosed) / bucketsClosed);
+    }
     auto commits = stats->numCommits.load();
     builder->appendNumber("numCommits", commits);
     builder->appendNumber("numWaits", stats->numWaits.load());
@@ -919,6 +943,24 @@ BucketCatalog::StripeNumber BucketCatalog::_getStripeNumber(const BucketKey& key
     return key.hash % kNumberOfStripes;
 }
 
+stdx::unique_lock<Latch> BucketCatalog::_lockStripe(const Stripe& stripe) const {
+    static thread_local const std::size_t counterShard =
+        std::hash<stdx::thread::id>{}(stdx::this_thread::get_id()) %
+        kNumberOfStripeLockCounterShards;
+    auto& counters = _stripeLockCounters[counterShard];
+    const std::size_t stripeNumber = &stripe - _stripes.data();
+
+    counters.numAcquisitions[stripeNumber].fetchAndAddRelaxed(1);
+    stdx::unique_lock<Latch> lk{stripe.mutex, stdx::try_to_lock};
+    if (!lk.owns_lock()) {
+        Timer timer;
+        lk.lock();
+        counters.numContentions[stripeNumber].fetchAndAddRelaxed(1);
+        counters.waitMicros[stripeNumber].fetchAndAddRelaxed(timer.micros());
+    }
+    return lk;
+}
+
 const BucketCatalog::Bucket* BucketCatalog::_findBucket(const Stripe& stripe,
                                                         WithLock,
                                                         const OID& id,
@@ -989,7 +1031,7 @@ void BucketCatalog::_waitToCommitBatch(Stripe* stripe, const std::shared_ptr<Wri
         std::shared_ptr<WriteBatch> current;
 
         {
-            stdx::lock_guard stripeLock{stripe->mutex};
+            auto stripeLock = _lockStripe(*stripe);
             Bucket* bucket =
                 _useBucket(stripe, stripeLock, batch->bucket().id, ReturnClearedBuckets::kNo);
             if (!bucket || batch->finished()) {
@@ -1105,12 +1147,26 @@ void BucketCatalog::_expireIdleBuckets(Stripe* stripe,
     while (!stripe->idleBuckets.empty() &&
            _memoryUsage.load() > getTimeseriesIdleBucketExpiryMemoryUsageThresholdBytes() &&
            numClosed <= gTimeseriesIdleBucketExpiryMaxCountPerAttempt) {
-        Bucket* bucket = stripe->idleBuckets.back();
+        // Among the least recently used candidates, close the one pinning the most memory so that
+        // pressure is relieved with as few (and as full) closed buckets as possible.
+        auto it = stripe->idleBuckets.rbegin();
+        Bucket* bucket = *it;
+        for (int i = 1; i < gTimeseriesIdleBucketExpiryCandidates.load() &&
+             ++it != stripe->idleBuckets.rend();
+             ++i) {
+            if ((*it)->_memoryUsage > bucket->_memoryUsage) {
+                bucket = *it;
+            }
+        }
+
         ClosedBucket closed{
             bucket->id(), bucket->getTimeField().toString(), bucket->numMeasurements()};
 
         if (_removeBucket(stripe, stripeLock, bucket)) {
             stats.incNumBucketsClosedDueToMemoryThreshold();
+            if (isSmallBucket(closed.numMeasurements)) {
+                stats.incNumSmallBucketsClosed();
+            }
             closedBuckets->push_back(closed);
             ++numClosed;
         }
@@ -1167,7 +1223,9 @@ BucketCatalog::Bucket* BucketCatalog::_rollover(Stripe* stripe,
                                                 WithLock stripeLock,
                                                 Bucket* bucket,
                                                 const CreationInfo& info) {
-
+    if (isSmallBucket(bucket->numMeasurements())) {
+        info.stats.incNumSmallBucketsClosed();
+    }
     if (bucket->allCommitted()) {
         // The bucket does not contain any measurements that are yet to be committed, so we can
         // remove it now.
@@ -1291,6 +1349,38 @@ class BucketCatalog::ServerStatus : public ServerStatusSection {
         return sum;
     }
 
+    void _appendStripeContention(const BucketCatalog& catalog, BSONObjBuilder* builder) const {
+        long long acquisitions = 0;
+        long long contentions = 0;
+        long long waitMicros = 0;
+        BSONArrayBuilder perStripe;
+        for (std::size_t i = 0; i < kNumberOfStripes; ++i) {
+            long long stripeAcquisitions = 0;
+            long long stripeContentions = 0;
+            long long stripeWaitMicros = 0;
+            for (auto const& counters : catalog._stripeLockCounters) {
+                stripeAcquisitions += counters.numAcquisitions[i].load();
+                stripeContentions += counters.numContentions[i].load();
+                stripeWaitMicros += counters.waitMicros[i].load();
+            }
+            acquisitions += stripeAcquisitions;
+            contentions += stripeContentions;
+            waitMicros += stripeWaitMicros;
+
+            BSONObjBuilder stripeBuilder{perStripe.subobjStart()};
+            stripeBuilder.appendNumber("acquisitions", stripeAcquisitions);
+            stripeBuilder.appendNumber("contended", stripeContentions);
+            stripeBuilder.appendNumber("waitMicros", stripeWaitMicros);
+        }
+
+        BSONObjBuilder contentionBuilder{builder->subobjStart("stripeContention")};
+        contentionBuilder.appendNumber("numStripes", static_cast<long long>(kNumberOfStripes));
+        contentionBuilder.appendNumber("acquisitions", acquisitions);
+        contentionBuilder.appendNumber("contended", contentions);
+        contentionBuilder.appendNumber("waitMicros", waitMicros);
+        contentionBuilder.append("stripes", perStripe.arr());
+    }
+
 public:
     ServerStatus() : ServerStatusSection("bucketCatalog") {}
 
@@ -1318,6 +1408,8 @@ public:
         // Append the global execution stats for all namespaces.
         bucketCatalog.appendGlobalExecutionStats(&builder);
 
+        _appendStripeContention(bucketCatalog, &builder);
+
         return builder.obj();
     }
 } bucketCatalogServerStatus;
@@ -39,6 +39,8 @@
 #include "mongo/db/timeseries/flat_bson.h"
 #include "mongo/db/timeseries/timeseries_gen.h"
 #include "mongo/db/views/view.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/new.h"
 #include "mongo/stdx/unordered_map.h"
 #include "mongo/stdx/unordered_set.h"
 #include "mongo/util/string_map.h"
@@ -67,6 +69,7 @@ class BucketCatalog {
         AtomicWord<long long> numBucketsClosedDueToTimeForward;
         AtomicWord<long long> numBucketsClosedDueToTimeBackward;
         AtomicWord<long long> numBucketsClosedDueToMemoryThreshold;
+        AtomicWord<long long> numSmallBucketsClosed;
         AtomicWord<long long> numCommits;
         AtomicWord<long long> numWaits;
         AtomicWord<long long> numMeasurementsCommitted;
@@ -88,6 +91,7 @@ class BucketCatalog {
         void incNumBucketsClosedDueToTimeForward(long long increment = 1);
         void incNumBucketsClosedDueToTimeBackward(long long increment = 1);
         void incNumBucketsClosedDueToMemoryThreshold(long long increment = 1);
+        void incNumSmallBucketsClosed(long long increment = 1);
         void incNumCommits(long long increment = 1);
         void incNumWaits(long long increment = 1);
         void incNumMeasurementsCommitted(long long increment = 1);
@@ -416,6 +420,12 @@ private:
 
     StripeNumber _getStripeNumber(const BucketKey& key);
 
+    /**
+     * Acquires 'stripe.mutex', recording whether the acquisition had to wait for another thread
+     * and for how long.
+     */
+    stdx::unique_lock<Latch> _lockStripe(const Stripe& stripe) const;
+
     /**
      * Mode enum to control whether the bucket retrieval methods below will return buckets that are
      * in kCleared or kPreparedAndCleared state.
@@ -549,6 +559,20 @@ private:
     static constexpr std::size_t kNumberOfStripes = 32;
     std::array<Stripe, kNumberOfStripes> _stripes;
 
+    // Contention counters for the stripe mutexes, updated by _lockStripe() and reported in
+    // serverStatus. Each thread only updates the shard its id hashes to, so threads locking
+    // different stripes do not contend on the cache lines of the counters. The catalog is a
+    // decoration, which is not guaranteed to be over-aligned, so the shards are padded rather than
+    // aligned.
+    struct StripeLockCounters {
+        std::array<AtomicWord<long long>, kNumberOfStripes> numAcquisitions;
+        std::array<AtomicWord<long long>, kNumberOfStripes> numContentions;
+        std::array<AtomicWord<long long>, kNumberOfStripes> waitMicros;
+        char padding[stdx::hardware_destructive_interference_size];
+    };
+    static constexpr std::size_t kNumberOfStripeLockCounterShards = 16;
+    mutable std::array<StripeLockCounters, kNumberOfStripeLockCounterShards> _stripeLockCounters;
+
     mutable Mutex _mutex =
         MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(0), "BucketCatalog::_mutex");
 
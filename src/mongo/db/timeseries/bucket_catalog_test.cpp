@@ -31,6 +31,7 @@
 #include "mongo/db/catalog/catalog_test_fixture.h"
 #include "mongo/db/catalog/create_collection.h"
 #include "mongo/db/catalog_raii.h"
+#include "mongo/db/commands/server_status.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/timeseries/bucket_catalog.h"
 #include "mongo/stdx/future.h"
@@ -288,6 +289,57 @@ TEST_F(BucketCatalogTest, GetMetadataReturnsEmptyDocOnMissingBucket) {
     ASSERT_BSONOBJ_EQ(BSONObj(), _bucketCatalog->getMetadata(bucket));
 }
 
+TEST_F(BucketCatalogTest, ServerStatusReportsStripeContention) {
+    auto result = _bucketCatalog->insert(_opCtx,
+                                         _ns1,
+                                         _getCollator(_ns1),
+                                         _getTimeseriesOptions(_ns1),
+                                         BSON(_timeField << Date_t::now()),
+                                         BucketCatalog::CombineWithInsertsFromOtherClients::kAllow);
+    ASSERT_OK(result.getStatus());
+    auto batch = result.getValue().batch;
+    ASSERT(batch->claimCommitRights());
+    _bucketCatalog->abort(batch, {ErrorCodes::TimeseriesBucketCleared, ""});
+
+    auto* registry = ServerStatusSectionRegistry::get();
+    auto it = std::find_if(registry->begin(), registry->end(), [](const auto& entry) {
+        return entry.first == "bucketCatalog";
+    });
+    ASSERT(it != registry->end());
+
+    auto section = it->second->generateSection(_opCtx, BSONElement());
+    auto contention = section.getObjectField("stripeContention");
+    ASSERT_EQ(contention.getIntField("numStripes"), 32);
+    ASSERT_GTE(contention.getIntField("acquisitions"), 2);
+    ASSERT_LTE(contention.getIntField("contended"), contention.getIntField("acquisitions"));
+    ASSERT_EQ(contention.getObjectField("stripes").nFields(), 32);
+}
+
+TEST_F(BucketCatalogTest, SmallClosedBucketsReportedAsFragmentation) {
+    _bucketCatalog->clear(_ns1);
+    ScopeGuard guard([this]() { _bucketCatalog->clear(_ns1); });
+
+    auto now = Date_t::now();
+    for (auto time : {now, now - Hours(1)}) {
+        ASSERT_OK(_bucketCatalog
+                      ->insert(_opCtx,
+                               _ns1,
+                               _getCollator(_ns1),
+                               _getTimeseriesOptions(_ns1),
+                               BSON(_timeField << time),
+                               BucketCatalog::CombineWithInsertsFromOtherClients::kAllow)
+                      .getStatus());
+    }
+
+    // Going back in time closed the first bucket while it held a single measurement.
+    BSONObjBuilder builder;
+    _bucketCatalog->appendExecutionStats(_ns1, &builder);
+    auto stats = builder.obj();
+    ASSERT_EQ(stats.getIntField("numBucketsClosedDueToTimeBackward"), 1);
+    ASSERT_EQ(stats.getIntField("numSmallBucketsClosed"), 1);
+    ASSERT_EQ(stats.getField("bucketFragmentationRatio").numberDouble(), 1.0);
+}
+
 TEST_F(BucketCatalogTest, InsertIntoDifferentBuckets) {
     auto result1 =
         _bucketCatalog->insert(_opCtx,
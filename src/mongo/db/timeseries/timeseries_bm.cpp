@@ -0,0 +1,252 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/db/client.h"
+#include "mongo/db/dbdirectclient.h"
+#include "mongo/db/ops/write_ops.h"
+#include "mongo/db/pipeline/aggregate_command_gen.h"
+#include "mongo/db/service_context_d_bm_fixture.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/platform/random.h"
+#include "mongo/stdx/unordered_set.h"
+
+namespace mongo {
+namespace {
+
+const StringData kDbName = "timeseries_bm"_sd;
+const int kMaxThreads = 32;
+const int kMeasurementsPerInsert = 100;
+const Date_t kStartTime = Date_t::fromMillisSinceEpoch(1'600'000'000'000LL);
+
+// The query dataset: kQueryMetas series with one measurement per second each.
+const int kQueryMetas = 100;
+const int kQueryMeasurementsPerMeta = 1000;
+
+/**
+ * The environment shared by every benchmark and every benchmark thread in this binary. Time-series
+ * inserts go through the insert command, the BucketCatalog and its commit path exactly as they do
+ * in a server, and queries are rewritten to unpack buckets with $_internalUnpackBucket.
+ */
+class TimeseriesBenchmarkEnvironment : public ServiceContextMongoDBenchmarkFixture {
+public:
+    static TimeseriesBenchmarkEnvironment& get() {
+        return getShared<TimeseriesBenchmarkEnvironment>();
+    }
+
+    /**
+     * Creates the time-series collection 'coll' if no benchmark thread has created it yet.
+     * Returns true if this call created it.
+     */
+    bool ensureCollection(DBDirectClient& client, const std::string& coll) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        if (!_collections.insert(coll).second) {
+            return false;
+        }
+        BSONObj info;
+        invariant(client.runCommand(kDbName.toString(),
+                                    BSON("create" << coll << "timeseries"
+                                                  << BSON("timeField"
+                                                          << "t"
+                                                          << "metaField"
+                                                          << "m")),
+                                    info),
+                  info.toString());
+        return true;
+    }
+
+private:
+    Mutex _mutex = MONGO_MAKE_LATCH("TimeseriesBenchmarkEnvironment::_mutex");
+    stdx::unordered_set<std::string> _collections;
+};
+
+/**
+ * Per-thread Client, OperationContext and DBDirectClient. The main thread reuses the
+ * environment's Client.
+ */
+class TimeseriesBenchmarkThread {
+public:
+    TimeseriesBenchmarkThread() {
+        auto service = TimeseriesBenchmarkEnvironment::get().getServiceContext();
+        if (!haveClient()) {
+            _threadClient.emplace(service);
+        }
+        _opCtx = cc().makeOperationContext();
+        _client.emplace(_opCtx.get());
+    }
+
+    DBDirectClient& client() {
+        return *_client;
+    }
+
+private:
+    boost::optional<ThreadClient> _threadClient;
+    ServiceContext::UniqueOperationContext _opCtx;
+    boost::optional<DBDirectClient> _client;
+};
+
+void insertMeasurements(DBDirectClient& client,
+                        const std::string& coll,
+                        std::vector<BSONObj> measurements) {
+    write_ops::InsertCommandRequest insertOp(NamespaceString(kDbName, coll));
+    insertOp.setDocuments(std::move(measurements));
+    insertOp.getWriteCommandRequestBase().setOrdered(false);
+    auto reply = client.insert(insertOp);
+    invariant(!reply.getWriteErrors());
+}
+
+/**
+ * Every thread inserts batches of kMeasurementsPerInsert measurements whose meta value is drawn
+ * from state.range(0) distinct values. state.range(1) percent of the measurements are back-dated
+ * by up to an hour, which forces them into older or new buckets instead of the open one.
+ *
+ * Reports the ingest rate per thread (and so per core, up to the number of cores) and, from thread
+ * 0, the size of the buckets collection divided by the number of measurements inserted.
+ */
+void BM_Ingest(benchmark::State& state) {
+    const int metaCardinality = state.range(0);
+    const int outOfOrderPercent = state.range(1);
+    const std::string coll = str::stream() << "ingest_" << metaCardinality << "_"
+                                           << outOfOrderPercent << "_" << state.threads;
+
+    TimeseriesBenchmarkThread thread;
+    TimeseriesBenchmarkEnvironment::get().ensureCollection(thread.client(), coll);
+
+    PseudoRandom random(state.thread_index);
+    long long nextSecond = 0;
+    for (auto keepRunning : state) {
+        std::vector<BSONObj> measurements;
+        measurements.reserve(kMeasurementsPerInsert);
+        for (int i = 0; i < kMeasurementsPerInsert; ++i) {
+            auto time = kStartTime + Seconds(nextSecond++);
+            if (random.nextInt32(100) < outOfOrderPercent) {
+                time -= Seconds(random.nextInt32(3600));
+            }
+            measurements.push_back(BSON("t" << time << "m" << random.nextInt32(metaCardinality)
+                                            << "v" << random.nextCanonicalDouble()));
+        }
+        insertMeasurements(thread.client(), coll, std::move(measurements));
+    }
+
+    state.counters["measurementsPerThread"] = benchmark::Counter(
+        state.iterations() * kMeasurementsPerInsert, benchmark::Counter::kAvgThreadsRate);
+
+    // The benchmark loop only exits once every thread is done inserting. The collection is reused
+    // by reruns with the same arguments, so divide the size of all its buckets by the number of
+    // all the measurements it holds rather than by the measurements inserted by this run.
+    if (state.thread_index == 0) {
+        BSONObj stats;
+        invariant(thread.client().runCommand(
+            kDbName.toString(), BSON("collStats"
+                                     << "system.buckets." + coll),
+            stats));
+        const auto measurements = thread.client().count(NamespaceString(kDbName, coll));
+        state.counters["bucketBytesPerMeasurement"] =
+            stats["size"].numberDouble() / std::max(measurements, 1LL);
+    }
+}
+
+const std::string kQueryColl = "query";
+
+/**
+ * Loads the query dataset the first time it is called.
+ */
+void ensureQueryDataset(DBDirectClient& client) {
+    if (!TimeseriesBenchmarkEnvironment::get().ensureCollection(client, kQueryColl)) {
+        return;
+    }
+    for (int second = 0; second < kQueryMeasurementsPerMeta; ++second) {
+        std::vector<BSONObj> measurements;
+        for (int meta = 0; meta < kQueryMetas; ++meta) {
+            measurements.push_back(
+                BSON("t" << kStartTime + Seconds(second) << "m" << meta << "v" << second));
+        }
+        insertMeasurements(client, kQueryColl, std::move(measurements));
+    }
+}
+
+void benchmarkQuery(benchmark::State& state, std::vector<BSONObj> pipeline) {
+    TimeseriesBenchmarkThread thread;
+    ensureQueryDataset(thread.client());
+
+    for (auto keepRunning : state) {
+        AggregateCommandRequest aggCmd(NamespaceString(kDbName, kQueryColl), pipeline);
+        auto cursor = uassertStatusOK(DBClientCursor::fromAggregationRequest(
+            &thread.client(), std::move(aggCmd), false /* secondaryOk */, false /* useExhaust */));
+        while (cursor->more()) {
+            benchmark::DoNotOptimize(cursor->next());
+        }
+    }
+}
+
+void BM_QueryTimeRange(benchmark::State& state) {
+    benchmarkQuery(state,
+                   {BSON("$match" << BSON("t" << BSON("$gte" << kStartTime + Seconds(100) << "$lt"
+                                                             << kStartTime + Seconds(200))))});
+}
+
+void BM_QueryLastPoint(benchmark::State& state) {
+    benchmarkQuery(state,
+                   {BSON("$sort" << BSON("m" << 1 << "t" << -1)),
+                    BSON("$group" << BSON("_id"
+                                          << "$m"
+                                          << "last"
+                                          << BSON("$first"
+                                                  << "$v")))});
+}
+
+void BM_QueryGroupByTimeWindow(benchmark::State& state) {
+    benchmarkQuery(
+        state,
+        {BSON("$group" << BSON("_id" << BSON("$dateTrunc" << BSON("date"
+                                                                  << "$t"
+                                                                  << "unit"
+                                                                  << "minute"))
+                                     << "avg"
+                                     << BSON("$avg"
+                                             << "$v")))});
+}
+
+BENCHMARK(BM_Ingest)
+    ->ArgNames({"metas", "outOfOrderPct"})
+    ->Args({1, 0})
+    ->Args({100, 0})
+    ->Args({10000, 0})
+    ->Args({100, 10})
+    ->ThreadRange(1, kMaxThreads)
+    ->UseRealTime();
+BENCHMARK(BM_QueryTimeRange);
+BENCHMARK(BM_QueryLastPoint);
+BENCHMARK(BM_QueryGroupByTimeWindow);
+
+}  // namespace
+}  // namespace mongo
@@ -80,7 +80,9 @@ MONGO_INITIALIZER(ShouldAlwaysRecordTraffic)(InitializerContext*) {
 class TrafficRecorder::Recording {
 public:
     Recording(const StartRecordingTraffic& options)
-        : _path(_getPath(options.getFilename().toString())), _maxLogSize(options.getMaxFileSize()) {
+        : _path(_getPath(options.getFilename().toString())),
+          _maxLogSize(options.getMaxFileSize()),
+          _sampleRate(options.getSampleRate()) {
 
         MultiProducerSingleConsumerQueue<TrafficRecordingPacket, CostFunction>::Options
             queueOptions;
@@ -95,6 +97,21 @@ public:
         _trafficStats.setBufferSize(options.getBufferSize());
         _trafficStats.setRecordingFile(_path);
         _trafficStats.setMaxFileSize(_maxLogSize);
+        _trafficStats.setSampleRate(_sampleRate);
+    }
+
+    /**
+     * Returns whether the traffic of the session with the given id belongs to the sample. The
+     * decision only depends on the id, so all messages of a session are either kept or dropped.
+     */
+    bool shouldRecordSession(uint64_t sessionId) const {
+        if (_sampleRate >= 1.0) {
+            return true;
+        }
+
+        // Session ids are sequential, so mix the bits before mapping the id onto [0, 1).
+        const uint64_t mixed = sessionId * 0x9E3779B97F4A7C15ULL;
+        return static_cast<double>(mixed >> 11) * 0x1.0p-53 < _sampleRate;
     }
 
     void run() {
@@ -245,6 +262,7 @@ private:
 
     const std::string _path;
     const size_t _maxLogSize;
+    const double _sampleRate;
 
     MultiProducerSingleConsumerQueue<TrafficRecordingPacket, CostFunction>::Pipe _pcqPipe;
     stdx::thread _thread;
@@ -334,8 +352,8 @@ void TrafficRecorder::observe(const transport::SessionHandle& ts,
 
     auto recording = _getCurrentRecording();
 
-    // If we don't have an active recording, bail
-    if (!recording) {
+    // If we don't have an active recording, or this session is not sampled, bail
+    if (!recording || !recording->shouldRecordSession(ts->id())) {
         return;
     }
 
@@ -47,6 +47,7 @@
 #include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/db_raii.h"
+#include "mongo/db/exec/batched_delete_stage.h"
 #include "mongo/db/exec/delete_stage.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/namespace_string.h"
@@ -475,7 +476,8 @@ private:
                                                  endKey,
                                                  BoundInclusion::kIncludeBothStartAndEndKeys,
                                                  PlanYieldPolicy::YieldPolicy::YIELD_AUTO,
-                                                 direction);
+                                                 direction,
+                                                 makeBatchedDeleteParams());
 
         try {
             const auto numDeleted = exec->executeDelete();
@@ -500,6 +502,17 @@ private:
         }
     }
 
+    /**
+     * Returns the batching parameters for a TTL delete, or nullptr to delete one document per
+     * storage transaction.
+     */
+    std::unique_ptr<BatchedDeleteStageBatchParams> makeBatchedDeleteParams() {
+        if (!ttlMonitorBatchDeletes.load()) {
+            return nullptr;
+        }
+        return std::make_unique<BatchedDeleteStageBatchParams>();
+    }
+
     /**
      * Returns the end recordId bound with the correct type. All time-series buckets collections
      * delete entries of type 'ObjectId'. All other collections must only delete entries of type
@@ -567,7 +580,8 @@ private:
             InternalPlanner::Direction::FORWARD,
             startId,
             endId,
-            CollectionScanParams::ScanBoundInclusion::kIncludeBothStartAndEndRecords);
+            CollectionScanParams::ScanBoundInclusion::kIncludeBothStartAndEndRecords,
+            makeBatchedDeleteParams());
 
         try {
             const auto numDeleted = exec->executeDelete();
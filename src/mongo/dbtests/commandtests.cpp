@@ -39,6 +39,7 @@
 #include "mongo/db/dbdirectclient.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/dbtests/dbtests.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/logv2/log.h"
 #include "mongo/rpc/op_msg.h"
 
@@ -72,6 +73,185 @@ TEST(CommandTests, InputDocumentSequeceWorksEndToEnd) {
     ASSERT_EQ(db.count(nss), 5u);
 }
 
+namespace BulkWrite {
+
+const NamespaceString kFirstNss("test", "bulk_write_first");
+const NamespaceString kSecondNss("test", "bulk_write_second");
+
+BSONObj makeBulkWrite(std::vector<BSONObj> ops, bool ordered) {
+    BSONArrayBuilder opsArray;
+    for (const auto& op : ops) {
+        opsArray.append(op);
+    }
+    return BSON("bulkWrite" << 1 << "ops" << opsArray.arr() << "nsInfo"
+                            << BSON_ARRAY(BSON("ns" << kFirstNss.ns())
+                                          << BSON("ns" << kSecondNss.ns()))
+                            << "ordered" << ordered);
+}
+
+class BulkWriteTest {
+public:
+    BulkWriteTest() : _client(_opCtx.get()) {
+        _client.dropCollection(kFirstNss.ns());
+        _client.dropCollection(kSecondNss.ns());
+    }
+
+    BSONObj run(std::vector<BSONObj> ops, bool ordered) {
+        BSONObj reply;
+        _client.runCommand("admin", makeBulkWrite(std::move(ops), ordered), reply);
+        return reply;
+    }
+
+    std::vector<int> okResults(const BSONObj& reply) {
+        std::vector<int> oks;
+        for (const auto& item : reply["results"].Obj()) {
+            oks.push_back(item.Obj()["ok"].numberInt());
+        }
+        return oks;
+    }
+
+    DBDirectClient& client() {
+        return _client;
+    }
+
+private:
+    RAIIServerParameterControllerForTest _featureFlag{"featureFlagBulkWriteCommand", true};
+    const ServiceContext::UniqueOperationContext _opCtx = cc().makeOperationContext();
+    DBDirectClient _client;
+};
+
+TEST(BulkWriteCommandTests, RejectedWhenFeatureFlagDisabled) {
+    RAIIServerParameterControllerForTest featureFlag("featureFlagBulkWriteCommand", false);
+    const auto opCtxHolder = cc().makeOperationContext();
+    DBDirectClient client(opCtxHolder.get());
+    client.dropCollection(kFirstNss.ns());
+
+    BSONObj reply;
+    const auto cmd = makeBulkWrite({BSON("insert" << 0 << "document" << BSON("_id" << 1))}, true);
+    ASSERT_FALSE(client.runCommand("admin", cmd, reply));
+    ASSERT_EQ(reply["code"].numberInt(), ErrorCodes::IllegalOperation);
+    ASSERT_EQ(client.count(kFirstNss), 0u);
+}
+
+TEST(BulkWriteCommandTests, MixedOperationsAcrossNamespaces) {
+    BulkWriteTest test;
+    const auto reply = test.run({BSON("insert" << 0 << "document" << BSON("_id" << 1 << "x" << 1)),
+                                 BSON("insert" << 0 << "document" << BSON("_id" << 2 << "x" << 1)),
+                                 BSON("insert" << 1 << "document" << BSON("_id" << 1)),
+                                 BSON("update" << 0 << "filter" << BSON("x" << 1) << "updateMods"
+                                               << BSON("$set" << BSON("y" << 1)) << "multi"
+                                               << true),
+                                 BSON("update" << 1 << "filter" << BSON("_id" << 2)
+                                               << "updateMods" << BSON("$set" << BSON("y" << 2))
+                                               << "upsert" << true),
+                                 BSON("delete" << 0 << "filter" << BSON("_id" << 1))},
+                                true);
+
+    ASSERT_EQ(reply["ok"].numberDouble(), 1.0) << reply;
+    ASSERT_EQ(reply["nErrors"].numberInt(), 0) << reply;
+    ASSERT_EQ(reply["nInserted"].numberInt(), 3) << reply;
+    ASSERT_EQ(reply["nMatched"].numberInt(), 2) << reply;
+    ASSERT_EQ(reply["nModified"].numberInt(), 2) << reply;
+    ASSERT_EQ(reply["nUpserted"].numberInt(), 1) << reply;
+    ASSERT_EQ(reply["nDeleted"].numberInt(), 1) << reply;
+
+    const auto results = reply["results"].Obj();
+    ASSERT_EQ(results.nFields(), 6) << reply;
+    int expectedIdx = 0;
+    for (const auto& item : results) {
+        ASSERT_EQ(item.Obj()["idx"].numberInt(), expectedIdx++) << reply;
+    }
+    ASSERT_BSONOBJ_EQ(results["4"].Obj()["upserted"].wrap("_id"), BSON("_id" << 2));
+
+    ASSERT_BSONOBJ_EQ(test.client().findOne(kFirstNss, BSONObj{}),
+                      BSON("_id" << 2 << "x" << 1 << "y" << 1));
+    ASSERT_EQ(test.client().count(kSecondNss), 2u);
+}
+
+TEST(BulkWriteCommandTests, OrderedStopsAtFirstError) {
+    BulkWriteTest test;
+    const auto reply = test.run({BSON("insert" << 0 << "document" << BSON("_id" << 1)),
+                                 BSON("insert" << 0 << "document" << BSON("_id" << 1)),
+                                 BSON("insert" << 0 << "document" << BSON("_id" << 2)),
+                                 BSON("insert" << 1 << "document" << BSON("_id" << 1))},
+                                true);
+
+    ASSERT_EQ(reply["ok"].numberDouble(), 1.0) << reply;
+    ASSERT_EQ(reply["nErrors"].numberInt(), 1) << reply;
+    ASSERT_EQ(reply["nInserted"].numberInt(), 1) << reply;
+    ASSERT(test.okResults(reply) == std::vector<int>({1, 0})) << reply;
+    ASSERT_EQ(reply["results"].Obj()["1"].Obj()["code"].numberInt(), ErrorCodes::DuplicateKey);
+
+    ASSERT_EQ(test.client().count(kFirstNss), 1u);
+    ASSERT_EQ(test.client().count(kSecondNss), 0u);
+}
+
+TEST(BulkWriteCommandTests, UnorderedContinuesPastErrors) {
+    BulkWriteTest test;
+    const auto reply = test.run({BSON("insert" << 0 << "document" << BSON("_id" << 1)),
+                                 BSON("insert" << 0 << "document" << BSON("_id" << 1)),
+                                 BSON("insert" << 0 << "document" << BSON("_id" << 2)),
+                                 BSON("delete" << 0 << "filter" << BSON("_id" << 2)),
+                                 BSON("insert" << 1 << "document" << BSON("_id" << 1))},
+                                false);
+
+    ASSERT_EQ(reply["ok"].numberDouble(), 1.0) << reply;
+    ASSERT_EQ(reply["nErrors"].numberInt(), 1) << reply;
+    ASSERT_EQ(reply["nInserted"].numberInt(), 3) << reply;
+    ASSERT_EQ(reply["nDeleted"].numberInt(), 1) << reply;
+    ASSERT(test.okResults(reply) == std::vector<int>({1, 0, 1, 1, 1})) << reply;
+
+    ASSERT_EQ(test.client().count(kFirstNss), 1u);
+    ASSERT_EQ(test.client().count(kSecondNss), 1u);
+}
+
+TEST(BulkWriteCommandTests, RejectsOutOfRangeNsInfoIndex) {
+    BulkWriteTest test;
+    const auto reply = test.run({BSON("insert" << 2 << "document" << BSON("_id" << 1))}, true);
+    ASSERT_EQ(reply["ok"].numberDouble(), 0.0) << reply;
+    ASSERT_EQ(reply["code"].numberInt(), ErrorCodes::BadValue) << reply;
+}
+
+}  // namespace BulkWrite
+
+TEST(CommandTests, CheckpointedMergeRequiresClusteredSourceCollection) {
+    const auto opCtxHolder = cc().makeOperationContext();
+    DBDirectClient db(opCtxHolder.get());
+
+    NamespaceString source("test", "merge_checkpoint_source");
+    NamespaceString target("test", "merge_checkpoint_target");
+    db.dropCollection(source.ns());
+    db.dropCollection(target.ns());
+    db.remove(NamespaceString::kConfigAggregateCheckpointsNamespace.ns(),
+              BSON("_id"
+                   << "mergeCheckpointTest"));
+
+    const auto aggregate =
+        BSON("aggregate" << source.coll() << "pipeline"
+                         << BSON_ARRAY(BSON("$merge" << BSON("into" << target.coll()
+                                                                    << "checkpointId"
+                                                                    << "mergeCheckpointTest")))
+                         << "cursor" << BSONObj());
+    const std::vector<BSONObj> docs = {BSON("_id" << 1), BSON("_id" << 2)};
+
+    // The RecordIds of a collection which is not clustered differ from one node to the next.
+    db.insert(source.ns(), docs);
+    BSONObj reply;
+    ASSERT_FALSE(db.runCommand(source.db().toString(), aggregate, reply));
+    ASSERT_EQ(reply["code"].numberInt(), 7027515);
+    ASSERT_EQ(db.count(target), 0u);
+
+    db.dropCollection(source.ns());
+    ASSERT(db.runCommand(source.db().toString(),
+                         BSON("create" << source.coll() << "clusteredIndex"
+                                       << BSON("key" << BSON("_id" << 1) << "unique" << true)),
+                         reply))
+        << reply;
+    db.insert(source.ns(), docs);
+    ASSERT(db.runCommand(source.db().toString(), aggregate, reply)) << reply;
+    ASSERT_EQ(db.count(target), 2u);
+}
+
 using std::string;
 
 /**
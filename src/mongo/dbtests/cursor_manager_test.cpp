@@ -40,6 +40,7 @@
 #include "mongo/db/cursor_manager.h"
 #include "mongo/db/cursor_server_params.h"
 #include "mongo/db/exec/queued_data_stage.h"
+#include "mongo/db/exec/sort.h"
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/exec/working_set_common.h"
 #include "mongo/db/operation_context.h"
@@ -48,6 +49,7 @@
 #include "mongo/db/query/query_test_service_context.h"
 #include "mongo/db/repl/read_concern_level.h"
 #include "mongo/dbtests/dbtests.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/clock_source_mock.h"
 #include "mongo/util/scopeguard.h"
@@ -97,6 +99,31 @@ public:
                                         kTestNss));
     }
 
+    /**
+     * Returns an executor whose plan sorts its (empty) input in memory.
+     */
+    std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> makeFakeSortPlanExecutor() {
+        auto expCtx = make_intrusive<ExpressionContext>(_opCtx.get(), nullptr, kTestNss);
+
+        auto workingSet = std::make_unique<WorkingSet>();
+        auto queuedDataStage = std::make_unique<QueuedDataStage>(expCtx.get(), workingSet.get());
+        auto sortStage = std::make_unique<SortStageDefault>(expCtx,
+                                                            workingSet.get(),
+                                                            SortPattern(BSON("a" << 1), expCtx),
+                                                            0 /* limit */,
+                                                            100 * 1024 * 1024,
+                                                            false /* addSortKeyMetadata */,
+                                                            std::move(queuedDataStage));
+        return unittest::assertGet(
+            plan_executor_factory::make(expCtx,
+                                        std::move(workingSet),
+                                        std::move(sortStage),
+                                        &CollectionPtr::null,
+                                        PlanYieldPolicy::YieldPolicy::NO_YIELD,
+                                        QueryPlannerParams::DEFAULT,
+                                        kTestNss));
+    }
+
     ClientCursorParams makeParams(OperationContext* opCtx) {
         return {
             makeFakePlanExecutor(opCtx),
@@ -246,6 +273,47 @@ TEST_F(CursorManagerTest, InactiveCursorShouldTimeout) {
     ASSERT_EQ(0UL, cursorManager->numCursors());
 }
 
+/**
+ * Test that cursors holding the results of an in-memory sort can be given a shorter timeout.
+ */
+TEST_F(CursorManagerTest, InactiveCursorWithInMemorySortShouldTimeoutSooner) {
+    RAIIServerParameterControllerForTest sortTimeout{"cursorTimeoutMillisForInMemorySort", 1000};
+    CursorManager* cursorManager = useCursorManager();
+    auto clock = useClock();
+
+    auto makeCursorParams = [&](auto exec) -> ClientCursorParams {
+        return {std::move(exec),
+                kTestNss,
+                {},
+                APIParameters(),
+                {},
+                repl::ReadConcernArgs(repl::ReadConcernLevel::kLocalReadConcern),
+                ReadPreferenceSetting(ReadPreference::PrimaryOnly),
+                BSONObj(),
+                PrivilegeVector()};
+    };
+    cursorManager->registerCursor(_opCtx.get(), makeCursorParams(makeFakePlanExecutor()));
+    auto sortCursorId =
+        cursorManager
+            ->registerCursor(_opCtx.get(), makeCursorParams(makeFakeSortPlanExecutor()))
+            .getCursor()
+            ->cursorid();
+
+    clock->advance(Milliseconds(999));
+    ASSERT_EQ(0UL, cursorManager->timeoutCursors(_opCtx.get(), clock->now()));
+
+    // Only the cursor that sorted in memory times out at the shorter timeout.
+    clock->advance(Milliseconds(1));
+    ASSERT_EQ(1UL, cursorManager->timeoutCursors(_opCtx.get(), clock->now()));
+    ASSERT_EQ(1UL, cursorManager->numCursors());
+    ASSERT_EQ(ErrorCodes::CursorNotFound,
+              cursorManager->pinCursor(_opCtx.get(), sortCursorId).getStatus());
+
+    clock->advance(getDefaultCursorTimeoutMillis());
+    ASSERT_EQ(1UL, cursorManager->timeoutCursors(_opCtx.get(), clock->now()));
+    ASSERT_EQ(0UL, cursorManager->numCursors());
+}
+
 /**
  * Test that pinned cursors do not get timed out.
  */
@@ -38,10 +38,14 @@
 #include "mongo/db/client.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/dbdirectclient.h"
+#include "mongo/db/dbhelpers.h"
+#include "mongo/db/index/index_access_method.h"
+#include "mongo/db/index/index_build_interceptor.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/storage_engine_init.h"
 #include "mongo/dbtests/dbtests.h"
+#include "mongo/idl/server_parameter_test_util.h"
 
 namespace IndexUpdateTests {
 
@@ -177,6 +181,76 @@ public:
     }
 };
 
+/**
+ * Side writes drained in key order are still applied in the order they were recorded in for each
+ * key, so that inserting, deleting and re-inserting the same key leaves a single index entry.
+ */
+class DrainSortedByKeyKeepsWriteOrderPerKey : public IndexBuildBase {
+public:
+    void run() {
+        RAIIServerParameterControllerForTest sortByKey("indexBuildDrainSortBatchesByKey", true);
+        AutoGetCollection autoColl(_opCtx, _nss, LockMode::MODE_X);
+        auto& coll = collection();
+
+        MultiIndexBlock indexer;
+        ScopeGuard abortOnExit([&] {
+            indexer.abortIndexBuild(_opCtx, collection(), MultiIndexBlock::kNoopOnCleanUpFn);
+        });
+        const BSONObj spec = BSON("name"
+                                  << "a_1"
+                                  << "key" << BSON("a" << 1) << "v"
+                                  << static_cast<int>(kIndexVersion));
+        {
+            WriteUnitOfWork wunit(_opCtx);
+            ASSERT_OK(indexer.init(_opCtx, coll, spec, MultiIndexBlock::kNoopOnInitFn).getStatus());
+            wunit.commit();
+        }
+        ASSERT_OK(indexer.insertAllDocumentsInCollection(_opCtx, coll.get()));
+
+        // These writes happen while the index is building, so they go to the side table. The
+        // writes to 'a: 5' are surrounded by writes to other keys, so that the drain reorders
+        // the batch.
+        auto insert = [&](const BSONObj& doc) {
+            WriteUnitOfWork wunit(_opCtx);
+            ASSERT_OK(coll->insertDocument(_opCtx, InsertStatement(doc), nullptr));
+            wunit.commit();
+        };
+        insert(BSON("_id" << 1 << "a" << 9));
+        insert(BSON("_id" << 2 << "a" << 5));
+        {
+            WriteUnitOfWork wunit(_opCtx);
+            auto rid = Helpers::findById(_opCtx, coll.get(), BSON("_id" << 2));
+            ASSERT(!rid.isNull());
+            coll->deleteDocument(_opCtx, kUninitializedStmtId, rid, nullptr);
+            wunit.commit();
+        }
+        insert(BSON("_id" << 2 << "a" << 5));
+        insert(BSON("_id" << 3 << "a" << 1));
+
+        ASSERT_OK(indexer.drainBackgroundWrites(_opCtx,
+                                                RecoveryUnit::ReadSource::kNoTimestamp,
+                                                IndexBuildInterceptor::DrainYieldPolicy::kNoYield));
+        ASSERT_OK(indexer.checkConstraints(_opCtx, coll.get()));
+        {
+            WriteUnitOfWork wunit(_opCtx);
+            ASSERT_OK(indexer.commit(_opCtx,
+                                     coll.getWritableCollection(),
+                                     MultiIndexBlock::kNoopOnCreateEachFn,
+                                     MultiIndexBlock::kNoopOnCommitFn));
+            wunit.commit();
+        }
+        abortOnExit.dismiss();
+
+        // A delete applied before the insert it follows would leave the key of the deleted
+        // document behind.
+        auto indexCatalog = coll->getIndexCatalog();
+        auto desc = indexCatalog->findIndexByName(_opCtx, "a_1");
+        ASSERT(desc);
+        auto iam = indexCatalog->getEntry(desc)->accessMethod()->asSortedData();
+        ASSERT_EQ(iam->getSortedDataInterface()->numEntries(_opCtx), 3);
+    }
+};
+
 /** Index creation enforces unique constraints unless told not to. */
 template <bool background>
 class InsertBuildEnforceUnique : public IndexBuildBase {
@@ -688,6 +762,7 @@ public:
         addIf<InsertBuildEnforceUnique<true>>();
         addIf<InsertBuildEnforceUnique<false>>();
 
+        add<DrainSortedByKeyKeepsWriteOrderPerKey>();
         add<InsertBuildIndexInterrupt>();
         add<InsertBuildIdIndexInterrupt>();
         add<SameSpecDifferentOption>();
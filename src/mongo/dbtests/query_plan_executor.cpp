@@ -30,8 +30,10 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
 #include <memory>
 
+#include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/database.h"
 #include "mongo/db/catalog/index_catalog.h"
@@ -48,6 +50,7 @@
 #include "mongo/db/matcher/expression_parser.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/pipeline/document_source_cursor.h"
+#include "mongo/db/pipeline/document_source_mock.h"
 #include "mongo/db/pipeline/expression_context_for_test.h"
 #include "mongo/db/pipeline/pipeline.h"
 #include "mongo/db/pipeline/plan_executor_pipeline.h"
@@ -56,6 +59,7 @@
 #include "mongo/db/query/query_planner_params.h"
 #include "mongo/db/query/query_solution.h"
 #include "mongo/dbtests/dbtests.h"
+#include "mongo/idl/server_parameter_test_util.h"
 
 namespace mongo {
 namespace {
@@ -313,6 +317,171 @@ TEST_F(PlanExecutorTest, ShouldReportErrorIfKilledDuringYield) {
                                 "Using AlwaysPlanKilledYieldPolicy");
 }
 
+TEST_F(PlanExecutorTest, PipelineExecutorReturnsBatchedResultsInOrder) {
+    RAIIServerParameterControllerForTest batchSize{"internalPipelineExecutorBatchSize", 2};
+
+    auto mock = DocumentSourceMock::createForTest({"{_id: 0}", "{_id: 1}", "{_id: 2}"}, _expCtx);
+    mock->push_back(DocumentSource::GetNextResult::makePauseExecution());
+    mock->push_back(Document{{"_id", 3}});
+    auto exec = plan_executor_factory::make(_expCtx, Pipeline::create({mock}, _expCtx));
+
+    BSONObj objOut;
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_EQ(PlanExecutor::ADVANCED, exec->getNext(&objOut, nullptr));
+        ASSERT_BSONOBJ_EQ(BSON("_id" << i), objOut);
+    }
+    ASSERT_EQ(PlanExecutor::IS_EOF, exec->getNext(&objOut, nullptr));
+    ASSERT_TRUE(exec->isEOF());
+}
+
+TEST_F(PlanExecutorTest, PipelineExecutorReportsEofWhichEndedABatch) {
+    RAIIServerParameterControllerForTest batchSize{"internalPipelineExecutorBatchSize", 3};
+
+    auto mock = DocumentSourceMock::createForTest({"{_id: 0}", "{_id: 1}"}, _expCtx);
+    auto exec = plan_executor_factory::make(_expCtx, Pipeline::create({mock}, _expCtx));
+
+    // The first call pulls both documents and the EOF after them. A document which arrives later,
+    // as with a tailable cursor, is only returned after that EOF.
+    BSONObj objOut;
+    ASSERT_EQ(PlanExecutor::ADVANCED, exec->getNext(&objOut, nullptr));
+    ASSERT_BSONOBJ_EQ(BSON("_id" << 0), objOut);
+    mock->push_back(Document{{"_id", 2}});
+    ASSERT_EQ(PlanExecutor::ADVANCED, exec->getNext(&objOut, nullptr));
+    ASSERT_BSONOBJ_EQ(BSON("_id" << 1), objOut);
+    ASSERT_EQ(PlanExecutor::IS_EOF, exec->getNext(&objOut, nullptr));
+    ASSERT_EQ(PlanExecutor::ADVANCED, exec->getNext(&objOut, nullptr));
+    ASSERT_BSONOBJ_EQ(BSON("_id" << 2), objOut);
+    ASSERT_EQ(PlanExecutor::IS_EOF, exec->getNext(&objOut, nullptr));
+}
+
+class BatchedIdHackTest : public unittest::Test {
+public:
+    BatchedIdHackTest() : _client(_opCtx.get()) {
+        _client.dropCollection(nss.ns());
+    }
+
+    ~BatchedIdHackTest() {
+        _client.dropCollection(nss.ns());
+    }
+
+    BSONObj findCommand(const BSONObj& filter, const BSONObj& collation = BSONObj()) {
+        BSONObjBuilder bob;
+        bob.append("find", nss.coll());
+        bob.append("filter", filter);
+        if (!collation.isEmpty()) {
+            bob.append("collation", collation);
+        }
+        return bob.obj();
+    }
+
+    /**
+     * Returns the _ids of the documents matching 'filter', as {_id: <value>} objects in _id order.
+     */
+    std::vector<BSONObj> findIds(const BSONObj& filter, const BSONObj& collation = BSONObj()) {
+        BSONObj res;
+        ASSERT(_client.runCommand(nss.db().toString(), findCommand(filter, collation), res))
+            << res;
+        std::vector<BSONObj> ids;
+        for (auto&& doc : res["cursor"]["firstBatch"].Obj()) {
+            ids.push_back(doc.Obj()["_id"].wrap());
+        }
+        std::sort(ids.begin(), ids.end(), SimpleBSONObjComparator::kInstance.makeLessThan());
+        return ids;
+    }
+
+    std::string winningPlanStage(const BSONObj& filter, const BSONObj& collation = BSONObj()) {
+        BSONObj res;
+        ASSERT(_client.runCommand(nss.db().toString(),
+                                  BSON("explain" << findCommand(filter, collation) << "verbosity"
+                                                 << "queryPlanner"),
+                                  res))
+            << res;
+        return res["queryPlanner"]["winningPlan"]["stage"].String();
+    }
+
+protected:
+    RAIIServerParameterControllerForTest _forceClassic{"internalQueryForceClassicEngine", true};
+    const ServiceContext::UniqueOperationContext _opCtx = cc().makeOperationContext();
+    DBDirectClient _client;
+};
+
+TEST_F(BatchedIdHackTest, ReturnsDuplicateIdsOnce) {
+    for (int i = 0; i < 5; ++i) {
+        _client.insert(nss.ns(), BSON("_id" << i));
+    }
+
+    const auto filter = fromjson("{_id: {$in: [3, 1, 3, 1.0, 4]}}");
+    ASSERT_EQ(winningPlanStage(filter), "IDHACK");
+    auto ids = findIds(filter);
+    ASSERT_EQ(ids.size(), 3U);
+    ASSERT_BSONOBJ_EQ(ids[0], BSON("_id" << 1));
+    ASSERT_BSONOBJ_EQ(ids[1], BSON("_id" << 3));
+    ASSERT_BSONOBJ_EQ(ids[2], BSON("_id" << 4));
+}
+
+TEST_F(BatchedIdHackTest, SkipsMissingIds) {
+    for (int i = 0; i < 5; ++i) {
+        _client.insert(nss.ns(), BSON("_id" << i));
+    }
+
+    auto ids = findIds(fromjson("{_id: {$in: [-1, 2, 7, 'a']}}"));
+    ASSERT_EQ(ids.size(), 1U);
+    ASSERT_BSONOBJ_EQ(ids[0], BSON("_id" << 2));
+
+    ASSERT(findIds(fromjson("{_id: {$in: [10, 11]}}")).empty());
+}
+
+TEST_F(BatchedIdHackTest, UsesTheCollectionDefaultCollation) {
+    BSONObj res;
+    ASSERT(_client.runCommand(
+        nss.db().toString(),
+        BSON("create" << nss.coll() << "collation" << BSON("locale" << "en_US"
+                                                                    << "strength" << 2)),
+        res))
+        << res;
+    _client.insert(nss.ns(), BSON("_id" << "a"));
+    _client.insert(nss.ns(), BSON("_id" << "B"));
+
+    // The _id index compares strings case insensitively, so both documents match.
+    const auto filter = fromjson("{_id: {$in: ['A', 'b', 'c']}}");
+    ASSERT_EQ(winningPlanStage(filter), "IDHACK");
+    auto ids = findIds(filter);
+    ASSERT_EQ(ids.size(), 2U);
+    ASSERT_BSONOBJ_EQ(ids[0], BSON("_id"
+                                   << "B"));
+    ASSERT_BSONOBJ_EQ(ids[1], BSON("_id"
+                                   << "a"));
+
+    // A query with another collation cannot use the _id index for exact lookups.
+    const auto simpleCollation = BSON("locale"
+                                      << "simple");
+    ASSERT_NE(winningPlanStage(filter, simpleCollation), "IDHACK");
+    ASSERT(findIds(filter, simpleCollation).empty());
+}
+
+TEST_F(BatchedIdHackTest, FallsBackToPlanningWhenAnIndexFilterApplies) {
+    for (int i = 0; i < 5; ++i) {
+        _client.insert(nss.ns(), BSON("_id" << i << "a" << i));
+    }
+    ASSERT_OK(dbtests::createIndex(_opCtx.get(), nss.ns(), BSON("a" << 1)));
+
+    BSONObj res;
+    ASSERT(_client.runCommand(nss.db().toString(),
+                              BSON("planCacheSetFilter" << nss.coll() << "query"
+                                                        << fromjson("{_id: {$in: [1, 2]}}")
+                                                        << "indexes" << BSON_ARRAY(BSON("a" << 1))),
+                              res))
+        << res;
+
+    // The filter only allows the index on 'a', which cannot answer the query.
+    const auto filter = fromjson("{_id: {$in: [2, 4]}}");
+    ASSERT_EQ(winningPlanStage(filter), "COLLSCAN");
+    auto ids = findIds(filter);
+    ASSERT_EQ(ids.size(), 2U);
+    ASSERT_BSONOBJ_EQ(ids[0], BSON("_id" << 2));
+    ASSERT_BSONOBJ_EQ(ids[1], BSON("_id" << 4));
+}
+
 class PlanExecutorSnapshotTest : public PlanExecutorTest {
 protected:
     void setupCollection() {
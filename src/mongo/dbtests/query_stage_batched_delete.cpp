@@ -38,8 +38,10 @@
 #include "mongo/db/exec/collection_scan.h"
 #include "mongo/db/exec/delete_stage.h"
 #include "mongo/db/exec/queued_data_stage.h"
+#include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/op_observer_noop.h"
 #include "mongo/db/query/canonical_query.h"
+#include "mongo/db/query/internal_plans.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/checkpointer.h"
 #include "mongo/dbtests/dbtests.h"
@@ -154,6 +156,14 @@ public:
         _client.remove(nss.ns(), obj);
     }
 
+    void createIndex(const BSONObj& keys) {
+        _client.createIndex(nss.ns(), keys);
+    }
+
+    long long count(const BSONObj& query) {
+        return _client.count(nss, query);
+    }
+
     void update(BSONObj& query, BSONObj& updateSpec) {
         _client.update(nss.ns(), query, updateSpec);
     }
@@ -671,5 +681,48 @@ TEST_F(QueryStageBatchedDeleteTest, BatchedDeleteTargetBatchTimeMSWithTargetBatc
         ASSERT_LT(Milliseconds(timer.millis()), targetBatchTimeMS);
     }
 }
+
+// Runs the IXSCAN => FETCH => BATCHED_DELETE plan the TTL monitor builds when
+// 'ttlMonitorBatchDeletes' is enabled, and checks that it deletes exactly the documents a
+// per-document delete over the same expiry range would.
+TEST_F(QueryStageBatchedDeleteTest, BatchedDeleteWithIndexScanDeletesExpiredRange) {
+    const auto nDocs = 25;
+    const auto nExpired = 14;
+    createIndex(BSON("expireAt" << 1));
+    for (int i = 0; i < nDocs; i++) {
+        insert(BSON("_id" << i << "expireAt" << Date_t::fromMillisSinceEpoch(i)));
+    }
+
+    dbtests::WriteContextForTests ctx(&_opCtx, nss.ns());
+    const CollectionPtr& coll = ctx.getCollection();
+    ASSERT(coll);
+    auto desc = coll->getIndexCatalog()->findIndexByName(&_opCtx, "expireAt_1");
+    ASSERT(desc);
+
+    const auto expirationDate = Date_t::fromMillisSinceEpoch(nExpired - 1);
+    auto cq = canonicalize(BSON("expireAt" << BSON("$lte" << expirationDate)));
+    auto deleteParams = std::make_unique<DeleteStageParams>();
+    deleteParams->isMulti = true;
+    deleteParams->canonicalQuery = cq.get();
+
+    auto batchedDeleteParams = std::make_unique<BatchedDeleteStageBatchParams>();
+    batchedDeleteParams->targetBatchDocs = targetBatchDocs;
+
+    auto exec = InternalPlanner::deleteWithIndexScan(
+        &_opCtx,
+        &coll,
+        std::move(deleteParams),
+        desc,
+        BSON("" << Date_t::fromMillisSinceEpoch(std::numeric_limits<long long>::min())),
+        BSON("" << expirationDate),
+        BoundInclusion::kIncludeBothStartAndEndKeys,
+        PlanYieldPolicy::YieldPolicy::NO_YIELD,
+        InternalPlanner::FORWARD,
+        std::move(batchedDeleteParams));
+    ASSERT_EQ(exec->executeDelete(), nExpired);
+
+    ASSERT_EQ(count(BSONObj()), nDocs - nExpired);
+    ASSERT_EQ(count(BSON("expireAt" << BSON("$lte" << expirationDate))), 0LL);
+}
 }  // namespace QueryStageBatchedDelete
 }  // namespace mongo
@@ -51,7 +51,9 @@
 #include "mongo/db/query/plan_cache_key_factory.h"
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner_params.h"
+#include "mongo/db/query/sbe_plan_cache.h"
 #include "mongo/dbtests/dbtests.h"
+#include "mongo/idl/server_parameter_test_util.h"
 
 namespace QueryStageCachedPlan {
 
@@ -550,4 +552,44 @@ TEST_F(QueryStageCachedPlan, DoesNotThrowOnYieldRecoveryWhenIndexIsDroppedAferPl
     cachedPlanStage.restoreState(&readLock->getCollection());
 }
 
+TEST_F(QueryStageCachedPlan, SbeCacheEntryCountsCompilationsOfRecoveredPlans) {
+    RAIIServerParameterControllerForTest controllerSBE("internalQueryForceClassicEngine", false);
+    RAIIServerParameterControllerForTest controllerSBEPlanCache("featureFlagSbePlanCache", true);
+
+    auto& sbePlanCache = sbe::getPlanCache(&_opCtx);
+    sbePlanCache.clear();
+
+    // Both the index on "a" and the index on "b" can answer this query, so the first runs
+    // multi-plan and create an inactive, then an active cache entry.
+    auto runQuery = [&] {
+        FindCommandRequest findCmd{nss};
+        findCmd.setFilter(fromjson("{a: {$gte: 8}, b: 1}"));
+        ASSERT_EQ(_client.find(std::move(findCmd))->itcount(), 2);
+    };
+    auto getCompileStats = [&] {
+        auto entries = sbePlanCache.getAllEntries();
+        ASSERT_EQ(entries.size(), 1U);
+        ASSERT_TRUE(entries[0]->isActive);
+        auto compileStats = entries[0]->cachedPlan->planStageData.compileStats;
+        ASSERT(compileStats);
+        return compileStats;
+    };
+    for (int i = 0; i < 3; ++i) {
+        runQuery();
+    }
+
+    // Every further run recovers the plan from the active entry and prepares it again. All of
+    // these runs update the counters of that entry.
+    const auto compileStats = getCompileStats();
+    const auto numCompilations = compileStats->numCompilations.load();
+    const auto compileTimeMicros = compileStats->compileTimeMicros.load();
+    runQuery();
+    runQuery();
+    ASSERT_EQ(compileStats->numCompilations.load(), numCompilations + 2);
+    ASSERT_GTE(compileStats->compileTimeMicros.load(), compileTimeMicros);
+    ASSERT_EQ(getCompileStats(), compileStats);
+
+    sbePlanCache.clear();
+}
+
 }  // namespace QueryStageCachedPlan
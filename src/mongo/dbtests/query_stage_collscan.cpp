@@ -48,6 +48,7 @@
 #include "mongo/db/dbdirectclient.h"
 #include "mongo/db/exec/collection_scan.h"
 #include "mongo/db/exec/plan_stage.h"
+#include "mongo/db/exec/shared_scan_registry.h"
 #include "mongo/db/json.h"
 #include "mongo/db/matcher/expression_parser.h"
 #include "mongo/db/namespace_string.h"
@@ -56,6 +57,7 @@
 #include "mongo/db/record_id_helpers.h"
 #include "mongo/db/storage/record_store.h"
 #include "mongo/dbtests/dbtests.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/logv2/log.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/fail_point.h"
@@ -92,6 +94,46 @@ public:
         _client.remove(nss.ns(), obj);
     }
 
+    // Returns the documents of 'nss' that match 'filter', in natural order, as returned by a find
+    // command.
+    std::vector<BSONObj> findAll(const BSONObj& filter) {
+        FindCommandRequest findRequest{nss};
+        findRequest.setFilter(filter);
+        auto cursor = _client.find(std::move(findRequest));
+        std::vector<BSONObj> docs;
+        while (cursor->more()) {
+            docs.push_back(cursor->next().getOwned());
+        }
+        return docs;
+    }
+
+    // Scans 'nss' with a CollectionScan stage, saving and restoring the stage after every
+    // 'yieldEvery' works, and returns the values of 'foo' in the order they were returned.
+    std::vector<int> scanFoo(CollectionScanParams::Direction direction, int yieldEvery) {
+        AutoGetCollectionForReadCommand collection(&_opCtx, nss);
+
+        CollectionScanParams params;
+        params.direction = direction;
+        params.tailable = false;
+
+        WorkingSet ws;
+        auto scan = std::make_unique<CollectionScan>(
+            _expCtx.get(), collection.getCollection(), params, &ws, nullptr);
+
+        std::vector<int> values;
+        for (int works = 1; !scan->isEOF(); ++works) {
+            WorkingSetID id = WorkingSet::INVALID_ID;
+            if (PlanStage::ADVANCED == scan->work(&id)) {
+                values.push_back(ws.get(id)->doc.value()["foo"].getInt());
+            }
+            if (works % yieldEvery == 0) {
+                scan->saveState();
+                scan->restoreState(&collection.getCollection());
+            }
+        }
+        return values;
+    }
+
     int countResults(CollectionScanParams::Direction direction, const BSONObj& filterObj) {
         AutoGetCollectionForReadCommand collection(&_opCtx, nss);
 
@@ -438,6 +480,27 @@ TEST_F(QueryStageCollectionScanTest, QueryStageCollscanObjectsInOrderBackward) {
     ASSERT_EQUALS(numObj(), count);
 }
 
+// Reading records from the storage engine in batches returns the same documents in the same order
+// as reading them one at a time, including across yields in the middle of a batch.
+TEST_F(QueryStageCollectionScanTest, QueryStageCollscanBatchedReadsReturnSameResults) {
+    const auto forward = scanFoo(CollectionScanParams::FORWARD, 3);
+    const auto backward = scanFoo(CollectionScanParams::BACKWARD, 3);
+    const auto found = findAll(BSON("foo" << BSON("$mod" << BSON_ARRAY(3 << 0))));
+    ASSERT_EQUALS(numObj(), static_cast<int>(forward.size()));
+    ASSERT_EQUALS(numObj(), static_cast<int>(backward.size()));
+
+    // A batch size that does not divide the number of documents, so the last batch is partial.
+    RAIIServerParameterControllerForTest batchSize{"internalQueryCollectionScanBatchSize", 7};
+    ASSERT(forward == scanFoo(CollectionScanParams::FORWARD, 3));
+    ASSERT(backward == scanFoo(CollectionScanParams::BACKWARD, 3));
+
+    auto batchedFound = findAll(BSON("foo" << BSON("$mod" << BSON_ARRAY(3 << 0))));
+    ASSERT_EQUALS(found.size(), batchedFound.size());
+    for (size_t i = 0; i < found.size(); ++i) {
+        ASSERT_BSONOBJ_EQ(found[i], batchedFound[i]);
+    }
+}
+
 // Scan through half the objects, delete the one we're about to fetch, then expect to get the "next"
 // object we would have gotten after that.
 TEST_F(QueryStageCollectionScanTest, QueryStageCollscanDeleteUpcomingObject) {
@@ -1358,4 +1421,64 @@ TEST_F(QueryStageCollectionScanTest, QueryTestCollscanClusteredInclusionBoundsHa
     }
 }
 
+// Verify that a scan which shares its position with a scan in flight starts where that scan is,
+// wraps around, and returns every record exactly once.
+TEST_F(QueryStageCollectionScanTest, QueryStageCollscanSharedScanWrapsAround) {
+    const int numRecords = numObj() + 2 * SharedScanRegistry::kPositionReportInterval;
+    {
+        dbtests::WriteContextForTests ctx(&_opCtx, nss.ns());
+        for (int i = numObj(); i < numRecords; ++i) {
+            insertDocument(nss, BSON("foo" << i));
+        }
+    }
+
+    AutoGetCollectionForReadCommand collection(&_opCtx, nss);
+    const CollectionPtr& coll = collection.getCollection();
+
+    vector<RecordId> recordIds;
+    getRecordIds(coll, CollectionScanParams::FORWARD, &recordIds);
+    ASSERT_EQ(recordIds.size(), size_t(numRecords));
+
+    CollectionScanParams params;
+    params.direction = CollectionScanParams::FORWARD;
+    params.shareScanPosition = true;
+
+    auto runScan = [&](CollectionScan* scan, WorkingSet* ws, size_t maxResults) {
+        vector<RecordId> results;
+        while (!scan->isEOF() && results.size() < maxResults) {
+            WorkingSetID id = WorkingSet::INVALID_ID;
+            if (PlanStage::ADVANCED == scan->work(&id)) {
+                results.push_back(ws->get(id)->recordId);
+                ws->free(id);
+            }
+        }
+        return results;
+    };
+
+    // The first scan reports its position once it has returned 'kPositionReportInterval' records.
+    WorkingSet firstWs;
+    auto firstScan =
+        std::make_unique<CollectionScan>(_expCtx.get(), coll, params, &firstWs, nullptr);
+    auto firstResults =
+        runScan(firstScan.get(), &firstWs, SharedScanRegistry::kPositionReportInterval + 10);
+    ASSERT_EQ(firstResults.front(), recordIds.front());
+
+    // The second scan starts at the reported position, then reads the start of the collection.
+    WorkingSet secondWs;
+    auto secondScan =
+        std::make_unique<CollectionScan>(_expCtx.get(), coll, params, &secondWs, nullptr);
+    auto secondResults = runScan(secondScan.get(), &secondWs, recordIds.size() + 1);
+    ASSERT_TRUE(secondScan->isEOF());
+
+    const size_t startOffset = SharedScanRegistry::kPositionReportInterval - 1;
+    vector<RecordId> expectedIds{recordIds.begin() + startOffset, recordIds.end()};
+    expectedIds.insert(expectedIds.end(), recordIds.begin(), recordIds.begin() + startOffset);
+    ASSERT(secondResults == expectedIds);
+
+    // Scans leave the registry at EOF or when destroyed.
+    ASSERT_EQ(SharedScanRegistry::get(_opCtx.getServiceContext()).numScans(coll->uuid()), 1U);
+    firstScan.reset();
+    ASSERT_EQ(SharedScanRegistry::get(_opCtx.getServiceContext()).numScans(coll->uuid()), 0U);
+}
+
 }  // namespace query_stage_collection_scan
@@ -920,6 +920,79 @@ public:
     }
 };
 
+// find($or[{a:1}, {b:1}]) with indices {a:1} and {b:1}, merged on RecordId. Documents matching
+// both branches are returned once.
+class QueryStageMergeSortByRecordId : public QueryStageMergeSortTestBase {
+public:
+    void run() {
+        dbtests::WriteContextForTests ctx(&_opCtx, ns());
+        if (!ctx.getCollection()) {
+            WriteUnitOfWork wuow(&_opCtx);
+            ctx.db()->createCollection(&_opCtx, nss());
+            wuow.commit();
+        }
+
+        const int N = 60;
+        for (int i = 0; i < N; ++i) {
+            insert(BSON("a" << (i % 2 == 0 ? 1 : 0) << "b" << (i % 3 == 0 ? 1 : 0) << "c" << i));
+        }
+
+        BSONObj firstIndex = BSON("a" << 1);
+        BSONObj secondIndex = BSON("b" << 1);
+
+        addIndex(firstIndex);
+        addIndex(secondIndex);
+        auto coll = ctx.getCollection();
+
+        unique_ptr<WorkingSet> ws = make_unique<WorkingSet>();
+        MergeSortStageParams msparams;
+        msparams.mergeByRecordId = true;
+        auto ms = std::make_unique<MergeSortStage>(_expCtx.get(), msparams, ws.get());
+
+        // Point scans over a single key return their results in RecordId order.
+        auto makePointScanParams = [&](const BSONObj& keyPattern) {
+            auto params = makeIndexScanParams(&_opCtx, coll, getIndex(keyPattern, coll));
+            params.bounds.startKey = BSON("" << 1);
+            params.bounds.endKey = BSON("" << 1);
+            return params;
+        };
+
+        // a:1
+        ms->addChild(std::make_unique<IndexScan>(
+            _expCtx.get(), coll, makePointScanParams(firstIndex), ws.get(), nullptr));
+
+        // b:1
+        ms->addChild(std::make_unique<IndexScan>(
+            _expCtx.get(), coll, makePointScanParams(secondIndex), ws.get(), nullptr));
+        unique_ptr<FetchStage> fetchStage =
+            make_unique<FetchStage>(_expCtx.get(), ws.get(), std::move(ms), nullptr, coll);
+
+        auto statusWithPlanExecutor =
+            plan_executor_factory::make(_expCtx,
+                                        std::move(ws),
+                                        std::move(fetchStage),
+                                        &coll,
+                                        PlanYieldPolicy::YieldPolicy::NO_YIELD,
+                                        QueryPlannerParams::DEFAULT);
+        ASSERT_OK(statusWithPlanExecutor.getStatus());
+        auto exec = std::move(statusWithPlanExecutor.getValue());
+
+        // The documents were inserted in order of 'c', so they come out in that order.
+        for (int i = 0; i < N; ++i) {
+            if (i % 2 != 0 && i % 3 != 0) {
+                continue;
+            }
+            BSONObj obj;
+            ASSERT_EQUALS(PlanExecutor::ADVANCED, exec->getNext(&obj, nullptr));
+            ASSERT_EQUALS(i, obj["c"].numberInt());
+        }
+
+        // Should be done now.
+        BSONObj foo;
+        ASSERT_EQUALS(PlanExecutor::IS_EOF, exec->getNext(&foo, nullptr));
+    }
+};
+
 class All : public OldStyleSuiteSpecification {
 public:
     All() : OldStyleSuiteSpecification("query_stage_merge_sort_test") {}
@@ -935,6 +1008,7 @@ public:
         add<QueryStageMergeSortConcurrentUpdateDedup>();
         add<QueryStageMergeSortStringsWithNullCollation>();
         add<QueryStageMergeSortStringsRespectsCollation>();
+        add<QueryStageMergeSortByRecordId>();
     }
 };
 
@@ -60,7 +60,10 @@
 #include "mongo/db/query/stage_builder_util.h"
 #include "mongo/dbtests/dbtests.h"
 #include "mongo/idl/server_parameter_test_util.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/clock_source_mock.h"
+#include "mongo/util/fail_point.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -689,6 +692,60 @@ TEST_F(QueryStageMultiPlanTest, ShouldReportErrorIfKilledDuringPlanning) {
               multiPlanStage.pickBestPlan(&alwaysPlanKilledYieldPolicy));
 }
 
+TEST_F(QueryStageMultiPlanTest, ParallelSbeTrialsStopWhenKilled) {
+    RAIIServerParameterControllerForTest controllerSBE("internalQueryForceClassicEngine", false);
+    RAIIServerParameterControllerForTest controllerParallel(
+        "internalQueryPlanEvaluationMaxParallelTrialsSbe", 2);
+
+    const int N = 5000;
+    for (int i = 0; i < N; ++i) {
+        insert(BSON("foo" << (i % 10)));
+    }
+
+    // Add two indices to give more plans.
+    addIndex(BSON("foo" << 1));
+    addIndex(BSON("foo" << -1 << "bar" << 1));
+
+    // The trials only run in parallel when the query reads at a known timestamp.
+    opCtx()->recoveryUnit()->setTimestampReadSource(RecoveryUnit::ReadSource::kProvided,
+                                                    Timestamp(1, 1));
+    AutoGetCollectionForReadCommand ctx(_opCtx.get(), nss);
+    const CollectionPtr& coll = ctx.getCollection();
+
+    auto findCommand = std::make_unique<FindCommandRequest>(nss);
+    findCommand->setFilter(BSON("foo" << BSON("$gte" << 0)));
+    auto cq = uassertStatusOK(CanonicalQuery::canonicalize(opCtx(), std::move(findCommand)));
+
+    // Kill the query once a trial has started. The trials run on operation contexts of their own,
+    // which must be killed as well for the planner to return.
+    auto fp = globalFailPointRegistry().find("hangDuringSbeParallelTrials");
+    auto timesEntered = fp->setMode(FailPoint::alwaysOn);
+    stdx::thread killer([&] {
+        fp->waitForTimesEntered(timesEntered + 1);
+        stdx::lock_guard<Client> lk(*opCtx()->getClient());
+        serviceContext()->killOperation(lk, opCtx(), ErrorCodes::Interrupted);
+    });
+    ON_BLOCK_EXIT([&] {
+        killer.join();
+        fp->setMode(FailPoint::off);
+    });
+
+    auto status = [&] {
+        try {
+            return getExecutor(opCtx(),
+                               &coll,
+                               std::move(cq),
+                               nullptr /* extractAndAttachPipelineStages */,
+                               PlanYieldPolicy::YieldPolicy::NO_YIELD,
+                               0)
+                .getStatus();
+        } catch (const DBException& ex) {
+            return ex.toStatus();
+        }
+    }();
+    ASSERT_EQ(ErrorCodes::Interrupted, status);
+}
+
 /**
  * A PlanStage for testing which always throws exceptions.
  */
@@ -47,6 +47,11 @@
 #include "mongo/db/logical_time.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/query/find.h"
+#include "mongo/db/query/plan_cache_key_factory.h"
+#include "mongo/db/query/plan_cache_snapshot.h"
+#include "mongo/db/query/sbe_plan_cache.h"
+#include "mongo/db/query/stats/histogram.h"
+#include "mongo/db/query/stats/stats_catalog.h"
 #include "mongo/db/service_context.h"
 #include "mongo/dbtests/dbtests.h"
 #include "mongo/unittest/unittest.h"
@@ -1894,6 +1899,99 @@ public:
     }
 };
 
+TEST(StatsCatalogTest, LookupsOnlyReadTheCacheAndLoadInTheBackground) {
+    const auto opCtxHolder = cc().makeOperationContext();
+    auto opCtx = opCtxHolder.get();
+    DBDirectClient client(opCtx);
+
+    const NamespaceString nss("unittests.stats_catalog");
+    const auto statsNss = nss.makeStatisticsNamespace();
+    client.dropCollection(statsNss.ns());
+
+    const auto values = BSON_ARRAY(1 << 2 << 3);
+    std::vector<BSONElement> elements;
+    for (auto&& elem : values) {
+        elements.push_back(elem);
+    }
+    client.insert(statsNss.ns(),
+                  BSON("_id"
+                       << "a"
+                       << "statistics" << stats::Histogram::build(elements, 2).toBSON()));
+
+    auto& catalog = stats::StatsCatalog::get(opCtx);
+    catalog.invalidate(nss);
+
+    // The first lookup misses the cache and does not read the statistics itself.
+    ASSERT_FALSE(catalog.getHistogram(opCtx, nss, "a"));
+
+    catalog.waitForLoads();
+    ASSERT(catalog.getHistogram(opCtx, nss, "a"));
+    ASSERT_FALSE(catalog.getHistogram(opCtx, nss, "b"));
+
+    client.dropCollection(statsNss.ns());
+    catalog.invalidate(nss);
+}
+
+TEST(PlanCacheSnapshotTest, WriteReplacesTheSnapshotAndLoadSkipsUnknownIndexCatalogs) {
+    const auto opCtxHolder = cc().makeOperationContext();
+    auto opCtx = opCtxHolder.get();
+    DBDirectClient client(opCtx);
+
+    const NamespaceString nss("unittests.plan_cache_snapshot");
+    const auto& snapshotNss = NamespaceString::kLocalPlanCacheSnapshotNamespace;
+    client.dropCollection(nss.ns());
+    client.dropCollection(snapshotNss.ns());
+    ASSERT(client.createCollection(nss.ns()));
+    ASSERT_OK(dbtests::createIndex(opCtx, nss.ns(), BSON("planCacheSnapshotTestField" << 1)));
+
+    std::string fingerprint;
+    {
+        AutoGetCollectionForRead collection(opCtx, nss);
+        fingerprint = plan_cache_key_factory::makeIndexCatalogFingerprint(
+            opCtx, collection.getCollection());
+    }
+    auto makeKey = [](const std::string& fingerprint, StringData shape) {
+        return std::to_string(fingerprint.size()) + ':' + fingerprint + shape;
+    };
+    const auto knownKey = makeKey(fingerprint, "shape");
+    const auto unknownKey = makeKey("unknownFingerprint", "shape");
+    const auto parsedFingerprint = plan_cache_key_factory::getIndexCatalogFingerprint(knownKey);
+    ASSERT(parsedFingerprint);
+    ASSERT_EQ(*parsedFingerprint, fingerprint);
+    ASSERT_FALSE(plan_cache_key_factory::getIndexCatalogFingerprint("malformed"));
+
+    const sbe::SharedShapePlanCache::Entry entry{BSON("solution" << 1), 10};
+    sbe::SharedShapePlanCache cache(10);
+    cache.set(knownKey, entry);
+    cache.set(unknownKey, entry);
+    cache.set("malformed", entry);
+    ASSERT(plan_cache_snapshot::write(opCtx, cache));
+    ASSERT_EQ(client.count(snapshotNss), 3);
+
+    // The snapshot is built aside and renamed over the previous one.
+    sbe::SharedShapePlanCache smallerCache(10);
+    smallerCache.set(unknownKey, entry);
+    ASSERT(plan_cache_snapshot::write(opCtx, smallerCache));
+    ASSERT_EQ(client.count(snapshotNss), 1);
+    ASSERT_FALSE(client.exists(snapshotNss.ns() + ".tmp"));
+
+    // Only the entry matching the index catalog of an existing collection is loaded.
+    ASSERT(plan_cache_snapshot::write(opCtx, cache));
+    sbe::SharedShapePlanCache loadedCache(10);
+    ASSERT_EQ(plan_cache_snapshot::load(opCtx, loadedCache), 1U);
+    ASSERT(loadedCache.find(knownKey));
+    ASSERT_FALSE(loadedCache.find(unknownKey));
+    ASSERT_FALSE(loadedCache.find("malformed"));
+
+    // Once the index is dropped, no collection matches the entry anymore.
+    client.dropIndex(nss.ns(), BSON("planCacheSnapshotTestField" << 1));
+    sbe::SharedShapePlanCache reloadedCache(10);
+    ASSERT_EQ(plan_cache_snapshot::load(opCtx, reloadedCache), 0U);
+
+    client.dropCollection(nss.ns());
+    client.dropCollection(snapshotNss.ns());
+}
+
 class All : public OldStyleSuiteSpecification {
 public:
     All() : OldStyleSuiteSpecification("query") {}
@@ -66,6 +66,10 @@ public:
         UASSERT_NOT_IMPLEMENTED;
     }
 
+    uint64_t getCacheEpoch() const override {
+        return 0;
+    }
+
     bool hasAnyPrivilegeDocuments(OperationContext*) override {
         UASSERT_NOT_IMPLEMENTED;
     }
@@ -64,6 +64,13 @@ struct ConnectionPoolStats;
  *
  * The overall workflow here is to manage separate pools for each unique
  * HostAndPort. See comments on the various Options for how the pool operates.
+ *
+ * A leased connection carries exactly one in-flight request: the wire protocol's responseTo is
+ * only used to validate the reply on that connection, not to demultiplex replies to concurrent
+ * requests. The number of connections to a host therefore tracks the number of concurrent
+ * requests to it, bounded by Options::maxConnections, and is multiplied by the number of pools
+ * (e.g. one per executor in a TaskExecutorPool) that target the host, unless the Controller bounds
+ * the sum, as ShardingTaskExecutorPoolController does for ShardingTaskExecutorPoolMaxSizePerHost.
  */
 class ConnectionPool : public EgressTagCloser, public std::enable_shared_from_this<ConnectionPool> {
     class LimitController;
@@ -739,6 +739,38 @@ TEST_F(NetworkInterfaceInternalClientTest, StartCommandOnAny) {
     assertNumOps(0u, 0u, 0u, 1u);
 }
 
+TEST_F(NetworkInterfaceInternalClientTest, StartCommandOnAnySkipsHedgeWhenFirstHostAnswersInTime) {
+    const auto hedgeDelay = Minutes(10);
+    auto request = [&] {
+        auto cs = fixture();
+        RemoteCommandRequestBase::HedgeOptions ho;
+        ho.count = 1;
+        ho.delayMSForHedgedReads = durationCount<Milliseconds>(hedgeDelay);
+
+        // Target the same host twice so that the request is eligible for hedging.
+        auto target = cs.getServers().front();
+        return RemoteCommandRequestOnAny({target, target},
+                                         "admin",
+                                         makeEchoCmdObj(),
+                                         BSONObj(),
+                                         nullptr,
+                                         RemoteCommandRequest::kNoTimeout,
+                                         ho);
+    }();
+
+    auto deferred = runCommandOnAny(makeCallbackHandle(), std::move(request));
+    auto res = deferred.get();
+
+    uassertStatusOK(res.status);
+    ASSERT_EQ(1, res.data.getIntField("ok"));
+    ASSERT(res.elapsed);
+    ASSERT_LT(*res.elapsed, hedgeDelay);
+
+    // The echo answered before the hedge delay expired, so no second echo was sent and there was
+    // no hedged operation left to kill.
+    assertNumOps(0u, 0u, 0u, 1u);
+}
+
 TEST_F(NetworkInterfaceTest, SetAlarm) {
     // set a first alarm, to execute after "expiration"
     Date_t expiration = net().now() + Milliseconds(100);
@@ -594,8 +594,43 @@ Status NetworkInterfaceTL::startCommand(const TaskExecutor::CallbackHandle& cbHa
         return Status::OK();
     }
 
+    const auto hedgeDelay = request.hedgeOptions
+        ? Milliseconds(request.hedgeOptions->delayMSForHedgedReads)
+        : Milliseconds(0);
+
     // Attempt to get a connection to every target host
     for (size_t idx = 0; idx < request.target.size(); ++idx) {
+        if (idx > 0 && hedgeDelay > Milliseconds(0) && !targetHostsInAlphabeticalOrder) {
+            // Only hedge to the remaining hosts if the first one has not answered within the hedge
+            // delay. The connection is not acquired until then, so a request which finishes in
+            // time does not tie up connections to the other hosts.
+            std::shared_ptr<transport::ReactorTimer> timer = _reactor->makeTimer();
+            timer->waitUntil(now() + hedgeDelay, nullptr)
+                .getAsync([this,
+                           timer,
+                           cmdState = cmdState,
+                           idx,
+                           target = request.target[idx],
+                           sslMode = request.sslMode,
+                           timeout = request.timeout](Status status) {
+                    if (!status.isOK()) {
+                        cmdState->requestManager->trySend(status, idx);
+                        return;
+                    }
+
+                    if (cmdState->finishLine.isReady()) {
+                        return;
+                    }
+
+                    _pool->get(target, sslMode, timeout)
+                        .thenRunOn(_reactor)
+                        .getAsync([cmdState = cmdState, idx](auto swConn) {
+                            cmdState->requestManager->trySend(std::move(swConn), idx);
+                        });
+                });
+            continue;
+        }
+
         auto connFuture = _pool->get(request.target[idx], request.sslMode, request.timeout);
 
         // If connection future is ready or requests should be sent in order, send the request
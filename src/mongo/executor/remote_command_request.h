@@ -47,6 +47,8 @@ struct RemoteCommandRequestBase {
     struct HedgeOptions {
         size_t count = 0;
         int maxTimeMSForHedgedReads = 0;
+        // How long to wait for the first target to respond before sending the hedged requests.
+        int delayMSForHedgedReads = 0;
     };
 
     enum FireAndForgetMode { kOn, kOff };
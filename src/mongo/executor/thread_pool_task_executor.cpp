@@ -33,6 +33,7 @@
 
 #include "mongo/executor/thread_pool_task_executor.h"
 
+#include <algorithm>
 #include <boost/optional.hpp>
 #include <iterator>
 #include <utility>
@@ -48,6 +49,7 @@
 #include "mongo/util/concurrency/thread_pool_interface.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/time_support.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 namespace executor {
@@ -102,6 +104,7 @@ public:
     AtomicWord<bool> isFinished{false};
     boost::optional<stdx::condition_variable> finishedCondition;
     BatonHandle baton;
+    Timer poolQueueTimer;  // Reset when the callback is scheduled into the thread pool.
     AtomicWord<bool> exhaustErased{
         false};  // Used only in the exhaust path. Used to indicate that a cbState associated with
                  // an exhaust request has been removed from the '_networkInProgressQueue'.
@@ -255,6 +258,11 @@ void ThreadPoolTaskExecutor::appendDiagnosticBSON(BSONObjBuilder* b) const {
     BSONObjBuilder poolCounters(b->subobjStart("pool"));
     poolCounters.appendNumber("inProgressCount",
                               static_cast<long long>(_poolInProgressQueue.size()));
+    BSONObjBuilder queueLatency(poolCounters.subobjStart("queueLatency"));
+    queueLatency.appendNumber("count", _poolQueueLatency.count);
+    queueLatency.appendNumber("totalMicros", durationCount<Microseconds>(_poolQueueLatency.total));
+    queueLatency.appendNumber("maxMicros", durationCount<Microseconds>(_poolQueueLatency.max));
+    queueLatency.done();
     poolCounters.done();
 
     // Queues
@@ -592,6 +600,9 @@ void ThreadPoolTaskExecutor::scheduleIntoPool_inlock(WorkQueue* fromQueue,
                                                      stdx::unique_lock<Latch> lk) {
     dassert(fromQueue != &_poolInProgressQueue);
     std::vector<std::shared_ptr<CallbackState>> todo(begin, end);
+    for (const auto& cbState : todo) {
+        cbState->poolQueueTimer.reset();
+    }
     _poolInProgressQueue.splice(_poolInProgressQueue.end(), *fromQueue, begin, end);
 
     lk.unlock();
@@ -655,6 +666,7 @@ void ThreadPoolTaskExecutor::runCallback(std::shared_ptr<CallbackState> cbStateA
         TaskExecutor::CallbackFn callback;
         {
             auto lk = stdx::lock_guard(_mutex);
+            _recordPoolQueueLatency_inlock(*cbStateArg);
             std::swap(cbStateArg->callback, callback);
         }
         callback(std::move(args));
@@ -778,6 +790,7 @@ void ThreadPoolTaskExecutor::scheduleExhaustIntoPool_inlock(std::shared_ptr<Call
                                                             stdx::unique_lock<Latch> lk) {
     _poolInProgressQueue.push_back(cbState);
     cbState->exhaustIter = --_poolInProgressQueue.end();
+    cbState->poolQueueTimer.reset();
     auto expectedExhaustIter = cbState->exhaustIter.get();
     lk.unlock();
 
@@ -825,6 +838,7 @@ void ThreadPoolTaskExecutor::runCallbackExhaust(std::shared_ptr<CallbackState> c
                       cbState->canceled.load() ? kCallbackCanceledErrorStatus : Status::OK());
 
     if (auto lk = stdx::unique_lock(_mutex); !cbState->isFinished.load()) {
+        _recordPoolQueueLatency_inlock(*cbState);
         TaskExecutor::CallbackFn callback = [](const CallbackArgs&) {};
         {
             std::swap(cbState->callback, callback);
@@ -871,6 +885,13 @@ bool ThreadPoolTaskExecutor::hasTasks() {
     return false;
 }
 
+void ThreadPoolTaskExecutor::_recordPoolQueueLatency_inlock(const CallbackState& cbState) {
+    const auto latency = cbState.poolQueueTimer.elapsed();
+    ++_poolQueueLatency.count;
+    _poolQueueLatency.total += latency;
+    _poolQueueLatency.max = std::max(_poolQueueLatency.max, latency);
+}
+
 bool ThreadPoolTaskExecutor::_inShutdown_inlock() const {
     return _state >= joinRequired;
 }
@@ -201,6 +201,12 @@ private:
     void runCallbackExhaust(std::shared_ptr<CallbackState> cbState,
                             WorkQueue::iterator expectedExhaustIter);
 
+    /**
+     * Records how long "cbState" waited between being scheduled into the thread pool and starting
+     * to run.
+     */
+    void _recordPoolQueueLatency_inlock(const CallbackState& cbState);
+
     bool _inShutdown_inlock() const;
     void _setState_inlock(State newState);
     stdx::unique_lock<Latch> _join(stdx::unique_lock<Latch> lk);
@@ -228,6 +234,14 @@ private:
     // List of all events that have yet to be signaled.
     EventList _unsignaledEvents;
 
+    // Time that ready work items spent waiting for a thread pool thread, reported by
+    // appendDiagnosticBSON().
+    struct PoolQueueLatency {
+        long long count = 0;
+        Microseconds total{0};
+        Microseconds max{0};
+    } _poolQueueLatency;
+
     // Lifecycle state of this executor.
     stdx::condition_variable _stateChange;
     State _state = preStart;
@@ -91,6 +91,27 @@ TEST_F(ThreadPoolExecutorTest, Schedule) {
     executor.join();
 }
 
+TEST_F(ThreadPoolExecutorTest, DiagnosticsReportPoolQueueLatency) {
+    auto& executor = getExecutor();
+    launchExecutorThread();
+    unittest::Barrier barrier{2};
+    ASSERT_OK(executor
+                  .scheduleWork([&](const TaskExecutor::CallbackArgs&) {
+                      barrier.countDownAndWait();
+                  })
+                  .getStatus());
+    barrier.countDownAndWait();
+    executor.shutdown();
+    executor.join();
+
+    BSONObjBuilder bob;
+    executor.appendDiagnosticBSON(&bob);
+    const auto queueLatency = bob.obj()["pool"]["queueLatency"];
+    ASSERT_EQ(1, queueLatency["count"].numberLong());
+    ASSERT_GTE(queueLatency["maxMicros"].numberLong(), 0);
+    ASSERT_GTE(queueLatency["totalMicros"].numberLong(), queueLatency["maxMicros"].numberLong());
+}
+
 TEST_F(ThreadPoolExecutorTest, ScheduleAfterShutdown) {
     auto& executor = getExecutor();
     auto status1 = getDetectableErrorStatus();
@@ -33,13 +33,18 @@
 #include <boost/filesystem/operations.hpp>
 #include <boost/iterator/filter_iterator.hpp>
 #include <boost/iterator/transform_iterator.hpp>
+#include <boost/log/attributes/value_extraction.hpp>
 #include <boost/make_shared.hpp>
 #include <fmt/format.h>
 #include <fstream>
 
+#include "mongo/logv2/attributes.h"
 #include "mongo/logv2/json_formatter.h"
 #include "mongo/logv2/log_detail.h"
 #include "mongo/logv2/shared_access_fstream.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/quick_exit.h"
 #include "mongo/util/stacktrace.h"
 #include "mongo/util/string_map.h"
@@ -74,15 +79,155 @@ StatusWith<boost::shared_ptr<stream_t>> openFile(const std::string& filename, bo
 
 struct FileRotateSink::Impl {
     Impl(LogTimestampFormat tsFormat) : timestampFormat(tsFormat) {}
+
+    void abortIfWriteFailed();
+    void writeBuffered();
+
     StringMap<boost::shared_ptr<stream_t>> files;
     LogTimestampFormat timestampFormat;
+
+    // Serializes the writer thread with changes to the files.
+    stdx::mutex fileMutex;  // NOLINT
+
+    // The state below is only used once enableAsyncWrites() has set maxBufferedBytes.
+    size_t maxBufferedBytes = 0;
+    stdx::mutex asyncMutex;  // NOLINT
+    stdx::condition_variable wakeWriter;
+    stdx::condition_variable drained;
+    std::string buffered;
+    size_t droppedRecords = 0;
+    bool writing = false;
+    bool shuttingDown = false;
+    stdx::thread writer;
 };
 
+void FileRotateSink::Impl::abortIfWriteFailed() {
+    auto isFailed = [](const auto& file) { return file.second->fail(); };
+    if (std::none_of(files.begin(), files.end(), isFailed)) {
+        return;
+    }
+
+    try {
+        auto failedBegin = boost::make_filter_iterator(isFailed, files.begin(), files.end());
+        auto failedEnd = boost::make_filter_iterator(isFailed, files.end(), files.end());
+
+        auto getFilename = [](const auto& file) -> const auto& {
+            return file.first;
+        };
+        auto begin = boost::make_transform_iterator(failedBegin, getFilename);
+        auto end = boost::make_transform_iterator(failedEnd, getFilename);
+        auto sequence = logv2::seqLog(begin, end);
+
+        DynamicAttributes attrs;
+        attrs.add("files", sequence);
+
+        fmt::memory_buffer buffer;
+        JSONFormatter(nullptr, timestampFormat)
+            .format(buffer,
+                    LogSeverity::Severe(),
+                    LogComponent::kControl,
+                    Date_t::now(),
+                    4522200,
+                    getThreadName(),
+                    "Writing to log file failed, aborting application",
+                    TypeErasedAttributeStorage(attrs),
+                    LogTag::kNone,
+                    nullptr /* tenantID */,
+                    LogTruncation::Disabled);
+        // Commented out log line below to get validation of the log id with the errorcodes
+        // linter LOGV2(4522200, "Writing to log file failed, aborting application");
+        std::cerr << StringData(buffer.data(), buffer.size()) << std::endl;
+    } catch (const std::exception& ex) {
+        std::cerr << "Caught std::exception of type " << demangleName(typeid(ex)) << ": "
+                  << ex.what() << std::endl;
+    } catch (const boost::exception& ex) {
+        std::cerr << "Caught boost::exception of type " << demangleName(typeid(ex)) << ": "
+                  << boost::diagnostic_information(ex) << std::endl;
+    } catch (...) {
+        std::cerr << "Caught unidentified exception" << std::endl;
+    }
+
+    printStackTrace(std::cerr);
+    quickExitWithoutLogging(EXIT_FAILURE);
+}
+
+void FileRotateSink::Impl::writeBuffered() {
+    stdx::unique_lock lk(asyncMutex);
+    while (true) {
+        wakeWriter.wait(lk, [&] { return shuttingDown || !buffered.empty(); });
+        if (buffered.empty()) {
+            return;
+        }
+
+        std::string batch;
+        batch.swap(buffered);
+        auto dropped = std::exchange(droppedRecords, 0);
+        writing = true;
+        lk.unlock();
+
+        if (dropped) {
+            // The records were dropped after the ones in this batch were buffered, so the warning
+            // goes at its end.
+            DynamicAttributes attrs;
+            attrs.add("dropped", static_cast<long long>(dropped));
+
+            fmt::memory_buffer buffer;
+            JSONFormatter(nullptr, timestampFormat)
+                .format(buffer,
+                        LogSeverity::Warning(),
+                        LogComponent::kControl,
+                        Date_t::now(),
+                        7027509,
+                        getThreadName(),
+                        "Dropped log records because the log buffer was full",
+                        TypeErasedAttributeStorage(attrs),
+                        LogTag::kNone,
+                        nullptr /* tenantID */,
+                        LogTruncation::Disabled);
+            // Commented out log line below to get validation of the log id with the errorcodes
+            // linter LOGV2(7027509, "Dropped log records because the log buffer was full");
+            batch.append(buffer.data(), buffer.size()).push_back('\n');
+        }
+
+        {
+            stdx::lock_guard fileLk(fileMutex);
+            for (auto& file : files) {
+                file.second->write(batch.data(), batch.size());
+                file.second->flush();
+            }
+            abortIfWriteFailed();
+        }
+
+        lk.lock();
+        writing = false;
+        drained.notify_all();
+    }
+}
+
 FileRotateSink::FileRotateSink(LogTimestampFormat timestampFormat)
     : _impl(std::make_unique<Impl>(timestampFormat)) {}
-FileRotateSink::~FileRotateSink() {}
+
+FileRotateSink::~FileRotateSink() {
+    if (_impl->writer.joinable()) {
+        {
+            stdx::lock_guard lk(_impl->asyncMutex);
+            _impl->shuttingDown = true;
+            _impl->wakeWriter.notify_one();
+        }
+        _impl->writer.join();
+    }
+}
+
+void FileRotateSink::enableAsyncWrites(size_t maxBufferedBytes) {
+    invariant(_impl->files.empty());
+    invariant(!_impl->writer.joinable());
+    invariant(maxBufferedBytes > 0);
+    _impl->maxBufferedBytes = maxBufferedBytes;
+    _impl->writer = stdx::thread([impl = _impl.get()] { impl->writeBuffered(); });
+}
 
 Status FileRotateSink::addFile(const std::string& filename, bool append) {
+    stdx::lock_guard lk(_impl->fileMutex);
     auto statusWithFile = openFile(filename, append);
     if (statusWithFile.isOK()) {
         add_stream(statusWithFile.getValue());
@@ -92,6 +237,7 @@ Status FileRotateSink::addFile(const std::string& filename, bool append) {
     return statusWithFile.getStatus().withContext("Can't initialize rotatable log file");
 }
 void FileRotateSink::removeFile(const std::string& filename) {
+    stdx::lock_guard lk(_impl->fileMutex);
     auto it = _impl->files.find(filename);
     if (it != _impl->files.cend()) {
         remove_stream(it->second);
@@ -102,6 +248,7 @@ void FileRotateSink::removeFile(const std::string& filename) {
 Status FileRotateSink::rotate(bool rename,
                               StringData renameSuffix,
                               std::function<void(Status)> onMinorError) {
+    stdx::lock_guard lk(_impl->fileMutex);
     for (auto& file : _impl->files) {
         const std::string& filename = file.first;
         if (rename) {
@@ -163,54 +310,54 @@ Status FileRotateSink::rotate(bool rename,
 
 void FileRotateSink::consume(const boost::log::record_view& rec,
                              const string_type& formatted_string) {
-    auto isFailed = [](const auto& file) { return file.second->fail(); };
-    boost::log::sinks::text_ostream_backend::consume(rec, formatted_string);
-    if (std::any_of(_impl->files.begin(), _impl->files.end(), isFailed)) {
-        try {
-            auto failedBegin =
-                boost::make_filter_iterator(isFailed, _impl->files.begin(), _impl->files.end());
-            auto failedEnd =
-                boost::make_filter_iterator(isFailed, _impl->files.end(), _impl->files.end());
-
-            auto getFilename = [](const auto& file) -> const auto& {
-                return file.first;
-            };
-            auto begin = boost::make_transform_iterator(failedBegin, getFilename);
-            auto end = boost::make_transform_iterator(failedEnd, getFilename);
-            auto sequence = logv2::seqLog(begin, end);
-
-            DynamicAttributes attrs;
-            attrs.add("files", sequence);
+    if (_impl->maxBufferedBytes && isWrittenSynchronously(rec)) {
+        // Errors are often the last thing logged before the process exits without flushing the
+        // log, so they are written before consume() returns, after the records buffered before
+        // them. Holding asyncMutex while waiting for the writer's current batch keeps the order.
+        stdx::lock_guard lk(_impl->asyncMutex);
+        stdx::lock_guard fileLk(_impl->fileMutex);
+        for (auto& file : _impl->files) {
+            file.second->write(_impl->buffered.data(), _impl->buffered.size());
+        }
+        _impl->buffered.clear();
+        boost::log::sinks::text_ostream_backend::consume(rec, formatted_string);
+        boost::log::sinks::text_ostream_backend::flush();
+        _impl->abortIfWriteFailed();
+        return;
+    }
 
-            fmt::memory_buffer buffer;
-            JSONFormatter(nullptr, _impl->timestampFormat)
-                .format(buffer,
-                        LogSeverity::Severe(),
-                        LogComponent::kControl,
-                        Date_t::now(),
-                        4522200,
-                        getThreadName(),
-                        "Writing to log file failed, aborting application",
-                        TypeErasedAttributeStorage(attrs),
-                        LogTag::kNone,
-                        nullptr /* tenantID */,
-                        LogTruncation::Disabled);
-            // Commented out log line below to get validation of the log id with the errorcodes
-            // linter LOGV2(4522200, "Writing to log file failed, aborting application");
-            std::cerr << StringData(buffer.data(), buffer.size()) << std::endl;
-        } catch (const std::exception& ex) {
-            std::cerr << "Caught std::exception of type " << demangleName(typeid(ex)) << ": "
-                      << ex.what() << std::endl;
-        } catch (const boost::exception& ex) {
-            std::cerr << "Caught boost::exception of type " << demangleName(typeid(ex)) << ": "
-                      << boost::diagnostic_information(ex) << std::endl;
-        } catch (...) {
-            std::cerr << "Caught unidentified exception" << std::endl;
+    if (_impl->maxBufferedBytes) {
+        stdx::lock_guard lk(_impl->asyncMutex);
+        if (_impl->buffered.size() + formatted_string.size() + 1 > _impl->maxBufferedBytes) {
+            ++_impl->droppedRecords;
+            return;
         }
+        _impl->buffered.append(formatted_string).push_back('\n');
+        _impl->wakeWriter.notify_one();
+        return;
+    }
+
+    boost::log::sinks::text_ostream_backend::consume(rec, formatted_string);
+    _impl->abortIfWriteFailed();
+}
 
-        printStackTrace(std::cerr);
-        quickExitWithoutLogging(EXIT_FAILURE);
+bool FileRotateSink::isWrittenSynchronously(const boost::log::record_view& rec) {
+    if (!rec) {
+        return false;
     }
+    auto severity = boost::log::extract<LogSeverity>(attributes::severity(), rec);
+    return severity && severity.get() >= LogSeverity::Error();
+}
+
+void FileRotateSink::flush() {
+    if (_impl->maxBufferedBytes) {
+        // The writer thread flushes the files after each batch.
+        stdx::unique_lock lk(_impl->asyncMutex);
+        _impl->drained.wait(lk, [&] { return _impl->buffered.empty() && !_impl->writing; });
+        return;
+    }
+
+    boost::log::sinks::text_ostream_backend::flush();
 }
 
 }  // namespace mongo::logv2
@@ -50,9 +50,31 @@ public:
 
     Status rotate(bool rename, StringData renameSuffix, std::function<void(Status)> onMinorError);
 
+    /**
+     * Hands formatted records to a background thread that writes them to the files, so that the
+     * logging threads do not wait on file I/O. At most maxBufferedBytes of records wait for the
+     * writer; records that do not fit are dropped, and the writer logs how many it dropped. Errors
+     * are the exception, see consume(). Must be called before any file is added.
+     */
+    void enableAsyncWrites(size_t maxBufferedBytes);
+
+    /**
+     * Writes a record to the files, or hands it to the writer thread if enableAsyncWrites() was
+     * called. Records of severity Error and above are always written before this returns, along
+     * with the records buffered before them, so that they are not lost when the process exits
+     * without flushing the log.
+     */
     void consume(const boost::log::record_view& rec, const string_type& formatted_string);
 
+    /**
+     * Waits for the records handed to the writer thread, if any, to be written, then flushes the
+     * files.
+     */
+    void flush();
+
 private:
+    static bool isWrittenSynchronously(const boost::log::record_view& rec);
+
     struct Impl;
     std::unique_ptr<Impl> _impl;
 };
@@ -85,6 +85,12 @@ struct LogDomainGlobal::Impl {
     LogDomainGlobal& _parent;
     LogComponentSettings _settings;
     ConfigurationOptions _config;
+
+    // The sinks format each record on the logging thread, before the log statement returns. They
+    // cannot be swapped for boost::log's asynchronous frontends: the attributes of a record are a
+    // TypeErasedAttributeStorage that points into the caller's stack frame, so they must be
+    // consumed before that frame unwinds. Only the file write of the already formatted record can
+    // be deferred, which the file sink does when fileAsyncBufferBytes is set.
     boost::shared_ptr<boost::log::sinks::unlocked_sink<ConsoleBackend>> _consoleSink;
     boost::shared_ptr<boost::log::sinks::unlocked_sink<RotatableFileBackend>> _rotatableFileSink;
     boost::shared_ptr<boost::log::sinks::unlocked_sink<BacktraceBackend>> _backtraceSink;
@@ -169,6 +175,9 @@ Status LogDomainGlobal::Impl::configure(LogDomainGlobal::ConfigurationOptions co
             boost::make_shared<RamLogSink>(RamLog::get("global")),
             boost::make_shared<RamLogSink>(RamLog::get("startupWarnings")),
             boost::make_shared<UserAssertSink>());
+        if (options.fileAsyncBufferBytes) {
+            backend->lockedBackend<0>()->enableAsyncWrites(options.fileAsyncBufferBytes);
+        }
         Status ret = backend->lockedBackend<0>()->addFile(
             options.filePath,
             options.fileOpenMode == ConfigurationOptions::OpenMode::kAppend ? true : false);
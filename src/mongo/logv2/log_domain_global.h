@@ -45,6 +45,9 @@ public:
         std::string filePath;
         RotationMode fileRotationMode{RotationMode::kRename};
         OpenMode fileOpenMode{OpenMode::kTruncate};
+        // If non-zero, the log file is written by a background thread that buffers at most this
+        // many bytes of formatted records. See FileRotateSink::enableAsyncWrites().
+        size_t fileAsyncBufferBytes{0};
         LogTimestampFormat timestampFormat{LogTimestampFormat::kISO8601UTC};
         bool syslogEnabled{false};
         int syslogFacility{-1};  // invalid facility by default, must be set
@@ -47,6 +47,7 @@
 #include "mongo/logv2/component_settings_filter.h"
 #include "mongo/logv2/composite_backend.h"
 #include "mongo/logv2/constants.h"
+#include "mongo/logv2/file_rotate_sink.h"
 #include "mongo/logv2/json_formatter.h"
 #include "mongo/logv2/log.h"
 #include "mongo/logv2/log_capture_backend.h"
@@ -1813,6 +1814,67 @@ TEST_F(LogV2Test, FileLogging) {
     ASSERT(before_rotation == after_rotation);
 }
 
+TEST_F(LogV2Test, FileRotateSinkAsyncWrites) {
+    auto logv2_dir = std::make_unique<mongo::unittest::TempDir>("logv2");
+    std::string file_name = logv2_dir->path() + "/async.log";
+
+    auto readFile = [&] {
+        std::vector<std::string> lines;
+        std::ifstream file(file_name);
+        for (std::string line; std::getline(file, line, '\n');)
+            lines.push_back(std::move(line));
+        return lines;
+    };
+
+    FileRotateSink sink(LogTimestampFormat::kISO8601UTC);
+    sink.enableAsyncWrites(64);
+    ASSERT_OK(sink.addFile(file_name, false));
+
+    sink.consume(boost::log::record_view(), "first");
+    sink.consume(boost::log::record_view(), "second");
+    sink.flush();
+    ASSERT(readFile() == std::vector<std::string>({"first", "second"}));
+
+    // A record that can never fit in the buffer is dropped, and the writer reports the drop after
+    // the next batch it writes.
+    sink.consume(boost::log::record_view(), std::string(100, 'x'));
+    sink.consume(boost::log::record_view(), "third");
+    sink.flush();
+    auto lines = readFile();
+    ASSERT_EQ(lines.size(), 4U);
+    ASSERT_EQ(lines[2], "third");
+    auto dropped = fromjson(lines[3]);
+    ASSERT_EQ(dropped.getField(kIdFieldName).numberInt(), 7027509);
+    ASSERT_EQ(dropped.getField(kAttributesFieldName).Obj().getField("dropped").numberLong(), 1);
+}
+
+TEST_F(LogV2Test, FileRotateSinkAsyncWritesErrorsSynchronously) {
+    auto logv2_dir = std::make_unique<mongo::unittest::TempDir>("logv2");
+    std::string file_name = logv2_dir->path() + "/async.log";
+
+    auto readFile = [&] {
+        std::vector<std::string> lines;
+        std::ifstream file(file_name);
+        for (std::string line; std::getline(file, line, '\n');)
+            lines.push_back(std::move(line));
+        return lines;
+    };
+
+    auto backend = boost::make_shared<FileRotateSink>(LogTimestampFormat::kISO8601UTC);
+    backend->enableAsyncWrites(1024 * 1024);
+    ASSERT_OK(backend->addFile(file_name, false));
+    auto sink = wrapInSynchronousSink(backend);
+    applyDefaultFilterToSink(sink);
+    sink->set_formatter(PlainFormatter());
+    attachSink(sink);
+
+    // The error is in the file as soon as the log statement returns, and the records buffered
+    // before it are written first.
+    LOGV2(7027519, "buffered");
+    LOGV2_ERROR(7027520, "error");
+    ASSERT(readFile() == std::vector<std::string>({"buffered", "error"}));
+}
+
 TEST_F(LogV2Test, UserAssert) {
     std::vector<std::string> lines;
     auto sink = wrapInSynchronousSink(wrapInCompositeBackend(
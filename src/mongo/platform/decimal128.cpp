@@ -752,6 +752,34 @@ bool Decimal128::isNegative() const {
     return bid128_isSigned(decimal128ToLibraryType(_value));
 }
 
+/**
+ * The following static const variables are used to mathematically produce
+ * frequently needed Decimal128 constants.
+ */
+
+namespace {
+// Get the representation of 1 with 17 zeros (half of decimal128's 34 digit precision)
+const std::uint64_t t17 = 100ull * 1000 * 1000 * 1000 * 1000 * 1000;
+// Get the low 64 bits of 34 consecutive decimal 9's
+// t17 * 17 gives 1 with 34 0's, so subtract 1 to get all 9's == 4003012203950112767
+// Using the computed constant avoids a MSVC warning.
+// Computed by running the calculations in Python, and verified with static_assert.
+const std::uint64_t t34lo64 = 4003012203950112767ULL;
+#if defined(__GNUC__)
+MONGO_STATIC_ASSERT(t34lo64 == t17 * t17 - 1);
+#endif
+// Mod t17 by 2^32 to get the low 32 bits of t17's binary representation
+const std::uint64_t t17lo32 = t17 % (1ull << 32);
+// Divide t17 by 2^32 to get the high 32 bits of t17's binary representation
+const std::uint64_t t17hi32 = t17 >> 32;
+// Multiply t17 by t17 and keep the high 64 bits by distributing the operation to
+// t17hi32*t17hi32 + 2*t17hi32*t17lo32 + t17lo32*t17lo32 where the 2nd term
+// is shifted right by 32 and the 3rd term by 64 (which effectively drops the 3rd term)
+const std::uint64_t t34hi64 = t17hi32 * t17hi32 + (((t17hi32 * t17lo32) >> 31));
+MONGO_STATIC_ASSERT(t34hi64 == 0x1ed09bead87c0);
+MONGO_STATIC_ASSERT(t34lo64 == 0x378d8e63ffffffff);
+}  // namespace
+
 Decimal128 Decimal128::add(const Decimal128& other, RoundingMode roundMode) const {
     std::uint32_t throwAwayFlag = 0;
     return add(other, &throwAwayFlag, roundMode);
@@ -760,6 +788,21 @@ Decimal128 Decimal128::add(const Decimal128& other, RoundingMode roundMode) cons
 Decimal128 Decimal128::add(const Decimal128& other,
                            std::uint32_t* signalingFlags,
                            RoundingMode roundMode) const {
+    // Fast path for two finite values with the same sign and exponent, such as amounts of money
+    // stored at a fixed scale: the sign and combination fields sit above the 49 high coefficient
+    // bits, so comparing those bits checks all three at once. If the coefficient sum still fits
+    // in 34 digits the result is exact, has the same exponent, and needs no rounding or flags.
+    const std::uint64_t signAndCombination = _value.high64 & ~kCanonicalCoefficientHighFieldMask;
+    if (_getCombinationField() < kCombinationNonCanonical &&
+        signAndCombination == (other._value.high64 & ~kCanonicalCoefficientHighFieldMask)) {
+        const std::uint64_t low = _value.low64 + other._value.low64;
+        const std::uint64_t high =
+            getCoefficientHigh() + other.getCoefficientHigh() + (low < _value.low64 ? 1 : 0);
+        if (high < t34hi64 || (high == t34hi64 && low <= t34lo64)) {
+            return Decimal128(Value{low, signAndCombination | high});
+        }
+    }
+
     BID_UINT128 current = decimal128ToLibraryType(_value);
     BID_UINT128 addend = decimal128ToLibraryType(other.getValue());
     current = bid128_add(current, addend, roundMode, signalingFlags);
@@ -983,34 +1026,6 @@ bool Decimal128::isLessEqual(const Decimal128& other) const {
     return bid128_quiet_less_equal(current, compare, &throwAwayFlag);
 }
 
-/**
- * The following static const variables are used to mathematically produce
- * frequently needed Decimal128 constants.
- */
-
-namespace {
-// Get the representation of 1 with 17 zeros (half of decimal128's 34 digit precision)
-const std::uint64_t t17 = 100ull * 1000 * 1000 * 1000 * 1000 * 1000;
-// Get the low 64 bits of 34 consecutive decimal 9's
-// t17 * 17 gives 1 with 34 0's, so subtract 1 to get all 9's == 4003012203950112767
-// Using the computed constant avoids a MSVC warning.
-// Computed by running the calculations in Python, and verified with static_assert.
-const std::uint64_t t34lo64 = 4003012203950112767ULL;
-#if defined(__GNUC__)
-MONGO_STATIC_ASSERT(t34lo64 == t17 * t17 - 1);
-#endif
-// Mod t17 by 2^32 to get the low 32 bits of t17's binary representation
-const std::uint64_t t17lo32 = t17 % (1ull << 32);
-// Divide t17 by 2^32 to get the high 32 bits of t17's binary representation
-const std::uint64_t t17hi32 = t17 >> 32;
-// Multiply t17 by t17 and keep the high 64 bits by distributing the operation to
-// t17hi32*t17hi32 + 2*t17hi32*t17lo32 + t17lo32*t17lo32 where the 2nd term
-// is shifted right by 32 and the 3rd term by 64 (which effectively drops the 3rd term)
-const std::uint64_t t34hi64 = t17hi32 * t17hi32 + (((t17hi32 * t17lo32) >> 31));
-MONGO_STATIC_ASSERT(t34hi64 == 0x1ed09bead87c0);
-MONGO_STATIC_ASSERT(t34lo64 == 0x378d8e63ffffffff);
-}  // namespace
-
 // (t34hi64 << 64) + t34lo64 == 1e34 - 1
 const Decimal128 Decimal128::kLargestPositive(0, Decimal128::kMaxBiasedExponent, t34hi64, t34lo64);
 // The smallest positive decimal is 1 with the largest negative exponent of 0 (biased)
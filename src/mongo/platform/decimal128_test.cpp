@@ -1039,6 +1039,31 @@ TEST(Decimal128Test, TestDecimal128AdditionCase2) {
     ASSERT_EQUALS(result.getValue().high64, expected.getValue().high64);
 }
 
+TEST(Decimal128Test, TestDecimal128AdditionSameExponent) {
+    Decimal128 d1("-1234.56");
+    Decimal128 d2("-0.01");
+    Decimal128 result = d1.add(d2);
+    Decimal128 expected("-1234.57");
+    ASSERT_EQUALS(result.getValue().low64, expected.getValue().low64);
+    ASSERT_EQUALS(result.getValue().high64, expected.getValue().high64);
+}
+
+TEST(Decimal128Test, TestDecimal128AdditionSameExponentCarriesIntoHighWord) {
+    Decimal128 d1(0, Decimal128::kExponentBias, 0, ~std::uint64_t{0});
+    Decimal128 result = d1.add(Decimal128(1));
+    Decimal128 expected(0, Decimal128::kExponentBias, 1, 0);
+    ASSERT_EQUALS(result.getValue().low64, expected.getValue().low64);
+    ASSERT_EQUALS(result.getValue().high64, expected.getValue().high64);
+}
+
+TEST(Decimal128Test, TestDecimal128AdditionSameExponentRoundsPast34Digits) {
+    Decimal128 d1("9999999999999999999999999999999999");
+    Decimal128 result = d1.add(Decimal128(1));
+    Decimal128 expected("1.000000000000000000000000000000000E+34");
+    ASSERT_EQUALS(result.getValue().low64, expected.getValue().low64);
+    ASSERT_EQUALS(result.getValue().high64, expected.getValue().high64);
+}
+
 TEST(Decimal128Test, TestDecimal128SubtractionCase1) {
     Decimal128 d1("25.05E20");
     Decimal128 d2("-50.5218E19");
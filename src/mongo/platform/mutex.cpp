@@ -29,6 +29,8 @@
 
 #include "mongo/platform/mutex.h"
 
+#include <chrono>
+
 #include "mongo/base/init.h"
 #include "mongo/bson/bsonobjbuilder.h"
 
@@ -71,8 +73,12 @@ void Mutex::lock() {
     }
 
     _onContendedLock();
+    const auto waitStart = std::chrono::steady_clock::now();
     _mutex.lock();
+    const auto waited = std::chrono::steady_clock::now() - waitStart;
     _isLocked = true;
+    _data->counts().contendedWaitMicros.fetchAndAddRelaxed(
+        std::chrono::duration_cast<std::chrono::microseconds>(waited).count());
     _onSlowLock();
 }
 
@@ -238,6 +238,10 @@ private:
         AtomicWord<int> contended{0};
         AtomicWord<int> acquired{0};
         AtomicWord<int> released{0};
+
+        // Total time spent blocked in lock() after a failed try_lock(). This is only measured on
+        // the contended path, so uncontended acquisitions never read the clock.
+        AtomicWord<long long> contendedWaitMicros{0};
     };
 
     Counts _counts;
@@ -370,10 +370,12 @@ ChunkMap ChunkMap::_makeUpdated(ChunkVector&& updateChunks) const {
 
             while (updateChunkWrittenBytesIt != updateChunks.end() &&
                    overlaps(*nextChunkPtr, **updateChunkWrittenBytesIt)) {
-                // Copy writtenBytes to all new overlapping chunks
-                (*updateChunkWrittenBytesIt++)
-                    ->getWritesTracker()
-                    ->addBytesWritten(nextChunkPtr->getWritesTracker()->getBytesWritten());
+                // Copy writtenBytes and writeOps to all new overlapping chunks
+                const auto& oldWritesTracker = nextChunkPtr->getWritesTracker();
+                const auto& newWritesTracker =
+                    (*updateChunkWrittenBytesIt++)->getWritesTracker();
+                newWritesTracker->addBytesWritten(oldWritesTracker->getBytesWritten());
+                newWritesTracker->addWriteOps(oldWritesTracker->getWriteOps());
             }
 
             newMap._updateShardVersionFromDiscardedChunk(*nextChunkPtr);
@@ -701,6 +703,10 @@ Chunk ChunkManager::findIntersectingChunk(const BSONObj& shardKey,
         }
     }
 
+    return findIntersectingChunkWithSimpleCollation(shardKey);
+}
+
+Chunk ChunkManager::findIntersectingChunkWithSimpleCollation(const BSONObj& shardKey) const {
     auto chunkInfo = _rt->optRt->findIntersectingChunk(shardKey);
 
     uassert(ErrorCodes::ShardKeyNotFound,
@@ -764,11 +764,11 @@ public:
                                 bool bypassIsFieldHashedCheck = false) const;
 
     /**
-     * Same as findIntersectingChunk, but assumes the simple collation.
+     * Same as findIntersectingChunk, but assumes the simple collation. Since no shard key value can
+     * be collatable under the simple collation, this skips the per-field collation checks and is
+     * the preferred entry point for hot paths such as insert targeting.
      */
-    Chunk findIntersectingChunkWithSimpleCollation(const BSONObj& shardKey) const {
-        return findIntersectingChunk(shardKey, CollationSpec::kSimpleSpec);
-    }
+    Chunk findIntersectingChunkWithSimpleCollation(const BSONObj& shardKey) const;
 
     /**
      * Finds the shard id of the shard that owns the chunk minKey belongs to, assuming the simple
@@ -390,6 +390,32 @@ void BM_FindIntersectingChunk(benchmark::State& state,
     state.SetItemsProcessed(state.iterations());
 }
 
+template <typename CollectionMetadataBuilderFn>
+void BM_TargetInsert(benchmark::State& state, CollectionMetadataBuilderFn makeCollectionMetadata) {
+    const int nShards = state.range(0);
+    const int nChunks = state.range(1);
+
+    auto metadata = makeCollectionMetadata(nShards, nChunks);
+    const auto& cm = *metadata.getChunkManager();
+
+    // Documents as they arrive from a client insert, with the shard key among other fields.
+    std::vector<BSONObj> docs;
+    for (const auto& key : makeKeys(nChunks)) {
+        docs.emplace_back(BSON("a" << 1 << "_id" << key["_id"] << "b"
+                                   << "some string value"));
+    }
+    auto docsIter = makeCircularIterator(docs);
+
+    for (auto keepRunning : state) {
+        auto shardKey = cm.getShardKeyPattern().extractShardKeyFromDoc(*docsIter);
+        auto chunk = cm.findIntersectingChunkWithSimpleCollation(shardKey);
+        benchmark::DoNotOptimize(cm.getVersion(chunk.getShardId()));
+        ++docsIter;
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
 template <typename CollectionMetadataBuilderFn>
 void BM_GetShardIdsForRange(benchmark::State& state,
                             CollectionMetadataBuilderFn makeCollectionMetadata) {
@@ -490,6 +516,10 @@ MONGO_INITIALIZER(RegisterBenchmarks)(InitializerContext* context) {
             BM_FindIntersectingChunk, Pessimal, makeChunkManagerWithPessimalBalancedDistribution),
         REGISTER_BENCHMARK_CAPTURE(
             BM_FindIntersectingChunk, Optimal, makeChunkManagerWithOptimalBalancedDistribution),
+        REGISTER_BENCHMARK_CAPTURE(
+            BM_TargetInsert, Pessimal, makeChunkManagerWithPessimalBalancedDistribution),
+        REGISTER_BENCHMARK_CAPTURE(
+            BM_TargetInsert, Optimal, makeChunkManagerWithOptimalBalancedDistribution),
         REGISTER_BENCHMARK_CAPTURE(
             BM_GetShardIdsForRange, Pessimal, makeChunkManagerWithPessimalBalancedDistribution),
         REGISTER_BENCHMARK_CAPTURE(
@@ -384,9 +384,11 @@ ShardEndpoint ChunkManagerTargeter::targetInsert(OperationContext* opCtx,
                 !shardKey.isEmpty());
     }
 
-    // Target the shard key or database primary
+    // Target the shard key or database primary. Inserts always target with the simple collation,
+    // so go straight to the chunk lookup rather than through the collation-aware _targetShardKey.
     if (!shardKey.isEmpty()) {
-        return uassertStatusOK(_targetShardKey(shardKey, CollationSpec::kSimpleSpec));
+        auto chunk = _cm.findIntersectingChunkWithSimpleCollation(shardKey);
+        return ShardEndpoint(chunk.getShardId(), _cm.getVersion(chunk.getShardId()), boost::none);
     }
 
     // TODO (SERVER-51070): Remove the boost::none when the config server can support shardVersion
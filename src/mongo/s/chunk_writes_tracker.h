@@ -62,6 +62,22 @@ public:
      */
     uint64_t clearBytesWritten();
 
+    /**
+     * Add more client write operations to the chunk. Unlike the bytes written, this counter is
+     * never cleared by a split attempt, so it reflects how hot the range has been since this node
+     * started tracking it.
+     */
+    void addWriteOps(uint64_t writeOps) {
+        _writeOps.fetchAndAdd(writeOps);
+    }
+
+    /**
+     * Returns the total number of client write operations that have been applied to the chunk.
+     */
+    uint64_t getWriteOps() {
+        return _writeOps.loadRelaxed();
+    }
+
     /**
      * Returns whether or not this chunk is ready to be split based on the
      * maximum allowable size of a chunk.
@@ -86,6 +102,12 @@ private:
      */
     AtomicWord<unsigned long long> _bytesWritten{0};
 
+    /**
+     * The number of client write operations that have been applied to this chunk. May be modified
+     * concurrently by several threads.
+     */
+    AtomicWord<unsigned long long> _writeOps{0};
+
     /**
      * Protects _splitState when starting a split.
      */
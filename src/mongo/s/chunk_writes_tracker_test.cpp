@@ -64,6 +64,23 @@ TEST(ChunkWritesTrackerTest, ClearBytesWrittenReturnsBytesWrittenBeforeClearing)
     ASSERT_EQ(previousBytesWritten, bytesToAdd);
 }
 
+TEST(ChunkWritesTrackerTest, AddWriteOpsCorrectlyAddsOps) {
+    ChunkWritesTracker wt;
+    ASSERT_EQ(wt.getWriteOps(), 0ull);
+    wt.addWriteOps(1);
+    wt.addWriteOps(2);
+    ASSERT_EQ(wt.getWriteOps(), 3ull);
+}
+
+TEST(ChunkWritesTrackerTest, ClearBytesWrittenDoesNotClearWriteOps) {
+    ChunkWritesTracker wt;
+    wt.addBytesWritten(4ull);
+    wt.addWriteOps(2);
+    wt.clearBytesWritten();
+    ASSERT_EQ(wt.getBytesWritten(), 0ull);
+    ASSERT_EQ(wt.getWriteOps(), 2ull);
+}
+
 TEST(ChunkWritesTrackerTest, ShouldSplitReturnsTrueWithBytesWrittenAndMaxChunkSizeZero) {
     ChunkWritesTracker wt;
     wt.addBytesWritten(4ull);
@@ -68,7 +68,8 @@ protected:
                            const BSONObj& cmdObj,
                            const BSONObj& rspObj,
                            const bool hedge,
-                           const int maxTimeMSForHedgedReads = kMaxTimeMSForHedgedReadsDefault) {
+                           const int maxTimeMSForHedgedReads = kMaxTimeMSForHedgedReadsDefault,
+                           const int delayMSForHedgedReads = kDelayMSForHedgedReadsDefault) {
         setParameters(serverParameters);
 
         auto readPref = uassertStatusOK(ReadPreferenceSetting::fromInnerBSON(rspObj));
@@ -77,6 +78,7 @@ protected:
         if (hedge) {
             ASSERT_TRUE(hedgeOptions.has_value());
             ASSERT_EQ(hedgeOptions->maxTimeMSForHedgedReads, maxTimeMSForHedgedReads);
+            ASSERT_EQ(hedgeOptions->delayMSForHedgedReads, delayMSForHedgedReads);
         } else {
             ASSERT_FALSE(hedgeOptions.has_value());
         }
@@ -89,10 +91,14 @@ protected:
     static inline const std::string kReadHedgingModeFieldName = "readHedgingMode";
     static inline const std::string kMaxTimeMSForHedgedReadsFieldName = "maxTimeMSForHedgedReads";
     static inline const int kMaxTimeMSForHedgedReadsDefault = 10;
+    static inline const std::string kDelayMSForHedgedReadsFieldName = "delayMSForHedgedReads";
+    static inline const int kDelayMSForHedgedReadsDefault = 0;
 
     static inline const BSONObj kDefaultParameters =
         BSON(kReadHedgingModeFieldName << "on" << kMaxTimeMSForHedgedReadsFieldName
-                                       << kMaxTimeMSForHedgedReadsDefault);
+                                       << kMaxTimeMSForHedgedReadsDefault
+                                       << kDelayMSForHedgedReadsFieldName
+                                       << kDelayMSForHedgedReadsDefault);
 
 private:
     ServiceContext::UniqueServiceContext _serviceCtx = ServiceContext::make();
@@ -187,5 +193,16 @@ TEST_F(HedgeOptionsUtilTestFixture, MaxTimeMSForHedgedReads) {
     checkHedgeOptions(parameters, cmdObj, rspObj, true, 100);
 }
 
+TEST_F(HedgeOptionsUtilTestFixture, DelayMSForHedgedReads) {
+    const auto parameters =
+        BSON(kReadHedgingModeFieldName << "on" << kDelayMSForHedgedReadsFieldName << 20);
+    const auto cmdObj = BSON("find" << kCollName);
+    const auto rspObj = BSON("mode"
+                             << "nearest"
+                             << "hedge" << BSONObj());
+
+    checkHedgeOptions(parameters, cmdObj, rspObj, true, kMaxTimeMSForHedgedReadsDefault, 20);
+}
+
 }  // namespace
 }  // namespace mongo
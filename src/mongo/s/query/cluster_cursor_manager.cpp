@@ -143,14 +143,13 @@ ClusterCursorManager::ClusterCursorManager(ClockSource* clockSource)
 }
 
 ClusterCursorManager::~ClusterCursorManager() {
-    invariant(_cursorEntryMap.empty());
+    for (auto&& partition : _partitions) {
+        invariant(partition->entries.empty());
+    }
 }
 
 void ClusterCursorManager::shutdown(OperationContext* opCtx) {
-    {
-        stdx::lock_guard<Latch> lk(_mutex);
-        _inShutdown = true;
-    }
+    _inShutdown.store(true);
     killAllCursors(opCtx);
 }
 
@@ -164,32 +163,48 @@ StatusWith<CursorId> ClusterCursorManager::registerCursor(
     // Read the clock out of the lock.
     const auto now = _clockSource->now();
 
-    stdx::unique_lock<Latch> lk(_mutex);
-
-    if (_inShutdown) {
-        lk.unlock();
+    auto shutdownStatus = [&] {
         cursor->kill(opCtx);
         return Status(ErrorCodes::ShutdownInProgress,
                       "Cannot register new cursors as we are in the process of shutting down");
+    };
+
+    if (_inShutdown.load()) {
+        return shutdownStatus();
     }
 
     invariant(cursor);
     cursor->setLeftoverMaxTimeMicros(opCtx->getRemainingMaxTimeMicros());
 
+    stdx::lock_guard<Latch> registrationLk(_registrationMutex);
     auto cursorId = generic_cursor::allocateCursorId(
-        [&](CursorId cursorId) -> bool { return _cursorEntryMap.count(cursorId) == 0; },
+        [&](CursorId cursorId) -> bool {
+            // Another thread cannot register a cursor with the same id once we drop the partition
+            // lock, because we still hold '_registrationMutex'.
+            auto& partition = _getPartition(cursorId);
+            stdx::lock_guard<Latch> lk(partition.mutex);
+            return partition.entries.count(cursorId) == 0;
+        },
         _pseudoRandom);
 
-    // Create a new CursorEntry and register it in the CursorEntryContainer's map.
-    auto emplaceResult = _cursorEntryMap.emplace(cursorId,
-                                                 CursorEntry(std::move(cursor),
-                                                             cursorType,
-                                                             cursorLifetime,
-                                                             now,
-                                                             authenticatedUsers,
-                                                             opCtx->getClient()->getUUID(),
-                                                             opCtx->getOperationKey(),
-                                                             nss));
+    auto& partition = _getPartition(cursorId);
+    stdx::unique_lock<Latch> lk(partition.mutex);
+
+    if (_inShutdown.load()) {
+        lk.unlock();
+        return shutdownStatus();
+    }
+
+    // Create a new CursorEntry and register it in its partition's map.
+    auto emplaceResult = partition.entries.emplace(cursorId,
+                                                   CursorEntry(std::move(cursor),
+                                                               cursorType,
+                                                               cursorLifetime,
+                                                               now,
+                                                               authenticatedUsers,
+                                                               opCtx->getClient()->getUUID(),
+                                                               opCtx->getOperationKey(),
+                                                               nss));
     invariant(emplaceResult.second);
 
     return cursorId;
@@ -201,9 +216,9 @@ StatusWith<ClusterCursorManager::PinnedCursor> ClusterCursorManager::checkOutCur
     AuthzCheckFn authChecker,
     AuthCheck checkSessionAuth) {
 
-    stdx::lock_guard<Latch> lk(_mutex);
+    stdx::lock_guard<Latch> lk(_getPartition(cursorId).mutex);
 
-    if (_inShutdown) {
+    if (_inShutdown.load()) {
         return Status(ErrorCodes::ShutdownInProgress,
                       "Cannot check out cursor as we are in the process of shutting down");
     }
@@ -263,7 +278,7 @@ void ClusterCursorManager::checkInCursor(std::unique_ptr<ClusterClientCursor> cu
     cursor->detachFromOperationContext();
     cursor->setLastUseDate(now);
 
-    stdx::unique_lock<Latch> lk(_mutex);
+    stdx::unique_lock<Latch> lk(_getPartition(cursorId).mutex);
 
     CursorEntry* entry = _getEntry(lk, cursorId);
     invariant(entry);
@@ -287,7 +302,7 @@ void ClusterCursorManager::checkInCursor(std::unique_ptr<ClusterClientCursor> cu
 Status ClusterCursorManager::checkAuthForKillCursors(OperationContext* opCtx,
                                                      CursorId cursorId,
                                                      AuthzCheckFn authChecker) {
-    stdx::lock_guard<Latch> lk(_mutex);
+    stdx::lock_guard<Latch> lk(_getPartition(cursorId).mutex);
     auto entry = _getEntry(lk, cursorId);
 
     if (!entry) {
@@ -313,7 +328,7 @@ void ClusterCursorManager::killOperationUsingCursor(WithLock, CursorEntry* entry
 Status ClusterCursorManager::killCursor(OperationContext* opCtx, CursorId cursorId) {
     invariant(opCtx);
 
-    stdx::unique_lock<Latch> lk(_mutex);
+    stdx::unique_lock<Latch> lk(_getPartition(cursorId).mutex);
 
     CursorEntry* entry = _getEntry(lk, cursorId);
     if (!entry) {
@@ -378,70 +393,79 @@ void ClusterCursorManager::killAllCursors(OperationContext* opCtx) {
 std::size_t ClusterCursorManager::killCursorsSatisfying(
     OperationContext* opCtx, const std::function<bool(CursorId, const CursorEntry&)>& pred) {
     invariant(opCtx);
-    stdx::unique_lock<Latch> lk(_mutex);
     std::size_t nKilled = 0;
 
-    std::vector<ClusterClientCursorGuard> cursorsToDestroy;
-    auto cursorIdEntryIt = _cursorEntryMap.begin();
-    while (cursorIdEntryIt != _cursorEntryMap.end()) {
-        auto cursorId = cursorIdEntryIt->first;
-        auto& entry = cursorIdEntryIt->second;
-
-        if (!pred(cursorId, entry)) {
-            ++cursorIdEntryIt;
-            continue;
-        }
+    // Sweep one partition at a time, so that checkouts and check-ins against the other partitions
+    // can proceed while the predicate is being evaluated.
+    for (auto&& partition : _partitions) {
+        stdx::unique_lock<Latch> lk(partition->mutex);
+
+        std::vector<ClusterClientCursorGuard> cursorsToDestroy;
+        auto& entries = partition->entries;
+        auto cursorIdEntryIt = entries.begin();
+        while (cursorIdEntryIt != entries.end()) {
+            auto cursorId = cursorIdEntryIt->first;
+            auto& entry = cursorIdEntryIt->second;
+
+            if (!pred(cursorId, entry)) {
+                ++cursorIdEntryIt;
+                continue;
+            }
 
-        ++nKilled;
+            ++nKilled;
 
-        if (entry.getOperationUsingCursor()) {
-            // Mark the OperationContext using the cursor as killed, and move on.
-            killOperationUsingCursor(lk, &entry);
-            ++cursorIdEntryIt;
-            continue;
-        }
+            if (entry.getOperationUsingCursor()) {
+                // Mark the OperationContext using the cursor as killed, and move on.
+                killOperationUsingCursor(lk, &entry);
+                ++cursorIdEntryIt;
+                continue;
+            }
 
-        cursorsToDestroy.push_back(entry.releaseCursor(opCtx));
+            cursorsToDestroy.push_back(entry.releaseCursor(opCtx));
 
-        // Destroy the entry and set the iterator to the next element.
-        _cursorEntryMap.erase(cursorIdEntryIt++);
-    }
+            // Destroy the entry and set the iterator to the next element.
+            entries.erase(cursorIdEntryIt++);
+        }
 
-    // Ensure cursors are killed outside the lock, as killing may require waiting for callbacks to
-    // finish.
-    lk.unlock();
+        // Ensure cursors are killed outside the lock, as killing may require waiting for
+        // callbacks to finish.
+        lk.unlock();
 
-    for (auto&& cursorGuard : cursorsToDestroy) {
-        invariant(cursorGuard);
-        cursorGuard->kill(opCtx);
+        for (auto&& cursorGuard : cursorsToDestroy) {
+            invariant(cursorGuard);
+            cursorGuard->kill(opCtx);
+        }
     }
 
     return nKilled;
 }
 
 ClusterCursorManager::Stats ClusterCursorManager::stats() const {
-    stdx::lock_guard<Latch> lk(_mutex);
-
     Stats stats;
 
-    for (auto&& [cursorId, entry] : _cursorEntryMap) {
-        if (entry.isKillPending()) {
-            // Killed cursors do not count towards the number of pinned cursors or the number of
-            // open cursors.
-            continue;
-        }
+    // Partitions are inspected one at a time, so the result is not a point-in-time snapshot.
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition->mutex);
 
-        if (entry.getOperationUsingCursor()) {
-            ++stats.cursorsPinned;
-        }
+        for (auto&& [cursorId, entry] : partition->entries) {
+            if (entry.isKillPending()) {
+                // Killed cursors do not count towards the number of pinned cursors or the number
+                // of open cursors.
+                continue;
+            }
 
-        switch (entry.getCursorType()) {
-            case CursorType::SingleTarget:
-                ++stats.cursorsSingleTarget;
-                break;
-            case CursorType::MultiTarget:
-                ++stats.cursorsMultiTarget;
-                break;
+            if (entry.getOperationUsingCursor()) {
+                ++stats.cursorsPinned;
+            }
+
+            switch (entry.getCursorType()) {
+                case CursorType::SingleTarget:
+                    ++stats.cursorsSingleTarget;
+                    break;
+                case CursorType::MultiTarget:
+                    ++stats.cursorsMultiTarget;
+                    break;
+            }
         }
     }
 
@@ -449,17 +473,19 @@ ClusterCursorManager::Stats ClusterCursorManager::stats() const {
 }
 
 void ClusterCursorManager::appendActiveSessions(LogicalSessionIdSet* lsids) const {
-    stdx::lock_guard<Latch> lk(_mutex);
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition->mutex);
 
-    for (auto&& [cursorId, entry] : _cursorEntryMap) {
-        if (entry.isKillPending()) {
-            // Don't include sessions for killed cursors.
-            continue;
-        }
+        for (auto&& [cursorId, entry] : partition->entries) {
+            if (entry.isKillPending()) {
+                // Don't include sessions for killed cursors.
+                continue;
+            }
 
-        auto lsid = entry.getLsid();
-        if (lsid) {
-            lsids->insert(*lsid);
+            auto lsid = entry.getLsid();
+            if (lsid) {
+                lsids->insert(*lsid);
+            }
         }
     }
 }
@@ -486,24 +512,26 @@ std::vector<GenericCursor> ClusterCursorManager::getIdleCursors(
     const OperationContext* opCtx, MongoProcessInterface::CurrentOpUserMode userMode) const {
     std::vector<GenericCursor> cursors;
 
-    stdx::lock_guard<Latch> lk(_mutex);
-
     AuthorizationSession* ctxAuth = AuthorizationSession::get(opCtx->getClient());
 
-    for (auto&& [cursorId, entry] : _cursorEntryMap) {
-        // If auth is enabled, and userMode is allUsers, check if the current user has
-        // permission to see this cursor.
-        if (ctxAuth->getAuthorizationManager().isAuthEnabled() &&
-            userMode == MongoProcessInterface::CurrentOpUserMode::kExcludeOthers &&
-            !ctxAuth->isCoauthorizedWith(entry.getAuthenticatedUsers())) {
-            continue;
-        }
-        if (entry.isKillPending() || entry.getOperationUsingCursor()) {
-            // Don't include sessions for killed or pinned cursors.
-            continue;
-        }
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition->mutex);
 
-        cursors.emplace_back(entry.cursorToGenericCursor(cursorId, entry.getNamespace()));
+        for (auto&& [cursorId, entry] : partition->entries) {
+            // If auth is enabled, and userMode is allUsers, check if the current user has
+            // permission to see this cursor.
+            if (ctxAuth->getAuthorizationManager().isAuthEnabled() &&
+                userMode == MongoProcessInterface::CurrentOpUserMode::kExcludeOthers &&
+                !ctxAuth->isCoauthorizedWith(entry.getAuthenticatedUsers())) {
+                continue;
+            }
+            if (entry.isKillPending() || entry.getOperationUsingCursor()) {
+                // Don't include sessions for killed or pinned cursors.
+                continue;
+            }
+
+            cursors.emplace_back(entry.cursorToGenericCursor(cursorId, entry.getNamespace()));
+        }
     }
 
 
@@ -525,19 +553,21 @@ std::pair<Status, int> ClusterCursorManager::killCursorsWithMatchingSessions(
 
 stdx::unordered_set<CursorId> ClusterCursorManager::getCursorsForSession(
     LogicalSessionId lsid) const {
-    stdx::lock_guard<Latch> lk(_mutex);
-
     stdx::unordered_set<CursorId> cursorIds;
 
-    for (auto&& [cursorId, entry] : _cursorEntryMap) {
-        if (entry.isKillPending()) {
-            // Don't include sessions for killed cursors.
-            continue;
-        }
+    for (auto&& partition : _partitions) {
+        stdx::lock_guard<Latch> lk(partition->mutex);
 
-        auto cursorLsid = entry.getLsid();
-        if (lsid == cursorLsid) {
-            cursorIds.insert(cursorId);
+        for (auto&& [cursorId, entry] : partition->entries) {
+            if (entry.isKillPending()) {
+                // Don't include sessions for killed cursors.
+                continue;
+            }
+
+            auto cursorLsid = entry.getLsid();
+            if (lsid == cursorLsid) {
+                cursorIds.insert(cursorId);
+            }
         }
     }
 
@@ -545,8 +575,9 @@ stdx::unordered_set<CursorId> ClusterCursorManager::getCursorsForSession(
 }
 
 auto ClusterCursorManager::_getEntry(WithLock, CursorId cursorId) -> CursorEntry* {
-    auto entryMapIt = _cursorEntryMap.find(cursorId);
-    if (entryMapIt == _cursorEntryMap.end()) {
+    auto& entries = _getPartition(cursorId).entries;
+    auto entryMapIt = entries.find(cursorId);
+    if (entryMapIt == entries.end()) {
         return nullptr;
     }
 
@@ -569,7 +600,7 @@ StatusWith<ClusterClientCursorGuard> ClusterCursorManager::_detachCursor(WithLoc
     ClusterClientCursorGuard cursor = entry->releaseCursor(opCtx);
 
     // Destroy the entry.
-    size_t eraseResult = _cursorEntryMap.erase(cursorId);
+    size_t eraseResult = _getPartition(cursorId).entries.erase(cursorId);
     invariant(1 == eraseResult);
 
     return std::move(cursor);
@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -38,12 +39,14 @@
 #include "mongo/db/kill_sessions.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/session_killer.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/platform/random.h"
 #include "mongo/s/query/cluster_client_cursor.h"
 #include "mongo/s/query/cluster_client_cursor_guard.h"
 #include "mongo/s/query/cluster_client_cursor_params.h"
 #include "mongo/stdx/unordered_map.h"
+#include "mongo/util/aligned.h"
 #include "mongo/util/concurrency/with_lock.h"
 #include "mongo/util/time_support.h"
 
@@ -527,6 +530,25 @@ public:
 private:
     using CursorEntryMap = stdx::unordered_map<CursorId, CursorEntry>;
 
+    // Number of independently locked partitions the registered cursors are spread across.
+    static constexpr size_t kNumPartitions = 16;
+
+    /**
+     * One stripe of the cursor map. Cursors are assigned to a partition by their id, so checking
+     * out, checking in or killing one cursor only takes the lock of the partition it lives in.
+     */
+    struct Partition {
+        Mutex mutex = MONGO_MAKE_LATCH("ClusterCursorManager::Partition::mutex");
+        CursorEntryMap entries;
+    };
+
+    /**
+     * Returns the partition which holds, or would hold, the given cursor.
+     */
+    Partition& _getPartition(CursorId cursorId) const {
+        return *_partitions[static_cast<uint64_t>(cursorId) % kNumPartitions];
+    }
+
     /**
      * Transfers ownership of the given pinned cursor back to the manager, and moves the cursor to
      * the 'idle' state.
@@ -543,7 +565,7 @@ private:
                        CursorState cursorState);
 
     /**
-     * Will detach a cursor, release the lock and then call kill() on it.
+     * Will detach a cursor, release the lock on its partition and then call kill() on it.
      */
     void detachAndKillCursor(stdx::unique_lock<Latch> lk,
                              OperationContext* opCtx,
@@ -553,7 +575,7 @@ private:
      * Returns a pointer to the CursorEntry for the given cursor.  If the given cursor is not
      * registered, returns null.
      *
-     * Not thread-safe.
+     * Not thread-safe. The caller must hold the lock of the cursor's partition.
      */
     CursorEntry* _getEntry(WithLock, CursorId cursorId);
 
@@ -569,7 +591,7 @@ private:
      * If the given cursor is pinned, returns an error Status with code CursorInUse.  If the given
      * cursor is not registered, returns an error Status with code CursorNotFound.
      *
-     * Not thread-safe.
+     * Not thread-safe. The caller must hold the lock of the cursor's partition.
      */
     StatusWith<ClusterClientCursorGuard> _detachCursor(WithLock,
                                                        OperationContext* opCtx,
@@ -584,17 +606,22 @@ private:
     // concurrently accessed by multiple threads.
     ClockSource* _clockSource;
 
-    // Synchronizes access to all private state variables below.
-    mutable Mutex _mutex = MONGO_MAKE_LATCH("ClusterCursorManager::_mutex");
+    // Set once shutdown begins. It is checked again under a partition lock before a cursor is
+    // inserted, so that the shutdown sweep cannot miss a cursor registered concurrently.
+    AtomicWord<bool> _inShutdown{false};
 
-    bool _inShutdown{false};
+    // Protects '_pseudoRandom', and must be held from cursor id generation until the new cursor
+    // has been inserted into its partition so that two cursors cannot be given the same id. If
+    // both are needed it is acquired before any partition mutex. Partition mutexes are never
+    // held more than one at a time.
+    Mutex _registrationMutex = MONGO_MAKE_LATCH("ClusterCursorManager::_registrationMutex");
 
     // Randomness source.  Used for cursor id generation.
     const int64_t _randomSeed;
     PseudoRandom _pseudoRandom;
 
-    // Map from CursorId to CursorEntry.
-    CursorEntryMap _cursorEntryMap;
+    // Map from CursorId to CursorEntry, partitioned by CursorId.
+    mutable std::array<CacheAligned<Partition>, kNumPartitions> _partitions;
 
     size_t _cursorsTimedOut = 0;
 };
@@ -37,6 +37,7 @@
 #include "mongo/s/client/shard_registry.h"
 #include "mongo/s/is_mongos.h"
 #include "mongo/s/sharding_task_executor_pool_controller.h"
+#include "mongo/util/static_immortal.h"
 
 namespace mongo {
 
@@ -56,6 +57,42 @@ void emplaceOrInvariant(Map&& map, Args&&... args) noexcept {
     invariant(ret.second, "Element already existed in map/set");
 }
 
+/**
+ * The number of pools, across every ShardingTaskExecutorPoolController in the process, that target
+ * each host. Used to split ShardingTaskExecutorPoolMaxSizePerHost between those pools.
+ */
+class PoolsPerHost {
+public:
+    static PoolsPerHost& get() {
+        static StaticImmortal<PoolsPerHost> poolsPerHost;
+        return *poolsPerHost;
+    }
+
+    void add(const HostAndPort& host) {
+        stdx::lock_guard lk(_mutex);
+        ++_counts[host];
+    }
+
+    void remove(const HostAndPort& host) {
+        stdx::lock_guard lk(_mutex);
+        auto it = _counts.find(host);
+        invariant(it != _counts.end());
+        if (--it->second == 0) {
+            _counts.erase(it);
+        }
+    }
+
+    size_t count(const HostAndPort& host) const {
+        stdx::lock_guard lk(_mutex);
+        auto it = _counts.find(host);
+        return it == _counts.end() ? 1 : it->second;
+    }
+
+private:
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("PoolsPerHost::_mutex");
+    stdx::unordered_map<HostAndPort, size_t> _counts;
+};
+
 bool isConfigServer(const ShardRegistry* sr, const HostAndPort& peer) {
     if (!sr)
         return false;
@@ -115,9 +152,11 @@ Status ShardingTaskExecutorPoolController::onUpdateMatchingStrategy(const std::s
 }
 
 void ShardingTaskExecutorPoolController::_addGroup(WithLock,
-                                                   const ReplicaSetChangeNotifier::State& state) {
+                                                   const ReplicaSetChangeNotifier::State& state,
+                                                   size_t target) {
     auto groupData = std::make_shared<GroupData>();
     groupData->primary = state.primary;
+    groupData->target = target;
 
     // Find each active member
     for (auto& host : state.connStr.getServers()) {
@@ -145,13 +184,14 @@ void ShardingTaskExecutorPoolController::_addGroup(WithLock,
     emplaceOrInvariant(_groupDatas, state.connStr.getSetName(), std::move(groupData));
 }
 
-void ShardingTaskExecutorPoolController::_removeGroup(WithLock, const std::string& name) {
+size_t ShardingTaskExecutorPoolController::_removeGroup(WithLock, const std::string& name) {
     auto it = _groupDatas.find(name);
     if (it == _groupDatas.end()) {
-        return;
+        return 0;
     }
 
     auto& groupData = it->second;
+    auto target = groupData->target;
     for (auto& host : groupData->members) {
         auto& groupAndId = getOrInvariant(_groupAndIds, host);
         groupAndId.groupData.reset();
@@ -164,6 +204,7 @@ void ShardingTaskExecutorPoolController::_removeGroup(WithLock, const std::strin
     }
 
     _groupDatas.erase(it);
+    return target;
 }
 
 class ShardingTaskExecutorPoolController::ReplicaSetChangeListener final
@@ -179,8 +220,10 @@ public:
     void onConfirmedSet(const State& state) noexcept override {
         stdx::lock_guard lk(_controller->_mutex);
 
-        _controller->_removeGroup(lk, state.connStr.getSetName());
-        _controller->_addGroup(lk, state);
+        // Carry the group's target across the reconfig so that, after a failover, pools to the new
+        // primary are grown to the previous demand right away instead of starting cold.
+        auto target = _controller->_removeGroup(lk, state.connStr.getSetName());
+        _controller->_addGroup(lk, state, target);
     }
 
     void onPossibleSet(const State& state) noexcept override {
@@ -223,6 +266,7 @@ void ShardingTaskExecutorPoolController::addHost(PoolId id, const HostAndPort& h
     }
 
     // Add this PoolData to the set
+    PoolsPerHost::get().add(host);
     emplaceOrInvariant(_poolDatas, id, std::move(poolData));
 }
 auto ShardingTaskExecutorPoolController::updateHost(PoolId id, const HostState& stats)
@@ -242,6 +286,13 @@ auto ShardingTaskExecutorPoolController::updateHost(PoolId id, const HostState&
             maybeOverride(lo, gParameters.minConnectionsForConfigServers.load());
             maybeOverride(hi, gParameters.maxConnectionsForConfigServers.load());
         }
+        if (auto perHost = gParameters.maxConnectionsPerHost.load(); perHost >= 0) {
+            // Each pool to this host gets an even share of the per-host limit, but never less
+            // than one connection so that requests can still make progress.
+            size_t share = perHost / PoolsPerHost::get().count(poolData.host);
+            hi = std::min(hi, std::max(share, size_t{1}));
+            lo = std::min(lo, hi);
+        }
         return std::tuple(lo, hi);
     }();
     // conn_pool_csrs.js looks for this message in the log.
@@ -310,6 +361,7 @@ void ShardingTaskExecutorPoolController::removeHost(PoolId id) {
     }
 
     auto& poolData = it->second;
+    PoolsPerHost::get().remove(poolData.host);
     auto& groupAndId = getOrInvariant(_groupAndIds, poolData.host);
     groupAndId.maybeId.reset();
     if (groupAndId.groupData) {
@@ -61,6 +61,9 @@ class ShardRegistry;
  * When the MatchingStrategy is kMatchBusiestNode, it operates like kMatchPrimaryNode, but any pool
  * can be responsible for increasing the targetConnections of each member of its set.
  *
+ * The maxConnectionsPerHost parameter, when not -1, bounds the connections to a host summed over
+ * every pool in the process that targets it, by splitting it evenly between those pools.
+ *
  * Note that, in essence, there are three outside elements that can mutate the state of this class:
  * * The ReplicaSetChangeNotifier can notify the listener which updates the host groups
  * * The ServerParameters can update the Parameters which will used in the next update
@@ -107,6 +110,8 @@ public:
 
         AtomicWord<int> minConnectionsForConfigServers;
         AtomicWord<int> maxConnectionsForConfigServers;
+
+        AtomicWord<int> maxConnectionsPerHost;
     };
 
     static inline Parameters gParameters;
@@ -151,8 +156,16 @@ public:
     void updateConnectionPoolStats(executor::ConnectionPoolStats* cps) const override;
 
 private:
-    void _addGroup(WithLock, const ReplicaSetChangeNotifier::State& state);
-    void _removeGroup(WithLock, const std::string& key);
+    /**
+     * Adds a GroupData for the replica set described by state, starting it at the given target.
+     */
+    void _addGroup(WithLock, const ReplicaSetChangeNotifier::State& state, size_t target = 0);
+
+    /**
+     * Removes the GroupData for the given replica set and returns its last target, or 0 if there
+     * was no such group.
+     */
+    size_t _removeGroup(WithLock, const std::string& key);
 
     /**
      * GroupData is a shared state for a set of hosts (a replica set).
@@ -43,6 +43,7 @@
 #include "mongo/db/service_context.h"
 #include "mongo/logv2/log.h"
 #include "mongo/scripting/dbdirectclient_factory.h"
+#include "mongo/scripting/engine_parameters_gen.h"
 #include "mongo/util/ctype.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/file.h"
@@ -378,7 +379,7 @@ public:
             return;
         }
 
-        if (Date_t::now() - scope->getCreateTime() > kMaxScopeReuseTime) {
+        if (Date_t::now() - scope->getCreateTime() > Seconds(gScriptingScopeMaxReuseSecs.load())) {
             return;  // too old to save
         }
 
@@ -386,7 +387,12 @@ public:
             return;  // not saving errored scopes
         }
 
-        if (_pools.size() >= kMaxPoolSize) {
+        const size_t maxPoolSize = gScriptingScopePoolSize.load();
+        if (maxPoolSize == 0) {
+            return;  // pooling disabled
+        }
+
+        while (_pools.size() >= maxPoolSize) {
             // prefer to keep recently-used scopes
             _pools.pop_back();
         }
@@ -424,10 +430,8 @@ private:
         string poolName;
     };
 
-    // Note: if these numbers change, reconsider choice of datastructure for _pools
-    static const unsigned kMaxPoolSize = 10;
-    constexpr static inline Seconds kMaxScopeReuseTime = Seconds(10);
-
+    // Note: the pool is searched linearly by name, so very large values of
+    // 'scriptingScopePoolSize' should prompt a reconsideration of the datastructure for _pools.
     typedef std::deque<ScopeAndPool> Pools;  // More-recently used Scopes are kept at the front.
     Pools _pools;                            // protected by _mutex
     Mutex _mutex = MONGO_MAKE_LATCH("ScopeCache::_mutex");
@@ -39,6 +39,7 @@
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/logv2/log.h"
 #include "mongo/rpc/message.h"
+#include "mongo/transport/message_compressor_manager_gen.h"
 #include "mongo/transport/message_compressor_registry.h"
 #include "mongo/transport/session.h"
 
@@ -95,6 +96,11 @@ StatusWith<Message> MessageCompressorManager::compressMessage(
         return {msg};
     }
 
+    // Small messages barely shrink and are cheaper to send as-is.
+    if (msg.dataSize() < gNetworkMessageCompressionMinBytes.load()) {
+        return {msg};
+    }
+
     LOGV2_DEBUG(22925,
                 3,
                 "Compressing message with {compressor}",
@@ -36,7 +36,9 @@
 #include <vector>
 
 #include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/rpc/message.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/transport/message_compressor_manager.h"
 #include "mongo/transport/message_compressor_noop.h"
 #include "mongo/transport/message_compressor_registry.h"
@@ -261,6 +263,35 @@ TEST(ZstdMessageCompressor, Fidelity) {
     checkFidelity(testMessage, std::make_unique<ZstdMessageCompressor>());
 }
 
+TEST(ZstdMessageCompressor, ConcurrentFidelity) {
+    // Use more threads than the compressor keeps idle contexts for, so that contexts are both
+    // reused and freed while other threads compress.
+    ZstdMessageCompressor compressor;
+    const int kNumThreads = 32;
+    const int kMessagesPerThread = 50;
+    std::vector<stdx::thread> threads;
+    for (int i = 0; i < kNumThreads; ++i) {
+        threads.emplace_back([&, i] {
+            const std::string input(4096 + i, static_cast<char>('a' + i % 26));
+            std::vector<char> compressed(compressor.getMaxCompressedSize(input.size()));
+            std::vector<char> decompressed(input.size());
+            for (int j = 0; j < kMessagesPerThread; ++j) {
+                auto compressedSize = assertOk(compressor.compressData(
+                    ConstDataRange(input.data(), input.size()),
+                    DataRange(compressed.data(), compressed.size())));
+                auto decompressedSize = assertOk(compressor.decompressData(
+                    ConstDataRange(compressed.data(), compressedSize),
+                    DataRange(decompressed.data(), decompressed.size())));
+                ASSERT_EQ(decompressedSize, input.size());
+                ASSERT_EQ(memcmp(decompressed.data(), input.data(), input.size()), 0);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
 TEST(SnappyMessageCompressor, Overflow) {
     checkOverflow(std::make_unique<SnappyMessageCompressor>());
 }
@@ -343,6 +374,30 @@ TEST(MessageCompressorManager, SERVER_28008) {
     ASSERT_EQ(compressorId, zstdId);
 }
 
+TEST(MessageCompressorManager, SmallMessagesAreNotCompressed) {
+    auto registry = buildRegistry();
+    MessageCompressorManager manager(&registry);
+
+    BSONObjBuilder serverOutput;
+    manager.serverNegotiate(std::vector<StringData>{"noop"_sd}, &serverOutput);
+    checkNegotiationResult(serverOutput.done(), {"noop"});
+
+    auto msg = buildMessage();
+    {
+        RAIIServerParameterControllerForTest minBytes("networkMessageCompressionMinBytes",
+                                                      msg.dataSize() + 1);
+        auto sent = assertOk(manager.compressMessage(msg, nullptr));
+        ASSERT_EQ(sent.operation(), dbQuery);
+        ASSERT_EQ(sent.size(), msg.size());
+    }
+    {
+        RAIIServerParameterControllerForTest minBytes("networkMessageCompressionMinBytes",
+                                                      msg.dataSize());
+        auto sent = assertOk(manager.compressMessage(msg, nullptr));
+        ASSERT_EQ(sent.operation(), dbCompressed);
+    }
+}
+
 TEST(MessageCompressorManager, MessageSizeTooLarge) {
     auto registry = buildRegistry();
     MessageCompressorManager compManager(&registry);
@@ -30,14 +30,97 @@
 #include "mongo/platform/basic.h"
 
 #include <memory>
+#include <vector>
 
 #include <zstd.h>
 
 #include "mongo/base/init.h"
+#include "mongo/platform/mutex.h"
 #include "mongo/transport/message_compressor_registry.h"
 #include "mongo/transport/message_compressor_zstd.h"
 
 namespace mongo {
+namespace {
+
+struct ZstdCCtxDeleter {
+    void operator()(ZSTD_CCtx* ctx) const {
+        ZSTD_freeCCtx(ctx);
+    }
+};
+
+struct ZstdDCtxDeleter {
+    void operator()(ZSTD_DCtx* ctx) const {
+        ZSTD_freeDCtx(ctx);
+    }
+};
+
+/**
+ * ZSTD_compress() and ZSTD_decompress() allocate and tear down a fresh context on every call,
+ * which for the default compression level is a few hundred kilobytes of workspace per message.
+ * The compressor instance is shared by every session, so contexts are instead borrowed from a
+ * pool and returned after each message. At most 'kMaxIdleContexts' idle contexts are kept, so the
+ * memory held doesn't grow with the number of connections or threads. Each message is still
+ * compressed as an independent frame, so the wire format is unchanged.
+ */
+template <typename Context, typename Deleter, Context* (*create)()>
+class ContextPool {
+public:
+    using ContextPtr = std::unique_ptr<Context, Deleter>;
+
+    /**
+     * Returns a context to the pool when it goes out of scope.
+     */
+    class Handle {
+    public:
+        Handle(ContextPool* pool, ContextPtr ctx) : _pool(pool), _ctx(std::move(ctx)) {}
+        Handle(Handle&&) = default;
+        Handle& operator=(Handle&&) = delete;
+
+        ~Handle() {
+            if (_ctx) {
+                _pool->_release(std::move(_ctx));
+            }
+        }
+
+        Context* get() const {
+            return _ctx.get();
+        }
+
+    private:
+        ContextPool* _pool;
+        ContextPtr _ctx;
+    };
+
+    Handle acquire() {
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            if (!_idle.empty()) {
+                auto ctx = std::move(_idle.back());
+                _idle.pop_back();
+                return {this, std::move(ctx)};
+            }
+        }
+        return {this, ContextPtr(create())};
+    }
+
+private:
+    static constexpr size_t kMaxIdleContexts = 16;
+
+    void _release(ContextPtr ctx) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        if (_idle.size() < kMaxIdleContexts) {
+            _idle.push_back(std::move(ctx));
+        }
+    }
+
+    Mutex _mutex = MONGO_MAKE_LATCH("ZstdMessageCompressor::ContextPool::_mutex");
+    std::vector<ContextPtr> _idle;
+};
+
+ContextPool<ZSTD_CCtx, ZstdCCtxDeleter, ZSTD_createCCtx> compressionContexts;
+ContextPool<ZSTD_DCtx, ZstdDCtxDeleter, ZSTD_createDCtx> decompressionContexts;
+
+}  // namespace
 
 ZstdMessageCompressor::ZstdMessageCompressor() : MessageCompressorBase(MessageCompressor::kZstd) {}
 
@@ -47,11 +130,17 @@ std::size_t ZstdMessageCompressor::getMaxCompressedSize(size_t inputSize) {
 
 StatusWith<std::size_t> ZstdMessageCompressor::compressData(ConstDataRange input,
                                                             DataRange output) {
-    size_t ret = ZSTD_compress(const_cast<char*>(output.data()),
-                               output.length(),
-                               input.data(),
-                               input.length(),
-                               ZSTD_CLEVEL_DEFAULT);
+    auto ctx = compressionContexts.acquire();
+    if (!ctx.get()) {
+        return Status{ErrorCodes::ExceededMemoryLimit, "Could not allocate a zstd context"};
+    }
+
+    size_t ret = ZSTD_compressCCtx(ctx.get(),
+                                   const_cast<char*>(output.data()),
+                                   output.length(),
+                                   input.data(),
+                                   input.length(),
+                                   ZSTD_CLEVEL_DEFAULT);
 
     if (ZSTD_isError(ret)) {
         return Status{ErrorCodes::BadValue,
@@ -63,8 +152,13 @@ StatusWith<std::size_t> ZstdMessageCompressor::compressData(ConstDataRange input
 
 StatusWith<std::size_t> ZstdMessageCompressor::decompressData(ConstDataRange input,
                                                               DataRange output) {
-    size_t ret = ZSTD_decompress(
-        const_cast<char*>(output.data()), output.length(), input.data(), input.length());
+    auto ctx = decompressionContexts.acquire();
+    if (!ctx.get()) {
+        return Status{ErrorCodes::ExceededMemoryLimit, "Could not allocate a zstd context"};
+    }
+
+    size_t ret = ZSTD_decompressDCtx(
+        ctx.get(), const_cast<char*>(output.data()), output.length(), input.data(), input.length());
 
     if (ZSTD_isError(ret)) {
         return Status{ErrorCodes::BadValue,
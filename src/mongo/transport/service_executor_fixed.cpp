@@ -144,6 +144,13 @@ public:
             _recursionDepth--;
             _executor->_stats->tasksEnded.fetchAndAdd(1);
 
+            // Avoid serializing every task on the executor-wide mutex while running. Both this
+            // load and the store in _beginShutdown() are sequentially consistent, so either we see
+            // the executor stopping here or _beginShutdown() sees our task as ended.
+            if (_executor->_isRunning.load()) {
+                return;
+            }
+
             auto lk = stdx::lock_guard(_executor->_mutex);
             _executor->_checkForShutdown();
         });
@@ -222,6 +229,7 @@ Status ServiceExecutorFixed::start() {
         switch (_state) {
             case State::kNotStarted:
                 _state = State::kRunning;
+                _isRunning.store(true);
                 break;
             case State::kRunning:
                 return Status::OK();
@@ -323,6 +331,7 @@ void ServiceExecutorFixed::_beginShutdown() {
             break;
         case State::kRunning:
             _state = State::kStopping;
+            _isRunning.store(false);
             // Cancel any session we own.
             for (auto& waiter : _waiters)
                 waiter.session->cancelAsyncOperations();
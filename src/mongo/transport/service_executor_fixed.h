@@ -117,6 +117,9 @@ private:
     /** `_state` transitions: kNotStarted -> kRunning -> kStopping -> kStopped */
     State _state = State::kNotStarted;
 
+    /** Mirrors `_state == State::kRunning` so that it can be read without holding `_mutex`. */
+    AtomicWord<bool> _isRunning{false};
+
     std::unique_ptr<Stats> _stats;
 
     ServiceContext* const _svcCtx;
@@ -297,6 +297,9 @@ Status TransportLayerASIO::ASIOSession::buildSSLSocket(const HostAndPort& target
 Future<void> TransportLayerASIO::ASIOSession::handshakeSSLForEgress(const HostAndPort& target,
                                                                     const ReactorHandle& reactor) {
     invariant(_sslSocket, "SSL Socket expected to be built");
+#if MONGO_CONFIG_SSL_PROVIDER == MONGO_CONFIG_SSL_PROVIDER_OPENSSL
+    _sslContext->egressSessions.prepareHandshake(_sslSocket->native_handle(), target.toString());
+#endif
     auto doHandshake = [&] {
         if (_blockingMode == Sync) {
             std::error_code ec;
@@ -410,16 +413,17 @@ ExecutorFuture<void> TransportLayerASIO::ASIOSession::parseProxyProtocolHeader(
 
 Future<Message> TransportLayerASIO::ASIOSession::sourceMessageImpl(const BatonHandle& baton) {
     static constexpr auto kHeaderSize = sizeof(MSGHEADER::Value);
+    static_assert(kHeaderSize == std::tuple_size_v<decltype(_headerBuffer)>);
 
-    auto headerBuffer = SharedBuffer::allocate(kHeaderSize);
-    auto ptr = headerBuffer.get();
-    return read(asio::buffer(ptr, kHeaderSize), baton)
-        .then([headerBuffer = std::move(headerBuffer), this, baton]() mutable {
-            if (checkForHTTPRequest(asio::buffer(headerBuffer.get(), kHeaderSize))) {
+    // Only one message is ever being sourced from a session at a time, so the header is read into
+    // a buffer owned by the session rather than one allocated for every message.
+    return read(asio::buffer(_headerBuffer.data(), kHeaderSize), baton)
+        .then([this, baton]() mutable {
+            if (checkForHTTPRequest(asio::buffer(_headerBuffer.data(), kHeaderSize))) {
                 return sendHTTPResponse(baton);
             }
 
-            const auto msgLen = size_t(MSGHEADER::View(headerBuffer.get()).getMessageLength());
+            const auto msgLen = size_t(MSGHEADER::View(_headerBuffer.data()).getMessageLength());
             if (msgLen < kHeaderSize || msgLen > MaxMessageSizeBytes) {
                 StringBuilder sb;
                 sb << "recv(): message msgLen " << msgLen << " is invalid. "
@@ -435,17 +439,17 @@ Future<Message> TransportLayerASIO::ASIOSession::sourceMessageImpl(const BatonHa
                 return Future<Message>::makeReady(Status(ErrorCodes::ProtocolError, str));
             }
 
+            auto buffer = SharedBuffer::allocate(msgLen);
+            memcpy(buffer.get(), _headerBuffer.data(), kHeaderSize);
+
             if (msgLen == kHeaderSize) {
                 // This probably isn't a real case since all (current) messages have bodies.
                 if (_isIngressSession) {
                     networkCounter.hitPhysicalIn(msgLen);
                 }
-                return Future<Message>::makeReady(Message(std::move(headerBuffer)));
+                return Future<Message>::makeReady(Message(std::move(buffer)));
             }
 
-            auto buffer = SharedBuffer::allocate(msgLen);
-            memcpy(buffer.get(), headerBuffer.get(), kHeaderSize);
-
             MsgData::View msgView(buffer.get());
             return read(asio::buffer(msgView.data(), msgView.dataLen()), baton)
                 .then([this, buffer = std::move(buffer), msgLen]() mutable {
@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <array>
 #include <utility>
 
 #include "mongo/base/system_error.h"
@@ -242,6 +243,9 @@ private:
     SockAddr _remoteAddr;
     SockAddr _localAddr;
 
+    // Holds the header of the message currently being sourced by sourceMessageImpl().
+    std::array<char, sizeof(MSGHEADER::Value)> _headerBuffer;
+
     boost::optional<Milliseconds> _configuredTimeout;
     boost::optional<Milliseconds> _socketTimeout;
 
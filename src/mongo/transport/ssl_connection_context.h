@@ -35,6 +35,10 @@
 #include "mongo/util/net/ssl_options.h"
 #include "mongo/util/net/ssl_types.h"
 
+#if MONGO_CONFIG_SSL_PROVIDER == MONGO_CONFIG_SSL_PROVIDER_OPENSSL
+#include "mongo/transport/ssl_egress_session_cache.h"
+#endif
+
 namespace asio {
 
 namespace ssl {
@@ -57,6 +61,13 @@ struct SSLConnectionContext {
     // cluster. It can also be used to determine if the context is indeed transient.
     boost::optional<std::string> targetClusterURI;
 
+#if MONGO_CONFIG_SSL_PROVIDER == MONGO_CONFIG_SSL_PROVIDER_OPENSSL
+    // Resumable sessions issued to 'egress' connections, keyed by the remote "host:port".
+    // Sessions are only valid for the egress context they were negotiated with, so the cache lives
+    // and dies with this context.
+    mutable EgressSSLSessionCache egressSessions;
+#endif
+
     ~SSLConnectionContext();
 };
 #endif
@@ -0,0 +1,135 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/transport/ssl_egress_session_cache.h"
+
+#include <openssl/ssl.h>
+
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+namespace transport {
+namespace {
+
+#if OPENSSL_VERSION_NUMBER >= 0x10101000L
+/**
+ * Attached to each prepared egress connection, so that the new session callback, which is
+ * registered on the shared context, knows which cache and peer a session belongs to.
+ */
+struct SessionTarget {
+    EgressSSLSessionCache* cache;
+    std::string peer;
+};
+
+void freeSessionTarget(void*, void* ptr, CRYPTO_EX_DATA*, int, long, void*) {
+    delete static_cast<SessionTarget*>(ptr);
+}
+
+int sessionTargetIndex() {
+    static const int index = [] {
+        int index = ::SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, &freeSessionTarget);
+        invariant(index >= 0);
+        return index;
+    }();
+    return index;
+}
+#endif
+
+}  // namespace
+
+void EgressSSLSessionCache::attachToContext(SSL_CTX* context) {
+#if OPENSSL_VERSION_NUMBER >= 0x10101000L
+    // The sessions are kept by this cache, so OpenSSL's internal store would only duplicate them.
+    ::SSL_CTX_set_session_cache_mode(context,
+                                     SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+    ::SSL_CTX_sess_set_new_cb(context, &EgressSSLSessionCache::_onNewSession);
+#endif
+}
+
+void EgressSSLSessionCache::prepareHandshake(SSL* ssl, const std::string& peer) {
+#if OPENSSL_VERSION_NUMBER >= 0x10101000L
+    std::shared_ptr<SSL_SESSION> cached;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        auto it = _sessions.find(peer);
+        if (it != _sessions.end()) {
+            cached = it->second;
+            // TLS 1.3 tickets are meant for single use. The connection they resume is issued a
+            // fresh one.
+            if (::SSL_SESSION_get_protocol_version(cached.get()) >= TLS1_3_VERSION) {
+                _sessions.erase(it);
+            }
+        }
+    }
+
+    // OpenSSL marks a connection's session as not resumable when the connection is freed without
+    // a clean shutdown, so connections are only ever handed copies of the cached sessions.
+    if (cached) {
+        if (auto copy = ::SSL_SESSION_dup(cached.get())) {
+            // A failure here only means we fall back to a full handshake.
+            ::SSL_set_session(ssl, copy);
+            ::SSL_SESSION_free(copy);
+        }
+    }
+
+    invariant(::SSL_get_ex_data(ssl, sessionTargetIndex()) == nullptr);
+    auto target = std::make_unique<SessionTarget>(SessionTarget{this, peer});
+    if (::SSL_set_ex_data(ssl, sessionTargetIndex(), target.get()) == 1) {
+        target.release();
+    }
+#endif
+}
+
+size_t EgressSSLSessionCache::size() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _sessions.size();
+}
+
+int EgressSSLSessionCache::_onNewSession(SSL* ssl, SSL_SESSION* session) {
+#if OPENSSL_VERSION_NUMBER >= 0x10101000L
+    auto target = static_cast<SessionTarget*>(::SSL_get_ex_data(ssl, sessionTargetIndex()));
+    if (!target || !::SSL_SESSION_is_resumable(session)) {
+        return 0;
+    }
+
+    // Keep a copy, for the same reason connections are only handed copies.
+    std::shared_ptr<SSL_SESSION> copy(::SSL_SESSION_dup(session), ::SSL_SESSION_free);
+    if (copy) {
+        stdx::lock_guard<Latch> lk(target->cache->_mutex);
+        target->cache->_sessions[target->peer] = std::move(copy);
+    }
+#endif
+    // OpenSSL keeps ownership of 'session'.
+    return 0;
+}
+
+}  // namespace transport
+}  // namespace mongo
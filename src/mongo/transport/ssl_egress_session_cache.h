@@ -0,0 +1,87 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+
+struct ssl_st;
+struct ssl_ctx_st;
+struct ssl_session_st;
+
+namespace mongo {
+namespace transport {
+
+/**
+ * Remembers the most recent resumable TLS session issued by each egress peer, so that the next
+ * connection to that peer can offer it and skip the full handshake.
+ *
+ * Sessions are captured through OpenSSL's new session callback rather than after the handshake,
+ * because TLS 1.3 servers send their session tickets once the handshake has completed. A TLS 1.3
+ * session is offered only once, since its ticket is meant for single use and the connection it
+ * resumes is issued a fresh one. Caching requires OpenSSL 1.1.1 or later. With older versions
+ * every connection runs a full handshake.
+ */
+class EgressSSLSessionCache {
+public:
+    EgressSSLSessionCache() = default;
+    EgressSSLSessionCache(const EgressSSLSessionCache&) = delete;
+    EgressSSLSessionCache& operator=(const EgressSSLSessionCache&) = delete;
+
+    /**
+     * Enables client side session caching on the egress context 'context', handing the sessions
+     * its connections receive to the cache each connection was prepared with.
+     */
+    static void attachToContext(ssl_ctx_st* context);
+
+    /**
+     * Prepares 'ssl', created from a context passed to attachToContext(), for a handshake with
+     * 'peer'. Offers the session cached for 'peer', if any, and caches sessions later issued on
+     * this connection under 'peer'.
+     */
+    void prepareHandshake(ssl_st* ssl, const std::string& peer);
+
+    /**
+     * Returns the number of peers with a cached session.
+     */
+    size_t size() const;
+
+private:
+    static int _onNewSession(ssl_st* ssl, ssl_session_st* session);
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("EgressSSLSessionCache::_mutex");
+    stdx::unordered_map<std::string, std::shared_ptr<ssl_session_st>> _sessions;
+};
+
+}  // namespace transport
+}  // namespace mongo
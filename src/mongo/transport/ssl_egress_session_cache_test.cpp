@@ -0,0 +1,162 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/transport/ssl_egress_session_cache.h"
+
+#include <openssl/ssl.h>
+
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace transport {
+namespace {
+
+#if OPENSSL_VERSION_NUMBER >= 0x10101000L
+using UniqueSSLContext = std::unique_ptr<SSL_CTX, decltype(&::SSL_CTX_free)>;
+using UniqueSSL = std::unique_ptr<SSL, decltype(&::SSL_free)>;
+
+constexpr auto kServerPEM = "jstests/libs/server.pem";
+const std::string kPeer = "server:27017";
+
+class EgressSSLSessionCacheTest : public unittest::Test {
+protected:
+    void setUp() override {
+        ASSERT_EQ(1, ::SSL_CTX_use_certificate_chain_file(_serverContext.get(), kServerPEM));
+        ASSERT_EQ(
+            1, ::SSL_CTX_use_PrivateKey_file(_serverContext.get(), kServerPEM, SSL_FILETYPE_PEM));
+        EgressSSLSessionCache::attachToContext(_clientContext.get());
+    }
+
+    void useProtocol(int version) {
+        for (auto context : {_serverContext.get(), _clientContext.get()}) {
+            ASSERT_EQ(1, ::SSL_CTX_set_min_proto_version(context, version));
+            ASSERT_EQ(1, ::SSL_CTX_set_max_proto_version(context, version));
+        }
+    }
+
+    /**
+     * Connects a client prepared by the cache to an in-memory server, reads one message from the
+     * server and returns whether the client resumed a session.
+     */
+    bool connect() {
+        auto client = makeClient();
+        UniqueSSL server(::SSL_new(_serverContext.get()), ::SSL_free);
+        BIO* clientBio;
+        BIO* serverBio;
+        ASSERT_EQ(1, ::BIO_new_bio_pair(&clientBio, 0, &serverBio, 0));
+        ::SSL_set_bio(client.get(), clientBio, clientBio);
+        ::SSL_set_bio(server.get(), serverBio, serverBio);
+        ::SSL_set_connect_state(client.get());
+        ::SSL_set_accept_state(server.get());
+
+        _cache.prepareHandshake(client.get(), kPeer);
+
+        bool clientDone = false;
+        bool serverDone = false;
+        for (int round = 0; round < 10 && !(clientDone && serverDone); ++round) {
+            clientDone = clientDone || handshakeStep(client.get());
+            serverDone = serverDone || handshakeStep(server.get());
+        }
+        ASSERT(clientDone && serverDone);
+
+        // TLS 1.3 servers send their session tickets after the handshake, so the client only sees
+        // them once it reads.
+        const char msg[] = "ping";
+        ASSERT_EQ(sizeof(msg), ::SSL_write(server.get(), msg, sizeof(msg)));
+        char buf[sizeof(msg)];
+        ASSERT_EQ(sizeof(msg), ::SSL_read(client.get(), buf, sizeof(buf)));
+
+        return ::SSL_session_reused(client.get()) == 1;
+    }
+
+    UniqueSSL makeClient() {
+        return UniqueSSL(::SSL_new(_clientContext.get()), ::SSL_free);
+    }
+
+    EgressSSLSessionCache _cache;
+
+private:
+    static bool handshakeStep(SSL* ssl) {
+        int rc = ::SSL_do_handshake(ssl);
+        if (rc == 1) {
+            return true;
+        }
+        int err = ::SSL_get_error(ssl, rc);
+        ASSERT(err == SSL_ERROR_WANT_READ || err == SSL_ERROR_WANT_WRITE) << err;
+        return false;
+    }
+
+    UniqueSSLContext _serverContext{::SSL_CTX_new(::TLS_server_method()), ::SSL_CTX_free};
+    UniqueSSLContext _clientContext{::SSL_CTX_new(::TLS_client_method()), ::SSL_CTX_free};
+};
+
+TEST_F(EgressSSLSessionCacheTest, ResumesTLS12Session) {
+    useProtocol(TLS1_2_VERSION);
+
+    ASSERT_FALSE(connect());
+    ASSERT_EQ(_cache.size(), 1);
+    ASSERT_TRUE(connect());
+
+    // A TLS 1.2 session stays cached after a connection resumes it.
+    ASSERT_EQ(_cache.size(), 1);
+    ASSERT_TRUE(connect());
+}
+
+TEST_F(EgressSSLSessionCacheTest, ResumesTLS13SessionFromTicketSentAfterHandshake) {
+    useProtocol(TLS1_3_VERSION);
+
+    ASSERT_FALSE(connect());
+    ASSERT_EQ(_cache.size(), 1);
+    ASSERT_TRUE(connect());
+
+    // The resumed connection was issued a fresh ticket for the next one.
+    ASSERT_EQ(_cache.size(), 1);
+    ASSERT_TRUE(connect());
+}
+
+TEST_F(EgressSSLSessionCacheTest, OffersTLS13SessionOnlyOnce) {
+    useProtocol(TLS1_3_VERSION);
+
+    ASSERT_FALSE(connect());
+    ASSERT_EQ(_cache.size(), 1);
+
+    // Preparing a connection takes the session, even if that connection never completes its
+    // handshake.
+    auto abandoned = makeClient();
+    _cache.prepareHandshake(abandoned.get(), kPeer);
+    ASSERT_EQ(_cache.size(), 0);
+    ASSERT_FALSE(connect());
+}
+#endif
+
+}  // namespace
+}  // namespace transport
+}  // namespace mongo
@@ -0,0 +1,273 @@
+/**
+ *    Copyright (C) 2023-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+#include <cstring>
+
+#ifdef __linux__
+#include <sys/resource.h>
+#endif
+
+#include "mongo/db/concurrency/locker_noop_client_observer.h"
+#include "mongo/db/dbmessage.h"
+#include "mongo/db/service_context.h"
+#include "mongo/rpc/op_msg.h"
+#include "mongo/transport/message_compressor_manager.h"
+#include "mongo/transport/message_compressor_registry.h"
+#include "mongo/transport/message_compressor_snappy.h"
+#include "mongo/transport/service_entry_point_impl.h"
+#include "mongo/transport/service_executor.h"
+#include "mongo/transport/transport_layer_asio.h"
+#include "mongo/util/net/sock.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace {
+
+const int kFindReplyDocuments = 100;
+
+/**
+ * Answers every request without running a command: "find" gets a canned batch of documents and
+ * everything else gets {ok: 1}. What remains is the cost of the transport layer, the
+ * ServiceStateMachine and the service executor.
+ */
+class NoopCommandServiceEntryPoint final : public ServiceEntryPointImpl {
+public:
+    explicit NoopCommandServiceEntryPoint(ServiceContext* svcCtx)
+        : ServiceEntryPointImpl(svcCtx), _findReply(_makeFindReply()) {}
+
+    Future<DbResponse> handleRequest(OperationContext* opCtx,
+                                     const Message& request) noexcept override {
+        auto opMsg = OpMsg::parse(request);
+        OpMsgBuilder builder;
+        builder.setBody(opMsg.body.firstElementFieldNameStringData() == "find"_sd ? _findReply
+                                                                                 : BSON("ok" << 1));
+        DbResponse response;
+        response.response = builder.finish();
+        return Future<DbResponse>::makeReady(std::move(response));
+    }
+
+private:
+    static BSONObj _makeFindReply() {
+        BSONArrayBuilder firstBatch;
+        for (int i = 0; i < kFindReplyDocuments; ++i) {
+            firstBatch.append(BSON("_id" << i << "name"
+                                         << "document " + std::to_string(i)));
+        }
+        return BSON("cursor" << BSON("id" << 0LL << "ns"
+                                          << "transport_bm.coll"
+                                          << "firstBatch" << firstBatch.arr())
+                             << "ok" << 1);
+    }
+
+    const BSONObj _findReply;
+};
+
+/**
+ * A process-wide ServiceContext with the no-op entry point and a TransportLayerASIO listening on
+ * an ephemeral loopback port. It is created on first use and never torn down.
+ */
+class TransportBenchmarkEnvironment {
+public:
+    static TransportBenchmarkEnvironment& get() {
+        static auto environment = new TransportBenchmarkEnvironment();
+        return *environment;
+    }
+
+    int port() const {
+        return _tla->listenerPort();
+    }
+
+    MessageCompressorId snappyId() const {
+        return MessageCompressorRegistry::get().getCompressor("snappy")->getId();
+    }
+
+private:
+    TransportBenchmarkEnvironment() {
+        // The benchmark binary never parses --networkMessageCompressors, so enable snappy here
+        // before any session exists.
+        auto& registry = MessageCompressorRegistry::get();
+        if (!registry.getCompressor("snappy")) {
+            auto names = registry.getCompressorNames();
+            names.push_back("snappy");
+            registry.setSupportedCompressors(std::move(names));
+            registry.registerImplementation(std::make_unique<SnappyMessageCompressor>());
+        }
+
+        setGlobalServiceContext(ServiceContext::make());
+        auto service = getGlobalServiceContext();
+        service->registerClientObserver(std::make_unique<LockerNoopClientObserver>());
+        service->setServiceEntryPoint(std::make_unique<NoopCommandServiceEntryPoint>(service));
+        invariant(service->getServiceEntryPoint()->start());
+
+        ServerGlobalParams params;
+        params.noUnixSocket = true;
+        transport::TransportLayerASIO::Options opts(&params);
+        opts.port = 0;
+        _tla = std::make_unique<transport::TransportLayerASIO>(opts,
+                                                               service->getServiceEntryPoint());
+        invariant(_tla->setup());
+        invariant(_tla->start());
+    }
+
+    std::unique_ptr<transport::TransportLayerASIO> _tla;
+};
+
+/**
+ * A blocking loopback client. Requests are optionally compressed with snappy; replies are
+ * decompressed whenever the server compressed them.
+ */
+class LoopbackClient {
+public:
+    LoopbackClient(int port, boost::optional<MessageCompressorId> compressorId)
+        : _compressorId(compressorId) {
+        invariant(_socket.connect(SockAddr::create("localhost", port, AF_INET)));
+    }
+
+    void send(const Message& request) {
+        auto toSend = request;
+        if (_compressorId) {
+            toSend = uassertStatusOK(_compressorManager.compressMessage(request, &*_compressorId));
+        }
+        _socket.send(toSend.buf(), toSend.size(), "transport_bm");
+    }
+
+    Message receive() {
+        int32_t length;
+        _socket.recv(reinterpret_cast<char*>(&length), sizeof(length));
+        auto buf = SharedBuffer::allocate(length);
+        std::memcpy(buf.get(), &length, sizeof(length));
+        _socket.recv(buf.get() + sizeof(length), length - sizeof(length));
+        Message reply(std::move(buf));
+        if (reply.operation() == dbCompressed) {
+            reply = uassertStatusOK(_compressorManager.decompressMessage(reply));
+        }
+        return reply;
+    }
+
+private:
+    boost::optional<MessageCompressorId> _compressorId;
+    MessageCompressorManager _compressorManager{&MessageCompressorRegistry::get()};
+    Socket _socket;
+};
+
+Message makeRequest(const BSONObj& body) {
+    OpMsgBuilder builder;
+    builder.setBody(body);
+    auto msg = builder.finish();
+    msg.header().setId(nextMessageId());
+    msg.header().setResponseToMsgId(0);
+    return msg;
+}
+
+long long contextSwitches() {
+#ifdef __linux__
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_nvcsw + usage.ru_nivcsw;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * Each iteration sends 'request' on state.range(0) connections and then waits for every reply, so
+ * that that many requests are in flight at once. state.range(1) selects the threading model
+ * (dedicated threads use the synchronous executor, borrowed threads the fixed one) and
+ * state.range(2) whether messages are compressed with snappy. The reported rate is messages per
+ * second, with the process's context switches per message as a proxy for syscall and wakeup cost.
+ */
+void benchmarkRoundTrips(benchmark::State& state, const BSONObj& requestBody) {
+    auto& environment = TransportBenchmarkEnvironment::get();
+    const auto numClients = state.range(0);
+    const auto threadingModel = state.range(1) ? ServiceExecutor::ThreadingModel::kBorrowed
+                                               : ServiceExecutor::ThreadingModel::kDedicated;
+    boost::optional<MessageCompressorId> compressorId;
+    if (state.range(2)) {
+        compressorId = environment.snappyId();
+    }
+
+    const auto originalThreadingModel = ServiceExecutor::getInitialThreadingModel();
+    ServiceExecutor::setInitialThreadingModel(threadingModel);
+    ON_BLOCK_EXIT([&] { ServiceExecutor::setInitialThreadingModel(originalThreadingModel); });
+
+    std::vector<std::unique_ptr<LoopbackClient>> clients;
+    for (int64_t i = 0; i < numClients; ++i) {
+        clients.push_back(std::make_unique<LoopbackClient>(environment.port(), compressorId));
+    }
+    const auto request = makeRequest(requestBody);
+
+    const auto contextSwitchesBefore = contextSwitches();
+    for (auto keepRunning : state) {
+        for (auto&& client : clients) {
+            client->send(request);
+        }
+        for (auto&& client : clients) {
+            benchmark::DoNotOptimize(client->receive());
+        }
+    }
+    const auto numMessages = state.iterations() * numClients;
+    state.SetItemsProcessed(numMessages);
+    state.counters["contextSwitchesPerMessage"] =
+        static_cast<double>(contextSwitches() - contextSwitchesBefore) / numMessages;
+}
+
+void BM_Ping(benchmark::State& state) {
+    benchmarkRoundTrips(state,
+                        BSON("ping" << 1 << "$db"
+                                    << "admin"));
+}
+
+void BM_SmallFind(benchmark::State& state) {
+    benchmarkRoundTrips(state,
+                        BSON("find"
+                             << "coll"
+                             << "filter" << BSON("_id" << BSON("$lt" << kFindReplyDocuments))
+                             << "$db"
+                             << "transport_bm"));
+}
+
+void clientsExecutorCompressionArgs(benchmark::internal::Benchmark* b) {
+    for (int64_t executor : {0, 1}) {
+        for (int64_t compression : {0, 1}) {
+            for (int64_t numClients : {1, 8, 64}) {
+                b->Args({numClients, executor, compression});
+            }
+        }
+    }
+    b->ArgNames({"clients", "fixedExecutor", "snappy"});
+}
+
+BENCHMARK(BM_Ping)->Apply(clientsExecutorCompressionArgs)->UseRealTime();
+BENCHMARK(BM_SmallFind)->Apply(clientsExecutorCompressionArgs)->UseRealTime();
+
+}  // namespace
+}  // namespace mongo
@@ -146,8 +146,9 @@ private:
     template <typename ArmTimerCb>
     Future<void> _asyncWait(ArmTimerCb&& armTimer) {
         try {
-            cancel();
-
+            // Setting the expiry cancels any outstanding wait on the timer, so there is no need to
+            // cancel explicitly first. This saves a trip through the reactor's timer queue on every
+            // rearm, which happens for each remote command and pooled connection checkin.
             armTimer();
             return _timer->async_wait(UseFuture{}).tapError([timer = _timer](const Status& status) {
                 if (status != ErrorCodes::CallbackCanceled) {
@@ -1491,6 +1492,9 @@ TransportLayerASIO::_createSSLContext(std::shared_ptr<SSLManagerInterface>& mana
         if (!status.isOK()) {
             return status;
         }
+#if MONGO_CONFIG_SSL_PROVIDER == MONGO_CONFIG_SSL_PROVIDER_OPENSSL
+        EgressSSLSessionCache::attachToContext(newSSLContext->egress->native_handle());
+#endif
         if (newSSLContext->manager->isTransient()) {
             newSSLContext->targetClusterURI =
                 newSSLContext->manager->getTargetedClusterConnectionString();
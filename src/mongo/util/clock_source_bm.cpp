@@ -35,6 +35,8 @@
 #include "mongo/util/fast_clock_source_factory.h"
 #include "mongo/util/processinfo.h"
 #include "mongo/util/system_clock_source.h"
+#include "mongo/util/system_tick_source.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 namespace {
@@ -76,5 +78,31 @@ BENCHMARK(BM_ClockNow)
     ->Arg(1)
     ->Arg(10);
 
+/**
+ * Benchmark reading the system tick source, which backs Timer and the per-operation timing in
+ * CurOp.
+ */
+void BM_SystemTickSourceGetTicks(benchmark::State& state) {
+    auto tickSource = SystemTickSource::get();
+    for (auto keepRunning : state) {
+        benchmark::DoNotOptimize(tickSource->getTicks());
+    }
+}
+
+BENCHMARK(BM_SystemTickSourceGetTicks)->ThreadRange(1, ProcessInfo::getNumAvailableCores());
+
+/**
+ * Benchmark the cost of timing one short section of work with a Timer: one tick read to start it
+ * and one to read the elapsed time.
+ */
+void BM_TimerStartAndRead(benchmark::State& state) {
+    for (auto keepRunning : state) {
+        Timer timer;
+        benchmark::DoNotOptimize(timer.micros());
+    }
+}
+
+BENCHMARK(BM_TimerStartAndRead)->ThreadRange(1, ProcessInfo::getNumAvailableCores());
+
 }  // namespace
 }  // namespace mongo
@@ -47,6 +47,14 @@ namespace mongo {
 
 MONGO_FAIL_POINT_DEFINE(hangTicketRelease);
 
+namespace {
+
+// The longest a queued FifoTicketHolder waiter can be overtaken by later arrivals with an earlier
+// deadline.
+constexpr Milliseconds kMaxQueueOvertake{100};
+
+}  // namespace
+
 TicketHolder::~TicketHolder() = default;
 
 #if defined(__linux__)
@@ -356,7 +364,7 @@ void FifoTicketHolder::release(AdmissionContext* admCtx, Ticket&& ticket) {
     // a waiting operation to avoid leaving an operation waiting indefinitely.
     while (true) {
         if (!_queue.empty()) {
-            auto elem = _queue.front();
+            auto elem = _queue.top().element;
             _enqueuedElements.subtractAndFetch(1);
             {
                 stdx::lock_guard elemLk(elem->modificationMutex);
@@ -443,6 +451,11 @@ boost::optional<Ticket> FifoTicketHolder::waitForTicketUntil(OperationContext* o
     // Enqueue.
     auto waitingElement = std::make_shared<WaitingElement>();
     waitingElement->state = WaitingState::Waiting;
+    auto clockSource = _serviceContext->getPreciseClockSource();
+    auto admitBy = std::min(until, clockSource->now() + kMaxQueueOvertake);
+    if (opCtx) {
+        admitBy = std::min(admitBy, opCtx->getDeadline());
+    }
     {
         stdx::lock_guard lk(_queueMutex);
         _enqueuedElements.addAndFetch(1);
@@ -457,7 +470,7 @@ boost::optional<Ticket> FifoTicketHolder::waitForTicketUntil(OperationContext* o
         _ticketsAvailable.addAndFetch(1);
         // We copy-construct the shared_ptr here as the waiting element needs to be alive in both
         // release() and waitForTicket(). Otherwise the code could lead to a segmentation fault
-        _queue.emplace(waitingElement);
+        _queue.push({admitBy, _nextArrival++, waitingElement});
     }
 
     ScopeGuard cancelWait([&] {
@@ -484,7 +497,7 @@ boost::optional<Ticket> FifoTicketHolder::waitForTicketUntil(OperationContext* o
     auto assigned = [&]() {
         stdx::unique_lock lk(waitingElement->modificationMutex);
         while (true) {
-            Date_t deadline = std::min(Date_t::now() + Milliseconds(500), until);
+            Date_t deadline = std::min(clockSource->now() + Milliseconds(500), until);
             bool taken = interruptible->waitForConditionOrInterruptUntil(
                 waitingElement->signaler, lk, deadline, [&]() {
                     return waitingElement->state == WaitingState::Assigned;
@@ -33,6 +33,8 @@
 #endif
 
 #include <queue>
+#include <tuple>
+#include <vector>
 
 #include "mongo/db/operation_context.h"
 #include "mongo/db/service_context.h"
@@ -141,7 +143,9 @@ private:
 };
 
 /**
- * A ticketholder implementation that uses a queue for pending operations.
+ * A ticketholder implementation that uses a queue for pending operations. Pending operations are
+ * admitted in arrival order, except that an operation with an earlier deadline may briefly jump
+ * ahead of ones that arrived before it.
  * Any change to the implementation should be paired with a change to the _ticketholder.tla_ file in
  * order to formally verify that the changes won't lead to a deadlock.
  */
@@ -197,7 +201,21 @@ private:
             HierarchicalAcquisitionLevel(0), "FifoTicketHolder::WaitingElement::modificationMutex");
         WaitingState state;
     };
-    std::queue<std::shared_ptr<WaitingElement>> _queue;
+    // Waiters are admitted in order of 'admitBy': the earlier of their own deadline and a bounded
+    // delay past their arrival. Operations with a short deadline can therefore overtake queued
+    // operations without one, but never by more than that delay, and ties are broken by arrival.
+    struct QueuedElement {
+        Date_t admitBy;
+        std::uint64_t arrival;
+        std::shared_ptr<WaitingElement> element;
+    };
+    struct AdmitsLater {
+        bool operator()(const QueuedElement& a, const QueuedElement& b) const {
+            return std::tie(a.admitBy, a.arrival) > std::tie(b.admitBy, b.arrival);
+        }
+    };
+    std::priority_queue<QueuedElement, std::vector<QueuedElement>, AdmitsLater> _queue;
+    std::uint64_t _nextArrival = 0;
     // _queueMutex protects all modifications made to either the _queue, or the statistics of the
     // queue.
     Mutex _queueMutex =
@@ -9,6 +9,10 @@ EXTENDS Integers, Sequences, TLC, FiniteSets
 
 variables
           Proc = {1, 2, 3},
+          \* Abstract admit-by times a waiter can enqueue with. FifoTicketHolder orders its queue by
+          \* the earlier of the waiter's deadline and a bound after its arrival, so only the
+          \* relative order of these values matters.
+          Urgencies = {0, 1},
           \* The waiting queue is abstracted as a set of pids waiting to be dequeued.
           \* This way we are independent of any queueing implementation and policy.
           Waiters = {},
@@ -17,7 +21,8 @@ variables
           ActiveProc = Proc,
           queueBeingModified = FALSE,
           ModifyingState = <<FALSE, FALSE, FALSE>>,
-          IsWaiting = <<FALSE, FALSE, FALSE>>;
+          IsWaiting = <<FALSE, FALSE, FALSE>>,
+          AdmitBy = <<0, 0, 0>>;
 
 \* You can pack functionality into macros and it will substitute invocations
 \* with the steps inside wherever they are invoked
@@ -29,6 +34,15 @@ macro dequeueIntoVariable(queue, var) {
     }
 };
 
+\* Dequeues one of the elements with the earliest admit-by time. Arrival order breaks ties in the
+\* implementation; it is left non-deterministic here, which covers every tie-breaking order.
+macro dequeueMostUrgent(queue, var) {
+    with (elem \in {w \in queue : \A other \in queue : AdmitBy[w] <= AdmitBy[other]}) {
+        queue := queue \ {elem} ;
+        var := elem;
+    }
+};
+
 \* The current implementation relies on having a mutex surrounding a queue so that
 \* only one process can modify the queue. This is a verifiably correct way of not having deadlocks.
 
@@ -77,6 +91,9 @@ variables localTicketsAvailableAcquire = -1,
     actualEnqueue:
         Waiters := Waiters \union {pid};
         IsWaiting[pid] := TRUE;
+        with (urgency \in Urgencies) {
+            AdmitBy[pid] := urgency;
+        };
         queueBeingModified := FALSE;
     resolve:
         await IsWaiting[pid] = FALSE /\ ModifyingState[pid] = FALSE;
@@ -95,7 +112,7 @@ variables localTicketsAvailable = -1,
         while (TRUE) {
     dequeue:
             if (Waiters # {}) {
-                dequeueIntoVariable(Waiters, dequeuedElem) ;
+                dequeueMostUrgent(Waiters, dequeuedElem) ;
     dequeued:
                 ticketsEnqueued := ticketsEnqueued - 1;
     modifyStateLock:
@@ -136,16 +153,18 @@ variable localPid = -1 ;
 }
 
 ***************)
-\* BEGIN TRANSLATION (chksum(pcal) = "2bdace43" /\ chksum(tla) = "c60322e0")
-\* Label release of procedure Release at line 95 col 9 changed to release_
+\* BEGIN TRANSLATION
+\* Label release of procedure Release at line 112 col 9 changed to release_
 CONSTANT defaultInitValue
-VARIABLES Proc, Waiters, ticketsAvailable, ticketsEnqueued, ActiveProc,
-          queueBeingModified, ModifyingState, IsWaiting, pc, stack, pid,
+VARIABLES Proc, Urgencies, Waiters, ticketsAvailable, ticketsEnqueued,
+          ActiveProc, queueBeingModified, ModifyingState, IsWaiting, AdmitBy,
+          pc, stack, pid,
           localTicketsAvailableAcquire, localTicketsEnqueuedAcquire,
           localTicketsAvailable, localTicketsEnqueued, dequeuedElem, localPid
 
-vars == << Proc, Waiters, ticketsAvailable, ticketsEnqueued, ActiveProc,
-           queueBeingModified, ModifyingState, IsWaiting, pc, stack, pid,
+vars == << Proc, Urgencies, Waiters, ticketsAvailable, ticketsEnqueued,
+           ActiveProc, queueBeingModified, ModifyingState, IsWaiting, AdmitBy,
+           pc, stack, pid,
            localTicketsAvailableAcquire, localTicketsEnqueuedAcquire,
            localTicketsAvailable, localTicketsEnqueued, dequeuedElem,
            localPid >>
@@ -154,6 +173,7 @@ ProcSet == (Proc)
 
 Init == (* Global variables *)
         /\ Proc = {1, 2, 3}
+        /\ Urgencies = {0, 1}
         /\ Waiters = {}
         /\ ticketsAvailable = 2
         /\ ticketsEnqueued = 0
@@ -161,6 +181,7 @@ Init == (* Global variables *)
         /\ queueBeingModified = FALSE
         /\ ModifyingState = <<FALSE, FALSE, FALSE>>
         /\ IsWaiting = <<FALSE, FALSE, FALSE>>
+        /\ AdmitBy = <<0, 0, 0>>
         (* Procedure Acquire *)
         /\ pid = [ self \in ProcSet |-> defaultInitValue]
         /\ localTicketsAvailableAcquire = [ self \in ProcSet |-> -1]
@@ -177,44 +198,44 @@ Init == (* Global variables *)
 lockAttemptCopy(self) == /\ pc[self] = "lockAttemptCopy"
                          /\ localTicketsEnqueuedAcquire' = [localTicketsEnqueuedAcquire EXCEPT ![self] = ticketsEnqueued]
                          /\ pc' = [pc EXCEPT ![self] = "attempt"]
-                         /\ UNCHANGED << Proc, Waiters, ticketsAvailable,
+                         /\ UNCHANGED << Proc, Urgencies, Waiters, ticketsAvailable,
                                          ticketsEnqueued, ActiveProc,
                                          queueBeingModified, ModifyingState,
                                          IsWaiting, stack, pid,
                                          localTicketsAvailableAcquire,
                                          localTicketsAvailable,
                                          localTicketsEnqueued, dequeuedElem,
-                                         localPid >>
+                                         localPid, AdmitBy >>
 
 attempt(self) == /\ pc[self] = "attempt"
                  /\ IF localTicketsEnqueuedAcquire[self] > 0
                        THEN /\ pc' = [pc EXCEPT ![self] = "enqueue"]
                        ELSE /\ pc' = [pc EXCEPT ![self] = "copyTickets"]
-                 /\ UNCHANGED << Proc, Waiters, ticketsAvailable,
+                 /\ UNCHANGED << Proc, Urgencies, Waiters, ticketsAvailable,
                                  ticketsEnqueued, ActiveProc,
                                  queueBeingModified, ModifyingState, IsWaiting,
                                  stack, pid, localTicketsAvailableAcquire,
                                  localTicketsEnqueuedAcquire,
                                  localTicketsAvailable, localTicketsEnqueued,
-                                 dequeuedElem, localPid >>
+                                 dequeuedElem, localPid, AdmitBy >>
 
 copyTickets(self) == /\ pc[self] = "copyTickets"
                      /\ ticketsAvailable' = ticketsAvailable - 1
                      /\ localTicketsAvailableAcquire' = [localTicketsAvailableAcquire EXCEPT ![self] = ticketsAvailable']
                      /\ pc' = [pc EXCEPT ![self] = "attemptOptimistic"]
-                     /\ UNCHANGED << Proc, Waiters, ticketsEnqueued,
+                     /\ UNCHANGED << Proc, Urgencies, Waiters, ticketsEnqueued,
                                      ActiveProc, queueBeingModified,
                                      ModifyingState, IsWaiting, stack, pid,
                                      localTicketsEnqueuedAcquire,
                                      localTicketsAvailable,
                                      localTicketsEnqueued, dequeuedElem,
-                                     localPid >>
+                                     localPid, AdmitBy >>
 
 attemptOptimistic(self) == /\ pc[self] = "attemptOptimistic"
                            /\ IF localTicketsAvailableAcquire[self] < 0
                                  THEN /\ pc' = [pc EXCEPT ![self] = "failedOptimistic"]
                                  ELSE /\ pc' = [pc EXCEPT ![self] = "successOptimistic"]
-                           /\ UNCHANGED << Proc, Waiters, ticketsAvailable,
+                           /\ UNCHANGED << Proc, Urgencies, Waiters, ticketsAvailable,
                                            ticketsEnqueued, ActiveProc,
                                            queueBeingModified, ModifyingState,
                                            IsWaiting, stack, pid,
@@ -222,19 +243,19 @@ attemptOptimistic(self) == /\ pc[self] = "attemptOptimistic"
                                            localTicketsEnqueuedAcquire,
                                            localTicketsAvailable,
                                            localTicketsEnqueued, dequeuedElem,
-                                           localPid >>
+                                           localPid, AdmitBy >>
 
 failedOptimistic(self) == /\ pc[self] = "failedOptimistic"
                           /\ ticketsAvailable' = ticketsAvailable + 1
                           /\ pc' = [pc EXCEPT ![self] = "enqueue"]
-                          /\ UNCHANGED << Proc, Waiters, ticketsEnqueued,
+                          /\ UNCHANGED << Proc, Urgencies, Waiters, ticketsEnqueued,
                                           ActiveProc, queueBeingModified,
                                           ModifyingState, IsWaiting, stack,
                                           pid, localTicketsAvailableAcquire,
                                           localTicketsEnqueuedAcquire,
                                           localTicketsAvailable,
                                           localTicketsEnqueued, dequeuedElem,
-                                          localPid >>
+                                          localPid, AdmitBy >>
 
 successOptimistic(self) == /\ pc[self] = "successOptimistic"
                            /\ pc' = [pc EXCEPT ![self] = Head(stack[self]).pc]
@@ -242,42 +263,42 @@ successOptimistic(self) == /\ pc[self] = "successOptimistic"
                            /\ localTicketsEnqueuedAcquire' = [localTicketsEnqueuedAcquire EXCEPT ![self] = Head(stack[self]).localTicketsEnqueuedAcquire]
                            /\ pid' = [pid EXCEPT ![self] = Head(stack[self]).pid]
                            /\ stack' = [stack EXCEPT ![self] = Tail(stack[self])]
-                           /\ UNCHANGED << Proc, Waiters, ticketsAvailable,
+                           /\ UNCHANGED << Proc, Urgencies, Waiters, ticketsAvailable,
                                            ticketsEnqueued, ActiveProc,
                                            queueBeingModified, ModifyingState,
                                            IsWaiting, localTicketsAvailable,
                                            localTicketsEnqueued, dequeuedElem,
-                                           localPid >>
+                                           localPid, AdmitBy >>
 
 enqueue(self) == /\ pc[self] = "enqueue"
                  /\ queueBeingModified = FALSE
                  /\ queueBeingModified' = TRUE
                  /\ pc' = [pc EXCEPT ![self] = "modifyEnqueued"]
-                 /\ UNCHANGED << Proc, Waiters, ticketsAvailable,
+                 /\ UNCHANGED << Proc, Urgencies, Waiters, ticketsAvailable,
                                  ticketsEnqueued, ActiveProc, ModifyingState,
                                  IsWaiting, stack, pid,
                                  localTicketsAvailableAcquire,
                                  localTicketsEnqueuedAcquire,
                                  localTicketsAvailable, localTicketsEnqueued,
-                                 dequeuedElem, localPid >>
+                                 dequeuedElem, localPid, AdmitBy >>
 
 modifyEnqueued(self) == /\ pc[self] = "modifyEnqueued"
                         /\ ticketsEnqueued' = ticketsEnqueued + 1
                         /\ pc' = [pc EXCEPT ![self] = "modifyAvailableOptimistically"]
-                        /\ UNCHANGED << Proc, Waiters, ticketsAvailable,
+                        /\ UNCHANGED << Proc, Urgencies, Waiters, ticketsAvailable,
                                         ActiveProc, queueBeingModified,
                                         ModifyingState, IsWaiting, stack, pid,
                                         localTicketsAvailableAcquire,
                                         localTicketsEnqueuedAcquire,
                                         localTicketsAvailable,
                                         localTicketsEnqueued, dequeuedElem,
-                                        localPid >>
+                                        localPid, AdmitBy >>
 
 modifyAvailableOptimistically(self) == /\ pc[self] = "modifyAvailableOptimistically"
                                        /\ ticketsAvailable' = ticketsAvailable - 1
                                        /\ localTicketsAvailableAcquire' = [localTicketsAvailableAcquire EXCEPT ![self] = ticketsAvailable']
                                        /\ pc' = [pc EXCEPT ![self] = "optimisticCheckQueue"]
-                                       /\ UNCHANGED << Proc, Waiters,
+                                       /\ UNCHANGED << Proc, Urgencies, Waiters,
                                                        ticketsEnqueued,
                                                        ActiveProc,
                                                        queueBeingModified,
@@ -286,13 +307,13 @@ modifyAvailableOptimistically(self) == /\ pc[self] = "modifyAvailableOptimistica
                                                        localTicketsEnqueuedAcquire,
                                                        localTicketsAvailable,
                                                        localTicketsEnqueued,
-                                                       dequeuedElem, localPid >>
+                                                       dequeuedElem, localPid, AdmitBy >>
 
 optimisticCheckQueue(self) == /\ pc[self] = "optimisticCheckQueue"
                               /\ IF localTicketsAvailableAcquire[self] >= 0
                                     THEN /\ pc' = [pc EXCEPT ![self] = "checkSucceeded"]
                                     ELSE /\ pc' = [pc EXCEPT ![self] = "pessimisticRelease"]
-                              /\ UNCHANGED << Proc, Waiters, ticketsAvailable,
+                              /\ UNCHANGED << Proc, Urgencies, Waiters, ticketsAvailable,
                                               ticketsEnqueued, ActiveProc,
                                               queueBeingModified,
                                               ModifyingState, IsWaiting, stack,
@@ -301,7 +322,7 @@ optimisticCheckQueue(self) == /\ pc[self] = "optimisticCheckQueue"
                                               localTicketsEnqueuedAcquire,
                                               localTicketsAvailable,
                                               localTicketsEnqueued,
-                                              dequeuedElem, localPid >>
+                                              dequeuedElem, localPid, AdmitBy >>
 
 checkSucceeded(self) == /\ pc[self] = "checkSucceeded"
                         /\ ticketsEnqueued' = ticketsEnqueued - 1
@@ -311,30 +332,32 @@ checkSucceeded(self) == /\ pc[self] = "checkSucceeded"
                         /\ localTicketsEnqueuedAcquire' = [localTicketsEnqueuedAcquire EXCEPT ![self] = Head(stack[self]).localTicketsEnqueuedAcquire]
                         /\ pid' = [pid EXCEPT ![self] = Head(stack[self]).pid]
                         /\ stack' = [stack EXCEPT ![self] = Tail(stack[self])]
-                        /\ UNCHANGED << Proc, Waiters, ticketsAvailable,
+                        /\ UNCHANGED << Proc, Urgencies, Waiters, ticketsAvailable,
                                         ActiveProc, ModifyingState, IsWaiting,
                                         localTicketsAvailable,
                                         localTicketsEnqueued, dequeuedElem,
-                                        localPid >>
+                                        localPid, AdmitBy >>
 
 pessimisticRelease(self) == /\ pc[self] = "pessimisticRelease"
                             /\ ticketsAvailable' = ticketsAvailable + 1
                             /\ pc' = [pc EXCEPT ![self] = "actualEnqueue"]
-                            /\ UNCHANGED << Proc, Waiters, ticketsEnqueued,
+                            /\ UNCHANGED << Proc, Urgencies, Waiters, ticketsEnqueued,
                                             ActiveProc, queueBeingModified,
                                             ModifyingState, IsWaiting, stack,
                                             pid, localTicketsAvailableAcquire,
                                             localTicketsEnqueuedAcquire,
                                             localTicketsAvailable,
                                             localTicketsEnqueued, dequeuedElem,
-                                            localPid >>
+                                            localPid, AdmitBy >>
 
 actualEnqueue(self) == /\ pc[self] = "actualEnqueue"
                        /\ Waiters' = (Waiters \union {pid[self]})
                        /\ IsWaiting' = [IsWaiting EXCEPT ![pid[self]] = TRUE]
+                       /\ \E urgency \in Urgencies:
+                            AdmitBy' = [AdmitBy EXCEPT ![pid[self]] = urgency]
                        /\ queueBeingModified' = FALSE
                        /\ pc' = [pc EXCEPT ![self] = "resolve"]
-                       /\ UNCHANGED << Proc, ticketsAvailable, ticketsEnqueued,
+                       /\ UNCHANGED << Proc, Urgencies, ticketsAvailable, ticketsEnqueued,
                                        ActiveProc, ModifyingState, stack, pid,
                                        localTicketsAvailableAcquire,
                                        localTicketsEnqueuedAcquire,
@@ -349,11 +372,11 @@ resolve(self) == /\ pc[self] = "resolve"
                  /\ localTicketsEnqueuedAcquire' = [localTicketsEnqueuedAcquire EXCEPT ![self] = Head(stack[self]).localTicketsEnqueuedAcquire]
                  /\ pid' = [pid EXCEPT ![self] = Head(stack[self]).pid]
                  /\ stack' = [stack EXCEPT ![self] = Tail(stack[self])]
-                 /\ UNCHANGED << Proc, Waiters, ticketsAvailable,
+                 /\ UNCHANGED << Proc, Urgencies, Waiters, ticketsAvailable,
                                  ticketsEnqueued, ActiveProc,
                                  queueBeingModified, ModifyingState, IsWaiting,
                                  localTicketsAvailable, localTicketsEnqueued,
-                                 dequeuedElem, localPid >>
+                                 dequeuedElem, localPid, AdmitBy >>
 
 Acquire(self) == lockAttemptCopy(self) \/ attempt(self)
                     \/ copyTickets(self) \/ attemptOptimistic(self)
@@ -368,65 +391,65 @@ disableEnqueueing(self) == /\ pc[self] = "disableEnqueueing"
                            /\ queueBeingModified = FALSE
                            /\ queueBeingModified' = TRUE
                            /\ pc' = [pc EXCEPT ![self] = "release_"]
-                           /\ UNCHANGED << Proc, Waiters, ticketsAvailable,
+                           /\ UNCHANGED << Proc, Urgencies, Waiters, ticketsAvailable,
                                            ticketsEnqueued, ActiveProc,
                                            ModifyingState, IsWaiting, stack,
                                            pid, localTicketsAvailableAcquire,
                                            localTicketsEnqueuedAcquire,
                                            localTicketsAvailable,
                                            localTicketsEnqueued, dequeuedElem,
-                                           localPid >>
+                                           localPid, AdmitBy >>
 
 release_(self) == /\ pc[self] = "release_"
                   /\ pc' = [pc EXCEPT ![self] = "dequeue"]
-                  /\ UNCHANGED << Proc, Waiters, ticketsAvailable,
+                  /\ UNCHANGED << Proc, Urgencies, Waiters, ticketsAvailable,
                                   ticketsEnqueued, ActiveProc,
                                   queueBeingModified, ModifyingState,
                                   IsWaiting, stack, pid,
                                   localTicketsAvailableAcquire,
                                   localTicketsEnqueuedAcquire,
                                   localTicketsAvailable, localTicketsEnqueued,
-                                  dequeuedElem, localPid >>
+                                  dequeuedElem, localPid, AdmitBy >>
 
 dequeue(self) == /\ pc[self] = "dequeue"
                  /\ IF Waiters # {}
-                       THEN /\ \E elem \in Waiters:
+                       THEN /\ \E elem \in {w \in Waiters : \A other \in Waiters : AdmitBy[w] <= AdmitBy[other]}:
                                  /\ Waiters' = Waiters \ {elem}
                                  /\ dequeuedElem' = [dequeuedElem EXCEPT ![self] = elem]
                             /\ pc' = [pc EXCEPT ![self] = "dequeued"]
                        ELSE /\ pc' = [pc EXCEPT ![self] = "releaseTicket"]
                             /\ UNCHANGED << Waiters, dequeuedElem >>
-                 /\ UNCHANGED << Proc, ticketsAvailable, ticketsEnqueued,
+                 /\ UNCHANGED << Proc, Urgencies, ticketsAvailable, ticketsEnqueued,
                                  ActiveProc, queueBeingModified,
                                  ModifyingState, IsWaiting, stack, pid,
                                  localTicketsAvailableAcquire,
                                  localTicketsEnqueuedAcquire,
                                  localTicketsAvailable, localTicketsEnqueued,
-                                 localPid >>
+                                 localPid, AdmitBy >>
 
 dequeued(self) == /\ pc[self] = "dequeued"
                   /\ ticketsEnqueued' = ticketsEnqueued - 1
                   /\ pc' = [pc EXCEPT ![self] = "modifyStateLock"]
-                  /\ UNCHANGED << Proc, Waiters, ticketsAvailable, ActiveProc,
+                  /\ UNCHANGED << Proc, Urgencies, Waiters, ticketsAvailable, ActiveProc,
                                   queueBeingModified, ModifyingState,
                                   IsWaiting, stack, pid,
                                   localTicketsAvailableAcquire,
                                   localTicketsEnqueuedAcquire,
                                   localTicketsAvailable, localTicketsEnqueued,
-                                  dequeuedElem, localPid >>
+                                  dequeuedElem, localPid, AdmitBy >>
 
 modifyStateLock(self) == /\ pc[self] = "modifyStateLock"
                          /\ ModifyingState[dequeuedElem[self]] = FALSE
                          /\ ModifyingState' = [ModifyingState EXCEPT ![dequeuedElem[self]] = TRUE]
                          /\ pc' = [pc EXCEPT ![self] = "modifyState"]
-                         /\ UNCHANGED << Proc, Waiters, ticketsAvailable,
+                         /\ UNCHANGED << Proc, Urgencies, Waiters, ticketsAvailable,
                                          ticketsEnqueued, ActiveProc,
                                          queueBeingModified, IsWaiting, stack,
                                          pid, localTicketsAvailableAcquire,
                                          localTicketsEnqueuedAcquire,
                                          localTicketsAvailable,
                                          localTicketsEnqueued, dequeuedElem,
-                                         localPid >>
+                                         localPid, AdmitBy >>
 
 modifyState(self) == /\ pc[self] = "modifyState"
                      /\ IF ~ IsWaiting[dequeuedElem[self]]
@@ -434,39 +457,39 @@ modifyState(self) == /\ pc[self] = "modifyState"
                                 /\ pc' = [pc EXCEPT ![self] = "dequeue"]
                            ELSE /\ pc' = [pc EXCEPT ![self] = "wakeWaiter"]
                                 /\ UNCHANGED ModifyingState
-                     /\ UNCHANGED << Proc, Waiters, ticketsAvailable,
+                     /\ UNCHANGED << Proc, Urgencies, Waiters, ticketsAvailable,
                                      ticketsEnqueued, ActiveProc,
                                      queueBeingModified, IsWaiting, stack, pid,
                                      localTicketsAvailableAcquire,
                                      localTicketsEnqueuedAcquire,
                                      localTicketsAvailable,
                                      localTicketsEnqueued, dequeuedElem,
-                                     localPid >>
+                                     localPid, AdmitBy >>
 
 wakeWaiter(self) == /\ pc[self] = "wakeWaiter"
                     /\ IsWaiting' = [IsWaiting EXCEPT ![dequeuedElem[self]] = FALSE]
                     /\ ModifyingState' = [ModifyingState EXCEPT ![dequeuedElem[self]] = FALSE]
                     /\ pc' = [pc EXCEPT ![self] = "finished"]
-                    /\ UNCHANGED << Proc, Waiters, ticketsAvailable,
+                    /\ UNCHANGED << Proc, Urgencies, Waiters, ticketsAvailable,
                                     ticketsEnqueued, ActiveProc,
                                     queueBeingModified, stack, pid,
                                     localTicketsAvailableAcquire,
                                     localTicketsEnqueuedAcquire,
                                     localTicketsAvailable,
                                     localTicketsEnqueued, dequeuedElem,
-                                    localPid >>
+                                    localPid, AdmitBy >>
 
 releaseTicket(self) == /\ pc[self] = "releaseTicket"
                        /\ ticketsAvailable' = ticketsAvailable + 1
                        /\ pc' = [pc EXCEPT ![self] = "finished"]
-                       /\ UNCHANGED << Proc, Waiters, ticketsEnqueued,
+                       /\ UNCHANGED << Proc, Urgencies, Waiters, ticketsEnqueued,
                                        ActiveProc, queueBeingModified,
                                        ModifyingState, IsWaiting, stack, pid,
                                        localTicketsAvailableAcquire,
                                        localTicketsEnqueuedAcquire,
                                        localTicketsAvailable,
                                        localTicketsEnqueued, dequeuedElem,
-                                       localPid >>
+                                       localPid, AdmitBy >>
 
 finished(self) == /\ pc[self] = "finished"
                   /\ queueBeingModified' = FALSE
@@ -475,10 +498,10 @@ finished(self) == /\ pc[self] = "finished"
                   /\ localTicketsEnqueued' = [localTicketsEnqueued EXCEPT ![self] = Head(stack[self]).localTicketsEnqueued]
                   /\ dequeuedElem' = [dequeuedElem EXCEPT ![self] = Head(stack[self]).dequeuedElem]
                   /\ stack' = [stack EXCEPT ![self] = Tail(stack[self])]
-                  /\ UNCHANGED << Proc, Waiters, ticketsAvailable,
+                  /\ UNCHANGED << Proc, Urgencies, Waiters, ticketsAvailable,
                                   ticketsEnqueued, ActiveProc, ModifyingState,
                                   IsWaiting, pid, localTicketsAvailableAcquire,
-                                  localTicketsEnqueuedAcquire, localPid >>
+                                  localTicketsEnqueuedAcquire, localPid, AdmitBy >>
 
 Release(self) == disableEnqueueing(self) \/ release_(self) \/ dequeue(self)
                     \/ dequeued(self) \/ modifyStateLock(self)
@@ -490,12 +513,12 @@ loop(self) == /\ pc[self] = "loop"
                    /\ ActiveProc' = ActiveProc \ {elem}
                    /\ localPid' = [localPid EXCEPT ![self] = elem]
               /\ pc' = [pc EXCEPT ![self] = "acquire"]
-              /\ UNCHANGED << Proc, Waiters, ticketsAvailable, ticketsEnqueued,
+              /\ UNCHANGED << Proc, Urgencies, Waiters, ticketsAvailable, ticketsEnqueued,
                               queueBeingModified, ModifyingState, IsWaiting,
                               stack, pid, localTicketsAvailableAcquire,
                               localTicketsEnqueuedAcquire,
                               localTicketsAvailable, localTicketsEnqueued,
-                              dequeuedElem >>
+                              dequeuedElem, AdmitBy >>
 
 acquire(self) == /\ pc[self] = "acquire"
                  /\ /\ pid' = [pid EXCEPT ![self] = localPid[self]]
@@ -508,11 +531,11 @@ acquire(self) == /\ pc[self] = "acquire"
                  /\ localTicketsAvailableAcquire' = [localTicketsAvailableAcquire EXCEPT ![self] = -1]
                  /\ localTicketsEnqueuedAcquire' = [localTicketsEnqueuedAcquire EXCEPT ![self] = -1]
                  /\ pc' = [pc EXCEPT ![self] = "lockAttemptCopy"]
-                 /\ UNCHANGED << Proc, Waiters, ticketsAvailable,
+                 /\ UNCHANGED << Proc, Urgencies, Waiters, ticketsAvailable,
                                  ticketsEnqueued, ActiveProc,
                                  queueBeingModified, ModifyingState, IsWaiting,
                                  localTicketsAvailable, localTicketsEnqueued,
-                                 dequeuedElem, localPid >>
+                                 dequeuedElem, localPid, AdmitBy >>
 
 release(self) == /\ pc[self] = "release"
                  /\ stack' = [stack EXCEPT ![self] = << [ procedure |->  "Release",
@@ -525,23 +548,23 @@ release(self) == /\ pc[self] = "release"
                  /\ localTicketsEnqueued' = [localTicketsEnqueued EXCEPT ![self] = -1]
                  /\ dequeuedElem' = [dequeuedElem EXCEPT ![self] = -1]
                  /\ pc' = [pc EXCEPT ![self] = "disableEnqueueing"]
-                 /\ UNCHANGED << Proc, Waiters, ticketsAvailable,
+                 /\ UNCHANGED << Proc, Urgencies, Waiters, ticketsAvailable,
                                  ticketsEnqueued, ActiveProc,
                                  queueBeingModified, ModifyingState, IsWaiting,
                                  pid, localTicketsAvailableAcquire,
-                                 localTicketsEnqueuedAcquire, localPid >>
+                                 localTicketsEnqueuedAcquire, localPid, AdmitBy >>
 
 releasePid(self) == /\ pc[self] = "releasePid"
                     /\ ActiveProc' = (ActiveProc \union {localPid[self]})
                     /\ pc' = [pc EXCEPT ![self] = "loop"]
-                    /\ UNCHANGED << Proc, Waiters, ticketsAvailable,
+                    /\ UNCHANGED << Proc, Urgencies, Waiters, ticketsAvailable,
                                     ticketsEnqueued, queueBeingModified,
                                     ModifyingState, IsWaiting, stack, pid,
                                     localTicketsAvailableAcquire,
                                     localTicketsEnqueuedAcquire,
                                     localTicketsAvailable,
                                     localTicketsEnqueued, dequeuedElem,
-                                    localPid >>
+                                    localPid, AdmitBy >>
 
 P(self) == loop(self) \/ acquire(self) \/ release(self) \/ releasePid(self)
 
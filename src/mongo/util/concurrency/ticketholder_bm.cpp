@@ -90,6 +90,38 @@ void BM_acquireAndRelease(benchmark::State& state) {
         benchmark::Counter(acquired, benchmark::Counter::kAvgThreadsRate);
 }
 
+/**
+ * Same as BM_acquireAndRelease, except that the first thread keeps resizing the pool between
+ * kTickets / 2 and kTickets, as a runtime concurrency controller would, while the others acquire.
+ */
+template <class TicketHolderImpl>
+void BM_acquireAndReleaseWhileResizing(benchmark::State& state) {
+    static std::unique_ptr<TicketHolderFixture<TicketHolderImpl>> p;
+    if (state.thread_index == 0) {
+        p = std::make_unique<TicketHolderFixture<TicketHolderImpl>>(state.threads);
+    }
+    double acquired = 0;
+    double resized = 0;
+    for (auto _ : state) {
+        if (state.thread_index == 0) {
+            auto newSize = p->ticketHolder->outof() == kTickets ? kTickets / 2 : kTickets;
+            invariant(p->ticketHolder->resize(newSize));
+            resized++;
+            continue;
+        }
+        AdmissionContext admCtx;
+        auto opCtx = p->opCtxs[state.thread_index].get();
+        auto ticket = p->ticketHolder->waitForTicket(opCtx, &admCtx, waitMode);
+        state.PauseTiming();
+        sleepmicros(1);
+        state.ResumeTiming();
+        p->ticketHolder->release(&admCtx, std::move(ticket));
+        acquired++;
+    }
+    state.counters["Acquired"] = benchmark::Counter(acquired, benchmark::Counter::kIsRate);
+    state.counters["Resized"] = benchmark::Counter(resized, benchmark::Counter::kIsRate);
+}
+
 BENCHMARK_TEMPLATE(BM_acquireAndRelease, SemaphoreTicketHolder)
     ->Threads(kThreadMin)
     ->Threads(kTickets)
@@ -100,5 +132,15 @@ BENCHMARK_TEMPLATE(BM_acquireAndRelease, FifoTicketHolder)
     ->Threads(kTickets)
     ->Threads(kThreadMax);
 
+BENCHMARK_TEMPLATE(BM_acquireAndReleaseWhileResizing, SemaphoreTicketHolder)
+    ->Threads(kThreadMin)
+    ->Threads(kTickets)
+    ->Threads(kThreadMax);
+
+BENCHMARK_TEMPLATE(BM_acquireAndReleaseWhileResizing, FifoTicketHolder)
+    ->Threads(kThreadMin)
+    ->Threads(kTickets)
+    ->Threads(kThreadMax);
+
 }  // namespace
 }  // namespace mongo
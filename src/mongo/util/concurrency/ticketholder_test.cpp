@@ -38,6 +38,7 @@
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/concurrency/admission_context.h"
+#include "mongo/util/clock_source_mock.h"
 #include "mongo/util/concurrency/ticketholder.h"
 #include "mongo/util/tick_source_mock.h"
 
@@ -193,6 +194,53 @@ TEST_F(TicketHolderTest, FifoCanceled) {
     ASSERT_EQ(stats["canceled"], 1);
 }
 
+TEST_F(TicketHolderTest, FifoAdmitsEarlierDeadlineFirst) {
+    // The clock does not move during the test, so neither waiter can time out and the admission
+    // order only depends on the deadlines.
+    auto clockSource = std::make_unique<ClockSourceMock>();
+    auto clockSourcePtr = clockSource.get();
+    getServiceContext()->setPreciseClockSource(std::move(clockSource));
+    getServiceContext()->setTickSource(std::make_unique<TickSourceMock<Microseconds>>());
+    FifoTicketHolder holder(1, getServiceContext());
+    AdmissionContext admCtx;
+    AtomicWord<int> admissions{0};
+
+    auto ticket =
+        holder.waitForTicket(_opCtx.get(), &admCtx, TicketHolder::WaitMode::kInterruptible);
+
+    auto waitFor = [&](Date_t until, int* order) {
+        auto client = getServiceContext()->makeClient("waiting");
+        auto opCtx = client->makeOperationContext();
+
+        AdmissionContext admCtx;
+        auto ticket = holder.waitForTicketUntil(
+            opCtx.get(), &admCtx, until, TicketHolder::WaitMode::kInterruptible);
+        ASSERT(ticket);
+        *order = admissions.fetchAndAdd(1);
+        holder.release(&admCtx, std::move(*ticket));
+    };
+
+    int patientOrder = -1;
+    stdx::thread patient([&] { waitFor(Date_t::max(), &patientOrder); });
+    while (holder.queued() < 1) {
+        // Wait for the first waiter to enqueue.
+    }
+
+    int urgentOrder = -1;
+    auto urgentDeadline = clockSourcePtr->now() + Milliseconds(50);
+    stdx::thread urgent([&] { waitFor(urgentDeadline, &urgentOrder); });
+    while (holder.queued() < 2) {
+        // Wait for the second waiter to enqueue.
+    }
+
+    holder.release(&admCtx, std::move(ticket));
+    urgent.join();
+    patient.join();
+
+    ASSERT_EQ(urgentOrder, 0);
+    ASSERT_EQ(patientOrder, 1);
+}
+
 DEATH_TEST_F(TicketHolderTest, UnreleasedTicket, "invariant") {
     ServiceContext serviceContext;
     serviceContext.setTickSource(std::make_unique<TickSourceMock<Microseconds>>());
@@ -32,21 +32,36 @@
 #include "mongo/util/log_and_backoff.h"
 
 #include "mongo/logv2/log.h"
+#include "mongo/platform/random.h"
 #include "mongo/util/time_support.h"
 
 namespace mongo::log_backoff_detail {
+namespace {
+
+/**
+ * Sleeps for a random duration in [base / 2, 3 * base / 2). Callers that conflicted with each other
+ * tend to start backing off at the same moment, so a fixed delay would line their retries up to
+ * conflict again.
+ */
+void sleepWithJitter(Milliseconds base) {
+    thread_local PseudoRandom prng{SecureRandom().nextInt64()};
+    const auto baseMicros = durationCount<Microseconds>(base);
+    sleepmicros(baseMicros / 2 + prng.nextInt64(baseMicros));
+}
+
+}  // namespace
 
 void logAndBackoffImpl(size_t numAttempts) {
     if (numAttempts < 4) {
         // no-op
     } else if (numAttempts < 10) {
-        sleepmillis(1);
+        sleepWithJitter(Milliseconds(1));
     } else if (numAttempts < 100) {
-        sleepmillis(5);
+        sleepWithJitter(Milliseconds(5));
     } else if (numAttempts < 200) {
-        sleepmillis(10);
+        sleepWithJitter(Milliseconds(10));
     } else {
-        sleepmillis(100);
+        sleepWithJitter(Milliseconds(100));
     }
 }
 
@@ -143,6 +143,12 @@ public:
 
     /**
      * Determine if NUMA is enabled (interleaved) for this process
+     *
+     * The server does not place memory per node: the storage engine cache is a single shared pool
+     * and service threads float across nodes. Only the oplog writer threads can be pinned to nodes,
+     * with replWriterPinToNumaNodes. The supported configuration on multi-node hosts is to
+     * interleave memory across nodes (e.g. numactl --interleave=all), which mongod checks for and
+     * warns about at startup.
      */
     static bool hasNumaEnabled() {
         return sysInfo().hasNuma;
@@ -198,6 +198,16 @@ void escape(Buffer& buffer,
         *wouldWrite = total;
     }
 }
+
+// Returns true if 'str' is printable ASCII with no characters that JSON requires to be escaped.
+// This is written without an early exit so that the compiler can vectorize the loop.
+bool isJSONSafeASCII(StringData str) {
+    bool unsafe = false;
+    for (uint8_t c : str) {
+        unsafe |= (c < 0x20) | (c == '"') | (c == '\\') | (c >= 0x7f);
+    }
+    return !unsafe;
+}
 }  // namespace
 
 template <typename Buffer>
@@ -349,6 +359,16 @@ std::string escapeForText(StringData str, size_t maxLength, size_t* wouldWrite)
 
 template <typename Buffer>
 void escapeForJSONCommon(Buffer& buffer, StringData str, size_t maxLength, size_t* wouldWrite) {
+    // Most field names and string values need no escaping. Append those in one go instead of
+    // dispatching on every byte in escape().
+    if (str.size() <= maxLength && isJSONSafeASCII(str)) {
+        appendBuffer(buffer, str.begin(), str.end());
+        if (wouldWrite) {
+            *wouldWrite = str.size();
+        }
+        return;
+    }
+
     auto singleByteHandler = [](const auto& writer, uint8_t unescaped) {
         switch (unescaped) {
             case '\0':
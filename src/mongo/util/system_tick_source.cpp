@@ -99,6 +99,11 @@ void initTickSource() {
 /**
  * Implementation for timer on systems that support the
  * POSIX clock API and CLOCK_MONOTONIC clock.
+ *
+ * On Linux this call is served from the vDSO, which already reads the TSC directly when the kernel
+ * has judged it invariant and stable, and falls back to another clock source when it has not.
+ * Reading the TSC here instead would skip that judgment (and the adjustments made across VM
+ * migration) for little gain; see BM_SystemTickSourceGetTicks in clock_source_bm.cpp.
  */
 TickSource::Tick timerNowPosixMonotonicClock() {
     timespec the_time;